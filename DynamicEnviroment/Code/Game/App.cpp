@@ -6,13 +6,21 @@
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/RenderBackend.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Core/DebugRender.hpp"
 #include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/AssetLoader.hpp"
 #include "Engine/Window/Window.hpp"
 #include "Engine/Core/Clock.hpp"
 
 
+//--------------------------------------------------------------------------------------------------
+#include <stdlib.h>
+#include <string.h>
+
+
 //--------------------------------------------------------------------------------------------------
 RandomNumberGenerator*		g_rng			= nullptr;
 InputSystem*				g_theInput		= nullptr;
@@ -22,6 +30,10 @@ Window*						g_theWindow		= nullptr;
 App*						g_theApp		= nullptr;
 
 
+//--------------------------------------------------------------------------------------------------
+static constexpr int	NUM_OF_HEADLESS_WARMUP_FRAMES	=	3;
+
+
 //--------------------------------------------------------------------------------------------------
 App::App()
 {
@@ -37,8 +49,18 @@ App::~App()
 
 
 //--------------------------------------------------------------------------------------------------
-void App::Startup()
+void App::Startup(char const* commandLine)
 {
+	char const* headlessArg = commandLine ? strstr(commandLine, "-headless") : nullptr;
+	if (headlessArg)
+	{
+		m_isHeadless = true;
+		if (headlessArg[9] == '=')
+		{
+			m_numOfHeadlessFrames = atoi(headlessArg + 10);
+		}
+	}
+
 	XmlDocument gameConfig;
 	gameConfig.LoadFile("Data/GameConfig.xml");
 	XmlElement& root = *(gameConfig.RootElement());
@@ -56,23 +78,35 @@ void App::Startup()
 	windowConfig.m_windowTitle		=	"Dynamic Environment";
 	windowConfig.m_clientAspect		=	m_aspectRatio;
 	windowConfig.m_inputSystem		=	g_theInput;
-	windowConfig.m_isFullScreen		=	g_gameConfigBlackboard.GetValue("isWindowFullScreen", false);
+	windowConfig.m_isFullScreen		=	g_gameConfigBlackboard.GetValue("isWindowFullScreen", false) && !m_isHeadless;
+	windowConfig.m_isHidden			=	m_isHeadless;
 	g_theWindow = new Window(windowConfig);
 	
 	RendererConfig renderConfig;
-	renderConfig.m_window	=	g_theWindow;
-	g_theRenderer			=	new Renderer(renderConfig);
+	renderConfig.m_window		=	g_theWindow;
+	renderConfig.m_isHeadless	=	m_isHeadless;
+	g_theRenderer				=	new Renderer(renderConfig);
 
 	DevConsoleConfig devConsoleConfig;
 	devConsoleConfig.m_renderer		=	g_theRenderer;
 	devConsoleConfig.m_camera		=	&m_devConsoleCamera;
 	g_theDevConsole = new DevConsole(devConsoleConfig);
 
+	JobSystemConfig jobSystemConfig;
+	g_theJobSystem = new JobSystem(jobSystemConfig);
+
 	g_theEventSystem->Startup();
+	g_theJobSystem->Startup();
 	g_theDevConsole->Startup();
 	g_theInput->Startup();
 	g_theWindow->Startup();
 	g_theRenderer->Startup();
+
+	AssetLoaderConfig assetLoaderConfig;
+	assetLoaderConfig.m_renderer	=	g_theRenderer;
+	assetLoaderConfig.m_jobSystem	=	g_theJobSystem;
+	g_theAssetLoader = new AssetLoader(assetLoaderConfig);
+	g_theAssetLoader->Startup();
 	g_rng = new RandomNumberGenerator();
 
 	g_theFont = g_theRenderer->CreateOrGetBitmapFont("Data/Fonts/SquirrelFixedFont");
@@ -90,6 +124,7 @@ void App::Startup()
 	g_theEventSystem->SubscribeEventCallbackFunction("quit", Event_Quit);
 	g_theEventSystem->SubscribeEventCallbackFunction("debugrenderclear", Command_DebugRenderClear);
 	g_theEventSystem->SubscribeEventCallbackFunction("debugrendertoggle", Command_DebugRenderToggle);
+	g_theEventSystem->SubscribeEventCallbackFunction("renderbenchmark", Command_RenderBenchmark);
 	
 	m_theGame = new Game(g_theWindow->GetConfig().m_clientAspect);
 	
@@ -109,11 +144,13 @@ void App::Shutdown()
 	delete m_theGame;
 	m_theGame = nullptr;
 
+	g_theAssetLoader->Shutdown();
 	g_theRenderer->Shutdown();
 	g_theWindow->Shutdown();
 	g_theInput->Shutdown();
 	g_theDevConsole->Shutdown();
 	g_theEventSystem->Shutdown();
+	g_theJobSystem->Shutdown();
 
 	delete g_theFont;
 	g_theFont = nullptr;
@@ -121,6 +158,9 @@ void App::Shutdown()
 	delete g_rng;
 	g_rng = nullptr;
 
+	delete g_theAssetLoader;
+	g_theAssetLoader = nullptr;
+
 	delete g_theRenderer;
 	g_theRenderer = nullptr;
 
@@ -135,6 +175,9 @@ void App::Shutdown()
 
 	delete g_theEventSystem;
 	g_theEventSystem = nullptr;
+
+	delete g_theJobSystem;
+	g_theJobSystem = nullptr;
 }
 
 
@@ -162,6 +205,28 @@ void App::RunFrame()
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// Runs a few frames so the scene requests its assets and waits for them, then records Game::Render for the benchmark frames
+int App::RunHeadless()
+{
+	for (int frameIndex = 0; frameIndex < NUM_OF_HEADLESS_WARMUP_FRAMES; ++frameIndex)
+	{
+		RunFrame();
+		g_theAssetLoader->WaitUntilAllLoaded();
+	}
+
+	bool isValid = RunRenderBenchmark(*g_theRenderer, [this]() { m_theGame->Render(); }, m_numOfHeadlessFrames, "DynamicEnviroment");
+	return isValid ? 0 : 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool App::IsHeadless() const
+{
+	return m_isHeadless;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 bool App::IsQuitting() const
 {
@@ -228,6 +293,15 @@ bool App::Event_Quit(EventArgs& args)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+bool App::Command_RenderBenchmark(EventArgs& args)
+{
+	int numOfFrames = args.GetValue("NumOfFrames", 200);
+	RunRenderBenchmark(*g_theRenderer, []() { g_theApp->m_theGame->Render(); }, numOfFrames, "DynamicEnviroment");
+	return true;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void App::BeginFrame()
 {
@@ -236,6 +310,7 @@ void App::BeginFrame()
 	g_theInput->BeginFrame();
 	g_theWindow->BeginFrame();
 	g_theRenderer->BeginFrame();
+	g_theAssetLoader->Update();
 	DebugRenderBeginFrame();
 }
 
@@ -17,10 +17,13 @@ class App
 public:
 	App();
 	~App();
-	void Startup();
+	void Startup(char const* commandLine);		// "-headless" or "-headless=<frames>" runs RunHeadless instead of Run
 	void Shutdown();
 	void Run();
 	void RunFrame();
+	int  RunHeadless();						// Renders on the null backend without showing anything, returns 0 when validation passed
+
+	bool IsHeadless() const;
 
 	bool IsQuitting() const;
 	void SetQuitting(bool isQuitting);
@@ -28,6 +31,7 @@ public:
 	bool HandleQuitRequested();
 	void InputHandler();
 	static bool Event_Quit(EventArgs& args);
+	static bool Command_RenderBenchmark(EventArgs& args);
 
 private:
 	void BeginFrame();
@@ -44,4 +48,6 @@ private:
 	float m_aspectRatio			=	2.f;
 	bool m_isQuitting			=	false;
 	bool m_isSlowMo				=	false;
+	bool m_isHeadless			=	false;
+	int  m_numOfHeadlessFrames	=	200;
 };
\ No newline at end of file
@@ -16,6 +16,7 @@
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/OBJLoader.hpp"
+#include "Engine/Core/AssetLoader.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Window/Window.hpp"
 #include "Engine/Math/AABB3.hpp"
@@ -358,7 +359,8 @@ void Game::RenderDynamicEnvMode() const
 		translantionMat.SetTranslation3D(Vec3(0.f, 66.f, 0.f));
 		// translantionMat.SetTranslation3D(Vec3(0.f, 0.f, 0.f));
 		g_theRenderer->SetModelConstants(translantionMat);
-		g_theRenderer->BindReadableResources(&m_skyBoxCubeMapResource, 1, 0, BindingLocation::PIXEL_SHADER);
+		D3D11_Resource* skyBoxCubeMapResource = m_skyBoxCubeMapAsset->GetTextureResource();
+		g_theRenderer->BindReadableResources(&skyBoxCubeMapResource, 1, 0, BindingLocation::PIXEL_SHADER);
 		g_theRenderer->BindShader(m_reflectionPlaneShader);
 		static unsigned int refPlaneIndexCount = (unsigned int)m_reflectionPlaneIB->m_size / m_reflectionPlaneIB->GetStride();
 		g_theRenderer->DrawIndexedBuffer(m_reflectionPlaneIB, m_reflectionPlaneVB, refPlaneIndexCount);
@@ -368,7 +370,7 @@ void Game::RenderDynamicEnvMode() const
 	{
 		RendererAnnotationJanitor foliageJanitor(L"Foliage Render");
 		
-		D3D11_Resource* readableResourcesToBind[] = { m_foliageStiffnessResource };
+		D3D11_Resource* readableResourcesToBind[] = { m_foliageStiffnessAsset->GetTextureResource() };
 		g_theRenderer->BindReadableResources(readableResourcesToBind, 1, 5, BindingLocation::VERTEX_SHADER);
 		g_theRenderer->BindShader(m_foliageShader);
 		g_theRenderer->DrawIndexedInstanced(m_foliageInstanceDataIB, m_foliageInstanceDataVB, nullptr, INDEX_COUNT_PER_GRASS_BLADE, GRASS_BLADE_INSTANCE_COUNT);
@@ -388,7 +390,8 @@ void Game::RenderDynamicEnvMode() const
 		AABB3 bounds(Vec3::ZERO, 1.f, 1.f, 1.f);
 		AddVertsForAABB3D(tempVertsPCU, bounds, Rgba8::WHITE);
 		g_theRenderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_FRONT);
-		g_theRenderer->BindReadableResources(&m_skyBoxCubeMapResource, 1, 0, BindingLocation::PIXEL_SHADER);
+		D3D11_Resource* skyBoxCubeMapResource = m_skyBoxCubeMapAsset->GetTextureResource();
+		g_theRenderer->BindReadableResources(&skyBoxCubeMapResource, 1, 0, BindingLocation::PIXEL_SHADER);
 		g_theRenderer->BindShader(m_skyBoxShader, BindingLocation::PIXEL_SHADER);
 		g_theRenderer->DrawVertexArray(tempVertsPCU);
 		tempVertsPCU.clear();
@@ -558,9 +561,9 @@ void Game::InitializeRayMarchingCanvas()
 //--------------------------------------------------------------------------------------------------
 void Game::InitializeResources()
 {
-	m_testUVTexture				=	g_theRenderer->CreateTextureResourceFromFile("Data/Textures/TestUV.png", "TestUV", sizeof("TestUV") - 1);
-	m_skyBoxCubeMapResource		=	g_theRenderer->CreateTextureCubeResourceFromFile("Data/ColdSunsetSkybox_png/", "Skybox", sizeof("Skybox"));
-	m_foliageStiffnessResource	=	g_theRenderer->CreateTextureResourceFromFile("Data/Textures/FoliageStiffness.png", "FoliageStiffness", sizeof("FoliageStiffness") - 1);
+	m_testUVTextureAsset		=	g_theAssetLoader->RequestTextureResource("Data/Textures/TestUV.png", "TestUV");
+	m_skyBoxCubeMapAsset		=	g_theAssetLoader->RequestTextureCubeResource("Data/ColdSunsetSkybox_png/", "Skybox");
+	m_foliageStiffnessAsset		=	g_theAssetLoader->RequestTextureResource("Data/Textures/FoliageStiffness.png", "FoliageStiffness");
 
 	// Terrain vertex and Index buffer
 	CreateAndPopulateTerrainBuffers(IntVec2(TERRAIN_RES, TERRAIN_RES));
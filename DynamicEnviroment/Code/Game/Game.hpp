@@ -30,6 +30,7 @@ class VertexBuffer;
 class D3D11_Buffer;
 class ConstantBuffer;
 class D3D11_Resource;
+class Asset;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -134,10 +135,10 @@ private:
 	Shader*				m_terrainShader					=	nullptr;
 	Shader*				m_debugSDFRaymarchingShader		=	nullptr;
 
-	// Resources
-	D3D11_Resource*		m_testUVTexture					=	nullptr;
-	D3D11_Resource*		m_skyBoxCubeMapResource			=	nullptr;
-	D3D11_Resource*		m_foliageStiffnessResource		=	nullptr;
+	// Resources, streamed in by g_theAssetLoader and white placeholders until then
+	Asset const*		m_testUVTextureAsset			=	nullptr;
+	Asset const*		m_skyBoxCubeMapAsset			=	nullptr;
+	Asset const*		m_foliageStiffnessAsset			=	nullptr;
 
 	// General
 	Camera				m_screenCamera					=	{ };
@@ -15,18 +15,25 @@ extern App* g_theApp;
 int WINAPI WinMain( HINSTANCE applicationInstanceHandle, HINSTANCE, LPSTR commandLineString, int )
 {
 	Sleep(0);
-	(void) commandLineString;
 	(void) applicationInstanceHandle;
 	
 	
 	g_theApp = new App();
-	g_theApp->Startup();
-	g_theApp->Run();
+	g_theApp->Startup(commandLineString);
+	int exitCode = 0;
+	if (g_theApp->IsHeadless())
+	{
+		exitCode = g_theApp->RunHeadless();
+	}
+	else
+	{
+		g_theApp->Run();
+	}
 	g_theApp->Shutdown();
 	delete g_theApp;
 	g_theApp = nullptr;
 
-	return 0;
+	return exitCode;
 }
 
 
@@ -0,0 +1,772 @@
+#include "Engine/Core/AssetLoader.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/OBJLoader.hpp"
+#include "Engine/Core/VertexQuantization.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+
+//--------------------------------------------------------------------------------------------------
+AssetLoader* g_theAssetLoader = nullptr;
+
+
+//--------------------------------------------------------------------------------------------------
+// Everything here runs on a job worker (or on whichever thread helps out in JobSystem::WaitUntilJobsCompleted)
+// The asset's payload is only touched by the main thread again once the job is retrieved
+class AssetLoadJob : public Job
+{
+public:
+	AssetLoadJob(Asset* asset) : m_asset(asset) {};
+	virtual void Execute() override;
+
+public:
+	Asset* m_asset = nullptr;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+void AssetLoadJob::Execute()
+{
+	Asset& asset = *m_asset;
+	switch (asset.m_type)
+	{
+		case AssetType::TEXTURE:
+		case AssetType::TEXTURE_RESOURCE:
+		{
+			// Image dies on a missing file, a missing asset should only fail its own load
+			if (DoesFileExist(asset.m_filePath))
+			{
+				asset.m_images.emplace_back(asset.m_filePath.c_str());
+			}
+			break;
+		}
+		case AssetType::TEXTURE_CUBE_RESOURCE:
+		{
+			std::string faceFilePaths[6];
+			Renderer::GetTextureCubeFaceFilePaths(asset.m_filePath.c_str(), faceFilePaths);
+			for (int faceIndex = 0; faceIndex < 6; ++faceIndex)
+			{
+				if (!DoesFileExist(faceFilePaths[faceIndex]))
+				{
+					return;
+				}
+			}
+
+			asset.m_images.reserve(6);
+			for (int faceIndex = 0; faceIndex < 6; ++faceIndex)
+			{
+				asset.m_images.emplace_back(faceFilePaths[faceIndex].c_str());
+				if (asset.m_images[faceIndex].GetDimensions() != asset.m_images[0].GetDimensions())
+				{
+					asset.m_images.clear();
+					return;
+				}
+			}
+			break;
+		}
+		case AssetType::MESH:
+		{
+			OBJLoader::LoadOBJFileByName(asset.m_filePath, asset.m_verts, asset.m_indexes, asset.m_transformFixUpMat);
+			break;
+		}
+		case AssetType::MESH_PCUTBN:
+		{
+			OBJLoader::LoadOBJFileByName(asset.m_filePath, asset.m_pcutbnVerts, asset.m_indexes, asset.m_transformFixUpMat);
+			break;
+		}
+		case AssetType::MESH_PCUTBN_QUANTIZED:
+		{
+			// The source verts stay around for the loaded callbacks, the GPU only gets the quantized ones
+			OBJLoader::LoadOBJFileByName(asset.m_filePath, asset.m_pcutbnVerts, asset.m_indexes, asset.m_transformFixUpMat);
+			asset.m_quantizationBounds = QuantizeVertexes(asset.m_pcutbnVerts, asset.m_quantizedVerts);
+			break;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Asset::Asset(AssetType type, std::string const& filePath, std::string const& debugName, AssetLoader* owner) :
+	m_owner(owner),
+	m_type(type),
+	m_filePath(filePath),
+	m_debugName(debugName)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Textures belong to the renderer, texture resources and mesh buffers were created for this asset alone
+Asset::~Asset()
+{
+	if (m_textureResource)
+	{
+		m_owner->GetConfig().m_renderer->DestroyResource(m_textureResource);
+	}
+	delete m_vertexBuffer;
+	m_vertexBuffer = nullptr;
+	delete m_indexBuffer;
+	m_indexBuffer = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AssetType Asset::GetType() const
+{
+	return m_type;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AssetStatus Asset::GetStatus() const
+{
+	return m_status;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Asset::IsReady() const
+{
+	return m_status == AssetStatus::READY;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Asset::IsFinished() const
+{
+	return m_status == AssetStatus::READY || m_status == AssetStatus::FAILED;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Asset::IsMesh() const
+{
+	return m_type == AssetType::MESH || m_type == AssetType::MESH_PCUTBN || m_type == AssetType::MESH_PCUTBN_QUANTIZED;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::string const& Asset::GetFilePath() const
+{
+	return m_filePath;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Texture* Asset::GetTexture() const
+{
+	GUARANTEE_OR_DIE(m_type == AssetType::TEXTURE, Stringf("Asset \"%s\" is not a texture", m_filePath.c_str()));
+	return m_texture ? m_texture : m_owner->GetPlaceholderTexture();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* Asset::GetTextureResource() const
+{
+	if (m_type == AssetType::TEXTURE_CUBE_RESOURCE)
+	{
+		return m_textureResource ? m_textureResource : m_owner->GetPlaceholderTextureCubeResource();
+	}
+	GUARANTEE_OR_DIE(m_type == AssetType::TEXTURE_RESOURCE, Stringf("Asset \"%s\" is not a texture resource", m_filePath.c_str()));
+	return m_textureResource ? m_textureResource : m_owner->GetPlaceholderTextureResource();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+VertexBuffer* Asset::GetVertexBuffer() const
+{
+	return m_vertexBuffer;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+IndexBuffer* Asset::GetIndexBuffer() const
+{
+	return m_indexBuffer;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned int Asset::GetNumOfIndexes() const
+{
+	return m_numOfIndexes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The bounds are only known once the mesh is DECODED, until then the quantized placeholder draws nothing anyway
+Mat44 Asset::GetDequantizationMatrix() const
+{
+	if (m_type != AssetType::MESH_PCUTBN_QUANTIZED)
+	{
+		return Mat44();
+	}
+	return ::GetDequantizationMatrix(m_quantizationBounds);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<Vertex_PCU> const& Asset::GetDecodedVerts() const
+{
+	return m_verts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<Vertex_PCUTBN> const& Asset::GetDecodedPCUTBNVerts() const
+{
+	return m_pcutbnVerts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<unsigned int> const& Asset::GetDecodedIndexes() const
+{
+	return m_indexes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t Asset::GetNumOfDecodedBytes() const
+{
+	size_t numOfBytes = m_verts.size() * sizeof(Vertex_PCU) + m_pcutbnVerts.size() * sizeof(Vertex_PCUTBN) + m_quantizedVerts.size() * sizeof(Vertex_PCUTBN_Quantized) + m_indexes.size() * sizeof(unsigned int);
+	for (size_t imageIndex = 0; imageIndex < m_images.size(); ++imageIndex)
+	{
+		IntVec2 dimensions	=	m_images[imageIndex].GetDimensions();
+		numOfBytes			+=	(size_t)dimensions.x * (size_t)dimensions.y * sizeof(Rgba8);
+	}
+	return numOfBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Asset::FreeDecodedData()
+{
+	std::vector<Image>().swap(m_images);
+	std::vector<Vertex_PCU>().swap(m_verts);
+	std::vector<Vertex_PCUTBN>().swap(m_pcutbnVerts);
+	std::vector<Vertex_PCUTBN_Quantized>().swap(m_quantizedVerts);
+	std::vector<unsigned int>().swap(m_indexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AssetLoader::AssetLoader(AssetLoaderConfig const& config) :
+	m_config(config)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AssetLoader::~AssetLoader()
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AssetLoader::Startup()
+{
+	GUARANTEE_OR_DIE(m_config.m_renderer && m_config.m_jobSystem, "The asset loader needs a renderer and a job system");
+
+	Image placeholderImage = Image(IntVec2(1, 1), Rgba8(255, 255, 255));
+	m_placeholderTextureResource		=	m_config.m_renderer->CreateTextureResourceFromImage(placeholderImage, "AssetPlaceholder", sizeof("AssetPlaceholder") - 1);
+
+	Image placeholderFaceImages[6] = { placeholderImage, placeholderImage, placeholderImage, placeholderImage, placeholderImage, placeholderImage };
+	m_placeholderTextureCubeResource	=	m_config.m_renderer->CreateTextureCubeResourceFromImages(placeholderFaceImages, "AssetCubePlaceholder", sizeof("AssetCubePlaceholder") - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Picks up finished loads, creates up to m_maxNumOfAssetsCreatedPerFrame of them on the GPU, runs the loaded callbacks,
+// then starts as many new loads as the byte cap allows
+void AssetLoader::Update()
+{
+	bool hasNoWorkers = m_config.m_jobSystem->GetNumOfWorkerThreads() == 0;
+	RetrieveDecodedAssets(hasNoWorkers);
+	CreateDecodedAssets(m_config.m_maxNumOfAssetsCreatedPerFrame);
+	RunLoadedCallbacks();
+	StartPendingLoads();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AssetLoader::Shutdown()
+{
+	// The jobs write into their assets, so they have to be done before anything is freed
+	std::vector<Job*> loadJobs(m_loadJobs.begin(), m_loadJobs.end());
+	m_config.m_jobSystem->WaitUntilJobsCompleted(loadJobs);
+	for (size_t jobIndex = 0; jobIndex < m_loadJobs.size(); ++jobIndex)
+	{
+		delete m_loadJobs[jobIndex];
+	}
+	m_loadJobs.clear();
+	m_pendingAssets.clear();
+	m_decodedAssets.clear();
+	m_finishedAssets.clear();
+
+	for (size_t assetIndex = 0; assetIndex < m_assets.size(); ++assetIndex)
+	{
+		delete m_assets[assetIndex];
+	}
+	m_assets.clear();
+	m_numOfBytesInFlight = 0;
+
+	m_config.m_renderer->DestroyResource(m_placeholderTextureResource);
+	m_config.m_renderer->DestroyResource(m_placeholderTextureCubeResource);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Asset* AssetLoader::RequestTexture(std::string const& imageFilePath, AssetLoadedCallback const& onLoaded)
+{
+	return RequestAsset(AssetType::TEXTURE, imageFilePath, "", Mat44(), onLoaded);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Asset* AssetLoader::RequestTextureResource(std::string const& imageFilePath, std::string const& debugName, AssetLoadedCallback const& onLoaded)
+{
+	return RequestAsset(AssetType::TEXTURE_RESOURCE, imageFilePath, debugName, Mat44(), onLoaded);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Asset* AssetLoader::RequestTextureCubeResource(std::string const& cubeMapDir, std::string const& debugName, AssetLoadedCallback const& onLoaded)
+{
+	return RequestAsset(AssetType::TEXTURE_CUBE_RESOURCE, cubeMapDir, debugName, Mat44(), onLoaded);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Asset* AssetLoader::RequestMesh(std::string const& objFilePath, Mat44 const& transformFixUpMat, std::string const& debugName, AssetLoadedCallback const& onLoaded)
+{
+	return RequestAsset(AssetType::MESH, objFilePath, debugName, transformFixUpMat, onLoaded);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Asset* AssetLoader::RequestMeshPCUTBN(std::string const& objFilePath, Mat44 const& transformFixUpMat, std::string const& debugName, AssetLoadedCallback const& onLoaded)
+{
+	return RequestAsset(AssetType::MESH_PCUTBN, objFilePath, debugName, transformFixUpMat, onLoaded);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Asset* AssetLoader::RequestMeshPCUTBNQuantized(std::string const& objFilePath, Mat44 const& transformFixUpMat, std::string const& debugName, AssetLoadedCallback const& onLoaded)
+{
+	return RequestAsset(AssetType::MESH_PCUTBN_QUANTIZED, objFilePath, debugName, transformFixUpMat, onLoaded);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AssetLoader::WaitUntilAllLoaded()
+{
+	// A loaded callback can request more assets, so this goes until there are neither loads nor callbacks left
+	while (GetNumOfAssetsInFlight() > 0 || !m_finishedAssets.empty())
+	{
+		StartPendingLoads();
+		RetrieveDecodedAssets(true);
+		CreateDecodedAssets(-1);
+		RunLoadedCallbacks();
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int AssetLoader::GetNumOfAssetsInFlight() const
+{
+	return (int)(m_pendingAssets.size() + m_loadJobs.size() + m_decodedAssets.size());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t AssetLoader::GetNumOfBytesInFlight() const
+{
+	return m_numOfBytesInFlight;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AssetLoaderConfig const& AssetLoader::GetConfig() const
+{
+	return m_config;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Texture* AssetLoader::GetPlaceholderTexture() const
+{
+	return m_config.m_renderer->GetDefaultTexture();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* AssetLoader::GetPlaceholderTextureResource() const
+{
+	return m_placeholderTextureResource;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* AssetLoader::GetPlaceholderTextureCubeResource() const
+{
+	return m_placeholderTextureCubeResource;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Asset* AssetLoader::RequestAsset(AssetType type, std::string const& filePath, std::string const& debugName, Mat44 const& transformFixUpMat, AssetLoadedCallback const& onLoaded)
+{
+	for (size_t assetIndex = 0; assetIndex < m_assets.size(); ++assetIndex)
+	{
+		Asset* existingAsset = m_assets[assetIndex];
+		if (existingAsset->m_type == type && existingAsset->m_filePath == filePath &&
+			(!existingAsset->IsMesh() || memcmp(existingAsset->m_transformFixUpMat.m_values, transformFixUpMat.m_values, sizeof(transformFixUpMat.m_values)) == 0))
+		{
+			if (onLoaded)
+			{
+				existingAsset->m_loadedCallbacks.push_back(onLoaded);
+				if (existingAsset->IsFinished())
+				{
+					AddFinishedAsset(existingAsset);
+				}
+			}
+			return existingAsset;
+		}
+	}
+
+	Asset* newAsset					=	new Asset(type, filePath, debugName, this);
+	newAsset->m_transformFixUpMat	=	transformFixUpMat;
+	if (onLoaded)
+	{
+		newAsset->m_loadedCallbacks.push_back(onLoaded);
+	}
+	m_assets.push_back(newAsset);
+	m_pendingAssets.push_back(newAsset);
+	StartPendingLoads();
+	return newAsset;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// A load starts if its bytes fit under m_maxNumOfBytesInFlight, or if nothing is in flight so an oversized asset still loads
+bool AssetLoader::CanStartLoading(Asset const* asset) const
+{
+	return m_numOfBytesInFlight == 0 || m_numOfBytesInFlight + asset->m_numOfBytesCharged <= m_config.m_maxNumOfBytesInFlight;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Loads start in request order, until that is charged the asset counts its source file sizes against the cap
+void AssetLoader::StartPendingLoads()
+{
+	while (!m_pendingAssets.empty())
+	{
+		Asset* asset = m_pendingAssets.front();
+		if (asset->m_numOfBytesCharged == 0)
+		{
+			std::string	sourceFilePaths[6]	=	{ asset->m_filePath };
+			int			numOfSourceFiles	=	1;
+			if (asset->m_type == AssetType::TEXTURE_CUBE_RESOURCE)
+			{
+				Renderer::GetTextureCubeFaceFilePaths(asset->m_filePath.c_str(), sourceFilePaths);
+				numOfSourceFiles = 6;
+			}
+			for (int sourceFileIndex = 0; sourceFileIndex < numOfSourceFiles; ++sourceFileIndex)
+			{
+				std::error_code	errorCode;
+				uintmax_t		fileSize	=	std::filesystem::file_size(sourceFilePaths[sourceFileIndex], errorCode);
+				asset->m_numOfBytesCharged	+=	errorCode ? 0 : (size_t)fileSize;
+			}
+			asset->m_numOfBytesCharged = std::max(asset->m_numOfBytesCharged, (size_t)1);
+		}
+
+		if (!CanStartLoading(asset))
+		{
+			break;
+		}
+		m_pendingAssets.pop_front();
+		m_numOfBytesInFlight	+=	asset->m_numOfBytesCharged;
+		asset->m_status			=	AssetStatus::LOADING;
+
+		AssetLoadJob* loadJob = new AssetLoadJob(asset);
+		m_loadJobs.push_back(loadJob);
+		m_config.m_jobSystem->QueueNewJob(loadJob);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// From here until its GPU objects exist a decoded asset counts its decoded bytes against the cap
+// With waitForOne and nothing finished yet, waits on the oldest load (which runs it on this thread if no worker has claimed it)
+void AssetLoader::RetrieveDecodedAssets(bool waitForOne)
+{
+	if (waitForOne && !m_loadJobs.empty())
+	{
+		bool isAnyLoadCompleted = false;
+		for (size_t jobIndex = 0; jobIndex < m_loadJobs.size() && !isAnyLoadCompleted; ++jobIndex)
+		{
+			isAnyLoadCompleted = m_loadJobs[jobIndex]->m_status == JOB_STATUS_COMPLETED;
+		}
+		if (!isAnyLoadCompleted)
+		{
+			std::vector<Job*> oldestLoadJob = { m_loadJobs.front() };
+			m_config.m_jobSystem->WaitUntilJobsCompleted(oldestLoadJob);
+		}
+	}
+
+	for (size_t jobIndex = 0; jobIndex < m_loadJobs.size();)
+	{
+		AssetLoadJob* loadJob = m_loadJobs[jobIndex];
+		if (loadJob->m_status == JOB_STATUS_COMPLETED)
+		{
+			// Takes it off the job system's completed list, the job is already done so this does not wait
+			std::vector<Job*> completedLoadJob = { loadJob };
+			m_config.m_jobSystem->WaitUntilJobsCompleted(completedLoadJob);
+		}
+		if (loadJob->m_status != JOB_STATUS_RETRIEVED_AND_RETIRED)
+		{
+			++jobIndex;
+			continue;
+		}
+
+		Asset* asset = loadJob->m_asset;
+		m_loadJobs.erase(m_loadJobs.begin() + jobIndex);
+		delete loadJob;
+
+		bool hasFailed = asset->IsMesh() ? asset->m_indexes.empty() : asset->m_images.empty();
+		if (hasFailed)
+		{
+			DebuggerPrintf("\nAssetLoader: failed to load \"%s\"\n", asset->m_filePath.c_str());
+			asset->m_status = AssetStatus::FAILED;
+			Release(asset);
+			AddFinishedAsset(asset);
+			continue;
+		}
+
+		m_numOfBytesInFlight		-=	asset->m_numOfBytesCharged;
+		asset->m_numOfBytesCharged	=	asset->GetNumOfDecodedBytes();
+		m_numOfBytesInFlight		+=	asset->m_numOfBytesCharged;
+		asset->m_status				=	AssetStatus::DECODED;
+		m_decodedAssets.push_back(asset);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int AssetLoader::CreateDecodedAssets(int maxNumOfAssetsToCreate)
+{
+	int numOfAssetsCreated = 0;
+	while (!m_decodedAssets.empty() && (maxNumOfAssetsToCreate < 0 || numOfAssetsCreated < maxNumOfAssetsToCreate))
+	{
+		Asset* asset = m_decodedAssets.front();
+		m_decodedAssets.pop_front();
+		CreateGPUObjects(asset);
+		asset->m_status = AssetStatus::READY;
+
+		// The loaded callbacks can still read the decoded data, it is freed once they ran
+		if (asset->m_loadedCallbacks.empty())
+		{
+			Release(asset);
+		}
+		AddFinishedAsset(asset);
+		++numOfAssetsCreated;
+	}
+	return numOfAssetsCreated;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AssetLoader::CreateGPUObjects(Asset* asset)
+{
+	Renderer*		renderer		=	m_config.m_renderer;
+	char const*		debugName		=	asset->m_debugName.empty() ? nullptr : asset->m_debugName.c_str();
+	unsigned int	debugNameSize	=	(unsigned int)asset->m_debugName.size();
+	switch (asset->m_type)
+	{
+		case AssetType::TEXTURE:
+		{
+			asset->m_texture = renderer->CreateOrGetTextureFromImage(asset->m_images[0]);
+			break;
+		}
+		case AssetType::TEXTURE_RESOURCE:
+		{
+			asset->m_textureResource = renderer->CreateTextureResourceFromImage(asset->m_images[0], debugName, debugNameSize);
+			break;
+		}
+		case AssetType::TEXTURE_CUBE_RESOURCE:
+		{
+			asset->m_textureResource = renderer->CreateTextureCubeResourceFromImages(asset->m_images.data(), debugName, debugNameSize);
+			break;
+		}
+		case AssetType::MESH:
+		case AssetType::MESH_PCUTBN:
+		case AssetType::MESH_PCUTBN_QUANTIZED:
+		{
+			if (asset->m_type == AssetType::MESH)
+			{
+				asset->m_vertexBuffer = renderer->CreateVertexBuffer(asset->m_verts.size(), sizeof(Vertex_PCU), ResourceUsage::GPU_READ, asset->m_verts.data());
+			}
+			else if (asset->m_type == AssetType::MESH_PCUTBN_QUANTIZED)
+			{
+				asset->m_vertexBuffer = renderer->CreateVertexBuffer(asset->m_quantizedVerts.size(), sizeof(Vertex_PCUTBN_Quantized), ResourceUsage::GPU_READ, asset->m_quantizedVerts.data());
+			}
+			else
+			{
+				asset->m_vertexBuffer = renderer->CreateVertexBuffer(asset->m_pcutbnVerts.size(), sizeof(Vertex_PCUTBN), ResourceUsage::GPU_READ, asset->m_pcutbnVerts.data());
+			}
+			asset->m_indexBuffer	=	renderer->CreateIndexBuffer(asset->m_indexes.size(), ResourceUsage::GPU_READ, asset->m_indexes.data());
+			asset->m_numOfIndexes	=	(unsigned int)asset->m_indexes.size();
+			if (debugName)
+			{
+				std::string vertexBufferName	=	asset->m_debugName + "_VertexBuffer";
+				std::string indexBufferName		=	asset->m_debugName + "_IndexBuffer";
+				renderer->SetDebugResourceName(asset->m_vertexBuffer, (unsigned int)vertexBufferName.size(), vertexBufferName.c_str());
+				renderer->SetDebugResourceName(asset->m_indexBuffer, (unsigned int)indexBufferName.size(), indexBufferName.c_str());
+			}
+			break;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AssetLoader::AddFinishedAsset(Asset* asset)
+{
+	if (!asset->m_loadedCallbacks.empty() && std::find(m_finishedAssets.begin(), m_finishedAssets.end(), asset) == m_finishedAssets.end())
+	{
+		m_finishedAssets.push_back(asset);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Callbacks can request assets, anything that finishes because of that waits for the next call
+void AssetLoader::RunLoadedCallbacks()
+{
+	std::vector<Asset*> finishedAssets;
+	finishedAssets.swap(m_finishedAssets);
+	for (size_t assetIndex = 0; assetIndex < finishedAssets.size(); ++assetIndex)
+	{
+		Asset*								asset			=	finishedAssets[assetIndex];
+		std::vector<AssetLoadedCallback>	loadedCallbacks;
+		loadedCallbacks.swap(asset->m_loadedCallbacks);
+		for (size_t callbackIndex = 0; callbackIndex < loadedCallbacks.size(); ++callbackIndex)
+		{
+			loadedCallbacks[callbackIndex](*asset);
+		}
+		Release(asset);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AssetLoader::Release(Asset* asset)
+{
+	m_numOfBytesInFlight		-=	asset->m_numOfBytesCharged;
+	asset->m_numOfBytesCharged	=	0;
+	asset->FreeDecodedData();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Loads every texture in TextureFolder and every .obj in ModelFolder once on the main thread and once through a private AssetLoader
+// Reports how long the main thread was busy in each case, for the AssetLoader also the longest single Update (the worst frame hitch)
+// Both passes create new GPU resources every time it runs and destroy them before returning
+bool Command_AssetLoaderBenchmark(EventArgs& args)
+{
+	if (!g_theAssetLoader)
+	{
+		PrintBenchmarkResult("AssetLoaderBenchmark needs g_theAssetLoader for its renderer and job system", true);
+		return false;
+	}
+	Renderer*	renderer	=	g_theAssetLoader->GetConfig().m_renderer;
+	JobSystem*	jobSystem	=	g_theAssetLoader->GetConfig().m_jobSystem;
+
+	std::vector<std::string> textureFileNames;
+	std::vector<std::string> modelFileNames;
+	textureFileNames	=	GetFileNamesInFolder(args.GetValue("TextureFolder", "Data/Textures"), { ".png", ".jpg", ".tga" });
+	modelFileNames		=	GetFileNamesInFolder(args.GetValue("ModelFolder", "Data/Models"), { ".obj" });
+	int maxNumOfMegabytesInFlight = args.GetValue("MaxMegabytesInFlight", 64);
+
+	// Cooks the models up front, otherwise whichever pass runs first pays for it
+	for (size_t fileIndex = 0; fileIndex < modelFileNames.size(); ++fileIndex)
+	{
+		std::vector<Vertex_PCU>		verts;
+		std::vector<unsigned int>	indexes;
+		OBJLoader::LoadOBJFileByName(modelFileNames[fileIndex], verts, indexes, Mat44());
+	}
+
+	double timeBeforeBlockingLoads = GetCurrentTimeSeconds();
+	for (size_t fileIndex = 0; fileIndex < textureFileNames.size(); ++fileIndex)
+	{
+		D3D11_Resource* textureResource = renderer->CreateTextureResourceFromFile(textureFileNames[fileIndex].c_str());
+		renderer->DestroyResource(textureResource);
+	}
+	for (size_t fileIndex = 0; fileIndex < modelFileNames.size(); ++fileIndex)
+	{
+		std::vector<Vertex_PCU>		verts;
+		std::vector<unsigned int>	indexes;
+		OBJLoader::LoadOBJFileByName(modelFileNames[fileIndex], verts, indexes, Mat44());
+		VertexBuffer*	vertexBuffer	=	renderer->CreateVertexBuffer(verts.size(), sizeof(Vertex_PCU), ResourceUsage::GPU_READ, verts.data());
+		IndexBuffer*	indexBuffer		=	renderer->CreateIndexBuffer(indexes.size(), ResourceUsage::GPU_READ, indexes.data());
+		delete vertexBuffer;
+		delete indexBuffer;
+	}
+	double blockingSeconds = GetCurrentTimeSeconds() - timeBeforeBlockingLoads;
+
+	AssetLoaderConfig assetLoaderConfig;
+	assetLoaderConfig.m_renderer				=	renderer;
+	assetLoaderConfig.m_jobSystem				=	jobSystem;
+	assetLoaderConfig.m_maxNumOfBytesInFlight	=	(size_t)maxNumOfMegabytesInFlight * 1024 * 1024;
+	AssetLoader assetLoader(assetLoaderConfig);
+	assetLoader.Startup();
+
+	double timeBeforeRequests = GetCurrentTimeSeconds();
+	for (size_t fileIndex = 0; fileIndex < textureFileNames.size(); ++fileIndex)
+	{
+		assetLoader.RequestTextureResource(textureFileNames[fileIndex]);
+	}
+	for (size_t fileIndex = 0; fileIndex < modelFileNames.size(); ++fileIndex)
+	{
+		assetLoader.RequestMesh(modelFileNames[fileIndex], Mat44());
+	}
+	double	mainThreadSeconds		=	GetCurrentTimeSeconds() - timeBeforeRequests;
+	double	longestUpdateSeconds	=	0.0;
+	size_t	maxNumOfBytesInFlight	=	assetLoader.GetNumOfBytesInFlight();
+	int		numOfUpdates			=	0;
+	while (assetLoader.GetNumOfAssetsInFlight() > 0)
+	{
+		double timeBeforeUpdate = GetCurrentTimeSeconds();
+		assetLoader.Update();
+		double updateSeconds	=	GetCurrentTimeSeconds() - timeBeforeUpdate;
+		mainThreadSeconds		+=	updateSeconds;
+		longestUpdateSeconds	=	std::max(longestUpdateSeconds, updateSeconds);
+		maxNumOfBytesInFlight	=	std::max(maxNumOfBytesInFlight, assetLoader.GetNumOfBytesInFlight());
+		++numOfUpdates;
+
+		// Stands in for the rest of a frame
+		std::this_thread::yield();
+	}
+	double asyncSeconds = GetCurrentTimeSeconds() - timeBeforeRequests;
+	assetLoader.Shutdown();
+
+	PrintBenchmarkResult(Stringf("%d textures, %d models, %d job workers, cap %d MB", (int)textureFileNames.size(), (int)modelFileNames.size(), jobSystem->GetNumOfWorkerThreads(), maxNumOfMegabytesInFlight));
+	PrintBenchmarkResult(Stringf("Blocking loads:  main thread busy %.2f ms", blockingSeconds * 1000.0));
+	PrintBenchmarkResult(Stringf("AssetLoader:     main thread busy %.2f ms over %d updates, longest update %.2f ms, done after %.2f ms, peak %.2f MB in flight",
+								 mainThreadSeconds * 1000.0, numOfUpdates, longestUpdateSeconds * 1000.0, asyncSeconds * 1000.0, (double)maxNumOfBytesInFlight / (1024.0 * 1024.0)));
+	return true;
+}
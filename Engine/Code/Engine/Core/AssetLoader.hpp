@@ -0,0 +1,196 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Core/Vertex_PCUTBN_Quantized.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Mat44.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <functional>
+#include <vector>
+#include <string>
+#include <deque>
+
+
+//--------------------------------------------------------------------------------------------------
+class AssetLoader;
+class AssetLoadJob;
+class D3D11_Resource;
+class VertexBuffer;
+class IndexBuffer;
+class JobSystem;
+class Renderer;
+class Texture;
+
+
+//--------------------------------------------------------------------------------------------------
+extern AssetLoader* g_theAssetLoader;
+
+
+//--------------------------------------------------------------------------------------------------
+class Asset;
+typedef std::function<void(Asset const& asset)> AssetLoadedCallback;		// Runs on the main thread once the asset is READY or FAILED
+
+
+//--------------------------------------------------------------------------------------------------
+enum class AssetType : unsigned char
+{
+	TEXTURE,					// Renderer::CreateOrGetTextureFromFile
+	TEXTURE_RESOURCE,			// Renderer::CreateTextureResourceFromFile
+	TEXTURE_CUBE_RESOURCE,		// Renderer::CreateTextureCubeResourceFromFile
+	MESH,						// OBJLoader::LoadOBJFileByName into a Vertex_PCU vertex buffer and an index buffer
+	MESH_PCUTBN,				// The same with Vertex_PCUTBN verts, normals and tangents included
+	MESH_PCUTBN_QUANTIZED,		// The Vertex_PCUTBN verts quantized into a Vertex_PCUTBN_Quantized vertex buffer, see VertexQuantization.hpp
+};
+
+
+//--------------------------------------------------------------------------------------------------
+enum class AssetStatus : unsigned char
+{
+	PENDING,		// Waiting for room under the in flight byte cap
+	LOADING,		// Read and decoded by a job
+	DECODED,		// Waiting for the main thread to create the GPU objects
+	READY,
+	FAILED,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Owned by the AssetLoader, the getters hand out placeholders until the asset is READY (and keep doing so if it FAILED)
+// Texture placeholders are white, mesh placeholders have no buffers and 0 indexes so they draw nothing
+class Asset
+{
+	friend class AssetLoader;
+	friend class AssetLoadJob;
+
+public:
+	AssetType			GetType() const;
+	AssetStatus			GetStatus() const;
+	bool				IsReady() const;
+	bool				IsFinished() const;		// READY or FAILED
+	bool				IsMesh() const;
+	std::string const&	GetFilePath() const;
+
+	Texture*			GetTexture() const;
+	D3D11_Resource*		GetTextureResource() const;
+	VertexBuffer*		GetVertexBuffer() const;
+	IndexBuffer*		GetIndexBuffer() const;
+	unsigned int		GetNumOfIndexes() const;
+	Mat44				GetDequantizationMatrix() const;		// Append to the model matrix of MESH_PCUTBN_QUANTIZED draws, identity for every other asset
+
+	// The decoded mesh, only there during the loaded callbacks of the Update it became READY in
+	std::vector<Vertex_PCU> const&		GetDecodedVerts() const;
+	std::vector<Vertex_PCUTBN> const&	GetDecodedPCUTBNVerts() const;
+	std::vector<unsigned int> const&	GetDecodedIndexes() const;
+
+private:
+	Asset(AssetType type, std::string const& filePath, std::string const& debugName, AssetLoader* owner);
+	Asset(Asset const& copyFrom) = delete;
+	~Asset();
+
+	size_t				GetNumOfDecodedBytes() const;
+	void				FreeDecodedData();
+
+private:
+	AssetLoader*		m_owner						=	nullptr;
+	AssetType			m_type						=	AssetType::TEXTURE;
+	AssetStatus			m_status					=	AssetStatus::PENDING;
+	std::string			m_filePath;
+	std::string			m_debugName;
+	Mat44				m_transformFixUpMat;
+	size_t				m_numOfBytesCharged			=	0;		// What this asset currently counts against the in flight byte cap
+	std::vector<AssetLoadedCallback>	m_loadedCallbacks;			// Cleared once they ran
+
+	// Filled in by the load job, freed once the GPU objects exist
+	std::vector<Image>			m_images;
+	std::vector<Vertex_PCU>		m_verts;
+	std::vector<Vertex_PCUTBN>	m_pcutbnVerts;
+	std::vector<Vertex_PCUTBN_Quantized>	m_quantizedVerts;
+	std::vector<unsigned int>	m_indexes;
+	AABB3						m_quantizationBounds;
+
+	// Created on the main thread
+	Texture*			m_texture					=	nullptr;
+	D3D11_Resource*		m_textureResource			=	nullptr;
+	VertexBuffer*		m_vertexBuffer				=	nullptr;
+	IndexBuffer*		m_indexBuffer				=	nullptr;
+	unsigned int		m_numOfIndexes				=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct AssetLoaderConfig
+{
+	Renderer*	m_renderer							=	nullptr;
+	JobSystem*	m_jobSystem							=	nullptr;
+	size_t		m_maxNumOfBytesInFlight				=	256 * 1024 * 1024;	// Read, decoded and not yet on the GPU, a single asset over the cap still loads on its own
+	int			m_maxNumOfAssetsCreatedPerFrame		=	4;					// GPU creations per Update, -1 for no limit
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Reads and decodes assets on the job system and creates their GPU objects on the main thread in Update
+// Requests for a file that was already requested return the same asset, meshes are keyed on their fix-up transform as well
+// With no job workers Update runs one load on the main thread per frame instead
+class AssetLoader
+{
+public:
+	AssetLoader(AssetLoaderConfig const& config);
+	~AssetLoader();
+
+	void		Startup();
+	void		Update();
+	void		Shutdown();
+
+	// onLoaded runs from a later Update (or WaitUntilAllLoaded) once the asset is READY or FAILED, even when it already was
+	Asset*		RequestTexture(std::string const& imageFilePath, AssetLoadedCallback const& onLoaded = nullptr);
+	Asset*		RequestTextureResource(std::string const& imageFilePath, std::string const& debugName = "", AssetLoadedCallback const& onLoaded = nullptr);
+	Asset*		RequestTextureCubeResource(std::string const& cubeMapDir, std::string const& debugName = "", AssetLoadedCallback const& onLoaded = nullptr);
+	Asset*		RequestMesh(std::string const& objFilePath, Mat44 const& transformFixUpMat, std::string const& debugName = "", AssetLoadedCallback const& onLoaded = nullptr);
+	Asset*		RequestMeshPCUTBN(std::string const& objFilePath, Mat44 const& transformFixUpMat, std::string const& debugName = "", AssetLoadedCallback const& onLoaded = nullptr);
+	Asset*		RequestMeshPCUTBNQuantized(std::string const& objFilePath, Mat44 const& transformFixUpMat, std::string const& debugName = "", AssetLoadedCallback const& onLoaded = nullptr);
+
+	// Blocks until every request so far is READY or FAILED and their loaded callbacks ran, ignoring the per frame creation limit
+	void		WaitUntilAllLoaded();
+
+	int			GetNumOfAssetsInFlight() const;		// PENDING, LOADING or DECODED
+	size_t		GetNumOfBytesInFlight() const;
+	AssetLoaderConfig const& GetConfig() const;
+
+	Texture*		GetPlaceholderTexture() const;
+	D3D11_Resource*	GetPlaceholderTextureResource() const;
+	D3D11_Resource*	GetPlaceholderTextureCubeResource() const;
+
+private:
+	Asset*		RequestAsset(AssetType type, std::string const& filePath, std::string const& debugName, Mat44 const& transformFixUpMat, AssetLoadedCallback const& onLoaded);
+	void		AddFinishedAsset(Asset* asset);
+	void		RunLoadedCallbacks();
+	bool		CanStartLoading(Asset const* asset) const;
+	void		StartPendingLoads();
+	void		RetrieveDecodedAssets(bool waitForOne);
+	int			CreateDecodedAssets(int maxNumOfAssetsToCreate);
+	void		CreateGPUObjects(Asset* asset);
+	void		Release(Asset* asset);
+
+private:
+	AssetLoaderConfig				m_config;
+	std::vector<Asset*>				m_assets;
+	std::deque<Asset*>				m_pendingAssets;
+	std::vector<AssetLoadJob*>		m_loadJobs;
+	std::deque<Asset*>				m_decodedAssets;
+	std::vector<Asset*>				m_finishedAssets;					// Became READY or FAILED, or were requested again once they were, waiting on their loaded callbacks
+	size_t							m_numOfBytesInFlight				=	0;
+	D3D11_Resource*					m_placeholderTextureResource		=	nullptr;
+	D3D11_Resource*					m_placeholderTextureCubeResource	=	nullptr;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_AssetLoaderBenchmark(EventArgs& args);
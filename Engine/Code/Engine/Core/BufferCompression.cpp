@@ -0,0 +1,1037 @@
+#include "Engine/Core/BufferCompression.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/HashUtils.hpp"
+#include "Engine/Core/OBJLoader.hpp"
+#include "Engine/Core/Image.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <intrin.h>
+#include <algorithm>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// The LZ4 block format: every sequence is a token byte holding the number of literals (high 4 bits) and the match length - 4 (low 4 bits),
+// extra literal count bytes, the literals, a 16 bit match offset and extra match length bytes; a count of 15 continues in bytes of 255
+// The last sequence stops after its literals
+static constexpr size_t		MIN_MATCH_LENGTH			=	4;
+static constexpr size_t		NUM_OF_LAST_LITERALS		=	5;		// The last 5 bytes of a block are always literals
+static constexpr size_t		MATCH_FIND_LIMIT			=	12;		// and no match starts in its last 12, which keeps the decoder's wild copies short of the end
+static constexpr size_t		MAX_MATCH_OFFSET			=	65535;
+static constexpr int		HASH_TABLE_LOG				=	12;		// 16 KB of positions, small enough to stay in L1
+static constexpr int		SKIP_TRIGGER				=	6;		// Every 64 lookups without a match the search step grows by a byte
+static constexpr size_t		WILD_COPY_LENGTH			=	16;
+static constexpr size_t		FAR_REPEAT_OFFSET			=	64;
+static constexpr uint32_t	STORED_BLOCK_FLAG			=	0x80000000u;
+static constexpr uint8_t	BLOCK_CHECKSUMS_FLAG		=	0x01;
+static constexpr uint8_t	CONTENT_CHECKSUM_FLAG		=	0x02;
+
+
+//--------------------------------------------------------------------------------------------------
+// The codec's own loads are native, which is little endian on every platform the engine runs on
+static uint32_t ReadUInt32(unsigned char const* bytes)
+{
+	uint32_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint64_t ReadUInt64(unsigned char const* bytes)
+{
+	uint64_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Frame fields are spelled out byte by byte so the format stays little endian regardless
+static uint32_t ReadUInt32LittleEndian(unsigned char const* bytes)
+{
+	return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void WriteUInt32LittleEndian(unsigned char* bytes, uint32_t value)
+{
+	bytes[0] = (unsigned char)value;
+	bytes[1] = (unsigned char)(value >> 8);
+	bytes[2] = (unsigned char)(value >> 16);
+	bytes[3] = (unsigned char)(value >> 24);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashSequence(uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - HASH_TABLE_LOG);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// How many bytes starting at bytesA match the ones at bytesB, stopping at bytesALimit
+static size_t CountMatchingBytes(unsigned char const* bytesA, unsigned char const* bytesB, unsigned char const* bytesALimit)
+{
+	unsigned char const* bytesAStart = bytesA;
+	while (bytesA + sizeof(uint64_t) <= bytesALimit)
+	{
+		uint64_t differentBits = ReadUInt64(bytesA) ^ ReadUInt64(bytesB);
+		if (differentBits != 0)
+		{
+			unsigned long firstDifferentBit = 0;
+			_BitScanForward64(&firstDifferentBit, differentBits);
+			return (size_t)(bytesA - bytesAStart) + (firstDifferentBit >> 3);
+		}
+		bytesA += sizeof(uint64_t);
+		bytesB += sizeof(uint64_t);
+	}
+	while (bytesA < bytesALimit && *bytesA == *bytesB)
+	{
+		++bytesA;
+		++bytesB;
+	}
+	return (size_t)(bytesA - bytesAStart);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The remainder of a literal count or match length past the 15 in the token
+static unsigned char* WriteExtraLength(unsigned char* writePos, size_t extraLength)
+{
+	for (; extraLength >= 255; extraLength -= 255)
+	{
+		*writePos++ = 255;
+	}
+	*writePos++ = (unsigned char)extraLength;
+	return writePos;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Returns nullptr when the sequence would not fit before outputEnd, a matchLength of 0 writes the literals only sequence that ends a block
+static unsigned char* WriteSequence(unsigned char* writePos, unsigned char const* outputEnd, unsigned char const* literals, size_t numOfLiterals, size_t matchOffset, size_t matchLength)
+{
+	size_t maxNumOfSequenceBytes = 1 + (numOfLiterals / 255 + 1) + numOfLiterals + 2 + (matchLength / 255 + 1);
+	if (maxNumOfSequenceBytes > (size_t)(outputEnd - writePos))
+	{
+		return nullptr;
+	}
+
+	size_t				matchLengthCode	=	matchLength > 0 ? matchLength - MIN_MATCH_LENGTH : 0;
+	unsigned char*		token			=	writePos++;
+	*token = (unsigned char)((std::min<size_t>(numOfLiterals, 15) << 4) | std::min<size_t>(matchLengthCode, 15));
+	if (numOfLiterals >= 15)
+	{
+		writePos = WriteExtraLength(writePos, numOfLiterals - 15);
+	}
+	memcpy(writePos, literals, numOfLiterals);
+	writePos += numOfLiterals;
+	if (matchLength == 0)
+	{
+		return writePos;
+	}
+
+	*writePos++ = (unsigned char)matchOffset;
+	*writePos++ = (unsigned char)(matchOffset >> 8);
+	if (matchLengthCode >= 15)
+	{
+		writePos = WriteExtraLength(writePos, matchLengthCode - 15);
+	}
+	return writePos;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t GetMaxCompressedBlockSize(size_t numOfSourceBytes)
+{
+	return numOfSourceBytes + numOfSourceBytes / 255 + 16;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Greedy single probe matching like LZ4's fast mode: a hash of the next 4 bytes finds the last position that started with them
+size_t CompressBlock(unsigned char const* source, size_t numOfSourceBytes, unsigned char* out_destination, size_t destinationCapacity, int acceleration)
+{
+	GUARANTEE_OR_DIE(numOfSourceBytes <= 0xFFFFFFFFu, "CompressBlock keeps 32 bit positions, split the data into smaller blocks");
+	unsigned char*			writePos	=	out_destination;
+	unsigned char const*	outputEnd	=	out_destination + destinationCapacity;
+	unsigned char const*	anchor		=	source;
+	if (numOfSourceBytes > MATCH_FIND_LIMIT)
+	{
+		uint32_t				hashTable[1 << HASH_TABLE_LOG]	=	{ };
+		unsigned char const*	matchFindLimit					=	source + numOfSourceBytes - MATCH_FIND_LIMIT;
+		unsigned char const*	matchLimit						=	source + numOfSourceBytes - NUM_OF_LAST_LITERALS;
+		size_t					firstSearchCount				=	(size_t)std::max(acceleration, 1) << SKIP_TRIGGER;
+		size_t					searchCount						=	firstSearchCount;
+		unsigned char const*	readPos							=	source + 1;
+		while (readPos <= matchFindLimit)
+		{
+			uint32_t				sequence	=	ReadUInt32(readPos);
+			uint32_t				hash		=	HashSequence(sequence);
+			unsigned char const*	match		=	source + hashTable[hash];
+			hashTable[hash] = (uint32_t)(readPos - source);
+			if ((size_t)(readPos - match) > MAX_MATCH_OFFSET || ReadUInt32(match) != sequence)
+			{
+				readPos += searchCount++ >> SKIP_TRIGGER;
+				continue;
+			}
+
+			while (readPos > anchor && match > source && readPos[-1] == match[-1])
+			{
+				--readPos;
+				--match;
+			}
+			size_t matchLength = MIN_MATCH_LENGTH + CountMatchingBytes(readPos + MIN_MATCH_LENGTH, match + MIN_MATCH_LENGTH, matchLimit);
+			writePos = WriteSequence(writePos, outputEnd, anchor, (size_t)(readPos - anchor), (size_t)(readPos - match), matchLength);
+			if (writePos == nullptr)
+			{
+				return 0;
+			}
+
+			readPos			+=	matchLength;
+			anchor			=	readPos;
+			searchCount		=	firstSearchCount;
+			if (readPos <= matchFindLimit)
+			{
+				hashTable[HashSequence(ReadUInt32(readPos - 2))] = (uint32_t)(readPos - 2 - source);
+			}
+		}
+	}
+
+	writePos = WriteSequence(writePos, outputEnd, anchor, (size_t)(source + numOfSourceBytes - anchor), 0, 0);
+	return writePos != nullptr ? (size_t)(writePos - out_destination) : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Adds the extra length bytes after a 15 in the token, false if they run past sourceEnd
+static bool ReadExtraLength(unsigned char const*& readPos, unsigned char const* sourceEnd, size_t& length)
+{
+	unsigned char lengthByte = 255;
+	while (lengthByte == 255)
+	{
+		if (readPos >= sourceEnd)
+		{
+			return false;
+		}
+		lengthByte = *readPos++;
+		length += lengthByte;
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Copies in WILD_COPY_LENGTH chunks that may run up to WILD_COPY_LENGTH - 1 bytes past numOfBytes, the two ranges have to be at least a chunk apart
+static void WildCopy(unsigned char* destination, unsigned char const* source, size_t numOfBytes)
+{
+	for (size_t byteIndex = 0; byteIndex < numOfBytes; byteIndex += WILD_COPY_LENGTH)
+	{
+		memcpy(destination + byteIndex, source + byteIndex, WILD_COPY_LENGTH);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Every length and offset is checked against both ends, the wild copies are only taken when a whole chunk fits
+// Literals are read strictly ahead of where they get written, which is what lets DecompressFrameInPlace decode into the memory the frame sits in
+bool DecompressBlock(unsigned char const* source, size_t numOfSourceBytes, unsigned char* out_destination, size_t destinationCapacity, size_t& out_numOfBytesWritten)
+{
+	unsigned char const*	readPos		=	source;
+	unsigned char const*	sourceEnd	=	source + numOfSourceBytes;
+	unsigned char*			writePos	=	out_destination;
+	unsigned char*			outputEnd	=	out_destination + destinationCapacity;
+	out_numOfBytesWritten = 0;
+	for (;;)
+	{
+		if (readPos >= sourceEnd)
+		{
+			return false;
+		}
+		unsigned char	token			=	*readPos++;
+		size_t			numOfLiterals	=	token >> 4;
+		if (numOfLiterals == 15 && !ReadExtraLength(readPos, sourceEnd, numOfLiterals))
+		{
+			return false;
+		}
+		if (numOfLiterals > (size_t)(sourceEnd - readPos) || numOfLiterals > (size_t)(outputEnd - writePos))
+		{
+			return false;
+		}
+		if (numOfLiterals + WILD_COPY_LENGTH <= (size_t)(sourceEnd - readPos) && numOfLiterals + WILD_COPY_LENGTH <= (size_t)(outputEnd - writePos))
+		{
+			WildCopy(writePos, readPos, numOfLiterals);
+		}
+		else
+		{
+			memmove(writePos, readPos, numOfLiterals);
+		}
+		readPos		+=	numOfLiterals;
+		writePos	+=	numOfLiterals;
+		if (readPos == sourceEnd)
+		{
+			break;
+		}
+
+		if (sourceEnd - readPos < 2)
+		{
+			return false;
+		}
+		size_t matchOffset = (size_t)readPos[0] | ((size_t)readPos[1] << 8);
+		readPos += 2;
+		size_t matchLength = (token & 15) + MIN_MATCH_LENGTH;
+		if ((token & 15) == 15 && !ReadExtraLength(readPos, sourceEnd, matchLength))
+		{
+			return false;
+		}
+		if (matchOffset == 0 || matchOffset > (size_t)(writePos - out_destination) || matchLength > (size_t)(outputEnd - writePos))
+		{
+			return false;
+		}
+
+		unsigned char const*	match				=	writePos - matchOffset;
+		bool					hasRoomForWildCopy	=	matchLength + WILD_COPY_LENGTH <= (size_t)(outputEnd - writePos);
+		if (matchOffset >= WILD_COPY_LENGTH && hasRoomForWildCopy)
+		{
+			WildCopy(writePos, match, matchLength);
+		}
+		else
+		{
+			// Overlapping matches repeat every matchOffset bytes, so once a repeat is written the rest copies from a whole number of repeats back
+			// With room for it the first 64 bytes go 8 at a time, after that each copy takes everything written so far, doubling until the match is done
+			size_t numOfBytesCopied = 0;
+			if (hasRoomForWildCopy)
+			{
+				if (matchOffset < sizeof(uint64_t))
+				{
+					for (; numOfBytesCopied < sizeof(uint64_t); ++numOfBytesCopied)
+					{
+						writePos[numOfBytesCopied] = match[numOfBytesCopied];
+					}
+				}
+				size_t repeatOffset = matchOffset * ((sizeof(uint64_t) + matchOffset - 1) / matchOffset);
+				for (; numOfBytesCopied < matchLength && numOfBytesCopied < FAR_REPEAT_OFFSET; numOfBytesCopied += sizeof(uint64_t))
+				{
+					memcpy(writePos + numOfBytesCopied, writePos + numOfBytesCopied - repeatOffset, sizeof(uint64_t));
+				}
+			}
+			else
+			{
+				numOfBytesCopied = std::min(matchOffset, matchLength);
+				memcpy(writePos, match, numOfBytesCopied);
+			}
+			while (numOfBytesCopied < matchLength)
+			{
+				size_t repeatDistance		=	numOfBytesCopied - numOfBytesCopied % matchOffset;
+				size_t numOfBytesToCopy		=	std::min(repeatDistance, matchLength - numOfBytesCopied);
+				memcpy(writePos + numOfBytesCopied, writePos + numOfBytesCopied - repeatDistance, numOfBytesToCopy);
+				numOfBytesCopied += numOfBytesToCopy;
+			}
+		}
+		writePos += matchLength;
+	}
+
+	out_numOfBytesWritten = (size_t)(writePos - out_destination);
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint8_t GetBlockSizeLog2(uint32_t blockSize)
+{
+	uint8_t blockSizeLog2 = 0;
+	while (((uint32_t)1 << blockSizeLog2) < blockSize)
+	{
+		++blockSizeLog2;
+	}
+	return blockSizeLog2;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void ValidateCompressionConfig(CompressionConfig const& config)
+{
+	bool isPowerOfTwo = (config.m_blockSize & (config.m_blockSize - 1)) == 0;
+	GUARANTEE_OR_DIE(isPowerOfTwo && config.m_blockSize >= COMPRESSED_FRAME_MIN_BLOCK_SIZE && config.m_blockSize <= COMPRESSED_FRAME_MAX_BLOCK_SIZE,
+					 Stringf("Compression block size %u has to be a power of two from 64 KB to 4 MB", config.m_blockSize));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void WriteFrameHeader(unsigned char* out_header, CompressionConfig const& config, uint64_t numOfDecompressedBytes)
+{
+	WriteUInt32LittleEndian(out_header, COMPRESSED_FRAME_FOURCC);
+	out_header[4]	=	COMPRESSED_FRAME_VERSION;
+	out_header[5]	=	(config.m_hasBlockChecksums ? BLOCK_CHECKSUMS_FLAG : 0) | (config.m_hasContentChecksum ? CONTENT_CHECKSUM_FLAG : 0);
+	out_header[6]	=	GetBlockSizeLog2(config.m_blockSize);
+	out_header[7]	=	0;
+	WriteUInt32LittleEndian(out_header + 8, (uint32_t)numOfDecompressedBytes);
+	WriteUInt32LittleEndian(out_header + 12, (uint32_t)(numOfDecompressedBytes >> 32));
+	WriteUInt32LittleEndian(out_header + 16, ComputeCRC32C(out_header, 16));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static size_t GetMaxFrameBlockSize(size_t numOfBlockBytes)
+{
+	return 4 + numOfBlockBytes + 4;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Writes the block header, the block and its checksum, returns how many bytes that took
+// The block is stored as is when compressing it would not make it smaller, so a block never grows by more than its header and checksum
+static size_t WriteFrameBlock(unsigned char const* block, size_t numOfBlockBytes, unsigned char* out_frameBlock, CompressionConfig const& config)
+{
+	unsigned char*	storedBytes		=	out_frameBlock + 4;
+	size_t			numOfStoredBytes	=	CompressBlock(block, numOfBlockBytes, storedBytes, numOfBlockBytes - 1, config.m_acceleration);
+	uint32_t		blockHeader		=	(uint32_t)numOfStoredBytes;
+	if (numOfStoredBytes == 0)
+	{
+		memcpy(storedBytes, block, numOfBlockBytes);
+		numOfStoredBytes	=	numOfBlockBytes;
+		blockHeader			=	(uint32_t)numOfBlockBytes | STORED_BLOCK_FLAG;
+	}
+	WriteUInt32LittleEndian(out_frameBlock, blockHeader);
+	if (!config.m_hasBlockChecksums)
+	{
+		return 4 + numOfStoredBytes;
+	}
+	WriteUInt32LittleEndian(storedBytes + numOfStoredBytes, ComputeCRC32C(storedBytes, numOfStoredBytes));
+	return 4 + numOfStoredBytes + 4;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static size_t WriteFrameEnd(unsigned char* out_frameEnd, CompressionConfig const& config, uint32_t contentChecksum)
+{
+	WriteUInt32LittleEndian(out_frameEnd, 0);
+	if (!config.m_hasContentChecksum)
+	{
+		return 4;
+	}
+	WriteUInt32LittleEndian(out_frameEnd + 4, contentChecksum);
+	return 8;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Reads the block at readPosition into out_destination and moves readPosition past it, out_isEndMark is set instead when it is the end mark
+static bool ReadFrameBlock(unsigned char const* frame, size_t frameSize, size_t& readPosition, CompressedFrameInfo const& info, unsigned char* out_destination,
+						   size_t destinationCapacity, size_t& out_numOfBytes, bool& out_isEndMark)
+{
+	out_numOfBytes	=	0;
+	out_isEndMark	=	false;
+	if (frameSize - readPosition < 4)
+	{
+		return false;
+	}
+	uint32_t blockHeader = ReadUInt32LittleEndian(frame + readPosition);
+	if (blockHeader == 0)
+	{
+		out_isEndMark = true;
+		readPosition += 4;
+		return true;
+	}
+
+	size_t	numOfStoredBytes	=	blockHeader & ~STORED_BLOCK_FLAG;
+	size_t	numOfChecksumBytes	=	info.m_hasBlockChecksums ? 4 : 0;
+	if (numOfStoredBytes > info.m_blockSize || frameSize - readPosition - 4 < numOfStoredBytes + numOfChecksumBytes)
+	{
+		return false;
+	}
+	unsigned char const* storedBytes = frame + readPosition + 4;
+	if (info.m_hasBlockChecksums && ComputeCRC32C(storedBytes, numOfStoredBytes) != ReadUInt32LittleEndian(storedBytes + numOfStoredBytes))
+	{
+		return false;
+	}
+	readPosition += 4 + numOfStoredBytes + numOfChecksumBytes;
+
+	if ((blockHeader & STORED_BLOCK_FLAG) == 0)
+	{
+		return DecompressBlock(storedBytes, numOfStoredBytes, out_destination, destinationCapacity, out_numOfBytes) && out_numOfBytes > 0;
+	}
+	if (numOfStoredBytes == 0 || numOfStoredBytes > destinationCapacity)
+	{
+		return false;
+	}
+	memmove(out_destination, storedBytes, numOfStoredBytes);
+	out_numOfBytes = numOfStoredBytes;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool ReadFrameEnd(unsigned char const* frame, size_t frameSize, size_t readPosition, CompressedFrameInfo const& info, uint32_t contentChecksum)
+{
+	if (!info.m_hasContentChecksum)
+	{
+		return true;
+	}
+	return frameSize - readPosition >= 4 && ReadUInt32LittleEndian(frame + readPosition) == contentChecksum;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// out_destination may overlap the frame as long as it starts at least the in place margin ahead of it, see GetInPlaceDecompressionBufferSize
+static bool DecompressFrameBlocks(unsigned char const* frame, size_t frameSize, unsigned char* out_destination, CompressedFrameInfo const& info)
+{
+	size_t		readPosition		=	COMPRESSED_FRAME_HEADER_SIZE;
+	uint64_t	numOfBytesWritten	=	0;
+	uint32_t	contentChecksum		=	0;
+	for (;;)
+	{
+		unsigned char*	blockDestination	=	out_destination + numOfBytesWritten;
+		size_t			blockCapacity		=	(size_t)std::min<uint64_t>(info.m_blockSize, info.m_numOfDecompressedBytes - numOfBytesWritten);
+		size_t			numOfBlockBytes		=	0;
+		bool			isEndMark			=	false;
+		if (!ReadFrameBlock(frame, frameSize, readPosition, info, blockDestination, blockCapacity, numOfBlockBytes, isEndMark))
+		{
+			return false;
+		}
+		if (isEndMark)
+		{
+			break;
+		}
+		if (info.m_hasContentChecksum)
+		{
+			contentChecksum = ComputeCRC32C(blockDestination, numOfBlockBytes, contentChecksum);
+		}
+		numOfBytesWritten += numOfBlockBytes;
+	}
+	return numOfBytesWritten == info.m_numOfDecompressedBytes && ReadFrameEnd(frame, frameSize, readPosition, info, contentChecksum);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t GetMaxCompressedFrameSize(size_t numOfSourceBytes, CompressionConfig const& config)
+{
+	size_t numOfBlocks = (numOfSourceBytes + config.m_blockSize - 1) / config.m_blockSize;
+	return COMPRESSED_FRAME_HEADER_SIZE + numOfSourceBytes + numOfBlocks * GetMaxFrameBlockSize(0) + 8;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Returns 0 when frameCapacity is under GetMaxCompressedFrameSize
+size_t CompressFrame(unsigned char const* source, size_t numOfSourceBytes, unsigned char* out_frame, size_t frameCapacity, CompressionConfig const& config)
+{
+	ValidateCompressionConfig(config);
+	if (frameCapacity < GetMaxCompressedFrameSize(numOfSourceBytes, config))
+	{
+		return 0;
+	}
+
+	WriteFrameHeader(out_frame, config, numOfSourceBytes);
+	size_t		writePosition		=	COMPRESSED_FRAME_HEADER_SIZE;
+	uint32_t	contentChecksum		=	0;
+	for (size_t blockStart = 0; blockStart < numOfSourceBytes; blockStart += config.m_blockSize)
+	{
+		size_t numOfBlockBytes = std::min<size_t>(config.m_blockSize, numOfSourceBytes - blockStart);
+		if (config.m_hasContentChecksum)
+		{
+			contentChecksum = ComputeCRC32C(source + blockStart, numOfBlockBytes, contentChecksum);
+		}
+		writePosition += WriteFrameBlock(source + blockStart, numOfBlockBytes, out_frame + writePosition, config);
+	}
+	writePosition += WriteFrameEnd(out_frame + writePosition, config, contentChecksum);
+	return writePosition;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool GetCompressedFrameInfo(unsigned char const* frame, size_t frameSize, CompressedFrameInfo& out_info)
+{
+	if (frameSize < COMPRESSED_FRAME_HEADER_SIZE || ReadUInt32LittleEndian(frame) != COMPRESSED_FRAME_FOURCC || frame[4] != COMPRESSED_FRAME_VERSION)
+	{
+		return false;
+	}
+	if (ComputeCRC32C(frame, 16) != ReadUInt32LittleEndian(frame + 16))
+	{
+		return false;
+	}
+	uint8_t blockSizeLog2 = frame[6];
+	if (blockSizeLog2 < GetBlockSizeLog2(COMPRESSED_FRAME_MIN_BLOCK_SIZE) || blockSizeLog2 > GetBlockSizeLog2(COMPRESSED_FRAME_MAX_BLOCK_SIZE))
+	{
+		return false;
+	}
+	out_info.m_numOfDecompressedBytes	=	(uint64_t)ReadUInt32LittleEndian(frame + 8) | ((uint64_t)ReadUInt32LittleEndian(frame + 12) << 32);
+	out_info.m_blockSize				=	(uint32_t)1 << blockSizeLog2;
+	out_info.m_hasBlockChecksums		=	(frame[5] & BLOCK_CHECKSUMS_FLAG) != 0;
+	out_info.m_hasContentChecksum		=	(frame[5] & CONTENT_CHECKSUM_FLAG) != 0;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool DecompressFrame(unsigned char const* frame, size_t frameSize, unsigned char* out_destination, size_t destinationCapacity)
+{
+	CompressedFrameInfo info;
+	if (!GetCompressedFrameInfo(frame, frameSize, info) || info.m_numOfDecompressedBytes > destinationCapacity)
+	{
+		return false;
+	}
+	return DecompressFrameBlocks(frame, frameSize, out_destination, info);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The writes never catch up with the reads: a frame's remaining bytes outgrow what they decompress to by at most a 255th
+// (literal runs) plus the block headers and checksums, and the margin is well over that plus a wild copy
+size_t GetInPlaceDecompressionBufferSize(uint64_t numOfDecompressedBytes)
+{
+	return (size_t)(numOfDecompressedBytes + (numOfDecompressedBytes >> 7) + 256);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool DecompressFrameInPlace(unsigned char* buffer, size_t bufferSize, size_t frameSize)
+{
+	if (frameSize > bufferSize)
+	{
+		return false;
+	}
+	unsigned char const*	frame	=	buffer + bufferSize - frameSize;
+	CompressedFrameInfo		info;
+	if (!GetCompressedFrameInfo(frame, frameSize, info) || bufferSize < GetInPlaceDecompressionBufferSize(info.m_numOfDecompressedBytes))
+	{
+		return false;
+	}
+	return DecompressFrameBlocks(frame, frameSize, buffer, info);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CompressBuffer(Buffer const& source, Buffer& out_frame, CompressionConfig const& config)
+{
+	out_frame.resize(GetMaxCompressedFrameSize(source.size(), config));
+	size_t frameSize = CompressFrame(source.data(), source.size(), out_frame.data(), out_frame.size(), config);
+	out_frame.resize(frameSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool DecompressBuffer(Buffer const& frame, Buffer& out_decompressed)
+{
+	CompressedFrameInfo info;
+	if (!GetCompressedFrameInfo(frame.data(), frame.size(), info))
+	{
+		out_decompressed.clear();
+		return false;
+	}
+	out_decompressed.resize((size_t)info.m_numOfDecompressedBytes);
+	if (!DecompressFrameBlocks(frame.data(), frame.size(), out_decompressed.data(), info))
+	{
+		out_decompressed.clear();
+		return false;
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void FileWriteFromBufferCompressed(Buffer const& inBuffer, std::string const& fileName, CompressionConfig const& config)
+{
+	Buffer frame;
+	CompressBuffer(inBuffer, frame, config);
+	FileWriteFromBuffer(frame, fileName);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Reads the frame straight into the tail of the buffer it decompresses into
+bool FileReadToBufferDecompressed(Buffer& out_buffer, std::string const& fileName)
+{
+	out_buffer.clear();
+	FILE* fileStreamPtr = nullptr;
+	if (fopen_s(&fileStreamPtr, fileName.c_str(), "rb") != 0 || fileStreamPtr == nullptr)
+	{
+		return false;
+	}
+	fseek(fileStreamPtr, 0, SEEK_END);
+	size_t frameSize = (size_t)ftell(fileStreamPtr);
+	fseek(fileStreamPtr, 0, SEEK_SET);
+
+	unsigned char		header[COMPRESSED_FRAME_HEADER_SIZE];
+	CompressedFrameInfo	info;
+	bool isValid = fread(header, 1, sizeof(header), fileStreamPtr) == sizeof(header) && GetCompressedFrameInfo(header, frameSize, info);
+	if (isValid)
+	{
+		size_t bufferSize = std::max(GetInPlaceDecompressionBufferSize(info.m_numOfDecompressedBytes), frameSize);
+		out_buffer.resize(bufferSize);
+		unsigned char* frame = out_buffer.data() + bufferSize - frameSize;
+		memcpy(frame, header, sizeof(header));
+		isValid = fread(frame + sizeof(header), 1, frameSize - sizeof(header), fileStreamPtr) == frameSize - sizeof(header) && DecompressFrameInPlace(out_buffer.data(), bufferSize, frameSize);
+	}
+	fclose(fileStreamPtr);
+
+	out_buffer.resize(isValid ? (size_t)info.m_numOfDecompressedBytes : 0);
+	return isValid;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+CompressionStreamWriter::CompressionStreamWriter(Buffer& out_frame, CompressionConfig const& config) :
+	m_frame(out_frame),
+	m_config(config)
+{
+	ValidateCompressionConfig(config);
+	m_headerPosition = m_frame.size();
+	m_frame.resize(m_headerPosition + COMPRESSED_FRAME_HEADER_SIZE);
+	m_block.reserve(config.m_blockSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+CompressionStreamWriter::~CompressionStreamWriter()
+{
+	Finish();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Whole blocks of data compress straight from it, only the partial blocks go through m_block
+void CompressionStreamWriter::Write(void const* data, size_t numOfBytes)
+{
+	GUARANTEE_OR_DIE(!m_isFinished, "Writing to a compression stream that was already finished");
+	unsigned char const* bytes = (unsigned char const*)data;
+	m_numOfBytesWritten += numOfBytes;
+	while (numOfBytes > 0)
+	{
+		if (m_block.empty() && numOfBytes >= m_config.m_blockSize)
+		{
+			size_t frameBlockPosition = m_frame.size();
+			m_frame.resize(frameBlockPosition + GetMaxFrameBlockSize(m_config.m_blockSize));
+			size_t numOfFrameBlockBytes = WriteFrameBlock(bytes, m_config.m_blockSize, &m_frame[frameBlockPosition], m_config);
+			m_frame.resize(frameBlockPosition + numOfFrameBlockBytes);
+			if (m_config.m_hasContentChecksum)
+			{
+				m_contentChecksum = ComputeCRC32C(bytes, m_config.m_blockSize, m_contentChecksum);
+			}
+			bytes		+=	m_config.m_blockSize;
+			numOfBytes	-=	m_config.m_blockSize;
+			continue;
+		}
+
+		size_t numOfBytesToCopy = std::min<size_t>(numOfBytes, m_config.m_blockSize - m_block.size());
+		m_block.insert(m_block.end(), bytes, bytes + numOfBytesToCopy);
+		bytes		+=	numOfBytesToCopy;
+		numOfBytes	-=	numOfBytesToCopy;
+		if (m_block.size() == m_config.m_blockSize)
+		{
+			FlushBlock();
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CompressionStreamWriter::FlushBlock()
+{
+	if (m_block.empty())
+	{
+		return;
+	}
+	size_t frameBlockPosition = m_frame.size();
+	m_frame.resize(frameBlockPosition + GetMaxFrameBlockSize(m_block.size()));
+	size_t numOfFrameBlockBytes = WriteFrameBlock(m_block.data(), m_block.size(), &m_frame[frameBlockPosition], m_config);
+	m_frame.resize(frameBlockPosition + numOfFrameBlockBytes);
+	if (m_config.m_hasContentChecksum)
+	{
+		m_contentChecksum = ComputeCRC32C(m_block.data(), m_block.size(), m_contentChecksum);
+	}
+	m_block.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CompressionStreamWriter::Finish()
+{
+	if (m_isFinished)
+	{
+		return;
+	}
+	FlushBlock();
+	size_t frameEndPosition = m_frame.size();
+	m_frame.resize(frameEndPosition + 8);
+	m_frame.resize(frameEndPosition + WriteFrameEnd(&m_frame[frameEndPosition], m_config, m_contentChecksum));
+	WriteFrameHeader(&m_frame[m_headerPosition], m_config, m_numOfBytesWritten);
+	m_isFinished = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t CompressionStreamWriter::GetNumOfBytesWritten() const
+{
+	return m_numOfBytesWritten;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+CompressionStreamReader::CompressionStreamReader(unsigned char const* frame, size_t frameSize) :
+	m_frame(frame),
+	m_frameSize(frameSize),
+	m_readPosition(COMPRESSED_FRAME_HEADER_SIZE)
+{
+	m_hasFailed = !GetCompressedFrameInfo(frame, frameSize, m_info);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+CompressionStreamReader::CompressionStreamReader(Buffer const& frame) :
+	CompressionStreamReader(frame.data(), frame.size())
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Decompresses the next block as soon as the current one runs out, so reading the last byte also checks the content checksum
+size_t CompressionStreamReader::Read(void* out_data, size_t numOfBytes)
+{
+	unsigned char*	bytes				=	(unsigned char*)out_data;
+	size_t			numOfBytesCopied	=	0;
+	while (!m_hasFailed && !m_isFinished)
+	{
+		if (m_blockReadPosition == m_block.size() && !DecompressNextBlock())
+		{
+			break;
+		}
+		if (numOfBytesCopied == numOfBytes)
+		{
+			break;
+		}
+		size_t numOfBytesToCopy = std::min(numOfBytes - numOfBytesCopied, m_block.size() - m_blockReadPosition);
+		memcpy(bytes + numOfBytesCopied, m_block.data() + m_blockReadPosition, numOfBytesToCopy);
+		numOfBytesCopied	+=	numOfBytesToCopy;
+		m_blockReadPosition	+=	numOfBytesToCopy;
+	}
+	return numOfBytesCopied;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool CompressionStreamReader::DecompressNextBlock()
+{
+	uint64_t numOfBytesLeft = m_info.m_numOfDecompressedBytes - m_numOfBytesRead;
+	m_block.resize((size_t)std::min<uint64_t>(m_info.m_blockSize, numOfBytesLeft));
+	m_blockReadPosition = 0;
+
+	size_t	numOfBlockBytes	=	0;
+	bool	isEndMark		=	false;
+	if (!ReadFrameBlock(m_frame, m_frameSize, m_readPosition, m_info, m_block.data(), m_block.size(), numOfBlockBytes, isEndMark))
+	{
+		m_block.clear();
+		m_hasFailed = true;
+		return false;
+	}
+	if (isEndMark)
+	{
+		m_block.clear();
+		m_isFinished	=	numOfBytesLeft == 0 && ReadFrameEnd(m_frame, m_frameSize, m_readPosition, m_info, m_contentChecksum);
+		m_hasFailed		=	!m_isFinished;
+		return false;
+	}
+
+	m_block.resize(numOfBlockBytes);
+	if (m_info.m_hasContentChecksum)
+	{
+		m_contentChecksum = ComputeCRC32C(m_block.data(), numOfBlockBytes, m_contentChecksum);
+	}
+	m_numOfBytesRead += numOfBlockBytes;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool CompressionStreamReader::HasFailed() const
+{
+	return m_hasFailed;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool CompressionStreamReader::IsFinished() const
+{
+	return m_isFinished;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+CompressedFrameInfo const& CompressionStreamReader::GetFrameInfo() const
+{
+	return m_info;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+struct CompressionBenchmarkTotals
+{
+	size_t	m_numOfBytes				=	0;
+	size_t	m_numOfCompressedBytes		=	0;
+	double	m_compressSeconds			=	0.0;
+	double	m_decompressSeconds			=	0.0;
+	double	m_inPlaceSeconds			=	0.0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Best of numOfRuns for each direction, in place decompression works on a copy of the frame at the end of a preallocated buffer
+static bool RunCompressionBenchmark(std::string const& name, Buffer const& data, int numOfRuns, CompressionConfig const& config, CompressionBenchmarkTotals& totals)
+{
+	Buffer frame(GetMaxCompressedFrameSize(data.size(), config));
+	size_t frameSize			=	0;
+	double compressSeconds		=	1e9;
+	for (int runIndex = 0; runIndex < numOfRuns; ++runIndex)
+	{
+		double timeBeforeCompress = GetCurrentTimeSeconds();
+		frameSize = CompressFrame(data.data(), data.size(), frame.data(), frame.size(), config);
+		compressSeconds = std::min(compressSeconds, GetCurrentTimeSeconds() - timeBeforeCompress);
+	}
+
+	Buffer decompressed(data.size());
+	double decompressSeconds	=	1e9;
+	bool   isValid				=	true;
+	for (int runIndex = 0; runIndex < numOfRuns; ++runIndex)
+	{
+		double timeBeforeDecompress = GetCurrentTimeSeconds();
+		isValid = DecompressFrame(frame.data(), frameSize, decompressed.data(), decompressed.size()) && isValid;
+		decompressSeconds = std::min(decompressSeconds, GetCurrentTimeSeconds() - timeBeforeDecompress);
+	}
+	isValid = isValid && decompressed == data;
+
+	Buffer inPlaceBuffer(GetInPlaceDecompressionBufferSize(data.size()));
+	double inPlaceSeconds		=	1e9;
+	for (int runIndex = 0; runIndex < numOfRuns; ++runIndex)
+	{
+		memcpy(inPlaceBuffer.data() + inPlaceBuffer.size() - frameSize, frame.data(), frameSize);
+		double timeBeforeInPlace = GetCurrentTimeSeconds();
+		isValid = DecompressFrameInPlace(inPlaceBuffer.data(), inPlaceBuffer.size(), frameSize) && isValid;
+		inPlaceSeconds = std::min(inPlaceSeconds, GetCurrentTimeSeconds() - timeBeforeInPlace);
+	}
+	isValid = isValid && memcmp(inPlaceBuffer.data(), data.data(), data.size()) == 0;
+
+	double numOfGigabytes = (double)data.size() / (1024.0 * 1024.0 * 1024.0);
+	PrintBenchmarkResult(Stringf("%-36s %9.2f MB  ratio %5.2f  compress %6.2f GB/s  decompress %6.2f GB/s  in place %6.2f GB/s  %s", name.c_str(), (double)data.size() / (1024.0 * 1024.0),
+								 (double)data.size() / (double)frameSize, numOfGigabytes / compressSeconds, numOfGigabytes / decompressSeconds, numOfGigabytes / inPlaceSeconds,
+								 isValid ? "identical" : "MISMATCH"), !isValid);
+	totals.m_numOfBytes				+=	data.size();
+	totals.m_numOfCompressedBytes	+=	frameSize;
+	totals.m_compressSeconds		+=	compressSeconds;
+	totals.m_decompressSeconds		+=	decompressSeconds;
+	totals.m_inPlaceSeconds			+=	inPlaceSeconds;
+	return isValid;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Streams the data through in odd sized pieces, then checks a flipped byte anywhere in the frame gets caught
+static bool RunCompressionStreamAndCorruptionChecks(Buffer const& data)
+{
+	CompressionConfig config;
+	config.m_blockSize			=	COMPRESSED_FRAME_MIN_BLOCK_SIZE;
+	config.m_hasBlockChecksums	=	true;
+
+	Buffer frame;
+	{
+		CompressionStreamWriter streamWriter(frame, config);
+		for (size_t byteIndex = 0; byteIndex < data.size(); byteIndex += 1000)
+		{
+			streamWriter.Write(data.data() + byteIndex, std::min<size_t>(1000, data.size() - byteIndex));
+		}
+	}
+
+	Buffer					streamedData(data.size());
+	CompressionStreamReader	streamReader(frame);
+	size_t					numOfBytesRead	=	0;
+	size_t					pieceSize		=	777;
+	while (numOfBytesRead < data.size() && !streamReader.HasFailed())
+	{
+		numOfBytesRead += streamReader.Read(streamedData.data() + numOfBytesRead, std::min(pieceSize, data.size() - numOfBytesRead));
+		pieceSize = pieceSize * 3 % 200000 + 1;
+	}
+	bool isValid = streamReader.IsFinished() && streamedData == data;
+
+	Buffer oneShotDecompressed;
+	isValid = isValid && DecompressBuffer(frame, oneShotDecompressed) && oneShotDecompressed == data;
+
+	int numOfUncaughtCorruptions = 0;
+	for (size_t byteIndex = 0; byteIndex < frame.size(); byteIndex += 1 + frame.size() / 64)
+	{
+		Buffer corruptFrame		=	frame;
+		corruptFrame[byteIndex]	^=	0x20;
+		if (DecompressBuffer(corruptFrame, oneShotDecompressed))
+		{
+			++numOfUncaughtCorruptions;
+		}
+	}
+	return isValid && numOfUncaughtCorruptions == 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Compresses the PCUTBN vertex and index data of every model and the texels of every texture, NumOfRuns times each
+bool Command_CompressionBenchmark(EventArgs& args)
+{
+	std::string	modelFolderName		=	args.GetValue("ModelFolder", "Data/Models");
+	std::string	textureFolderName	=	args.GetValue("TextureFolder", "Data/Textures");
+	int			numOfRuns			=	args.GetValue("NumOfRuns", 5);
+	if (numOfRuns <= 0)
+	{
+		return false;
+	}
+
+	CompressionConfig			config;
+	CompressionBenchmarkTotals	meshTotals;
+	CompressionBenchmarkTotals	textureTotals;
+	bool						isValid			=	true;
+	Buffer						streamCheckData;
+	for (std::string const& fileName : GetFileNamesInFolder(modelFolderName, { ".obj" }))
+	{
+		std::vector<Vertex_PCUTBN>	verts;
+		std::vector<unsigned int>	indexes;
+		OBJLoader::LoadOBJFileByName(fileName, verts, indexes, Mat44());
+		Buffer meshData;
+		BufferWriter meshWriter(meshData);
+		meshWriter.AppendArray(verts);
+		meshWriter.AppendArray(indexes);
+		isValid = RunCompressionBenchmark(fileName, meshData, numOfRuns, config, meshTotals) && isValid;
+		if (streamCheckData.empty())
+		{
+			streamCheckData = meshData;
+		}
+	}
+	for (std::string const& fileName : GetFileNamesInFolder(textureFolderName, { ".png", ".jpg", ".tga" }))
+	{
+		Image			image(fileName.c_str());
+		IntVec2			dimensions		=	image.GetDimensions();
+		unsigned char const* texels		=	(unsigned char const*)image.GetRawData();
+		Buffer			textureData(texels, texels + (size_t)dimensions.x * (size_t)dimensions.y * sizeof(Rgba8));
+		isValid = RunCompressionBenchmark(fileName, textureData, numOfRuns, config, textureTotals) && isValid;
+	}
+
+	CompressionBenchmarkTotals const*	totals[2]		=	{ &meshTotals, &textureTotals };
+	char const*							totalNames[2]	=	{ "Meshes", "Textures" };
+	for (int totalIndex = 0; totalIndex < 2; ++totalIndex)
+	{
+		CompressionBenchmarkTotals const& total = *totals[totalIndex];
+		if (total.m_numOfBytes == 0)
+		{
+			continue;
+		}
+		double numOfGigabytes = (double)total.m_numOfBytes / (1024.0 * 1024.0 * 1024.0);
+		PrintBenchmarkResult(Stringf("%s: %.2f MB to %.2f MB, ratio %.2f, compress %.2f GB/s, decompress %.2f GB/s, in place %.2f GB/s", totalNames[totalIndex],
+									 (double)total.m_numOfBytes / (1024.0 * 1024.0), (double)total.m_numOfCompressedBytes / (1024.0 * 1024.0), (double)total.m_numOfBytes / (double)total.m_numOfCompressedBytes,
+									 numOfGigabytes / total.m_compressSeconds, numOfGigabytes / total.m_decompressSeconds, numOfGigabytes / total.m_inPlaceSeconds));
+	}
+
+	bool areStreamChecksValid = RunCompressionStreamAndCorruptionChecks(streamCheckData);
+	PrintBenchmarkResult(Stringf("Streamed round trip and corruption checks: %s", areStreamChecksValid ? "PASSED" : "FAILED"), !areStreamChecksValid);
+	return isValid && areStreamChecksValid;
+}
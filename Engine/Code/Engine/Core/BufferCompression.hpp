@@ -0,0 +1,133 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/BufferUtils.hpp"
+#include "Engine/Core/EventSystem.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <string>
+#include <stdint.h>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr uint32_t	COMPRESSED_FRAME_FOURCC				=	0x465A4C42;		// "BLZF" read as little endian
+constexpr uint8_t	COMPRESSED_FRAME_VERSION			=	2;
+constexpr size_t	COMPRESSED_FRAME_HEADER_SIZE		=	20;
+constexpr uint32_t	COMPRESSED_FRAME_MIN_BLOCK_SIZE		=	64 * 1024;
+constexpr uint32_t	COMPRESSED_FRAME_MAX_BLOCK_SIZE		=	4 * 1024 * 1024;
+
+
+//--------------------------------------------------------------------------------------------------
+struct CompressionConfig
+{
+	uint32_t	m_blockSize				=	256 * 1024;		// Power of two between the min and max block size, blocks compress on their own with a 64 KB window
+	bool		m_hasBlockChecksums		=	false;			// Over each stored block, so a corrupt block is rejected before it gets decompressed
+	bool		m_hasContentChecksum	=	true;			// Over all the decompressed bytes, built up a block at a time and checked once the last block is read
+	int			m_acceleration			=	1;				// Higher skips ahead faster through data that does not match, trading ratio for speed
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Everything in a frame is little endian and every checksum is a CRC32C:
+//	header: fourCC, version, flags, log2 of the block size, a reserved byte, the decompressed size (uint64) and a checksum of the 16 bytes before it
+//	blocks: a uint32 stored size with the top bit set when the block is stored uncompressed, the stored bytes, then their checksum when the frame has block checksums
+//	end: a uint32 0, then the content checksum when the frame has one
+struct CompressedFrameInfo
+{
+	uint64_t	m_numOfDecompressedBytes	=	0;
+	uint32_t	m_blockSize					=	0;
+	bool		m_hasBlockChecksums			=	false;
+	bool		m_hasContentChecksum		=	false;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Block level codec in the LZ4 block format, for callers that keep track of the sizes themselves
+// CompressBlock returns 0 when the result would not fit in destinationCapacity, DecompressBlock returns false on malformed data and never reads or writes out of bounds
+size_t		GetMaxCompressedBlockSize(size_t numOfSourceBytes);
+size_t		CompressBlock(unsigned char const* source, size_t numOfSourceBytes, unsigned char* out_destination, size_t destinationCapacity, int acceleration = 1);
+bool		DecompressBlock(unsigned char const* source, size_t numOfSourceBytes, unsigned char* out_destination, size_t destinationCapacity, size_t& out_numOfBytesWritten);
+
+// One shot frames into preallocated memory, CompressFrame returns the frame size and the Decompress functions fail on any bad size or checksum
+size_t		GetMaxCompressedFrameSize(size_t numOfSourceBytes, CompressionConfig const& config = CompressionConfig());
+size_t		CompressFrame(unsigned char const* source, size_t numOfSourceBytes, unsigned char* out_frame, size_t frameCapacity, CompressionConfig const& config = CompressionConfig());
+bool		GetCompressedFrameInfo(unsigned char const* frame, size_t frameSize, CompressedFrameInfo& out_info);
+bool		DecompressFrame(unsigned char const* frame, size_t frameSize, unsigned char* out_destination, size_t destinationCapacity);
+
+// In place decompression: with the frame copied (or read from a file) into the last frameSize bytes of a buffer of at least
+// GetInPlaceDecompressionBufferSize bytes, it decompresses to the start of that same buffer without a second allocation
+size_t		GetInPlaceDecompressionBufferSize(uint64_t numOfDecompressedBytes);
+bool		DecompressFrameInPlace(unsigned char* buffer, size_t bufferSize, size_t frameSize);
+
+// Buffer conveniences, CompressBuffer replaces out_frame and DecompressBuffer replaces out_decompressed
+void		CompressBuffer(Buffer const& source, Buffer& out_frame, CompressionConfig const& config = CompressionConfig());
+bool		DecompressBuffer(Buffer const& frame, Buffer& out_decompressed);
+void		FileWriteFromBufferCompressed(Buffer const& inBuffer, std::string const& fileName, CompressionConfig const& config = CompressionConfig());
+bool		FileReadToBufferDecompressed(Buffer& out_buffer, std::string const& fileName);
+
+
+//--------------------------------------------------------------------------------------------------
+// Appends a frame to a buffer a piece at a time, each full block is compressed as soon as it is written
+// The decompressed size is patched into the header by Finish, which the destructor calls if nobody did
+class CompressionStreamWriter
+{
+public:
+	CompressionStreamWriter(Buffer& out_frame, CompressionConfig const& config = CompressionConfig());
+	CompressionStreamWriter(CompressionStreamWriter const& copyFrom) = delete;
+	~CompressionStreamWriter();
+
+	void		Write(void const* data, size_t numOfBytes);
+	void		Finish();
+	uint64_t	GetNumOfBytesWritten() const;
+
+private:
+	void		FlushBlock();
+
+private:
+	Buffer&				m_frame;
+	CompressionConfig	m_config;
+	size_t				m_headerPosition		=	0;
+	Buffer				m_block;
+	uint64_t			m_numOfBytesWritten		=	0;
+	uint32_t			m_contentChecksum		=	0;
+	bool				m_isFinished			=	false;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Reads a frame back a piece at a time, decompressing one block ahead of the reader
+// Read returns fewer bytes than asked for at the end of the frame or once something turned out to be corrupt, HasFailed tells the two apart
+class CompressionStreamReader
+{
+public:
+	CompressionStreamReader(unsigned char const* frame, size_t frameSize);
+	CompressionStreamReader(Buffer const& frame);
+	CompressionStreamReader(CompressionStreamReader const& copyFrom) = delete;
+
+	size_t				Read(void* out_data, size_t numOfBytes);
+	bool				HasFailed() const;
+	bool				IsFinished() const;		// Every block read and every checksum matched
+	CompressedFrameInfo const& GetFrameInfo() const;
+
+private:
+	bool				DecompressNextBlock();
+
+private:
+	unsigned char const*	m_frame					=	nullptr;
+	size_t					m_frameSize				=	0;
+	size_t					m_readPosition			=	0;
+	CompressedFrameInfo		m_info;
+	Buffer					m_block;
+	size_t					m_blockReadPosition		=	0;
+	uint64_t				m_numOfBytesRead		=	0;
+	uint32_t				m_contentChecksum		=	0;
+	bool					m_hasFailed				=	false;
+	bool					m_isFinished			=	false;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_CompressionBenchmark(EventArgs& args);
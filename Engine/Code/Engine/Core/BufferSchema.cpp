@@ -0,0 +1,266 @@
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/BufferSchema.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// Two versions of the same saved struct for the version and tagged format checks: the newer one dropped m_score and added m_level and m_bounds
+struct SchemaBenchmarkActorV1
+{
+	std::string				m_name;
+	Vec3					m_position;
+	float					m_health		=	100.f;
+	std::vector<uint32_t>	m_inventory;
+	int32_t					m_score			=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct SchemaBenchmarkActorV2
+{
+	std::string				m_name;
+	Vec3					m_position;
+	float					m_health		=	100.f;
+	std::vector<uint32_t>	m_inventory;
+	int32_t					m_level			=	1;
+	AABB3					m_bounds;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+template <> struct BufferSchema<SchemaBenchmarkActorV1>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&SchemaBenchmarkActorV1::m_name, 1), MakeBufferSchemaField(&SchemaBenchmarkActorV1::m_position, 2),
+												   MakeBufferSchemaField(&SchemaBenchmarkActorV1::m_health, 3), MakeBufferSchemaField(&SchemaBenchmarkActorV1::m_inventory, 4),
+												   MakeBufferSchemaField(&SchemaBenchmarkActorV1::m_score, 5));
+};
+
+template <> struct BufferSchema<SchemaBenchmarkActorV2>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&SchemaBenchmarkActorV2::m_name, 1), MakeBufferSchemaField(&SchemaBenchmarkActorV2::m_position, 2),
+												   MakeBufferSchemaField(&SchemaBenchmarkActorV2::m_health, 3), MakeBufferSchemaField(&SchemaBenchmarkActorV2::m_inventory, 4),
+												   MakeBufferSchemaField(&SchemaBenchmarkActorV2::m_level, 6, 2), MakeBufferSchemaField(&SchemaBenchmarkActorV2::m_bounds, 7, 2));
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// What an actor's handwritten Append function would look like, to compare the schema against
+static void AppendActorByHand(BufferWriter& writer, SchemaBenchmarkActorV2 const& actor)
+{
+	writer.AppendStringAfter32BitLength(actor.m_name.c_str());
+	writer.AppendVec3(actor.m_position);
+	writer.AppendFloat(actor.m_health);
+	writer.AppendVarUInt64(actor.m_inventory.size());
+	for (uint32_t item : actor.m_inventory)
+	{
+		writer.AppendUInt32(item);
+	}
+	writer.AppendInt32(actor.m_level);
+	writer.AppendAABB3(actor.m_bounds);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool AreActorsEqual(SchemaBenchmarkActorV2 const& actorA, SchemaBenchmarkActorV2 const& actorB)
+{
+	return actorA.m_name == actorB.m_name && actorA.m_position == actorB.m_position && actorA.m_health == actorB.m_health && actorA.m_inventory == actorB.m_inventory &&
+		   actorA.m_level == actorB.m_level && actorA.m_bounds.m_mins == actorB.m_bounds.m_mins && actorA.m_bounds.m_maxs == actorB.m_bounds.m_maxs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Older and newer data through the compact format with a version and through the tagged format both ways
+static bool RunBufferSchemaVersionChecks()
+{
+	SchemaBenchmarkActorV2 actorV2;
+	actorV2.m_name		=	"Grunt";
+	actorV2.m_position	=	Vec3(1.f, 2.f, 3.f);
+	actorV2.m_health	=	42.5f;
+	actorV2.m_inventory	=	{ 7, 8, 9 };
+	actorV2.m_level		=	12;
+	actorV2.m_bounds	=	AABB3(Vec3(-1.f, -1.f, 0.f), Vec3(1.f, 1.f, 2.f));
+
+	// Version 1 of the V2 schema is the V1 layout minus the dropped m_score, so V1 reads it with its own version 1 subset
+	Buffer			compactBuffer;
+	BufferWriter	compactWriter(compactBuffer);
+	AppendWithSchema(compactWriter, actorV2, 1);
+	SchemaBenchmarkActorV2	compactActor;
+	BufferParser			compactParser(compactBuffer);
+	ParseWithSchema(compactParser, compactActor, 1);
+	bool isValid = compactActor.m_name == actorV2.m_name && compactActor.m_inventory == actorV2.m_inventory && compactActor.m_level == 1 &&
+				   compactParser.GetCurrentReadPosition() == (uint32_t)compactBuffer.size();
+
+	// Newer data read by the older struct skips the new fields, older data read by the newer struct skips m_score and keeps the defaults
+	Buffer			taggedV2Buffer;
+	BufferWriter	taggedV2Writer(taggedV2Buffer, eBufferEndian::BIG);
+	AppendTaggedWithSchema(taggedV2Writer, actorV2);
+	SchemaBenchmarkActorV1	actorV1FromV2;
+	BufferParser			taggedV2Parser(taggedV2Buffer, eBufferEndian::BIG);
+	ParseTaggedWithSchema(taggedV2Parser, actorV1FromV2);
+	isValid = isValid && actorV1FromV2.m_name == actorV2.m_name && actorV1FromV2.m_position == actorV2.m_position && actorV1FromV2.m_health == actorV2.m_health &&
+			  actorV1FromV2.m_inventory == actorV2.m_inventory && actorV1FromV2.m_score == 0 && taggedV2Parser.GetCurrentReadPosition() == (uint32_t)taggedV2Buffer.size();
+
+	actorV1FromV2.m_score = 1234;
+	Buffer			taggedV1Buffer;
+	BufferWriter	taggedV1Writer(taggedV1Buffer);
+	AppendTaggedWithSchema(taggedV1Writer, actorV1FromV2);
+	SchemaBenchmarkActorV2	actorV2FromV1;
+	BufferParser			taggedV1Parser(taggedV1Buffer);
+	ParseTaggedWithSchema(taggedV1Parser, actorV2FromV1);
+	isValid = isValid && actorV2FromV1.m_name == actorV2.m_name && actorV2FromV1.m_inventory == actorV2.m_inventory && actorV2FromV1.m_level == 1 &&
+			  taggedV1Parser.GetCurrentReadPosition() == (uint32_t)taggedV1Buffer.size();
+
+	SchemaBenchmarkActorV2	taggedRoundTripActor;
+	BufferParser			taggedRoundTripParser(taggedV2Buffer, eBufferEndian::BIG);
+	ParseTaggedWithSchema(taggedRoundTripParser, taggedRoundTripActor);
+	return isValid && AreActorsEqual(taggedRoundTripActor, actorV2);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Times handwritten Append / Parse calls against the schema generated ones on NumOfVerts Vertex_PCUTBNs and NumOfActors actors,
+// and checks they all write the same bytes and read back the same values
+bool Command_BufferSchemaBenchmark(EventArgs& args)
+{
+	int numOfVerts	=	args.GetValue("NumOfVerts", 1000000);
+	int numOfActors	=	args.GetValue("NumOfActors", 100000);
+	if (numOfVerts <= 0 || numOfActors <= 0)
+	{
+		return false;
+	}
+
+	bool areVersionChecksValid = RunBufferSchemaVersionChecks();
+	PrintBenchmarkResult(Stringf("Schema versioned compact and tagged round trips: %s", areVersionChecksValid ? "PASSED" : "FAILED"), !areVersionChecksValid);
+
+	std::vector<Vertex_PCUTBN> verts((size_t)numOfVerts);
+	for (int vertIndex = 0; vertIndex < numOfVerts; ++vertIndex)
+	{
+		float value = (float)vertIndex;
+		verts[vertIndex] = Vertex_PCUTBN(Vec3(value, -value, 0.5f * value), Rgba8((unsigned char)vertIndex, 1, 2, 3), Vec2(value, 1.f), Vec3(1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, 0.f, 1.f));
+	}
+
+	Buffer handwrittenBuffer;
+	handwrittenBuffer.reserve(verts.size() * sizeof(Vertex_PCUTBN));
+	double timeBeforeHandwritten = GetCurrentTimeSeconds();
+	BufferWriter handwrittenWriter(handwrittenBuffer);
+	for (Vertex_PCUTBN const& vert : verts)
+	{
+		handwrittenWriter.AppendVertexPCUTBN(vert);
+	}
+	double handwrittenSeconds = GetCurrentTimeSeconds() - timeBeforeHandwritten;
+
+	Buffer schemaBuffer;
+	schemaBuffer.reserve(verts.size() * sizeof(Vertex_PCUTBN));
+	double timeBeforeSchema = GetCurrentTimeSeconds();
+	BufferWriter schemaWriter(schemaBuffer);
+	for (Vertex_PCUTBN const& vert : verts)
+	{
+		AppendWithSchema(schemaWriter, vert);
+	}
+	double schemaSeconds = GetCurrentTimeSeconds() - timeBeforeSchema;
+
+	Buffer fieldsBuffer;
+	fieldsBuffer.reserve(verts.size() * sizeof(Vertex_PCUTBN));
+	double timeBeforeFields = GetCurrentTimeSeconds();
+	BufferWriter fieldsWriter(fieldsBuffer);
+	for (Vertex_PCUTBN const& vert : verts)
+	{
+		AppendFieldsWithSchema(fieldsWriter, vert);
+	}
+	double fieldsSeconds = GetCurrentTimeSeconds() - timeBeforeFields;
+
+	Buffer arrayBuffer;
+	arrayBuffer.reserve(verts.size() * sizeof(Vertex_PCUTBN));
+	double timeBeforeArray = GetCurrentTimeSeconds();
+	BufferWriter arrayWriter(arrayBuffer);
+	AppendArrayWithSchema(arrayWriter, verts.data(), verts.size());
+	double arraySeconds = GetCurrentTimeSeconds() - timeBeforeArray;
+
+	std::vector<Vertex_PCUTBN> handwrittenVerts(verts.size());
+	double timeBeforeHandwrittenParse = GetCurrentTimeSeconds();
+	BufferParser handwrittenParser(handwrittenBuffer);
+	for (Vertex_PCUTBN& vert : handwrittenVerts)
+	{
+		vert = handwrittenParser.ParseVertexPCUTBN();
+	}
+	double handwrittenParseSeconds = GetCurrentTimeSeconds() - timeBeforeHandwrittenParse;
+
+	std::vector<Vertex_PCUTBN> schemaVerts(verts.size());
+	double timeBeforeSchemaParse = GetCurrentTimeSeconds();
+	BufferParser schemaParser(handwrittenBuffer);
+	for (Vertex_PCUTBN& vert : schemaVerts)
+	{
+		ParseWithSchema(schemaParser, vert);
+	}
+	double schemaParseSeconds = GetCurrentTimeSeconds() - timeBeforeSchemaParse;
+
+	std::vector<Vertex_PCUTBN> fieldsVerts(verts.size());
+	BufferParser fieldsParser(handwrittenBuffer);
+	for (Vertex_PCUTBN& vert : fieldsVerts)
+	{
+		ParseFieldsWithSchema(fieldsParser, vert);
+	}
+
+	size_t	numOfVertBytes		=	verts.size() * sizeof(Vertex_PCUTBN);
+	bool	areVertsIdentical	=	handwrittenBuffer == schemaBuffer && handwrittenBuffer == fieldsBuffer && handwrittenBuffer == arrayBuffer &&
+									memcmp(handwrittenVerts.data(), verts.data(), numOfVertBytes) == 0 && memcmp(schemaVerts.data(), verts.data(), numOfVertBytes) == 0 &&
+									memcmp(fieldsVerts.data(), verts.data(), numOfVertBytes) == 0;
+	PrintBenchmarkResult(Stringf("%d Vertex_PCUTBN append: handwritten %.2f ms, schema %.2f ms, schema field by field %.2f ms, schema array %.2f ms", numOfVerts,
+								 handwrittenSeconds * 1000.0, schemaSeconds * 1000.0, fieldsSeconds * 1000.0, arraySeconds * 1000.0));
+	PrintBenchmarkResult(Stringf("%d Vertex_PCUTBN parse: handwritten %.2f ms, schema %.2f ms, %s", numOfVerts, handwrittenParseSeconds * 1000.0, schemaParseSeconds * 1000.0,
+								 areVertsIdentical ? "identical" : "MISMATCH"), !areVertsIdentical);
+
+	// Actors have strings and vectors, so no contiguous path for the struct itself
+	std::vector<SchemaBenchmarkActorV2> actors((size_t)numOfActors);
+	for (int actorIndex = 0; actorIndex < numOfActors; ++actorIndex)
+	{
+		SchemaBenchmarkActorV2& actor = actors[actorIndex];
+		actor.m_name		=	Stringf("Actor%d", actorIndex);
+		actor.m_position	=	Vec3((float)actorIndex, 0.f, 1.f);
+		actor.m_health		=	(float)(actorIndex % 100);
+		actor.m_inventory.assign((size_t)(actorIndex % 8), (uint32_t)actorIndex);
+		actor.m_level		=	actorIndex % 50;
+		actor.m_bounds		=	AABB3(Vec3(-1.f, -1.f, 0.f), Vec3(1.f, 1.f, (float)actorIndex));
+	}
+
+	Buffer handwrittenActorBuffer;
+	double timeBeforeHandwrittenActors = GetCurrentTimeSeconds();
+	BufferWriter handwrittenActorWriter(handwrittenActorBuffer);
+	for (SchemaBenchmarkActorV2 const& actor : actors)
+	{
+		AppendActorByHand(handwrittenActorWriter, actor);
+	}
+	double handwrittenActorSeconds = GetCurrentTimeSeconds() - timeBeforeHandwrittenActors;
+
+	Buffer schemaActorBuffer;
+	double timeBeforeSchemaActors = GetCurrentTimeSeconds();
+	BufferWriter schemaActorWriter(schemaActorBuffer);
+	AppendWithSchema(schemaActorWriter, actors);
+	double schemaActorSeconds = GetCurrentTimeSeconds() - timeBeforeSchemaActors;
+
+	std::vector<SchemaBenchmarkActorV2>	parsedActors;
+	BufferParser						schemaActorParser(schemaActorBuffer);
+	double timeBeforeSchemaActorParse = GetCurrentTimeSeconds();
+	ParseWithSchema(schemaActorParser, parsedActors);
+	double schemaActorParseSeconds = GetCurrentTimeSeconds() - timeBeforeSchemaActorParse;
+
+	// The schema writes the vector's count in front of the actors, the handwritten loop does not
+	Buffer			countBuffer;
+	BufferWriter	countWriter(countBuffer);
+	countWriter.AppendVarUInt64(actors.size());
+	bool areActorsIdentical = parsedActors.size() == actors.size() && schemaActorBuffer.size() == countBuffer.size() + handwrittenActorBuffer.size() &&
+							  memcmp(schemaActorBuffer.data() + countBuffer.size(), handwrittenActorBuffer.data(), handwrittenActorBuffer.size()) == 0;
+	for (size_t actorIndex = 0; areActorsIdentical && actorIndex < actors.size(); ++actorIndex)
+	{
+		areActorsIdentical = AreActorsEqual(parsedActors[actorIndex], actors[actorIndex]);
+	}
+	PrintBenchmarkResult(Stringf("%d actors append: handwritten %.2f ms, schema %.2f ms, schema parse %.2f ms, %s", numOfActors, handwrittenActorSeconds * 1000.0,
+								 schemaActorSeconds * 1000.0, schemaActorParseSeconds * 1000.0, areActorsIdentical ? "identical" : "MISMATCH"), !areActorsIdentical);
+	return areVersionChecksValid && areVertsIdentical && areActorsIdentical;
+}
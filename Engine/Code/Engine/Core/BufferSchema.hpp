@@ -0,0 +1,412 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/BufferUtils.hpp"
+#include "Engine/Core/EventSystem.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <tuple>
+#include <string>
+#include <vector>
+#include <utility>
+#include <type_traits>
+
+
+//--------------------------------------------------------------------------------------------------
+// Passing this as the version reads or writes every field of a schema
+constexpr uint16_t BUFFER_SCHEMA_CURRENT_VERSION = 0xFFFF;
+
+
+//--------------------------------------------------------------------------------------------------
+// One serialized member of a struct
+// m_id names the field in the tagged format, so it must never change or be reused once data has been written with it
+// m_sinceVersion is the data version that added the field, reading older data leaves newer fields untouched
+template <typename StructType, typename MemberType>
+struct BufferSchemaField
+{
+	using Member = MemberType;
+
+	MemberType StructType::*	m_member			=	nullptr;
+	uint16_t					m_id				=	0;
+	uint16_t					m_sinceVersion		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename StructType, typename MemberType>
+constexpr BufferSchemaField<StructType, MemberType> MakeBufferSchemaField(MemberType StructType::* member, uint16_t id, uint16_t sinceVersion = 0)
+{
+	return BufferSchemaField<StructType, MemberType>{ member, id, sinceVersion };
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Specialize for a struct to serialize it with AppendWithSchema / ParseWithSchema, listing its fields in the order they are written:
+//
+//	template <> struct BufferSchema<AABB2>
+//	{
+//		static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&AABB2::m_mins, 1), MakeBufferSchemaField(&AABB2::m_maxs, 2));
+//	};
+//
+// A struct that also has a BufferArrayLayout is written as its memory bytes in one go, so its FIELDS have to list every member in memory order
+// Fields can be arithmetic, enums, std::string, std::vector, or structs with a schema or a BufferArrayLayout
+template <typename T>
+struct BufferSchema
+{
+};
+
+template <typename T, typename = void>
+struct HasBufferSchema : std::false_type
+{
+};
+
+template <typename T>
+struct HasBufferSchema<T, std::void_t<decltype(BufferSchema<T>::FIELDS)>> : std::true_type
+{
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Compact format: the fields back to back with nothing in between, both sides have to agree on the version
+// Structs with a BufferArrayLayout take the contiguous path when every field is in the version, as do vectors of them
+template <typename T> void	AppendWithSchema(BufferWriter& writer, T const& value, uint16_t version = BUFFER_SCHEMA_CURRENT_VERSION);
+template <typename T> void	ParseWithSchema(BufferParser& parser, T& out_value, uint16_t version = BUFFER_SCHEMA_CURRENT_VERSION);
+template <typename T> void	AppendArrayWithSchema(BufferWriter& writer, T const* values, size_t numOfValues, uint16_t version = BUFFER_SCHEMA_CURRENT_VERSION);
+template <typename T> void	ParseArrayWithSchema(BufferParser& parser, T* out_values, size_t numOfValues, uint16_t version = BUFFER_SCHEMA_CURRENT_VERSION);
+
+// The compact format one field at a time, never the contiguous path. Gives the same bytes, the schema check compares the two
+template <typename T> void	AppendFieldsWithSchema(BufferWriter& writer, T const& value, uint16_t version = BUFFER_SCHEMA_CURRENT_VERSION);
+template <typename T> void	ParseFieldsWithSchema(BufferParser& parser, T& out_value, uint16_t version = BUFFER_SCHEMA_CURRENT_VERSION);
+
+// Tagged format: a VarUInt field count, then per field a VarUInt id, a UInt32 byte size and the field in the compact format
+// Parsing skips fields with ids the schema does not know and leaves fields the data does not have untouched,
+// so fields can be added and removed over time. Only the top level struct is tagged, a nested struct that changes needs a new field id
+template <typename T> void	AppendTaggedWithSchema(BufferWriter& writer, T const& value);
+template <typename T> void	ParseTaggedWithSchema(BufferParser& parser, T& out_value);
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_BufferSchemaBenchmark(EventArgs& args);
+
+
+//--------------------------------------------------------------------------------------------------
+template <> struct BufferSchema<Vec2>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&Vec2::x, 1), MakeBufferSchemaField(&Vec2::y, 2));
+};
+
+template <> struct BufferSchema<Vec3>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&Vec3::x, 1), MakeBufferSchemaField(&Vec3::y, 2), MakeBufferSchemaField(&Vec3::z, 3));
+};
+
+template <> struct BufferSchema<Vec4>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&Vec4::x, 1), MakeBufferSchemaField(&Vec4::y, 2), MakeBufferSchemaField(&Vec4::z, 3), MakeBufferSchemaField(&Vec4::w, 4));
+};
+
+template <> struct BufferSchema<IntVec2>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&IntVec2::x, 1), MakeBufferSchemaField(&IntVec2::y, 2));
+};
+
+template <> struct BufferSchema<IntVec3>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&IntVec3::x, 1), MakeBufferSchemaField(&IntVec3::y, 2), MakeBufferSchemaField(&IntVec3::z, 3));
+};
+
+template <> struct BufferSchema<Rgba8>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&Rgba8::r, 1), MakeBufferSchemaField(&Rgba8::g, 2), MakeBufferSchemaField(&Rgba8::b, 3), MakeBufferSchemaField(&Rgba8::a, 4));
+};
+
+template <> struct BufferSchema<AABB2>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&AABB2::m_mins, 1), MakeBufferSchemaField(&AABB2::m_maxs, 2));
+};
+
+template <> struct BufferSchema<AABB3>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&AABB3::m_mins, 1), MakeBufferSchemaField(&AABB3::m_maxs, 2));
+};
+
+template <> struct BufferSchema<OBB2>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&OBB2::m_center, 1), MakeBufferSchemaField(&OBB2::m_iBasisNormal, 2), MakeBufferSchemaField(&OBB2::m_halfDimensions, 3));
+};
+
+template <> struct BufferSchema<OBB3>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&OBB3::m_center, 1), MakeBufferSchemaField(&OBB3::m_iBasis, 2), MakeBufferSchemaField(&OBB3::m_jBasis, 3),
+												   MakeBufferSchemaField(&OBB3::m_kBasis, 4), MakeBufferSchemaField(&OBB3::m_halfDims, 5));
+};
+
+template <> struct BufferSchema<Plane2D>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&Plane2D::m_normal, 1), MakeBufferSchemaField(&Plane2D::m_distFromOrigin, 2));
+};
+
+template <> struct BufferSchema<Vertex_PCU>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&Vertex_PCU::m_position, 1), MakeBufferSchemaField(&Vertex_PCU::m_color, 2), MakeBufferSchemaField(&Vertex_PCU::m_uvTexCoords, 3));
+};
+
+template <> struct BufferSchema<Vertex_PCUTBN>
+{
+	static constexpr auto FIELDS = std::make_tuple(MakeBufferSchemaField(&Vertex_PCUTBN::m_position, 1), MakeBufferSchemaField(&Vertex_PCUTBN::m_color, 2), MakeBufferSchemaField(&Vertex_PCUTBN::m_uvTexCoords, 3),
+												   MakeBufferSchemaField(&Vertex_PCUTBN::m_tangent, 4), MakeBufferSchemaField(&Vertex_PCUTBN::m_binormal, 5), MakeBufferSchemaField(&Vertex_PCUTBN::m_normal, 6));
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Calls function on every field of a schema, unrolled at compile time
+template <typename Tuple, typename Function, size_t... FieldIndexes>
+void ForEachBufferSchemaField(Tuple const& fields, Function&& function, std::index_sequence<FieldIndexes...>)
+{
+	(function(std::get<FieldIndexes>(fields)), ...);
+}
+
+template <typename T, typename Function>
+void ForEachBufferSchemaField(Function&& function)
+{
+	constexpr auto const& fields = BufferSchema<T>::FIELDS;
+	ForEachBufferSchemaField(fields, function, std::make_index_sequence<std::tuple_size<std::decay_t<decltype(fields)>>::value>());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The highest m_sinceVersion of a schema's fields, versions at or above it include every field
+template <typename Tuple, size_t... FieldIndexes>
+constexpr uint16_t GetBufferSchemaNewestFieldVersion(Tuple const& fields, std::index_sequence<FieldIndexes...>)
+{
+	uint16_t newestVersion = 0;
+	((newestVersion = std::get<FieldIndexes>(fields).m_sinceVersion > newestVersion ? std::get<FieldIndexes>(fields).m_sinceVersion : newestVersion), ...);
+	return newestVersion;
+}
+
+template <typename T>
+constexpr uint16_t GetBufferSchemaNewestFieldVersion()
+{
+	return GetBufferSchemaNewestFieldVersion(BufferSchema<T>::FIELDS, std::make_index_sequence<std::tuple_size<std::decay_t<decltype(BufferSchema<T>::FIELDS)>>::value>());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+struct IsStdVector : std::false_type
+{
+};
+
+template <typename ElementType, typename Allocator>
+struct IsStdVector<std::vector<ElementType, Allocator>> : std::true_type
+{
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Contiguous when the struct's memory bytes are its compact bytes, which is the case once every field is in the version
+template <typename T>
+bool CanUseContiguousBufferSchemaPath(uint16_t version)
+{
+	if constexpr (HasBufferArrayLayout<T>::value && HasBufferSchema<T>::value)
+	{
+		return version >= GetBufferSchemaNewestFieldVersion<T>();
+	}
+	else
+	{
+		return HasBufferArrayLayout<T>::value;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void AppendWithSchema(BufferWriter& writer, T const& value, uint16_t version)
+{
+	if constexpr (std::is_enum<T>::value)
+	{
+		AppendWithSchema(writer, static_cast<std::underlying_type_t<T>>(value), version);
+	}
+	else if constexpr (std::is_same<T, std::string>::value)
+	{
+		writer.AppendStringAfter32BitLength(value.c_str());
+	}
+	else if constexpr (IsStdVector<T>::value)
+	{
+		writer.AppendVarUInt64(value.size());
+		AppendArrayWithSchema(writer, value.data(), value.size(), version);
+	}
+	else if constexpr (HasBufferArrayLayout<T>::value)
+	{
+		if (CanUseContiguousBufferSchemaPath<T>(version))
+		{
+			writer.AppendArray(&value, 1);
+		}
+		else if constexpr (HasBufferSchema<T>::value)
+		{
+			AppendFieldsWithSchema(writer, value, version);
+		}
+	}
+	else
+	{
+		static_assert(HasBufferSchema<T>::value, "Specialize BufferSchema (or BufferArrayLayout) to serialize this type");
+		AppendFieldsWithSchema(writer, value, version);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void ParseWithSchema(BufferParser& parser, T& out_value, uint16_t version)
+{
+	if constexpr (std::is_enum<T>::value)
+	{
+		std::underlying_type_t<T> parsedValue = 0;
+		ParseWithSchema(parser, parsedValue, version);
+		out_value = static_cast<T>(parsedValue);
+	}
+	else if constexpr (std::is_same<T, std::string>::value)
+	{
+		out_value.clear();
+		parser.ParseStringAfter32BitLength(out_value);
+	}
+	else if constexpr (IsStdVector<T>::value)
+	{
+		uint64_t numOfElements = parser.ParseVarUInt64();
+		GUARANTEE_OR_DIE(numOfElements <= uint64_t(parser.m_bufferSize - parser.GetCurrentReadPosition()), "Vector longer than the rest of the buffer");
+		out_value.resize((size_t)numOfElements);
+		ParseArrayWithSchema(parser, out_value.data(), out_value.size(), version);
+	}
+	else if constexpr (HasBufferArrayLayout<T>::value)
+	{
+		if (CanUseContiguousBufferSchemaPath<T>(version))
+		{
+			parser.ParseArray(&out_value, 1);
+		}
+		else if constexpr (HasBufferSchema<T>::value)
+		{
+			ParseFieldsWithSchema(parser, out_value, version);
+		}
+	}
+	else
+	{
+		static_assert(HasBufferSchema<T>::value, "Specialize BufferSchema (or BufferArrayLayout) to serialize this type");
+		ParseFieldsWithSchema(parser, out_value, version);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void AppendArrayWithSchema(BufferWriter& writer, T const* values, size_t numOfValues, uint16_t version)
+{
+	if constexpr (HasBufferArrayLayout<T>::value)
+	{
+		if (CanUseContiguousBufferSchemaPath<T>(version))
+		{
+			writer.AppendArray(values, numOfValues);
+			return;
+		}
+	}
+	for (size_t valueIndex = 0; valueIndex < numOfValues; ++valueIndex)
+	{
+		AppendWithSchema(writer, values[valueIndex], version);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void ParseArrayWithSchema(BufferParser& parser, T* out_values, size_t numOfValues, uint16_t version)
+{
+	if constexpr (HasBufferArrayLayout<T>::value)
+	{
+		if (CanUseContiguousBufferSchemaPath<T>(version))
+		{
+			parser.ParseArray(out_values, numOfValues);
+			return;
+		}
+	}
+	for (size_t valueIndex = 0; valueIndex < numOfValues; ++valueIndex)
+	{
+		ParseWithSchema(parser, out_values[valueIndex], version);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void AppendFieldsWithSchema(BufferWriter& writer, T const& value, uint16_t version)
+{
+	ForEachBufferSchemaField<T>([&writer, &value, version](auto const& field)
+	{
+		if (field.m_sinceVersion <= version)
+		{
+			AppendWithSchema(writer, value.*(field.m_member), version);
+		}
+	});
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void ParseFieldsWithSchema(BufferParser& parser, T& out_value, uint16_t version)
+{
+	ForEachBufferSchemaField<T>([&parser, &out_value, version](auto const& field)
+	{
+		if (field.m_sinceVersion <= version)
+		{
+			ParseWithSchema(parser, out_value.*(field.m_member), version);
+		}
+	});
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void AppendTaggedWithSchema(BufferWriter& writer, T const& value)
+{
+	static_assert(HasBufferSchema<T>::value, "The tagged format needs a BufferSchema");
+	writer.AppendVarUInt32((uint32_t)std::tuple_size<std::decay_t<decltype(BufferSchema<T>::FIELDS)>>::value);
+	ForEachBufferSchemaField<T>([&writer, &value](auto const& field)
+	{
+		writer.AppendVarUInt32(field.m_id);
+		size_t sizeOffset = writer.GetCurrentWritePosition();
+		writer.AppendUInt32(0);
+		AppendWithSchema(writer, value.*(field.m_member));
+		writer.OverwriteUint32(sizeOffset, (uint32_t)(writer.GetCurrentWritePosition() - sizeOffset - 4));
+	});
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void ParseTaggedWithSchema(BufferParser& parser, T& out_value)
+{
+	static_assert(HasBufferSchema<T>::value, "The tagged format needs a BufferSchema");
+	uint32_t numOfFields = parser.ParseVarUInt32();
+	for (uint32_t fieldIndex = 0; fieldIndex < numOfFields; ++fieldIndex)
+	{
+		uint32_t	fieldId			=	parser.ParseVarUInt32();
+		uint32_t	fieldSize		=	parser.ParseUint32();
+		uint32_t	fieldEnd		=	parser.GetCurrentReadPosition() + fieldSize;
+		bool		isKnownField	=	false;
+		ForEachBufferSchemaField<T>([&parser, &out_value, fieldId, &isKnownField](auto const& field)
+		{
+			if (!isKnownField && field.m_id == fieldId)
+			{
+				ParseWithSchema(parser, out_value.*(field.m_member));
+				isKnownField = true;
+			}
+		});
+		if (!isKnownField)
+		{
+			parser.SkipBytes(fieldSize);
+		}
+		GUARANTEE_OR_DIE(parser.GetCurrentReadPosition() == fieldEnd, "Tagged field size does not match its data");
+	}
+}
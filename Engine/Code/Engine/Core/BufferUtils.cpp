@@ -1,5 +1,120 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/BufferUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <emmintrin.h>
+#include <string.h>
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// Reverses the bytes of every wordSize (1, 2, 4 or 8) word of bytes, 16 bytes at a time with SSE2
+// SSE2 has no byte shuffle, so bytes are swapped within 16 bit lanes by shifting, then the lanes are shuffled into place
+static void ReverseWordsInPlace(unsigned char* bytes, size_t numOfBytes, size_t wordSize)
+{
+	if (wordSize < 2)
+	{
+		return;
+	}
+
+	size_t byteIndex = 0;
+	for (; byteIndex + 16 <= numOfBytes; byteIndex += 16)
+	{
+		__m128i words	=	_mm_loadu_si128(reinterpret_cast<__m128i const*>(bytes + byteIndex));
+		words			=	_mm_or_si128(_mm_slli_epi16(words, 8), _mm_srli_epi16(words, 8));
+		if (wordSize == 4)
+		{
+			words = _mm_shufflelo_epi16(words, _MM_SHUFFLE(2, 3, 0, 1));
+			words = _mm_shufflehi_epi16(words, _MM_SHUFFLE(2, 3, 0, 1));
+		}
+		else if (wordSize == 8)
+		{
+			words = _mm_shufflelo_epi16(words, _MM_SHUFFLE(0, 1, 2, 3));
+			words = _mm_shufflehi_epi16(words, _MM_SHUFFLE(0, 1, 2, 3));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + byteIndex), words);
+	}
+
+	for (; byteIndex < numOfBytes; byteIndex += wordSize)
+	{
+		unsigned char* word = bytes + byteIndex;
+		for (size_t wordByteIndex = 0; wordByteIndex < wordSize / 2; ++wordByteIndex)
+		{
+			unsigned char byte					=	word[wordByteIndex];
+			word[wordByteIndex]					=	word[wordSize - 1 - wordByteIndex];
+			word[wordSize - 1 - wordByteIndex]	=	byte;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Brings elements from native to the opposite endianness or back, the byte word of every element (if it has one) keeps its order
+static void ReverseArrayElementsInPlace(unsigned char* elements, size_t numOfElements, size_t elementSize, size_t wordSize, size_t byteWordIndex)
+{
+	ReverseWordsInPlace(elements, numOfElements * elementSize, wordSize);
+	if (byteWordIndex == SIZE_MAX || wordSize < 2)
+	{
+		return;
+	}
+	for (size_t elementIndex = 0; elementIndex < numOfElements; ++elementIndex)
+	{
+		ReverseWordsInPlace(elements + elementIndex * elementSize + byteWordIndex * wordSize, wordSize, wordSize);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t ZigZagEncode32(int32_t value)
+{
+	return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int32_t ZigZagDecode32(uint32_t encodedValue)
+{
+	return (int32_t)((encodedValue >> 1) ^ (0u - (encodedValue & 1)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t ZigZagEncode64(int64_t value)
+{
+	return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int64_t ZigZagDecode64(uint64_t encodedValue)
+{
+	return (int64_t)((encodedValue >> 1) ^ (0ull - (encodedValue & 1)));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t QuantizeFloat(float value, float minValue, float maxValue, int numOfBits)
+{
+	GUARANTEE_OR_DIE(numOfBits >= 1 && numOfBits <= 32 && maxValue > minValue, "Quantized floats need 1 to 32 bits and a non empty range");
+	double maxQuantizedValue	=	double((uint64_t(1) << numOfBits) - 1);
+	double fractionOfRange		=	(double(GetClamped(value, minValue, maxValue)) - minValue) / (double(maxValue) - minValue);
+	return (uint32_t)(fractionOfRange * maxQuantizedValue + 0.5);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float DequantizeFloat(uint32_t quantizedValue, float minValue, float maxValue, int numOfBits)
+{
+	GUARANTEE_OR_DIE(numOfBits >= 1 && numOfBits <= 32 && maxValue > minValue, "Quantized floats need 1 to 32 bits and a non empty range");
+	double maxQuantizedValue = double((uint64_t(1) << numOfBits) - 1);
+	return (float)(minValue + (double(maxValue) - minValue) * (double(quantizedValue) / maxQuantizedValue));
+}
 
 
 //--------------------------------------------------------------------------------------------------
@@ -46,6 +161,13 @@ void BufferWriter::SetEndianMode(eBufferEndian endianMode)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+size_t BufferWriter::GetCurrentWritePosition() const
+{
+	return m_bufferToWriteTo.size();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void BufferWriter::AppendByte(uint8_t byteToAppend)
 {
@@ -366,6 +488,84 @@ void BufferWriter::OverwriteUint32(uint64_t writePosOffset, uint32_t overwrittin
 }
 
 
+//--------------------------------------------------------------------------------------------------
+void BufferWriter::AppendVarUInt32(uint32_t valueToAppend)
+{
+	AppendVarUInt64(valueToAppend);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BufferWriter::AppendVarUInt64(uint64_t valueToAppend)
+{
+	while (valueToAppend >= 0x80)
+	{
+		AppendByte((uint8_t)(valueToAppend | 0x80));
+		valueToAppend >>= 7;
+	}
+	AppendByte((uint8_t)valueToAppend);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BufferWriter::AppendVarInt32(int32_t valueToAppend)
+{
+	AppendVarUInt64(ZigZagEncode32(valueToAppend));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BufferWriter::AppendVarInt64(int64_t valueToAppend)
+{
+	AppendVarUInt64(ZigZagEncode64(valueToAppend));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BufferWriter::AppendDeltaInt32(int32_t valueToAppend, int32_t previousValue)
+{
+	AppendVarInt32((int32_t)((uint32_t)valueToAppend - (uint32_t)previousValue));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BufferWriter::AppendQuantizedFloat(float floatToAppend, float minValue, float maxValue, int numOfBits)
+{
+	uint32_t quantizedFloat = QuantizeFloat(floatToAppend, minValue, maxValue, numOfBits);
+	if (numOfBits <= 8)
+	{
+		AppendByte((uint8_t)quantizedFloat);
+	}
+	else if (numOfBits <= 16)
+	{
+		AppendUShort16((uint16_t)quantizedFloat);
+	}
+	else
+	{
+		AppendUInt32(quantizedFloat);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BufferWriter::AppendArrayBytes(void const* elementsToAppend, size_t numOfElements, size_t elementSize, size_t wordSize, size_t byteWordIndex)
+{
+	size_t numOfBytes = numOfElements * elementSize;
+	if (numOfBytes == 0)
+	{
+		return;
+	}
+	size_t firstByteIndex = m_bufferToWriteTo.size();
+	m_bufferToWriteTo.resize(firstByteIndex + numOfBytes);
+	unsigned char* bytes = m_bufferToWriteTo.data() + firstByteIndex;
+	memcpy(bytes, elementsToAppend, numOfBytes);
+	if (m_isOppositeNativeEndian)
+	{
+		ReverseArrayElementsInPlace(bytes, numOfElements, elementSize, wordSize, byteWordIndex);
+	}
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void BufferWriter::Reverse2BytesInPlace(void* bytesToReverseStartAddr)
 {
@@ -779,6 +979,109 @@ Vertex_PCUTBN BufferParser::ParseVertexPCUTBN()
 }
 
 
+//--------------------------------------------------------------------------------------------------
+uint32_t BufferParser::ParseVarUInt32()
+{
+	uint64_t parsedValue = ParseVarUInt64();
+	GUARANTEE_OR_DIE(parsedValue <= UINT32_MAX, "VarUInt32 out of range");
+	return (uint32_t)parsedValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t BufferParser::ParseVarUInt64()
+{
+	uint64_t parsedValue = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		unsigned char parsedByte = ParseByte();
+
+		// The 10th byte only has room for bit 63, anything more would be shifted out silently
+		GUARANTEE_OR_DIE(shift < 63 || parsedByte <= 0x01, "VarUInt64 out of range");
+		parsedValue |= uint64_t(parsedByte & 0x7F) << shift;
+		if ((parsedByte & 0x80) == 0)
+		{
+			return parsedValue;
+		}
+	}
+	ERROR_AND_DIE("VarUInt64 longer than 10 bytes");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int32_t BufferParser::ParseVarInt32()
+{
+	return ZigZagDecode32(ParseVarUInt32());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int64_t BufferParser::ParseVarInt64()
+{
+	return ZigZagDecode64(ParseVarUInt64());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int32_t BufferParser::ParseDeltaInt32(int32_t previousValue)
+{
+	return (int32_t)((uint32_t)previousValue + (uint32_t)ParseVarInt32());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float BufferParser::ParseQuantizedFloat(float minValue, float maxValue, int numOfBits)
+{
+	uint32_t quantizedFloat = 0;
+	if (numOfBits <= 8)
+	{
+		quantizedFloat = ParseByte();
+	}
+	else if (numOfBits <= 16)
+	{
+		quantizedFloat = ParseUShort16();
+	}
+	else
+	{
+		quantizedFloat = ParseUint32();
+	}
+	return DequantizeFloat(quantizedFloat, minValue, maxValue, numOfBits);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BufferParser::ParseArrayBytes(void* out_elements, size_t numOfElements, size_t elementSize, size_t wordSize, size_t byteWordIndex)
+{
+	uint64_t numOfBytes = uint64_t(numOfElements) * elementSize;
+	GUARANTEE_OR_DIE(m_currentOffsetFromStart + numOfBytes <= m_bufferSize, "Parsing Index out of bounds");
+	if (numOfBytes == 0)
+	{
+		return;
+	}
+	memcpy(out_elements, m_bufferStart + m_currentOffsetFromStart, (size_t)numOfBytes);
+	if (m_isOppositeNativeEndianess)
+	{
+		ReverseArrayElementsInPlace(static_cast<unsigned char*>(out_elements), numOfElements, elementSize, wordSize, byteWordIndex);
+	}
+	m_currentOffsetFromStart += (uint32_t)numOfBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void const* BufferParser::ViewArrayBytes(size_t numOfElements, size_t elementSize, size_t elementAlignment, size_t wordSize)
+{
+	uint64_t numOfBytes = uint64_t(numOfElements) * elementSize;
+	GUARANTEE_OR_DIE(m_currentOffsetFromStart + numOfBytes <= m_bufferSize, "Parsing Index out of bounds");
+	unsigned char const* elements = m_bufferStart + m_currentOffsetFromStart;
+	if ((m_isOppositeNativeEndianess && wordSize > 1) || reinterpret_cast<uintptr_t>(elements) % elementAlignment != 0)
+	{
+		return nullptr;
+	}
+	m_currentOffsetFromStart += (uint32_t)numOfBytes;
+	return elements;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 uint32_t BufferParser::GetCurrentReadPosition() const
 {
@@ -794,6 +1097,14 @@ void BufferParser::JumpCurrentReadPositionToDesiredOffsetWithinTheBuffer(uint32_
 }
 
 
+//--------------------------------------------------------------------------------------------------
+void BufferParser::SkipBytes(uint32_t numOfBytesToSkip)
+{
+	GUARANTEE_OR_DIE(uint64_t(m_currentOffsetFromStart) + numOfBytesToSkip <= m_bufferSize, "Parsing Index out of bounds");
+	m_currentOffsetFromStart += numOfBytesToSkip;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void BufferParser::Reverse2BytesInPlace(void* bytesToReverseStartAddr)
 {
@@ -827,3 +1138,596 @@ void BufferParser::Reverse8BytesInPlace(void* bytesToReverseStartAddr)
 												 ((originalDWordData & 0x00'FF'00'00'00'00'00'00) >> 40) |
 												 ((originalDWordData & 0xFF'00'00'00'00'00'00'00) >> 56));
 }
+
+
+//--------------------------------------------------------------------------------------------------
+BitWriter::BitWriter(Buffer& buffer) :
+	m_bufferToWriteTo(buffer)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+BitWriter::~BitWriter()
+{
+	Flush();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitWriter::WriteBits(uint32_t bitsToWrite, int numOfBits)
+{
+	GUARANTEE_OR_DIE(numOfBits >= 0 && numOfBits <= 32, "BitWriter writes 0 to 32 bits at a time");
+	uint64_t bitMask	=	(uint64_t(1) << numOfBits) - 1;
+	m_pendingBits		|=	(uint64_t(bitsToWrite) & bitMask) << m_numOfPendingBits;
+	m_numOfPendingBits	+=	numOfBits;
+	m_numOfBitsWritten	+=	numOfBits;
+	while (m_numOfPendingBits >= 8)
+	{
+		m_bufferToWriteTo.push_back((unsigned char)m_pendingBits);
+		m_pendingBits		>>=	8;
+		m_numOfPendingBits	-=	8;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitWriter::WriteBool(bool booleanToWrite)
+{
+	WriteBits(booleanToWrite ? 1 : 0, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitWriter::WriteSignedBits(int32_t valueToWrite, int numOfBits)
+{
+	WriteBits(ZigZagEncode32(valueToWrite), numOfBits);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitWriter::WriteVarUInt32(uint32_t valueToWrite)
+{
+	while (valueToWrite >= 0x80)
+	{
+		WriteBits((valueToWrite & 0x7F) | 0x80, 8);
+		valueToWrite >>= 7;
+	}
+	WriteBits(valueToWrite, 8);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitWriter::WriteVarInt32(int32_t valueToWrite)
+{
+	WriteVarUInt32(ZigZagEncode32(valueToWrite));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitWriter::WriteQuantizedFloat(float floatToWrite, float minValue, float maxValue, int numOfBits)
+{
+	WriteBits(QuantizeFloat(floatToWrite, minValue, maxValue, numOfBits), numOfBits);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitWriter::Flush()
+{
+	if (m_numOfPendingBits > 0)
+	{
+		m_bufferToWriteTo.push_back((unsigned char)m_pendingBits);
+		m_numOfBitsWritten	+=	8 - m_numOfPendingBits;
+		m_pendingBits		=	0;
+		m_numOfPendingBits	=	0;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t BitWriter::GetNumOfBitsWritten() const
+{
+	return m_numOfBitsWritten;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+BitReader::BitReader(unsigned char const* bufferToRead, size_t bufferSizeInBytes) :
+	m_bufferStart(bufferToRead),
+	m_bufferSizeInBits(bufferSizeInBytes * 8)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+BitReader::BitReader(Buffer const& buffer) :
+	m_bufferStart(buffer.data()),
+	m_bufferSizeInBits(buffer.size() * 8)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t BitReader::ReadBits(int numOfBits)
+{
+	GUARANTEE_OR_DIE(numOfBits >= 0 && numOfBits <= 32, "BitReader reads 0 to 32 bits at a time");
+	GUARANTEE_OR_DIE(m_numOfBitsRead + numOfBits <= m_bufferSizeInBits, "Reading past the end of the bits");
+
+	// At most 5 bytes hold the bits, 7 bits into the first byte plus 32 bits
+	size_t		firstByteIndex	=	m_numOfBitsRead >> 3;
+	int			firstBitIndex	=	(int)(m_numOfBitsRead & 7);
+	int			numOfBytes		=	(firstBitIndex + numOfBits + 7) >> 3;
+	uint64_t	bits			=	0;
+	for (int byteIndex = 0; byteIndex < numOfBytes; ++byteIndex)
+	{
+		bits |= uint64_t(m_bufferStart[firstByteIndex + byteIndex]) << (8 * byteIndex);
+	}
+	m_numOfBitsRead += numOfBits;
+	return (uint32_t)((bits >> firstBitIndex) & ((uint64_t(1) << numOfBits) - 1));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool BitReader::ReadBool()
+{
+	return ReadBits(1) != 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int32_t BitReader::ReadSignedBits(int numOfBits)
+{
+	return ZigZagDecode32(ReadBits(numOfBits));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t BitReader::ReadVarUInt32()
+{
+	uint64_t readValue = 0;
+	for (int shift = 0; shift < 35; shift += 7)
+	{
+		uint32_t readByte	=	ReadBits(8);
+		readValue			|=	uint64_t(readByte & 0x7F) << shift;
+		if ((readByte & 0x80) == 0)
+		{
+			GUARANTEE_OR_DIE(readValue <= UINT32_MAX, "VarUInt32 out of range");
+			return (uint32_t)readValue;
+		}
+	}
+	ERROR_AND_DIE("VarUInt32 longer than 5 bytes");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int32_t BitReader::ReadVarInt32()
+{
+	return ZigZagDecode32(ReadVarUInt32());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float BitReader::ReadQuantizedFloat(float minValue, float maxValue, int numOfBits)
+{
+	return DequantizeFloat(ReadBits(numOfBits), minValue, maxValue, numOfBits);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t BitReader::GetNumOfBitsRead() const
+{
+	return m_numOfBitsRead;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Writes and reads NumOfVerts Vertex_PCUTBNs one at a time and as an array, in native and in the opposite endianness,
+// and checks both ways produce the same bytes and read back the same vertexes
+bool Command_BufferArrayBenchmark(EventArgs& args)
+{
+	int numOfVerts = args.GetValue("NumOfVerts", 1000000);
+	if (numOfVerts <= 0)
+	{
+		return false;
+	}
+
+	std::vector<Vertex_PCUTBN> verts((size_t)numOfVerts);
+	for (int vertIndex = 0; vertIndex < numOfVerts; ++vertIndex)
+	{
+		float value = (float)vertIndex;
+		verts[vertIndex] = Vertex_PCUTBN(Vec3(value, value * 0.5f, -value), Rgba8((unsigned char)vertIndex, 20, 30, 40), Vec2(value * 0.25f, 1.f / (value + 1.f)),
+										 Vec3(1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, 0.f, value));
+	}
+
+	Buffer			scratchBuffer;
+	eBufferEndian	nativeEndianness	=	BufferWriter(scratchBuffer).GetNativeEndianness();
+	eBufferEndian	oppositeEndianness	=	nativeEndianness == eBufferEndian::LITTLE ? eBufferEndian::BIG : eBufferEndian::LITTLE;
+	eBufferEndian	endiannesses[2]		=	{ nativeEndianness, oppositeEndianness };
+
+	bool areAllIdentical = true;
+	for (int endiannessIndex = 0; endiannessIndex < 2; ++endiannessIndex)
+	{
+		eBufferEndian endianness = endiannesses[endiannessIndex];
+
+		Buffer perVertexBuffer;
+		perVertexBuffer.reserve(verts.size() * sizeof(Vertex_PCUTBN));
+		double timeBeforePerVertexAppend = GetCurrentTimeSeconds();
+		BufferWriter perVertexWriter(perVertexBuffer, endianness);
+		for (size_t vertIndex = 0; vertIndex < verts.size(); ++vertIndex)
+		{
+			perVertexWriter.AppendVertexPCUTBN(verts[vertIndex]);
+		}
+		double perVertexAppendSeconds = GetCurrentTimeSeconds() - timeBeforePerVertexAppend;
+
+		Buffer arrayBuffer;
+		arrayBuffer.reserve(verts.size() * sizeof(Vertex_PCUTBN));
+		double timeBeforeArrayAppend = GetCurrentTimeSeconds();
+		BufferWriter arrayWriter(arrayBuffer, endianness);
+		arrayWriter.AppendArray(verts);
+		double arrayAppendSeconds = GetCurrentTimeSeconds() - timeBeforeArrayAppend;
+
+		std::vector<Vertex_PCUTBN> perVertexVerts(verts.size());
+		double timeBeforePerVertexParse = GetCurrentTimeSeconds();
+		BufferParser perVertexParser(arrayBuffer, endianness);
+		for (size_t vertIndex = 0; vertIndex < perVertexVerts.size(); ++vertIndex)
+		{
+			perVertexVerts[vertIndex] = perVertexParser.ParseVertexPCUTBN();
+		}
+		double perVertexParseSeconds = GetCurrentTimeSeconds() - timeBeforePerVertexParse;
+
+		std::vector<Vertex_PCUTBN> arrayVerts;
+		arrayVerts.reserve(verts.size());
+		double timeBeforeArrayParse = GetCurrentTimeSeconds();
+		BufferParser arrayParser(arrayBuffer, endianness);
+		arrayParser.ParseArray(arrayVerts, verts.size());
+		double arrayParseSeconds = GetCurrentTimeSeconds() - timeBeforeArrayParse;
+
+		BufferParser			viewParser(arrayBuffer, endianness);
+		Vertex_PCUTBN const*	viewedVerts		=	viewParser.ViewArray<Vertex_PCUTBN>(verts.size());
+		bool					isViewIdentical	=	viewedVerts == nullptr || memcmp(viewedVerts, verts.data(), verts.size() * sizeof(Vertex_PCUTBN)) == 0;
+
+		bool isIdentical	=	perVertexBuffer == arrayBuffer && isViewIdentical &&
+								memcmp(perVertexVerts.data(), verts.data(), verts.size() * sizeof(Vertex_PCUTBN)) == 0 &&
+								memcmp(arrayVerts.data(), verts.data(), verts.size() * sizeof(Vertex_PCUTBN)) == 0;
+		areAllIdentical		=	areAllIdentical && isIdentical;
+		PrintBenchmarkResult(Stringf("%s endian, %d verts: append %.2f ms -> %.2f ms (%.1fx), parse %.2f ms -> %.2f ms (%.1fx), view %s, %s",
+									 endiannessIndex == 0 ? "native" : "opposite", numOfVerts,
+									 perVertexAppendSeconds * 1000.0, arrayAppendSeconds * 1000.0, perVertexAppendSeconds / arrayAppendSeconds,
+									 perVertexParseSeconds * 1000.0, arrayParseSeconds * 1000.0, perVertexParseSeconds / arrayParseSeconds,
+									 viewedVerts ? "zero copy" : "not possible", isIdentical ? "identical" : "MISMATCH"), !isIdentical);
+	}
+	return areAllIdentical;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// A synthetic networked entity for Command_BufferEncodingBenchmark
+struct BenchmarkEntity
+{
+	uint32_t	m_id			=	0;
+	Vec3		m_position;
+	float		m_yawDegrees	=	0.f;
+	int32_t		m_health		=	100;
+	bool		m_isAlive		=	true;
+	uint8_t		m_teamIndex		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// The quantized state both sides of a delta encoding keep, deltas are taken against this rather than the exact floats so errors never build up
+struct QuantizedBenchmarkEntity
+{
+	uint32_t	m_id			=	0;
+	int32_t		m_position[3]	=	{ 0, 0, 0 };
+	int32_t		m_health		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr float	BENCHMARK_WORLD_HALF_SIZE		=	512.f;
+constexpr int	BENCHMARK_POSITION_BITS			=	18;		// 1024 / 2^18, about 4 mm
+constexpr int	BENCHMARK_YAW_BITS				=	10;		// About a third of a degree
+
+
+//--------------------------------------------------------------------------------------------------
+static void AppendFullWidthSnapshot(BufferWriter& writer, std::vector<BenchmarkEntity> const& entities)
+{
+	for (BenchmarkEntity const& entity : entities)
+	{
+		writer.AppendUInt32(entity.m_id);
+		writer.AppendVec3(entity.m_position);
+		writer.AppendFloat(entity.m_yawDegrees);
+		writer.AppendInt32(entity.m_health);
+		writer.AppendBool(entity.m_isAlive);
+		writer.AppendByte(entity.m_teamIndex);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Byte aligned: varint id and health deltas, quantized position deltas, a 16 bit yaw and the bools and team in one byte
+static void AppendVarIntSnapshot(BufferWriter& writer, std::vector<BenchmarkEntity> const& entities, std::vector<QuantizedBenchmarkEntity>& previousEntities)
+{
+	uint32_t previousId = 0;
+	for (size_t entityIndex = 0; entityIndex < entities.size(); ++entityIndex)
+	{
+		BenchmarkEntity const&		entity			=	entities[entityIndex];
+		QuantizedBenchmarkEntity&	previousEntity	=	previousEntities[entityIndex];
+		writer.AppendDeltaInt32((int32_t)entity.m_id, (int32_t)previousId + 1);
+		previousId = entity.m_id;
+		for (int axisIndex = 0; axisIndex < 3; ++axisIndex)
+		{
+			int32_t quantizedPosition = (int32_t)QuantizeFloat((&entity.m_position.x)[axisIndex], -BENCHMARK_WORLD_HALF_SIZE, BENCHMARK_WORLD_HALF_SIZE, BENCHMARK_POSITION_BITS);
+			writer.AppendDeltaInt32(quantizedPosition, previousEntity.m_position[axisIndex]);
+			previousEntity.m_position[axisIndex] = quantizedPosition;
+		}
+		writer.AppendQuantizedFloat(entity.m_yawDegrees, 0.f, 360.f, 16);
+		writer.AppendDeltaInt32(entity.m_health, previousEntity.m_health);
+		previousEntity.m_health = entity.m_health;
+		writer.AppendByte((uint8_t)((entity.m_isAlive ? 1 : 0) | (entity.m_teamIndex << 1)));
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void ParseVarIntSnapshot(BufferParser& parser, std::vector<BenchmarkEntity>& out_entities, std::vector<QuantizedBenchmarkEntity>& previousEntities)
+{
+	uint32_t previousId = 0;
+	for (size_t entityIndex = 0; entityIndex < out_entities.size(); ++entityIndex)
+	{
+		BenchmarkEntity&			entity			=	out_entities[entityIndex];
+		QuantizedBenchmarkEntity&	previousEntity	=	previousEntities[entityIndex];
+		entity.m_id	=	(uint32_t)parser.ParseDeltaInt32((int32_t)previousId + 1);
+		previousId	=	entity.m_id;
+		for (int axisIndex = 0; axisIndex < 3; ++axisIndex)
+		{
+			previousEntity.m_position[axisIndex]	=	parser.ParseDeltaInt32(previousEntity.m_position[axisIndex]);
+			(&entity.m_position.x)[axisIndex]		=	DequantizeFloat((uint32_t)previousEntity.m_position[axisIndex], -BENCHMARK_WORLD_HALF_SIZE, BENCHMARK_WORLD_HALF_SIZE, BENCHMARK_POSITION_BITS);
+		}
+		entity.m_yawDegrees		=	parser.ParseQuantizedFloat(0.f, 360.f, 16);
+		entity.m_health			=	parser.ParseDeltaInt32(previousEntity.m_health);
+		previousEntity.m_health	=	entity.m_health;
+		uint8_t flags			=	parser.ParseByte();
+		entity.m_isAlive		=	(flags & 1) != 0;
+		entity.m_teamIndex		=	(uint8_t)(flags >> 1);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Bit packed: a changed bit in front of every delta so unchanged fields cost a single bit, then only the bits each field needs
+static void WriteBitPackedSnapshot(BitWriter& writer, std::vector<BenchmarkEntity> const& entities, std::vector<QuantizedBenchmarkEntity>& previousEntities)
+{
+	uint32_t previousId = 0;
+	for (size_t entityIndex = 0; entityIndex < entities.size(); ++entityIndex)
+	{
+		BenchmarkEntity const&		entity			=	entities[entityIndex];
+		QuantizedBenchmarkEntity&	previousEntity	=	previousEntities[entityIndex];
+		uint32_t					idGap			=	entity.m_id - previousId - 1;
+		writer.WriteBool(idGap != 0);
+		if (idGap != 0)
+		{
+			writer.WriteVarUInt32(idGap);
+		}
+		previousId = entity.m_id;
+
+		for (int axisIndex = 0; axisIndex < 3; ++axisIndex)
+		{
+			int32_t quantizedPosition	=	(int32_t)QuantizeFloat((&entity.m_position.x)[axisIndex], -BENCHMARK_WORLD_HALF_SIZE, BENCHMARK_WORLD_HALF_SIZE, BENCHMARK_POSITION_BITS);
+			int32_t positionDelta		=	quantizedPosition - previousEntity.m_position[axisIndex];
+			writer.WriteBool(positionDelta != 0);
+			if (positionDelta != 0)
+			{
+				writer.WriteVarInt32(positionDelta);
+			}
+			previousEntity.m_position[axisIndex] = quantizedPosition;
+		}
+		writer.WriteQuantizedFloat(entity.m_yawDegrees, 0.f, 360.f, BENCHMARK_YAW_BITS);
+
+		bool hasHealthChanged = entity.m_health != previousEntity.m_health;
+		writer.WriteBool(hasHealthChanged);
+		if (hasHealthChanged)
+		{
+			writer.WriteBits((uint32_t)entity.m_health, 7);
+		}
+		previousEntity.m_health = entity.m_health;
+		writer.WriteBool(entity.m_isAlive);
+		writer.WriteBits(entity.m_teamIndex, 2);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void ReadBitPackedSnapshot(BitReader& reader, std::vector<BenchmarkEntity>& out_entities, std::vector<QuantizedBenchmarkEntity>& previousEntities)
+{
+	uint32_t previousId = 0;
+	for (size_t entityIndex = 0; entityIndex < out_entities.size(); ++entityIndex)
+	{
+		BenchmarkEntity&			entity			=	out_entities[entityIndex];
+		QuantizedBenchmarkEntity&	previousEntity	=	previousEntities[entityIndex];
+		uint32_t					idGap			=	reader.ReadBool() ? reader.ReadVarUInt32() : 0;
+		entity.m_id	=	previousId + 1 + idGap;
+		previousId	=	entity.m_id;
+
+		for (int axisIndex = 0; axisIndex < 3; ++axisIndex)
+		{
+			int32_t positionDelta					=	reader.ReadBool() ? reader.ReadVarInt32() : 0;
+			previousEntity.m_position[axisIndex]	+=	positionDelta;
+			(&entity.m_position.x)[axisIndex]		=	DequantizeFloat((uint32_t)previousEntity.m_position[axisIndex], -BENCHMARK_WORLD_HALF_SIZE, BENCHMARK_WORLD_HALF_SIZE, BENCHMARK_POSITION_BITS);
+		}
+		entity.m_yawDegrees = reader.ReadQuantizedFloat(0.f, 360.f, BENCHMARK_YAW_BITS);
+
+		if (reader.ReadBool())
+		{
+			previousEntity.m_health = (int32_t)reader.ReadBits(7);
+		}
+		entity.m_health		=	previousEntity.m_health;
+		entity.m_isAlive	=	reader.ReadBool();
+		entity.m_teamIndex	=	(uint8_t)reader.ReadBits(2);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Decoded entities have to match exactly except for the quantized floats, which have to be within half a quantization step
+static bool AreBenchmarkEntitiesEqual(std::vector<BenchmarkEntity> const& entities, std::vector<BenchmarkEntity> const& decodedEntities, int numOfYawBits)
+{
+	float maxPositionError	=	0.5001f * (2.f * BENCHMARK_WORLD_HALF_SIZE) / float((1 << BENCHMARK_POSITION_BITS) - 1);
+	float maxYawError		=	0.5001f * 360.f / float((1 << numOfYawBits) - 1);
+	for (size_t entityIndex = 0; entityIndex < entities.size(); ++entityIndex)
+	{
+		BenchmarkEntity const& entity			=	entities[entityIndex];
+		BenchmarkEntity const& decodedEntity	=	decodedEntities[entityIndex];
+		if (entity.m_id != decodedEntity.m_id || entity.m_health != decodedEntity.m_health || entity.m_isAlive != decodedEntity.m_isAlive || entity.m_teamIndex != decodedEntity.m_teamIndex ||
+			fabsf(entity.m_position.x - decodedEntity.m_position.x) > maxPositionError || fabsf(entity.m_position.y - decodedEntity.m_position.y) > maxPositionError ||
+			fabsf(entity.m_position.z - decodedEntity.m_position.z) > maxPositionError || fabsf(entity.m_yawDegrees - decodedEntity.m_yawDegrees) > maxYawError)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Edge values through every encoding, then bits written in random widths
+static bool RunBufferEncodingRoundTrips()
+{
+	int64_t const	signedValues[]		=	{ 0, 1, -1, 63, -64, 64, -65, 127, 128, -129, 16383, 16384, INT32_MAX, INT32_MIN, INT64_MAX, INT64_MIN };
+	Buffer			buffer;
+	BufferWriter	writer(buffer, eBufferEndian::BIG);
+	for (int64_t value : signedValues)
+	{
+		writer.AppendVarInt64(value);
+		writer.AppendVarUInt64((uint64_t)value);
+		writer.AppendVarInt32((int32_t)value);
+		writer.AppendVarUInt32((uint32_t)value);
+		writer.AppendDeltaInt32((int32_t)value, INT32_MAX);
+		writer.AppendQuantizedFloat((float)value, -1000.f, 1000.f, 12);
+	}
+
+	bool			isValid = buffer.size() > 0 && buffer[0] == 0 && buffer[1] == 0;
+	BufferParser	parser(buffer, eBufferEndian::BIG);
+	for (int64_t value : signedValues)
+	{
+		float expectedFloat	=	GetClamped((float)value, -1000.f, 1000.f);
+		isValid				=	isValid && parser.ParseVarInt64() == value && parser.ParseVarUInt64() == (uint64_t)value;
+		isValid				=	isValid && parser.ParseVarInt32() == (int32_t)value && parser.ParseVarUInt32() == (uint32_t)value;
+		isValid				=	isValid && parser.ParseDeltaInt32(INT32_MAX) == (int32_t)value;
+		isValid				=	isValid && fabsf(parser.ParseQuantizedFloat(-1000.f, 1000.f, 12) - expectedFloat) <= 0.5001f * 2000.f / 4095.f;
+	}
+	isValid = isValid && parser.GetCurrentReadPosition() == (uint32_t)buffer.size();
+
+	RandomNumberGenerator	rng;
+	std::vector<uint32_t>	bitValues;
+	std::vector<int>		bitCounts;
+	Buffer					bitBuffer;
+	{
+		BitWriter bitWriter(bitBuffer);
+		for (int valueIndex = 0; valueIndex < 10000; ++valueIndex)
+		{
+			int			numOfBits	=	rng.RollRandomIntInRange(0, 32);
+			uint32_t	value		=	(uint32_t)rng.RollRandomIntLessThan(0x7FFFFFFF) * 2654435761u;
+			bitWriter.WriteBits(value, numOfBits);
+			bitValues.push_back(numOfBits == 32 ? value : value & ((1u << numOfBits) - 1));
+			bitCounts.push_back(numOfBits);
+		}
+		bitWriter.WriteSignedBits(-5, 4);
+		bitWriter.WriteVarInt32(INT32_MIN);
+		bitWriter.WriteQuantizedFloat(0.25f, 0.f, 1.f, 3);
+	}
+	BitReader bitReader(bitBuffer);
+	for (size_t valueIndex = 0; valueIndex < bitValues.size(); ++valueIndex)
+	{
+		isValid = isValid && bitReader.ReadBits(bitCounts[valueIndex]) == bitValues[valueIndex];
+	}
+	isValid = isValid && bitReader.ReadSignedBits(4) == -5 && bitReader.ReadVarInt32() == INT32_MIN && bitReader.ReadQuantizedFloat(0.f, 1.f, 3) == 2.f / 7.f;
+	isValid = isValid && (bitReader.GetNumOfBitsRead() + 7) / 8 == bitBuffer.size();
+	return isValid;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Round trips every encoding, then writes NumOfFrames snapshots of NumOfEntities slowly moving entities full width, with varints and deltas,
+// and bit packed, decodes them all again and reports the bytes per entity each way
+bool Command_BufferEncodingBenchmark(EventArgs& args)
+{
+	int numOfEntities	=	args.GetValue("NumOfEntities", 1000);
+	int numOfFrames		=	args.GetValue("NumOfFrames", 60);
+	if (numOfEntities <= 0 || numOfFrames <= 0)
+	{
+		return false;
+	}
+
+	bool areRoundTripsValid = RunBufferEncodingRoundTrips();
+	PrintBenchmarkResult(Stringf("Varint, zigzag, delta, quantized float and bit packing round trips: %s", areRoundTripsValid ? "PASSED" : "FAILED"), !areRoundTripsValid);
+
+	// Ids mostly consecutive with a few gaps, entities walk a little each frame, a few take damage
+	RandomNumberGenerator			rng;
+	std::vector<BenchmarkEntity>	entities((size_t)numOfEntities);
+	uint32_t						nextId		=	1000;
+	for (BenchmarkEntity& entity : entities)
+	{
+		nextId					+=	rng.RollRandomIntLessThan(10) == 0 ? (uint32_t)rng.RollRandomIntInRange(1, 50) : 1;
+		entity.m_id				=	nextId;
+		entity.m_position		=	Vec3(rng.RollRandomFloatInRange(-500.f, 500.f), rng.RollRandomFloatInRange(-500.f, 500.f), rng.RollRandomFloatInRange(0.f, 10.f));
+		entity.m_yawDegrees		=	rng.RollRandomFloatInRange(0.f, 360.f);
+		entity.m_teamIndex		=	(uint8_t)rng.RollRandomIntLessThan(4);
+	}
+
+	std::vector<QuantizedBenchmarkEntity>	varIntEncoderState((size_t)numOfEntities);
+	std::vector<QuantizedBenchmarkEntity>	varIntDecoderState((size_t)numOfEntities);
+	std::vector<QuantizedBenchmarkEntity>	bitPackedEncoderState((size_t)numOfEntities);
+	std::vector<QuantizedBenchmarkEntity>	bitPackedDecoderState((size_t)numOfEntities);
+	std::vector<BenchmarkEntity>			decodedEntities((size_t)numOfEntities);
+	size_t	numOfFullWidthBytes		=	0;
+	size_t	numOfVarIntBytes		=	0;
+	size_t	numOfBitPackedBytes		=	0;
+	bool	areSnapshotsValid		=	true;
+	for (int frameIndex = 0; frameIndex < numOfFrames; ++frameIndex)
+	{
+		for (BenchmarkEntity& entity : entities)
+		{
+			if (rng.RollRandomIntLessThan(4) != 0)
+			{
+				entity.m_position.x	=	GetClamped(entity.m_position.x + rng.RollRandomFloatInRange(-0.1f, 0.1f), -500.f, 500.f);
+				entity.m_position.y	=	GetClamped(entity.m_position.y + rng.RollRandomFloatInRange(-0.1f, 0.1f), -500.f, 500.f);
+				entity.m_yawDegrees	=	GetClamped(entity.m_yawDegrees + rng.RollRandomFloatInRange(-2.f, 2.f), 0.f, 360.f);
+			}
+			if (rng.RollRandomIntLessThan(50) == 0)
+			{
+				entity.m_health		=	entity.m_health > 10 ? entity.m_health - 10 : 100;
+				entity.m_isAlive	=	entity.m_health > 20;
+			}
+		}
+
+		Buffer fullWidthBuffer;
+		BufferWriter fullWidthWriter(fullWidthBuffer);
+		AppendFullWidthSnapshot(fullWidthWriter, entities);
+		numOfFullWidthBytes += fullWidthBuffer.size();
+
+		Buffer varIntBuffer;
+		BufferWriter varIntWriter(varIntBuffer);
+		AppendVarIntSnapshot(varIntWriter, entities, varIntEncoderState);
+		numOfVarIntBytes += varIntBuffer.size();
+		BufferParser varIntParser(varIntBuffer);
+		ParseVarIntSnapshot(varIntParser, decodedEntities, varIntDecoderState);
+		areSnapshotsValid = areSnapshotsValid && AreBenchmarkEntitiesEqual(entities, decodedEntities, 16) && varIntParser.GetCurrentReadPosition() == (uint32_t)varIntBuffer.size();
+
+		Buffer bitPackedBuffer;
+		{
+			BitWriter bitPackedWriter(bitPackedBuffer);
+			WriteBitPackedSnapshot(bitPackedWriter, entities, bitPackedEncoderState);
+		}
+		numOfBitPackedBytes += bitPackedBuffer.size();
+		BitReader bitPackedReader(bitPackedBuffer);
+		ReadBitPackedSnapshot(bitPackedReader, decodedEntities, bitPackedDecoderState);
+		areSnapshotsValid = areSnapshotsValid && AreBenchmarkEntitiesEqual(entities, decodedEntities, BENCHMARK_YAW_BITS);
+	}
+
+	double numOfEntitySnapshots = double(numOfEntities) * numOfFrames;
+	PrintBenchmarkResult(Stringf("%d entities x %d frames, bytes per entity: full width %.2f, varint + delta %.2f, bit packed + delta %.2f, decoded %s", numOfEntities, numOfFrames,
+								 numOfFullWidthBytes / numOfEntitySnapshots, numOfVarIntBytes / numOfEntitySnapshots, numOfBitPackedBytes / numOfEntitySnapshots,
+								 areSnapshotsValid ? "within quantization error" : "WRONG"), !areSnapshotsValid);
+	return areRoundTripsValid && areSnapshotsValid;
+}
@@ -15,11 +15,13 @@
 #include "Engine/Math/IntVec3.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
 #include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Core/EventSystem.hpp"
 
 
 //--------------------------------------------------------------------------------------------------
 #include <vector>
 #include <stdint.h>
+#include <type_traits>
 #include <Engine/Core/Rgba8.hpp>
 
 
@@ -36,6 +38,46 @@ enum class eBufferEndian : unsigned char
 };
 
 
+//--------------------------------------------------------------------------------------------------
+// Zigzag maps signed integers to unsigned ones so small magnitudes stay small (0, -1, 1, -2 -> 0, 1, 2, 3) and varint encode well
+uint32_t	ZigZagEncode32(int32_t value);
+int32_t		ZigZagDecode32(uint32_t encodedValue);
+uint64_t	ZigZagEncode64(int64_t value);
+int64_t		ZigZagDecode64(uint64_t encodedValue);
+
+// value is clamped to [minValue, maxValue] and rounded to the nearest of 2^numOfBits evenly spaced steps, numOfBits is 1 to 32
+// The round trip error is at most half a step, (maxValue - minValue) / (2^numOfBits - 1) / 2
+uint32_t	QuantizeFloat(float value, float minValue, float maxValue, int numOfBits);
+float		DequantizeFloat(uint32_t quantizedValue, float minValue, float maxValue, int numOfBits);
+
+
+//--------------------------------------------------------------------------------------------------
+// How AppendArray, ParseArray and ViewArray see an element type: its buffer bytes are exactly its memory bytes (no padding),
+// made of WORD_SIZE words that get reversed for the opposite endianness. BYTE_WORD_INDEX is a word of single bytes (an Rgba8) that never is
+// Arithmetic types work as they are, structs need a specialization (see the bottom of this file)
+template <typename T, typename = void>
+struct BufferArrayLayout
+{
+};
+
+template <typename T>
+struct BufferArrayLayout<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+	static constexpr size_t WORD_SIZE			=	sizeof(T);
+	static constexpr size_t BYTE_WORD_INDEX		=	SIZE_MAX;
+};
+
+template <typename T, typename = void>
+struct HasBufferArrayLayout : std::false_type
+{
+};
+
+template <typename T>
+struct HasBufferArrayLayout<T, std::void_t<decltype(BufferArrayLayout<T>::WORD_SIZE)>> : std::true_type
+{
+};
+
+
 //--------------------------------------------------------------------------------------------------
 class BufferWriter
 {
@@ -46,6 +88,7 @@ public:
 	eBufferEndian GetNativeEndianness() const;
 	eBufferEndian GetCurrentEndianness() const;
 	void SetEndianMode(eBufferEndian endianMode);
+	size_t GetCurrentWritePosition() const;
 	
 	void AppendByte(uint8_t dataToAppend);
 	void AppendChar(int8_t dataToAppend);
@@ -76,10 +119,28 @@ public:
 	void AppendVertexPCUTBN(Vertex_PCUTBN const& vertexToAppend);
 	void OverwriteUint32(uint64_t writePosOffset, uint32_t overwrittingDWord);
 
+	// LEB128 varints, 7 bits per byte with the high bit set on all but the last byte, so values under 128 take a single byte
+	// They are byte streams and come out the same in any endian mode. The signed ones are zigzag encoded first
+	void AppendVarUInt32(uint32_t valueToAppend);
+	void AppendVarUInt64(uint64_t valueToAppend);
+	void AppendVarInt32(int32_t valueToAppend);
+	void AppendVarInt64(int64_t valueToAppend);
+	// The difference to previousValue as a VarInt, cheap for values that change slowly. The difference wraps around instead of overflowing
+	void AppendDeltaInt32(int32_t valueToAppend, int32_t previousValue);
+	// QuantizeFloat into 1, 2 or 4 bytes, whichever is the smallest that holds numOfBits
+	void AppendQuantizedFloat(float floatToAppend, float minValue, float maxValue, int numOfBits);
+
+	// Writes the same bytes as appending the elements one at a time with the matching Append function, with one resize and a memcpy
+	template <typename T> void AppendArray(T const* elementsToAppend, size_t numOfElements);
+	template <typename T> void AppendArray(std::vector<T> const& elementsToAppend);
+
 	void Reverse2BytesInPlace(void* bytesToReverseStartAddr);
 	void Reverse4BytesInPlace(void* bytesToReverseStartAddr);
 	void Reverse8BytesInPlace(void* bytesToReverseStartAddr);
 
+private:
+	void AppendArrayBytes(void const* elementsToAppend, size_t numOfElements, size_t elementSize, size_t wordSize, size_t byteWordIndex);
+
 private:
 	Buffer&			m_bufferToWriteTo;
 	eBufferEndian	m_currentEndianness			=	eBufferEndian::NATIVE;
@@ -125,18 +186,162 @@ public:
 	Plane2D			ParsePlane2D();
 	Vertex_PCU		ParseVertexPCU();
 	Vertex_PCUTBN	ParseVertexPCUTBN();
+	uint32_t		ParseVarUInt32();
+	uint64_t		ParseVarUInt64();
+	int32_t			ParseVarInt32();
+	int64_t			ParseVarInt64();
+	int32_t			ParseDeltaInt32(int32_t previousValue);
+	float			ParseQuantizedFloat(float minValue, float maxValue, int numOfBits);
+
+	// Reads what AppendArray wrote, ParseArray copies (the vector version appends to out_elements)
+	// ViewArray points straight into the buffer instead when that needs no byte swapping and the elements are aligned for T there,
+	// otherwise it returns nullptr without moving the read position so the caller can fall back to ParseArray
+	template <typename T> void		ParseArray(T* out_elements, size_t numOfElements);
+	template <typename T> void		ParseArray(std::vector<T>& out_elements, size_t numOfElements);
+	template <typename T> T const*	ViewArray(size_t numOfElements);
 
 	uint32_t	GetCurrentReadPosition() const;
 	void		JumpCurrentReadPositionToDesiredOffsetWithinTheBuffer(uint32_t newOffset);
+	void		SkipBytes(uint32_t numOfBytesToSkip);		// Unlike jumping, this can move the read position to the very end of the buffer
 
 	void Reverse2BytesInPlace(void* bytesToReverseStartAddr);
 	void Reverse4BytesInPlace(void* bytesToReverseStartAddr);
 	void Reverse8BytesInPlace(void* bytesToReverseStartAddr);
 
+private:
+	void		ParseArrayBytes(void* out_elements, size_t numOfElements, size_t elementSize, size_t wordSize, size_t byteWordIndex);
+	void const*	ViewArrayBytes(size_t numOfElements, size_t elementSize, size_t elementAlignment, size_t wordSize);
+
 public:
 	unsigned char const*	m_bufferStart					=	nullptr;
 	uint32_t				m_bufferSize					=	0;
 	uint32_t				m_currentOffsetFromStart		=	0;
 	bool					m_isOppositeNativeEndianess		=	false;
 	eBufferEndian			m_currentEndianness				=	eBufferEndian::NATIVE;
-};
\ No newline at end of file
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Packs values into only as many bits as they need, least significant bit first, with no byte alignment between values
+// Whole bytes go into the buffer as they fill up, Flush (also done by the destructor) pads the last one with zero bits
+class BitWriter
+{
+public:
+	BitWriter(Buffer& buffer);
+	~BitWriter();
+
+	void	WriteBits(uint32_t bitsToWrite, int numOfBits);		// The low numOfBits (0 to 32) bits of bitsToWrite
+	void	WriteBool(bool booleanToWrite);
+	void	WriteSignedBits(int32_t valueToWrite, int numOfBits);	// Zigzag encoded, so numOfBits holds values in [-2^(numOfBits - 1), 2^(numOfBits - 1) - 1]
+	void	WriteVarUInt32(uint32_t valueToWrite);					// LEB128 groups of 7 bits, like BufferWriter::AppendVarUInt32
+	void	WriteVarInt32(int32_t valueToWrite);
+	void	WriteQuantizedFloat(float floatToWrite, float minValue, float maxValue, int numOfBits);
+	void	Flush();
+
+	size_t	GetNumOfBitsWritten() const;
+
+private:
+	Buffer&		m_bufferToWriteTo;
+	uint64_t	m_pendingBits				=	0;
+	int			m_numOfPendingBits			=	0;
+	size_t		m_numOfBitsWritten			=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Reads what a BitWriter wrote, in the same order with the same bit counts
+class BitReader
+{
+public:
+	BitReader(unsigned char const* bufferToRead, size_t bufferSizeInBytes);
+	BitReader(Buffer const& buffer);
+
+	uint32_t	ReadBits(int numOfBits);
+	bool		ReadBool();
+	int32_t		ReadSignedBits(int numOfBits);
+	uint32_t	ReadVarUInt32();
+	int32_t		ReadVarInt32();
+	float		ReadQuantizedFloat(float minValue, float maxValue, int numOfBits);
+
+	size_t		GetNumOfBitsRead() const;
+
+private:
+	unsigned char const*	m_bufferStart		=	nullptr;
+	size_t					m_bufferSizeInBits	=	0;
+	size_t					m_numOfBitsRead		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_BufferArrayBenchmark(EventArgs& args);
+bool Command_BufferEncodingBenchmark(EventArgs& args);
+
+
+//--------------------------------------------------------------------------------------------------
+// The sizes double check these structs have no padding, so their memory bytes are what the Append functions write
+#define BUFFER_ARRAY_LAYOUT(elementType, elementSize, wordSize, byteWordIndex) \
+	static_assert(sizeof(elementType) == elementSize, #elementType " is not laid out in memory like it is in a buffer"); \
+	template <> struct BufferArrayLayout<elementType> { static constexpr size_t WORD_SIZE = wordSize; static constexpr size_t BYTE_WORD_INDEX = byteWordIndex; };
+
+BUFFER_ARRAY_LAYOUT(Vec2,			8,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(Vec3,			12,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(Vec4,			16,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(IntVec2,		8,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(IntVec3,		12,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(Rgba8,			4,	1,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(AABB2,			16,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(AABB3,			24,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(OBB2,			24,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(OBB3,			60,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(Plane2D,		12,	4,	SIZE_MAX)
+BUFFER_ARRAY_LAYOUT(Vertex_PCU,		24,	4,	3)			// The color is the 4th word
+BUFFER_ARRAY_LAYOUT(Vertex_PCUTBN,	60,	4,	3)
+#undef BUFFER_ARRAY_LAYOUT
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void BufferWriter::AppendArray(T const* elementsToAppend, size_t numOfElements)
+{
+	static_assert(HasBufferArrayLayout<T>::value, "Specialize BufferArrayLayout to append, parse or view arrays of this type");
+	static_assert(sizeof(T) % BufferArrayLayout<T>::WORD_SIZE == 0, "Elements have to be made of whole words");
+	AppendArrayBytes(elementsToAppend, numOfElements, sizeof(T), BufferArrayLayout<T>::WORD_SIZE, BufferArrayLayout<T>::BYTE_WORD_INDEX);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void BufferWriter::AppendArray(std::vector<T> const& elementsToAppend)
+{
+	AppendArray(elementsToAppend.data(), elementsToAppend.size());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void BufferParser::ParseArray(T* out_elements, size_t numOfElements)
+{
+	static_assert(HasBufferArrayLayout<T>::value, "Specialize BufferArrayLayout to append, parse or view arrays of this type");
+	static_assert(sizeof(T) % BufferArrayLayout<T>::WORD_SIZE == 0, "Elements have to be made of whole words");
+	ParseArrayBytes(out_elements, numOfElements, sizeof(T), BufferArrayLayout<T>::WORD_SIZE, BufferArrayLayout<T>::BYTE_WORD_INDEX);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+void BufferParser::ParseArray(std::vector<T>& out_elements, size_t numOfElements)
+{
+	size_t firstElementIndex = out_elements.size();
+	out_elements.resize(firstElementIndex + numOfElements);
+	ParseArray(out_elements.data() + firstElementIndex, numOfElements);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+T const* BufferParser::ViewArray(size_t numOfElements)
+{
+	static_assert(HasBufferArrayLayout<T>::value, "Specialize BufferArrayLayout to append, parse or view arrays of this type");
+	return static_cast<T const*>(ViewArrayBytes(numOfElements, sizeof(T), alignof(T), BufferArrayLayout<T>::WORD_SIZE));
+}
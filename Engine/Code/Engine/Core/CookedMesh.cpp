@@ -0,0 +1,329 @@
+#include "Engine/Core/CookedMesh.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+#include "Engine/Core/HashUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <filesystem>
+#include <string.h>
+#include <stddef.h>
+#include <stdio.h>
+
+
+//--------------------------------------------------------------------------------------------------
+static uint32_t GetVertexStride(CookedMeshVertexFormat vertexFormat)
+{
+	return vertexFormat == CookedMeshVertexFormat::PCU ? (uint32_t)sizeof(Vertex_PCU) : (uint32_t)sizeof(Vertex_PCUTBN);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint64_t AlignCookedMeshOffset(uint64_t offset)
+{
+	return (offset + COOKED_MESH_DATA_ALIGNMENT - 1) & ~(COOKED_MESH_DATA_ALIGNMENT - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool GetSourceFileTimeAndSize(std::string const& sourceFileName, int64_t& out_modifiedTime, uint64_t& out_fileSize)
+{
+	std::error_code errorCode;
+	std::filesystem::file_time_type modifiedTime = std::filesystem::last_write_time(sourceFileName, errorCode);
+	if (errorCode)
+	{
+		return false;
+	}
+	uintmax_t fileSize = std::filesystem::file_size(sourceFileName, errorCode);
+	if (errorCode)
+	{
+		return false;
+	}
+	out_modifiedTime	=	(int64_t)modifiedTime.time_since_epoch().count();
+	out_fileSize		=	(uint64_t)fileSize;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool HashSourceFile(std::string const& sourceFileName, uint64_t& out_hash)
+{
+	MemoryMappedFile sourceFile;
+	if (!sourceFile.Open(sourceFileName))
+	{
+		return false;
+	}
+	out_hash = HashCookedMeshSource(sourceFile.GetData(), sourceFile.GetSize());
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool WriteCookedMeshSourceTime(std::string const& cookedFileName, int64_t sourceModifiedTime)
+{
+	FILE* file = nullptr;
+	if (fopen_s(&file, cookedFileName.c_str(), "r+b") != 0 || file == nullptr)
+	{
+		return false;
+	}
+	bool wasWritten = fseek(file, (long)offsetof(CookedMeshHeader, m_sourceModifiedTime), SEEK_SET) == 0 && fwrite(&sourceModifiedTime, sizeof(int64_t), 1, file) == 1;
+	wasWritten &= fclose(file) == 0;
+	return wasWritten;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+CookedMeshFile::~CookedMeshFile()
+{
+	Close();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool CookedMeshFile::Open(std::string const& cookedFileName, std::string const& sourceFileName, CookedMeshVertexFormat vertexFormat, Mat44 const& transformFixUpMat)
+{
+	int64_t	sourceModifiedTime	=	0;
+	bool	isSourceTimeStale	=	false;
+	if (!MapAndValidate(cookedFileName, sourceFileName, vertexFormat, transformFixUpMat, sourceModifiedTime, isSourceTimeStale))
+	{
+		return false;
+	}
+	if (!isSourceTimeStale)
+	{
+		return true;
+	}
+
+	// The mapping does not share writing, so it is dropped while the header is patched and then validated again
+	// If the patch fails (another mesh has the file mapped) this just hashes once more, same as before the patch
+	Close();
+	WriteCookedMeshSourceTime(cookedFileName, sourceModifiedTime);
+	return MapAndValidate(cookedFileName, sourceFileName, vertexFormat, transformFixUpMat, sourceModifiedTime, isSourceTimeStale);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool CookedMeshFile::MapAndValidate(std::string const& cookedFileName, std::string const& sourceFileName, CookedMeshVertexFormat vertexFormat, Mat44 const& transformFixUpMat,
+									int64_t& out_sourceModifiedTime, bool& out_isSourceTimeStale)
+{
+	Close();
+
+	int64_t		sourceModifiedTime	=	0;
+	uint64_t	sourceFileSize		=	0;
+	out_isSourceTimeStale			=	false;
+	if (!GetSourceFileTimeAndSize(sourceFileName, sourceModifiedTime, sourceFileSize))
+	{
+		return false;
+	}
+
+	m_mappedFile = new MemoryMappedFile();
+	if (!m_mappedFile->Open(cookedFileName) || m_mappedFile->GetSize() < sizeof(CookedMeshHeader))
+	{
+		Close();
+		return false;
+	}
+
+	CookedMeshHeader const*	header			=	reinterpret_cast<CookedMeshHeader const*>(m_mappedFile->GetData());
+	uint64_t				fileSize		=	(uint64_t)m_mappedFile->GetSize();
+	uint64_t				vertsEnd		=	header->m_vertsOffset + header->m_numOfVerts * header->m_vertexStride;
+	uint64_t				indexesEnd		=	header->m_indexesOffset + header->m_numOfIndexes * sizeof(unsigned int);
+	bool					isValidLayout	=	header->m_fourCC == COOKED_MESH_FOURCC && header->m_version == COOKED_MESH_VERSION &&
+												header->m_vertexFormat == (uint32_t)vertexFormat && header->m_vertexStride == GetVertexStride(vertexFormat) &&
+												header->m_vertsOffset % COOKED_MESH_DATA_ALIGNMENT == 0 && header->m_indexesOffset % COOKED_MESH_DATA_ALIGNMENT == 0 &&
+												header->m_vertsOffset >= sizeof(CookedMeshHeader) && vertsEnd <= header->m_indexesOffset && indexesEnd <= fileSize &&
+												memcmp(header->m_transformFixUp, transformFixUpMat.m_values, sizeof(header->m_transformFixUp)) == 0;
+	if (!isValidLayout || header->m_sourceFileSize != sourceFileSize)
+	{
+		Close();
+		return false;
+	}
+
+	// A checkout or copy touches the modified time without changing anything, so a different time falls back to comparing contents
+	if (header->m_sourceModifiedTime != sourceModifiedTime)
+	{
+		uint64_t sourceHash = 0;
+		if (!HashSourceFile(sourceFileName, sourceHash) || sourceHash != header->m_sourceHash)
+		{
+			Close();
+			return false;
+		}
+		out_isSourceTimeStale = true;
+	}
+
+	out_sourceModifiedTime	=	sourceModifiedTime;
+	m_header				=	header;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CookedMeshFile::Close()
+{
+	delete m_mappedFile;
+	m_mappedFile	=	nullptr;
+	m_header		=	nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool CookedMeshFile::IsOpen() const
+{
+	return m_header != nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void const* CookedMeshFile::GetVertexData() const
+{
+	return m_header ? m_mappedFile->GetData() + m_header->m_vertsOffset : nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned int const* CookedMeshFile::GetIndexes() const
+{
+	return m_header ? reinterpret_cast<unsigned int const*>(m_mappedFile->GetData() + m_header->m_indexesOffset) : nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t CookedMeshFile::GetNumOfVerts() const
+{
+	return m_header ? (size_t)m_header->m_numOfVerts : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t CookedMeshFile::GetNumOfIndexes() const
+{
+	return m_header ? (size_t)m_header->m_numOfIndexes : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// "Data/Models/Teapot.obj" -> "Cache/CookedMeshes/Data_Models_Teapot.obj.1f3a5c7e9b2d4f60.pcu.cmesh"
+std::string GetCookedMeshFileName(std::string const& sourceFileName, CookedMeshVertexFormat vertexFormat, Mat44 const& transformFixUpMat)
+{
+	std::string flattenedName = sourceFileName;
+	for (size_t charIndex = 0; charIndex < flattenedName.size(); ++charIndex)
+	{
+		char& character = flattenedName[charIndex];
+		if (character == '/' || character == '\\' || character == ':')
+		{
+			character = '_';
+		}
+	}
+	uint64_t transformHash = ComputeXXHash64(transformFixUpMat.m_values, sizeof(transformFixUpMat.m_values));
+	return std::string(COOKED_MESH_FOLDER) + flattenedName + Stringf(".%016llx", (unsigned long long)transformHash) + (vertexFormat == CookedMeshVertexFormat::PCU ? ".pcu.cmesh" : ".pcutbn.cmesh");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t HashCookedMeshSource(unsigned char const* data, size_t numOfBytes)
+{
+	return ComputeXXHash64(data, numOfBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool WritePadding(FILE* file, uint64_t& currentOffset, uint64_t targetOffset)
+{
+	static unsigned char const ZEROES[COOKED_MESH_DATA_ALIGNMENT] = { };
+	size_t numOfBytes = (size_t)(targetOffset - currentOffset);
+	currentOffset = targetOffset;
+	return numOfBytes == 0 || fwrite(ZEROES, 1, numOfBytes, file) == numOfBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool WriteCookedMeshContents(FILE* file, CookedMeshHeader const& header, void const* verts, unsigned int const* indexes, unsigned int indexBase)
+{
+	uint64_t currentOffset = sizeof(CookedMeshHeader);
+	if (fwrite(&header, sizeof(CookedMeshHeader), 1, file) != 1 || !WritePadding(file, currentOffset, header.m_vertsOffset))
+	{
+		return false;
+	}
+
+	size_t numOfVertBytes = (size_t)(header.m_numOfVerts * header.m_vertexStride);
+	if (numOfVertBytes > 0 && fwrite(verts, 1, numOfVertBytes, file) != numOfVertBytes)
+	{
+		return false;
+	}
+	currentOffset += numOfVertBytes;
+	if (!WritePadding(file, currentOffset, header.m_indexesOffset))
+	{
+		return false;
+	}
+
+	if (indexBase == 0)
+	{
+		return header.m_numOfIndexes == 0 || fwrite(indexes, sizeof(unsigned int), (size_t)header.m_numOfIndexes, file) == header.m_numOfIndexes;
+	}
+
+	// Rebase in small batches rather than copying the whole index array
+	unsigned int	rebasedIndexes[4096];
+	size_t			numOfIndexesWritten	=	0;
+	while (numOfIndexesWritten < header.m_numOfIndexes)
+	{
+		size_t numOfIndexesInBatch = (size_t)header.m_numOfIndexes - numOfIndexesWritten;
+		numOfIndexesInBatch = numOfIndexesInBatch < 4096 ? numOfIndexesInBatch : 4096;
+		for (size_t batchIndex = 0; batchIndex < numOfIndexesInBatch; ++batchIndex)
+		{
+			rebasedIndexes[batchIndex] = indexes[numOfIndexesWritten + batchIndex] - indexBase;
+		}
+		if (fwrite(rebasedIndexes, sizeof(unsigned int), numOfIndexesInBatch, file) != numOfIndexesInBatch)
+		{
+			return false;
+		}
+		numOfIndexesWritten += numOfIndexesInBatch;
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool WriteCookedMeshFile(std::string const& cookedFileName, std::string const& sourceFileName, CookedMeshVertexFormat vertexFormat, Mat44 const& transformFixUpMat,
+						 void const* verts, size_t numOfVerts, unsigned int const* indexes, size_t numOfIndexes, unsigned int indexBase)
+{
+	CookedMeshHeader header;
+	if (!GetSourceFileTimeAndSize(sourceFileName, header.m_sourceModifiedTime, header.m_sourceFileSize) || !HashSourceFile(sourceFileName, header.m_sourceHash))
+	{
+		return false;
+	}
+	header.m_vertexFormat	=	(uint32_t)vertexFormat;
+	header.m_vertexStride	=	GetVertexStride(vertexFormat);
+	header.m_numOfVerts		=	(uint64_t)numOfVerts;
+	header.m_numOfIndexes	=	(uint64_t)numOfIndexes;
+	header.m_vertsOffset	=	AlignCookedMeshOffset(sizeof(CookedMeshHeader));
+	header.m_indexesOffset	=	AlignCookedMeshOffset(header.m_vertsOffset + header.m_numOfVerts * header.m_vertexStride);
+	memcpy(header.m_transformFixUp, transformFixUpMat.m_values, sizeof(header.m_transformFixUp));
+
+	std::error_code			errorCode;
+	std::filesystem::path	cookedFilePath(cookedFileName);
+	if (cookedFilePath.has_parent_path())
+	{
+		std::filesystem::create_directories(cookedFilePath.parent_path(), errorCode);
+	}
+
+	std::string	tempFileName	=	cookedFileName + ".tmp";
+	FILE*		file			=	nullptr;
+	if (fopen_s(&file, tempFileName.c_str(), "wb") != 0 || file == nullptr)
+	{
+		return false;
+	}
+	bool wasWritten = WriteCookedMeshContents(file, header, verts, indexes, indexBase);
+	wasWritten &= fclose(file) == 0;
+
+	// Fails when another mesh still has the old cooked file mapped (Windows will not replace it), the next load just cooks again
+	if (wasWritten)
+	{
+		std::filesystem::rename(tempFileName, cookedFileName, errorCode);
+		wasWritten = !errorCode;
+	}
+	if (!wasWritten)
+	{
+		std::filesystem::remove(tempFileName, errorCode);
+	}
+	return wasWritten;
+}
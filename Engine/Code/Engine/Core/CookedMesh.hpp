@@ -0,0 +1,93 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Math/Mat44.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <string>
+#include <stdint.h>
+
+
+//--------------------------------------------------------------------------------------------------
+class MemoryMappedFile;
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr uint32_t		COOKED_MESH_FOURCC				=	0x48534D43;				// "CMSH" read as little endian
+constexpr uint32_t		COOKED_MESH_VERSION				=	2;						// 2: source hash is xxHash64
+constexpr uint64_t		COOKED_MESH_DATA_ALIGNMENT		=	64;
+constexpr char const*	COOKED_MESH_FOLDER				=	"Cache/CookedMeshes/";
+
+
+//--------------------------------------------------------------------------------------------------
+enum class CookedMeshVertexFormat : uint32_t
+{
+	PCU,
+	PCUTBN,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Starts every cooked mesh file, the vertex and index arrays follow at m_vertsOffset / m_indexesOffset
+// Both offsets are multiples of COOKED_MESH_DATA_ALIGNMENT so the arrays can be used straight out of a mapping of the file
+struct CookedMeshHeader
+{
+	uint32_t	m_fourCC				=	COOKED_MESH_FOURCC;
+	uint32_t	m_version				=	COOKED_MESH_VERSION;
+	uint32_t	m_vertexFormat			=	0;
+	uint32_t	m_vertexStride			=	0;
+	uint64_t	m_sourceFileSize		=	0;
+	int64_t		m_sourceModifiedTime	=	0;		// std::filesystem::file_time_type ticks
+	uint64_t	m_sourceHash			=	0;
+	uint64_t	m_numOfVerts			=	0;
+	uint64_t	m_numOfIndexes			=	0;
+	uint64_t	m_vertsOffset			=	0;
+	uint64_t	m_indexesOffset			=	0;
+	float		m_transformFixUp[16]	=	{ };	// The cooked verts already have it applied, a different one means a different mesh
+};
+static_assert(sizeof(CookedMeshHeader) == 136, "CookedMeshHeader is written to disk as is, bump COOKED_MESH_VERSION when changing it");
+
+
+//--------------------------------------------------------------------------------------------------
+// A read only mapping of a cooked mesh file that was validated against its source
+class CookedMeshFile
+{
+public:
+	CookedMeshFile() {};
+	~CookedMeshFile();
+	CookedMeshFile(CookedMeshFile const& copyFrom) = delete;
+	CookedMeshFile& operator=(CookedMeshFile const& copyFrom) = delete;
+
+	// Fails if the file is missing or malformed, or was cooked with another version, vertex format or fix-up transform
+	// The source counts as unchanged when its size and modified time match, or when its size and contents hash match
+	// A contents match stores the new modified time in the cooked file, so only the first open after a checkout hashes the source
+	bool			Open(std::string const& cookedFileName, std::string const& sourceFileName, CookedMeshVertexFormat vertexFormat, Mat44 const& transformFixUpMat);
+	void			Close();
+	bool			IsOpen() const;
+
+	void const*				GetVertexData() const;
+	unsigned int const*		GetIndexes() const;
+	size_t					GetNumOfVerts() const;
+	size_t					GetNumOfIndexes() const;
+
+private:
+	bool			MapAndValidate(std::string const& cookedFileName, std::string const& sourceFileName, CookedMeshVertexFormat vertexFormat, Mat44 const& transformFixUpMat,
+								   int64_t& out_sourceModifiedTime, bool& out_isSourceTimeStale);
+
+private:
+	MemoryMappedFile*		m_mappedFile	=	nullptr;
+	CookedMeshHeader const*	m_header		=	nullptr;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// The fix-up transform is baked into the verts, so it is hashed into the name and every transform of a source gets its own file
+std::string	GetCookedMeshFileName(std::string const& sourceFileName, CookedMeshVertexFormat vertexFormat, Mat44 const& transformFixUpMat);
+uint64_t	HashCookedMeshSource(unsigned char const* data, size_t numOfBytes);		// xxHash64, see HashUtils.hpp
+
+// indexBase is subtracted from every index, so a range appended to a bigger vertex array is stored relative to its own first vert
+// Writes to a temporary file first and renames it, a failed or interrupted write never leaves a half cooked mesh behind
+bool		WriteCookedMeshFile(std::string const& cookedFileName, std::string const& sourceFileName, CookedMeshVertexFormat vertexFormat, Mat44 const& transformFixUpMat,
+								void const* verts, size_t numOfVerts, unsigned int const* indexes, size_t numOfIndexes, unsigned int indexBase = 0);
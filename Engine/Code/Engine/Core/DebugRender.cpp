@@ -3,7 +3,10 @@
 #include "Engine/Core/Stopwatch.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/MeshBuilder.hpp"
+#include "Engine/Core/FrameArena.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
 #include "Engine/Core/DebugRender.hpp"
 
 
@@ -20,7 +23,7 @@ std::mutex g_debugRenderMutex;
 //--------------------------------------------------------------------------------------------------
 struct DebugRenderAlways
 {
-	std::vector<Vertex_PCU> m_alwaysVertexes;
+	MeshBuilder m_alwaysShapes;
 	Stopwatch* m_alwaysStopwatch = nullptr;
 	Rgba8 m_startColor = Rgba8::WHITE;
 	Rgba8 m_endColor = Rgba8::WHITE;
@@ -28,7 +31,7 @@ struct DebugRenderAlways
 
 struct DebugRenderDepth
 {
-	std::vector<Vertex_PCU> m_depthVertexes;
+	MeshBuilder m_depthShapes;
 	Stopwatch* m_depthStopwatch = nullptr;
 	float m_duration = -2.f;
 	Rgba8 m_startColor = Rgba8::WHITE;
@@ -37,7 +40,7 @@ struct DebugRenderDepth
 
 struct DebugRenderXRay
 {
-	std::vector<Vertex_PCU> m_xRayVertexes;
+	MeshBuilder m_xRayShapes;
 	Stopwatch* m_xRayStopwatch = nullptr;
 	Rgba8 m_startColor = Rgba8::WHITE;
 	Rgba8 m_endColor = Rgba8::WHITE;
@@ -65,7 +68,7 @@ struct DebugRenderWorldText
 
 struct DebugRenderScreenText
 {
-	std::vector<Vertex_PCU> m_screenTextVertexes;
+	std::vector<SpriteQuad> m_screenTextQuads;
 	float m_duration = -2.f;
 	Stopwatch* m_textStopwatch = nullptr;
 	Rgba8 m_startColor = Rgba8::WHITE;
@@ -83,60 +86,40 @@ std::vector<DebugRenderWorldText>	g_theWorldText;
 std::vector<DebugRenderScreenText>	g_theScreenTextRenderVertexes;
 
 BitmapFont* g_Font = nullptr;
+SpriteBatch* g_screenTextBatch = nullptr;
+// Shapes are kept as recorded MeshBuilder commands and regenerated each frame with their current color into this arena
+FrameArena* g_debugRenderFrameArena = nullptr;
+MeshBuilder g_debugRenderPassShapes;
 
-void PopulateDepthVertexes(std::vector<Vertex_PCU>& verts)
+void PopulateAlwaysShapes(MeshBuilder& shapes, std::vector<DebugRenderAlways>& alwaysObjs)
 {
-	for (int depthObjIndex = 0; depthObjIndex < (int)g_theDepthRenderVertexes.size(); ++depthObjIndex)
-	{
-		DebugRenderDepth& depthObj = g_theDepthRenderVertexes[depthObjIndex];
-
-		float interpolatorFactor = depthObj.m_depthStopwatch->GetElapsedFraction();
-		Rgba8 interpolatedColor = Interpolate(depthObj.m_startColor, depthObj.m_endColor, interpolatorFactor);
-		for (int depthVertexIndex = 0; depthVertexIndex < depthObj.m_depthVertexes.size(); ++depthVertexIndex)
-		{
-			depthObj.m_depthVertexes[depthVertexIndex].m_color = interpolatedColor;
-			verts.push_back(depthObj.m_depthVertexes[depthVertexIndex]);
-		}
-	}
-}
-
-void PopulateAlwaysVertexes(std::vector<Vertex_PCU>& verts, std::vector<DebugRenderAlways>& alwaysVerts)
-{
-	for (int alwaysObjIndex = 0; alwaysObjIndex < (int)g_theAlwaysRenderVertexes.size(); ++alwaysObjIndex)
+	for (int alwaysObjIndex = 0; alwaysObjIndex < (int)alwaysObjs.size(); ++alwaysObjIndex)
 	{
-		DebugRenderAlways& alwaysObj = alwaysVerts[alwaysObjIndex];
+		DebugRenderAlways& alwaysObj = alwaysObjs[alwaysObjIndex];
 
 		float interpolatorFactor = alwaysObj.m_alwaysStopwatch->GetElapsedFraction();
 		Rgba8 interpolatedColor = Interpolate(alwaysObj.m_startColor, alwaysObj.m_endColor, interpolatorFactor);
-		for (int AlwaysVertexIndex = 0; AlwaysVertexIndex < alwaysObj.m_alwaysVertexes.size(); ++AlwaysVertexIndex)
-		{
-			alwaysObj.m_alwaysVertexes[AlwaysVertexIndex].m_color = interpolatedColor;
-			verts.push_back(alwaysObj.m_alwaysVertexes[AlwaysVertexIndex]);
-		}
+		shapes.AddShapes(alwaysObj.m_alwaysShapes, interpolatedColor);
 	}
 }
 
-void PopulateDepthVertexes(std::vector<Vertex_PCU>& verts, std::vector<DebugRenderDepth>& depthverts)
+void PopulateDepthShapes(MeshBuilder& shapes, std::vector<DebugRenderDepth>& depthObjs)
 {
-	for (int depthObjIndex = 0; depthObjIndex < (int)depthverts.size(); ++depthObjIndex)
+	for (int depthObjIndex = 0; depthObjIndex < (int)depthObjs.size(); ++depthObjIndex)
 	{
-		DebugRenderDepth& depthObj = depthverts[depthObjIndex];
+		DebugRenderDepth& depthObj = depthObjs[depthObjIndex];
 
 		float interpolatorFactor = depthObj.m_depthStopwatch->GetElapsedFraction();
 		Rgba8 interpolatedColor = Interpolate(depthObj.m_startColor, depthObj.m_endColor, interpolatorFactor);
-		for (int depthVertexIndex = 0; depthVertexIndex < depthObj.m_depthVertexes.size(); ++depthVertexIndex)
-		{
-			depthObj.m_depthVertexes[depthVertexIndex].m_color = interpolatedColor;
-			verts.push_back(depthObj.m_depthVertexes[depthVertexIndex]);
-		}
+		shapes.AddShapes(depthObj.m_depthShapes, interpolatedColor);
 	}
 }
 
-void PopulateXRayAlphaVertexes(std::vector<Vertex_PCU>& verts, std::vector<DebugRenderXRay>& alphaVerts)
+void PopulateXRayAlphaShapes(MeshBuilder& shapes, std::vector<DebugRenderXRay>& xRayObjs)
 {
-	for (int xRayObjIndex = 0; xRayObjIndex < (int)g_theXRayRenderVertexes.size(); ++xRayObjIndex)
+	for (int xRayObjIndex = 0; xRayObjIndex < (int)xRayObjs.size(); ++xRayObjIndex)
 	{
-		DebugRenderXRay& xRayObj = alphaVerts[xRayObjIndex];
+		DebugRenderXRay& xRayObj = xRayObjs[xRayObjIndex];
 
 		float interpolatorFactor = xRayObj.m_xRayStopwatch->GetElapsedFraction();
 
@@ -144,50 +127,43 @@ void PopulateXRayAlphaVertexes(std::vector<Vertex_PCU>& verts, std::vector<Debug
 		xRayObj.m_endColor.a = 127;//  char(xRayObj.m_endColor.a * 0.5f);
 
 		Rgba8 interpolatedColor = Interpolate(xRayObj.m_startColor, xRayObj.m_endColor, interpolatorFactor);
-		for (int AlwaysVertexIndex = 0; AlwaysVertexIndex < xRayObj.m_xRayVertexes.size(); ++AlwaysVertexIndex)
-		{
-			xRayObj.m_xRayVertexes[AlwaysVertexIndex].m_color = interpolatedColor;
-			verts.push_back(xRayObj.m_xRayVertexes[AlwaysVertexIndex]);
-		}
+		shapes.AddShapes(xRayObj.m_xRayShapes, interpolatedColor);
 	}
 }
 
-void PopulateXRaySolidVertexes(std::vector<Vertex_PCU>& verts, std::vector<DebugRenderXRay>& solidVerts)
+void PopulateXRaySolidShapes(MeshBuilder& shapes, std::vector<DebugRenderXRay>& xRayObjs)
 {
-	for (int xRayObjIndex = 0; xRayObjIndex < (int)g_theXRayRenderVertexes.size(); ++xRayObjIndex)
+	for (int xRayObjIndex = 0; xRayObjIndex < (int)xRayObjs.size(); ++xRayObjIndex)
 	{
-		DebugRenderXRay& xRayObj = solidVerts[xRayObjIndex];
+		DebugRenderXRay& xRayObj = xRayObjs[xRayObjIndex];
 
 		float interpolatorFactor = xRayObj.m_xRayStopwatch->GetElapsedFraction();
 		Rgba8 interpolatedColor = Interpolate(xRayObj.m_startColor, xRayObj.m_endColor, interpolatorFactor);
-		for (int AlwaysVertexIndex = 0; AlwaysVertexIndex < xRayObj.m_xRayVertexes.size(); ++AlwaysVertexIndex)
-		{
-			xRayObj.m_xRayVertexes[AlwaysVertexIndex].m_color = interpolatedColor;
-			verts.push_back(xRayObj.m_xRayVertexes[AlwaysVertexIndex]);
-		}
+		shapes.AddShapes(xRayObj.m_xRayShapes, interpolatedColor);
 	}
 }
 
-void PopulateScreenTextVertexes(std::vector<Vertex_PCU>& verts, std::vector<DebugRenderScreenText>& textVerts)
+void DrawShapes(MeshBuilder const& shapes)
 {
-	for (int textIndex = 0; textIndex < (int)textVerts.size(); ++textIndex)
+	Vertex_PCU* verts = shapes.Build(*g_debugRenderFrameArena);
+	g_theConfig.m_renderer->DrawVertexArray(shapes.GetNumOfVerts(), verts);
+}
+
+void PopulateScreenTextQuads(SpriteBatch& spriteBatch, std::vector<DebugRenderScreenText>& textObjs)
+{
+	for (int textIndex = 0; textIndex < (int)textObjs.size(); ++textIndex)
 	{
-		DebugRenderScreenText& textObj = textVerts[textIndex];
-		if (textObj.m_duration == 0)
+		DebugRenderScreenText& textObj = textObjs[textIndex];
+		if (textObj.m_duration != 0)
 		{
-			for (int textVertexIndex = 0; textVertexIndex < textObj.m_screenTextVertexes.size(); ++textVertexIndex)
+			float interpolatorFactor = textObj.m_textStopwatch->GetElapsedFraction();
+			Rgba8 interpolatedColor = Interpolate(textObj.m_startColor, textObj.m_endColor, interpolatorFactor);
+			for (int textQuadIndex = 0; textQuadIndex < (int)textObj.m_screenTextQuads.size(); ++textQuadIndex)
 			{
-				verts.push_back(textObj.m_screenTextVertexes[textVertexIndex]);
+				textObj.m_screenTextQuads[textQuadIndex].m_color = interpolatedColor;
 			}
-			continue;
-		}
-		float interpolatorFactor = textObj.m_textStopwatch->GetElapsedFraction();
-		Rgba8 interpolatedColor = Interpolate(textObj.m_startColor, textObj.m_endColor, interpolatorFactor);
-		for (int textVertexIndex = 0; textVertexIndex < textObj.m_screenTextVertexes.size(); ++textVertexIndex)
-		{
-			textObj.m_screenTextVertexes[textVertexIndex].m_color = interpolatedColor;
-			verts.push_back(textObj.m_screenTextVertexes[textVertexIndex]);
 		}
+		spriteBatch.AddQuads(&g_Font->GetTexture(), BlendMode::ALPHA, textObj.m_screenTextQuads.data(), (int)textObj.m_screenTextQuads.size());
 	}
 }
 
@@ -217,8 +193,16 @@ void PopulateTextVertexes(Camera const& camera, std::vector<DebugRenderText>& te
 	}
 }
 
-void PopulateWorldText(std::vector<Vertex_PCU>& verts, std::vector<DebugRenderWorldText>& textVerts)
+Vertex_PCU* PopulateWorldText(int& out_numOfVerts, std::vector<DebugRenderWorldText>& textVerts)
 {
+	out_numOfVerts = 0;
+	for (int textIndex = 0; textIndex < (int)textVerts.size(); ++textIndex)
+	{
+		out_numOfVerts += (int)textVerts[textIndex].m_textVertexes.size();
+	}
+
+	Vertex_PCU* verts		=	g_debugRenderFrameArena->AllocateArray<Vertex_PCU>((size_t)out_numOfVerts);
+	int			vertIndex	=	0;
 	for (int textIndex = 0; textIndex < (int)textVerts.size(); ++textIndex)
 	{
 		DebugRenderWorldText& textObj = textVerts[textIndex];
@@ -228,9 +212,11 @@ void PopulateWorldText(std::vector<Vertex_PCU>& verts, std::vector<DebugRenderWo
 		for (int textVertexIndex = 0; textVertexIndex < textObj.m_textVertexes.size(); ++textVertexIndex)
 		{
 			textObj.m_textVertexes[textVertexIndex].m_color = interpolatedColor;
-			verts.push_back(textObj.m_textVertexes[textVertexIndex]);
+			verts[vertIndex] = textObj.m_textVertexes[textVertexIndex];
+			++vertIndex;
 		}
 	}
+	return verts;
 }
 
 void DebugRenderSystemStartup(DebugRenderConfig const& config)
@@ -240,10 +226,16 @@ void DebugRenderSystemStartup(DebugRenderConfig const& config)
 	g_isVisible = config.m_startHidden;
 
 	g_Font = config.m_renderer->CreateOrGetBitmapFont("Data/Fonts/SquirrelFixedFont");
+	g_screenTextBatch = new SpriteBatch(*config.m_renderer);
+	g_debugRenderFrameArena = new FrameArena();
 }
 
 void DebugRenderSystemShutdown()
 {
+	delete g_screenTextBatch;
+	g_screenTextBatch = nullptr;
+	delete g_debugRenderFrameArena;
+	g_debugRenderFrameArena = nullptr;
 }
 
 void DebugRenderSetVisible()
@@ -282,6 +274,8 @@ void DebugRenderToggle()
 
 void DebugRenderBeginFrame()
 {
+	g_debugRenderFrameArena->BeginFrame();
+
 	for (int depthObjIndex = 0; depthObjIndex < (int)g_theDepthRenderVertexes.size(); ++depthObjIndex)
 	{
 		DebugRenderDepth& depthObj = g_theDepthRenderVertexes[depthObjIndex];
@@ -407,51 +401,51 @@ void DebugRenderWorld(Camera const& camera)
 		return;
 	}
 	g_theConfig.m_renderer->BeginCamera(camera);
-	std::vector<Vertex_PCU> alwaysVertexes;
-	PopulateAlwaysVertexes(alwaysVertexes, g_theAlwaysRenderVertexes);
+	g_debugRenderPassShapes.Clear();
+	PopulateAlwaysShapes(g_debugRenderPassShapes, g_theAlwaysRenderVertexes);
 	g_theConfig.m_renderer->SetDepthMode(DepthMode::DISABLED);
 	g_theConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
 	g_theConfig.m_renderer->BindTexture(nullptr);
-	g_theConfig.m_renderer->DrawVertexArray((int)alwaysVertexes.size(), alwaysVertexes.data());
+	DrawShapes(g_debugRenderPassShapes);
 
-	std::vector<Vertex_PCU> depthVertexes;
-	PopulateDepthVertexes(depthVertexes);
+	g_debugRenderPassShapes.Clear();
+	PopulateDepthShapes(g_debugRenderPassShapes, g_theDepthRenderVertexes);
 	g_theConfig.m_renderer->SetDepthMode(DepthMode::ENABLED);
 	g_theConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
 	g_theConfig.m_renderer->BindTexture(nullptr);
-	g_theConfig.m_renderer->DrawVertexArray((int)depthVertexes.size(), depthVertexes.data());
+	DrawShapes(g_debugRenderPassShapes);
 
-	std::vector<Vertex_PCU> depthWireframeVerts;
-	PopulateDepthVertexes(depthWireframeVerts, g_theDepthRenderWireframeVertexes);
+	g_debugRenderPassShapes.Clear();
+	PopulateDepthShapes(g_debugRenderPassShapes, g_theDepthRenderWireframeVertexes);
 	g_theConfig.m_renderer->SetDepthMode(DepthMode::ENABLED);
 	g_theConfig.m_renderer->SetRasterizerMode(RasterizerMode::WIREFRAME_CULL_BACK);
 	g_theConfig.m_renderer->BindTexture(nullptr);
-	g_theConfig.m_renderer->DrawVertexArray((int)depthWireframeVerts.size(), depthWireframeVerts.data());
+	DrawShapes(g_debugRenderPassShapes);
 	
 	
-	std::vector<Vertex_PCU> xRayAlphaVertexes;
-	PopulateXRayAlphaVertexes(xRayAlphaVertexes, g_theXRayRenderVertexes);
+	g_debugRenderPassShapes.Clear();
+	PopulateXRayAlphaShapes(g_debugRenderPassShapes, g_theXRayRenderVertexes);
 	g_theConfig.m_renderer->SetBlendMode(BlendMode::ALPHA);
 	g_theConfig.m_renderer->SetDepthMode(DepthMode::DISABLED);
 	g_theConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
 	g_theConfig.m_renderer->BindTexture(nullptr);
-	g_theConfig.m_renderer->DrawVertexArray((int)xRayAlphaVertexes.size(), xRayAlphaVertexes.data());
+	DrawShapes(g_debugRenderPassShapes);
 	
-	std::vector<Vertex_PCU> xRayDepthVertexes;
-	PopulateXRaySolidVertexes(xRayDepthVertexes, g_theXRayRenderVertexes);
+	g_debugRenderPassShapes.Clear();
+	PopulateXRaySolidShapes(g_debugRenderPassShapes, g_theXRayRenderVertexes);
 	g_theConfig.m_renderer->SetBlendMode(BlendMode::OPAQUE);
 	g_theConfig.m_renderer->SetDepthMode(DepthMode::ENABLED);
 	g_theConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_BACK);
 	g_theConfig.m_renderer->BindTexture(nullptr);
-	g_theConfig.m_renderer->DrawVertexArray((int)xRayDepthVertexes.size(), xRayDepthVertexes.data());
+	DrawShapes(g_debugRenderPassShapes);
 
-	std::vector<Vertex_PCU> worldTextVerts;
-	PopulateWorldText(worldTextVerts, g_theWorldText);
+	int			numOfWorldTextVerts	=	0;
+	Vertex_PCU*	worldTextVerts		=	PopulateWorldText(numOfWorldTextVerts, g_theWorldText);
 	g_theConfig.m_renderer->SetBlendMode(BlendMode::ALPHA);
 	g_theConfig.m_renderer->SetDepthMode(DepthMode::ENABLED);
 	g_theConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_NONE);
 	g_theConfig.m_renderer->BindTexture(&g_Font->GetTexture());
-	g_theConfig.m_renderer->DrawVertexArray((int)worldTextVerts.size(), worldTextVerts.data());
+	g_theConfig.m_renderer->DrawVertexArray(numOfWorldTextVerts, worldTextVerts);
 
 	PopulateTextVertexes(camera, g_theTextRenderVertexes);
 
@@ -466,13 +460,11 @@ void DebugRenderScreen(Camera const& camera)
 	}
 	g_theConfig.m_renderer->BeginCamera(camera);
 
-	std::vector<Vertex_PCU> screenTextVertexes;
-	PopulateScreenTextVertexes(screenTextVertexes, g_theScreenTextRenderVertexes);
-	g_theConfig.m_renderer->SetBlendMode(BlendMode::ALPHA);
 	g_theConfig.m_renderer->SetDepthMode(DepthMode::DISABLED);
 	g_theConfig.m_renderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_NONE);
-	g_theConfig.m_renderer->BindTexture(&g_Font->GetTexture());
-	g_theConfig.m_renderer->DrawVertexArray((int)screenTextVertexes.size(), screenTextVertexes.data());
+	g_screenTextBatch->Begin();
+	PopulateScreenTextQuads(*g_screenTextBatch, g_theScreenTextRenderVertexes);
+	g_screenTextBatch->End();
 
 	g_theConfig.m_renderer->EndCamera(camera);
 }
@@ -531,7 +523,7 @@ void DebugAddWorldPoint(Vec3 const& pos, float radius, float duration, Rgba8 con
 		debugRenderAlways.m_endColor = endColor;
 		debugRenderAlways.m_alwaysStopwatch = new Stopwatch(duration);
 
-		AddVertsForUVSphereZ3D(debugRenderAlways.m_alwaysVertexes, pos, radius, numSlices, numStacks, startColor);
+		debugRenderAlways.m_alwaysShapes.AddUVSphereZ3D(pos, radius, numSlices, numStacks, startColor);
 		g_debugRenderMutex.lock();
 		g_theAlwaysRenderVertexes.push_back(debugRenderAlways);
 		g_debugRenderMutex.unlock();
@@ -544,7 +536,7 @@ void DebugAddWorldPoint(Vec3 const& pos, float radius, float duration, Rgba8 con
 		debugRenderDepth.m_endColor = endColor;
 		debugRenderDepth.m_depthStopwatch = new Stopwatch(duration);
 
-		AddVertsForUVSphereZ3D(debugRenderDepth.m_depthVertexes, pos, radius, numSlices, numStacks, startColor);
+		debugRenderDepth.m_depthShapes.AddUVSphereZ3D(pos, radius, numSlices, numStacks, startColor);
 		g_debugRenderMutex.lock();
 		g_theDepthRenderVertexes.push_back(debugRenderDepth);
 		g_debugRenderMutex.unlock();
@@ -557,7 +549,7 @@ void DebugAddWorldPoint(Vec3 const& pos, float radius, float duration, Rgba8 con
 		debugRenderXRay.m_endColor = endColor;
 		debugRenderXRay.m_xRayStopwatch = new Stopwatch(duration);
 
-		AddVertsForUVSphereZ3D(debugRenderXRay.m_xRayVertexes, pos, radius, numSlices, numStacks, startColor);
+		debugRenderXRay.m_xRayShapes.AddUVSphereZ3D(pos, radius, numSlices, numStacks, startColor);
 		g_debugRenderMutex.lock();
 		g_theXRayRenderVertexes.push_back(debugRenderXRay);
 		g_debugRenderMutex.unlock();
@@ -579,7 +571,7 @@ void DebugAddWorldLine(Vec3 const& start, Vec3 const& end, float radius, float d
 		debugRenderAlways.m_endColor = endColor;
 		debugRenderAlways.m_alwaysStopwatch = new Stopwatch(duration);
 
-		AddVertsForCylinder3D(debugRenderAlways.m_alwaysVertexes, start, end, radius, startColor);
+		debugRenderAlways.m_alwaysShapes.AddCylinder3D(start, end, radius, startColor);
 		g_debugRenderMutex.lock();
 		g_theAlwaysRenderVertexes.push_back(debugRenderAlways);
 		g_debugRenderMutex.unlock();
@@ -592,7 +584,7 @@ void DebugAddWorldLine(Vec3 const& start, Vec3 const& end, float radius, float d
 		debugRenderDepth.m_endColor = endColor;
 		debugRenderDepth.m_depthStopwatch = new Stopwatch(duration);
 		
-		AddVertsForCylinder3D(debugRenderDepth.m_depthVertexes, start, end, radius, startColor);
+		debugRenderDepth.m_depthShapes.AddCylinder3D(start, end, radius, startColor);
 		g_debugRenderMutex.lock();
 		g_theDepthRenderVertexes.push_back(debugRenderDepth);
 		g_debugRenderMutex.unlock();
@@ -605,7 +597,7 @@ void DebugAddWorldLine(Vec3 const& start, Vec3 const& end, float radius, float d
 		debugRenderXRay.m_endColor = endColor;
 		debugRenderXRay.m_xRayStopwatch = new Stopwatch(duration);
 
-		AddVertsForCylinder3D(debugRenderXRay.m_xRayVertexes, start, end, radius, startColor);
+		debugRenderXRay.m_xRayShapes.AddCylinder3D(start, end, radius, startColor);
 		g_debugRenderMutex.lock();
 		g_theXRayRenderVertexes.push_back(debugRenderXRay);
 		g_debugRenderMutex.unlock();
@@ -629,7 +621,7 @@ void DebugAddWorldWireCylinder(Vec3 const& base, Vec3 const& top, float radius,
 		debugRenderAlways.m_endColor = endColor;
 		debugRenderAlways.m_alwaysStopwatch = new Stopwatch(duration);
 
-		AddVertsForCylinder3D(debugRenderAlways.m_alwaysVertexes, base, top, radius, startColor, numSlices);
+		debugRenderAlways.m_alwaysShapes.AddCylinder3D(base, top, radius, startColor, numSlices);
 		g_debugRenderMutex.lock();
 		g_theAlwaysRenderWireframeVertexes.push_back(debugRenderAlways);
 		g_debugRenderMutex.unlock();
@@ -642,7 +634,7 @@ void DebugAddWorldWireCylinder(Vec3 const& base, Vec3 const& top, float radius,
 		debugRenderDepth.m_endColor = endColor;
 		debugRenderDepth.m_depthStopwatch = new Stopwatch(duration);
 
-		AddVertsForCylinder3D(debugRenderDepth.m_depthVertexes, base, top, radius, startColor, numSlices);
+		debugRenderDepth.m_depthShapes.AddCylinder3D(base, top, radius, startColor, numSlices);
 		g_debugRenderMutex.lock();
 		g_theDepthRenderWireframeVertexes.push_back(debugRenderDepth);
 		g_debugRenderMutex.unlock();
@@ -655,7 +647,7 @@ void DebugAddWorldWireCylinder(Vec3 const& base, Vec3 const& top, float radius,
 		debugRenderXRay.m_endColor = endColor;
 		debugRenderXRay.m_xRayStopwatch = new Stopwatch(duration);
 
-		AddVertsForCylinder3D(debugRenderXRay.m_xRayVertexes, base, top, radius, startColor, numSlices);
+		debugRenderXRay.m_xRayShapes.AddCylinder3D(base, top, radius, startColor, numSlices);
 		g_debugRenderMutex.lock();
 		g_theXRayRenderWireframeVertexes.push_back(debugRenderXRay);
 		g_debugRenderMutex.unlock();
@@ -680,7 +672,7 @@ void DebugAddWorldWireSphere(Vec3 const& center, float radius, float duration, R
 		debugRenderAlways.m_endColor = endColor;
 		debugRenderAlways.m_alwaysStopwatch = new Stopwatch(duration);
 
-		AddVertsForUVSphereZ3D(debugRenderAlways.m_alwaysVertexes, center, radius, numSlices, numStacks, startColor);
+		debugRenderAlways.m_alwaysShapes.AddUVSphereZ3D(center, radius, numSlices, numStacks, startColor);
 		g_debugRenderMutex.lock();
 		g_theAlwaysRenderVertexes.push_back(debugRenderAlways);
 		g_debugRenderMutex.unlock();
@@ -693,7 +685,7 @@ void DebugAddWorldWireSphere(Vec3 const& center, float radius, float duration, R
 		debugRenderDepth.m_endColor = endColor;
 		debugRenderDepth.m_depthStopwatch = new Stopwatch(duration);
 
-		AddVertsForUVSphereZ3D(debugRenderDepth.m_depthVertexes, center, radius, numSlices, numStacks, startColor);
+		debugRenderDepth.m_depthShapes.AddUVSphereZ3D(center, radius, numSlices, numStacks, startColor);
 		g_debugRenderMutex.lock();
 		g_theDepthRenderWireframeVertexes.push_back(debugRenderDepth);
 		g_debugRenderMutex.unlock();
@@ -706,7 +698,7 @@ void DebugAddWorldWireSphere(Vec3 const& center, float radius, float duration, R
 		debugRenderXRay.m_endColor = endColor;
 		debugRenderXRay.m_xRayStopwatch = new Stopwatch(duration);
 
-		AddVertsForUVSphereZ3D(debugRenderXRay.m_xRayVertexes, center, radius, numSlices, numStacks, startColor);
+		debugRenderXRay.m_xRayShapes.AddUVSphereZ3D(center, radius, numSlices, numStacks, startColor);
 		g_debugRenderMutex.lock();
 		g_theXRayRenderVertexes.push_back(debugRenderXRay);
 		g_debugRenderMutex.unlock();
@@ -729,8 +721,8 @@ void DebugAddWorldArrow(Vec3 const& start, Vec3 const& end, float radius, float
 		debugRenderAlways.m_endColor = endColor;
 		debugRenderAlways.m_alwaysStopwatch = new Stopwatch(duration);
 
-		AddVertsForCylinder3D(debugRenderAlways.m_alwaysVertexes, start, start + (iForward * 0.8f), radius * 0.75f, startColor, 8);
-		AddVertsForCone3D(debugRenderAlways.m_alwaysVertexes, start + (iForward * 0.8f), end, radius * 1.5f, startColor);
+		debugRenderAlways.m_alwaysShapes.AddCylinder3D(start, start + (iForward * 0.8f), radius * 0.75f, startColor, 8);
+		debugRenderAlways.m_alwaysShapes.AddCone3D(start + (iForward * 0.8f), end, radius * 1.5f, startColor);
 		g_debugRenderMutex.lock();
 		g_theAlwaysRenderVertexes.push_back(debugRenderAlways);
 		g_debugRenderMutex.unlock();
@@ -744,8 +736,8 @@ void DebugAddWorldArrow(Vec3 const& start, Vec3 const& end, float radius, float
 		debugRenderDepth.m_duration = duration;
 		debugRenderDepth.m_depthStopwatch = new Stopwatch(duration);
 
-		AddVertsForCylinder3D(debugRenderDepth.m_depthVertexes, start, start + (iForward * 0.8f), radius * 0.75f, startColor, 8);
-		AddVertsForCone3D(debugRenderDepth.m_depthVertexes, start + (iForward * 0.8f), end, radius * 1.5f, startColor, 8);
+		debugRenderDepth.m_depthShapes.AddCylinder3D(start, start + (iForward * 0.8f), radius * 0.75f, startColor, 8);
+		debugRenderDepth.m_depthShapes.AddCone3D(start + (iForward * 0.8f), end, radius * 1.5f, startColor, 8);
 		g_theDepthRenderVertexes.push_back(debugRenderDepth);
 		break;
 	}
@@ -756,8 +748,8 @@ void DebugAddWorldArrow(Vec3 const& start, Vec3 const& end, float radius, float
 		debugRenderXRay.m_endColor = endColor;
 		debugRenderXRay.m_xRayStopwatch = new Stopwatch(duration);
 
-		AddVertsForCylinder3D(debugRenderXRay.m_xRayVertexes, start, start + (iForward * 0.8f), radius * 0.65f, startColor, 8);
-		AddVertsForCone3D(debugRenderXRay.m_xRayVertexes, start + (iForward * 0.8f), end, radius * 1.5f, startColor);
+		debugRenderXRay.m_xRayShapes.AddCylinder3D(start, start + (iForward * 0.8f), radius * 0.65f, startColor, 8);
+		debugRenderXRay.m_xRayShapes.AddCone3D(start + (iForward * 0.8f), end, radius * 1.5f, startColor);
 		g_theXRayRenderVertexes.push_back(debugRenderXRay);
 		break;
 	}
@@ -864,9 +856,9 @@ void DebugAddScreenText(std::string const& text, Vec2 const& position, float siz
 	debugRenderScreenText.m_duration = duration;
 	debugRenderScreenText.m_textStopwatch = new Stopwatch(duration);
 	
-	std::vector<Vertex_PCU>& verts = debugRenderScreenText.m_screenTextVertexes;
+	std::vector<SpriteQuad>& quads = debugRenderScreenText.m_screenTextQuads;
 	// g_theFont->AddVertsForText2D(verts, Vec2(), size, text, startColor, 1.f);
-	g_Font->AddVertsForTextInBox2D(verts, AABB2(0.f, 0.f, 1600.f, 800.f), size, text, startColor, 1.f, alignment, TextDrawMode::OVERRUN);
+	g_Font->AddQuadsForTextInBox2D(quads, AABB2(0.f, 0.f, 1600.f, 800.f), size, text, startColor, 1.f, alignment, TextDrawMode::OVERRUN);
 	// AABB2 textBounds = GetVertexBounds2D(verts);
 	// Vec2 textDim = textBounds.GetDimensions();
 	// textDim.x *= alignment.x;
@@ -1,12 +1,14 @@
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Network/NetSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/Stopwatch.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -65,6 +67,8 @@ void DevConsole::Startup()
 //--------------------------------------------------------------------------------------------------
 void DevConsole::Shutdown()
 {
+	delete m_spriteBatch;
+	m_spriteBatch = nullptr;
 }
 
 
@@ -246,15 +250,17 @@ void DevConsole::Render(AABB2 const& bounds)
 
 	m_config.m_renderer->BeginCamera(devConsoleCamera);
 
-	std::vector<Vertex_PCU> devConsoleOverlay;
-	AddVertsForAABB2D(devConsoleOverlay, bounds, Rgba8(0, 0, 0, 175));
-	
+	if (m_spriteBatch == nullptr)
+	{
+		m_spriteBatch = new SpriteBatch(*m_config.m_renderer);
+	}
+
 	BitmapFont* font = m_config.m_renderer->CreateOrGetBitmapFont(m_fontFilePath.c_str());
 	
 	float cellHeight = m_cellHeight * bounds.m_maxs.y;
 	AABB2 localBounds = AABB2(bounds.m_mins.x, bounds.m_mins.y + cellHeight, bounds.m_maxs.x, bounds.m_mins.y + cellHeight + cellHeight);
 	
-	std::vector<Vertex_PCU> textInBoxVerts;
+	std::vector<SpriteQuad> textInBoxQuads;
 	float fontAspect = m_config.m_fontAspect;
 	
 	int linesToBePrinted = 0;
@@ -266,7 +272,7 @@ void DevConsole::Render(AABB2 const& bounds)
 			break;
 		}
 
-		font->AddVertsForTextInBox2D(textInBoxVerts, localBounds, cellHeight, m_lines[lineIndex].m_text, m_lines[lineIndex].m_color, fontAspect, Vec2(0.f, 0.f));
+		font->AddQuadsForTextInBox2D(textInBoxQuads, localBounds, cellHeight, m_lines[lineIndex].m_text, m_lines[lineIndex].m_color, fontAspect, Vec2(0.f, 0.f));
 		
 		localBounds.m_mins.y += cellHeight;
 		localBounds.m_maxs.y += cellHeight;
@@ -275,30 +281,23 @@ void DevConsole::Render(AABB2 const& bounds)
 
 	localBounds.m_mins.y = bounds.m_mins.y;
 	localBounds.m_maxs.y = cellHeight;
-	font->AddVertsForTextInBox2D(textInBoxVerts, localBounds, cellHeight, m_inputText, INPUT_TEXT, fontAspect, Vec2(0.f, 0.f));
+	font->AddQuadsForTextInBox2D(textInBoxQuads, localBounds, cellHeight, m_inputText, INPUT_TEXT, fontAspect, Vec2(0.f, 0.f));
 
 	float cellWidth = cellHeight * fontAspect;
 	AABB2 carretBounds(0.f, 0.f, cellWidth * 0.1f, cellHeight);
 	float caretPosition = cellWidth * m_caretPosition;
 	caretPosition = GetClamped(caretPosition, bounds.m_mins.x, bounds.m_maxs.x);
 	carretBounds.SetCenter(Vec2(caretPosition, cellHeight * 0.5f));
-	std::vector<Vertex_PCU> carretVerts;
-	AddVertsForAABB2D(carretVerts, carretBounds, INPUT_CARET);
 
-	m_config.m_renderer->SetBlendMode(BlendMode::ALPHA);
-	m_config.m_renderer->BindTexture(nullptr);
-	m_config.m_renderer->DrawVertexArray((int)devConsoleOverlay.size(), devConsoleOverlay.data());
-	
+	// The overlay and caret share the default texture, so they go in one draw ahead of the text
+	m_spriteBatch->Begin();
+	m_spriteBatch->AddQuad(nullptr, BlendMode::ALPHA, bounds, AABB2::ZERO_TO_ONE, Rgba8(0, 0, 0, 175));
 	if (m_caretVisible)
 	{
-		m_config.m_renderer->SetBlendMode(BlendMode::ALPHA);
-		m_config.m_renderer->BindTexture(nullptr);
-		m_config.m_renderer->DrawVertexArray((int)carretVerts.size(), carretVerts.data());
+		m_spriteBatch->AddQuad(nullptr, BlendMode::ALPHA, carretBounds, AABB2::ZERO_TO_ONE, INPUT_CARET);
 	}
-	
-	m_config.m_renderer->SetBlendMode(BlendMode::ALPHA);
-	m_config.m_renderer->BindTexture(&font->GetTexture());
-	m_config.m_renderer->DrawVertexArray((int)textInBoxVerts.size(), textInBoxVerts.data());
+	m_spriteBatch->AddQuads(&font->GetTexture(), BlendMode::ALPHA, textInBoxQuads.data(), (int)textInBoxQuads.size());
+	m_spriteBatch->End();
 	m_config.m_renderer->EndCamera(devConsoleCamera);
 	m_devConsoleRenderMutex.unlock();
 }
@@ -538,3 +537,14 @@ bool DevConsole::Command_Help(EventArgs& args)
 	(void)args;
 	return true;
 }
+
+
+//--------------------------------------------------------------------------------------------------
+void PrintBenchmarkResult(std::string const& result, bool isError)
+{
+	DebuggerPrintf("%s\n", result.c_str());
+	if (g_theDevConsole)
+	{
+		g_theDevConsole->AddLine(isError ? DevConsole::ERROR : DevConsole::INFO_MINOR, result);
+	}
+}
@@ -16,6 +16,7 @@
 
 //--------------------------------------------------------------------------------------------------
 class	BitmapFont;
+class	SpriteBatch;
 class	Stopwatch;
 class	Renderer;
 class	Camera;
@@ -33,6 +34,11 @@ class DevConsole;
 extern DevConsole* g_theDevConsole;
 
 
+//--------------------------------------------------------------------------------------------------
+// For benchmark and check commands, goes to the debugger output and to the dev console once there is one
+void PrintBenchmarkResult(std::string const& result, bool isError = false);
+
+
 //--------------------------------------------------------------------------------------------------
 struct DevConsoleLine
 {
@@ -105,4 +111,5 @@ protected:
 	std::vector<std::string> m_commandHistory;
 	int m_historyIndex = -1;
 	float m_cellHeight = -1;
+	SpriteBatch* m_spriteBatch = nullptr;
 };
\ No newline at end of file
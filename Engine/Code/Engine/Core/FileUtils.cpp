@@ -2,6 +2,11 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
 
+//--------------------------------------------------------------------------------------------------
+#include <filesystem>
+#include <algorithm>
+
+
 //--------------------------------------------------------------------------------------------------
 int FileReadToBuffer(std::vector<uint8_t>& out_Buffer, std::string const& fileName)
 {
@@ -51,7 +56,6 @@ int FileReadToString(std::string& outString, std::string const& fileName)
 
 
 //--------------------------------------------------------------------------------------------------
-#include <filesystem>
 void FileWriteFromBuffer(std::vector<uint8_t> const& inBuffer, std::string const& fileName)
 {
 	FILE* fileInfoPtr = nullptr;
@@ -85,4 +89,26 @@ bool DoesFileExist(std::string const& filePath)
 	}
 	fclose(fileInfoPtr);
 	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<std::string> GetFileNamesInFolder(std::string const& folderName, std::vector<std::string> const& extensions)
+{
+	std::vector<std::string>			fileNames;
+	std::error_code						errorCode;
+	std::filesystem::directory_iterator	folderIterator(folderName, errorCode);
+	if (errorCode)
+	{
+		return fileNames;
+	}
+	for (std::filesystem::directory_entry const& folderEntry : folderIterator)
+	{
+		if (std::find(extensions.begin(), extensions.end(), folderEntry.path().extension().string()) != extensions.end())
+		{
+			fileNames.push_back(folderName + "/" + folderEntry.path().filename().string());
+		}
+	}
+	std::sort(fileNames.begin(), fileNames.end());
+	return fileNames;
 }
\ No newline at end of file
@@ -11,4 +11,5 @@
 int		FileReadToBuffer(std::vector<uint8_t>& out_Buffer, std::string const& fileName);
 int		FileReadToString(std::string& outString, std::string const& fileName);
 void	FileWriteFromBuffer(std::vector<uint8_t> const& inBuffer, std::string const& fileName);
-bool	DoesFileExist(std::string const& filePath);
\ No newline at end of file
+bool	DoesFileExist(std::string const& filePath);
+std::vector<std::string>	GetFileNamesInFolder(std::string const& folderName, std::vector<std::string> const& extensions);	// Sorted "folder/name.ext" paths of the files with one of the extensions (".obj"), empty if the folder does not exist
\ No newline at end of file
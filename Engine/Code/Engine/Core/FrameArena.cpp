@@ -0,0 +1,98 @@
+#include "Engine/Core/FrameArena.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+
+
+//--------------------------------------------------------------------------------------------------
+static unsigned char* AlignPointer(unsigned char* pointer, size_t alignment)
+{
+	uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+	return reinterpret_cast<unsigned char*>((address + (alignment - 1)) & ~(uintptr_t)(alignment - 1));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+FrameArena::FrameArena(size_t initialCapacityBytes) :
+	m_capacityBytes(initialCapacityBytes)
+{
+	if (m_capacityBytes > 0)
+	{
+		m_block = new unsigned char[m_capacityBytes];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+FrameArena::~FrameArena()
+{
+	for (size_t blockIndex = 0; blockIndex < m_overflowBlocks.size(); ++blockIndex)
+	{
+		delete[] m_overflowBlocks[blockIndex];
+	}
+	delete[] m_block;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void FrameArena::BeginFrame()
+{
+	if (!m_overflowBlocks.empty())
+	{
+		for (size_t blockIndex = 0; blockIndex < m_overflowBlocks.size(); ++blockIndex)
+		{
+			delete[] m_overflowBlocks[blockIndex];
+		}
+		m_overflowBlocks.clear();
+
+		// Grow geometrically so a slowly increasing workload does not reallocate every frame
+		size_t neededBytes	=	m_numOfBytesUsed + m_numOfOverflowBytes;
+		size_t newCapacity	=	m_capacityBytes * 2;
+		m_capacityBytes		=	newCapacity > neededBytes ? newCapacity : neededBytes;
+		delete[] m_block;
+		m_block				=	new unsigned char[m_capacityBytes];
+	}
+
+	m_numOfBytesUsed		=	0;
+	m_numOfOverflowBytes	=	0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void* FrameArena::Allocate(size_t numOfBytes, size_t alignment)
+{
+	GUARANTEE_OR_DIE(alignment > 0 && (alignment & (alignment - 1)) == 0, "FrameArena alignment must be a power of two");
+
+	if (m_block)
+	{
+		unsigned char* allocation = AlignPointer(m_block + m_numOfBytesUsed, alignment);
+		if (allocation + numOfBytes <= m_block + m_capacityBytes)
+		{
+			m_numOfBytesUsed = (size_t)(allocation - m_block) + numOfBytes;
+			return allocation;
+		}
+	}
+
+	// Only happens until the next BeginFrame resizes the main block
+	size_t overflowBytes = numOfBytes + alignment;
+	unsigned char* overflowBlock = new unsigned char[overflowBytes];
+	m_overflowBlocks.push_back(overflowBlock);
+	m_numOfOverflowBytes += overflowBytes;
+	return AlignPointer(overflowBlock, alignment);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t FrameArena::GetNumOfBytesUsed() const
+{
+	return m_numOfBytesUsed + m_numOfOverflowBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t FrameArena::GetCapacityBytes() const
+{
+	return m_capacityBytes;
+}
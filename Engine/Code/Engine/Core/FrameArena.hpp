@@ -0,0 +1,38 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+// Linear allocator for memory that only lives until the next BeginFrame
+// Allocations that do not fit go into overflow blocks, and the next BeginFrame folds them into one block big enough for the whole frame,
+// so after a warm up frame everything comes out of a single allocation
+// Not thread safe, allocate from the thread that owns the arena and hand the pointers to jobs
+class FrameArena
+{
+public:
+	explicit FrameArena(size_t initialCapacityBytes = 1024 * 1024);
+	~FrameArena();
+	FrameArena(FrameArena const& copyFrom) = delete;
+	FrameArena& operator=(FrameArena const& copyFrom) = delete;
+
+	void	BeginFrame();
+	void*	Allocate(size_t numOfBytes, size_t alignment = 16);
+	size_t	GetNumOfBytesUsed() const;
+	size_t	GetCapacityBytes() const;
+
+	template <typename T>
+	T*		AllocateArray(size_t numOfElements)
+	{
+		return static_cast<T*>(Allocate(sizeof(T) * numOfElements, alignof(T)));
+	}
+
+private:
+	unsigned char*				m_block					=	nullptr;
+	size_t						m_capacityBytes			=	0;
+	size_t						m_numOfBytesUsed		=	0;
+	std::vector<unsigned char*>	m_overflowBlocks;
+	size_t						m_numOfOverflowBytes	=	0;
+};
@@ -0,0 +1,541 @@
+#include "Engine/Core/HashUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <intrin.h>
+#include <nmmintrin.h>
+#include <filesystem>
+#include <algorithm>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------------------------
+static constexpr uint32_t	CRC32C_POLYNOMIAL			=	0x82F63B78u;		// Bit reversed, the CRC shifts right
+static constexpr size_t		CRC32C_STREAM_LENGTH		=	1024;				// Bytes per stream when three CRCs run side by side
+static constexpr uint64_t	XXHASH64_PRIME_1			=	0x9E3779B185EBCA87ull;
+static constexpr uint64_t	XXHASH64_PRIME_2			=	0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t	XXHASH64_PRIME_3			=	0x165667B19E3779F9ull;
+static constexpr uint64_t	XXHASH64_PRIME_4			=	0x85EBCA77C2B2AE63ull;
+static constexpr uint64_t	XXHASH64_PRIME_5			=	0x27D4EB2F165667C5ull;
+
+
+//--------------------------------------------------------------------------------------------------
+// Native loads, the hashes are defined on little endian words like every platform the engine runs on
+static uint32_t ReadUInt32(unsigned char const* bytes)
+{
+	uint32_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint64_t ReadUInt64(unsigned char const* bytes)
+{
+	uint64_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Slicing by 8 tables for the software CRC, and the tables that move a CRC past CRC32C_STREAM_LENGTH zero bytes to join up the side by side streams
+struct CRC32CTables
+{
+	CRC32CTables();
+	uint32_t	ShiftPastStream(uint32_t crc) const;
+
+	uint32_t	m_slicingTables[8][256];
+	uint32_t	m_streamShiftTables[4][256];
+	bool		m_hasHardwareCRC			=	false;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+CRC32CTables::CRC32CTables()
+{
+	for (uint32_t byteValue = 0; byteValue < 256; ++byteValue)
+	{
+		uint32_t crc = byteValue;
+		for (int bitIndex = 0; bitIndex < 8; ++bitIndex)
+		{
+			crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLYNOMIAL : 0);
+		}
+		m_slicingTables[0][byteValue] = crc;
+	}
+	for (int tableIndex = 1; tableIndex < 8; ++tableIndex)
+	{
+		for (uint32_t byteValue = 0; byteValue < 256; ++byteValue)
+		{
+			uint32_t previousEntry = m_slicingTables[tableIndex - 1][byteValue];
+			m_slicingTables[tableIndex][byteValue] = (previousEntry >> 8) ^ m_slicingTables[0][previousEntry & 0xFF];
+		}
+	}
+
+	// Without the pre and post inversion a CRC is linear, so shifting past the zero bytes is fixed by where each of the 32 bits ends up
+	uint32_t shiftedBits[32];
+	for (int bitIndex = 0; bitIndex < 32; ++bitIndex)
+	{
+		uint32_t crc = 1u << bitIndex;
+		for (size_t byteIndex = 0; byteIndex < CRC32C_STREAM_LENGTH; ++byteIndex)
+		{
+			crc = (crc >> 8) ^ m_slicingTables[0][crc & 0xFF];
+		}
+		shiftedBits[bitIndex] = crc;
+	}
+	for (int tableIndex = 0; tableIndex < 4; ++tableIndex)
+	{
+		for (uint32_t byteValue = 0; byteValue < 256; ++byteValue)
+		{
+			uint32_t shiftedCRC = 0;
+			for (int bitIndex = 0; bitIndex < 8; ++bitIndex)
+			{
+				if (byteValue & (1u << bitIndex))
+				{
+					shiftedCRC ^= shiftedBits[tableIndex * 8 + bitIndex];
+				}
+			}
+			m_streamShiftTables[tableIndex][byteValue] = shiftedCRC;
+		}
+	}
+
+	int cpuInfo[4] = { };
+	__cpuid(cpuInfo, 1);
+	m_hasHardwareCRC = (cpuInfo[2] & (1 << 20)) != 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t CRC32CTables::ShiftPastStream(uint32_t crc) const
+{
+	return m_streamShiftTables[0][crc & 0xFF] ^ m_streamShiftTables[1][(crc >> 8) & 0xFF] ^ m_streamShiftTables[2][(crc >> 16) & 0xFF] ^ m_streamShiftTables[3][crc >> 24];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static CRC32CTables const& GetCRC32CTables()
+{
+	static CRC32CTables const s_crc32cTables;
+	return s_crc32cTables;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool IsCRC32CHardwareAccelerated()
+{
+	return GetCRC32CTables().m_hasHardwareCRC;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The crc32 instruction has a 3 cycle latency but issues every cycle, so big inputs run as three independent streams joined with the shift tables
+static uint32_t UpdateCRC32CHardware(unsigned char const* bytes, size_t numOfBytes, uint32_t crc, CRC32CTables const& tables)
+{
+	while (numOfBytes >= 3 * CRC32C_STREAM_LENGTH)
+	{
+		uint64_t crcA = crc;
+		uint64_t crcB = 0;
+		uint64_t crcC = 0;
+		for (size_t byteIndex = 0; byteIndex < CRC32C_STREAM_LENGTH; byteIndex += sizeof(uint64_t))
+		{
+			crcA = _mm_crc32_u64(crcA, ReadUInt64(bytes + byteIndex));
+			crcB = _mm_crc32_u64(crcB, ReadUInt64(bytes + CRC32C_STREAM_LENGTH + byteIndex));
+			crcC = _mm_crc32_u64(crcC, ReadUInt64(bytes + 2 * CRC32C_STREAM_LENGTH + byteIndex));
+		}
+		crc = tables.ShiftPastStream(tables.ShiftPastStream((uint32_t)crcA) ^ (uint32_t)crcB) ^ (uint32_t)crcC;
+		bytes		+=	3 * CRC32C_STREAM_LENGTH;
+		numOfBytes	-=	3 * CRC32C_STREAM_LENGTH;
+	}
+
+	uint64_t crc64 = crc;
+	for (; numOfBytes >= sizeof(uint64_t); numOfBytes -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+	{
+		crc64 = _mm_crc32_u64(crc64, ReadUInt64(bytes));
+	}
+	crc = (uint32_t)crc64;
+	for (; numOfBytes > 0; --numOfBytes, ++bytes)
+	{
+		crc = _mm_crc32_u8(crc, *bytes);
+	}
+	return crc;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint32_t UpdateCRC32CSoftware(unsigned char const* bytes, size_t numOfBytes, uint32_t crc, CRC32CTables const& tables)
+{
+	uint32_t const (&slicingTables)[8][256] = tables.m_slicingTables;
+	for (; numOfBytes >= sizeof(uint64_t); numOfBytes -= sizeof(uint64_t), bytes += sizeof(uint64_t))
+	{
+		uint64_t word = ReadUInt64(bytes) ^ crc;
+		crc = slicingTables[7][word & 0xFF] ^ slicingTables[6][(word >> 8) & 0xFF] ^ slicingTables[5][(word >> 16) & 0xFF] ^ slicingTables[4][(word >> 24) & 0xFF] ^
+			  slicingTables[3][(word >> 32) & 0xFF] ^ slicingTables[2][(word >> 40) & 0xFF] ^ slicingTables[1][(word >> 48) & 0xFF] ^ slicingTables[0][word >> 56];
+	}
+	for (; numOfBytes > 0; --numOfBytes, ++bytes)
+	{
+		crc = (crc >> 8) ^ slicingTables[0][(crc ^ *bytes) & 0xFF];
+	}
+	return crc;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t ComputeCRC32C(void const* data, size_t numOfBytes, uint32_t previousCRC)
+{
+	CRC32CTables const& tables = GetCRC32CTables();
+	if (!tables.m_hasHardwareCRC)
+	{
+		return ~UpdateCRC32CSoftware((unsigned char const*)data, numOfBytes, ~previousCRC, tables);
+	}
+	return ~UpdateCRC32CHardware((unsigned char const*)data, numOfBytes, ~previousCRC, tables);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t ComputeCRC32C(Buffer const& buffer, uint32_t previousCRC)
+{
+	return ComputeCRC32C(buffer.data(), buffer.size(), previousCRC);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t ComputeCRC32C(MemoryMappedFile const& file, uint32_t previousCRC)
+{
+	return ComputeCRC32C(file.GetData(), file.GetSize(), previousCRC);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t ComputeCRC32CSoftware(void const* data, size_t numOfBytes, uint32_t previousCRC)
+{
+	return ~UpdateCRC32CSoftware((unsigned char const*)data, numOfBytes, ~previousCRC, GetCRC32CTables());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint64_t RotateLeft64(uint64_t value, int numOfBits)
+{
+	return (value << numOfBits) | (value >> (64 - numOfBits));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint64_t XXHash64Round(uint64_t accumulator, uint64_t input)
+{
+	accumulator += input * XXHASH64_PRIME_2;
+	accumulator = RotateLeft64(accumulator, 31);
+	return accumulator * XXHASH64_PRIME_1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint64_t XXHash64MergeRound(uint64_t hash, uint64_t accumulator)
+{
+	hash ^= XXHash64Round(0, accumulator);
+	return hash * XXHASH64_PRIME_1 + XXHASH64_PRIME_4;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void InitializeXXHash64Accumulators(uint64_t (&out_accumulators)[4], uint64_t seed)
+{
+	out_accumulators[0]	=	seed + XXHASH64_PRIME_1 + XXHASH64_PRIME_2;
+	out_accumulators[1]	=	seed + XXHASH64_PRIME_2;
+	out_accumulators[2]	=	seed;
+	out_accumulators[3]	=	seed - XXHASH64_PRIME_1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Runs every whole 32 byte stripe of bytes through the four accumulators, returns how many bytes that used
+static size_t ConsumeXXHash64Stripes(uint64_t (&accumulators)[4], unsigned char const* bytes, size_t numOfBytes)
+{
+	size_t numOfStripeBytes = numOfBytes & ~(size_t)31;
+	for (size_t byteIndex = 0; byteIndex < numOfStripeBytes; byteIndex += 32)
+	{
+		accumulators[0] = XXHash64Round(accumulators[0], ReadUInt64(bytes + byteIndex));
+		accumulators[1] = XXHash64Round(accumulators[1], ReadUInt64(bytes + byteIndex + 8));
+		accumulators[2] = XXHash64Round(accumulators[2], ReadUInt64(bytes + byteIndex + 16));
+		accumulators[3] = XXHash64Round(accumulators[3], ReadUInt64(bytes + byteIndex + 24));
+	}
+	return numOfStripeBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Folds in the total length and the last partial stripe, then mixes the bits
+static uint64_t FinalizeXXHash64(uint64_t const (&accumulators)[4], uint64_t seed, uint64_t totalNumOfBytes, unsigned char const* leftoverBytes, size_t numOfLeftoverBytes)
+{
+	uint64_t hash = 0;
+	if (totalNumOfBytes >= 32)
+	{
+		hash = RotateLeft64(accumulators[0], 1) + RotateLeft64(accumulators[1], 7) + RotateLeft64(accumulators[2], 12) + RotateLeft64(accumulators[3], 18);
+		for (int accumulatorIndex = 0; accumulatorIndex < 4; ++accumulatorIndex)
+		{
+			hash = XXHash64MergeRound(hash, accumulators[accumulatorIndex]);
+		}
+	}
+	else
+	{
+		hash = seed + XXHASH64_PRIME_5;
+	}
+
+	hash += totalNumOfBytes;
+	for (; numOfLeftoverBytes >= 8; numOfLeftoverBytes -= 8, leftoverBytes += 8)
+	{
+		hash ^= XXHash64Round(0, ReadUInt64(leftoverBytes));
+		hash = RotateLeft64(hash, 27) * XXHASH64_PRIME_1 + XXHASH64_PRIME_4;
+	}
+	if (numOfLeftoverBytes >= 4)
+	{
+		hash ^= (uint64_t)ReadUInt32(leftoverBytes) * XXHASH64_PRIME_1;
+		hash = RotateLeft64(hash, 23) * XXHASH64_PRIME_2 + XXHASH64_PRIME_3;
+		numOfLeftoverBytes	-=	4;
+		leftoverBytes		+=	4;
+	}
+	for (; numOfLeftoverBytes > 0; --numOfLeftoverBytes, ++leftoverBytes)
+	{
+		hash ^= (*leftoverBytes) * XXHASH64_PRIME_5;
+		hash = RotateLeft64(hash, 11) * XXHASH64_PRIME_1;
+	}
+
+	hash ^= hash >> 33;
+	hash *= XXHASH64_PRIME_2;
+	hash ^= hash >> 29;
+	hash *= XXHASH64_PRIME_3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t ComputeXXHash64(void const* data, size_t numOfBytes, uint64_t seed)
+{
+	unsigned char const*	bytes				=	(unsigned char const*)data;
+	uint64_t				accumulators[4];
+	InitializeXXHash64Accumulators(accumulators, seed);
+	size_t					numOfStripeBytes	=	ConsumeXXHash64Stripes(accumulators, bytes, numOfBytes);
+	return FinalizeXXHash64(accumulators, seed, numOfBytes, bytes + numOfStripeBytes, numOfBytes - numOfStripeBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t ComputeXXHash64(Buffer const& buffer, uint64_t seed)
+{
+	return ComputeXXHash64(buffer.data(), buffer.size(), seed);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t ComputeXXHash64(MemoryMappedFile const& file, uint64_t seed)
+{
+	return ComputeXXHash64(file.GetData(), file.GetSize(), seed);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool ComputeFileXXHash64(std::string const& fileName, uint64_t& out_hash, uint64_t seed)
+{
+	MemoryMappedFile file;
+	if (!file.Open(fileName))
+	{
+		return false;
+	}
+	out_hash = ComputeXXHash64(file, seed);
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+XXHash64::XXHash64(uint64_t seed)
+{
+	Reset(seed);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void XXHash64::Reset(uint64_t seed)
+{
+	m_seed				=	seed;
+	m_numOfStripeBytes	=	0;
+	m_numOfBytes		=	0;
+	InitializeXXHash64Accumulators(m_accumulators, seed);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Tops up the buffered stripe first, then hashes whole stripes straight from data and buffers what is left
+void XXHash64::Update(void const* data, size_t numOfBytes)
+{
+	unsigned char const* bytes = (unsigned char const*)data;
+	m_numOfBytes += numOfBytes;
+	if (m_numOfStripeBytes > 0)
+	{
+		size_t numOfBytesToCopy = std::min(numOfBytes, sizeof(m_stripe) - m_numOfStripeBytes);
+		memcpy(m_stripe + m_numOfStripeBytes, bytes, numOfBytesToCopy);
+		m_numOfStripeBytes	+=	numOfBytesToCopy;
+		bytes				+=	numOfBytesToCopy;
+		numOfBytes			-=	numOfBytesToCopy;
+		if (m_numOfStripeBytes < sizeof(m_stripe))
+		{
+			return;
+		}
+		ConsumeXXHash64Stripes(m_accumulators, m_stripe, sizeof(m_stripe));
+		m_numOfStripeBytes = 0;
+	}
+
+	size_t numOfConsumedBytes = ConsumeXXHash64Stripes(m_accumulators, bytes, numOfBytes);
+	m_numOfStripeBytes = numOfBytes - numOfConsumedBytes;
+	memcpy(m_stripe, bytes + numOfConsumedBytes, m_numOfStripeBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void XXHash64::Update(Buffer const& buffer)
+{
+	Update(buffer.data(), buffer.size());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t XXHash64::GetHash() const
+{
+	return FinalizeXXHash64(m_accumulators, m_seed, m_numOfBytes, m_stripe, m_numOfStripeBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// What cooked meshes used to hash their source with, FNV-1a over 8 byte words, kept here to compare against
+static uint64_t ComputeWordFNV1a64(unsigned char const* data, size_t numOfBytes)
+{
+	uint64_t const	FNV_OFFSET_BASIS	=	0xCBF29CE484222325ull;
+	uint64_t const	FNV_PRIME			=	0x00000100000001B3ull;
+	uint64_t		hash				=	FNV_OFFSET_BASIS ^ (uint64_t)numOfBytes;
+	size_t			numOfWords			=	numOfBytes / sizeof(uint64_t);
+	for (size_t wordIndex = 0; wordIndex < numOfWords; ++wordIndex)
+	{
+		hash = (hash ^ ReadUInt64(data + wordIndex * sizeof(uint64_t))) * FNV_PRIME;
+		hash ^= hash >> 29;
+	}
+	for (size_t byteIndex = numOfWords * sizeof(uint64_t); byteIndex < numOfBytes; ++byteIndex)
+	{
+		hash = (hash ^ data[byteIndex]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Published check values, and incremental and split results against the one shot ones on awkward sizes
+static bool RunHashKnownAnswerChecks(Buffer const& data)
+{
+	char const* checkString		=	"123456789";
+	char const* longString		=	"Nobody inspects the spammish repetition";
+	bool		isValid			=	ComputeCRC32C(checkString, 9) == 0xE3069283u && ComputeCRC32CSoftware(checkString, 9) == 0xE3069283u;
+	isValid = isValid && ComputeXXHash64("", 0) == 0xEF46DB3751D8E999ull && ComputeXXHash64("abc", 3) == 0x44BC2CF5AD770999ull;
+	isValid = isValid && ComputeXXHash64(longString, strlen(longString)) == 0xFBCEA83C8A378BF1ull;
+
+	size_t numOfBytesToCheck = std::min<size_t>(data.size(), 100000);
+	for (size_t numOfBytes = 0; isValid && numOfBytes < numOfBytesToCheck; numOfBytes = numOfBytes * 2 + 13)
+	{
+		size_t		splitPosition	=	numOfBytes / 3;
+		uint32_t	crc				=	ComputeCRC32C(data.data(), numOfBytes, 7);
+		isValid = crc == ComputeCRC32CSoftware(data.data(), numOfBytes, 7) && crc == ComputeCRC32C(data.data() + splitPosition, numOfBytes - splitPosition, ComputeCRC32C(data.data(), splitPosition, 7));
+
+		XXHash64 incrementalHash(42);
+		for (size_t byteIndex = 0; byteIndex < numOfBytes; byteIndex += 1 + byteIndex % 37)
+		{
+			incrementalHash.Update(data.data() + byteIndex, std::min<size_t>(1 + byteIndex % 37, numOfBytes - byteIndex));
+		}
+		isValid = isValid && incrementalHash.GetHash() == ComputeXXHash64(data.data(), numOfBytes, 42);
+	}
+	return isValid;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Hashes NumOfMegabytes of random bytes NumOfRuns times with each hash (best run counts), then every model file through a memory mapping
+bool Command_HashBenchmark(EventArgs& args)
+{
+	int numOfMegabytes	=	args.GetValue("NumOfMegabytes", 64);
+	int numOfRuns		=	args.GetValue("NumOfRuns", 5);
+	if (numOfMegabytes <= 0 || numOfRuns <= 0)
+	{
+		return false;
+	}
+
+	Buffer		data((size_t)numOfMegabytes * 1024 * 1024);
+	uint64_t	randomState		=	0x2545F4914F6CDD1Dull;
+	for (size_t byteIndex = 0; byteIndex + sizeof(uint64_t) <= data.size(); byteIndex += sizeof(uint64_t))
+	{
+		randomState ^= randomState << 13;
+		randomState ^= randomState >> 7;
+		randomState ^= randomState << 17;
+		memcpy(&data[byteIndex], &randomState, sizeof(randomState));
+	}
+
+	bool areChecksValid = RunHashKnownAnswerChecks(data);
+	PrintBenchmarkResult(Stringf("Hash check values and incremental hashes: %s", areChecksValid ? "PASSED" : "FAILED"), !areChecksValid);
+
+	double		numOfGigabytes		=	(double)data.size() / (1024.0 * 1024.0 * 1024.0);
+	uint64_t	resultSum			=	0;
+	char const*	hashNames[5]		=	{ IsCRC32CHardwareAccelerated() ? "CRC32C (SSE4.2, 3 streams)" : "CRC32C (no SSE4.2, tables)", "CRC32C (tables)", "xxHash64", "xxHash64 in 4 KB pieces", "FNV-1a words (old cooked mesh hash)" };
+	for (int hashIndex = 0; hashIndex < 5; ++hashIndex)
+	{
+		double bestSeconds = 1e9;
+		for (int runIndex = 0; runIndex < numOfRuns; ++runIndex)
+		{
+			double timeBeforeHash = GetCurrentTimeSeconds();
+			switch (hashIndex)
+			{
+				case 0:		resultSum += ComputeCRC32C(data);								break;
+				case 1:		resultSum += ComputeCRC32CSoftware(data.data(), data.size());	break;
+				case 2:		resultSum += ComputeXXHash64(data);								break;
+				case 3:
+				{
+					XXHash64 incrementalHash;
+					for (size_t byteIndex = 0; byteIndex < data.size(); byteIndex += 4096)
+					{
+						incrementalHash.Update(data.data() + byteIndex, std::min<size_t>(4096, data.size() - byteIndex));
+					}
+					resultSum += incrementalHash.GetHash();
+					break;
+				}
+				default:	resultSum += ComputeWordFNV1a64(data.data(), data.size());		break;
+			}
+			bestSeconds = std::min(bestSeconds, GetCurrentTimeSeconds() - timeBeforeHash);
+		}
+		PrintBenchmarkResult(Stringf("%-40s %6.2f GB/s", hashNames[hashIndex], numOfGigabytes / bestSeconds));
+	}
+
+	std::string	folderName			=	args.GetValue("Folder", "Data/Models");
+	size_t		numOfFileBytes		=	0;
+	double		mappedFileSeconds	=	0.0;
+	int			numOfFiles			=	0;
+	std::error_code errorCode;
+	for (std::filesystem::directory_entry const& folderEntry : std::filesystem::directory_iterator(folderName, errorCode))
+	{
+		MemoryMappedFile file;
+		if (!folderEntry.is_regular_file() || !file.Open(folderEntry.path().string()))
+		{
+			continue;
+		}
+		ComputeXXHash64(file);
+		double timeBeforeHash = GetCurrentTimeSeconds();
+		resultSum += ComputeXXHash64(file) + ComputeCRC32C(file);
+		mappedFileSeconds	+=	GetCurrentTimeSeconds() - timeBeforeHash;
+		numOfFileBytes		+=	file.GetSize();
+		++numOfFiles;
+	}
+	if (numOfFiles > 0)
+	{
+		PrintBenchmarkResult(Stringf("%d mapped files in %s, %.2f MB: xxHash64 and CRC32C together %.2f GB/s (checksum sum %llx)", numOfFiles, folderName.c_str(), (double)numOfFileBytes / (1024.0 * 1024.0),
+									 (double)numOfFileBytes / (1024.0 * 1024.0 * 1024.0) / mappedFileSeconds, (unsigned long long)resultSum));
+	}
+	return areChecksValid;
+}
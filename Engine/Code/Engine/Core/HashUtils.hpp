@@ -0,0 +1,59 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/BufferUtils.hpp"
+#include "Engine/Core/EventSystem.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <string>
+#include <stdint.h>
+
+
+//--------------------------------------------------------------------------------------------------
+class MemoryMappedFile;
+
+
+//--------------------------------------------------------------------------------------------------
+// CRC32C (Castagnoli), for integrity checks, runs on SSE4.2's crc32 instruction when the CPU has it and on tables otherwise
+// Passing the CRC of everything before as previousCRC continues it, so ComputeCRC32C(B, ComputeCRC32C(A)) is the CRC of A followed by B
+bool		IsCRC32CHardwareAccelerated();
+uint32_t	ComputeCRC32C(void const* data, size_t numOfBytes, uint32_t previousCRC = 0);
+uint32_t	ComputeCRC32C(Buffer const& buffer, uint32_t previousCRC = 0);
+uint32_t	ComputeCRC32C(MemoryMappedFile const& file, uint32_t previousCRC = 0);
+uint32_t	ComputeCRC32CSoftware(void const* data, size_t numOfBytes, uint32_t previousCRC = 0);
+
+
+//--------------------------------------------------------------------------------------------------
+// 64 bit xxHash, for content hashes used as cache keys, matches the reference implementation's XXH64
+uint64_t	ComputeXXHash64(void const* data, size_t numOfBytes, uint64_t seed = 0);
+uint64_t	ComputeXXHash64(Buffer const& buffer, uint64_t seed = 0);
+uint64_t	ComputeXXHash64(MemoryMappedFile const& file, uint64_t seed = 0);
+bool		ComputeFileXXHash64(std::string const& fileName, uint64_t& out_hash, uint64_t seed = 0);		// Maps the file, false if it could not be opened
+
+
+//--------------------------------------------------------------------------------------------------
+// Incremental xxHash64, data can arrive in pieces of any size and hashes the same as one ComputeXXHash64 call over all of it
+class XXHash64
+{
+public:
+	XXHash64(uint64_t seed = 0);
+
+	void		Reset(uint64_t seed = 0);
+	void		Update(void const* data, size_t numOfBytes);
+	void		Update(Buffer const& buffer);
+	uint64_t	GetHash() const;		// Of everything so far, more can be added afterwards
+
+private:
+	uint64_t		m_seed					=	0;
+	uint64_t		m_accumulators[4]		=	{ };
+	unsigned char	m_stripe[32]			=	{ };
+	size_t			m_numOfStripeBytes		=	0;
+	uint64_t		m_numOfBytes			=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_HashBenchmark(EventArgs& args);
@@ -12,7 +12,7 @@ Image::Image(char const* imageFilePath) :
 	int numComponentsRequested = 0; // don't care; we support 3 (24-bit RGB) or 4 (32-bit RGBA)
 
 	// Load (and decompress) the image RGB(A) bytes from a file on disk into a memory buffer (array of bytes)
-	stbi_set_flip_vertically_on_load(1); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT
+	stbi_set_flip_vertically_on_load_thread(1); // We prefer uvTexCoords has origin (0,0) at BOTTOM LEFT, per thread since images are also decoded on job workers
 	unsigned char* texelData = stbi_load(imageFilePath, &m_dimensions.x, &m_dimensions.y, &bytesPerTexel, numComponentsRequested);
 	// Check if the load was successful
 	GUARANTEE_OR_DIE(texelData, Stringf("Failed to load image \"%s\"", imageFilePath));
@@ -62,7 +62,7 @@ Job* JobSystem::RetrieveCompletedJob()
 	if (!m_completedJobsList.empty())
 	{
 		completedJob = m_completedJobsList.front();
-		m_completedJobsList.pop();
+		m_completedJobsList.pop_front();
 		completedJob->m_status = JOB_STATUS_RETRIEVED_AND_RETIRED;
 	}
 	m_completedJobsListMutex.unlock();
@@ -91,11 +91,11 @@ void JobSystem::ClearCompletedJobList()
 	m_completedJobsListMutex.lock();
 	for (int completedJobListIndex = 0; completedJobListIndex < (int)m_completedJobsList.size(); ++completedJobListIndex)
 	{
-		Job* currentCompletedJob = m_queuedJobsList.front();
-		m_completedJobsList.pop();
+		Job* currentCompletedJob = m_completedJobsList[completedJobListIndex];
 		delete currentCompletedJob;
 		currentCompletedJob = nullptr;
 	}
+	m_completedJobsList.clear();
 	m_completedJobsListMutex.unlock();
 }
 
@@ -118,6 +118,82 @@ void JobSystem::WaitUntilQueuedJobCompletion()
 }
 
 
+//--------------------------------------------------------------------------------------------------
+void JobSystem::WaitUntilJobsCompleted(std::vector<Job*> const& jobsToWaitOn)
+{
+	for (;;)
+	{
+		bool areAllJobsCompleted = true;
+		for (int jobIndex = 0; jobIndex < (int)jobsToWaitOn.size(); ++jobIndex)
+		{
+			if (jobsToWaitOn[jobIndex]->m_status != JOB_STATUS_COMPLETED)
+			{
+				areAllJobsCompleted = false;
+				break;
+			}
+		}
+		if (areAllJobsCompleted)
+		{
+			break;
+		}
+
+		// Help out instead of idling, the jobs being waited on may still be queued behind other work
+		Job* job = ClaimJob();
+		if (job)
+		{
+			job->Execute();
+			ReportCompletedJob(job);
+		}
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	m_completedJobsListMutex.lock();
+	for (int jobIndex = 0; jobIndex < (int)jobsToWaitOn.size(); ++jobIndex)
+	{
+		Job* jobToRetrieve = jobsToWaitOn[jobIndex];
+		for (int completedJobListIndex = 0; completedJobListIndex < (int)m_completedJobsList.size(); ++completedJobListIndex)
+		{
+			if (m_completedJobsList[completedJobListIndex] == jobToRetrieve)
+			{
+				m_completedJobsList.erase(m_completedJobsList.begin() + completedJobListIndex);
+				break;
+			}
+		}
+		jobToRetrieve->m_status = JOB_STATUS_RETRIEVED_AND_RETIRED;
+	}
+	m_completedJobsListMutex.unlock();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void JobSystem::ExecuteJobsAndWait(JobSystem* jobSystem, std::vector<Job*> const& jobs)
+{
+	if (jobSystem == nullptr || jobs.size() < 2)
+	{
+		for (size_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
+		{
+			jobs[jobIndex]->Execute();
+		}
+		return;
+	}
+	for (size_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
+	{
+		jobSystem->QueueNewJob(jobs[jobIndex]);
+	}
+	jobSystem->WaitUntilJobsCompleted(jobs);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int JobSystem::GetNumOfWorkerThreads() const
+{
+	return (int)m_jobWorkerThreads.size();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void JobSystem::CreateNewWorkerThreads(int numWorkerThreads)
 {
@@ -161,7 +237,7 @@ Job* JobSystem::ClaimJob()
 		m_queuedJobsList.pop();
 		nextJob->m_status = JOB_STATUS_CLAIMED_AND_EXECUTING;
 		m_claimedJobListMutex.lock();
-		m_claimedJobList.push(nextJob);
+		m_claimedJobList.push_back(nextJob);
 		m_claimedJobListMutex.unlock();
 	}
 	m_queuedJobsListMutex.unlock();
@@ -174,7 +250,7 @@ void JobSystem::ReportCompletedJob(Job* job)
 {
 	RemoveCompletedJobFromClaimedList(job);
 	m_completedJobsListMutex.lock();
-	m_completedJobsList.push(job);
+	m_completedJobsList.push_back(job);
 	job->m_status = JOB_STATUS_COMPLETED;
 	m_completedJobsListMutex.unlock();
 }
@@ -186,10 +262,10 @@ void JobSystem::RemoveCompletedJobFromClaimedList(Job* jobToRemove)
 	m_claimedJobListMutex.lock();
 	for (int claimedJobListIndex = 0; claimedJobListIndex < (int)m_claimedJobList.size(); ++claimedJobListIndex)
 	{
-		Job* currentClaimedJob = m_claimedJobList.front();
+		Job* currentClaimedJob = m_claimedJobList[claimedJobListIndex];
 		if (currentClaimedJob == jobToRemove)
 		{
-			m_claimedJobList.pop();
+			m_claimedJobList.erase(m_claimedJobList.begin() + claimedJobListIndex);
 			break;
 			// #ToDo: Do I need to delete the job here as well?
 		}
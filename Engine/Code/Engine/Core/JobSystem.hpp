@@ -4,8 +4,10 @@
 //--------------------------------------------------------------------------------------------------
 #include <vector>
 #include <thread>
+#include <atomic>
 #include <mutex>
 #include <queue>
+#include <deque>
 
 
 //--------------------------------------------------------------------------------------------------
@@ -85,6 +87,9 @@ public:
 	void	ClearQueuedJobList();
 	void	ClearCompletedJobList();
 	void	WaitUntilQueuedJobCompletion();
+	void	WaitUntilJobsCompleted(std::vector<Job*> const& jobsToWaitOn); // Executes queued jobs on the calling thread while it waits, then retrieves the given jobs (caller keeps ownership)
+	static void	ExecuteJobsAndWait(JobSystem* jobSystem, std::vector<Job*> const& jobs); // Queues the batch and waits for it, runs it on the calling thread without a job system or with a single job (caller keeps ownership)
+	int		GetNumOfWorkerThreads() const;
 
 protected:
 	void	CreateNewWorkerThreads(int numWorkerThreads);
@@ -101,9 +106,9 @@ private:
 	std::atomic<bool>				m_isQuitting = false;
 	std::queue<Job*>				m_queuedJobsList;
 	std::mutex						m_queuedJobsListMutex;
-	std::queue<Job*>				m_completedJobsList;
+	std::deque<Job*>				m_completedJobsList;
 	std::mutex						m_completedJobsListMutex;
-	std::queue<Job*>				m_claimedJobList;
+	std::deque<Job*>				m_claimedJobList;
 	std::mutex						m_claimedJobListMutex;
 	std::vector<JobWorkerThread*>	m_jobWorkerThreads;
 	// std::vector<Job*>	m_unclaimedJobsList;
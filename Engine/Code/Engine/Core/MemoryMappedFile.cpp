@@ -0,0 +1,152 @@
+#include "Engine/Core/MemoryMappedFile.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#ifdef _WIN32
+#define PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+MemoryMappedFile::~MemoryMappedFile()
+{
+	Close();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool MemoryMappedFile::Open(std::string const& fileName)
+{
+	Close();
+
+#if defined( PLATFORM_WINDOWS )
+	HANDLE fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	m_fileHandle	=	fileHandle;
+	m_size			=	(size_t)fileSize.QuadPart;
+	m_isOpen		=	true;
+	if (m_size == 0)
+	{
+		// Zero length files cannot be mapped
+		return true;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr)
+	{
+		Close();
+		return false;
+	}
+	m_mappingHandle = mappingHandle;
+
+	m_data = static_cast<unsigned char const*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (m_data == nullptr)
+	{
+		Close();
+		return false;
+	}
+	return true;
+#else
+	int fileDescriptor = open(fileName.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) != 0)
+	{
+		close(fileDescriptor);
+		return false;
+	}
+
+	m_size		=	(size_t)fileStatus.st_size;
+	m_isOpen	=	true;
+	if (m_size > 0)
+	{
+		void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (mapping == MAP_FAILED)
+		{
+			close(fileDescriptor);
+			m_size		=	0;
+			m_isOpen	=	false;
+			return false;
+		}
+		madvise(mapping, m_size, MADV_SEQUENTIAL);
+		m_data = static_cast<unsigned char const*>(mapping);
+	}
+	// The mapping keeps the file alive on its own
+	close(fileDescriptor);
+	return true;
+#endif
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MemoryMappedFile::Close()
+{
+#if defined( PLATFORM_WINDOWS )
+	if (m_data)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mappingHandle)
+	{
+		CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+	}
+	if (m_fileHandle)
+	{
+		CloseHandle(static_cast<HANDLE>(m_fileHandle));
+	}
+#else
+	if (m_data)
+	{
+		munmap(const_cast<unsigned char*>(m_data), m_size);
+	}
+#endif
+
+	m_data			=	nullptr;
+	m_size			=	0;
+	m_isOpen		=	false;
+	m_fileHandle	=	nullptr;
+	m_mappingHandle	=	nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool MemoryMappedFile::IsOpen() const
+{
+	return m_isOpen;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned char const* MemoryMappedFile::GetData() const
+{
+	return m_data;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t MemoryMappedFile::GetSize() const
+{
+	return m_size;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include <string>
+
+
+//--------------------------------------------------------------------------------------------------
+// Read only view of a whole file, the OS pages it in on demand so nothing is copied up front
+class MemoryMappedFile
+{
+public:
+	MemoryMappedFile() {};
+	~MemoryMappedFile();
+	MemoryMappedFile(MemoryMappedFile const& copyFrom) = delete;
+	MemoryMappedFile& operator=(MemoryMappedFile const& copyFrom) = delete;
+
+	bool					Open(std::string const& fileName);	// Returns false if the file could not be opened or mapped, an empty file opens with a null view
+	void					Close();
+	bool					IsOpen() const;
+	unsigned char const*	GetData() const;
+	size_t					GetSize() const;
+
+private:
+	unsigned char const*	m_data				=	nullptr;
+	size_t					m_size				=	0;
+	bool					m_isOpen			=	false;
+	void*					m_fileHandle		=	nullptr;	// HANDLE on Windows
+	void*					m_mappingHandle		=	nullptr;	// HANDLE on Windows
+};
@@ -0,0 +1,455 @@
+#include "Engine/Core/MeshBuilder.hpp"
+#include "Engine/Core/FrameArena.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// Generates a contiguous range of commands straight into their slices of the output
+class MeshBuilderFillJob : public Job
+{
+public:
+	MeshBuilderFillJob(MeshBuilderCommand const* commands, int numOfCommands, Vertex_PCU* out_verts);
+	virtual void Execute() override;
+
+public:
+	MeshBuilderCommand const*	m_commands		=	nullptr;
+	int							m_numOfCommands	=	0;
+	Vertex_PCU*					m_outVerts		=	nullptr;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static void AddVertsForCommand(std::vector<Vertex_PCU>& verts, MeshBuilderCommand const& command)
+{
+	Vec3 const*	points		=	command.m_points;
+	Vec2		startXY		=	Vec2(points[0].x, points[0].y);
+	Vec2		endXY		=	Vec2(points[1].x, points[1].y);
+	switch (command.m_shape)
+	{
+		case MeshBuilderShape::CAPSULE2D:		AddVertsForCapsule2D(verts, startXY, endXY, command.m_values[0], command.m_color);													break;
+		case MeshBuilderShape::DISC2D:			AddVertsForDisc2D(verts, startXY, command.m_values[0], command.m_color);															break;
+		case MeshBuilderShape::RING2D:			AddVertsForRing2D(verts, startXY, command.m_values[0], command.m_values[1], command.m_color);										break;
+		case MeshBuilderShape::AABB2D:			AddVertsForAABB2D(verts, AABB2(startXY, endXY), command.m_color, command.m_UVs);													break;
+		case MeshBuilderShape::LINE_SEGMENT2D:	AddVertsForLineSegment2D(verts, startXY, endXY, command.m_values[0], command.m_color);												break;
+		case MeshBuilderShape::ARROW2D:			AddVertsForArrow2D(verts, startXY, endXY, command.m_values[0], command.m_values[1], command.m_color);								break;
+		case MeshBuilderShape::QUAD3D:			AddVertsForQuad3D(verts, points[0], points[1], points[2], points[3], command.m_color, command.m_UVs);								break;
+		case MeshBuilderShape::AABB3D:			AddVertsForAABB3D(verts, AABB3(points[0], points[1]), command.m_color, command.m_UVs);												break;
+		case MeshBuilderShape::OBB3D:			AddVertsForOBB3D(verts, OBB3(points[0], points[1], points[2], points[3], points[4]), command.m_color, command.m_UVs);				break;
+		case MeshBuilderShape::LINE_SEGMENT3D:	AddVertsForLineSegment3D(verts, points[0], points[1], command.m_values[0], command.m_color);										break;
+		case MeshBuilderShape::SPHERE3D:		AddVertsForSphere3D(verts, points[0], command.m_values[0], command.m_color, command.m_UVs, (int)command.m_values[1]);				break;
+		case MeshBuilderShape::UV_SPHERE_Z3D:	AddVertsForUVSphereZ3D(verts, points[0], points[1].x, points[1].y, points[1].z, command.m_color, command.m_UVs);					break;
+		case MeshBuilderShape::CYLINDER3D:		AddVertsForCylinder3D(verts, points[0], points[1], command.m_values[0], command.m_color, (int)command.m_values[1], command.m_UVs);	break;
+		case MeshBuilderShape::CONE3D:			AddVertsForCone3D(verts, points[0], points[1], command.m_values[0], command.m_color, (int)command.m_values[1], command.m_UVs);		break;
+		case MeshBuilderShape::OBB2D:
+		{
+			OBB2 box;
+			box.m_center			=	startXY;
+			box.m_iBasisNormal		=	endXY;
+			box.m_halfDimensions	=	Vec2(points[2].x, points[2].y);
+			AddVertsForOBB2D(verts, box, command.m_color);
+			break;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+MeshBuilderFillJob::MeshBuilderFillJob(MeshBuilderCommand const* commands, int numOfCommands, Vertex_PCU* out_verts) :
+	m_commands(commands),
+	m_numOfCommands(numOfCommands),
+	m_outVerts(out_verts)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilderFillJob::Execute()
+{
+	// The AddVertsFor* functions append to a vector, so generate into a scratch one sized for the largest command and copy each result into place
+	int maxNumOfVerts = 0;
+	for (int commandIndex = 0; commandIndex < m_numOfCommands; ++commandIndex)
+	{
+		maxNumOfVerts = m_commands[commandIndex].m_numOfVerts > maxNumOfVerts ? m_commands[commandIndex].m_numOfVerts : maxNumOfVerts;
+	}
+	std::vector<Vertex_PCU> scratchVerts;
+	scratchVerts.reserve(maxNumOfVerts);
+
+	for (int commandIndex = 0; commandIndex < m_numOfCommands; ++commandIndex)
+	{
+		MeshBuilderCommand const& command = m_commands[commandIndex];
+		scratchVerts.clear();
+		AddVertsForCommand(scratchVerts, command);
+		ASSERT_OR_DIE((int)scratchVerts.size() == command.m_numOfVerts, "GetVertCountFor* does not match what AddVertsFor* generated");
+		memcpy(m_outVerts + command.m_firstVertIndex, scratchVerts.data(), sizeof(Vertex_PCU) * scratchVerts.size());
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::Clear()
+{
+	m_commands.clear();
+	m_numOfVerts = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int MeshBuilder::GetNumOfVerts() const
+{
+	return m_numOfVerts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int MeshBuilder::GetNumOfCommands() const
+{
+	return (int)m_commands.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<MeshBuilderCommand> const& MeshBuilder::GetCommands() const
+{
+	return m_commands;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+MeshBuilderCommand& MeshBuilder::AddCommand(MeshBuilderShape shape, Rgba8 const& color, int numOfVerts)
+{
+	m_commands.emplace_back();
+	MeshBuilderCommand& command	=	m_commands.back();
+	command.m_shape				=	shape;
+	command.m_color				=	color;
+	command.m_firstVertIndex	=	m_numOfVerts;
+	command.m_numOfVerts		=	numOfVerts;
+	m_numOfVerts				+=	numOfVerts;
+	return command;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddCapsule2D(Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::CAPSULE2D, color, GetVertCountForCapsule2D());
+	command.m_points[0]			=	Vec3(boneStart.x, boneStart.y, 0.f);
+	command.m_points[1]			=	Vec3(boneEnd.x, boneEnd.y, 0.f);
+	command.m_values[0]			=	radius;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddDisc2D(Vec2 const& center, float radius, Rgba8 const& color)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::DISC2D, color, GetVertCountForDisc2D());
+	command.m_points[0]			=	Vec3(center.x, center.y, 0.f);
+	command.m_values[0]			=	radius;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddRing2D(Vec2 const& center, float radius, float thickness, Rgba8 const& color)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::RING2D, color, GetVertCountForRing2D());
+	command.m_points[0]			=	Vec3(center.x, center.y, 0.f);
+	command.m_values[0]			=	radius;
+	command.m_values[1]			=	thickness;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddAABB2D(AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::AABB2D, color, GetVertCountForAABB2D());
+	command.m_points[0]			=	Vec3(bounds.m_mins.x, bounds.m_mins.y, 0.f);
+	command.m_points[1]			=	Vec3(bounds.m_maxs.x, bounds.m_maxs.y, 0.f);
+	command.m_UVs				=	UVs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddOBB2D(OBB2 const& box, Rgba8 const& color)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::OBB2D, color, GetVertCountForOBB2D());
+	command.m_points[0]			=	Vec3(box.m_center.x, box.m_center.y, 0.f);
+	command.m_points[1]			=	Vec3(box.m_iBasisNormal.x, box.m_iBasisNormal.y, 0.f);
+	command.m_points[2]			=	Vec3(box.m_halfDimensions.x, box.m_halfDimensions.y, 0.f);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddLineSegment2D(Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::LINE_SEGMENT2D, color, GetVertCountForLineSegment2D());
+	command.m_points[0]			=	Vec3(start.x, start.y, 0.f);
+	command.m_points[1]			=	Vec3(end.x, end.y, 0.f);
+	command.m_values[0]			=	thickness;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddArrow2D(Vec2 const& tailPos, Vec2 const& tipPos, float arrowSize, float lineThickness, Rgba8 const& color)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::ARROW2D, color, GetVertCountForArrow2D());
+	command.m_points[0]			=	Vec3(tailPos.x, tailPos.y, 0.f);
+	command.m_points[1]			=	Vec3(tipPos.x, tipPos.y, 0.f);
+	command.m_values[0]			=	arrowSize;
+	command.m_values[1]			=	lineThickness;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddQuad3D(Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, Rgba8 const& color, AABB2 const& UVs)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::QUAD3D, color, GetVertCountForQuad3D());
+	command.m_points[0]			=	bottomLeft;
+	command.m_points[1]			=	bottomRight;
+	command.m_points[2]			=	topRight;
+	command.m_points[3]			=	topLeft;
+	command.m_UVs				=	UVs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddAABB3D(AABB3 const& bounds, Rgba8 const& color, AABB2 const& UVs)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::AABB3D, color, GetVertCountForAABB3D());
+	command.m_points[0]			=	bounds.m_mins;
+	command.m_points[1]			=	bounds.m_maxs;
+	command.m_UVs				=	UVs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddOBB3D(OBB3 const& box, Rgba8 const& color, AABB2 const& UVs)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::OBB3D, color, GetVertCountForOBB3D());
+	command.m_points[0]			=	box.m_center;
+	command.m_points[1]			=	box.m_iBasis;
+	command.m_points[2]			=	box.m_jBasis;
+	command.m_points[3]			=	box.m_kBasis;
+	command.m_points[4]			=	box.m_halfDims;
+	command.m_UVs				=	UVs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddLineSegment3D(Vec3 const& start, Vec3 const& end, float thickness, Rgba8 const& color)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::LINE_SEGMENT3D, color, GetVertCountForLineSegment3D());
+	command.m_points[0]			=	start;
+	command.m_points[1]			=	end;
+	command.m_values[0]			=	thickness;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddSphere3D(Vec3 const& center, float radius, Rgba8 const& color, AABB2 const& UVs, int numLatitudeSlices)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::SPHERE3D, color, GetVertCountForSphere3D(numLatitudeSlices));
+	command.m_points[0]			=	center;
+	command.m_values[0]			=	radius;
+	command.m_values[1]			=	(float)numLatitudeSlices;
+	command.m_UVs				=	UVs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddUVSphereZ3D(Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::UV_SPHERE_Z3D, tint, GetVertCountForUVSphereZ3D(numSlices, numStacks));
+	command.m_points[0]			=	center;
+	command.m_points[1]			=	Vec3(radius, numSlices, numStacks);
+	command.m_UVs				=	UVs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddCylinder3D(Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color, int numSlices, AABB2 const& UVs)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::CYLINDER3D, color, GetVertCountForCylinder3D(numSlices));
+	command.m_points[0]			=	start;
+	command.m_points[1]			=	end;
+	command.m_values[0]			=	radius;
+	command.m_values[1]			=	(float)numSlices;
+	command.m_UVs				=	UVs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddCone3D(Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color, int numSlices, AABB2 const& UVs)
+{
+	MeshBuilderCommand& command	=	AddCommand(MeshBuilderShape::CONE3D, color, GetVertCountForCone3D(numSlices));
+	command.m_points[0]			=	start;
+	command.m_points[1]			=	end;
+	command.m_values[0]			=	radius;
+	command.m_values[1]			=	(float)numSlices;
+	command.m_UVs				=	UVs;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::AddShapes(MeshBuilder const& shapes, Rgba8 const& color)
+{
+	int numOfCommands = (int)shapes.m_commands.size();
+	m_commands.reserve(m_commands.size() + numOfCommands);
+	for (int commandIndex = 0; commandIndex < numOfCommands; ++commandIndex)
+	{
+		m_commands.push_back(shapes.m_commands[commandIndex]);
+		MeshBuilderCommand& command	=	m_commands.back();
+		command.m_color				=	color;
+		command.m_firstVertIndex	=	m_numOfVerts;
+		m_numOfVerts				+=	command.m_numOfVerts;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Vertex_PCU* MeshBuilder::Build(FrameArena& frameArena) const
+{
+	Vertex_PCU* verts = frameArena.AllocateArray<Vertex_PCU>((size_t)m_numOfVerts);
+	BuildInto(verts);
+	return verts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::Build(std::vector<Vertex_PCU>& verts) const
+{
+	size_t firstVertIndex = verts.size();
+	verts.resize(firstVertIndex + (size_t)m_numOfVerts);
+	BuildInto(verts.data() + firstVertIndex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void MeshBuilder::BuildInto(Vertex_PCU* out_verts) const
+{
+	if (m_commands.empty())
+	{
+		return;
+	}
+
+	int numOfThreads	=	g_theJobSystem ? g_theJobSystem->GetNumOfWorkerThreads() + 1 : 1;
+	int numOfJobs		=	(m_numOfVerts + MESH_BUILDER_MIN_VERTS_PER_JOB - 1) / MESH_BUILDER_MIN_VERTS_PER_JOB;
+	numOfJobs			=	numOfJobs < numOfThreads ? numOfJobs : numOfThreads;
+	numOfJobs			=	numOfJobs > 0 ? numOfJobs : 1;
+
+	// Split on command boundaries so every job gets roughly the same number of verts
+	std::vector<Job*> jobs;
+	jobs.reserve(numOfJobs);
+	int vertsPerJob		=	(m_numOfVerts + numOfJobs - 1) / numOfJobs;
+	int numOfCommands	=	(int)m_commands.size();
+	int firstCommand	=	0;
+	while (firstCommand < numOfCommands)
+	{
+		int lastCommand = firstCommand;
+		int jobVertsEnd = m_commands[firstCommand].m_firstVertIndex + vertsPerJob;
+		while (lastCommand + 1 < numOfCommands && m_commands[lastCommand + 1].m_firstVertIndex < jobVertsEnd)
+		{
+			++lastCommand;
+		}
+		jobs.push_back(new MeshBuilderFillJob(m_commands.data() + firstCommand, lastCommand - firstCommand + 1, out_verts));
+		firstCommand = lastCommand + 1;
+	}
+
+	JobSystem::ExecuteJobsAndWait(g_theJobSystem, jobs);
+
+	for (size_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
+	{
+		delete jobs[jobIndex];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Records one frame of shapes, cycling through a debug / UI style mix
+static void RecordBenchmarkShapes(MeshBuilder& builder, int numOfShapes)
+{
+	for (int shapeIndex = 0; shapeIndex < numOfShapes; ++shapeIndex)
+	{
+		Vec3	position	=	Vec3((float)(shapeIndex % 64), (float)(shapeIndex / 64), (float)(shapeIndex % 5));
+		Vec2	position2D	=	Vec2(position.x, position.y);
+		Rgba8	color		=	Rgba8((unsigned char)shapeIndex, 128, 255, 255);
+		switch (shapeIndex % 8)
+		{
+			case 0:	builder.AddAABB2D(AABB2(position2D, position2D + Vec2(2.f, 1.f)), color);				break;
+			case 1:	builder.AddLineSegment2D(position2D, position2D + Vec2(3.f, 1.f), 0.1f, color);		break;
+			case 2:	builder.AddDisc2D(position2D, 0.5f, color);											break;
+			case 3:	builder.AddArrow2D(position2D, position2D + Vec2(1.f, 2.f), 0.3f, 0.05f, color);		break;
+			case 4:	builder.AddAABB3D(AABB3(position, position + Vec3(1.f, 1.f, 1.f)), color);			break;
+			case 5:	builder.AddUVSphereZ3D(position, 0.5f, 16.f, 8.f, color);							break;
+			case 6:	builder.AddCylinder3D(position, position + Vec3(0.f, 0.f, 2.f), 0.2f, color);			break;
+			case 7:	builder.AddCone3D(position, position + Vec3(1.f, 0.f, 0.f), 0.3f, color);			break;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Command_MeshBuilderBenchmark(EventArgs& args)
+{
+	int numOfShapes	=	args.GetValue("Shapes", 8192);
+	int numOfFrames	=	args.GetValue("Frames", 32);
+	if (numOfShapes < 1 || numOfFrames < 1)
+	{
+		return false;
+	}
+
+	// Before: a fresh vector every frame filled by the AddVertsFor* calls in order, the way DebugRender and the UI build their geometry
+	MeshBuilder recordedShapes;
+	RecordBenchmarkShapes(recordedShapes, numOfShapes);
+	std::vector<MeshBuilderCommand> const& commands = recordedShapes.GetCommands();
+
+	std::vector<Vertex_PCU> appendedVerts;
+	int		numOfRegrowths		=	0;
+	double	appendSeconds		=	0.0;
+	for (int frameIndex = 0; frameIndex < numOfFrames; ++frameIndex)
+	{
+		appendedVerts		=	std::vector<Vertex_PCU>();
+		numOfRegrowths		=	0;
+		double timeBefore	=	GetCurrentTimeSeconds();
+		for (size_t commandIndex = 0; commandIndex < commands.size(); ++commandIndex)
+		{
+			size_t capacityBefore = appendedVerts.capacity();
+			AddVertsForCommand(appendedVerts, commands[commandIndex]);
+			numOfRegrowths += appendedVerts.capacity() != capacityBefore ? 1 : 0;
+		}
+		appendSeconds += GetCurrentTimeSeconds() - timeBefore;
+	}
+
+	// After: record, then build once into the frame arena
+	FrameArena	frameArena;
+	MeshBuilder	builder;
+	Vertex_PCU*	builtVerts		=	nullptr;
+	double		builderSeconds	=	0.0;
+	for (int frameIndex = 0; frameIndex < numOfFrames; ++frameIndex)
+	{
+		double timeBefore = GetCurrentTimeSeconds();
+		frameArena.BeginFrame();
+		builder.Clear();
+		RecordBenchmarkShapes(builder, numOfShapes);
+		builtVerts = builder.Build(frameArena);
+		builderSeconds += GetCurrentTimeSeconds() - timeBefore;
+	}
+
+	bool isIdentical = (int)appendedVerts.size() == builder.GetNumOfVerts() && memcmp(appendedVerts.data(), builtVerts, sizeof(Vertex_PCU) * appendedVerts.size()) == 0;
+	std::string timingResult	=	Stringf("MeshBuilder: %d shapes, %d verts per frame, AddVertsFor* %.3f ms (%d regrowths), MeshBuilder %.3f ms (%.2fx)", numOfShapes, builder.GetNumOfVerts(), 1000.0 * appendSeconds / numOfFrames, numOfRegrowths, 1000.0 * builderSeconds / numOfFrames, appendSeconds / builderSeconds);
+	std::string checkResult		=	Stringf("MeshBuilder: output %s, arena capacity %d KB", isIdentical ? "identical" : "DIFFERENT", (int)(frameArena.GetCapacityBytes() / 1024));
+	DebuggerPrintf("\n%s\n%s\n", timingResult.c_str(), checkResult.c_str());
+	if (g_theDevConsole)
+	{
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, timingResult);
+		g_theDevConsole->AddLine(isIdentical ? DevConsole::INFO_MINOR : DevConsole::ERROR, checkResult);
+	}
+	return true;
+}
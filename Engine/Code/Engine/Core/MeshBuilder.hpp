@@ -0,0 +1,112 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/OBB2.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/AABB3.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+class FrameArena;
+
+
+//--------------------------------------------------------------------------------------------------
+// Batches smaller than this fill on the calling thread
+constexpr int MESH_BUILDER_MIN_VERTS_PER_JOB = 16384;
+
+
+//--------------------------------------------------------------------------------------------------
+enum class MeshBuilderShape : unsigned char
+{
+	CAPSULE2D,
+	DISC2D,
+	RING2D,
+	AABB2D,
+	OBB2D,
+	LINE_SEGMENT2D,
+	ARROW2D,
+	QUAD3D,
+	AABB3D,
+	OBB3D,
+	LINE_SEGMENT3D,
+	SPHERE3D,
+	UV_SPHERE_Z3D,
+	CYLINDER3D,
+	CONE3D,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Arguments of one recorded AddVertsFor* call, m_points and m_values are laid out per shape by the MeshBuilder::Add* functions
+struct MeshBuilderCommand
+{
+	MeshBuilderShape	m_shape				=	MeshBuilderShape::AABB2D;
+	Rgba8				m_color;
+	AABB2				m_UVs				=	AABB2::ZERO_TO_ONE;
+	Vec3				m_points[5];
+	float				m_values[2]			=	{ };
+	int					m_firstVertIndex	=	0;
+	int					m_numOfVerts		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Records a batch of non indexed PCU shapes, then generates them all at once
+// Every Add* knows its exact vert count through the GetVertCountFor* companions, so Build allocates the output exactly once
+// and each job fills its own slice of it with the regular AddVertsFor* functions, the output matches calling them in order
+class MeshBuilder
+{
+public:
+	MeshBuilder() {};
+	~MeshBuilder() {};
+
+	void	Clear();
+	int		GetNumOfVerts() const;
+	int		GetNumOfCommands() const;
+	std::vector<MeshBuilderCommand> const&	GetCommands() const;
+
+	void	AddCapsule2D(Vec2 const& boneStart, Vec2 const& boneEnd, float radius, Rgba8 const& color);
+	void	AddDisc2D(Vec2 const& center, float radius, Rgba8 const& color);
+	void	AddRing2D(Vec2 const& center, float radius, float thickness, Rgba8 const& color);
+	void	AddAABB2D(AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddOBB2D(OBB2 const& box, Rgba8 const& color);
+	void	AddLineSegment2D(Vec2 const& start, Vec2 const& end, float thickness, Rgba8 const& color);
+	void	AddArrow2D(Vec2 const& tailPos, Vec2 const& tipPos, float arrowSize, float lineThickness, Rgba8 const& color);
+	void	AddQuad3D(Vec3 const& bottomLeft, Vec3 const& bottomRight, Vec3 const& topRight, Vec3 const& topLeft, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddAABB3D(AABB3 const& bounds, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddOBB3D(OBB3 const& box, Rgba8 const& color, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddLineSegment3D(Vec3 const& start, Vec3 const& end, float thickness, Rgba8 const& color);
+	void	AddSphere3D(Vec3 const& center, float radius, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE, int numLatitudeSlices = 8);
+	void	AddUVSphereZ3D(Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddCylinder3D(Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	void	AddCone3D(Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+	// Appends every command of shapes with its color replaced, for recorded shapes whose tint changes from frame to frame
+	void	AddShapes(MeshBuilder const& shapes, Rgba8 const& color);
+
+	// Returns GetNumOfVerts() verts allocated from frameArena, valid until its next BeginFrame
+	Vertex_PCU*	Build(FrameArena& frameArena) const;
+	// Appends to verts with a single resize
+	void		Build(std::vector<Vertex_PCU>& verts) const;
+	// Fills exactly GetNumOfVerts() verts, splitting the commands across g_theJobSystem when there are enough of them
+	void		BuildInto(Vertex_PCU* out_verts) const;
+
+private:
+	MeshBuilderCommand&	AddCommand(MeshBuilderShape shape, Rgba8 const& color, int numOfVerts);
+
+private:
+	std::vector<MeshBuilderCommand>	m_commands;
+	int								m_numOfVerts	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_MeshBuilderBenchmark(EventArgs& args);
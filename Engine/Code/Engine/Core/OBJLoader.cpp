@@ -1,628 +1,1713 @@
 #include "Engine/Core/Time.hpp"
 #include "Engine/Core/FileUtils.hpp"
 #include "Engine/Core/OBJLoader.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/CookedMesh.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 
 
 //--------------------------------------------------------------------------------------------------
-void OBJLoader::LoadOBJFileByName(std::string const& fileName, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes, Mat44 const& transformFixUpMat)
+#include <charconv>
+#include <string.h>
+#include <filesystem>
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------------------------
+// Tokenizer helpers, they all work on the raw file bytes and never allocate
+// '\r' is treated like any other horizontal space so CRLF files need no special handling
+static bool IsHorizontalSpace(char character)
+{
+	return character == ' ' || character == '\t' || character == '\r';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static char const* SkipHorizontalSpace(char const* cursor, char const* end)
+{
+	while (cursor < end && IsHorizontalSpace(*cursor))
+	{
+		++cursor;
+	}
+	return cursor;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Returns the start of the next line
+static char const* SkipLine(char const* cursor, char const* end)
+{
+	char const* newLine = static_cast<char const*>(memchr(cursor, '\n', (size_t)(end - cursor)));
+	return newLine ? newLine + 1 : end;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool IsDigit(char character)
+{
+	return character >= '0' && character <= '9';
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Leaves out_value untouched and returns cursor if there is no number there
+// Exporters write plain decimals like "-12.345678", those are read here as an integer mantissa scaled by an exact power of ten,
+// which gives the same correctly rounded double from_chars would (both values are exact doubles). Anything longer, or with an exponent,
+// goes through from_chars. Going through double matches what the old atof based loader produced
+static char const* ParseFloat(char const* cursor, char const* end, float& out_value)
+{
+	static double const EXACT_POWERS_OF_TEN[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15 };
+
+	cursor = SkipHorizontalSpace(cursor, end);
+	char const* numberStart	=	(cursor < end && *cursor == '+') ? cursor + 1 : cursor;
+	char const* digit		=	numberStart;
+	bool		isNegative	=	digit < end && *digit == '-';
+	digit += isNegative ? 1 : 0;
+
+	uint64_t	mantissa		=	0;
+	int			numOfDigits		=	0;
+	int			numOfDecimals	=	0;
+	while (digit < end && IsDigit(*digit))
+	{
+		mantissa = mantissa * 10 + uint64_t(*digit++ - '0');
+		++numOfDigits;
+	}
+	if (digit < end && *digit == '.')
+	{
+		++digit;
+		while (digit < end && IsDigit(*digit))
+		{
+			mantissa = mantissa * 10 + uint64_t(*digit++ - '0');
+			++numOfDigits;
+			++numOfDecimals;
+		}
+	}
+
+	bool hasExponent = digit < end && (*digit == 'e' || *digit == 'E');
+	if (numOfDigits > 0 && numOfDigits <= 15 && !hasExponent)
+	{
+		double value	=	(double)mantissa / EXACT_POWERS_OF_TEN[numOfDecimals];
+		out_value		=	(float)(isNegative ? -value : value);
+		return digit;
+	}
+
+	double value = 0.0;
+	std::from_chars_result result = std::from_chars(numberStart, end, value);
+	if (result.ptr == numberStart)
+	{
+		return cursor;
+	}
+	out_value = (float)value;
+	return result.ptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Face indexes are short, so this is a plain digit loop, anything with more than 9 digits goes through from_chars for the overflow check
+static char const* ParseInt(char const* cursor, char const* end, int& out_value)
+{
+	char const* numberStart	=	(cursor < end && *cursor == '+') ? cursor + 1 : cursor;
+	char const* digit		=	numberStart;
+	bool		isNegative	=	digit < end && *digit == '-';
+	digit += isNegative ? 1 : 0;
+
+	char const*	firstDigit	=	digit;
+	int			value		=	0;
+	while (digit < end && IsDigit(*digit) && digit - firstDigit < 9)
+	{
+		value = value * 10 + (*digit++ - '0');
+	}
+	if (digit == firstDigit)
+	{
+		return cursor;
+	}
+	if (digit < end && IsDigit(*digit))
+	{
+		std::from_chars_result result = std::from_chars(numberStart, end, out_value);
+		return result.ptr;
+	}
+	out_value = isNegative ? -value : value;
+	return digit;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// OBJ indexes are one based, negative ones count back from the last element defined so far and 0 means "not there"
+static int ResolveOBJIndex(int objIndex, size_t numOfElementsSoFar)
+{
+	int index = objIndex > 0 ? objIndex - 1 : (int)numOfElementsSoFar + objIndex;
+	if (objIndex == 0 || index < 0 || index >= (int)numOfElementsSoFar)
+	{
+		return -1;
+	}
+	return index;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The rest of the line without surrounding spaces, for names. Returns where the line ends
+static char const* ParseRestOfLine(char const* cursor, char const* end, char const*& out_start, size_t& out_length)
+{
+	cursor = SkipHorizontalSpace(cursor, end);
+	char const* lineEnd		=	static_cast<char const*>(memchr(cursor, '\n', (size_t)(end - cursor)));
+	lineEnd					=	lineEnd ? lineEnd : end;
+	char const* textEnd		=	lineEnd;
+	while (textEnd > cursor && IsHorizontalSpace(textEnd[-1]))
+	{
+		--textEnd;
+	}
+	out_start	=	cursor;
+	out_length	=	(size_t)(textEnd - cursor);
+	return lineEnd;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Materials are few, a linear search beats hashing every usemtl line
+static int FindOrAddMaterialName(std::vector<std::string>& materialNames, char const* name, size_t nameLength)
+{
+	for (size_t materialIndex = 0; materialIndex < materialNames.size(); ++materialIndex)
+	{
+		std::string const& materialName = materialNames[materialIndex];
+		if (materialName.size() == nameLength && memcmp(materialName.data(), name, nameLength) == 0)
+		{
+			return (int)materialIndex;
+		}
+	}
+	materialNames.emplace_back(name, nameLength);
+	return (int)materialNames.size() - 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Starts a material range at the next face, a range that got no faces yet is simply retargeted
+static void UseMaterial(std::vector<OBJMaterialRange>& materialRanges, int materialIndex, size_t numOfFacesSoFar)
+{
+	if (!materialRanges.empty() && materialRanges.back().m_firstFace == (unsigned int)numOfFacesSoFar)
+	{
+		materialRanges.back().m_materialIndex = materialIndex;
+		return;
+	}
+	OBJMaterialRange materialRange;
+	materialRange.m_materialIndex	=	materialIndex;
+	materialRange.m_firstFace		=	(unsigned int)numOfFacesSoFar;
+	materialRanges.push_back(materialRange);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// While parsing only m_firstFace of a range is known, this fills in the face counts once all faces are in,
+// merges neighbors that use the same material and puts the faces before the first usemtl into a range of their own
+// Names no face ended up using are dropped, so the serial and the parallel parse agree on the names whatever the chunking
+static void FinalizeMaterialRanges(OBJMeshData& meshData)
+{
+	std::vector<OBJMaterialRange>&	materialRanges	=	meshData.m_materialRanges;
+	unsigned int					numOfFaces		=	(unsigned int)meshData.m_faceFirstCorners.size();
+	if (numOfFaces == 0)
+	{
+		materialRanges.clear();
+		meshData.m_materialNames.clear();
+		return;
+	}
+	if (materialRanges.empty() || materialRanges[0].m_firstFace != 0)
+	{
+		materialRanges.insert(materialRanges.begin(), OBJMaterialRange());
+	}
+
+	size_t numOfMergedRanges = 0;
+	for (size_t rangeIndex = 0; rangeIndex < materialRanges.size(); ++rangeIndex)
+	{
+		OBJMaterialRange	materialRange	=	materialRanges[rangeIndex];
+		unsigned int		faceEnd			=	rangeIndex + 1 < materialRanges.size() ? materialRanges[rangeIndex + 1].m_firstFace : numOfFaces;
+		materialRange.m_numOfFaces			=	faceEnd - materialRange.m_firstFace;
+		if (materialRange.m_numOfFaces == 0)
+		{
+			continue;
+		}
+		if (numOfMergedRanges > 0 && materialRanges[numOfMergedRanges - 1].m_materialIndex == materialRange.m_materialIndex)
+		{
+			materialRanges[numOfMergedRanges - 1].m_numOfFaces += materialRange.m_numOfFaces;
+			continue;
+		}
+		materialRanges[numOfMergedRanges++] = materialRange;
+	}
+	materialRanges.resize(numOfMergedRanges);
+
+	std::vector<int>			newMaterialIndexes(meshData.m_materialNames.size(), -1);
+	std::vector<std::string>	usedMaterialNames;
+	for (size_t rangeIndex = 0; rangeIndex < materialRanges.size(); ++rangeIndex)
+	{
+		int& materialIndex = materialRanges[rangeIndex].m_materialIndex;
+		if (materialIndex < 0)
+		{
+			continue;
+		}
+		if (newMaterialIndexes[materialIndex] < 0)
+		{
+			newMaterialIndexes[materialIndex] = (int)usedMaterialNames.size();
+			usedMaterialNames.push_back(meshData.m_materialNames[materialIndex]);
+		}
+		materialIndex = newMaterialIndexes[materialIndex];
+	}
+	meshData.m_materialNames.swap(usedMaterialNames);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+enum OBJRecordType
+{
+	OBJ_RECORD_UNKNOWN,
+	OBJ_RECORD_POSITION,
+	OBJ_RECORD_UV,
+	OBJ_RECORD_NORMAL,
+	OBJ_RECORD_FACE,
+	OBJ_RECORD_USE_MATERIAL,
+	OBJ_RECORD_MATERIAL_LIBRARY,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// cursor is the first non space character of a line, out_recordData is set to just past the keyword
+static OBJRecordType ClassifyOBJLine(char const* cursor, char const* end, char const*& out_recordData)
+{
+	if (cursor + 1 >= end)
+	{
+		return OBJ_RECORD_UNKNOWN;
+	}
+
+	char firstChar	=	cursor[0];
+	char secondChar	=	cursor[1];
+	if (firstChar == 'v' && IsHorizontalSpace(secondChar))
+	{
+		out_recordData = cursor + 2;
+		return OBJ_RECORD_POSITION;
+	}
+	if (firstChar == 'v' && (secondChar == 't' || secondChar == 'n') && cursor + 2 < end && IsHorizontalSpace(cursor[2]))
+	{
+		out_recordData = cursor + 3;
+		return secondChar == 't' ? OBJ_RECORD_UV : OBJ_RECORD_NORMAL;
+	}
+	if (firstChar == 'f' && IsHorizontalSpace(secondChar))
+	{
+		out_recordData = cursor + 2;
+		return OBJ_RECORD_FACE;
+	}
+	if ((firstChar == 'u' || firstChar == 'm') && cursor + 6 < end && IsHorizontalSpace(cursor[6]))
+	{
+		out_recordData = cursor + 7;
+		if (memcmp(cursor, "usemtl", 6) == 0)
+		{
+			return OBJ_RECORD_USE_MATERIAL;
+		}
+		if (memcmp(cursor, "mtllib", 6) == 0)
+		{
+			return OBJ_RECORD_MATERIAL_LIBRARY;
+		}
+	}
+	return OBJ_RECORD_UNKNOWN;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Where the serial parse puts records, straight into the OBJMeshData
+struct OBJMeshDataSink
+{
+	explicit OBJMeshDataSink(OBJMeshData& meshData) :
+		m_meshData(meshData),
+		m_faceCorners(meshData.m_faceCorners),
+		m_faceFirstCorners(meshData.m_faceFirstCorners)
+	{
+	}
+
+	void	AddPosition(Vec3 const& position)	{ m_meshData.m_positions.push_back(position); }
+	void	AddUV(Vec2 const& uv)				{ m_meshData.m_uvs.push_back(uv); }
+	void	AddNormal(Vec3 const& normal)		{ m_meshData.m_normals.push_back(normal); }
+	void	AddMaterialLibrary(char const* fileName, size_t fileNameLength)	{ m_meshData.m_materialLibraries.emplace_back(fileName, fileNameLength); }
+	void	UseMaterial(char const* name, size_t nameLength)				{ ::UseMaterial(m_meshData.m_materialRanges, FindOrAddMaterialName(m_meshData.m_materialNames, name, nameLength), m_faceFirstCorners.size()); }
+	size_t	GetNumOfPositions() const			{ return m_meshData.m_positions.size(); }
+	size_t	GetNumOfUVs() const					{ return m_meshData.m_uvs.size(); }
+	size_t	GetNumOfNormals() const				{ return m_meshData.m_normals.size(); }
+
+	OBJMeshData&				m_meshData;
+	std::vector<OBJFaceCorner>&	m_faceCorners;
+	std::vector<unsigned int>&	m_faceFirstCorners;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// A line aligned piece of the file for the parallel parse
+// The count pass fills in the m_numOf* counts, their prefix sums give each chunk the m_first* slots its attributes are written to,
+// so attribute order and the "defined so far" counts used to resolve indexes are exactly what the serial parse sees
+// Faces are collected per chunk with chunk relative first corners, then copied behind the previous chunks' faces
+// Material ranges use chunk relative faces and the chunk's own material names until they are merged in chunk order
+struct OBJTextChunk
+{
+	char const*					m_start					=	nullptr;
+	char const*					m_end					=	nullptr;
+	size_t						m_numOfPositions		=	0;
+	size_t						m_numOfUVs				=	0;
+	size_t						m_numOfNormals			=	0;
+	size_t						m_firstPosition			=	0;
+	size_t						m_firstUV				=	0;
+	size_t						m_firstNormal			=	0;
+	size_t						m_firstFace				=	0;
+	size_t						m_firstFaceCorner		=	0;
+	std::vector<OBJFaceCorner>		m_faceCorners;
+	std::vector<unsigned int>		m_faceFirstCorners;
+	std::vector<std::string>		m_materialLibraries;
+	std::vector<std::string>		m_materialNames;
+	std::vector<OBJMaterialRange>	m_materialRanges;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Where a chunk of the parallel parse puts records, attributes go into the slots reserved for the chunk
+struct OBJTextChunkSink
+{
+	OBJTextChunkSink(OBJTextChunk& chunk, OBJMeshData& meshData) :
+		m_positions(meshData.m_positions.data()),
+		m_uvs(meshData.m_uvs.data()),
+		m_normals(meshData.m_normals.data()),
+		m_numOfPositions(chunk.m_firstPosition),
+		m_numOfUVs(chunk.m_firstUV),
+		m_numOfNormals(chunk.m_firstNormal),
+		m_faceCorners(chunk.m_faceCorners),
+		m_faceFirstCorners(chunk.m_faceFirstCorners),
+		m_chunk(chunk)
+	{
+	}
+
+	void	AddPosition(Vec3 const& position)	{ m_positions[m_numOfPositions++] = position; }
+	void	AddUV(Vec2 const& uv)				{ m_uvs[m_numOfUVs++] = uv; }
+	void	AddNormal(Vec3 const& normal)		{ m_normals[m_numOfNormals++] = normal; }
+	void	AddMaterialLibrary(char const* fileName, size_t fileNameLength)	{ m_chunk.m_materialLibraries.emplace_back(fileName, fileNameLength); }
+	void	UseMaterial(char const* name, size_t nameLength)				{ ::UseMaterial(m_chunk.m_materialRanges, FindOrAddMaterialName(m_chunk.m_materialNames, name, nameLength), m_faceFirstCorners.size()); }
+	size_t	GetNumOfPositions() const			{ return m_numOfPositions; }
+	size_t	GetNumOfUVs() const					{ return m_numOfUVs; }
+	size_t	GetNumOfNormals() const				{ return m_numOfNormals; }
+
+	Vec3*						m_positions			=	nullptr;
+	Vec2*						m_uvs				=	nullptr;
+	Vec3*						m_normals			=	nullptr;
+	size_t						m_numOfPositions	=	0;
+	size_t						m_numOfUVs			=	0;
+	size_t						m_numOfNormals		=	0;
+	std::vector<OBJFaceCorner>&	m_faceCorners;
+	std::vector<unsigned int>&	m_faceFirstCorners;
+	OBJTextChunk&				m_chunk;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Parses one "f" line starting right after the keyword, returns where parsing stopped
+template <typename OBJRecordSink>
+static char const* ParseFace(char const* cursor, char const* end, OBJRecordSink& sink)
+{
+	size_t	firstCorner			=	sink.m_faceCorners.size();
+	bool	hasInvalidPosition	=	false;
+	while (true)
+	{
+		cursor = SkipHorizontalSpace(cursor, end);
+		if (cursor >= end || *cursor == '\n')
+		{
+			break;
+		}
+
+		// position[/[uv][/normal]]
+		int objPositionIndex	=	0;
+		int objUVIndex			=	0;
+		int objNormalIndex		=	0;
+		char const* tokenEnd	=	ParseInt(cursor, end, objPositionIndex);
+		if (tokenEnd < end && *tokenEnd == '/')
+		{
+			tokenEnd = ParseInt(tokenEnd + 1, end, objUVIndex);
+			if (tokenEnd < end && *tokenEnd == '/')
+			{
+				tokenEnd = ParseInt(tokenEnd + 1, end, objNormalIndex);
+			}
+		}
+		// Skip whatever is left of a malformed token
+		while (tokenEnd < end && !IsHorizontalSpace(*tokenEnd) && *tokenEnd != '\n')
+		{
+			++tokenEnd;
+		}
+		cursor = tokenEnd;
+
+		OBJFaceCorner corner;
+		corner.m_positionIndex	=	ResolveOBJIndex(objPositionIndex, sink.GetNumOfPositions());
+		corner.m_uvIndex		=	ResolveOBJIndex(objUVIndex, sink.GetNumOfUVs());
+		corner.m_normalIndex	=	ResolveOBJIndex(objNormalIndex, sink.GetNumOfNormals());
+		hasInvalidPosition		|=	corner.m_positionIndex < 0;
+		sink.m_faceCorners.push_back(corner);
+	}
+
+	// Points, lines and faces pointing at missing positions are dropped
+	if (hasInvalidPosition || sink.m_faceCorners.size() - firstCorner < 3)
+	{
+		sink.m_faceCorners.resize(firstCorner);
+	}
+	else
+	{
+		sink.m_faceFirstCorners.push_back((unsigned int)firstCorner);
+	}
+	return cursor;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename OBJRecordSink>
+static void ParseOBJLines(char const* cursor, char const* end, OBJRecordSink& sink)
+{
+	while (cursor < end)
+	{
+		cursor = SkipHorizontalSpace(cursor, end);
+		char const* recordData = cursor;
+		switch (ClassifyOBJLine(cursor, end, recordData))
+		{
+			case OBJ_RECORD_POSITION:
+			{
+				// Anything after xyz (w or vertex colors) is ignored
+				Vec3 position(0.f, 0.f, 0.f);
+				cursor = ParseFloat(recordData, end, position.x);
+				cursor = ParseFloat(cursor, end, position.y);
+				cursor = ParseFloat(cursor, end, position.z);
+				sink.AddPosition(position);
+				break;
+			}
+			case OBJ_RECORD_UV:
+			{
+				Vec2 uv(0.f, 0.f);
+				cursor = ParseFloat(recordData, end, uv.x);
+				cursor = ParseFloat(cursor, end, uv.y);
+				sink.AddUV(uv);
+				break;
+			}
+			case OBJ_RECORD_NORMAL:
+			{
+				Vec3 normal(0.f, 0.f, 0.f);
+				cursor = ParseFloat(recordData, end, normal.x);
+				cursor = ParseFloat(cursor, end, normal.y);
+				cursor = ParseFloat(cursor, end, normal.z);
+				sink.AddNormal(normal);
+				break;
+			}
+			case OBJ_RECORD_FACE:
+			{
+				cursor = ParseFace(recordData, end, sink);
+				break;
+			}
+			case OBJ_RECORD_USE_MATERIAL:
+			{
+				char const*	name		=	nullptr;
+				size_t		nameLength	=	0;
+				cursor = ParseRestOfLine(recordData, end, name, nameLength);
+				sink.UseMaterial(name, nameLength);
+				break;
+			}
+			case OBJ_RECORD_MATERIAL_LIBRARY:
+			{
+				// Several libraries can share a line, separated by spaces
+				char const*	fileNames			=	nullptr;
+				size_t		fileNamesLength		=	0;
+				cursor = ParseRestOfLine(recordData, end, fileNames, fileNamesLength);
+				char const*	fileNamesEnd		=	fileNames + fileNamesLength;
+				while (fileNames < fileNamesEnd)
+				{
+					char const* fileNameEnd = fileNames;
+					while (fileNameEnd < fileNamesEnd && !IsHorizontalSpace(*fileNameEnd))
+					{
+						++fileNameEnd;
+					}
+					sink.AddMaterialLibrary(fileNames, (size_t)(fileNameEnd - fileNames));
+					fileNames = SkipHorizontalSpace(fileNameEnd, fileNamesEnd);
+				}
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+		cursor = SkipLine(cursor, end);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+class OBJCountJob : public Job
+{
+public:
+	OBJCountJob(OBJTextChunk& chunk) : m_chunk(chunk) {};
+	virtual void Execute() override;
+
+public:
+	OBJTextChunk& m_chunk;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJCountJob::Execute()
+{
+	char const* cursor	=	m_chunk.m_start;
+	char const* end		=	m_chunk.m_end;
+	while (cursor < end)
+	{
+		cursor = SkipHorizontalSpace(cursor, end);
+		char const* recordData = cursor;
+		switch (ClassifyOBJLine(cursor, end, recordData))
+		{
+			case OBJ_RECORD_POSITION:	++m_chunk.m_numOfPositions;	break;
+			case OBJ_RECORD_UV:			++m_chunk.m_numOfUVs;		break;
+			case OBJ_RECORD_NORMAL:		++m_chunk.m_numOfNormals;	break;
+			default:												break;
+		}
+		cursor = SkipLine(cursor, end);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+class OBJParseJob : public Job
+{
+public:
+	OBJParseJob(OBJTextChunk& chunk, OBJMeshData& meshData) : m_chunk(chunk), m_meshData(meshData) {};
+	virtual void Execute() override;
+
+public:
+	OBJTextChunk&	m_chunk;
+	OBJMeshData&	m_meshData;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJParseJob::Execute()
+{
+	OBJTextChunkSink sink(m_chunk, m_meshData);
+	ParseOBJLines(m_chunk.m_start, m_chunk.m_end, sink);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+class OBJMergeFacesJob : public Job
+{
+public:
+	OBJMergeFacesJob(OBJTextChunk& chunk, OBJMeshData& meshData) : m_chunk(chunk), m_meshData(meshData) {};
+	virtual void Execute() override;
+
+public:
+	OBJTextChunk&	m_chunk;
+	OBJMeshData&	m_meshData;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJMergeFacesJob::Execute()
+{
+	if (!m_chunk.m_faceCorners.empty())
+	{
+		memcpy(m_meshData.m_faceCorners.data() + m_chunk.m_firstFaceCorner, m_chunk.m_faceCorners.data(), m_chunk.m_faceCorners.size() * sizeof(OBJFaceCorner));
+	}
+	unsigned int*	faceFirstCorners	=	m_meshData.m_faceFirstCorners.data() + m_chunk.m_firstFace;
+	unsigned int	cornerOffset		=	(unsigned int)m_chunk.m_firstFaceCorner;
+	for (size_t faceIndex = 0; faceIndex < m_chunk.m_faceFirstCorners.size(); ++faceIndex)
+	{
+		faceFirstCorners[faceIndex] = m_chunk.m_faceFirstCorners[faceIndex] + cornerOffset;
+	}
+
+	// The chunk's face data is no longer needed, free it while the other merges are still running
+	m_chunk.m_faceCorners		=	std::vector<OBJFaceCorner>();
+	m_chunk.m_faceFirstCorners	=	std::vector<unsigned int>();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void DeleteJobs(std::vector<Job*>& jobs)
+{
+	for (size_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
+	{
+		delete jobs[jobIndex];
+	}
+	jobs.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int OBJMeshData::GetNumOfFaces() const
+{
+	return (int)m_faceFirstCorners.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int OBJMeshData::GetNumOfFaceCorners(int faceIndex) const
+{
+	unsigned int faceEnd = faceIndex + 1 < (int)m_faceFirstCorners.size() ? m_faceFirstCorners[size_t(faceIndex) + 1] : (unsigned int)m_faceCorners.size();
+	return (int)(faceEnd - m_faceFirstCorners[faceIndex]);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int OBJMeshData::GetNumOfTriangles() const
+{
+	// Every stored face has at least 3 corners
+	return (int)m_faceCorners.size() - 2 * (int)m_faceFirstCorners.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int OBJMeshData::GetNumOfTriangles(OBJMaterialRange const& materialRange) const
+{
+	unsigned int faceEnd	=	materialRange.m_firstFace + materialRange.m_numOfFaces;
+	unsigned int cornerEnd	=	faceEnd < m_faceFirstCorners.size() ? m_faceFirstCorners[faceEnd] : (unsigned int)m_faceCorners.size();
+	return (int)(cornerEnd - m_faceFirstCorners[materialRange.m_firstFace]) - 2 * (int)materialRange.m_numOfFaces;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool OBJMaterial::IsTranslucent() const
+{
+	return m_opacity < 1.f || !m_opacityMap.empty();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool OBJLoader::ParseOBJFile(std::string const& fileName, OBJMeshData& out_meshData)
+{
+	MemoryMappedFile objFile;
+	if (!objFile.Open(fileName))
+	{
+		return false;
+	}
+
+	char const* text = reinterpret_cast<char const*>(objFile.GetData());
+	if (g_theJobSystem && g_theJobSystem->GetNumOfWorkerThreads() > 0 && objFile.GetSize() >= 2 * OBJ_LOADER_MIN_BYTES_PER_CHUNK)
+	{
+		ParseOBJTextParallel(text, objFile.GetSize(), out_meshData, *g_theJobSystem);
+	}
+	else
+	{
+		ParseOBJText(text, objFile.GetSize(), out_meshData);
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::ParseOBJText(char const* text, size_t numOfBytes, OBJMeshData& out_meshData)
+{
+	OBJMeshDataSink sink(out_meshData);
+	ParseOBJLines(text, text + numOfBytes, sink);
+	FinalizeMaterialRanges(out_meshData);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::ParseOBJTextParallel(char const* text, size_t numOfBytes, OBJMeshData& out_meshData, JobSystem& jobSystem)
+{
+	// A few chunks per thread so one slow chunk (say, all faces) does not hold everyone up
+	size_t numOfThreads	=	size_t(jobSystem.GetNumOfWorkerThreads()) + 1;
+	size_t numOfChunks	=	numOfBytes / OBJ_LOADER_MIN_BYTES_PER_CHUNK;
+	numOfChunks			=	numOfChunks < numOfThreads * 4 ? numOfChunks : numOfThreads * 4;
+	if (numOfChunks < 2)
+	{
+		ParseOBJText(text, numOfBytes, out_meshData);
+		return;
+	}
+
+	// Chunks end just past a new line so no record is split
+	char const*					end			=	text + numOfBytes;
+	char const*					chunkStart	=	text;
+	std::vector<OBJTextChunk>	chunks;
+	chunks.reserve(numOfChunks);
+	for (size_t chunkIndex = 1; chunkIndex <= numOfChunks && chunkStart < end; ++chunkIndex)
+	{
+		char const* chunkEnd = chunkIndex == numOfChunks ? end : text + numOfBytes * chunkIndex / numOfChunks;
+		if (chunkEnd < chunkStart)
+		{
+			continue;
+		}
+		chunkEnd = chunkEnd < end ? SkipLine(chunkEnd, end) : end;
+
+		OBJTextChunk chunk;
+		chunk.m_start	=	chunkStart;
+		chunk.m_end		=	chunkEnd;
+		chunks.push_back(std::move(chunk));
+		chunkStart = chunkEnd;
+	}
+
+	std::vector<Job*> jobs;
+	jobs.reserve(chunks.size());
+	for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+	{
+		jobs.push_back(new OBJCountJob(chunks[chunkIndex]));
+	}
+	JobSystem::ExecuteJobsAndWait(&jobSystem, jobs);
+	DeleteJobs(jobs);
+
+	size_t firstPosition	=	out_meshData.m_positions.size();
+	size_t firstUV			=	out_meshData.m_uvs.size();
+	size_t firstNormal		=	out_meshData.m_normals.size();
+	for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+	{
+		OBJTextChunk& chunk = chunks[chunkIndex];
+		chunk.m_firstPosition	=	firstPosition;
+		chunk.m_firstUV			=	firstUV;
+		chunk.m_firstNormal		=	firstNormal;
+		firstPosition			+=	chunk.m_numOfPositions;
+		firstUV					+=	chunk.m_numOfUVs;
+		firstNormal				+=	chunk.m_numOfNormals;
+	}
+	out_meshData.m_positions.resize(firstPosition);
+	out_meshData.m_uvs.resize(firstUV);
+	out_meshData.m_normals.resize(firstNormal);
+
+	for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+	{
+		jobs.push_back(new OBJParseJob(chunks[chunkIndex], out_meshData));
+	}
+	JobSystem::ExecuteJobsAndWait(&jobSystem, jobs);
+	DeleteJobs(jobs);
+
+	// Material names are interned in chunk order, so they come out in the same first use order as the serial parse
+	size_t firstFace		=	out_meshData.m_faceFirstCorners.size();
+	size_t firstFaceCorner	=	out_meshData.m_faceCorners.size();
+	for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+	{
+		OBJTextChunk& chunk = chunks[chunkIndex];
+		chunk.m_firstFace		=	firstFace;
+		chunk.m_firstFaceCorner	=	firstFaceCorner;
+		firstFace				+=	chunk.m_faceFirstCorners.size();
+		firstFaceCorner			+=	chunk.m_faceCorners.size();
+
+		out_meshData.m_materialLibraries.insert(out_meshData.m_materialLibraries.end(), chunk.m_materialLibraries.begin(), chunk.m_materialLibraries.end());
+		for (size_t rangeIndex = 0; rangeIndex < chunk.m_materialRanges.size(); ++rangeIndex)
+		{
+			OBJMaterialRange const&	chunkRange		=	chunk.m_materialRanges[rangeIndex];
+			std::string const&		materialName	=	chunk.m_materialNames[chunkRange.m_materialIndex];
+			int						materialIndex	=	FindOrAddMaterialName(out_meshData.m_materialNames, materialName.data(), materialName.size());
+			UseMaterial(out_meshData.m_materialRanges, materialIndex, chunk.m_firstFace + chunkRange.m_firstFace);
+		}
+	}
+	out_meshData.m_faceFirstCorners.resize(firstFace);
+	out_meshData.m_faceCorners.resize(firstFaceCorner);
+
+	for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+	{
+		jobs.push_back(new OBJMergeFacesJob(chunks[chunkIndex], out_meshData));
+	}
+	JobSystem::ExecuteJobsAndWait(&jobSystem, jobs);
+	DeleteJobs(jobs);
+
+	FinalizeMaterialRanges(out_meshData);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::AppendTriangles(OBJMeshData const& meshData, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes)
+{
+	AppendTriangles(meshData, meshData.m_materialRanges, out_verts, out_indexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::AppendTriangles(OBJMeshData const& meshData, std::vector<OBJMaterialRange> const& faceRanges, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes)
+{
+	size_t	firstVertIndex	=	out_verts.size();
+	size_t	firstIndex		=	out_indexes.size();
+	int		numOfTriangles	=	meshData.GetNumOfTriangles();
+	bool	isTriangleSoup	=	meshData.GetNumOfFaces() == 0;
+	if (isTriangleSoup)
+	{
+		// No faces, treat every 3 positions as a triangle
+		numOfTriangles = (int)meshData.m_positions.size() / 3;
+	}
+	out_verts.resize(firstVertIndex + size_t(numOfTriangles) * 3);
+	out_indexes.resize(firstIndex + size_t(numOfTriangles) * 3);
+
+	Vertex_PCU*		vert	=	out_verts.data() + firstVertIndex;
+	unsigned int*	index	=	out_indexes.data() + firstIndex;
+	for (int vertIndex = 0; vertIndex < numOfTriangles * 3; ++vertIndex)
+	{
+		index[vertIndex] = (unsigned int)(firstVertIndex + vertIndex);
+	}
+
+	if (isTriangleSoup)
+	{
+		for (int vertIndex = 0; vertIndex < numOfTriangles * 3; ++vertIndex)
+		{
+			vert[vertIndex] = Vertex_PCU(meshData.m_positions[vertIndex], Rgba8::WHITE, Vec2(0.f, 0.f));
+		}
+		return;
+	}
+
+	for (size_t rangeIndex = 0; rangeIndex < faceRanges.size(); ++rangeIndex)
+	{
+		int faceEnd = (int)(faceRanges[rangeIndex].m_firstFace + faceRanges[rangeIndex].m_numOfFaces);
+		for (int faceIndex = (int)faceRanges[rangeIndex].m_firstFace; faceIndex < faceEnd; ++faceIndex)
+		{
+			OBJFaceCorner const*	corners			=	meshData.m_faceCorners.data() + meshData.m_faceFirstCorners[faceIndex];
+			int						numOfCorners	=	meshData.GetNumOfFaceCorners(faceIndex);
+			for (int fanIndex = 1; fanIndex < numOfCorners - 1; ++fanIndex)
+			{
+				OBJFaceCorner const* triangleCorners[3] = { &corners[0], &corners[fanIndex], &corners[fanIndex + 1] };
+				for (int cornerIndex = 0; cornerIndex < 3; ++cornerIndex)
+				{
+					OBJFaceCorner const& corner = *triangleCorners[cornerIndex];
+					Vec2 uv = corner.m_uvIndex >= 0 ? meshData.m_uvs[corner.m_uvIndex] : Vec2(0.f, 0.f);
+					*vert++ = Vertex_PCU(meshData.m_positions[corner.m_positionIndex], Rgba8::WHITE, uv);
+				}
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::AppendTriangles(OBJMeshData const& meshData, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes)
+{
+	AppendTriangles(meshData, meshData.m_materialRanges, out_verts, out_indexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::AppendTriangles(OBJMeshData const& meshData, std::vector<OBJMaterialRange> const& faceRanges, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes)
+{
+	size_t	firstVertIndex	=	out_verts.size();
+	size_t	firstIndex		=	out_indexes.size();
+	int		numOfTriangles	=	meshData.GetNumOfTriangles();
+	bool	isTriangleSoup	=	meshData.GetNumOfFaces() == 0;
+	if (isTriangleSoup)
+	{
+		numOfTriangles = (int)meshData.m_positions.size() / 3;
+	}
+	out_verts.resize(firstVertIndex + size_t(numOfTriangles) * 3);
+	out_indexes.resize(firstIndex + size_t(numOfTriangles) * 3);
+
+	Vertex_PCUTBN*	vert	=	out_verts.data() + firstVertIndex;
+	unsigned int*	index	=	out_indexes.data() + firstIndex;
+	for (int vertIndex = 0; vertIndex < numOfTriangles * 3; ++vertIndex)
+	{
+		index[vertIndex] = (unsigned int)(firstVertIndex + vertIndex);
+	}
+
+	Vec3 const	noTangent	=	Vec3(0.f, 0.f, 0.f);
+	Vec2 const	noUV		=	Vec2(0.f, 0.f);
+	if (isTriangleSoup)
+	{
+		for (int triangleIndex = 0; triangleIndex < numOfTriangles; ++triangleIndex)
+		{
+			Vec3 const& vert1		=	meshData.m_positions[size_t(triangleIndex) * 3];
+			Vec3 const& vert2		=	meshData.m_positions[size_t(triangleIndex) * 3 + 1];
+			Vec3 const& vert3		=	meshData.m_positions[size_t(triangleIndex) * 3 + 2];
+			Vec3		faceNormal	=	CrossProduct3D(vert2 - vert1, vert3 - vert2).GetNormalized();
+			*vert++ = Vertex_PCUTBN(vert1, Rgba8::WHITE, noUV, noTangent, noTangent, faceNormal);
+			*vert++ = Vertex_PCUTBN(vert2, Rgba8::WHITE, noUV, noTangent, noTangent, faceNormal);
+			*vert++ = Vertex_PCUTBN(vert3, Rgba8::WHITE, noUV, noTangent, noTangent, faceNormal);
+		}
+		return;
+	}
+
+	for (size_t rangeIndex = 0; rangeIndex < faceRanges.size(); ++rangeIndex)
+	{
+		int faceEnd = (int)(faceRanges[rangeIndex].m_firstFace + faceRanges[rangeIndex].m_numOfFaces);
+		for (int faceIndex = (int)faceRanges[rangeIndex].m_firstFace; faceIndex < faceEnd; ++faceIndex)
+		{
+			OBJFaceCorner const*	corners			=	meshData.m_faceCorners.data() + meshData.m_faceFirstCorners[faceIndex];
+			int						numOfCorners	=	meshData.GetNumOfFaceCorners(faceIndex);
+			for (int fanIndex = 1; fanIndex < numOfCorners - 1; ++fanIndex)
+			{
+				OBJFaceCorner const* triangleCorners[3] = { &corners[0], &corners[fanIndex], &corners[fanIndex + 1] };
+				Vec3 const& vert1 = meshData.m_positions[triangleCorners[0]->m_positionIndex];
+				Vec3 const& vert2 = meshData.m_positions[triangleCorners[1]->m_positionIndex];
+				Vec3 const& vert3 = meshData.m_positions[triangleCorners[2]->m_positionIndex];
+
+				// Corners without a normal get the flat triangle normal
+				bool needsFaceNormal = triangleCorners[0]->m_normalIndex < 0 || triangleCorners[1]->m_normalIndex < 0 || triangleCorners[2]->m_normalIndex < 0;
+				Vec3 faceNormal = needsFaceNormal ? CrossProduct3D(vert2 - vert1, vert3 - vert2).GetNormalized() : Vec3(0.f, 0.f, 0.f);
+				for (int cornerIndex = 0; cornerIndex < 3; ++cornerIndex)
+				{
+					OBJFaceCorner const& corner = *triangleCorners[cornerIndex];
+					Vec2 uv		=	corner.m_uvIndex >= 0 ? meshData.m_uvs[corner.m_uvIndex] : noUV;
+					Vec3 normal	=	corner.m_normalIndex >= 0 ? meshData.m_normals[corner.m_normalIndex] : faceNormal;
+					*vert++ = Vertex_PCUTBN(meshData.m_positions[corner.m_positionIndex], Rgba8::WHITE, uv, noTangent, noTangent, normal);
+				}
+			}
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void PrintOBJLoadStats(std::string const& fileName, OBJMeshData const& meshData, int numOfVerts, int numOfIndexes, double parseSeconds, double createSeconds)
+{
+	DebuggerPrintf("\n--------------------------------------------------------------------------------------------------");
+	DebuggerPrintf("\nLoaded .obj file %s", fileName.c_str());
+	DebuggerPrintf("\n[file data]    vertexes: %d    texture coordinates: %d    normals: %d    faces: %d    triangles: %d", (int)meshData.m_positions.size(), (int)meshData.m_uvs.size(), (int)meshData.m_normals.size(), meshData.GetNumOfFaces(), numOfIndexes / 3);
+	DebuggerPrintf("\n[loaded mesh]  vertexes: %d    indexes: %d", numOfVerts, numOfIndexes);
+	DebuggerPrintf("\n[time]         parse: %f    create: %f", parseSeconds, createSeconds);
+	DebuggerPrintf("\n--------------------------------------------------------------------------------------------------\n\n");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void PrintCookedMeshLoadStats(std::string const& fileName, std::string const& cookedFileName, int numOfVerts, int numOfIndexes, double loadSeconds)
+{
+	DebuggerPrintf("\n--------------------------------------------------------------------------------------------------");
+	DebuggerPrintf("\nLoaded .obj file %s from %s", fileName.c_str(), cookedFileName.c_str());
+	DebuggerPrintf("\n[loaded mesh]  vertexes: %d    indexes: %d", numOfVerts, numOfIndexes);
+	DebuggerPrintf("\n[time]         load: %f", loadSeconds);
+	DebuggerPrintf("\n--------------------------------------------------------------------------------------------------\n\n");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Cooked indexes start at 0, so they are offset by the verts already in out_verts
+template <typename VertexType>
+static void AppendCookedMesh(CookedMeshFile const& cookedMesh, std::vector<VertexType>& out_verts, std::vector<unsigned int>& out_indexes)
+{
+	size_t				firstVertIndex	=	out_verts.size();
+	size_t				firstIndex		=	out_indexes.size();
+	VertexType const*	cookedVerts		=	static_cast<VertexType const*>(cookedMesh.GetVertexData());
+	unsigned int const*	cookedIndexes	=	cookedMesh.GetIndexes();
+	out_verts.insert(out_verts.end(), cookedVerts, cookedVerts + cookedMesh.GetNumOfVerts());
+	out_indexes.resize(firstIndex + cookedMesh.GetNumOfIndexes());
+	for (size_t indexIndex = 0; indexIndex < cookedMesh.GetNumOfIndexes(); ++indexIndex)
+	{
+		out_indexes[firstIndex + indexIndex] = cookedIndexes[indexIndex] + (unsigned int)firstVertIndex;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::LoadOBJFileByName(std::string const& fileName, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes, Mat44 const& transformFixUpMat, bool useCookedMesh)
+{
+	double		timeBeforeParsingOBJFile	=	GetCurrentTimeSeconds();
+	std::string	cookedFileName				=	GetCookedMeshFileName(fileName, CookedMeshVertexFormat::PCU, transformFixUpMat);
+	if (useCookedMesh)
+	{
+		CookedMeshFile cookedMesh;
+		if (cookedMesh.Open(cookedFileName, fileName, CookedMeshVertexFormat::PCU, transformFixUpMat))
+		{
+			AppendCookedMesh(cookedMesh, out_verts, out_indexes);
+			PrintCookedMeshLoadStats(fileName, cookedFileName, (int)cookedMesh.GetNumOfVerts(), (int)cookedMesh.GetNumOfIndexes(), GetCurrentTimeSeconds() - timeBeforeParsingOBJFile);
+			return;
+		}
+	}
+
+	OBJMeshData	meshData;
+	if (!ParseOBJFile(fileName, meshData))
+	{
+		return;
+	}
+	double timeAfterParsingOBJFile = GetCurrentTimeSeconds();
+
+	size_t firstVertIndex	=	out_verts.size();
+	size_t firstIndex		=	out_indexes.size();
+	AppendTriangles(meshData, out_verts, out_indexes);
+	TransformVertexArray3D((int)(out_verts.size() - firstVertIndex), out_verts.data() + firstVertIndex, transformFixUpMat);
+	double timeAfterCreatingVertexesAndIndexes = GetCurrentTimeSeconds();
+
+	PrintOBJLoadStats(fileName, meshData, (int)(out_verts.size() - firstVertIndex), (int)(out_indexes.size() - firstIndex), timeAfterParsingOBJFile - timeBeforeParsingOBJFile, timeAfterCreatingVertexesAndIndexes - timeAfterParsingOBJFile);
+
+	if (useCookedMesh)
+	{
+		WriteCookedMeshFile(cookedFileName, fileName, CookedMeshVertexFormat::PCU, transformFixUpMat, out_verts.data() + firstVertIndex, out_verts.size() - firstVertIndex,
+							out_indexes.data() + firstIndex, out_indexes.size() - firstIndex, (unsigned int)firstVertIndex);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::LoadOBJFileByName(std::string const& fileName, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes, Mat44 const& transformFixUpMat, bool useCookedMesh)
+{
+	double		timeBeforeParsingOBJFile	=	GetCurrentTimeSeconds();
+	std::string	cookedFileName				=	GetCookedMeshFileName(fileName, CookedMeshVertexFormat::PCUTBN, transformFixUpMat);
+	if (useCookedMesh)
+	{
+		CookedMeshFile cookedMesh;
+		if (cookedMesh.Open(cookedFileName, fileName, CookedMeshVertexFormat::PCUTBN, transformFixUpMat))
+		{
+			AppendCookedMesh(cookedMesh, out_verts, out_indexes);
+			PrintCookedMeshLoadStats(fileName, cookedFileName, (int)cookedMesh.GetNumOfVerts(), (int)cookedMesh.GetNumOfIndexes(), GetCurrentTimeSeconds() - timeBeforeParsingOBJFile);
+			return;
+		}
+	}
+
+	OBJMeshData	meshData;
+	if (!ParseOBJFile(fileName, meshData))
+	{
+		return;
+	}
+	double timeAfterParsingOBJFile = GetCurrentTimeSeconds();
+
+	size_t firstVertIndex	=	out_verts.size();
+	size_t firstIndex		=	out_indexes.size();
+	AppendTriangles(meshData, out_verts, out_indexes);
+	TransformVertexArray3D((int)(out_verts.size() - firstVertIndex), out_verts.data() + firstVertIndex, transformFixUpMat);
+	double timeAfterCreatingVertexesAndIndexes = GetCurrentTimeSeconds();
+
+	PrintOBJLoadStats(fileName, meshData, (int)(out_verts.size() - firstVertIndex), (int)(out_indexes.size() - firstIndex), timeAfterParsingOBJFile - timeBeforeParsingOBJFile, timeAfterCreatingVertexesAndIndexes - timeAfterParsingOBJFile);
+
+	CalculateTangentSpaceVectors(out_verts, out_indexes, firstVertIndex, firstIndex);
+
+	if (useCookedMesh)
+	{
+		WriteCookedMeshFile(cookedFileName, fileName, CookedMeshVertexFormat::PCUTBN, transformFixUpMat, out_verts.data() + firstVertIndex, out_verts.size() - firstVertIndex,
+							out_indexes.data() + firstIndex, out_indexes.size() - firstIndex, (unsigned int)firstVertIndex);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool OBJLoader::LoadOBJFileIntoCPUMesh(std::string const& fileName, CPUMesh& out_cpuMesh, Mat44 const& transformFixUpMat)
 {
-	if (!DoesFileExist(fileName))
+	std::string		cookedFileName	=	GetCookedMeshFileName(fileName, CookedMeshVertexFormat::PCUTBN, transformFixUpMat);
+	CookedMeshFile*	cookedMesh		=	new CookedMeshFile();
+	if (!cookedMesh->Open(cookedFileName, fileName, CookedMeshVertexFormat::PCUTBN, transformFixUpMat))
 	{
-		return;
-	}
+		std::vector<Vertex_PCUTBN>	verts;
+		std::vector<unsigned int>	indexes;
+		LoadOBJFileByName(fileName, verts, indexes, transformFixUpMat);
 
-	Strings newLineAndCarriageReturnDelimitedList;
-	double timeBeforeParsingOBJFile = GetCurrentTimeSeconds();
-	ParseAndRemoveNewLineAndCarraigeReturnFromFile(fileName, newLineAndCarriageReturnDelimitedList);
-	double timeAfterParsingOBJFile					= GetCurrentTimeSeconds();
-	double timeTakenToParseAndLoadFileIntoMemory	= timeAfterParsingOBJFile - timeBeforeParsingOBJFile;
-	// Populate the vertex PNCU
-	std::vector<Vec3> vertexPositionList;
-	std::vector<Vec3> vertexNormalList;
-	std::vector<Vec2> vertexTexCoordList;
-	
-	int numOfFaces		= 0;
-	int numOfTriangles	= 0;
+		// Cooking can fail (read only folder, old cooked file still mapped somewhere), the mesh then just owns its data
+		if (!cookedMesh->Open(cookedFileName, fileName, CookedMeshVertexFormat::PCUTBN, transformFixUpMat))
+		{
+			delete cookedMesh;
+			out_cpuMesh.SetCookedMeshFile(nullptr);
+			out_cpuMesh.m_cpuVerts.swap(verts);
+			out_cpuMesh.m_cpuIndexes.swap(indexes);
+			return !out_cpuMesh.m_cpuIndexes.empty();
+		}
+	}
+	out_cpuMesh.SetCookedMeshFile(cookedMesh);
+	return true;
+}
 
-	out_verts.reserve(newLineAndCarriageReturnDelimitedList.size());
 
-	double timeBeforeCreatingVertexesAndIndexes = GetCurrentTimeSeconds();
-	for (int stringIndex = 0; stringIndex < (int)newLineAndCarriageReturnDelimitedList.size(); ++stringIndex)
+//--------------------------------------------------------------------------------------------------
+// out_faceRanges is the file's material ranges reordered by material (stable, so faces keep file order within a material),
+// out_submeshes gets one entry per material covering its triangles, starting at firstIndex of the index buffer
+void OBJLoader::GroupFacesByMaterial(OBJMeshData const& meshData, size_t firstIndex, std::vector<OBJMaterialRange>& out_faceRanges, std::vector<OBJSubmesh>& out_submeshes)
+{
+	out_faceRanges = meshData.m_materialRanges;
+	std::stable_sort(out_faceRanges.begin(), out_faceRanges.end(), [](OBJMaterialRange const& rangeA, OBJMaterialRange const& rangeB)
 	{
-		std::string currentString	=	newLineAndCarriageReturnDelimitedList[stringIndex];
-		if (currentString.size() < 2) continue;
-		unsigned char firstChar		=	currentString[0];
-		unsigned char secondChar	=	currentString[1];
-		if (firstChar == '#') continue;
+		return rangeA.m_materialIndex < rangeB.m_materialIndex;
+	});
 
-		if (firstChar == 'v' && secondChar == ' ')
+	unsigned int nextIndex = (unsigned int)firstIndex;
+	for (size_t rangeIndex = 0; rangeIndex < out_faceRanges.size(); ++rangeIndex)
+	{
+		OBJMaterialRange const& faceRange = out_faceRanges[rangeIndex];
+		if (rangeIndex == 0 || out_submeshes.back().m_materialIndex != faceRange.m_materialIndex)
 		{
-			Strings spaceDelimitedList = SplitStringOnDelimiter(currentString, ' ');
-			int spaceDelimitedListSize = (int)spaceDelimitedList.size();
-			if (spaceDelimitedListSize > 3)
-			{
-				float x = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 3].c_str());
-				float y = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-				float z = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 1].c_str());
-				vertexPositionList.emplace_back(x, y, z);
-			}
-			continue;
+			OBJSubmesh submesh;
+			submesh.m_materialIndex	=	faceRange.m_materialIndex;
+			submesh.m_firstIndex	=	nextIndex;
+			out_submeshes.push_back(submesh);
 		}
+		unsigned int numOfIndexes = (unsigned int)meshData.GetNumOfTriangles(faceRange) * 3;
+		out_submeshes.back().m_numOfIndexes	+=	numOfIndexes;
+		nextIndex							+=	numOfIndexes;
+	}
+}
+
 
-		if (firstChar == 'v' && secondChar == 'n')
+//--------------------------------------------------------------------------------------------------
+// Appends one material per usemtl name in meshData's order, taking the first definition of that name from the mtllib files
+void OBJLoader::LoadMaterials(std::string const& fileName, OBJMeshData const& meshData, std::vector<OBJMaterial>& out_materials)
+{
+	size_t firstMaterialIndex = out_materials.size();
+	out_materials.resize(firstMaterialIndex + meshData.m_materialNames.size());
+	std::vector<bool> isDefined(meshData.m_materialNames.size(), false);
+	for (size_t nameIndex = 0; nameIndex < meshData.m_materialNames.size(); ++nameIndex)
+	{
+		out_materials[firstMaterialIndex + nameIndex].m_name = meshData.m_materialNames[nameIndex];
+	}
+
+	std::filesystem::path objFolder = std::filesystem::path(fileName).parent_path();
+	for (size_t libraryIndex = 0; libraryIndex < meshData.m_materialLibraries.size(); ++libraryIndex)
+	{
+		std::string				libraryFileName	=	(objFolder / meshData.m_materialLibraries[libraryIndex]).generic_string();
+		std::vector<OBJMaterial>	libraryMaterials;
+		if (!ParseMTLFile(libraryFileName, libraryMaterials))
 		{
-			Strings spaceDelimitedList = SplitStringOnDelimiter(currentString, ' ');
-			int spaceDelimitedListSize = (int)spaceDelimitedList.size();
-			if (spaceDelimitedListSize > 3)
-			{
-				float x = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 3].c_str());
-				float y = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-				float z = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 1].c_str());
-				vertexNormalList.emplace_back(x, y, z);
-			}
+			DebuggerPrintf("\nWARNING: %s uses material library %s which could not be opened\n", fileName.c_str(), libraryFileName.c_str());
 			continue;
 		}
-		
-		if (firstChar == 'v' && secondChar == 't')
+
+		for (size_t libraryMaterialIndex = 0; libraryMaterialIndex < libraryMaterials.size(); ++libraryMaterialIndex)
 		{
-			Strings spaceDelimitedList = SplitStringOnDelimiter(currentString, ' ');
-			int spaceDelimitedListSize = (int)spaceDelimitedList.size();
-			if (spaceDelimitedListSize > 3)
-			{
-				float u = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 3].c_str());
-				float v = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-				vertexTexCoordList.emplace_back(u, v);
-			}
-			else if (spaceDelimitedListSize > 2)
+			for (size_t nameIndex = 0; nameIndex < meshData.m_materialNames.size(); ++nameIndex)
 			{
-				float u = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-				float v = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 1].c_str());
-				vertexTexCoordList.emplace_back(u, v);
+				if (!isDefined[nameIndex] && meshData.m_materialNames[nameIndex] == libraryMaterials[libraryMaterialIndex].m_name)
+				{
+					out_materials[firstMaterialIndex + nameIndex]	=	libraryMaterials[libraryMaterialIndex];
+					isDefined[nameIndex]							=	true;
+				}
 			}
-			continue;
 		}
-		
-		if (firstChar == 'f' && secondChar == ' ')
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Submesh material indexes are offset by the materials already in out_materials, like the indexes are by the verts already in out_verts
+static void OffsetSubmeshMaterials(std::vector<OBJSubmesh>& out_submeshes, size_t firstSubmeshIndex, size_t firstMaterialIndex)
+{
+	for (size_t submeshIndex = firstSubmeshIndex; submeshIndex < out_submeshes.size(); ++submeshIndex)
+	{
+		if (out_submeshes[submeshIndex].m_materialIndex >= 0)
 		{
-			Strings spaceDelimitedList	=	SplitStringOnDelimiter(currentString, ' ');
-			int spaceDelimitedListSize	=	(int)spaceDelimitedList.size(); 
-			// unsigned int indexCount		=	0;
-			std::vector<Vec3> reorderedPosList;
-			std::vector<Vec3> reorderedNormalList;
-			std::vector<Vec2> reorderedUVList;
+			out_submeshes[submeshIndex].m_materialIndex += (int)firstMaterialIndex;
+		}
+	}
+}
 
-			for (int subStringIndex	= 1; subStringIndex < spaceDelimitedListSize; ++subStringIndex)
-			{
-				std::string currentSubString		=	spaceDelimitedList[size_t(subStringIndex)];
-				if (currentSubString == "") continue;
-				Strings forwardSlashDelimitedList	=	SplitStringOnDelimiter(currentSubString, '/');
-				std::string subString1				=	forwardSlashDelimitedList[0];
-				
-				Vec3 pos;
-				int indexIntoPositionList = atoi(subString1.c_str()) - 1;
-				pos = vertexPositionList[indexIntoPositionList];
-				reorderedPosList.emplace_back(pos);
-				++numOfFaces;
-				Vec3 normal;
-				Vec2 uv;
-				if (forwardSlashDelimitedList.size() > 1)
-				{
-					std::string subString2 = forwardSlashDelimitedList[1];
-					std::string subString3 = forwardSlashDelimitedList[2];
 
-					if (subString2 != "")
-					{
-						int indexIntoTextureCoordList	=		atoi(subString2.c_str()) - 1;
-						uv								=		vertexTexCoordList[indexIntoTextureCoordList];
-						reorderedUVList.emplace_back(uv);
-					}
-					if (subString3 != "")
-					{
-						int indexIntoNormalList		=	atoi(subString3.c_str()) - 1;
-						normal						=	vertexNormalList[indexIntoNormalList];
-						reorderedNormalList.emplace_back(normal);
-					}
-				}
-			}
-			if (reorderedNormalList.size() == 0 && reorderedUVList.size() == 0)
-			{
-				// #ToDo: Rename
-				Vec3 const& vert1	=	reorderedPosList[size_t(0)];
-				size_t nextIndex	=	1;
-				while (nextIndex < reorderedPosList.size() - 1)
-				{
-					Vec3 const& vert2	=	reorderedPosList[nextIndex];
-					Vec3 const& vert3	=	reorderedPosList[nextIndex + 1];
-
-					Vec3 dispFromVert1To2 = vert2 - vert1;
-					Vec3 dispFromVert2To3 = vert3 - vert2;
-					Vec3 vertexNormal	  = CrossProduct3D(dispFromVert1To2, dispFromVert2To3);
-					vertexNormal.Normalize();
-
-					Vec3 tangents;
-					Vec3 binormals;
-
-					int vertIndex = (int)out_verts.size();
-					out_verts.emplace_back(reorderedPosList[size_t(0)],		Rgba8::WHITE, Vec2());
-					out_verts.emplace_back(reorderedPosList[nextIndex],		Rgba8::WHITE, Vec2());
-					out_verts.emplace_back(reorderedPosList[nextIndex + 1], Rgba8::WHITE, Vec2());
-
-					out_indexes.emplace_back((unsigned int)vertIndex);
-					out_indexes.emplace_back((unsigned int)vertIndex + 1);
-					out_indexes.emplace_back((unsigned int)vertIndex + 2);
-					
-					++numOfTriangles;
-					nextIndex += 1;
-				}
-			}
-			else if (reorderedNormalList.size() != 0)
-			{
-				if (reorderedUVList.size() == 0)
-				{
-					Vec3 const& vert1	= reorderedPosList[size_t(0)];
+//--------------------------------------------------------------------------------------------------
+bool OBJLoader::LoadOBJFileWithMaterials(std::string const& fileName, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes, std::vector<OBJSubmesh>& out_submeshes,
+										 std::vector<OBJMaterial>& out_materials, Mat44 const& transformFixUpMat)
+{
+	OBJMeshData meshData;
+	if (!ParseOBJFile(fileName, meshData))
+	{
+		return false;
+	}
 
-					size_t nextIndex = 1;
-					while (nextIndex < reorderedPosList.size() - 1)
-					{
-						Vec3 const& vert2 = reorderedPosList[nextIndex];
-						Vec3 const& vert3 = reorderedPosList[nextIndex + 1];
+	size_t							firstVertIndex		=	out_verts.size();
+	size_t							firstIndex			=	out_indexes.size();
+	size_t							firstSubmeshIndex	=	out_submeshes.size();
+	std::vector<OBJMaterialRange>	faceRanges;
+	GroupFacesByMaterial(meshData, firstIndex, faceRanges, out_submeshes);
+	AppendTriangles(meshData, faceRanges, out_verts, out_indexes);
+	TransformVertexArray3D((int)(out_verts.size() - firstVertIndex), out_verts.data() + firstVertIndex, transformFixUpMat);
+	if (out_submeshes.size() == firstSubmeshIndex && out_indexes.size() > firstIndex)
+	{
+		// A triangle soup has no faces to group
+		OBJSubmesh submesh;
+		submesh.m_firstIndex	=	(unsigned int)firstIndex;
+		submesh.m_numOfIndexes	=	(unsigned int)(out_indexes.size() - firstIndex);
+		out_submeshes.push_back(submesh);
+	}
 
-						int vertIndex = (int)out_verts.size();
-						out_verts.emplace_back(vert1, Rgba8::WHITE, Vec2());
-						out_verts.emplace_back(vert2, Rgba8::WHITE, Vec2());
-						out_verts.emplace_back(vert3, Rgba8::WHITE, Vec2());
+	OffsetSubmeshMaterials(out_submeshes, firstSubmeshIndex, out_materials.size());
+	LoadMaterials(fileName, meshData, out_materials);
+	return true;
+}
 
-						out_indexes.emplace_back((unsigned int)vertIndex);
-						out_indexes.emplace_back((unsigned int)vertIndex + 1);
-						out_indexes.emplace_back((unsigned int)vertIndex + 2);
 
-						++numOfTriangles;
-						nextIndex += 1;
-					}
-				}
-				else
-				{
-					Vec3 const& vert1	= reorderedPosList[size_t(0)];
-					Vec2 const& uv1		= reorderedUVList[size_t(0)];
+//--------------------------------------------------------------------------------------------------
+bool OBJLoader::LoadOBJFileWithMaterials(std::string const& fileName, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes, std::vector<OBJSubmesh>& out_submeshes,
+										 std::vector<OBJMaterial>& out_materials, Mat44 const& transformFixUpMat)
+{
+	OBJMeshData meshData;
+	if (!ParseOBJFile(fileName, meshData))
+	{
+		return false;
+	}
 
-					size_t nextIndex = 1;
-					while (nextIndex < reorderedPosList.size() - 1)
-					{
-						Vec3 const& vert2 = reorderedPosList[nextIndex];
-						Vec3 const& vert3 = reorderedPosList[nextIndex + 1];
+	size_t							firstVertIndex		=	out_verts.size();
+	size_t							firstIndex			=	out_indexes.size();
+	size_t							firstSubmeshIndex	=	out_submeshes.size();
+	std::vector<OBJMaterialRange>	faceRanges;
+	GroupFacesByMaterial(meshData, firstIndex, faceRanges, out_submeshes);
+	AppendTriangles(meshData, faceRanges, out_verts, out_indexes);
+	TransformVertexArray3D((int)(out_verts.size() - firstVertIndex), out_verts.data() + firstVertIndex, transformFixUpMat);
+	CalculateTangentSpaceVectors(out_verts, out_indexes, firstVertIndex, firstIndex);
+	if (out_submeshes.size() == firstSubmeshIndex && out_indexes.size() > firstIndex)
+	{
+		OBJSubmesh submesh;
+		submesh.m_firstIndex	=	(unsigned int)firstIndex;
+		submesh.m_numOfIndexes	=	(unsigned int)(out_indexes.size() - firstIndex);
+		out_submeshes.push_back(submesh);
+	}
+
+	OffsetSubmeshMaterials(out_submeshes, firstSubmeshIndex, out_materials.size());
+	LoadMaterials(fileName, meshData, out_materials);
+	return true;
+}
 
-						Vec2 const& uv2 = reorderedUVList[nextIndex];
-						Vec2 const& uv3 = reorderedUVList[nextIndex + 1];
 
-						int vertIndex = (int)out_verts.size();
-						out_verts.emplace_back(vert1, Rgba8::WHITE, uv1);
-						out_verts.emplace_back(vert2, Rgba8::WHITE, uv2);
-						out_verts.emplace_back(vert3, Rgba8::WHITE, uv3);
+//--------------------------------------------------------------------------------------------------
+bool OBJLoader::ParseMTLFile(std::string const& fileName, std::vector<OBJMaterial>& out_materials)
+{
+	MemoryMappedFile mtlFile;
+	if (!mtlFile.Open(fileName))
+	{
+		return false;
+	}
 
-						out_indexes.emplace_back((unsigned int)vertIndex);
-						out_indexes.emplace_back((unsigned int)vertIndex + 1);
-						out_indexes.emplace_back((unsigned int)vertIndex + 2);
+	size_t firstMaterialIndex = out_materials.size();
+	ParseMTLText(reinterpret_cast<char const*>(mtlFile.GetData()), mtlFile.GetSize(), out_materials);
 
-						++numOfTriangles;
-						nextIndex += 1;
-					}
-				}
+	// Texture maps are relative to the .mtl file, make them relative to the working directory like fileName
+	std::filesystem::path mtlFolder = std::filesystem::path(fileName).parent_path();
+	for (size_t materialIndex = firstMaterialIndex; materialIndex < out_materials.size(); ++materialIndex)
+	{
+		OBJMaterial&	material	=	out_materials[materialIndex];
+		std::string*	maps[]		=	{ &material.m_diffuseMap, &material.m_specularMap, &material.m_normalMap, &material.m_opacityMap };
+		for (std::string* map : maps)
+		{
+			if (!map->empty() && std::filesystem::path(*map).is_relative())
+			{
+				*map = (mtlFolder / *map).generic_string();
 			}
 		}
 	}
+	return true;
+}
 
-	if (out_verts.size() == 0)
+
+//--------------------------------------------------------------------------------------------------
+// Reads "Kd r g b", a single value means grey. Leaves out_color untouched if there is no color there
+static void ParseMTLColor(char const* cursor, char const* end, Vec3& out_color)
+{
+	float	values[3]		=	{ 0.f, 0.f, 0.f };
+	int		numOfValues		=	0;
+	while (numOfValues < 3)
 	{
-		for (int vertexIndex = 0; vertexIndex < (int)vertexPositionList.size(); vertexIndex += 3)
+		char const* valueStart	=	SkipHorizontalSpace(cursor, end);
+		cursor					=	ParseFloat(valueStart, end, values[numOfValues]);
+		if (cursor == valueStart)
 		{
-			Vec3 const& vert1 = vertexPositionList[size_t(vertexIndex)];
-			Vec3 const& vert2 = vertexPositionList[size_t(vertexIndex) + 1];
-			Vec3 const& vert3 = vertexPositionList[size_t(vertexIndex) + 2];
-		
-			Vec3 dispFromVert1To2 = vert2 - vert1;
-			Vec3 dispFromVert2To3 = vert3 - vert2;
-			Vec3 vertexNormal = CrossProduct3D(dispFromVert1To2, dispFromVert2To3);
-			vertexNormal.Normalize();
-
-			Vec3 tangent;
-			Vec3 binormal;
+			break;
+		}
+		++numOfValues;
+	}
 
-			out_verts.emplace_back(vertexPositionList[size_t(vertexIndex)],		Rgba8::WHITE, Vec2());
-			out_verts.emplace_back(vertexPositionList[size_t(vertexIndex) + 1], Rgba8::WHITE, Vec2());
-			out_verts.emplace_back(vertexPositionList[size_t(vertexIndex) + 2], Rgba8::WHITE, Vec2());
+	if (numOfValues == 1)
+	{
+		out_color = Vec3(values[0], values[0], values[0]);
+	}
+	else if (numOfValues == 3)
+	{
+		out_color = Vec3(values[0], values[1], values[2]);
+	}
+}
 
-			out_indexes.emplace_back((unsigned int)vertexIndex);
-			out_indexes.emplace_back((unsigned int)vertexIndex + 1);
-			out_indexes.emplace_back((unsigned int)vertexIndex + 2);
 
-			++numOfTriangles;
-		}
+//--------------------------------------------------------------------------------------------------
+// Texture map lines can have options ("map_Kd -s 1 1 1 wood.png") before the file name, the file name is the last token
+static std::string ParseMTLTextureMap(char const* cursor, char const* end)
+{
+	char const*	name		=	nullptr;
+	size_t		nameLength	=	0;
+	ParseRestOfLine(cursor, end, name, nameLength);
+	char const* nameEnd = name + nameLength;
+	char const* lastTokenStart = nameEnd;
+	while (lastTokenStart > name && !IsHorizontalSpace(lastTokenStart[-1]))
+	{
+		--lastTokenStart;
 	}
-	double timeAfterCreatingVertexesAndIndexes = GetCurrentTimeSeconds();
-	double timeTakenToCreateVertexesAndIndexes = timeAfterCreatingVertexesAndIndexes - timeBeforeCreatingVertexesAndIndexes;
-	TransformVertexArray3D(out_verts, transformFixUpMat);
-
-	DebuggerPrintf("\n--------------------------------------------------------------------------------------------------");
-	DebuggerPrintf("\nLoaded .obj file %s", fileName.c_str());
-	DebuggerPrintf("\n[file data]    vertexes: %d    texture coordinates: %d    normals: %d    faces: %d    triangles: %d", (int)vertexPositionList.size(), (int)vertexTexCoordList.size(), (int)vertexNormalList.size(), numOfFaces, numOfTriangles);
-	DebuggerPrintf("\n[loaded mesh]  vertexes: %d    indexes: %d", (int)out_verts.size(), (int)out_indexes.size());
-	DebuggerPrintf("\n[time]         parse: %f    create: %f", timeTakenToParseAndLoadFileIntoMemory, timeTakenToCreateVertexesAndIndexes);
-	DebuggerPrintf("\n--------------------------------------------------------------------------------------------------\n\n");
+	return std::string(lastTokenStart, nameEnd);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void OBJLoader::LoadOBJFileByName(std::string const& fileName, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes, Mat44 const& transformFixUpMat)
-{	
-	if (!DoesFileExist(fileName))
+// Matches keyword followed by a space at cursor, out_data is set to just past the keyword
+static bool IsMTLKeyword(char const* cursor, char const* end, char const* keyword, char const*& out_data)
+{
+	size_t keywordLength = strlen(keyword);
+	if (size_t(end - cursor) <= keywordLength || memcmp(cursor, keyword, keywordLength) != 0 || !IsHorizontalSpace(cursor[keywordLength]))
 	{
-		return;
+		return false;
 	}
+	out_data = cursor + keywordLength;
+	return true;
+}
 
-	Strings newLineAndCarriageReturnDelimitedList;
-	double timeBeforeParsingOBJFile = GetCurrentTimeSeconds();
-	ParseAndRemoveNewLineAndCarraigeReturnFromFile(fileName, newLineAndCarriageReturnDelimitedList);
-	double timeAfterParsingOBJFile					= GetCurrentTimeSeconds();
-	double timeTakenToParseAndLoadFileIntoMemory	= timeAfterParsingOBJFile - timeBeforeParsingOBJFile;
-	// Populate the vertex PNCU
-	std::vector<Vec3> vertexPositionList;
-	std::vector<Vec3> vertexNormalList;
-	std::vector<Vec2> vertexTexCoordList;
-	
-	int numOfFaces		= 0;
-	int numOfTriangles	= 0;
-
-	out_verts.reserve(newLineAndCarriageReturnDelimitedList.size());
-
-	double timeBeforeCreatingVertexesAndIndexes = GetCurrentTimeSeconds();
-	for (int stringIndex = 0; stringIndex < (int)newLineAndCarriageReturnDelimitedList.size(); ++stringIndex)
-	{
-		std::string currentString	=	newLineAndCarriageReturnDelimitedList[stringIndex];
-		if (currentString.size() < 2) continue;
-		// Strings spaceDelimitedList	=	SplitStringOnDelimiter(currentString, ' ');
-		unsigned char firstChar		=	currentString[0];
-		unsigned char secondChar	=	currentString[1];
-		if (firstChar == '#') continue;
-
-		if (firstChar == 'v' && secondChar == ' ')
-		{
-			Strings spaceDelimitedList = SplitStringOnDelimiter(currentString, ' ');
-			int spaceDelimitedListSize = (int)spaceDelimitedList.size();
-			if (spaceDelimitedListSize > 3)
-			{
-				float x = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 3].c_str());
-				float y = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-				float z = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 1].c_str());
-				vertexPositionList.emplace_back(x, y, z);
-			}
-			continue;
-		}
 
-		if (firstChar == 'v' && secondChar == 'n')
+//--------------------------------------------------------------------------------------------------
+void OBJLoader::ParseMTLText(char const* text, size_t numOfBytes, std::vector<OBJMaterial>& out_materials)
+{
+	char const*		cursor		=	text;
+	char const*		end			=	text + numOfBytes;
+	OBJMaterial*	material	=	nullptr;
+	while (cursor < end)
+	{
+		cursor = SkipHorizontalSpace(cursor, end);
+		char const* lineEnd = SkipLine(cursor, end);
+		char const* data	= nullptr;
+		if (IsMTLKeyword(cursor, end, "newmtl", data))
 		{
-			Strings spaceDelimitedList = SplitStringOnDelimiter(currentString, ' ');
-			int spaceDelimitedListSize = (int)spaceDelimitedList.size();
-			if (spaceDelimitedListSize > 3)
-			{
-				float x = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 3].c_str());
-				float y = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-				float z = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 1].c_str());
-				vertexNormalList.emplace_back(x, y, z);
-			}
-			continue;
+			char const*	name		=	nullptr;
+			size_t		nameLength	=	0;
+			ParseRestOfLine(data, end, name, nameLength);
+			out_materials.emplace_back();
+			material			=	&out_materials.back();
+			material->m_name	=	std::string(name, nameLength);
 		}
-		
-		if (firstChar == 'v' && secondChar == 't')
+		else if (material == nullptr)
 		{
-			Strings spaceDelimitedList = SplitStringOnDelimiter(currentString, ' ');
-			int spaceDelimitedListSize = (int)spaceDelimitedList.size();
-			if (spaceDelimitedListSize > 3)
-			{
-				float u = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 3].c_str());
-				float v = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-				vertexTexCoordList.emplace_back(u, v);
-			}
-			else if (spaceDelimitedListSize > 2)
-			{
-				float u = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-				float v = (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 1].c_str());
-				vertexTexCoordList.emplace_back(u, v);
-			}
-			continue;
+			// Comments and anything before the first newmtl
+		}
+		else if (IsMTLKeyword(cursor, end, "Ka", data))
+		{
+			ParseMTLColor(data, end, material->m_ambientColor);
+		}
+		else if (IsMTLKeyword(cursor, end, "Kd", data))
+		{
+			ParseMTLColor(data, end, material->m_diffuseColor);
+		}
+		else if (IsMTLKeyword(cursor, end, "Ks", data))
+		{
+			ParseMTLColor(data, end, material->m_specularColor);
 		}
-		
-		if (firstChar == 'f' && secondChar == ' ')
+		else if (IsMTLKeyword(cursor, end, "Ke", data))
 		{
-			Strings spaceDelimitedList	=	SplitStringOnDelimiter(currentString, ' ');
-			int spaceDelimitedListSize	=	(int)spaceDelimitedList.size(); 
-			// unsigned int indexCount		=	0;
-			std::vector<Vec3> reorderedPosList;
-			std::vector<Vec3> reorderedNormalList;
-			std::vector<Vec2> reorderedUVList;
+			ParseMTLColor(data, end, material->m_emissiveColor);
+		}
+		else if (IsMTLKeyword(cursor, end, "Ns", data))
+		{
+			ParseFloat(SkipHorizontalSpace(data, end), end, material->m_specularExponent);
+		}
+		else if (IsMTLKeyword(cursor, end, "d", data))
+		{
+			ParseFloat(SkipHorizontalSpace(data, end), end, material->m_opacity);
+		}
+		else if (IsMTLKeyword(cursor, end, "Tr", data))
+		{
+			float transparency = 1.f - material->m_opacity;
+			ParseFloat(SkipHorizontalSpace(data, end), end, transparency);
+			material->m_opacity = 1.f - transparency;
+		}
+		else if (IsMTLKeyword(cursor, end, "Ni", data))
+		{
+			ParseFloat(SkipHorizontalSpace(data, end), end, material->m_indexOfRefraction);
+		}
+		else if (IsMTLKeyword(cursor, end, "illum", data))
+		{
+			ParseInt(SkipHorizontalSpace(data, end), end, material->m_illuminationModel);
+		}
+		else if (IsMTLKeyword(cursor, end, "map_Kd", data))
+		{
+			material->m_diffuseMap = ParseMTLTextureMap(data, end);
+		}
+		else if (IsMTLKeyword(cursor, end, "map_Ks", data))
+		{
+			material->m_specularMap = ParseMTLTextureMap(data, end);
+		}
+		else if (IsMTLKeyword(cursor, end, "map_Bump", data) || IsMTLKeyword(cursor, end, "map_bump", data) || IsMTLKeyword(cursor, end, "bump", data) || IsMTLKeyword(cursor, end, "norm", data))
+		{
+			material->m_normalMap = ParseMTLTextureMap(data, end);
+		}
+		else if (IsMTLKeyword(cursor, end, "map_d", data))
+		{
+			material->m_opacityMap = ParseMTLTextureMap(data, end);
+		}
+		cursor = lineEnd;
+	}
+}
 
-			for (int subStringIndex	= 1; subStringIndex < spaceDelimitedListSize; ++subStringIndex)
-			{
-				std::string currentSubString		=	spaceDelimitedList[size_t(subStringIndex)];
-				if (currentSubString == "") continue;
-				Strings forwardSlashDelimitedList	=	SplitStringOnDelimiter(currentSubString, '/');
-				std::string subString1				=	forwardSlashDelimitedList[0];
-				
-				Vec3 pos;
-				int indexIntoPositionList = atoi(subString1.c_str()) - 1;
-				pos = vertexPositionList[indexIntoPositionList];
-				reorderedPosList.emplace_back(pos);
-				++numOfFaces;
-				Vec3 normal;
-				Vec2 uv;
-				if (forwardSlashDelimitedList.size() > 1)
-				{
-					std::string subString2 = forwardSlashDelimitedList[1];
-					std::string subString3 = forwardSlashDelimitedList[2];
 
-					if (subString2 != "")
-					{
-						int indexIntoTextureCoordList =		atoi(subString2.c_str()) - 1;
-						uv							  =		vertexTexCoordList[indexIntoTextureCoordList];
-						reorderedUVList.emplace_back(uv);
-					}
-					if (subString3 != "")
-					{
-						int indexIntoNormalList	=	atoi(subString3.c_str()) - 1;
-						normal					=	vertexNormalList[indexIntoNormalList];
-						reorderedNormalList.emplace_back(normal);
-					}
-				}
-				// out_verts.emplace_back(pos, normal, Rgba8::WHITE, uv);
-				// out_indexes.emplace_back(indexCount);
-				// ++indexCount;
-			}
-			if (reorderedNormalList.size() == 0 && reorderedUVList.size() == 0)
+//--------------------------------------------------------------------------------------------------
+// Writes a grid mesh in the same style as the exported models (v / vt / vn and quads), roughly numOfMegabytes big
+static void WriteBenchmarkOBJFile(std::string const& fileName, int numOfMegabytes)
+{
+	// About 120 bytes of text per grid vertex once its attributes and its share of the faces are written
+	int gridSize = 2;
+	while ((double)gridSize * (double)gridSize * 120.0 < (double)numOfMegabytes * 1024.0 * 1024.0)
+	{
+		++gridSize;
+	}
+
+	std::vector<uint8_t>	fileContents;
+	char					line[128];
+	fileContents.reserve(size_t(numOfMegabytes) * 1024 * 1024 + 1024);
+	for (int pass = 0; pass < 3; ++pass)
+	{
+		for (int y = 0; y < gridSize; ++y)
+		{
+			for (int x = 0; x < gridSize; ++x)
 			{
-				// #ToDo: Rename
-				Vec3 const& vert1	= reorderedPosList[size_t(0)];
-				size_t nextIndex = 1;
-				// for (int vertexIndex = 0; vertexIndex < (int)reorderedPosList.size(); vertexIndex += 3)
-				while (nextIndex < reorderedPosList.size() - 1)
+				float	u			=	(float)x / (float)(gridSize - 1);
+				float	v			=	(float)y / (float)(gridSize - 1);
+				int		numOfChars	=	0;
+				switch (pass)
 				{
-					Vec3 const& vert2	= reorderedPosList[nextIndex];
-					Vec3 const& vert3	= reorderedPosList[nextIndex + 1];
-
-					Vec3 dispFromVert1To2	= vert2 - vert1;
-					Vec3 dispFromVert2To3	= vert3 - vert2;
-					Vec3 vertexNormal		= CrossProduct3D(dispFromVert1To2, dispFromVert2To3);
-					vertexNormal.Normalize();
-
-					Vec3 tangents;
-					Vec3 binormals;
-
-					int vertIndex = (int)out_verts.size();
-					out_verts.emplace_back(reorderedPosList[size_t(0)],		Rgba8::WHITE, Vec2(), tangents, binormals, vertexNormal);
-					out_verts.emplace_back(reorderedPosList[nextIndex],		Rgba8::WHITE, Vec2(), tangents, binormals, vertexNormal);
-					out_verts.emplace_back(reorderedPosList[nextIndex + 1], Rgba8::WHITE, Vec2(), tangents, binormals, vertexNormal);
-
-					out_indexes.emplace_back((unsigned int)vertIndex);
-					out_indexes.emplace_back((unsigned int)vertIndex + 1);
-					out_indexes.emplace_back((unsigned int)vertIndex + 2);
-					
-					++numOfTriangles;
-					nextIndex += 1;
+					case 0:	numOfChars = snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", u * 100.f - 50.f, v * 100.f - 50.f, 0.25f * SinDegrees(u * 1440.f) * CosDegrees(v * 1440.f));	break;
+					case 1:	numOfChars = snprintf(line, sizeof(line), "vt %.6f %.6f\n", u, v);																							break;
+					case 2:	numOfChars = snprintf(line, sizeof(line), "vn %.4f %.4f %.4f\n", 0.05f * CosDegrees(u * 1440.f), -0.05f * SinDegrees(v * 1440.f), 0.9975f);				break;
 				}
+				fileContents.insert(fileContents.end(), line, line + numOfChars);
 			}
-			else if (reorderedNormalList.size() != 0)
-			{
-				if (reorderedUVList.size() == 0)
-				{
-					Vec3 const& vert1	= reorderedPosList[size_t(0)];
-					Vec3 const& normal1 = reorderedNormalList[size_t(0)];
+		}
+	}
+	for (int y = 0; y < gridSize - 1; ++y)
+	{
+		for (int x = 0; x < gridSize - 1; ++x)
+		{
+			int bottomLeft	=	y * gridSize + x + 1;
+			int bottomRight	=	bottomLeft + 1;
+			int topRight	=	bottomRight + gridSize;
+			int topLeft		=	bottomLeft + gridSize;
+			int numOfChars	=	snprintf(line, sizeof(line), "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", bottomLeft, bottomLeft, bottomLeft, bottomRight, bottomRight, bottomRight, topRight, topRight, topRight, topLeft, topLeft, topLeft);
+			fileContents.insert(fileContents.end(), line, line + numOfChars);
+		}
+	}
+	FileWriteFromBuffer(fileContents, fileName);
+}
 
-					size_t nextIndex = 1;
-					while (nextIndex < reorderedPosList.size() - 1)
-					{
-						Vec3 const& vert2 = reorderedPosList[nextIndex];
-						Vec3 const& vert3 = reorderedPosList[nextIndex + 1];
 
-						Vec3 const& normal2 = reorderedNormalList[nextIndex];
-						Vec3 const& normal3 = reorderedNormalList[nextIndex + 1];
+//--------------------------------------------------------------------------------------------------
+// Benchmarks use File=<path> when given, otherwise a generated file of Megabytes size that they delete afterwards
+static bool GetBenchmarkOBJFileName(EventArgs& args, std::string& out_fileName, bool& out_isGeneratedFile)
+{
+	out_fileName		=	args.GetValue("File", "");
+	out_isGeneratedFile	=	out_fileName.empty();
+	if (out_isGeneratedFile)
+	{
+		int numOfMegabytes = args.GetValue("Megabytes", 128);
+		if (numOfMegabytes < 1)
+		{
+			return false;
+		}
+		out_fileName = "Temp/OBJLoadBenchmark.obj";
+		WriteBenchmarkOBJFile(out_fileName, numOfMegabytes);
+	}
+	return DoesFileExist(out_fileName);
+}
 
-						Vec3 binormal;
-						Vec3 tangent;
 
-						int vertIndex = (int)out_verts.size();
-						out_verts.emplace_back(vert1, Rgba8::WHITE, Vec2(), tangent, binormal, normal1);
-						out_verts.emplace_back(vert2, Rgba8::WHITE, Vec2(), tangent, binormal, normal2);
-						out_verts.emplace_back(vert3, Rgba8::WHITE, Vec2(), tangent, binormal, normal3);
+//--------------------------------------------------------------------------------------------------
+static bool AreOBJMeshDatasIdentical(OBJMeshData const& meshDataA, OBJMeshData const& meshDataB)
+{
+	return	meshDataA.m_positions.size() == meshDataB.m_positions.size() && meshDataA.m_uvs.size() == meshDataB.m_uvs.size() && meshDataA.m_normals.size() == meshDataB.m_normals.size() &&
+			meshDataA.m_faceCorners.size() == meshDataB.m_faceCorners.size() && meshDataA.m_faceFirstCorners.size() == meshDataB.m_faceFirstCorners.size() &&
+			memcmp(meshDataA.m_positions.data(), meshDataB.m_positions.data(), meshDataA.m_positions.size() * sizeof(Vec3)) == 0 &&
+			memcmp(meshDataA.m_uvs.data(), meshDataB.m_uvs.data(), meshDataA.m_uvs.size() * sizeof(Vec2)) == 0 &&
+			memcmp(meshDataA.m_normals.data(), meshDataB.m_normals.data(), meshDataA.m_normals.size() * sizeof(Vec3)) == 0 &&
+			memcmp(meshDataA.m_faceCorners.data(), meshDataB.m_faceCorners.data(), meshDataA.m_faceCorners.size() * sizeof(OBJFaceCorner)) == 0 &&
+			memcmp(meshDataA.m_faceFirstCorners.data(), meshDataB.m_faceFirstCorners.data(), meshDataA.m_faceFirstCorners.size() * sizeof(unsigned int)) == 0 &&
+			meshDataA.m_materialLibraries == meshDataB.m_materialLibraries && meshDataA.m_materialNames == meshDataB.m_materialNames &&
+			meshDataA.m_materialRanges.size() == meshDataB.m_materialRanges.size() &&
+			memcmp(meshDataA.m_materialRanges.data(), meshDataB.m_materialRanges.data(), meshDataA.m_materialRanges.size() * sizeof(OBJMaterialRange)) == 0;
+}
 
-						out_indexes.emplace_back((unsigned int)vertIndex);
-						out_indexes.emplace_back((unsigned int)vertIndex + 1);
-						out_indexes.emplace_back((unsigned int)vertIndex + 2);
 
-						++numOfTriangles;
-						nextIndex += 1;
-					}
-					//for (int vertexIndex = 0; vertexIndex < (int)reorderedPosList.size(); ++vertexIndex)
-					//{
-					//	int vertIndex = int(out_verts.size());
-					//	out_verts.emplace_back(reorderedPosList[size_t(vertexIndex)], reorderedNormalList[size_t(vertexIndex)], Rgba8::WHITE);
-					//	out_indexes.emplace_back((unsigned int)vertIndex);
-					//}
-				}
-				else
-				{
-					Vec3 const& vert1	= reorderedPosList[size_t(0)];
-					Vec3 const& normal1 = reorderedNormalList[size_t(0)];
-					Vec2 const& uv1		= reorderedUVList[size_t(0)];
+//--------------------------------------------------------------------------------------------------
+bool Command_OBJLoadBenchmark(EventArgs& args)
+{
+	int numOfIterations = args.GetValue("Iterations", 3);
+	if (numOfIterations < 1)
+	{
+		return false;
+	}
 
-					size_t nextIndex = 1;
-					while (nextIndex < reorderedPosList.size() - 1)
-					{
-						Vec3 const& vert2 = reorderedPosList[nextIndex];
-						Vec3 const& vert3 = reorderedPosList[nextIndex + 1];
+	std::string	fileName;
+	bool		isGeneratedFile	=	false;
+	if (!GetBenchmarkOBJFileName(args, fileName, isGeneratedFile))
+	{
+		return false;
+	}
 
-						Vec3 const& normal2 = reorderedNormalList[nextIndex];
-						Vec3 const& normal3 = reorderedNormalList[nextIndex + 1];
+	double	fileMegabytes	=	(double)std::filesystem::file_size(fileName) / (1024.0 * 1024.0);
+	double	bestSeconds		=	0.0;
+	int		numOfVerts		=	0;
+	for (int iteration = 0; iteration < numOfIterations; ++iteration)
+	{
+		std::vector<Vertex_PCU>		verts;
+		std::vector<unsigned int>	indexes;
+		double timeBeforeLoad = GetCurrentTimeSeconds();
+		OBJLoader::LoadOBJFileByName(fileName, verts, indexes, Mat44(), false);
+		double loadSeconds = GetCurrentTimeSeconds() - timeBeforeLoad;
+		bestSeconds	= (iteration == 0 || loadSeconds < bestSeconds) ? loadSeconds : bestSeconds;
+		numOfVerts	= (int)verts.size();
+	}
 
-						Vec2 const& uv2 = reorderedUVList[nextIndex];
-						Vec2 const& uv3 = reorderedUVList[nextIndex + 1];
+	if (isGeneratedFile)
+	{
+		std::filesystem::remove(fileName);
+	}
 
-						Vec3 tangent;
-						Vec3 binormal;
+	PrintBenchmarkResult(Stringf("OBJLoader: %.1f MB -> %d verts, best of %d loads %.1f ms (%.0f MB/s)", fileMegabytes, numOfVerts, numOfIterations, bestSeconds * 1000.0, fileMegabytes / bestSeconds));
+	return true;
+}
 
-						int vertIndex = (int)out_verts.size();
-						out_verts.emplace_back(vert1, Rgba8::WHITE, uv1, tangent, binormal, normal1);
-						out_verts.emplace_back(vert2, Rgba8::WHITE, uv2, tangent, binormal, normal2);
-						out_verts.emplace_back(vert3, Rgba8::WHITE, uv3, tangent, binormal, normal3);
 
-						out_indexes.emplace_back((unsigned int)vertIndex);
-						out_indexes.emplace_back((unsigned int)vertIndex + 1);
-						out_indexes.emplace_back((unsigned int)vertIndex + 2);
+//--------------------------------------------------------------------------------------------------
+// Parses the same mapped file serially, then in parallel on a private JobSystem per thread count (its workers plus the calling thread)
+bool Command_OBJParseScalingBenchmark(EventArgs& args)
+{
+	int numOfIterations	=	args.GetValue("Iterations", 3);
+	int maxNumOfThreads	=	args.GetValue("MaxThreads", 32);
+	if (numOfIterations < 1 || maxNumOfThreads < 1)
+	{
+		return false;
+	}
 
-						++numOfTriangles;
-						nextIndex += 1;
-					}
-					// for (int vertexIndex = 0; vertexIndex < (int)reorderedPosList.size(); ++vertexIndex)
-					// {
-					// 	int vertIndex = int(out_verts.size());
-					// 	out_verts.emplace_back(reorderedPosList[size_t(vertexIndex)], reorderedNormalList[size_t(vertexIndex)], Rgba8::WHITE, reorderedUVList[size_t(vertexIndex)]);
-					// 	out_indexes.emplace_back((unsigned int)vertIndex);
-					// 
-					// }
-				}
-			}
-		}
+	std::string	fileName;
+	bool		isGeneratedFile	=	false;
+	if (!GetBenchmarkOBJFileName(args, fileName, isGeneratedFile))
+	{
+		return false;
+	}
+
+	MemoryMappedFile objFile;
+	if (!objFile.Open(fileName))
+	{
+		return false;
+	}
+	char const*	text			=	reinterpret_cast<char const*>(objFile.GetData());
+	double		fileMegabytes	=	(double)objFile.GetSize() / (1024.0 * 1024.0);
 
-		/// if (firstChar == 'v')
-		/// {
-		/// 	if (secondChar == ' ')
-		/// 	{
-		/// 		Strings spaceDelimitedList	=	SplitStringOnDelimiter(currentString, ' ');
-		/// 		int spaceDelimitedListSize	=	(int)spaceDelimitedList.size();
-		/// 		if (spaceDelimitedListSize > 3)
-		/// 		{
-		/// 			std::string test1 =	spaceDelimitedList[size_t(spaceDelimitedListSize) - 3];
-		/// 			
-		/// 			float x		=   (float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 3].c_str());
-		/// 			float y		=	(float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 2].c_str());
-		/// 			float z		=	(float)atof(spaceDelimitedList[size_t(spaceDelimitedListSize) - 1].c_str());
-		/// 			vertexPositionList.emplace_back(x, y, z);
-		/// 		}
-		/// 	}
-		/// 	else if (secondChar == 't')
-		/// 	{
-		/// 		// Texture Coords
-		/// 	}
-		/// 	else if (secondChar == 'n')
-		/// 	{
-		/// 		// Vertex Normal
-		/// 	}
-		/// }
-		/// else if (firstChar == 'f')
-		/// {
-		/// 	// Face elements
-		/// }
-	}
-
-	if (out_verts.size() == 0)
-	{
-		for (int vertexIndex = 0; vertexIndex < (int)vertexPositionList.size(); vertexIndex += 3)
-		{
-			Vec3 const& vert1 = vertexPositionList[size_t(vertexIndex)];
-			Vec3 const& vert2 = vertexPositionList[size_t(vertexIndex) + 1];
-			Vec3 const& vert3 = vertexPositionList[size_t(vertexIndex) + 2];
-		
-			Vec3 dispFromVert1To2 = vert2 - vert1;
-			Vec3 dispFromVert2To3 = vert3 - vert2;
-			Vec3 vertexNormal = CrossProduct3D(dispFromVert1To2, dispFromVert2To3);
-			vertexNormal.Normalize();
-
-			Vec3 tangent;
-			Vec3 binormal;
-
-			out_verts.emplace_back(vertexPositionList[size_t(vertexIndex)],		Rgba8::WHITE, Vec2(), tangent, binormal, vertexNormal);
-			out_verts.emplace_back(vertexPositionList[size_t(vertexIndex) + 1], Rgba8::WHITE, Vec2(), tangent, binormal, vertexNormal);
-			out_verts.emplace_back(vertexPositionList[size_t(vertexIndex) + 2], Rgba8::WHITE, Vec2(), tangent, binormal, vertexNormal);
-
-			out_indexes.emplace_back((unsigned int)vertexIndex);
-			out_indexes.emplace_back((unsigned int)vertexIndex + 1);
-			out_indexes.emplace_back((unsigned int)vertexIndex + 2);
-
-			++numOfTriangles;
+	OBJMeshData	serialMeshData;
+	double		serialSeconds	=	0.0;
+	for (int iteration = 0; iteration < numOfIterations; ++iteration)
+	{
+		serialMeshData = OBJMeshData();
+		double timeBeforeParse = GetCurrentTimeSeconds();
+		OBJLoader::ParseOBJText(text, objFile.GetSize(), serialMeshData);
+		double parseSeconds = GetCurrentTimeSeconds() - timeBeforeParse;
+		serialSeconds = (iteration == 0 || parseSeconds < serialSeconds) ? parseSeconds : serialSeconds;
+	}
+	PrintBenchmarkResult(Stringf("OBJ parse scaling: %.1f MB, serial %.1f ms (%.0f MB/s)", fileMegabytes, serialSeconds * 1000.0, fileMegabytes / serialSeconds));
+
+	bool areAllIdentical = true;
+	for (int numOfThreads = 1; numOfThreads <= maxNumOfThreads; numOfThreads *= 2)
+	{
+		JobSystemConfig jobSystemConfig;
+		jobSystemConfig.m_numOfWorkerThreads = numOfThreads - 1;
+		JobSystem jobSystem(jobSystemConfig);
+		jobSystem.Startup();
+
+		OBJMeshData	parallelMeshData;
+		double		parallelSeconds	=	0.0;
+		for (int iteration = 0; iteration < numOfIterations; ++iteration)
+		{
+			parallelMeshData = OBJMeshData();
+			double timeBeforeParse = GetCurrentTimeSeconds();
+			OBJLoader::ParseOBJTextParallel(text, objFile.GetSize(), parallelMeshData, jobSystem);
+			double parseSeconds = GetCurrentTimeSeconds() - timeBeforeParse;
+			parallelSeconds = (iteration == 0 || parseSeconds < parallelSeconds) ? parseSeconds : parallelSeconds;
 		}
+		jobSystem.Shutdown();
+
+		bool isIdentical = AreOBJMeshDatasIdentical(serialMeshData, parallelMeshData);
+		areAllIdentical &= isIdentical;
+		PrintBenchmarkResult(Stringf("  %2d threads: %.1f ms (%.0f MB/s), %.2fx serial, %s", numOfThreads, parallelSeconds * 1000.0, fileMegabytes / parallelSeconds, serialSeconds / parallelSeconds, isIdentical ? "identical" : "MISMATCH"), !isIdentical);
 	}
-	double timeAfterCreatingVertexesAndIndexes = GetCurrentTimeSeconds();
-	double timeTakenToCreateVertexesAndIndexes = timeAfterCreatingVertexesAndIndexes - timeBeforeCreatingVertexesAndIndexes;
-	TransformVertexArray3D(out_verts, transformFixUpMat);
 
-	DebuggerPrintf("\n--------------------------------------------------------------------------------------------------");
-	DebuggerPrintf("\nLoaded .obj file %s", fileName.c_str());
-	DebuggerPrintf("\n[file data]    vertexes: %d    texture coordinates: %d    normals: %d    faces: %d    triangles: %d", (int)vertexPositionList.size(), (int)vertexTexCoordList.size(), (int)vertexNormalList.size(), numOfFaces, numOfTriangles);
-	DebuggerPrintf("\n[loaded mesh]  vertexes: %d    indexes: %d", (int)out_verts.size(), (int)out_indexes.size());
-	DebuggerPrintf("\n[time]         parse: %f    create: %f", timeTakenToParseAndLoadFileIntoMemory, timeTakenToCreateVertexesAndIndexes);
-	DebuggerPrintf("\n--------------------------------------------------------------------------------------------------\n\n");
+	objFile.Close();
+	if (isGeneratedFile)
+	{
+		std::filesystem::remove(fileName);
+	}
+	return areAllIdentical;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// For every .obj in Folder: a cold load (parse, tangents and cook), a warm load into a mapped CPUMesh and a warm load copied into vectors
+bool Command_CookedMeshBenchmark(EventArgs& args)
+{
+	std::vector<std::string>	fileNames	=	GetFileNamesInFolder(args.GetValue("Folder", "Data/Models"), { ".obj" });
+	std::error_code				errorCode;
+
+	double totalColdSeconds			=	0.0;
+	double totalWarmMappedSeconds	=	0.0;
+	double totalWarmCopiedSeconds	=	0.0;
+	for (size_t fileIndex = 0; fileIndex < fileNames.size(); ++fileIndex)
+	{
+		std::string const& fileName = fileNames[fileIndex];
+		std::filesystem::remove(GetCookedMeshFileName(fileName, CookedMeshVertexFormat::PCUTBN, Mat44()), errorCode);
+
+		double	timeBeforeColdLoad	=	GetCurrentTimeSeconds();
+		CPUMesh	coldMesh;
+		OBJLoader::LoadOBJFileIntoCPUMesh(fileName, coldMesh, Mat44());
+		double	coldSeconds			=	GetCurrentTimeSeconds() - timeBeforeColdLoad;
+
+		double	timeBeforeWarmLoad	=	GetCurrentTimeSeconds();
+		CPUMesh	warmMesh;
+		OBJLoader::LoadOBJFileIntoCPUMesh(fileName, warmMesh, Mat44());
+		double	warmMappedSeconds	=	GetCurrentTimeSeconds() - timeBeforeWarmLoad;
+
+		std::vector<Vertex_PCUTBN>	verts;
+		std::vector<unsigned int>	indexes;
+		double timeBeforeCopiedLoad = GetCurrentTimeSeconds();
+		OBJLoader::LoadOBJFileByName(fileName, verts, indexes, Mat44());
+		double warmCopiedSeconds = GetCurrentTimeSeconds() - timeBeforeCopiedLoad;
+
+		totalColdSeconds		+=	coldSeconds;
+		totalWarmMappedSeconds	+=	warmMappedSeconds;
+		totalWarmCopiedSeconds	+=	warmCopiedSeconds;
+		PrintBenchmarkResult(Stringf("%-28s %8d verts  cold %8.2f ms  warm mapped %7.3f ms (%s)  warm copied %7.2f ms", fileName.c_str(), (int)warmMesh.GetNumOfVerts(),
+									 coldSeconds * 1000.0, warmMappedSeconds * 1000.0, warmMesh.IsMapped() ? "zero copy" : "NOT MAPPED", warmCopiedSeconds * 1000.0), !warmMesh.IsMapped());
+	}
+	PrintBenchmarkResult(Stringf("%d files: cold %.2f ms, warm mapped %.3f ms, warm copied %.2f ms", (int)fileNames.size(), totalColdSeconds * 1000.0, totalWarmMappedSeconds * 1000.0, totalWarmCopiedSeconds * 1000.0));
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Triangle corner positions sorted, so two meshes compare equal when they have the same triangles in any order
+static std::vector<Vec3> GetSortedTrianglePositions(std::vector<Vertex_PCU> const& verts, std::vector<unsigned int> const& indexes)
+{
+	std::vector<Vec3> positions(indexes.size());
+	for (size_t indexIndex = 0; indexIndex < indexes.size(); ++indexIndex)
+	{
+		positions[indexIndex] = verts[indexes[indexIndex]].m_position;
+	}
+
+	std::vector<size_t> triangleOrder(indexes.size() / 3);
+	for (size_t triangleIndex = 0; triangleIndex < triangleOrder.size(); ++triangleIndex)
+	{
+		triangleOrder[triangleIndex] = triangleIndex;
+	}
+	std::sort(triangleOrder.begin(), triangleOrder.end(), [&positions](size_t triangleA, size_t triangleB)
+	{
+		return memcmp(&positions[triangleA * 3], &positions[triangleB * 3], 3 * sizeof(Vec3)) < 0;
+	});
+
+	std::vector<Vec3> sortedPositions(positions.size());
+	for (size_t triangleIndex = 0; triangleIndex < triangleOrder.size(); ++triangleIndex)
+	{
+		memcpy(&sortedPositions[triangleIndex * 3], &positions[triangleOrder[triangleIndex] * 3], 3 * sizeof(Vec3));
+	}
+	return sortedPositions;
+}
+
 
-	CalculateTangentSpaceVectors(out_verts, out_indexes);
-
-	// if (faceList.size() == 0)
-	// {
-	// 	if (vertexNormalList.size() == 0)
-	// 	{
-	// 		for (int vertexIndex = 0; vertexIndex < (int)vertexPositionList.size(); vertexIndex += 3)
-	// 		{
-	// 			Vec3 const& vert1 = vertexPositionList[size_t(vertexIndex)];
-	// 			Vec3 const& vert2 = vertexPositionList[size_t(vertexIndex) + 1];
-	// 			Vec3 const& vert3 = vertexPositionList[size_t(vertexIndex) + 2];
-	// 
-	// 			Vec3 dispFromVert1To2 = vert2 - vert1;
-	// 			Vec3 dispFromVert2To3 = vert3 - vert2;
-	// 			Vec3 vertexNormal = CrossProduct3D(dispFromVert1To2, dispFromVert2To3);
-	// 			vertexNormal.Normalize();
-	// 			vertexNormalList.emplace_back(vertexNormal);
-	// 			vertexNormalList.emplace_back(vertexNormal);
-	// 			vertexNormalList.emplace_back(vertexNormal);
-	// 		}
-	// 	}
-	// 
-	// 	if (vertexTexCoordList.size() == 0)
-	// 	{
-	// 		for (int vertexIndex = 0; vertexIndex < (int)vertexPositionList.size(); vertexIndex += 3)
-	// 		{
-	// 			Vec2 defaultTexCoord;
-	// 			vertexTexCoordList.emplace_back(defaultTexCoord);
-	// 			vertexTexCoordList.emplace_back(defaultTexCoord);
-	// 			vertexTexCoordList.emplace_back(defaultTexCoord);
-	// 
-	// 			// #Temp: figure out where to put this and how to use it
-	// 			out_indexes.emplace_back((unsigned int)(vertexIndex));
-	// 			out_indexes.emplace_back((unsigned int)(vertexIndex) + 1);
-	// 			out_indexes.emplace_back((unsigned int)(vertexIndex) + 2);
-	// 		}
-	// 	}
-	// 
-	// 	for (int vertexIndex = 0; vertexIndex < (int)vertexPositionList.size(); ++vertexIndex)
-	// 	{
-	// 		out_verts.emplace_back(vertexPositionList[size_t(vertexIndex)], vertexNormalList[size_t(vertexIndex)], Rgba8::WHITE);
-	// 	}
-	// }
-}
-
-
-//--------------------------------------------------------------------------------------------------
-void OBJLoader::ParseAndRemoveNewLineAndCarraigeReturnFromFile(std::string const& fileName, Strings& out_delimitedList)
-{
-	// Read file contents
-	std::string objFileContents;
-	FileReadToString(objFileContents, fileName);
-
-	// Split strings on newline and carriage return characters (\n and \r respectively)
-	Strings newLineDelimitedList = SplitStringOnDelimiter(objFileContents, '\r');
-	// #ToDo: Should this be one for loop where I split on \r and parse the text?
-	std::string newLineDelimitedFileContents = "";
-	for (int stringIndex = 0; stringIndex < (int)newLineDelimitedList.size(); ++stringIndex)
-	{
-		std::string const& currentString = newLineDelimitedList[stringIndex];
-		newLineDelimitedFileContents += currentString;
-	}
-	out_delimitedList = SplitStringOnDelimiter(newLineDelimitedFileContents, '\n');
+//--------------------------------------------------------------------------------------------------
+// For every .obj in Folder: loads it grouped by material and checks the submeshes tile the index buffer with the same triangles the ungrouped load has
+bool Command_OBJMaterialCheck(EventArgs& args)
+{
+	std::vector<std::string>	fileNames	=	GetFileNamesInFolder(args.GetValue("Folder", "Data/Models"), { ".obj" });
+
+	bool areAllValid = true;
+	for (size_t fileIndex = 0; fileIndex < fileNames.size(); ++fileIndex)
+	{
+		std::string const&			fileName	=	fileNames[fileIndex];
+		std::vector<Vertex_PCU>		flatVerts;
+		std::vector<unsigned int>	flatIndexes;
+		OBJLoader::LoadOBJFileByName(fileName, flatVerts, flatIndexes, Mat44(), false);
+
+		std::vector<Vertex_PCU>		groupedVerts;
+		std::vector<unsigned int>	groupedIndexes;
+		std::vector<OBJSubmesh>		submeshes;
+		std::vector<OBJMaterial>	materials;
+		OBJLoader::LoadOBJFileWithMaterials(fileName, groupedVerts, groupedIndexes, submeshes, materials, Mat44());
+
+		bool			isValid			=	flatVerts.size() == groupedVerts.size() && flatIndexes.size() == groupedIndexes.size();
+		unsigned int	nextIndex		=	0;
+		for (size_t submeshIndex = 0; submeshIndex < submeshes.size(); ++submeshIndex)
+		{
+			isValid		=	isValid && submeshes[submeshIndex].m_firstIndex == nextIndex && submeshes[submeshIndex].m_materialIndex < (int)materials.size();
+			nextIndex	+=	submeshes[submeshIndex].m_numOfIndexes;
+		}
+		isValid		=	isValid && nextIndex == (unsigned int)groupedIndexes.size();
+		isValid		=	isValid && GetSortedTrianglePositions(flatVerts, flatIndexes) == GetSortedTrianglePositions(groupedVerts, groupedIndexes);
+		areAllValid	=	areAllValid && isValid;
+
+		PrintBenchmarkResult(Stringf("%-28s %8d indexes  %3d materials  %3d draws  %s", fileName.c_str(), (int)groupedIndexes.size(), (int)materials.size(),
+									 (int)submeshes.size(), isValid ? "valid" : "MISMATCH"), !isValid);
+	}
+	return areAllValid;
 }
@@ -4,6 +4,7 @@
 //--------------------------------------------------------------------------------------------------
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/EventSystem.hpp"
 #include "Engine/Math/Mat44.hpp"
 
 
@@ -12,12 +13,133 @@
 #include <string>
 
 
+//--------------------------------------------------------------------------------------------------
+class JobSystem;
+class CPUMesh;
+
+
+//--------------------------------------------------------------------------------------------------
+// Files smaller than twice this parse on the calling thread
+constexpr size_t OBJ_LOADER_MIN_BYTES_PER_CHUNK = 1024 * 1024;
+
+
+//--------------------------------------------------------------------------------------------------
+// Zero based indexes into the OBJMeshData arrays, -1 when the face did not reference that attribute
+struct OBJFaceCorner
+{
+	int m_positionIndex	=	-1;
+	int m_uvIndex		=	-1;
+	int m_normalIndex	=	-1;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// A run of consecutive faces drawn with one material, m_materialIndex is -1 for faces before the first usemtl
+struct OBJMaterialRange
+{
+	int				m_materialIndex		=	-1;
+	unsigned int	m_firstFace			=	0;
+	unsigned int	m_numOfFaces		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Everything a .obj file describes before it gets turned into a vertex format
+// Face faceIndex uses the corners from m_faceFirstCorners[faceIndex] up to the next face's first corner (or the end of m_faceCorners)
+// m_materialRanges cover every face in file order and index into m_materialNames (first use order), empty when there are no faces
+struct OBJMeshData
+{
+	std::vector<Vec3>				m_positions;
+	std::vector<Vec2>				m_uvs;
+	std::vector<Vec3>				m_normals;
+	std::vector<OBJFaceCorner>		m_faceCorners;
+	std::vector<unsigned int>		m_faceFirstCorners;
+	std::vector<std::string>		m_materialLibraries;
+	std::vector<std::string>		m_materialNames;
+	std::vector<OBJMaterialRange>	m_materialRanges;
+
+	int		GetNumOfFaces() const;
+	int		GetNumOfFaceCorners(int faceIndex) const;
+	int		GetNumOfTriangles() const;
+	int		GetNumOfTriangles(OBJMaterialRange const& materialRange) const;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// The parameters of one newmtl block of a .mtl file, ParseMTLFile makes texture map paths relative to the working directory
+struct OBJMaterial
+{
+	std::string		m_name;
+	Vec3			m_ambientColor			=	Vec3(0.f, 0.f, 0.f);		// Ka
+	Vec3			m_diffuseColor			=	Vec3(1.f, 1.f, 1.f);		// Kd
+	Vec3			m_specularColor			=	Vec3(0.f, 0.f, 0.f);		// Ks
+	Vec3			m_emissiveColor			=	Vec3(0.f, 0.f, 0.f);		// Ke
+	float			m_specularExponent		=	0.f;						// Ns
+	float			m_opacity				=	1.f;						// d, or 1 - Tr
+	float			m_indexOfRefraction		=	1.f;						// Ni
+	int				m_illuminationModel		=	-1;							// illum
+	std::string		m_diffuseMap;										// map_Kd
+	std::string		m_specularMap;										// map_Ks
+	std::string		m_normalMap;										// map_Bump, bump or norm
+	std::string		m_opacityMap;										// map_d
+
+	bool			IsTranslucent() const;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Indexes [m_firstIndex, m_firstIndex + m_numOfIndexes) of the shared index buffer, drawn with one material
+struct OBJSubmesh
+{
+	int				m_materialIndex		=	-1;		// Into the loaded materials, -1 for faces before the first usemtl
+	unsigned int	m_firstIndex		=	0;
+	unsigned int	m_numOfIndexes		=	0;
+};
+
+
 //--------------------------------------------------------------------------------------------------
 class OBJLoader
 {
-private:
-	static void ParseAndRemoveNewLineAndCarraigeReturnFromFile(std::string const& fileName, Strings& out_delimitedList);
 public:
-	static void LoadOBJFileByName(std::string const& fileName, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes, Mat44 const& transformFixUpMat);
-	static void LoadOBJFileByName(std::string const& fileName, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes, Mat44 const& transformFixUpMat);
-};
\ No newline at end of file
+	// Memory maps the file and tokenizes it in a single pass, numbers are parsed straight from the mapped bytes
+	// Parses on g_theJobSystem when it has workers and the file is big enough
+	static bool ParseOBJFile(std::string const& fileName, OBJMeshData& out_meshData);
+	static void ParseOBJText(char const* text, size_t numOfBytes, OBJMeshData& out_meshData);
+	// Splits the text into line aligned chunks parsed on jobSystem's workers and the calling thread, the result is identical to ParseOBJText
+	static void ParseOBJTextParallel(char const* text, size_t numOfBytes, OBJMeshData& out_meshData, JobSystem& jobSystem);
+
+	// Polygons are fanned into triangles, every triangle corner gets its own vertex
+	// With useCookedMesh the result is read from the file's cooked mesh (see CookedMesh.hpp) while that is up to date, otherwise it is parsed and cooked
+	static void LoadOBJFileByName(std::string const& fileName, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes, Mat44 const& transformFixUpMat, bool useCookedMesh = true);
+	static void LoadOBJFileByName(std::string const& fileName, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes, Mat44 const& transformFixUpMat, bool useCookedMesh = true);
+	// Cooks the file if needed, then points out_cpuMesh straight into a mapping of the cooked mesh instead of copying it
+	static bool LoadOBJFileIntoCPUMesh(std::string const& fileName, CPUMesh& out_cpuMesh, Mat44 const& transformFixUpMat);
+
+	// Like LoadOBJFileByName but the triangles are grouped by material, one submesh per material (in material order) so a draw per material covers the mesh
+	// out_materials gets one entry per usemtl name, filled in from the file's mtllib files where they have it and left at the defaults otherwise
+	// Always parses the .obj, the cooked mesh cache only holds the ungrouped triangles
+	static bool LoadOBJFileWithMaterials(std::string const& fileName, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes, std::vector<OBJSubmesh>& out_submeshes,
+										 std::vector<OBJMaterial>& out_materials, Mat44 const& transformFixUpMat);
+	static bool LoadOBJFileWithMaterials(std::string const& fileName, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes, std::vector<OBJSubmesh>& out_submeshes,
+										 std::vector<OBJMaterial>& out_materials, Mat44 const& transformFixUpMat);
+	// Appends every newmtl block of the file, returns false if it could not be opened
+	static bool ParseMTLFile(std::string const& fileName, std::vector<OBJMaterial>& out_materials);
+	static void ParseMTLText(char const* text, size_t numOfBytes, std::vector<OBJMaterial>& out_materials);
+
+private:
+	static void AppendTriangles(OBJMeshData const& meshData, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes);
+	static void AppendTriangles(OBJMeshData const& meshData, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes);
+	// The faces of faceRanges in that order, faceRanges has to cover every face exactly once
+	static void AppendTriangles(OBJMeshData const& meshData, std::vector<OBJMaterialRange> const& faceRanges, std::vector<Vertex_PCU>& out_verts, std::vector<unsigned int>& out_indexes);
+	static void AppendTriangles(OBJMeshData const& meshData, std::vector<OBJMaterialRange> const& faceRanges, std::vector<Vertex_PCUTBN>& out_verts, std::vector<unsigned int>& out_indexes);
+	static void LoadMaterials(std::string const& fileName, OBJMeshData const& meshData, std::vector<OBJMaterial>& out_materials);
+	static void GroupFacesByMaterial(OBJMeshData const& meshData, size_t firstIndex, std::vector<OBJMaterialRange>& out_faceRanges, std::vector<OBJSubmesh>& out_submeshes);
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_OBJLoadBenchmark(EventArgs& args);
+bool Command_OBJParseScalingBenchmark(EventArgs& args);
+bool Command_CookedMeshBenchmark(EventArgs& args);
+bool Command_OBJMaterialCheck(EventArgs& args);
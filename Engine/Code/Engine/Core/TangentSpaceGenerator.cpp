@@ -0,0 +1,339 @@
+#include "Engine/Core/TangentSpaceGenerator.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <emmintrin.h>
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// Accumulates the angle weighted corner tangents of a range of triangles
+// Only the window of vertexes the range actually touches gets a buffer, so contiguous meshes stay cheap to split
+class TangentAccumulationJob : public Job
+{
+public:
+	TangentAccumulationJob(std::vector<Vertex_PCUTBN> const& verts, std::vector<unsigned int> const& indexes, unsigned int firstTriangle, unsigned int numOfTriangles);
+	virtual void Execute() override;
+
+public:
+	std::vector<Vertex_PCUTBN> const&	m_verts;
+	std::vector<unsigned int> const&	m_indexes;
+	unsigned int						m_firstTriangle		=	0;
+	unsigned int						m_numOfTriangles	=	0;
+	unsigned int						m_firstVertIndex	=	0;
+	std::vector<Vec3>					m_tangentSums;
+	std::vector<Vec3>					m_bitangentSums;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Sums the per job buffers for a range of vertexes and orthonormalizes them 4 at a time
+class TangentOrthonormalizeJob : public Job
+{
+public:
+	TangentOrthonormalizeJob(std::vector<Vertex_PCUTBN>& verts, std::vector<TangentAccumulationJob*> const& accumulationJobs, unsigned int firstVertIndex, unsigned int numOfVerts);
+	virtual void Execute() override;
+
+public:
+	std::vector<Vertex_PCUTBN>&					m_verts;
+	std::vector<TangentAccumulationJob*> const&	m_accumulationJobs;
+	unsigned int								m_firstVertIndex	=	0;
+	unsigned int								m_numOfVerts		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static __m128 DotProduct(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz)
+{
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Removes the part of the vector along the (unit) plane normal and normalizes what is left, zero length results stay zero
+static void ProjectOntoPlaneAndNormalize(__m128& x, __m128& y, __m128& z, __m128 normalX, __m128 normalY, __m128 normalZ)
+{
+	__m128 alongNormal	=	DotProduct(x, y, z, normalX, normalY, normalZ);
+	x					=	_mm_sub_ps(x, _mm_mul_ps(normalX, alongNormal));
+	y					=	_mm_sub_ps(y, _mm_mul_ps(normalY, alongNormal));
+	z					=	_mm_sub_ps(z, _mm_mul_ps(normalZ, alongNormal));
+	__m128 length		=	_mm_sqrt_ps(DotProduct(x, y, z, x, y, z));
+	__m128 inverseLength =	_mm_and_ps(_mm_cmpgt_ps(length, _mm_setzero_ps()), _mm_div_ps(_mm_set1_ps(1.f), _mm_max_ps(length, _mm_set1_ps(1e-30f))));
+	x					=	_mm_mul_ps(x, inverseLength);
+	y					=	_mm_mul_ps(y, inverseLength);
+	z					=	_mm_mul_ps(z, inverseLength);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Abramowitz and Stegun 4.4.46, absolute error below 2e-7 radians once float rounding is included
+static __m128 ACos(__m128 cosAngle)
+{
+	__m128 x			=	_mm_min_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), cosAngle), _mm_set1_ps(1.f));
+	__m128 polynomial	=	_mm_set1_ps(-0.0012624911f);
+	polynomial			=	_mm_add_ps(_mm_mul_ps(polynomial, x), _mm_set1_ps(0.0066700901f));
+	polynomial			=	_mm_add_ps(_mm_mul_ps(polynomial, x), _mm_set1_ps(-0.0170881256f));
+	polynomial			=	_mm_add_ps(_mm_mul_ps(polynomial, x), _mm_set1_ps(0.0308918810f));
+	polynomial			=	_mm_add_ps(_mm_mul_ps(polynomial, x), _mm_set1_ps(-0.0501743046f));
+	polynomial			=	_mm_add_ps(_mm_mul_ps(polynomial, x), _mm_set1_ps(0.0889789874f));
+	polynomial			=	_mm_add_ps(_mm_mul_ps(polynomial, x), _mm_set1_ps(-0.2145988016f));
+	polynomial			=	_mm_add_ps(_mm_mul_ps(polynomial, x), _mm_set1_ps(1.5707963050f));
+	__m128 angle		=	_mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.f), x)), polynomial);
+	__m128 isNegative	=	_mm_cmplt_ps(cosAngle, _mm_setzero_ps());
+	return _mm_or_ps(_mm_and_ps(isNegative, _mm_sub_ps(_mm_set1_ps(3.14159265f), angle)), _mm_andnot_ps(isNegative, angle));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+TangentAccumulationJob::TangentAccumulationJob(std::vector<Vertex_PCUTBN> const& verts, std::vector<unsigned int> const& indexes, unsigned int firstTriangle, unsigned int numOfTriangles) :
+	m_verts(verts),
+	m_indexes(indexes),
+	m_firstTriangle(firstTriangle),
+	m_numOfTriangles(numOfTriangles)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TangentAccumulationJob::Execute()
+{
+	unsigned int const*	triIndexes		=	m_indexes.data() + (size_t)m_firstTriangle * 3;
+	size_t				numOfIndexes	=	(size_t)m_numOfTriangles * 3;
+	if (numOfIndexes == 0)
+	{
+		return;
+	}
+
+	unsigned int minVertIndex = triIndexes[0];
+	unsigned int maxVertIndex = triIndexes[0];
+	for (size_t index = 1; index < numOfIndexes; ++index)
+	{
+		minVertIndex = triIndexes[index] < minVertIndex ? triIndexes[index] : minVertIndex;
+		maxVertIndex = triIndexes[index] > maxVertIndex ? triIndexes[index] : maxVertIndex;
+	}
+	m_firstVertIndex = minVertIndex;
+	m_tangentSums.assign((size_t)(maxVertIndex - minVertIndex) + 1, Vec3::ZERO);
+	m_bitangentSums.assign((size_t)(maxVertIndex - minVertIndex) + 1, Vec3::ZERO);
+
+	for (size_t index = 0; index < numOfIndexes; index += 3)
+	{
+		unsigned int const		cornerIndexes[3]	=	{ triIndexes[index + 0], triIndexes[index + 1], triIndexes[index + 2] };
+		Vertex_PCUTBN const&	vert0				=	m_verts[cornerIndexes[0]];
+		Vertex_PCUTBN const&	vert1				=	m_verts[cornerIndexes[1]];
+		Vertex_PCUTBN const&	vert2				=	m_verts[cornerIndexes[2]];
+
+		Vec3	edge1		=	vert1.m_position - vert0.m_position;
+		Vec3	edge2		=	vert2.m_position - vert0.m_position;
+		Vec2	uvEdge1		=	vert1.m_uvTexCoords - vert0.m_uvTexCoords;
+		Vec2	uvEdge2		=	vert2.m_uvTexCoords - vert0.m_uvTexCoords;
+		float	uvArea		=	uvEdge1.x * uvEdge2.y - uvEdge2.x * uvEdge1.y;
+		if (fabsf(uvArea) <= 1e-20f)
+		{
+			continue;
+		}
+
+		// Only the direction matters once projected, so scale by the sign of the uv area instead of dividing by it
+		float	orientation	=	uvArea > 0.f ? 1.f : -1.f;
+		Vec3	tangent		=	(edge1 * uvEdge2.y - edge2 * uvEdge1.y) * orientation;
+		Vec3	bitangent	=	(edge2 * uvEdge1.x - edge1 * uvEdge2.x) * orientation;
+
+		// One SIMD lane per triangle corner, the 4th lane duplicates corner 0 and is ignored
+		Vec3 const& normal0	=	vert0.m_normal;
+		Vec3 const& normal1	=	vert1.m_normal;
+		Vec3 const& normal2	=	vert2.m_normal;
+		__m128 normalX		=	_mm_setr_ps(normal0.x, normal1.x, normal2.x, normal0.x);
+		__m128 normalY		=	_mm_setr_ps(normal0.y, normal1.y, normal2.y, normal0.y);
+		__m128 normalZ		=	_mm_setr_ps(normal0.z, normal1.z, normal2.z, normal0.z);
+		Vec3	edge12		=	vert2.m_position - vert1.m_position;
+		__m128 toNextX		=	_mm_setr_ps(edge1.x, edge12.x, -edge2.x, edge1.x);
+		__m128 toNextY		=	_mm_setr_ps(edge1.y, edge12.y, -edge2.y, edge1.y);
+		__m128 toNextZ		=	_mm_setr_ps(edge1.z, edge12.z, -edge2.z, edge1.z);
+		__m128 toPreviousX	=	_mm_setr_ps(edge2.x, -edge1.x, -edge12.x, edge2.x);
+		__m128 toPreviousY	=	_mm_setr_ps(edge2.y, -edge1.y, -edge12.y, edge2.y);
+		__m128 toPreviousZ	=	_mm_setr_ps(edge2.z, -edge1.z, -edge12.z, edge2.z);
+		ProjectOntoPlaneAndNormalize(toNextX, toNextY, toNextZ, normalX, normalY, normalZ);
+		ProjectOntoPlaneAndNormalize(toPreviousX, toPreviousY, toPreviousZ, normalX, normalY, normalZ);
+		__m128 cornerAngle	=	ACos(DotProduct(toNextX, toNextY, toNextZ, toPreviousX, toPreviousY, toPreviousZ));
+
+		__m128 tangentX		=	_mm_set1_ps(tangent.x);
+		__m128 tangentY		=	_mm_set1_ps(tangent.y);
+		__m128 tangentZ		=	_mm_set1_ps(tangent.z);
+		__m128 bitangentX	=	_mm_set1_ps(bitangent.x);
+		__m128 bitangentY	=	_mm_set1_ps(bitangent.y);
+		__m128 bitangentZ	=	_mm_set1_ps(bitangent.z);
+		ProjectOntoPlaneAndNormalize(tangentX, tangentY, tangentZ, normalX, normalY, normalZ);
+		ProjectOntoPlaneAndNormalize(bitangentX, bitangentY, bitangentZ, normalX, normalY, normalZ);
+
+		alignas(16) float lanes[6][4];
+		_mm_store_ps(lanes[0], _mm_mul_ps(tangentX,		cornerAngle));
+		_mm_store_ps(lanes[1], _mm_mul_ps(tangentY,		cornerAngle));
+		_mm_store_ps(lanes[2], _mm_mul_ps(tangentZ,		cornerAngle));
+		_mm_store_ps(lanes[3], _mm_mul_ps(bitangentX,	cornerAngle));
+		_mm_store_ps(lanes[4], _mm_mul_ps(bitangentY,	cornerAngle));
+		_mm_store_ps(lanes[5], _mm_mul_ps(bitangentZ,	cornerAngle));
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			size_t bufferIndex = (size_t)(cornerIndexes[corner] - m_firstVertIndex);
+			m_tangentSums[bufferIndex]		+= Vec3(lanes[0][corner], lanes[1][corner], lanes[2][corner]);
+			m_bitangentSums[bufferIndex]	+= Vec3(lanes[3][corner], lanes[4][corner], lanes[5][corner]);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+TangentOrthonormalizeJob::TangentOrthonormalizeJob(std::vector<Vertex_PCUTBN>& verts, std::vector<TangentAccumulationJob*> const& accumulationJobs, unsigned int firstVertIndex, unsigned int numOfVerts) :
+	m_verts(verts),
+	m_accumulationJobs(accumulationJobs),
+	m_firstVertIndex(firstVertIndex),
+	m_numOfVerts(numOfVerts)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TangentOrthonormalizeJob::Execute()
+{
+	alignas(16) float lanes[9][4];
+	for (unsigned int groupStart = 0; groupStart < m_numOfVerts; groupStart += 4)
+	{
+		unsigned int numOfLanes = m_numOfVerts - groupStart < 4 ? m_numOfVerts - groupStart : 4;
+		for (unsigned int lane = 0; lane < 4; ++lane)
+		{
+			// Pad a partial group by repeating its last vertex, the padding is never written back
+			unsigned int	vertIndex		=	m_firstVertIndex + groupStart + (lane < numOfLanes ? lane : numOfLanes - 1);
+			Vec3 const&		normal			=	m_verts[vertIndex].m_normal;
+			Vec3			tangentSum		=	Vec3::ZERO;
+			Vec3			bitangentSum	=	Vec3::ZERO;
+			for (size_t jobIndex = 0; jobIndex < m_accumulationJobs.size(); ++jobIndex)
+			{
+				TangentAccumulationJob const* job = m_accumulationJobs[jobIndex];
+				if (vertIndex >= job->m_firstVertIndex && (size_t)(vertIndex - job->m_firstVertIndex) < job->m_tangentSums.size())
+				{
+					tangentSum		+= job->m_tangentSums[vertIndex - job->m_firstVertIndex];
+					bitangentSum	+= job->m_bitangentSums[vertIndex - job->m_firstVertIndex];
+				}
+			}
+			lanes[0][lane] = normal.x;			lanes[1][lane] = normal.y;			lanes[2][lane] = normal.z;
+			lanes[3][lane] = tangentSum.x;		lanes[4][lane] = tangentSum.y;		lanes[5][lane] = tangentSum.z;
+			lanes[6][lane] = bitangentSum.x;	lanes[7][lane] = bitangentSum.y;	lanes[8][lane] = bitangentSum.z;
+		}
+
+		__m128 const zero	=	_mm_setzero_ps();
+		__m128 const one	=	_mm_set1_ps(1.f);
+		__m128 normalX		=	_mm_load_ps(lanes[0]);
+		__m128 normalY		=	_mm_load_ps(lanes[1]);
+		__m128 normalZ		=	_mm_load_ps(lanes[2]);
+		__m128 normalLength	=	_mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, normalX), _mm_mul_ps(normalY, normalY)), _mm_mul_ps(normalZ, normalZ)));
+		__m128 inverseNormalLength = _mm_div_ps(one, _mm_max_ps(normalLength, _mm_set1_ps(1e-20f)));
+		normalX				=	_mm_mul_ps(normalX, inverseNormalLength);
+		normalY				=	_mm_mul_ps(normalY, inverseNormalLength);
+		normalZ				=	_mm_mul_ps(normalZ, inverseNormalLength);
+
+		// Gram-Schmidt the summed tangent against the normal
+		__m128 tangentX		=	_mm_load_ps(lanes[3]);
+		__m128 tangentY		=	_mm_load_ps(lanes[4]);
+		__m128 tangentZ		=	_mm_load_ps(lanes[5]);
+		__m128 normalDotTangent = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, tangentX), _mm_mul_ps(normalY, tangentY)), _mm_mul_ps(normalZ, tangentZ));
+		tangentX			=	_mm_sub_ps(tangentX, _mm_mul_ps(normalX, normalDotTangent));
+		tangentY			=	_mm_sub_ps(tangentY, _mm_mul_ps(normalY, normalDotTangent));
+		tangentZ			=	_mm_sub_ps(tangentZ, _mm_mul_ps(normalZ, normalDotTangent));
+
+		// Vertexes that only touched degenerate uv triangles get any tangent perpendicular to their normal, crossed with z up unless the normal is nearly z
+		__m128 isNormalNearlyZ	=	_mm_cmpgt_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), normalZ), _mm_set1_ps(0.9f));
+		__m128 fallbackX		=	_mm_or_ps(_mm_and_ps(isNormalNearlyZ, zero), _mm_andnot_ps(isNormalNearlyZ, _mm_sub_ps(zero, normalY)));
+		__m128 fallbackY		=	_mm_or_ps(_mm_and_ps(isNormalNearlyZ, _mm_sub_ps(zero, normalZ)), _mm_andnot_ps(isNormalNearlyZ, normalX));
+		__m128 fallbackZ		=	_mm_or_ps(_mm_and_ps(isNormalNearlyZ, normalY), _mm_andnot_ps(isNormalNearlyZ, zero));
+		__m128 tangentLengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(tangentX, tangentX), _mm_mul_ps(tangentY, tangentY)), _mm_mul_ps(tangentZ, tangentZ));
+		__m128 isDegenerate		=	_mm_cmple_ps(tangentLengthSquared, _mm_set1_ps(1e-20f));
+		tangentX				=	_mm_or_ps(_mm_and_ps(isDegenerate, fallbackX), _mm_andnot_ps(isDegenerate, tangentX));
+		tangentY				=	_mm_or_ps(_mm_and_ps(isDegenerate, fallbackY), _mm_andnot_ps(isDegenerate, tangentY));
+		tangentZ				=	_mm_or_ps(_mm_and_ps(isDegenerate, fallbackZ), _mm_andnot_ps(isDegenerate, tangentZ));
+		tangentLengthSquared	=	_mm_add_ps(_mm_add_ps(_mm_mul_ps(tangentX, tangentX), _mm_mul_ps(tangentY, tangentY)), _mm_mul_ps(tangentZ, tangentZ));
+		__m128 inverseTangentLength = _mm_div_ps(one, _mm_sqrt_ps(_mm_max_ps(tangentLengthSquared, _mm_set1_ps(1e-30f))));
+		tangentX				=	_mm_mul_ps(tangentX, inverseTangentLength);
+		tangentY				=	_mm_mul_ps(tangentY, inverseTangentLength);
+		tangentZ				=	_mm_mul_ps(tangentZ, inverseTangentLength);
+
+		// The binormal is the exact cross product, flipped when the accumulated bitangent says the uvs are mirrored
+		__m128 crossX			=	_mm_sub_ps(_mm_mul_ps(normalY, tangentZ), _mm_mul_ps(normalZ, tangentY));
+		__m128 crossY			=	_mm_sub_ps(_mm_mul_ps(normalZ, tangentX), _mm_mul_ps(normalX, tangentZ));
+		__m128 crossZ			=	_mm_sub_ps(_mm_mul_ps(normalX, tangentY), _mm_mul_ps(normalY, tangentX));
+		__m128 handedness		=	_mm_add_ps(_mm_add_ps(_mm_mul_ps(crossX, _mm_load_ps(lanes[6])), _mm_mul_ps(crossY, _mm_load_ps(lanes[7]))), _mm_mul_ps(crossZ, _mm_load_ps(lanes[8])));
+		__m128 flipSign			=	_mm_and_ps(_mm_cmplt_ps(handedness, zero), _mm_set1_ps(-0.f));
+		crossX					=	_mm_xor_ps(crossX, flipSign);
+		crossY					=	_mm_xor_ps(crossY, flipSign);
+		crossZ					=	_mm_xor_ps(crossZ, flipSign);
+
+		_mm_store_ps(lanes[0], tangentX);
+		_mm_store_ps(lanes[1], tangentY);
+		_mm_store_ps(lanes[2], tangentZ);
+		_mm_store_ps(lanes[3], crossX);
+		_mm_store_ps(lanes[4], crossY);
+		_mm_store_ps(lanes[5], crossZ);
+		for (unsigned int lane = 0; lane < numOfLanes; ++lane)
+		{
+			Vertex_PCUTBN& vert	=	m_verts[m_firstVertIndex + groupStart + lane];
+			vert.m_tangent		=	Vec3(lanes[0][lane], lanes[1][lane], lanes[2][lane]);
+			vert.m_binormal		=	Vec3(lanes[3][lane], lanes[4][lane], lanes[5][lane]);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void GenerateTangentSpace(std::vector<Vertex_PCUTBN>& vertsToModify, std::vector<unsigned int> const& indexes, size_t firstVertIndex, size_t firstIndex)
+{
+	GUARANTEE_OR_DIE(firstIndex % 3 == 0, "Tangent space has to start on a triangle");
+	if (firstVertIndex >= vertsToModify.size() || firstIndex > indexes.size())
+	{
+		return;
+	}
+	unsigned int firstTriangle	=	(unsigned int)(firstIndex / 3);
+	unsigned int numOfVerts		=	(unsigned int)(vertsToModify.size() - firstVertIndex);
+	unsigned int numOfTriangles	=	(unsigned int)((indexes.size() - firstIndex) / 3);
+
+	// The calling thread helps while it waits, so it counts as a worker
+	unsigned int numOfThreads	=	g_theJobSystem ? (unsigned int)g_theJobSystem->GetNumOfWorkerThreads() + 1 : 1;
+	unsigned int numOfJobs		=	(numOfTriangles + TANGENT_SPACE_MIN_TRIANGLES_PER_JOB - 1) / TANGENT_SPACE_MIN_TRIANGLES_PER_JOB;
+	numOfJobs					=	numOfJobs < numOfThreads ? numOfJobs : numOfThreads;
+	numOfJobs					=	numOfJobs > 0 ? numOfJobs : 1;
+
+	std::vector<TangentAccumulationJob*>	accumulationJobs;
+	std::vector<Job*>						jobs;
+	accumulationJobs.reserve(numOfJobs);
+	jobs.reserve(numOfJobs);
+	unsigned int trianglesPerJob = (numOfTriangles + numOfJobs - 1) / numOfJobs;
+	for (unsigned int jobIndex = 0; jobIndex < numOfJobs; ++jobIndex)
+	{
+		unsigned int firstJobTriangle		=	jobIndex * trianglesPerJob < numOfTriangles ? jobIndex * trianglesPerJob : numOfTriangles;
+		unsigned int numOfJobTriangles		=	numOfTriangles - firstJobTriangle < trianglesPerJob ? numOfTriangles - firstJobTriangle : trianglesPerJob;
+		TangentAccumulationJob* accumulationJob = new TangentAccumulationJob(vertsToModify, indexes, firstTriangle + firstJobTriangle, numOfJobTriangles);
+		accumulationJobs.push_back(accumulationJob);
+		jobs.push_back(accumulationJob);
+	}
+	JobSystem::ExecuteJobsAndWait(g_theJobSystem, jobs);
+
+	// Vertex ranges are multiples of 4 so every job but the last runs full SIMD groups
+	std::vector<Job*> orthonormalizeJobs;
+	orthonormalizeJobs.reserve(numOfJobs);
+	unsigned int vertsPerJob = (((numOfVerts + numOfJobs - 1) / numOfJobs) + 3) & ~3u;
+	for (unsigned int jobFirstVert = 0; jobFirstVert < numOfVerts; jobFirstVert += vertsPerJob)
+	{
+		unsigned int numOfJobVerts = numOfVerts - jobFirstVert < vertsPerJob ? numOfVerts - jobFirstVert : vertsPerJob;
+		orthonormalizeJobs.push_back(new TangentOrthonormalizeJob(vertsToModify, accumulationJobs, (unsigned int)firstVertIndex + jobFirstVert, numOfJobVerts));
+	}
+	JobSystem::ExecuteJobsAndWait(g_theJobSystem, orthonormalizeJobs);
+
+	for (size_t jobIndex = 0; jobIndex < jobs.size(); ++jobIndex)
+	{
+		delete jobs[jobIndex];
+	}
+	for (size_t jobIndex = 0; jobIndex < orthonormalizeJobs.size(); ++jobIndex)
+	{
+		delete orthonormalizeJobs[jobIndex];
+	}
+}
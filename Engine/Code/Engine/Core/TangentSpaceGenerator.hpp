@@ -0,0 +1,23 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+// Meshes smaller than this are not worth splitting across the job system
+constexpr unsigned int TANGENT_SPACE_MIN_TRIANGLES_PER_JOB = 16384;
+
+
+//--------------------------------------------------------------------------------------------------
+// MikkTSpace style tangent frames, matching what baked normal maps expect:
+// every triangle corner contributes its uv derived tangent and bitangent, projected onto the vertex normal's plane and weighted by the corner angle,
+// triangles with degenerate uvs contribute nothing and the binormal keeps the handedness of the uv mapping (mirrored uvs get a flipped binormal)
+// Triangle ranges accumulate in parallel into per job buffers when g_theJobSystem exists, otherwise everything runs on the calling thread
+// Only the triangles from firstIndex on are read and only the verts from firstVertIndex on are written, so a mesh appended to others leaves theirs alone
+void GenerateTangentSpace(std::vector<Vertex_PCUTBN>& vertsToModify, std::vector<unsigned int> const& indexes, size_t firstVertIndex = 0, size_t firstIndex = 0);
@@ -0,0 +1,261 @@
+#include "Engine/Core/UnitPrimitiveCache.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <emmintrin.h>
+#include <string.h>
+#include <math.h>
+#include <mutex>
+#include <map>
+
+
+//--------------------------------------------------------------------------------------------------
+struct UnitPrimitiveKey
+{
+	UnitPrimitiveShape	m_shape			=	UnitPrimitiveShape::SPHERE;
+	int					m_numSlices		=	0;
+	int					m_numStacks		=	0;
+
+	bool operator<(UnitPrimitiveKey const& compare) const
+	{
+		if (m_shape != compare.m_shape)
+		{
+			return m_shape < compare.m_shape;
+		}
+		if (m_numSlices != compare.m_numSlices)
+		{
+			return m_numSlices < compare.m_numSlices;
+		}
+		return m_numStacks < compare.m_numStacks;
+	}
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct CachedUnitPrimitive
+{
+	UnitPrimitiveVerts	m_verts;
+	uint64_t			m_lastUsedLookup	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static std::mutex										s_unitPrimitiveCacheMutex;
+static std::map<UnitPrimitiveKey, CachedUnitPrimitive>	s_unitPrimitiveCache;
+static uint64_t											s_numOfUnitPrimitiveLookups	=	0;
+
+
+//--------------------------------------------------------------------------------------------------
+static void AddVertsForUnitPrimitiveUncached(std::vector<Vertex_PCU>& verts, UnitPrimitiveShape shape, float numSlices, float numStacks)
+{
+	switch (shape)
+	{
+		case UnitPrimitiveShape::SPHERE:
+		{
+			AddVertsForSphere3DUncached(verts, Vec3::WORLD_ORIGIN, 1.f, Rgba8::WHITE, AABB2::ZERO_TO_ONE, (int)numSlices);
+			break;
+		}
+		case UnitPrimitiveShape::UV_SPHERE_Z:
+		{
+			AddVertsForUVSphereZ3DUncached(verts, Vec3::WORLD_ORIGIN, 1.f, numSlices, numStacks, Rgba8::WHITE, AABB2::ZERO_TO_ONE);
+			break;
+		}
+		case UnitPrimitiveShape::CYLINDER_X:
+		{
+			AddVertsForUnitCylinderX3D(verts, numSlices, Rgba8::WHITE, AABB2::ZERO_TO_ONE);
+			break;
+		}
+		case UnitPrimitiveShape::CONE_X:
+		{
+			AddVertsForCone3DUncached(verts, Vec3::WORLD_ORIGIN, Vec3::X_AXIS, 1.f, Rgba8::WHITE, (int)numSlices, AABB2::ZERO_TO_ONE);
+			break;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static UnitPrimitiveVerts GenerateUnitPrimitiveVerts(UnitPrimitiveShape shape, float numSlices, float numStacks)
+{
+	std::shared_ptr<std::vector<Vertex_PCU>> unitVerts = std::make_shared<std::vector<Vertex_PCU>>();
+	AddVertsForUnitPrimitiveUncached(*unitVerts, shape, numSlices, numStacks);
+	unitVerts->shrink_to_fit();
+	return unitVerts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static bool IsCachedTessellation(float numOfDivisions)
+{
+	return numOfDivisions >= 0.f && numOfDivisions <= MAX_CACHED_UNIT_PRIMITIVE_TESSELLATION && floorf(numOfDivisions) == numOfDivisions;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+UnitPrimitiveVerts GetUnitPrimitiveVerts(UnitPrimitiveShape shape, float numSlices, float numStacks)
+{
+	if (!IsCachedTessellation(numSlices) || !IsCachedTessellation(numStacks))
+	{
+		return GenerateUnitPrimitiveVerts(shape, numSlices, numStacks);
+	}
+
+	UnitPrimitiveKey key;
+	key.m_shape		=	shape;
+	key.m_numSlices	=	(int)numSlices;
+	key.m_numStacks	=	(int)numStacks;
+
+	std::lock_guard<std::mutex> lock(s_unitPrimitiveCacheMutex);
+	s_numOfUnitPrimitiveLookups += 1;
+	auto found = s_unitPrimitiveCache.find(key);
+	if (found != s_unitPrimitiveCache.end())
+	{
+		found->second.m_lastUsedLookup = s_numOfUnitPrimitiveLookups;
+		return found->second.m_verts;
+	}
+
+	if ((int)s_unitPrimitiveCache.size() >= MAX_NUM_OF_CACHED_UNIT_PRIMITIVES)
+	{
+		auto leastRecentlyUsed = s_unitPrimitiveCache.begin();
+		for (auto cacheIter = s_unitPrimitiveCache.begin(); cacheIter != s_unitPrimitiveCache.end(); ++cacheIter)
+		{
+			if (cacheIter->second.m_lastUsedLookup < leastRecentlyUsed->second.m_lastUsedLookup)
+			{
+				leastRecentlyUsed = cacheIter;
+			}
+		}
+		s_unitPrimitiveCache.erase(leastRecentlyUsed);
+	}
+
+	CachedUnitPrimitive& cachedPrimitive	=	s_unitPrimitiveCache[key];
+	cachedPrimitive.m_verts					=	GenerateUnitPrimitiveVerts(shape, numSlices, numStacks);
+	cachedPrimitive.m_lastUsedLookup		=	s_numOfUnitPrimitiveLookups;
+	return cachedPrimitive.m_verts;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetNumOfCachedUnitPrimitives()
+{
+	std::lock_guard<std::mutex> lock(s_unitPrimitiveCacheMutex);
+	return (int)s_unitPrimitiveCache.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AddVertsForUnitPrimitiveInstance(std::vector<Vertex_PCU>& verts, std::vector<Vertex_PCU> const& unitVerts, Mat44 const& transform, Rgba8 const& tint, Vec2 const& uvScale, Vec2 const& uvOffset)
+{
+	size_t const firstNewVertIndex = verts.size();
+	verts.resize(firstNewVertIndex + unitVerts.size());
+	Vertex_PCU*			destination	=	verts.data() + firstNewVertIndex;
+	Vertex_PCU const*	source		=	unitVerts.data();
+
+	__m128 const iBasis			=	_mm_loadu_ps(&transform.m_values[Mat44::Ix]);
+	__m128 const jBasis			=	_mm_loadu_ps(&transform.m_values[Mat44::Jx]);
+	__m128 const kBasis			=	_mm_loadu_ps(&transform.m_values[Mat44::Kx]);
+	__m128 const translation	=	_mm_loadu_ps(&transform.m_values[Mat44::Tx]);
+
+	// Position and color are adjacent, so each vertex's first 16 bytes are written as xyz | tint in one store
+	int tintBits = 0;
+	memcpy(&tintBits, &tint, sizeof(tintBits));
+	__m128 const positionMask	=	_mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	__m128 const tintLane		=	_mm_castsi128_ps(_mm_set_epi32(tintBits, 0, 0, 0));
+	__m128 const uvScale4		=	_mm_set_ps(0.f, 0.f, uvScale.y, uvScale.x);
+	__m128 const uvOffset4		=	_mm_set_ps(0.f, 0.f, uvOffset.y, uvOffset.x);
+
+	size_t const numOfVerts = unitVerts.size();
+	for (size_t vertIndex = 0; vertIndex < numOfVerts; ++vertIndex)
+	{
+		// Lane 3 holds the unit vertex's color, it gets masked away below
+		__m128 positionAndColor = _mm_loadu_ps(&source[vertIndex].m_position.x);
+		__m128 x = _mm_shuffle_ps(positionAndColor, positionAndColor, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 y = _mm_shuffle_ps(positionAndColor, positionAndColor, _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 z = _mm_shuffle_ps(positionAndColor, positionAndColor, _MM_SHUFFLE(2, 2, 2, 2));
+
+		__m128 position = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, iBasis), _mm_mul_ps(y, jBasis)), _mm_add_ps(_mm_mul_ps(z, kBasis), translation));
+		_mm_storeu_ps(&destination[vertIndex].m_position.x, _mm_or_ps(_mm_and_ps(position, positionMask), tintLane));
+
+		__m128 uv = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<__m64 const*>(&source[vertIndex].m_uvTexCoords));
+		uv = _mm_add_ps(_mm_mul_ps(uv, uvScale4), uvOffset4);
+		_mm_storel_pi(reinterpret_cast<__m64*>(&destination[vertIndex].m_uvTexCoords), uv);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Command_PrimitiveGenerationBenchmark(EventArgs& args)
+{
+	int numOfShapes		=	args.GetValue("Shapes", 4096);
+	int numOfIterations	=	args.GetValue("Iterations", 8);
+	int numOfSlices		=	args.GetValue("Slices", 32);
+	int numOfStacks		=	args.GetValue("Stacks", 16);
+	if (numOfShapes < 1 || numOfIterations < 1 || numOfSlices < 3 || numOfStacks < 2)
+	{
+		return false;
+	}
+
+	// Same mix DebugRender produces: spheres, cylinders and arrows (cylinder + cone), at varying positions and sizes
+	std::vector<Vertex_PCU> uncachedVerts;
+	std::vector<Vertex_PCU> cachedVerts;
+	double uncachedSeconds	=	0.0;
+	double cachedSeconds	=	0.0;
+	for (int iteration = 0; iteration < numOfIterations; ++iteration)
+	{
+		uncachedVerts.clear();
+		double timeBeforeUncached = GetCurrentTimeSeconds();
+		for (int shapeIndex = 0; shapeIndex < numOfShapes; ++shapeIndex)
+		{
+			Vec3	position	=	Vec3((float)(shapeIndex % 64), (float)(shapeIndex / 64), (float)(shapeIndex % 7));
+			float	radius		=	0.25f + 0.01f * (float)(shapeIndex % 50);
+			switch (shapeIndex % 3)
+			{
+				case 0:	AddVertsForUVSphereZ3DUncached(uncachedVerts, position, radius, (float)numOfSlices, (float)numOfStacks, Rgba8::WHITE, AABB2::ZERO_TO_ONE);	break;
+				case 1:	AddVertsForCylinder3DUncached(uncachedVerts, position, position + Vec3(0.f, 1.f, 2.f), radius, Rgba8::WHITE, numOfSlices, AABB2::ZERO_TO_ONE);	break;
+				case 2:	AddVertsForCone3DUncached(uncachedVerts, position, position + Vec3(1.f, 0.f, 0.5f), radius, Rgba8::WHITE, numOfSlices, AABB2::ZERO_TO_ONE);		break;
+			}
+		}
+		uncachedSeconds += GetCurrentTimeSeconds() - timeBeforeUncached;
+
+		cachedVerts.clear();
+		double timeBeforeCached = GetCurrentTimeSeconds();
+		for (int shapeIndex = 0; shapeIndex < numOfShapes; ++shapeIndex)
+		{
+			Vec3	position	=	Vec3((float)(shapeIndex % 64), (float)(shapeIndex / 64), (float)(shapeIndex % 7));
+			float	radius		=	0.25f + 0.01f * (float)(shapeIndex % 50);
+			switch (shapeIndex % 3)
+			{
+				case 0:	AddVertsForUVSphereZ3D(cachedVerts, position, radius, (float)numOfSlices, (float)numOfStacks);		break;
+				case 1:	AddVertsForCylinder3D(cachedVerts, position, position + Vec3(0.f, 1.f, 2.f), radius, Rgba8::WHITE, numOfSlices);	break;
+				case 2:	AddVertsForCone3D(cachedVerts, position, position + Vec3(1.f, 0.f, 0.5f), radius, Rgba8::WHITE, numOfSlices);		break;
+			}
+		}
+		cachedSeconds += GetCurrentTimeSeconds() - timeBeforeCached;
+	}
+
+	// Both paths must agree, otherwise the speedup means nothing
+	float maxPositionError	=	0.f;
+	float maxUVError		=	0.f;
+	bool  sameVertCount		=	uncachedVerts.size() == cachedVerts.size();
+	for (size_t vertIndex = 0; sameVertCount && vertIndex < cachedVerts.size(); ++vertIndex)
+	{
+		Vec3 positionError	=	cachedVerts[vertIndex].m_position - uncachedVerts[vertIndex].m_position;
+		Vec2 uvError		=	cachedVerts[vertIndex].m_uvTexCoords - uncachedVerts[vertIndex].m_uvTexCoords;
+		maxPositionError	=	positionError.GetLength() > maxPositionError ? positionError.GetLength() : maxPositionError;
+		maxUVError			=	uvError.GetLength() > maxUVError ? uvError.GetLength() : maxUVError;
+	}
+
+	double		totalShapes		=	(double)numOfShapes * (double)numOfIterations;
+	std::string timingResult	=	Stringf("Primitives: %d verts per pass, uncached %.0f shapes/s, cached %.0f shapes/s (%.2fx), %d unit shapes cached", (int)cachedVerts.size(), totalShapes / uncachedSeconds, totalShapes / cachedSeconds, uncachedSeconds / cachedSeconds, GetNumOfCachedUnitPrimitives());
+	std::string errorResult		=	Stringf("Primitives: %s, max position error %g, max uv error %g", sameVertCount ? "vert counts match" : "VERT COUNT MISMATCH", maxPositionError, maxUVError);
+	DebuggerPrintf("\n%s\n%s\n", timingResult.c_str(), errorResult.c_str());
+	if (g_theDevConsole)
+	{
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, timingResult);
+		g_theDevConsole->AddLine(sameVertCount ? DevConsole::INFO_MINOR : DevConsole::ERROR, errorResult);
+	}
+	return true;
+}
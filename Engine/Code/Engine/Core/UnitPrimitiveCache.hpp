@@ -0,0 +1,49 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Math/Mat44.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <memory>
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+// Unit shapes the PCU AddVertsFor* helpers instance from instead of re-evaluating sin/cos for every shape
+// Spheres are centered on the origin with radius 1, cylinders and cones run from the origin to +X with radius 1
+enum class UnitPrimitiveShape : unsigned char
+{
+	SPHERE,			// AddVertsForSphere3D, numSlices is the latitude slice count
+	UV_SPHERE_Z,	// AddVertsForUVSphereZ3D
+	CYLINDER_X,		// AddVertsForCylinder3D
+	CONE_X,			// AddVertsForCone3D
+};
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int	MAX_NUM_OF_CACHED_UNIT_PRIMITIVES			=	64;			// The least recently used one is evicted past this
+constexpr float	MAX_CACHED_UNIT_PRIMITIVE_TESSELLATION		=	1024.f;		// Slices or stacks above this are generated every time
+
+
+//--------------------------------------------------------------------------------------------------
+typedef std::shared_ptr<std::vector<Vertex_PCU> const> UnitPrimitiveVerts;
+
+
+//--------------------------------------------------------------------------------------------------
+// Generated with white tint and AABB2::ZERO_TO_ONE uvs, cached per (shape, slices, stacks) when the slices and stacks are whole numbers
+// up to MAX_CACHED_UNIT_PRIMITIVE_TESSELLATION, anything else is generated for this call alone so varying tessellation cannot grow the cache
+// Thread safe, the caller's pointer keeps the verts alive after the cache evicts them
+UnitPrimitiveVerts GetUnitPrimitiveVerts(UnitPrimitiveShape shape, float numSlices, float numStacks = 0.f);
+int GetNumOfCachedUnitPrimitives();
+
+// SSE2 instancing kernel: appends unitVerts with positions transformed by transform, colors replaced by tint and uvs remapped to uv * uvScale + uvOffset
+void AddVertsForUnitPrimitiveInstance(std::vector<Vertex_PCU>& verts, std::vector<Vertex_PCU> const& unitVerts, Mat44 const& transform, Rgba8 const& tint, Vec2 const& uvScale = Vec2(1.f, 1.f), Vec2 const& uvOffset = Vec2(0.f, 0.f));
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_PrimitiveGenerationBenchmark(EventArgs& args);
@@ -0,0 +1,565 @@
+#include "Engine/Core/VertexQuantization.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/OBJLoader.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/RandomNumberGenerator.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <emmintrin.h>
+#include <float.h>
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// 4 vertexes worth of float attributes, one lane per vertex
+struct VertexLanes
+{
+	__m128 m_positionX,	m_positionY,	m_positionZ;
+	__m128 m_normalX,	m_normalY,		m_normalZ;
+	__m128 m_tangentX,	m_tangentY,		m_tangentZ;
+	__m128 m_binormalX,	m_binormalY,	m_binormalZ;
+	__m128 m_u,			m_v;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+static __m128 Select(__m128 mask, __m128 ifTrue, __m128 ifFalse)
+{
+	return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static __m128 Abs(__m128 value)
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.f), value);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// +1 or -1 with the sign of value, zero counts as positive
+static __m128 SignNotZero(__m128 value)
+{
+	return _mm_or_ps(_mm_set1_ps(1.f), _mm_and_ps(_mm_set1_ps(-0.f), value));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Projects the directions onto the octahedron and unfolds the lower half over the diagonals, the result is in [-1, 1]
+static void EncodeOctahedral(__m128 x, __m128 y, __m128 z, __m128& out_u, __m128& out_v)
+{
+	__m128 manhattanLength		=	_mm_add_ps(_mm_add_ps(Abs(x), Abs(y)), Abs(z));
+	__m128 inverseLength		=	_mm_div_ps(_mm_set1_ps(1.f), _mm_max_ps(manhattanLength, _mm_set1_ps(1e-20f)));
+	__m128 projectedU			=	_mm_mul_ps(x, inverseLength);
+	__m128 projectedV			=	_mm_mul_ps(y, inverseLength);
+	__m128 foldedU				=	_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.f), Abs(projectedV)), SignNotZero(projectedU));
+	__m128 foldedV				=	_mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.f), Abs(projectedU)), SignNotZero(projectedV));
+	__m128 isLowerHemisphere	=	_mm_cmplt_ps(z, _mm_setzero_ps());
+	out_u = Select(isLowerHemisphere, foldedU, projectedU);
+	out_v = Select(isLowerHemisphere, foldedV, projectedV);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void DecodeOctahedral(__m128 u, __m128 v, __m128& out_x, __m128& out_y, __m128& out_z)
+{
+	__m128 z		=	_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.f), Abs(u)), Abs(v));
+	__m128 fold		=	_mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+	__m128 x		=	_mm_sub_ps(u, _mm_mul_ps(fold, SignNotZero(u)));
+	__m128 y		=	_mm_sub_ps(v, _mm_mul_ps(fold, SignNotZero(v)));
+	__m128 length	=	_mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+	out_x = _mm_div_ps(x, length);
+	out_y = _mm_div_ps(y, length);
+	out_z = _mm_div_ps(z, length);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Round to nearest even float -> half, NaN and overflow map to inf/NaN and tiny values to half denormals
+// The half ends up in the low 16 bits of each lane
+static __m128i FloatToHalf(__m128 value)
+{
+	__m128i const	subnormalMagic		=	_mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+	__m128 const	signMask			=	_mm_castsi128_ps(_mm_set1_epi32((int)0x80000000));
+	__m128			sign				=	_mm_and_ps(signMask, value);
+	__m128			absValue			=	_mm_xor_ps(value, sign);
+	__m128i			absBits				=	_mm_castps_si128(absValue);
+
+	__m128i			isNaN				=	_mm_castps_si128(_mm_cmpunord_ps(absValue, absValue));
+	__m128i			isRegular			=	_mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), absBits);
+	__m128i			infOrNaN			=	_mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7C00));
+	__m128i			isSubnormal			=	_mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), absBits);
+
+	// Let the float adder do the denormal rounding
+	__m128i			subnormal			=	_mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absValue, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+	// Rebias the exponent, round half to even on the mantissa and shift into place
+	__m128i			mantissaOdd			=	_mm_srai_epi32(_mm_slli_epi32(absBits, 31 - 13), 31);
+	__m128i			rounded				=	_mm_sub_epi32(_mm_add_epi32(absBits, _mm_set1_epi32(0xFFF - ((127 - 15) << 23))), mantissaOdd);
+	__m128i			normal				=	_mm_srli_epi32(rounded, 13);
+
+	__m128i			finite				=	_mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+	__m128i			half				=	_mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, infOrNaN));
+	return _mm_or_si128(half, _mm_srli_epi32(_mm_castps_si128(sign), 16));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Expects the half in the low 16 bits of each lane
+static __m128 HalfToFloat(__m128i half)
+{
+	__m128i	exponentAndMantissa	=	_mm_and_si128(half, _mm_set1_epi32(0x7FFF));
+	__m128i	sign				=	_mm_slli_epi32(_mm_xor_si128(half, exponentAndMantissa), 16);
+	// Multiplying by 2^112 rebiases the exponent and turns half denormals into float normals
+	__m128	scaled				=	_mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(exponentAndMantissa, 13)), _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+	__m128i	wasInfOrNaN			=	_mm_cmpgt_epi32(exponentAndMantissa, _mm_set1_epi32(0x7BFF));
+	__m128	infOrNaNExponent	=	_mm_and_ps(_mm_castsi128_ps(wasInfOrNaN), _mm_castsi128_ps(_mm_set1_epi32(255 << 23)));
+	return _mm_or_ps(scaled, _mm_or_ps(_mm_castsi128_ps(sign), infOrNaNExponent));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void LoadVertexLanes(Vertex_PCUTBN const* vertexes, VertexLanes& out_lanes)
+{
+	Vertex_PCUTBN const& v0 = vertexes[0];
+	Vertex_PCUTBN const& v1 = vertexes[1];
+	Vertex_PCUTBN const& v2 = vertexes[2];
+	Vertex_PCUTBN const& v3 = vertexes[3];
+	out_lanes.m_positionX	=	_mm_setr_ps(v0.m_position.x,	v1.m_position.x,	v2.m_position.x,	v3.m_position.x);
+	out_lanes.m_positionY	=	_mm_setr_ps(v0.m_position.y,	v1.m_position.y,	v2.m_position.y,	v3.m_position.y);
+	out_lanes.m_positionZ	=	_mm_setr_ps(v0.m_position.z,	v1.m_position.z,	v2.m_position.z,	v3.m_position.z);
+	out_lanes.m_normalX		=	_mm_setr_ps(v0.m_normal.x,		v1.m_normal.x,		v2.m_normal.x,		v3.m_normal.x);
+	out_lanes.m_normalY		=	_mm_setr_ps(v0.m_normal.y,		v1.m_normal.y,		v2.m_normal.y,		v3.m_normal.y);
+	out_lanes.m_normalZ		=	_mm_setr_ps(v0.m_normal.z,		v1.m_normal.z,		v2.m_normal.z,		v3.m_normal.z);
+	out_lanes.m_tangentX	=	_mm_setr_ps(v0.m_tangent.x,		v1.m_tangent.x,		v2.m_tangent.x,		v3.m_tangent.x);
+	out_lanes.m_tangentY	=	_mm_setr_ps(v0.m_tangent.y,		v1.m_tangent.y,		v2.m_tangent.y,		v3.m_tangent.y);
+	out_lanes.m_tangentZ	=	_mm_setr_ps(v0.m_tangent.z,		v1.m_tangent.z,		v2.m_tangent.z,		v3.m_tangent.z);
+	out_lanes.m_binormalX	=	_mm_setr_ps(v0.m_binormal.x,	v1.m_binormal.x,	v2.m_binormal.x,	v3.m_binormal.x);
+	out_lanes.m_binormalY	=	_mm_setr_ps(v0.m_binormal.y,	v1.m_binormal.y,	v2.m_binormal.y,	v3.m_binormal.y);
+	out_lanes.m_binormalZ	=	_mm_setr_ps(v0.m_binormal.z,	v1.m_binormal.z,	v2.m_binormal.z,	v3.m_binormal.z);
+	out_lanes.m_u			=	_mm_setr_ps(v0.m_uvTexCoords.x,	v1.m_uvTexCoords.x,	v2.m_uvTexCoords.x,	v3.m_uvTexCoords.x);
+	out_lanes.m_v			=	_mm_setr_ps(v0.m_uvTexCoords.y,	v1.m_uvTexCoords.y,	v2.m_uvTexCoords.y,	v3.m_uvTexCoords.y);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void EncodeFourVertexes(Vertex_PCUTBN const* vertexes, __m128 const& mins, __m128 const& quantizeScale, Vertex_PCUTBN_Quantized* out_quantizedVertexes)
+{
+	VertexLanes lanes;
+	LoadVertexLanes(vertexes, lanes);
+
+	// Positions, rounded to the nearest of the 65536 steps across the bounds
+	__m128 const	half		=	_mm_set1_ps(0.5f);
+	__m128 const	maxUNorm	=	_mm_set1_ps(65535.f);
+	__m128			scaledX		=	_mm_add_ps(_mm_mul_ps(_mm_sub_ps(lanes.m_positionX, _mm_shuffle_ps(mins, mins, _MM_SHUFFLE(0, 0, 0, 0))), _mm_shuffle_ps(quantizeScale, quantizeScale, _MM_SHUFFLE(0, 0, 0, 0))), half);
+	__m128			scaledY		=	_mm_add_ps(_mm_mul_ps(_mm_sub_ps(lanes.m_positionY, _mm_shuffle_ps(mins, mins, _MM_SHUFFLE(1, 1, 1, 1))), _mm_shuffle_ps(quantizeScale, quantizeScale, _MM_SHUFFLE(1, 1, 1, 1))), half);
+	__m128			scaledZ		=	_mm_add_ps(_mm_mul_ps(_mm_sub_ps(lanes.m_positionZ, _mm_shuffle_ps(mins, mins, _MM_SHUFFLE(2, 2, 2, 2))), _mm_shuffle_ps(quantizeScale, quantizeScale, _MM_SHUFFLE(2, 2, 2, 2))), half);
+	__m128i			positionX	=	_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(scaledX, _mm_setzero_ps()), maxUNorm));
+	__m128i			positionY	=	_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(scaledY, _mm_setzero_ps()), maxUNorm));
+	__m128i			positionZ	=	_mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(scaledZ, _mm_setzero_ps()), maxUNorm));
+
+	// Handedness, only the sign of the binormal survives
+	__m128 crossX		=	_mm_sub_ps(_mm_mul_ps(lanes.m_normalY, lanes.m_tangentZ), _mm_mul_ps(lanes.m_normalZ, lanes.m_tangentY));
+	__m128 crossY		=	_mm_sub_ps(_mm_mul_ps(lanes.m_normalZ, lanes.m_tangentX), _mm_mul_ps(lanes.m_normalX, lanes.m_tangentZ));
+	__m128 crossZ		=	_mm_sub_ps(_mm_mul_ps(lanes.m_normalX, lanes.m_tangentY), _mm_mul_ps(lanes.m_normalY, lanes.m_tangentX));
+	__m128 handedness	=	_mm_add_ps(_mm_add_ps(_mm_mul_ps(crossX, lanes.m_binormalX), _mm_mul_ps(crossY, lanes.m_binormalY)), _mm_mul_ps(crossZ, lanes.m_binormalZ));
+	__m128i isRightHanded = _mm_srli_epi32(_mm_castps_si128(_mm_cmpge_ps(handedness, _mm_setzero_ps())), 16);
+
+	// Directions, cvtps rounds to nearest under the default rounding mode and the pack saturates to SNORM16
+	__m128 normalU, normalV, tangentU, tangentV;
+	EncodeOctahedral(lanes.m_normalX, lanes.m_normalY, lanes.m_normalZ, normalU, normalV);
+	EncodeOctahedral(lanes.m_tangentX, lanes.m_tangentY, lanes.m_tangentZ, tangentU, tangentV);
+	__m128 const maxSNorm = _mm_set1_ps(32767.f);
+	__m128i normals		=	_mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(normalU, maxSNorm)), _mm_cvtps_epi32(_mm_mul_ps(normalV, maxSNorm)));
+	__m128i tangents	=	_mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(tangentU, maxSNorm)), _mm_cvtps_epi32(_mm_mul_ps(tangentV, maxSNorm)));
+
+	// SSE2 has no unsigned 32 -> 16 pack, so bias into the signed range, pack, then flip the sign bit back
+	__m128i const bias	=	_mm_set1_epi32(0x8000);
+	__m128i const flip	=	_mm_set1_epi16((short)0x8000);
+	__m128i uvs			=	_mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(FloatToHalf(lanes.m_u), bias), _mm_sub_epi32(FloatToHalf(lanes.m_v), bias)), flip);
+	__m128i positionXY	=	_mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(positionX, bias), _mm_sub_epi32(positionY, bias)), flip);
+	__m128i positionZW	=	_mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(positionZ, bias), _mm_sub_epi32(isRightHanded, bias)), flip);
+
+	alignas(16) unsigned short	positionXYLanes[8];
+	alignas(16) unsigned short	positionZWLanes[8];
+	alignas(16) unsigned short	uvLanes[8];
+	alignas(16) short			normalLanes[8];
+	alignas(16) short			tangentLanes[8];
+	_mm_store_si128((__m128i*)positionXYLanes,	positionXY);
+	_mm_store_si128((__m128i*)positionZWLanes,	positionZW);
+	_mm_store_si128((__m128i*)uvLanes,			uvs);
+	_mm_store_si128((__m128i*)normalLanes,		normals);
+	_mm_store_si128((__m128i*)tangentLanes,		tangents);
+	for (int lane = 0; lane < 4; ++lane)
+	{
+		Vertex_PCUTBN_Quantized& quantizedVertex = out_quantizedVertexes[lane];
+		quantizedVertex.m_position[0]		=	positionXYLanes[lane];
+		quantizedVertex.m_position[1]		=	positionXYLanes[lane + 4];
+		quantizedVertex.m_position[2]		=	positionZWLanes[lane];
+		quantizedVertex.m_position[3]		=	positionZWLanes[lane + 4];
+		quantizedVertex.m_color				=	vertexes[lane].m_color;
+		quantizedVertex.m_uvTexCoords[0]	=	uvLanes[lane];
+		quantizedVertex.m_uvTexCoords[1]	=	uvLanes[lane + 4];
+		quantizedVertex.m_tangent[0]		=	tangentLanes[lane];
+		quantizedVertex.m_tangent[1]		=	tangentLanes[lane + 4];
+		quantizedVertex.m_normal[0]			=	normalLanes[lane];
+		quantizedVertex.m_normal[1]			=	normalLanes[lane + 4];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void DecodeFourVertexes(Vertex_PCUTBN_Quantized const* quantizedVertexes, __m128 const& mins, __m128 const& dequantizeScale, Vertex_PCUTBN* out_vertexes)
+{
+	Vertex_PCUTBN_Quantized const& q0 = quantizedVertexes[0];
+	Vertex_PCUTBN_Quantized const& q1 = quantizedVertexes[1];
+	Vertex_PCUTBN_Quantized const& q2 = quantizedVertexes[2];
+	Vertex_PCUTBN_Quantized const& q3 = quantizedVertexes[3];
+
+	__m128 positionX	=	_mm_cvtepi32_ps(_mm_setr_epi32(q0.m_position[0], q1.m_position[0], q2.m_position[0], q3.m_position[0]));
+	__m128 positionY	=	_mm_cvtepi32_ps(_mm_setr_epi32(q0.m_position[1], q1.m_position[1], q2.m_position[1], q3.m_position[1]));
+	__m128 positionZ	=	_mm_cvtepi32_ps(_mm_setr_epi32(q0.m_position[2], q1.m_position[2], q2.m_position[2], q3.m_position[2]));
+	__m128 handedness	=	_mm_cvtepi32_ps(_mm_setr_epi32(q0.m_position[3], q1.m_position[3], q2.m_position[3], q3.m_position[3]));
+	positionX			=	_mm_add_ps(_mm_mul_ps(positionX, _mm_shuffle_ps(dequantizeScale, dequantizeScale, _MM_SHUFFLE(0, 0, 0, 0))), _mm_shuffle_ps(mins, mins, _MM_SHUFFLE(0, 0, 0, 0)));
+	positionY			=	_mm_add_ps(_mm_mul_ps(positionY, _mm_shuffle_ps(dequantizeScale, dequantizeScale, _MM_SHUFFLE(1, 1, 1, 1))), _mm_shuffle_ps(mins, mins, _MM_SHUFFLE(1, 1, 1, 1)));
+	positionZ			=	_mm_add_ps(_mm_mul_ps(positionZ, _mm_shuffle_ps(dequantizeScale, dequantizeScale, _MM_SHUFFLE(2, 2, 2, 2))), _mm_shuffle_ps(mins, mins, _MM_SHUFFLE(2, 2, 2, 2)));
+	handedness			=	_mm_sub_ps(_mm_mul_ps(handedness, _mm_set1_ps(2.f / 65535.f)), _mm_set1_ps(1.f));
+
+	// SNORM16 decode clamps -32768 to -1 just like the input assembler does
+	__m128 const inverseMaxSNorm = _mm_set1_ps(1.f / 32767.f);
+	__m128 const minusOne = _mm_set1_ps(-1.f);
+	__m128 normalU	=	_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(q0.m_normal[0],	q1.m_normal[0],		q2.m_normal[0],		q3.m_normal[0])),	inverseMaxSNorm), minusOne);
+	__m128 normalV	=	_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(q0.m_normal[1],	q1.m_normal[1],		q2.m_normal[1],		q3.m_normal[1])),	inverseMaxSNorm), minusOne);
+	__m128 tangentU	=	_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(q0.m_tangent[0],	q1.m_tangent[0],	q2.m_tangent[0],	q3.m_tangent[0])),	inverseMaxSNorm), minusOne);
+	__m128 tangentV	=	_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_setr_epi32(q0.m_tangent[1],	q1.m_tangent[1],	q2.m_tangent[1],	q3.m_tangent[1])),	inverseMaxSNorm), minusOne);
+	__m128 normalX, normalY, normalZ, tangentX, tangentY, tangentZ;
+	DecodeOctahedral(normalU, normalV, normalX, normalY, normalZ);
+	DecodeOctahedral(tangentU, tangentV, tangentX, tangentY, tangentZ);
+	__m128 binormalX	=	_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(normalY, tangentZ), _mm_mul_ps(normalZ, tangentY)), handedness);
+	__m128 binormalY	=	_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(normalZ, tangentX), _mm_mul_ps(normalX, tangentZ)), handedness);
+	__m128 binormalZ	=	_mm_mul_ps(_mm_sub_ps(_mm_mul_ps(normalX, tangentY), _mm_mul_ps(normalY, tangentX)), handedness);
+
+	__m128 u = HalfToFloat(_mm_setr_epi32(q0.m_uvTexCoords[0], q1.m_uvTexCoords[0], q2.m_uvTexCoords[0], q3.m_uvTexCoords[0]));
+	__m128 v = HalfToFloat(_mm_setr_epi32(q0.m_uvTexCoords[1], q1.m_uvTexCoords[1], q2.m_uvTexCoords[1], q3.m_uvTexCoords[1]));
+
+	alignas(16) float lanes[14][4];
+	_mm_store_ps(lanes[0],	positionX);
+	_mm_store_ps(lanes[1],	positionY);
+	_mm_store_ps(lanes[2],	positionZ);
+	_mm_store_ps(lanes[3],	u);
+	_mm_store_ps(lanes[4],	v);
+	_mm_store_ps(lanes[5],	tangentX);
+	_mm_store_ps(lanes[6],	tangentY);
+	_mm_store_ps(lanes[7],	tangentZ);
+	_mm_store_ps(lanes[8],	binormalX);
+	_mm_store_ps(lanes[9],	binormalY);
+	_mm_store_ps(lanes[10],	binormalZ);
+	_mm_store_ps(lanes[11],	normalX);
+	_mm_store_ps(lanes[12],	normalY);
+	_mm_store_ps(lanes[13],	normalZ);
+	for (int lane = 0; lane < 4; ++lane)
+	{
+		Vertex_PCUTBN& vertex	=	out_vertexes[lane];
+		vertex.m_position		=	Vec3(lanes[0][lane],	lanes[1][lane],		lanes[2][lane]);
+		vertex.m_color			=	quantizedVertexes[lane].m_color;
+		vertex.m_uvTexCoords	=	Vec2(lanes[3][lane],	lanes[4][lane]);
+		vertex.m_tangent		=	Vec3(lanes[5][lane],	lanes[6][lane],		lanes[7][lane]);
+		vertex.m_binormal		=	Vec3(lanes[8][lane],	lanes[9][lane],		lanes[10][lane]);
+		vertex.m_normal			=	Vec3(lanes[11][lane],	lanes[12][lane],	lanes[13][lane]);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AABB3 GetQuantizationBounds(Vertex_PCUTBN const* vertexes, size_t numOfVertexes)
+{
+	if (numOfVertexes == 0)
+	{
+		return AABB3(Vec3::ZERO, Vec3::ZERO);
+	}
+	AABB3 bounds(vertexes[0].m_position, vertexes[0].m_position);
+	for (size_t vertIndex = 1; vertIndex < numOfVertexes; ++vertIndex)
+	{
+		Vec3 const& position = vertexes[vertIndex].m_position;
+		bounds.m_mins.x = position.x < bounds.m_mins.x ? position.x : bounds.m_mins.x;
+		bounds.m_mins.y = position.y < bounds.m_mins.y ? position.y : bounds.m_mins.y;
+		bounds.m_mins.z = position.z < bounds.m_mins.z ? position.z : bounds.m_mins.z;
+		bounds.m_maxs.x = position.x > bounds.m_maxs.x ? position.x : bounds.m_maxs.x;
+		bounds.m_maxs.y = position.y > bounds.m_maxs.y ? position.y : bounds.m_maxs.y;
+		bounds.m_maxs.z = position.z > bounds.m_maxs.z ? position.z : bounds.m_maxs.z;
+	}
+	return bounds;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Maps the UNORM16 positions ([0, 1] once the input assembler converts them) back into the bounds
+Mat44 GetDequantizationMatrix(AABB3 const& quantizationBounds)
+{
+	Vec3 dimensions = quantizationBounds.m_maxs - quantizationBounds.m_mins;
+	return Mat44(Vec3(dimensions.x, 0.f, 0.f), Vec3(0.f, dimensions.y, 0.f), Vec3(0.f, 0.f, dimensions.z), quantizationBounds.m_mins);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void EncodeQuantizedVertexes(Vertex_PCUTBN const* vertexes, size_t numOfVertexes, AABB3 const& quantizationBounds, Vertex_PCUTBN_Quantized* out_quantizedVertexes)
+{
+	Vec3 dimensions = quantizationBounds.m_maxs - quantizationBounds.m_mins;
+	__m128 mins				=	_mm_setr_ps(quantizationBounds.m_mins.x, quantizationBounds.m_mins.y, quantizationBounds.m_mins.z, 0.f);
+	__m128 quantizeScale	=	_mm_setr_ps(dimensions.x > 0.f ? 65535.f / dimensions.x : 0.f, dimensions.y > 0.f ? 65535.f / dimensions.y : 0.f, dimensions.z > 0.f ? 65535.f / dimensions.z : 0.f, 0.f);
+
+	size_t vertIndex = 0;
+	for (; vertIndex + 4 <= numOfVertexes; vertIndex += 4)
+	{
+		EncodeFourVertexes(vertexes + vertIndex, mins, quantizeScale, out_quantizedVertexes + vertIndex);
+	}
+
+	// Pad the last partial group by repeating its final vertex
+	size_t numOfRemainingVertexes = numOfVertexes - vertIndex;
+	if (numOfRemainingVertexes > 0)
+	{
+		Vertex_PCUTBN			paddedVertexes[4];
+		Vertex_PCUTBN_Quantized	paddedQuantizedVertexes[4];
+		for (size_t lane = 0; lane < 4; ++lane)
+		{
+			paddedVertexes[lane] = vertexes[vertIndex + (lane < numOfRemainingVertexes ? lane : numOfRemainingVertexes - 1)];
+		}
+		EncodeFourVertexes(paddedVertexes, mins, quantizeScale, paddedQuantizedVertexes);
+		for (size_t lane = 0; lane < numOfRemainingVertexes; ++lane)
+		{
+			out_quantizedVertexes[vertIndex + lane] = paddedQuantizedVertexes[lane];
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void DecodeQuantizedVertexes(Vertex_PCUTBN_Quantized const* quantizedVertexes, size_t numOfVertexes, AABB3 const& quantizationBounds, Vertex_PCUTBN* out_vertexes)
+{
+	Vec3 dimensions = quantizationBounds.m_maxs - quantizationBounds.m_mins;
+	__m128 mins				=	_mm_setr_ps(quantizationBounds.m_mins.x, quantizationBounds.m_mins.y, quantizationBounds.m_mins.z, 0.f);
+	__m128 dequantizeScale	=	_mm_setr_ps(dimensions.x / 65535.f, dimensions.y / 65535.f, dimensions.z / 65535.f, 0.f);
+
+	size_t vertIndex = 0;
+	for (; vertIndex + 4 <= numOfVertexes; vertIndex += 4)
+	{
+		DecodeFourVertexes(quantizedVertexes + vertIndex, mins, dequantizeScale, out_vertexes + vertIndex);
+	}
+
+	size_t numOfRemainingVertexes = numOfVertexes - vertIndex;
+	if (numOfRemainingVertexes > 0)
+	{
+		Vertex_PCUTBN_Quantized	paddedQuantizedVertexes[4];
+		Vertex_PCUTBN			paddedVertexes[4];
+		for (size_t lane = 0; lane < 4; ++lane)
+		{
+			paddedQuantizedVertexes[lane] = quantizedVertexes[vertIndex + (lane < numOfRemainingVertexes ? lane : numOfRemainingVertexes - 1)];
+		}
+		DecodeFourVertexes(paddedQuantizedVertexes, mins, dequantizeScale, paddedVertexes);
+		for (size_t lane = 0; lane < numOfRemainingVertexes; ++lane)
+		{
+			out_vertexes[vertIndex + lane] = paddedVertexes[lane];
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+AABB3 QuantizeVertexes(std::vector<Vertex_PCUTBN> const& vertexes, std::vector<Vertex_PCUTBN_Quantized>& out_quantizedVertexes)
+{
+	AABB3 quantizationBounds = GetQuantizationBounds(vertexes.data(), vertexes.size());
+	out_quantizedVertexes.resize(vertexes.size());
+	EncodeQuantizedVertexes(vertexes.data(), vertexes.size(), quantizationBounds, out_quantizedVertexes.data());
+	return quantizationBounds;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static double GetAngleDegreesBetween(Vec3 const& a, Vec3 const& b)
+{
+	// atan2 keeps its precision for tiny angles, acos of a float dot product does not
+	double crossX	=	(double)a.y * b.z - (double)a.z * b.y;
+	double crossY	=	(double)a.z * b.x - (double)a.x * b.z;
+	double crossZ	=	(double)a.x * b.y - (double)a.y * b.x;
+	double dot		=	(double)a.x * b.x + (double)a.y * b.y + (double)a.z * b.z;
+	return atan2(sqrt(crossX * crossX + crossY * crossY + crossZ * crossZ), dot) * (180.0 / 3.14159265358979323846);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static Vec3 RollRandomDirection(RandomNumberGenerator& rng)
+{
+	for (;;)
+	{
+		Vec3 direction(rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f), rng.RollRandomFloatInRange(-1.f, 1.f));
+		float lengthSquared = direction.GetLengthSquared();
+		if (lengthSquared > 0.0001f && lengthSquared <= 1.f)
+		{
+			return direction / sqrtf(lengthSquared);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Round trips random and hand picked worst case vertexes and checks every attribute against its documented error bound
+bool Command_VertexQuantizationCheck(EventArgs& args)
+{
+	int numOfVertexes = args.GetValue("Vertexes", 1000000);
+	if (numOfVertexes < 1)
+	{
+		return false;
+	}
+
+	RandomNumberGenerator rng;
+	std::vector<Vertex_PCUTBN> sourceVertexes;
+	sourceVertexes.resize((size_t)numOfVertexes);
+	Vec3 const axisDirections[] = { Vec3(1.f, 0.f, 0.f), Vec3(-1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f), Vec3(0.f, -1.f, 0.f), Vec3(0.f, 0.f, 1.f), Vec3(0.f, 0.f, -1.f) };
+	for (int vertIndex = 0; vertIndex < numOfVertexes; ++vertIndex)
+	{
+		Vertex_PCUTBN& vertex = sourceVertexes[vertIndex];
+		vertex.m_position		=	Vec3(rng.RollRandomFloatInRange(-50.f, 50.f), rng.RollRandomFloatInRange(-2.f, 2.f), rng.RollRandomFloatInRange(0.f, 300.f));
+		vertex.m_uvTexCoords	=	Vec2(rng.RollRandomFloatInRange(-8.f, 8.f), rng.RollRandomFloatInRange(0.f, 1.f));
+		// The axes, the octahedron folds and the poles are where the encodings are most likely to break
+		if (vertIndex < 6)
+		{
+			vertex.m_normal = axisDirections[vertIndex];
+		}
+		else if (vertIndex < 64)
+		{
+			Vec3 direction	=	RollRandomDirection(rng);
+			vertex.m_normal	=	Vec3(direction.x, direction.y, 0.f).GetNormalized();
+		}
+		else
+		{
+			vertex.m_normal = RollRandomDirection(rng);
+		}
+		Vec3 helperAxis		=	fabsf(vertex.m_normal.z) < 0.9f ? Vec3(0.f, 0.f, 1.f) : Vec3(1.f, 0.f, 0.f);
+		vertex.m_tangent	=	CrossProduct3D(helperAxis, vertex.m_normal).GetNormalized();
+		vertex.m_binormal	=	CrossProduct3D(vertex.m_normal, vertex.m_tangent) * ((vertIndex & 1) ? -1.f : 1.f);
+	}
+
+	std::vector<Vertex_PCUTBN_Quantized>	quantizedVertexes;
+	std::vector<Vertex_PCUTBN>				decodedVertexes;
+	decodedVertexes.resize(sourceVertexes.size());
+	double		timeBeforeEncoding		=	GetCurrentTimeSeconds();
+	AABB3		quantizationBounds		=	QuantizeVertexes(sourceVertexes, quantizedVertexes);
+	double		timeBeforeDecoding		=	GetCurrentTimeSeconds();
+	DecodeQuantizedVertexes(quantizedVertexes.data(), quantizedVertexes.size(), quantizationBounds, decodedVertexes.data());
+	double		timeAfterDecoding		=	GetCurrentTimeSeconds();
+
+	Vec3	boundsDimensions				=	quantizationBounds.m_maxs - quantizationBounds.m_mins;
+	double	maxPositionErrorFraction		=	0.0;
+	double	maxNormalErrorDegrees			=	0.0;
+	double	maxTangentErrorDegrees			=	0.0;
+	double	maxBinormalErrorDegrees			=	0.0;
+	double	maxUVRelativeError				=	0.0;
+	int		numOfColorMismatches			=	0;
+	for (size_t vertIndex = 0; vertIndex < sourceVertexes.size(); ++vertIndex)
+	{
+		Vertex_PCUTBN const& source		=	sourceVertexes[vertIndex];
+		Vertex_PCUTBN const& decoded	=	decodedVertexes[vertIndex];
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			// Forgive the float rounding of the bounds arithmetic, a few ulps of the largest coordinate on this axis
+			double largestCoordinate	=	fmax(fabs((double)(&quantizationBounds.m_mins.x)[axis]), fabs((double)(&quantizationBounds.m_maxs.x)[axis]));
+			double roundingSlack		=	4.0 * (double)FLT_EPSILON * largestCoordinate;
+			double positionError		=	fmax(fabs((double)(&source.m_position.x)[axis] - (double)(&decoded.m_position.x)[axis]) - roundingSlack, 0.0) / (double)(&boundsDimensions.x)[axis];
+			maxPositionErrorFraction	=	positionError > maxPositionErrorFraction ? positionError : maxPositionErrorFraction;
+		}
+		for (int axis = 0; axis < 2; ++axis)
+		{
+			double sourceUV		=	(double)(&source.m_uvTexCoords.x)[axis];
+			double uvError		=	fabs(sourceUV - (double)(&decoded.m_uvTexCoords.x)[axis]) / fmax(fabs(sourceUV), 1.0 / 16384.0);
+			maxUVRelativeError	=	uvError > maxUVRelativeError ? uvError : maxUVRelativeError;
+		}
+		double normalError		=	GetAngleDegreesBetween(source.m_normal, decoded.m_normal);
+		double tangentError		=	GetAngleDegreesBetween(source.m_tangent, decoded.m_tangent);
+		double binormalError	=	GetAngleDegreesBetween(source.m_binormal, decoded.m_binormal);
+		maxNormalErrorDegrees	=	normalError > maxNormalErrorDegrees ? normalError : maxNormalErrorDegrees;
+		maxTangentErrorDegrees	=	tangentError > maxTangentErrorDegrees ? tangentError : maxTangentErrorDegrees;
+		maxBinormalErrorDegrees	=	binormalError > maxBinormalErrorDegrees ? binormalError : maxBinormalErrorDegrees;
+		numOfColorMismatches	+=	source.m_color != decoded.m_color ? 1 : 0;
+	}
+
+	// The binormal is rebuilt from the decoded normal and tangent, so it may carry both of their errors
+	bool isPositionInBounds		=	maxPositionErrorFraction	<=	(double)QUANTIZED_POSITION_MAX_ERROR_FRACTION;
+	bool isNormalInBounds		=	maxNormalErrorDegrees		<=	(double)QUANTIZED_DIRECTION_MAX_ERROR_DEGREES;
+	bool isTangentInBounds		=	maxTangentErrorDegrees		<=	(double)QUANTIZED_DIRECTION_MAX_ERROR_DEGREES;
+	bool isBinormalInBounds		=	maxBinormalErrorDegrees		<=	(double)QUANTIZED_DIRECTION_MAX_ERROR_DEGREES * 2.0;
+	bool isUVInBounds			=	maxUVRelativeError			<=	(double)QUANTIZED_UV_MAX_RELATIVE_ERROR;
+	bool hasPassed				=	isPositionInBounds && isNormalInBounds && isTangentInBounds && isBinormalInBounds && isUVInBounds && numOfColorMismatches == 0;
+
+	double millionsOfVertexes = (double)numOfVertexes / 1000000.0;
+	Strings results;
+	results.push_back(Stringf("VertexQuantization: %s, %d bytes -> %d bytes per vertex", hasPassed ? "PASSED" : "FAILED", (int)sizeof(Vertex_PCUTBN), (int)sizeof(Vertex_PCUTBN_Quantized)));
+	results.push_back(Stringf("  position error %.3g of bounds (limit %.3g) %s",		maxPositionErrorFraction,	(double)QUANTIZED_POSITION_MAX_ERROR_FRACTION,	isPositionInBounds	? "ok" : "FAILED"));
+	results.push_back(Stringf("  normal error %.5f degrees (limit %.5f) %s",			maxNormalErrorDegrees,		(double)QUANTIZED_DIRECTION_MAX_ERROR_DEGREES,	isNormalInBounds	? "ok" : "FAILED"));
+	results.push_back(Stringf("  tangent error %.5f degrees (limit %.5f) %s",			maxTangentErrorDegrees,		(double)QUANTIZED_DIRECTION_MAX_ERROR_DEGREES,	isTangentInBounds	? "ok" : "FAILED"));
+	results.push_back(Stringf("  binormal error %.5f degrees (limit %.5f) %s",			maxBinormalErrorDegrees,	(double)QUANTIZED_DIRECTION_MAX_ERROR_DEGREES * 2.0, isBinormalInBounds ? "ok" : "FAILED"));
+	results.push_back(Stringf("  uv relative error %.3g (limit %.3g) %s",				maxUVRelativeError,			(double)QUANTIZED_UV_MAX_RELATIVE_ERROR,		isUVInBounds		? "ok" : "FAILED"));
+	results.push_back(Stringf("  color mismatches %d", numOfColorMismatches));
+	results.push_back(Stringf("  encode %.2f ms, decode %.2f ms per million vertexes", (timeBeforeDecoding - timeBeforeEncoding) * 1000.0 / millionsOfVertexes, (timeAfterDecoding - timeBeforeDecoding) * 1000.0 / millionsOfVertexes));
+	for (size_t lineIndex = 0; lineIndex < results.size(); ++lineIndex)
+	{
+		DebuggerPrintf("%s\n", results[lineIndex].c_str());
+		if (g_theDevConsole)
+		{
+			g_theDevConsole->AddLine(hasPassed ? DevConsole::INFO_MINOR : DevConsole::ERROR, results[lineIndex]);
+		}
+	}
+	return hasPassed;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Loads every .obj in ModelFolder as Vertex_PCUTBN and reports its vertex buffer bytes as Vertex_PCU, Vertex_PCUTBN and Vertex_PCUTBN_Quantized
+// Fetched per draw is what the input assembler reads for one draw of the whole mesh with no post transform vertex reuse (indexes * stride)
+bool Command_VertexQuantizationMemory(EventArgs& args)
+{
+	std::vector<std::string> modelFileNames = GetFileNamesInFolder(args.GetValue("ModelFolder", "Data/Models"), { ".obj" });
+	if (modelFileNames.empty())
+	{
+		PrintBenchmarkResult("VertexQuantizationMemory: no .obj files in ModelFolder", true);
+		return false;
+	}
+
+	double const	bytesPerMegabyte		=	1024.0 * 1024.0;
+	size_t			totalNumOfVerts			=	0;
+	size_t			totalNumOfIndexes		=	0;
+	double			totalQuantizeSeconds	=	0.0;
+	PrintBenchmarkResult(Stringf("VertexQuantizationMemory: %d bytes PCU, %d bytes PCUTBN, %d bytes quantized per vertex", (int)sizeof(Vertex_PCU), (int)sizeof(Vertex_PCUTBN), (int)sizeof(Vertex_PCUTBN_Quantized)));
+	for (size_t fileIndex = 0; fileIndex < modelFileNames.size(); ++fileIndex)
+	{
+		std::vector<Vertex_PCUTBN>				verts;
+		std::vector<Vertex_PCUTBN_Quantized>	quantizedVerts;
+		std::vector<unsigned int>				indexes;
+		OBJLoader::LoadOBJFileByName(modelFileNames[fileIndex], verts, indexes, Mat44());
+		double timeBeforeQuantizing = GetCurrentTimeSeconds();
+		QuantizeVertexes(verts, quantizedVerts);
+		totalQuantizeSeconds	+=	GetCurrentTimeSeconds() - timeBeforeQuantizing;
+		totalNumOfVerts			+=	verts.size();
+		totalNumOfIndexes		+=	indexes.size();
+
+		PrintBenchmarkResult(Stringf("  %s: %d verts, %d indexes, buffer PCU %.2f MB, PCUTBN %.2f MB, quantized %.2f MB, fetched per draw PCUTBN %.2f MB, quantized %.2f MB",
+									 modelFileNames[fileIndex].c_str(), (int)verts.size(), (int)indexes.size(),
+									 (double)(verts.size() * sizeof(Vertex_PCU)) / bytesPerMegabyte,
+									 (double)(verts.size() * sizeof(Vertex_PCUTBN)) / bytesPerMegabyte,
+									 (double)(quantizedVerts.size() * sizeof(Vertex_PCUTBN_Quantized)) / bytesPerMegabyte,
+									 (double)(indexes.size() * sizeof(Vertex_PCUTBN)) / bytesPerMegabyte,
+									 (double)(indexes.size() * sizeof(Vertex_PCUTBN_Quantized)) / bytesPerMegabyte));
+	}
+
+	double pcutbnBytes		=	(double)(totalNumOfVerts * sizeof(Vertex_PCUTBN));
+	double quantizedBytes	=	(double)(totalNumOfVerts * sizeof(Vertex_PCUTBN_Quantized));
+	PrintBenchmarkResult(Stringf("  total: %d verts, buffers PCUTBN %.2f MB -> quantized %.2f MB (%.0f%% saved), fetched per draw of every model %.2f MB -> %.2f MB, quantized in %.2f ms",
+								 (int)totalNumOfVerts, pcutbnBytes / bytesPerMegabyte, quantizedBytes / bytesPerMegabyte, pcutbnBytes > 0.0 ? (1.0 - quantizedBytes / pcutbnBytes) * 100.0 : 0.0,
+								 (double)(totalNumOfIndexes * sizeof(Vertex_PCUTBN)) / bytesPerMegabyte, (double)(totalNumOfIndexes * sizeof(Vertex_PCUTBN_Quantized)) / bytesPerMegabyte,
+								 totalQuantizeSeconds * 1000.0));
+	return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/Vertex_PCUTBN_Quantized.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Mat44.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+// Worst case errors of an encode/decode round trip, checked by the vertexquantizationcheck console command
+constexpr float QUANTIZED_POSITION_MAX_ERROR_FRACTION	=	0.5f / 65535.f;		// Fraction of the bounds dimension along each axis
+constexpr float QUANTIZED_DIRECTION_MAX_ERROR_DEGREES	=	0.01f;				// Angle between the source and decoded normal / tangent
+constexpr float QUANTIZED_UV_MAX_RELATIVE_ERROR			=	1.f / 2048.f;		// Half float rounding, relative to the uv magnitude
+
+
+//--------------------------------------------------------------------------------------------------
+AABB3	GetQuantizationBounds(Vertex_PCUTBN const* vertexes, size_t numOfVertexes);
+Mat44	GetDequantizationMatrix(AABB3 const& quantizationBounds);
+
+// SSE2 kernels, both process 4 vertexes per iteration
+void	EncodeQuantizedVertexes(Vertex_PCUTBN const* vertexes, size_t numOfVertexes, AABB3 const& quantizationBounds, Vertex_PCUTBN_Quantized* out_quantizedVertexes);
+void	DecodeQuantizedVertexes(Vertex_PCUTBN_Quantized const* quantizedVertexes, size_t numOfVertexes, AABB3 const& quantizationBounds, Vertex_PCUTBN* out_vertexes);
+
+// Resizes out_quantizedVertexes and returns the bounds the positions were quantized against
+AABB3	QuantizeVertexes(std::vector<Vertex_PCUTBN> const& vertexes, std::vector<Vertex_PCUTBN_Quantized>& out_quantizedVertexes);
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_VertexQuantizationCheck(EventArgs& args);
+bool Command_VertexQuantizationMemory(EventArgs& args);
@@ -1,10 +1,22 @@
 #include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/UnitPrimitiveCache.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/Mat44.hpp"
 
 
+//--------------------------------------------------------------------------------------------------
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// Tessellation of the fixed resolution 2D shapes, shared with their GetVertCountFor* companions
+static constexpr int CAPSULE2D_TRIANGLES_PER_CAP	=	18;
+static constexpr int DISC2D_NUM_OF_TRIANGLES		=	32;
+static constexpr int RING2D_NUM_OF_QUADS			=	32;
+
+
 //--------------------------------------------------------------------------------------------------
 void TransformVertexArrayXY3D(int numVerts, Vertex_PCU* verts, float scaleXY, float rotationDegreesAboutZ, Vec2 const& translationXY)
 {
@@ -48,7 +60,7 @@ void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart,
 	verts.push_back(Vertex_PCU(Vec3(TL.x, TL.y), color));
 	verts.push_back(Vertex_PCU(Vec3(BL.x, BL.y), color));
 
-	int numOfTriangles = 18;
+	int numOfTriangles = CAPSULE2D_TRIANGLES_PER_CAP;
 	constexpr int vertsPerTriangle = 3;
 	float degreesPerSide = 180.f / (float)numOfTriangles;
 
@@ -88,7 +100,7 @@ void AddVertsForCapsule2D(std::vector<Vertex_PCU>& verts, Vec2 const& boneStart,
 //--------------------------------------------------------------------------------------------------
 void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, Rgba8 const& color)
 {
-	int numOfTriangles = 32;
+	int numOfTriangles = DISC2D_NUM_OF_TRIANGLES;
 	float degreesPerSide = 360.f / (float)numOfTriangles;
 	float currentOrientation = 0.f;
 
@@ -117,7 +129,7 @@ void AddVertsForDisc2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float
 //--------------------------------------------------------------------------------------------------
 void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec2 const& center, float radius, float thickness, Rgba8 const& color)
 {
-	int numOfQuads = 32;
+	int numOfQuads = RING2D_NUM_OF_QUADS;
 	float degreesPerSide = 360.f / (float)numOfQuads;
 	float currentOrientation = 0.f;
 	float halfThickness = thickness * 0.5f;
@@ -391,7 +403,7 @@ void AddVertsForHexagon2D(std::vector <Vertex_PCUTBN>& verts, std::vector<unsign
 //#ToDo: Optimize
 void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, float thickness, Rgba8 const& color)
 {
-	int numOfQuads = 32;
+	int numOfQuads = RING2D_NUM_OF_QUADS;
 	float degreesPerSide = 360.f / (float)numOfQuads;
 	float currentOrientation = 0.f;
 	float halfThickness = thickness * 0.5f;
@@ -424,6 +436,21 @@ void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float
 
 //--------------------------------------------------------------------------------------------------
 void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, Rgba8 const& color, AABB2 const& UVs, int numLatitudeSlices)
+{
+	// The cached unit sphere only carries the default uvs
+	if (!(UVs == AABB2::ZERO_TO_ONE))
+	{
+		AddVertsForSphere3DUncached(verts, center, radius, color, UVs, numLatitudeSlices);
+		return;
+	}
+
+	Mat44 transform(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, radius), center);
+	AddVertsForUnitPrimitiveInstance(verts, *GetUnitPrimitiveVerts(UnitPrimitiveShape::SPHERE, (float)numLatitudeSlices), transform, color);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AddVertsForSphere3DUncached(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, Rgba8 const& color, AABB2 const& UVs, int numLatitudeSlices)
 {
 	int numLongitudeSlices = 2 * numLatitudeSlices;
 
@@ -742,6 +769,20 @@ void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned in
 
 //--------------------------------------------------------------------------------------------------
 void AddVertsForUVSphereZ3D(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs)
+{
+	if (!(UVs == AABB2::ZERO_TO_ONE))
+	{
+		AddVertsForUVSphereZ3DUncached(verts, center, radius, numSlices, numStacks, tint, UVs);
+		return;
+	}
+
+	Mat44 transform(Vec3(radius, 0.f, 0.f), Vec3(0.f, radius, 0.f), Vec3(0.f, 0.f, radius), center);
+	AddVertsForUnitPrimitiveInstance(verts, *GetUnitPrimitiveVerts(UnitPrimitiveShape::UV_SPHERE_Z, numSlices, numStacks), transform, tint);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AddVertsForUVSphereZ3DUncached(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs)
 {
 	float degreesPerSlice = 360.f / numSlices;
 	float degreesPerStack = 180.f / numStacks;
@@ -789,10 +830,8 @@ void AddVertsForUVSphereZ3D(std::vector<Vertex_PCUTBN>& verts, std::vector<unsig
 	int NUM_LAYER = (int)numStacks;
 	int NUM_SLICE = (int)numSlices;
 	
-	int vertsNum = 2 + (NUM_LAYER - 1) * NUM_SLICE;
-	int indexNum = 3 * (((NUM_LAYER - 2) * NUM_SLICE * 2) + (2 * NUM_SLICE));
-	verts.reserve(verts.size() + vertsNum);
-	indexes.reserve(indexes.size() + indexNum);
+	verts.reserve(verts.size() + GetIndexedVertCountForUVSphereZ3D(numSlices, numStacks));
+	indexes.reserve(indexes.size() + GetIndexCountForUVSphereZ3D(numSlices, numStacks));
 	int vertStartIndex = (int)verts.size();
 	int NUM_VERTS_PER_LAYER = NUM_SLICE + 1;
 	float pitchPerStack = 180.f / NUM_LAYER;//Pitch
@@ -1285,8 +1324,44 @@ void AddVertsForCylinderZWireframe3D(std::vector<Vertex_PCU>& verts, Vec2 const&
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// Maps the unit +X cylinder / cone onto start -> end with the given radius, using the same frame the generators build
+static Mat44 GetUnitPrimitiveTransformX3D(Vec3 const& start, Vec3 const& end, float radius)
+{
+	Vec3 dispSE = (end - start);
+	Vec3 iForward = dispSE.GetNormalized();
+
+	Vec3 jLeft = CrossProduct3D(Vec3::Z_AXIS, iForward);
+	if (jLeft == Vec3::WORLD_ORIGIN)
+	{
+		jLeft = Vec3::Y_AXIS;
+	}
+	else
+	{
+		jLeft.Normalize();
+	}
+	Vec3 kUp = CrossProduct3D(iForward, jLeft);
+
+	float depth = dispSE.GetLength();
+	return Mat44(iForward * depth, jLeft * radius, kUp * radius, start);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
+{
+	if (!(UVs == AABB2::ZERO_TO_ONE))
+	{
+		AddVertsForCylinder3DUncached(verts, start, end, radius, tint, numSlices, UVs);
+		return;
+	}
+
+	AddVertsForUnitPrimitiveInstance(verts, *GetUnitPrimitiveVerts(UnitPrimitiveShape::CYLINDER_X, (float)numSlices), GetUnitPrimitiveTransformX3D(start, end, radius), tint);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AddVertsForCylinder3DUncached(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
 {
 	Vec3 dispSE = (end - start);
 	Vec3 iForward = dispSE.GetNormalized();
@@ -2156,6 +2231,22 @@ AABB2 GetVertexBounds2D(std::vector<Vertex_PCU> const& verts)
 
 //--------------------------------------------------------------------------------------------------
 void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
+{
+	if (!(UVs == AABB2::ZERO_TO_ONE))
+	{
+		AddVertsForCone3DUncached(verts, start, end, radius, tint, numSlices, UVs);
+		return;
+	}
+
+	// The cap uvs grow with the radius around (0.5, 0.5), so scale them the same way the positions are scaled
+	Vec2 uvScale	=	Vec2(radius, radius);
+	Vec2 uvOffset	=	Vec2(0.5f - 0.5f * radius, 0.5f - 0.5f * radius);
+	AddVertsForUnitPrimitiveInstance(verts, *GetUnitPrimitiveVerts(UnitPrimitiveShape::CONE_X, (float)numSlices), GetUnitPrimitiveTransformX3D(start, end, radius), tint, uvScale, uvOffset);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void AddVertsForCone3DUncached(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& tint, int numSlices, AABB2 const& UVs)
 {
 	Vec3 dispSE = (end - start);
 	Vec3 iForward = dispSE.GetNormalized();
@@ -2316,3 +2407,408 @@ void AddVertsForLineList(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3
 	verts.emplace_back(start,	color);
 	verts.emplace_back(end,		color);
 }
+
+
+//--------------------------------------------------------------------------------------------------
+// The generators loop with an int counter against a float count, so a fractional count still runs a final partial iteration
+static int GetNumOfLoopIterations(float count)
+{
+	return count > 0.f ? (int)ceilf(count) : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForCapsule2D()
+{
+	return 6 + 2 * CAPSULE2D_TRIANGLES_PER_CAP * 3;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForDisc2D()
+{
+	return DISC2D_NUM_OF_TRIANGLES * 3;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForRing2D()
+{
+	return RING2D_NUM_OF_QUADS * GetVertCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForAABB2D()
+{
+	return 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForOBB2D()
+{
+	return 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForLineSegment2D()
+{
+	return 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForArrow2D()
+{
+	return 3 * GetVertCountForLineSegment2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForQuad3D()
+{
+	return 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForAABB3D()
+{
+	return 6 * GetVertCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForOBB3D()
+{
+	return 6 * GetVertCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForLineSegment3D()
+{
+	return 6 * GetVertCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForSphere3D(int numLatitudeSlices)
+{
+	int numOfLatitudeSlices = numLatitudeSlices > 0 ? numLatitudeSlices : 0;
+	return (2 * numOfLatitudeSlices) * numOfLatitudeSlices * GetVertCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForUVSphereZ3D(float numSlices, float numStacks)
+{
+	return GetNumOfLoopIterations(numSlices) * GetNumOfLoopIterations(numStacks) * GetVertCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForCylinder3D(int numSlices)
+{
+	// Two cap triangles and a side quad per slice
+	return GetNumOfLoopIterations((float)numSlices) * (6 + GetVertCountForQuad3D());
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForCone3D(int numSlices)
+{
+	// A base triangle and a side triangle per slice
+	return GetNumOfLoopIterations((float)numSlices) * 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForLineList()
+{
+	return 2;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForConvexPoly2D(int numOfPoints)
+{
+	return numOfPoints >= 3 ? (numOfPoints - 2) * 3 : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForBorderedConvexPoly2D(int numOfPoints)
+{
+	return numOfPoints * GetVertCountForLineSegment2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForPlane2D()
+{
+	return GetVertCountForLineSegment2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetVertCountForConvexHull2D(int numOfPlanes)
+{
+	return numOfPlanes * GetVertCountForPlane2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForRing2D()
+{
+	// The first quad has four verts, every following quad shares its leading edge with the previous one
+	return GetIndexedVertCountForQuad3D() + (RING2D_NUM_OF_QUADS - 1) * 2;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForRing2D()
+{
+	return RING2D_NUM_OF_QUADS * GetIndexCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForBorderedHexagon2D()
+{
+	return GetIndexedVertCountForQuad3D() + 4 * 2;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForBorderedHexagon2D()
+{
+	return 6 * GetIndexCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForHexagon2D()
+{
+	return 7;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForHexagon2D()
+{
+	// The center index, the first edge, then one triangle per remaining side
+	return 3 + 5 * 3;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForSphere3D(float numSlices, float numStacks)
+{
+	// Both poles plus a column of inner stack verts per slice
+	return 2 + GetNumOfLoopIterations(numSlices) * GetNumOfLoopIterations(numStacks - 1.f);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForSphere3D(float numSlices, float numStacks)
+{
+	int numOfSlices = GetNumOfLoopIterations(numSlices);
+	return 2 * numOfSlices * 3 + numOfSlices * GetNumOfLoopIterations(numStacks - 2.f) * 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForUVSphereZ3D(float numSlices, float numStacks)
+{
+	// This overload truncates its counts and always emits the south cap row and the north pole
+	int numOfSlices			=	(int)numSlices;
+	int numOfInnerLayers	=	(int)numStacks - 2;
+	if (numOfSlices <= 0)
+	{
+		return 1;
+	}
+	return (numOfSlices + 2) + (numOfInnerLayers > 0 ? numOfInnerLayers * (numOfSlices + 1) : 0) + 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForUVSphereZ3D(float numSlices, float numStacks)
+{
+	int numOfSlices			=	(int)numSlices > 0 ? (int)numSlices : 0;
+	int numOfInnerLayers	=	(int)numStacks - 2;
+	return 2 * numOfSlices * 3 + (numOfInnerLayers > 0 ? numOfInnerLayers * numOfSlices * 6 : 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForSphereZ3D(float numSlices, float numStacks)
+{
+	// Only the cone around the south pole is generated, one extra vert per slice after the first
+	int numOfExtraSlices = GetNumOfLoopIterations(numStacks) > 0 ? GetNumOfLoopIterations(numSlices) - 1 : 0;
+	return 3 + (numOfExtraSlices > 0 ? numOfExtraSlices : 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForSphereZ3D(float numSlices, float numStacks)
+{
+	return (GetIndexedVertCountForSphereZ3D(numSlices, numStacks) - 2) * 3;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForCylinderZ3D(float numSlices)
+{
+	// Both cap centers and the first edge, then a bottom, two side and a top vert per slice
+	return 6 + GetNumOfLoopIterations(numSlices) * 4;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForCylinderZ3D(float numSlices)
+{
+	return GetNumOfLoopIterations(numSlices) * 12;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForAABB2D()
+{
+	return 4;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForAABB2D()
+{
+	return 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForQuad3D()
+{
+	return 4;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForQuad3D()
+{
+	return 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForRoundedQuad3D()
+{
+	return 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForRoundedQuad3D()
+{
+	return 4 * 3;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForAABB3D()
+{
+	return 6 * GetIndexedVertCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForAABB3D()
+{
+	return 6 * GetIndexCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForOBB3D()
+{
+	return 6 * GetIndexedVertCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForOBB3D()
+{
+	return 6 * GetIndexCountForQuad3D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForLineSegment2D()
+{
+	return 4;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForLineSegment2D()
+{
+	return 6;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForConvexPoly2D(int numOfPoints)
+{
+	return numOfPoints >= 3 ? numOfPoints : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForConvexPoly2D(int numOfPoints)
+{
+	return numOfPoints >= 3 ? (numOfPoints - 2) * 3 : 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForBorderedConvexPoly2D(int numOfPoints)
+{
+	return numOfPoints * GetIndexedVertCountForLineSegment2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForBorderedConvexPoly2D(int numOfPoints)
+{
+	return numOfPoints * GetIndexCountForLineSegment2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForPlane2D()
+{
+	return GetIndexedVertCountForLineSegment2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForPlane2D()
+{
+	return GetIndexCountForLineSegment2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexedVertCountForConvexHull2D(int numOfPlanes)
+{
+	return numOfPlanes * GetIndexedVertCountForPlane2D();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int GetIndexCountForConvexHull2D(int numOfPlanes)
+{
+	return numOfPlanes * GetIndexCountForPlane2D();
+}
@@ -41,8 +41,11 @@ void AddVertsForBorderedHexagon2D(std::vector<Vertex_PCUTBN>& verts, std::vector
 void AddVertsForHexagon2D(std::vector <Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec2 const& center, float circumRadius, Rgba8 const& color = Rgba8::WHITE);
 void AddVertsForHexagon2D(std::vector <Vertex_PCUTBN>& verts, std::vector<unsigned int>& indexes, Vec2 const& center, float circumRadius, Rgba8 const& color = Rgba8::WHITE);
 void AddVertsForRing2D(std::vector<Vertex_PCU>& verts, Vec2 const& center, float radius, float thickness, Rgba8 const& color);
+// With default uvs the PCU sphere, cylinder and cone helpers instance from UnitPrimitiveCache, the *Uncached versions always generate from scratch
 void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE, int numLatitudeSlices = 8);
+void AddVertsForSphere3DUncached(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, Rgba8 const& color, AABB2 const& UVs, int numLatitudeSlices);
 void AddVertsForUVSphereZ3D(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForUVSphereZ3DUncached(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint, AABB2 const& UVs);
 void AddVertsForSphereZ3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& tint = Rgba8::WHITE);
 void AddVertsForUVSphereZWireframe3D(std::vector<Vertex_PCU>& verts, Vec3 const& center, float radius, int numSlices, int numStacks, float lineThickness, Rgba8 const& color = Rgba8::WHITE);
 void AddVertsForSphere3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec3 const& center, float radius, float numSlices, float numStacks, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);		// Mr. Car Version
@@ -53,6 +56,7 @@ void AddVertsForCylinderZ3D(std::vector<Vertex_PCU>& verts, Vec2 const& centerXY
 void AddVertsForCylinderZ3D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, Rgba8 const& tint = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForCylinderZWireframe3D(std::vector<Vertex_PCU>& verts, Vec2 const& centerXY, FloatRange const& minMaxZ, float radius, float numSlices, float lineThickness, Rgba8 const& tint = Rgba8::WHITE);
 void AddVertsForCylinder3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForCylinder3DUncached(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color, int numSlices, AABB2 const& UVs);
 void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs = AABB2(0.f, 0.f, 1.f, 1.f));
 void AddVertsForAABB2D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, AABB2 const& bounds, Rgba8 const& color, AABB2 const& UVs = AABB2(0.f, 0.f, 1.f, 1.f));
 void AddVertsForAABB3D(std::vector<Vertex_PCU>& verts, AABB3 const& bounds, Rgba8 const& color = Rgba8::WHITE, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
@@ -74,6 +78,7 @@ void AddVertsForLineSegment2D(std::vector<Vertex_PCU>& verts, std::vector<unsign
 void AddVertsForLineSegment3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float thickness, Rgba8 const& color);
 void AddVertsForArrow2D(std::vector<Vertex_PCU>& verts, Vec2 const& tailPos, Vec2 const& tipPos, float arrowSize, float lineThickness, Rgba8 const& color = Rgba8(0, 255, 0));
 void AddVertsForCone3D(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
+void AddVertsForCone3DUncached(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color, int numSlices, AABB2 const& UVs);
 void AddVertsForCone3D(std::vector<Vertex_PCUTBN>& verts, Vec3 const& start, Vec3 const& end, float radius, Rgba8 const& color = Rgba8::WHITE, int numSlices = 8, AABB2 const& UVs = AABB2::ZERO_TO_ONE);
 void AddVertsForLineList(std::vector<Vertex_PCU>& verts, Vec3 const& start, Vec3 const& end, Rgba8 const& color = Rgba8::WHITE);
 void AddVertsForConvexPoly2D(std::vector<Vertex_PCU>& verts, ConvexPoly2D const& poly2D, Rgba8 const& color = Rgba8::WHITE);
@@ -85,5 +90,65 @@ void AddVertsForPlane2D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int
 void AddVertsForConvexHull2D(std::vector<Vertex_PCU>& verts, ConvexHull2D const& convexHull2D, float thickness, Vec2 const& camDims, Rgba8 const& color = Rgba8::WHITE);
 void AddVertsForConvexHull2D(std::vector<Vertex_PCU>& verts, std::vector<unsigned int>& indexes, ConvexHull2D const& convexHull2D, float thickness, Vec2 const& camDims, Rgba8 const& color = Rgba8::WHITE);
 
+//--------------------------------------------------------------------------------------------------
+// Exact number of verts the matching non indexed AddVertsFor* appends, so callers can size their storage once
+int GetVertCountForCapsule2D();
+int GetVertCountForDisc2D();
+int GetVertCountForRing2D();
+int GetVertCountForAABB2D();
+int GetVertCountForOBB2D();
+int GetVertCountForLineSegment2D();
+int GetVertCountForArrow2D();
+int GetVertCountForQuad3D();
+int GetVertCountForAABB3D();
+int GetVertCountForOBB3D();
+int GetVertCountForLineSegment3D();
+int GetVertCountForSphere3D(int numLatitudeSlices = 8);
+int GetVertCountForUVSphereZ3D(float numSlices, float numStacks);
+int GetVertCountForCylinder3D(int numSlices = 8);
+int GetVertCountForCone3D(int numSlices = 8);
+int GetVertCountForLineList();
+int GetVertCountForConvexPoly2D(int numOfPoints);
+int GetVertCountForBorderedConvexPoly2D(int numOfPoints);
+int GetVertCountForPlane2D();
+int GetVertCountForConvexHull2D(int numOfPlanes);
+
+//--------------------------------------------------------------------------------------------------
+// Exact number of verts and indexes the matching indexed AddVertsFor* appends, PCU and PCUTBN overloads alike
+int GetIndexedVertCountForRing2D();
+int GetIndexCountForRing2D();
+int GetIndexedVertCountForBorderedHexagon2D();
+int GetIndexCountForBorderedHexagon2D();
+int GetIndexedVertCountForHexagon2D();
+int GetIndexCountForHexagon2D();
+int GetIndexedVertCountForSphere3D(float numSlices, float numStacks);
+int GetIndexCountForSphere3D(float numSlices, float numStacks);
+int GetIndexedVertCountForUVSphereZ3D(float numSlices, float numStacks);
+int GetIndexCountForUVSphereZ3D(float numSlices, float numStacks);
+int GetIndexedVertCountForSphereZ3D(float numSlices, float numStacks);
+int GetIndexCountForSphereZ3D(float numSlices, float numStacks);
+int GetIndexedVertCountForCylinderZ3D(float numSlices);
+int GetIndexCountForCylinderZ3D(float numSlices);
+int GetIndexedVertCountForAABB2D();
+int GetIndexCountForAABB2D();
+int GetIndexedVertCountForQuad3D();
+int GetIndexCountForQuad3D();
+int GetIndexedVertCountForRoundedQuad3D();
+int GetIndexCountForRoundedQuad3D();
+int GetIndexedVertCountForAABB3D();
+int GetIndexCountForAABB3D();
+int GetIndexedVertCountForOBB3D();
+int GetIndexCountForOBB3D();
+int GetIndexedVertCountForLineSegment2D();
+int GetIndexCountForLineSegment2D();
+int GetIndexedVertCountForConvexPoly2D(int numOfPoints);
+int GetIndexCountForConvexPoly2D(int numOfPoints);
+int GetIndexedVertCountForBorderedConvexPoly2D(int numOfPoints);
+int GetIndexCountForBorderedConvexPoly2D(int numOfPoints);
+int GetIndexedVertCountForPlane2D();
+int GetIndexCountForPlane2D();
+int GetIndexedVertCountForConvexHull2D(int numOfPlanes);
+int GetIndexCountForConvexHull2D(int numOfPlanes);
+
 //--------------------------------------------------------------------------------------------------
 AABB2 GetVertexBounds2D(std::vector<Vertex_PCU> const& verts);
\ No newline at end of file
@@ -0,0 +1,19 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/Rgba8.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+// 24 byte GPU friendly counterpart of Vertex_PCUTBN (60 bytes), see VertexQuantization.hpp for the encode/decode kernels
+// Position is stored relative to the mesh bounds, so the mesh must be drawn with GetDequantizationMatrix(bounds) appended to its model matrix
+// The binormal is not stored, shaders rebuild it as cross(normal, tangent) * (position.w * 2 - 1)
+struct Vertex_PCUTBN_Quantized
+{
+	unsigned short	m_position[4]		=	{ };	// UNORM16 xyz inside the mesh bounds, w is the binormal handedness (0 = -1, 65535 = +1)
+	Rgba8			m_color;
+	unsigned short	m_uvTexCoords[2]	=	{ };	// IEEE half floats
+	short			m_tangent[2]		=	{ };	// SNORM16 octahedral
+	short			m_normal[2]			=	{ };	// SNORM16 octahedral
+};
@@ -0,0 +1,75 @@
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+static Plane3D MakeNormalizedPlane(float a, float b, float c, float d)
+{
+	Plane3D plane;
+	Vec3	normal(a, b, c);
+	float	length = normal.GetLength();
+	if (length > 0.f)
+	{
+		float inverseLength		=	1.f / length;
+		plane.m_normal			=	normal * inverseLength;
+		plane.m_distFromOrigin	=	-d * inverseLength;
+	}
+	return plane;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Frustum::IsSphereOutside(Vec3 const& center, float radius) const
+{
+	for (int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex)
+	{
+		if (m_planes[planeIndex].GetAltitudeOfPoint(center) < -radius)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Frustum::IsAABB3Outside(AABB3 const& bounds) const
+{
+	for (int planeIndex = 0; planeIndex < FRUSTUM_PLANE_COUNT; ++planeIndex)
+	{
+		// Test the corner furthest along the plane normal, if even that one is behind the plane the whole box is
+		Plane3D const& plane = m_planes[planeIndex];
+		Vec3 positiveVertex;
+		positiveVertex.x = plane.m_normal.x >= 0.f ? bounds.m_maxs.x : bounds.m_mins.x;
+		positiveVertex.y = plane.m_normal.y >= 0.f ? bounds.m_maxs.y : bounds.m_mins.y;
+		positiveVertex.z = plane.m_normal.z >= 0.f ? bounds.m_maxs.z : bounds.m_mins.z;
+		if (plane.GetAltitudeOfPoint(positiveVertex) < 0.f)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Frustum const Frustum::MakeFromClipMatrix(Mat44 const& worldToClip)
+{
+	// Gribb/Hartmann plane extraction, rows of the matrix are spread across the basis vectors
+	float const* m = worldToClip.GetAsFloatArray();
+	float row0[4] = { m[Mat44::Ix], m[Mat44::Jx], m[Mat44::Kx], m[Mat44::Tx] };
+	float row1[4] = { m[Mat44::Iy], m[Mat44::Jy], m[Mat44::Ky], m[Mat44::Ty] };
+	float row2[4] = { m[Mat44::Iz], m[Mat44::Jz], m[Mat44::Kz], m[Mat44::Tz] };
+	float row3[4] = { m[Mat44::Iw], m[Mat44::Jw], m[Mat44::Kw], m[Mat44::Tw] };
+
+	Frustum frustum;
+	frustum.m_planes[FRUSTUM_PLANE_LEFT]	=	MakeNormalizedPlane(row3[0] + row0[0], row3[1] + row0[1], row3[2] + row0[2], row3[3] + row0[3]);
+	frustum.m_planes[FRUSTUM_PLANE_RIGHT]	=	MakeNormalizedPlane(row3[0] - row0[0], row3[1] - row0[1], row3[2] - row0[2], row3[3] - row0[3]);
+	frustum.m_planes[FRUSTUM_PLANE_BOTTOM]	=	MakeNormalizedPlane(row3[0] + row1[0], row3[1] + row1[1], row3[2] + row1[2], row3[3] + row1[3]);
+	frustum.m_planes[FRUSTUM_PLANE_TOP]		=	MakeNormalizedPlane(row3[0] - row1[0], row3[1] - row1[1], row3[2] - row1[2], row3[3] - row1[3]);
+	frustum.m_planes[FRUSTUM_PLANE_NEAR]	=	MakeNormalizedPlane(row2[0], row2[1], row2[2], row2[3]);
+	frustum.m_planes[FRUSTUM_PLANE_FAR]		=	MakeNormalizedPlane(row3[0] - row2[0], row3[1] - row2[1], row3[2] - row2[2], row3[3] - row2[3]);
+	return frustum;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Math/Plane3D.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+struct AABB3;
+struct Mat44;
+
+
+//--------------------------------------------------------------------------------------------------
+enum FrustumPlane : unsigned char
+{
+	FRUSTUM_PLANE_LEFT,
+	FRUSTUM_PLANE_RIGHT,
+	FRUSTUM_PLANE_BOTTOM,
+	FRUSTUM_PLANE_TOP,
+	FRUSTUM_PLANE_NEAR,
+	FRUSTUM_PLANE_FAR,
+
+	FRUSTUM_PLANE_COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Planes face inwards, a point is inside the frustum if its altitude is positive for every plane
+struct Frustum
+{
+	Plane3D m_planes[FRUSTUM_PLANE_COUNT];
+
+	bool IsSphereOutside(Vec3 const& center, float radius)	const;
+	bool IsAABB3Outside(AABB3 const& bounds)				const;
+
+	// Expects the full world to clip matrix (projection * view * model) with a D3D style 0 to 1 clip depth
+	static Frustum const MakeFromClipMatrix(Mat44 const& worldToClip);
+};
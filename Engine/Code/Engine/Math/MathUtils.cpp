@@ -1,3 +1,4 @@
+#include "Engine/Core/TangentSpaceGenerator.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Math/IntVec2.hpp"
@@ -1361,135 +1362,7 @@ float Hesitate5(float parametricZeroToOneT)
 
 
 //--------------------------------------------------------------------------------------------------
-void CalculateTangentSpaceVectors(std::vector<Vertex_PCUTBN>& vertsToModify, std::vector<unsigned int> const& indexes)
+void CalculateTangentSpaceVectors(std::vector<Vertex_PCUTBN>& vertsToModify, std::vector<unsigned int> const& indexes, size_t firstVertIndex, size_t firstIndex)
 {
-	size_t numOfVerts		=	vertsToModify.size();
-	size_t numOfIndexes		=	indexes.size();
-	// 
-	// for (size_t vertIndex = 0; vertIndex < numOfIndexes; vertIndex += 3)
-	// {
-	// 	size_t const& index0 = indexes[vertIndex + 0];
-	// 	size_t const& index1 = indexes[vertIndex + 1];
-	// 	size_t const& index2 = indexes[vertIndex + 2];
-	// 	
-	// 	// Vertexes
-	// 	Vertex_PCUTBN& vert0 = vertsToModify[index0];
-	// 	Vertex_PCUTBN& vert1 = vertsToModify[index1];
-	// 	Vertex_PCUTBN& vert2 = vertsToModify[index2];
-	// 
-	// 	// Vertex Positions
-	// 	Vec3 const& pos0 = vert0.m_position;
-	// 	Vec3 const& pos1 = vert1.m_position;
-	// 	Vec3 const& pos2 = vert2.m_position;
-	// 
-	// 	// Vertex Uvs
-	// 	Vec2 const& uvs0 = vert0.m_uvTexCoords;
-	// 	Vec2 const& uvs1 = vert1.m_uvTexCoords;
-	// 	Vec2 const& uvs2 = vert2.m_uvTexCoords;
-	// 
-	// 	// Vertex Tangents
-	// 	Vec3& tangent0 = vert0.m_tangent;
-	// 	Vec3& tangent1 = vert1.m_tangent;
-	// 	Vec3& tangent2 = vert2.m_tangent;
-	// 
-	// 	// Vertex Binormals
-	// 	Vec3& binormal0 = vert0.m_binormal;
-	// 	Vec3& binormal1 = vert1.m_binormal;
-	// 	Vec3& binormal2 = vert2.m_binormal;
-	// 
-	// 	Vec3 edge1		=	pos1 - pos0;
-	// 	Vec3 edge2		=	pos2 - pos0;
-	// 	Vec2 uvEdge1	=	uvs1 - uvs0;
-	// 	Vec2 uvEdge2	=	uvs2 - uvs0;
-	// 
-	// 	float r			=	1.f / (uvEdge1.x * uvEdge2.y - uvEdge2.x * uvEdge1.y);
-	// 	Vec3 tangent	=	(edge1 * uvEdge2.y - edge2 * uvEdge1.y) * r;
-	// 	Vec3 binormal	=	(edge2 * uvEdge1.x - edge1 * uvEdge2.x) * r;
-	// 
-	// 	tangent0 += tangent;
-	// 	tangent1 += tangent;
-	// 	tangent2 += tangent;
-	// 
-	// 	binormal0 += binormal;
-	// 	binormal1 += binormal;
-	// 	binormal2 += binormal;
-	// }
-	// 
-	// for (size_t vertIndex = 0; vertIndex < numOfVerts; ++vertIndex)
-	// {
-	// 	Vertex_PCUTBN&	currentVert			=	vertsToModify[vertIndex];
-	// 	Vec3&			currentTangent		=	currentVert.m_tangent;
-	// 	Vec3&			currentBinormal		=	currentVert.m_binormal;
-	// 	Vec3&			currentNormal		=	currentVert.m_normal;
-	// 
-	// 	// currentTangent		=	(currentTangent - currentNormal * DotProduct3D(currentNormal, currentTangent)).GetNormalized();
-	// 	// currentBinormal		=	CrossProduct3D(currentNormal, currentTangent);
-	// 	Mat44 vectorsToOrthoNormalize(currentNormal, currentTangent, currentBinormal, Vec3());
-	// 	vectorsToOrthoNormalize.Orthonormalize_XFwd_YLeft_ZUp();
-	// 	
-	// 	currentNormal		=	vectorsToOrthoNormalize.GetIBasis3D();
-	// 	currentTangent		=	vectorsToOrthoNormalize.GetJBasis3D();
-	// 	currentBinormal		=	vectorsToOrthoNormalize.GetKBasis3D();
-	// }
-
-	std::vector<Vec3> tan1;
-	std::vector<Vec3> tan2;
-	tan1.resize(numOfIndexes);
-	tan2.resize(numOfIndexes);
-
-	for (size_t vertIndex = 0; vertIndex < numOfIndexes; vertIndex += 3)
-	{
-		long i1 = indexes[vertIndex + 0];
-		long i2 = indexes[vertIndex + 1];
-		long i3 = indexes[vertIndex + 2];
-
-		Vertex_PCUTBN& vert1 = vertsToModify[i1];
-		Vertex_PCUTBN& vert2 = vertsToModify[i2];
-		Vertex_PCUTBN& vert3 = vertsToModify[i3];
-
-		Vec3 const& v1 = vert1.m_position;
-		Vec3 const& v2 = vert2.m_position;
-		Vec3 const& v3 = vert3.m_position;
-
-		Vec2 const& w1 = vert1.m_uvTexCoords;
-		Vec2 const& w2 = vert2.m_uvTexCoords;
-		Vec2 const& w3 = vert3.m_uvTexCoords;
-
-		float x1 = v2.x - v1.x;
-		float x2 = v3.x - v1.x;
-		float y1 = v2.y - v1.y;
-		float y2 = v3.y - v1.y;
-		float z1 = v2.z - v1.z;
-		float z2 = v3.z - v1.z;
-
-		float s1 = w2.x - w1.x;
-		float s2 = w3.x - w1.x;
-		float t1 = w2.y - w1.y;
-		float t2 = w3.y - w1.y;
-
-		float r = 1.0f / (s1 * t2 - s2 * t1);
-		Vec3 sdir((t2 * x1 - t1 * x2) * r, (t2 * y1 - t1 * y2) * r,
-			(t2 * z1 - t1 * z2) * r);
-		Vec3 tdir((s1 * x2 - s2 * x1) * r, (s1 * y2 - s2 * y1) * r,
-			(s1 * z2 - s2 * z1) * r);
-
-		tan1[i1] += sdir;
-		tan1[i2] += sdir;
-		tan1[i3] += sdir;
-
-		tan2[i1] += tdir;
-		tan2[i2] += tdir;
-		tan2[i3] += tdir;
-	}
-
-	for (long a = 0; a < numOfVerts; a++)
-	{
-		Vertex_PCUTBN& verts = vertsToModify[a];
-		Vec3 const& n = verts.m_normal;
-		Vec3 const& t = tan1[a];
-
-		// Gram-Schmidt orthogonalize
-		verts.m_tangent		=	(t - n * DotProduct3D(n, t)).GetNormalized();
-		verts.m_binormal	=	CrossProduct3D(n, verts.m_tangent);
-	}
-}
+	GenerateTangentSpace(vertsToModify, indexes, firstVertIndex, firstIndex);
+}
\ No newline at end of file
@@ -143,4 +143,4 @@ float Hesitate5(float parametricZeroToOneT);
 //--------------------------------------------------------------------------------------------------
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include <vector>
-void CalculateTangentSpaceVectors(std::vector<Vertex_PCUTBN>& vertsToModify, std::vector<unsigned int> const& indexes);
\ No newline at end of file
+void CalculateTangentSpaceVectors(std::vector<Vertex_PCUTBN>& vertsToModify, std::vector<unsigned int> const& indexes, size_t firstVertIndex = 0, size_t firstIndex = 0);	// Only the verts and triangles from the firsts on
\ No newline at end of file
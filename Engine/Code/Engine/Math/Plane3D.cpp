@@ -0,0 +1,9 @@
+#include "Engine/Math/Plane3D.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+float Plane3D::GetAltitudeOfPoint(Vec3 const& point) const
+{
+	return DotProduct3D(point, m_normal) - m_distFromOrigin;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Math/Vec3.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+struct Plane3D
+{
+	Vec3	m_normal			=	{ };
+	float	m_distFromOrigin	=	0.f;
+
+	float GetAltitudeOfPoint(Vec3 const& point) const;
+};
@@ -1,4 +1,5 @@
 #include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/StringUtils.hpp"
@@ -76,8 +77,9 @@ void BitmapFont::AddVertsForText3D(std::vector<Vertex_PCU>& verts, Vec3 const& t
 }
 
 //--------------------------------------------------------------------------------------------------
-void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint, float cellAspect,
-	Vec2 const& alignment, TextDrawMode mode, int maxGlyphsToDraw)
+// Calls addLine(textMins, cellHeight, lineText) for every line that fits the glyph budget
+template <typename AddLineFunction>
+static void LayoutTextInBox2D(BitmapFont& font, AABB2 const& box, float cellHeight, std::string const& text, float cellAspect, Vec2 const& alignment, TextDrawMode mode, int maxGlyphsToDraw, AddLineFunction const& addLine)
 {
 	Strings newLineDelimitedTexts = SplitStringOnDelimiter(text, '\n');
 	int numOfLines = (int)newLineDelimitedTexts.size();
@@ -86,7 +88,7 @@ void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AA
 	float maxLength = -1.f;
 	for (int arrayIndex = 0; arrayIndex < numOfLines; ++arrayIndex)
 	{
-		float currentTextWidth = GetTextWidth(cellHeight, newLineDelimitedTexts[arrayIndex], cellAspect);
+		float currentTextWidth = font.GetTextWidth(cellHeight, newLineDelimitedTexts[arrayIndex], cellAspect);
 		if (maxLength < currentTextWidth)
 		{
 			maxLength = currentTextWidth;
@@ -145,7 +147,7 @@ void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AA
 	for (int stringIndex = 0; stringIndex < numOfLines; ++stringIndex)
 	{
 		int currentStringLength = (int)newLineDelimitedTexts[stringIndex].size();
-		float currentTextWidth = GetTextWidth(cellHeight, newLineDelimitedTexts[stringIndex], cellAspect);
+		float currentTextWidth = font.GetTextWidth(cellHeight, newLineDelimitedTexts[stringIndex], cellAspect);
 		float unusedParaSpaceX = paragraphWidth - currentTextWidth;
 		float localTextMinsX = alignment.x * unusedParaSpaceX;
 		textMins.x = paragraphMins.x + localTextMinsX;
@@ -153,13 +155,13 @@ void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AA
 		{
 			if (glyphsToBeDisplayed > currentStringLength)
 			{
-				AddVertsForText2D(vertexArray, textMins, cellHeight, newLineDelimitedTexts[stringIndex], tint, cellAspect);
+				addLine(textMins, cellHeight, newLineDelimitedTexts[stringIndex]);
 				glyphsToBeDisplayed -= currentStringLength;
 			}
 			else
 			{
 				std::string const& glyphsToRender = std::string(newLineDelimitedTexts[stringIndex], 0, glyphsToBeDisplayed);
-				AddVertsForText2D(vertexArray, textMins, cellHeight, glyphsToRender, tint, cellAspect);
+				addLine(textMins, cellHeight, glyphsToRender);
 				glyphsToBeDisplayed = 0;
 			}
 		}
@@ -172,6 +174,46 @@ void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AA
 	}
 }
 
+//--------------------------------------------------------------------------------------------------
+void BitmapFont::AddVertsForTextInBox2D(std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint, float cellAspect,
+	Vec2 const& alignment, TextDrawMode mode, int maxGlyphsToDraw)
+{
+	LayoutTextInBox2D(*this, box, cellHeight, text, cellAspect, alignment, mode, maxGlyphsToDraw, [&](Vec2 const& textMins, float lineCellHeight, std::string const& lineText)
+	{
+		AddVertsForText2D(vertexArray, textMins, lineCellHeight, lineText, tint, cellAspect);
+	});
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitmapFont::AddQuadsForText2D(std::vector<SpriteQuad>& quads, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint, float cellAspect)
+{
+	float		cellWidth	=	cellAspect * cellHeight;
+	SpriteQuad	quad;
+	quad.m_bounds.m_mins	=	textMins;
+	quad.m_bounds.m_maxs	=	Vec2(textMins.x + cellWidth, textMins.y + cellHeight);
+	quad.m_color			=	tint;
+
+	for (int textIndex = 0; textIndex < (int)text.size(); ++textIndex)
+	{
+		quad.m_uvs = m_fontGlyphsSpriteSheet.GetSpriteUVs(text[textIndex]);
+		quads.push_back(quad);
+		quad.m_bounds.m_mins.x += cellWidth;
+		quad.m_bounds.m_maxs.x += cellWidth;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BitmapFont::AddQuadsForTextInBox2D(std::vector<SpriteQuad>& quads, AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint, float cellAspect,
+	Vec2 const& alignment, TextDrawMode mode, int maxGlyphsToDraw)
+{
+	LayoutTextInBox2D(*this, box, cellHeight, text, cellAspect, alignment, mode, maxGlyphsToDraw, [&](Vec2 const& textMins, float lineCellHeight, std::string const& lineText)
+	{
+		AddQuadsForText2D(quads, textMins, lineCellHeight, lineText, tint, cellAspect);
+	});
+}
+
 float BitmapFont::GetTextWidth(float cellHeight, std::string const& text, float cellAspect)
 {
 	float textWidth = 0.f;
@@ -8,6 +8,7 @@
 
 class Texture;
 struct Vertex_PCU;
+struct SpriteQuad;
 struct Vec2;
 
 enum class TextDrawMode
@@ -32,6 +33,11 @@ public:
 	void AddVertsForTextInBox2D	(std::vector<Vertex_PCU>& vertexArray, AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint = Rgba8(255, 255, 255), float cellAspect = 1.f,
 		Vec2 const& alignment = Vec2(0.5f, 0.5f), TextDrawMode mode = TextDrawMode::SHRINK, int maxGlyphsToDraw = 99999999);
 
+	// One quad per glyph for a SpriteBatch, laid out like the Vertex_PCU versions
+	void AddQuadsForText2D		(std::vector<SpriteQuad>& quads, Vec2 const& textMins, float cellHeight, std::string const& text, Rgba8 const& tint = Rgba8(255, 255, 255), float cellAspect = 1.f);
+	void AddQuadsForTextInBox2D	(std::vector<SpriteQuad>& quads, AABB2 const& box, float cellHeight, std::string const& text, Rgba8 const& tint = Rgba8(255, 255, 255), float cellAspect = 1.f,
+		Vec2 const& alignment = Vec2(0.5f, 0.5f), TextDrawMode mode = TextDrawMode::SHRINK, int maxGlyphsToDraw = 99999999);
+
 	float GetTextWidth(float cellHeight, std::string const& text, float cellAspect = 1.f);
 
 protected:
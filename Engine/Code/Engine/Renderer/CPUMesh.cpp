@@ -1 +1,69 @@
-#include "Engine/Renderer/CPUMesh.hpp"
\ No newline at end of file
+#include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Core/CookedMesh.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+CPUMesh::~CPUMesh()
+{
+	delete m_cookedMeshFile;
+	m_cookedMeshFile = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CPUMesh::SetCookedMeshFile(CookedMeshFile* cookedMeshFile)
+{
+	delete m_cookedMeshFile;
+	m_cookedMeshFile = cookedMeshFile;
+	m_cpuVerts.clear();
+	m_cpuIndexes.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CPUMesh::CopyMappedDataToVectors()
+{
+	if (!m_cookedMeshFile)
+	{
+		return;
+	}
+	m_cpuVerts.assign(GetVerts(), GetVerts() + GetNumOfVerts());
+	m_cpuIndexes.assign(GetIndexes(), GetIndexes() + GetNumOfIndexes());
+	delete m_cookedMeshFile;
+	m_cookedMeshFile = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool CPUMesh::IsMapped() const
+{
+	return m_cookedMeshFile != nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Vertex_PCUTBN const* CPUMesh::GetVerts() const
+{
+	return m_cookedMeshFile ? static_cast<Vertex_PCUTBN const*>(m_cookedMeshFile->GetVertexData()) : m_cpuVerts.data();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned int const* CPUMesh::GetIndexes() const
+{
+	return m_cookedMeshFile ? m_cookedMeshFile->GetIndexes() : m_cpuIndexes.data();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t CPUMesh::GetNumOfVerts() const
+{
+	return m_cookedMeshFile ? m_cookedMeshFile->GetNumOfVerts() : m_cpuVerts.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t CPUMesh::GetNumOfIndexes() const
+{
+	return m_cookedMeshFile ? m_cookedMeshFile->GetNumOfIndexes() : m_cpuIndexes.size();
+}
@@ -8,10 +8,37 @@
 //--------------------------------------------------------------------------------------------------
 #include <vector>
 
+
 //--------------------------------------------------------------------------------------------------
+class CookedMeshFile;
+
+
+//--------------------------------------------------------------------------------------------------
+// Either owns its verts and indexes in m_cpuVerts / m_cpuIndexes, or reads them straight out of a mapped cooked mesh file
+// Read through the Get* functions to handle both, code that edits the vectors calls CopyMappedDataToVectors first
 class CPUMesh
 {
+public:
+	CPUMesh() {};
+	~CPUMesh();
+	CPUMesh(CPUMesh const& copyFrom) = delete;
+	CPUMesh& operator=(CPUMesh const& copyFrom) = delete;
+
+	// Takes ownership of an open PCUTBN cooked mesh file, replacing whatever the mesh had
+	void					SetCookedMeshFile(CookedMeshFile* cookedMeshFile);
+	// Copies mapped data into the vectors and releases the mapping, does nothing for a mesh that owns its data already
+	void					CopyMappedDataToVectors();
+	bool					IsMapped() const;
+
+	Vertex_PCUTBN const*	GetVerts() const;
+	unsigned int const*		GetIndexes() const;
+	size_t					GetNumOfVerts() const;
+	size_t					GetNumOfIndexes() const;
+
 public:
 	std::vector<Vertex_PCUTBN>	m_cpuVerts;
 	std::vector<unsigned int>	m_cpuIndexes;
-};
\ No newline at end of file
+
+private:
+	CookedMeshFile*				m_cookedMeshFile	=	nullptr;
+};
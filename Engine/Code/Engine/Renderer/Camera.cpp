@@ -223,6 +223,15 @@ Mat44 Camera::GetModelMatrix() const
 }
 
 
+//--------------------------------------------------------------------------------------------------
+Frustum Camera::GetWorldFrustum() const
+{
+	Mat44 worldToClipMat = GetProjectionMatrix();
+	worldToClipMat.Append(GetViewMatrix());
+	return Frustum::MakeFromClipMatrix(worldToClipMat);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 Vec2 Camera::GetOrthoBottomLeft() const
 {
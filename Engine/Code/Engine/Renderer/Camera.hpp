@@ -3,6 +3,7 @@
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/Mat44.hpp"
 #include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Frustum.hpp"
 
 class Camera
 {
@@ -39,6 +40,7 @@ public:
 	Mat44 GetRenderMatrix()					const;
 	Mat44 GetViewMatrix()					const;
 	Mat44 GetModelMatrix()					const;
+	Frustum GetWorldFrustum()				const;
 
 	Vec2 GetCameraCenter() const;
 	Vec2 GetOrthoBottomLeft() const;
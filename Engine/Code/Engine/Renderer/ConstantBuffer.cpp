@@ -10,5 +10,10 @@ ConstantBuffer::ConstantBuffer(size_t size) :
 
 ConstantBuffer::~ConstantBuffer()
 {
+	if (m_renderer)
+	{
+		m_renderer->ReleaseAfterFlush(m_buffer);
+		m_buffer = nullptr;
+	}
 	DX_SAFE_RELEASE(m_buffer);
 }
@@ -0,0 +1,556 @@
+#include "Engine/Renderer/D3D11_RenderBackend.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <d3d11.h>
+#include <d3d11_1.h>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------------------------
+template <typename T>
+static T* const* ToNativeObjects(RenderHandle const* handles)
+{
+	return reinterpret_cast<T* const*>(handles);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static ID3D11Query* GetOrCreateQuery(ID3D11DeviceContext* deviceContext, ID3D11Query*& query, D3D11_QUERY queryType)
+{
+	if (query)
+	{
+		return query;
+	}
+
+	D3D11_QUERY_DESC queryDesc	=	{};
+	queryDesc.Query				=	queryType;
+
+	ID3D11Device* device = nullptr;
+	deviceContext->GetDevice(&device);
+	HRESULT hResult = device->CreateQuery(&queryDesc, &query);
+	device->Release();
+	if (!SUCCEEDED(hResult))
+	{
+		ERROR_AND_DIE("Could not create the query");
+	}
+	return query;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void ReleaseQueries(ID3D11Query** queries, int numOfQueries)
+{
+	for (int queryIndex = 0; queryIndex < numOfQueries; ++queryIndex)
+	{
+		if (queries[queryIndex])
+		{
+			queries[queryIndex]->Release();
+			queries[queryIndex] = nullptr;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_RenderBackend::D3D11_RenderBackend(ID3D11DeviceContext* deviceContext) :
+	m_deviceContext(deviceContext)
+{
+	HRESULT hResult = m_deviceContext->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&m_deviceContext1);
+	if (!SUCCEEDED(hResult))
+	{
+		m_deviceContext1 = nullptr;
+		return;
+	}
+
+	ID3D11Device* device = nullptr;
+	m_deviceContext->GetDevice(&device);
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	hResult = device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+	m_supportsConstantBufferRanges = SUCCEEDED(hResult) && options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+	device->Release();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_RenderBackend::~D3D11_RenderBackend()
+{
+	for (int typeIndex = 0; typeIndex < (int)TransientBufferType::COUNT; ++typeIndex)
+	{
+		if (m_transientBuffers[typeIndex])
+		{
+			m_transientBuffers[typeIndex]->Release();
+			m_transientBuffers[typeIndex] = nullptr;
+		}
+	}
+	ReleaseQueries(m_fenceQueries, MAX_NUM_OF_FENCES_IN_FLIGHT);
+	ReleaseQueries(m_disjointQueries, NUM_OF_TIMESTAMP_FRAMES);
+	for (uint32_t frameSlot = 0; frameSlot < NUM_OF_TIMESTAMP_FRAMES; ++frameSlot)
+	{
+		ReleaseQueries(m_timestampQueries[frameSlot], MAX_NUM_OF_TIMESTAMPS_PER_FRAME);
+		ReleaseQueries(m_pipelineStatisticsQueries[frameSlot], MAX_NUM_OF_PIPELINE_STATISTICS_PER_FRAME);
+	}
+	if (m_deviceContext1)
+	{
+		m_deviceContext1->Release();
+		m_deviceContext1 = nullptr;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void D3D11_RenderBackend::SetDebugAnnotation(ID3DUserDefinedAnnotation* debugAnnotation)
+{
+	m_debugAnnotation = debugAnnotation;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Geometry is bound as both vertex and index buffer, the Renderer keeps vertexes and indexes at different offsets
+void D3D11_RenderBackend::ReserveTransientBuffer(TransientBufferType type, uint32_t sizeBytes)
+{
+	int typeIndex = (int)type;
+	if (m_transientBuffers[typeIndex] && m_transientBufferSizes[typeIndex] == sizeBytes)
+	{
+		return;
+	}
+
+	// Commands that used the old buffer have already run, the context keeps it alive until the GPU is done with it
+	if (m_transientBuffers[typeIndex])
+	{
+		m_transientBuffers[typeIndex]->Release();
+		m_transientBuffers[typeIndex] = nullptr;
+	}
+
+	D3D11_BUFFER_DESC bufferDesc	=	{};
+	bufferDesc.ByteWidth			=	sizeBytes;
+	bufferDesc.Usage				=	D3D11_USAGE_DYNAMIC;
+	bufferDesc.BindFlags			=	type == TransientBufferType::CONSTANTS ? D3D11_BIND_CONSTANT_BUFFER : D3D11_BIND_VERTEX_BUFFER | D3D11_BIND_INDEX_BUFFER;
+	bufferDesc.CPUAccessFlags		=	D3D11_CPU_ACCESS_WRITE;
+
+	ID3D11Device* device = nullptr;
+	m_deviceContext->GetDevice(&device);
+	HRESULT hResult = device->CreateBuffer(&bufferDesc, nullptr, &m_transientBuffers[typeIndex]);
+	device->Release();
+	if (!SUCCEEDED(hResult))
+	{
+		ERROR_AND_DIE("Could not create the transient buffer");
+	}
+	m_transientBufferSizes[typeIndex] = sizeBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderHandle D3D11_RenderBackend::GetTransientBuffer(TransientBufferType type) const
+{
+	return m_transientBuffers[(int)type];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool D3D11_RenderBackend::SupportsConstantBufferRanges() const
+{
+	return m_supportsConstantBufferRanges;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void D3D11_RenderBackend::SignalFence(uint64_t fenceValue)
+{
+	if (m_numOfFencesInFlight == MAX_NUM_OF_FENCES_IN_FLIGHT)
+	{
+		RetireOldestFence(true);
+	}
+
+	int fenceIndex = (m_oldestFenceIndex + m_numOfFencesInFlight) % MAX_NUM_OF_FENCES_IN_FLIGHT;
+	m_deviceContext->End(GetOrCreateQuery(m_deviceContext, m_fenceQueries[fenceIndex], D3D11_QUERY_EVENT));
+	m_fenceValues[fenceIndex]	=	fenceValue;
+	m_numOfFencesInFlight		+=	1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t D3D11_RenderBackend::GetCompletedFenceValue()
+{
+	while (m_numOfFencesInFlight > 0 && RetireOldestFence(false))
+	{
+	}
+	return m_completedFenceValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The disjoint query brackets the frame slot so it is the last one to finish, every timestamp in it is in once it is
+bool D3D11_RenderBackend::ReadGPUTimestamps(uint32_t frameSlot, uint32_t numOfTimestamps, double* out_gpuSeconds)
+{
+	ID3D11Query* disjointQuery = m_disjointQueries[frameSlot];
+	if (disjointQuery == nullptr)
+	{
+		return false;
+	}
+
+	D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData = {};
+	if (m_deviceContext->GetData(disjointQuery, &disjointData, sizeof(disjointData), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+	{
+		return false;
+	}
+	if (disjointData.Disjoint || disjointData.Frequency == 0)
+	{
+		return false;
+	}
+
+	for (uint32_t timestampIndex = 0; timestampIndex < numOfTimestamps; ++timestampIndex)
+	{
+		ID3D11Query*	timestampQuery	=	m_timestampQueries[frameSlot][timestampIndex];
+		UINT64			timestamp		=	0;
+		if (timestampQuery == nullptr || m_deviceContext->GetData(timestampQuery, &timestamp, sizeof(timestamp), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+		{
+			return false;
+		}
+		out_gpuSeconds[timestampIndex] = (double)timestamp / (double)disjointData.Frequency;
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool D3D11_RenderBackend::ReadPipelineStatistics(uint32_t frameSlot, uint32_t numOfQueries, PipelineStatistics* out_statistics)
+{
+	for (uint32_t queryIndex = 0; queryIndex < numOfQueries; ++queryIndex)
+	{
+		ID3D11Query*							statisticsQuery	=	m_pipelineStatisticsQueries[frameSlot][queryIndex];
+		D3D11_QUERY_DATA_PIPELINE_STATISTICS	statisticsData	=	{};
+		if (statisticsQuery == nullptr || m_deviceContext->GetData(statisticsQuery, &statisticsData, sizeof(statisticsData), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+		{
+			return false;
+		}
+		PipelineStatistics& statistics				=	out_statistics[queryIndex];
+		statistics.m_numOfVertexesAssembled			=	statisticsData.IAVertices;
+		statistics.m_numOfVertexShaderInvocations	=	statisticsData.VSInvocations;
+		statistics.m_numOfPixelShaderInvocations	=	statisticsData.PSInvocations;
+		statistics.m_numOfComputeShaderInvocations	=	statisticsData.CSInvocations;
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool D3D11_RenderBackend::RetireOldestFence(bool waitsForGPU)
+{
+	ID3D11Query* query = m_fenceQueries[m_oldestFenceIndex];
+	if (waitsForGPU)
+	{
+		while (m_deviceContext->GetData(query, nullptr, 0, 0) == S_FALSE)
+		{
+		}
+	}
+	else if (m_deviceContext->GetData(query, nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK)
+	{
+		return false;
+	}
+
+	m_completedFenceValue	=	m_fenceValues[m_oldestFenceIndex];
+	m_oldestFenceIndex		=	(m_oldestFenceIndex + 1) % MAX_NUM_OF_FENCES_IN_FLIGHT;
+	m_numOfFencesInFlight	-=	1;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Every range the Renderer uploads is one the frames in flight no longer read, so a single no overwrite map covers them
+void D3D11_RenderBackend::WriteTransientBuffer(TransientBufferType type, unsigned char const* bytes, TransientRange const* ranges, int numOfRanges, bool discardsContents)
+{
+	ID3D11Buffer*				buffer				=	m_transientBuffers[(int)type];
+	D3D11_MAPPED_SUBRESOURCE	mappedSubresource;
+	HRESULT hResult = m_deviceContext->Map(buffer, 0, discardsContents ? D3D11_MAP_WRITE_DISCARD : D3D11_MAP_WRITE_NO_OVERWRITE, 0, &mappedSubresource);
+	if (!SUCCEEDED(hResult))
+	{
+		ERROR_AND_DIE("Could not map the transient buffer");
+	}
+	for (int rangeIndex = 0; rangeIndex < numOfRanges; ++rangeIndex)
+	{
+		TransientRange const& range = ranges[rangeIndex];
+		memcpy(static_cast<unsigned char*>(mappedSubresource.pData) + range.m_firstByte, bytes + range.m_firstByte, range.m_numOfBytes);
+	}
+	m_deviceContext->Unmap(buffer, 0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void D3D11_RenderBackend::Execute(RenderCommandBuffer const& commandBuffer)
+{
+	float const			blendFactor[4]	=	{ 0.f, 0.f, 0.f, 0.f };
+	unsigned int const	sampleMask		=	0xffffffff;
+
+	for (RenderCommandHeader const* command = commandBuffer.GetFirstCommand(); command != nullptr; command = commandBuffer.GetNextCommand(command))
+	{
+		CountCommand(command);
+
+		switch (command->m_type)
+		{
+			case RenderCommandType::SET_RENDER_TARGETS:
+			{
+				RenderCommand_SetRenderTargets const*	setRenderTargets	=	reinterpret_cast<RenderCommand_SetRenderTargets const*>(command);
+				ID3D11RenderTargetView* const*			renderTargetViews	=	ToNativeObjects<ID3D11RenderTargetView>(setRenderTargets->GetRenderTargetViews());
+				ID3D11DepthStencilView*					depthStencilView	=	static_cast<ID3D11DepthStencilView*>(setRenderTargets->m_depthStencilView);
+				if (!setRenderTargets->m_setsUAVs)
+				{
+					m_deviceContext->OMSetRenderTargets(setRenderTargets->m_numOfRenderTargets, renderTargetViews, depthStencilView);
+					break;
+				}
+				m_deviceContext->OMSetRenderTargetsAndUnorderedAccessViews(setRenderTargets->m_numOfRenderTargets, renderTargetViews, depthStencilView, setRenderTargets->m_uavStartSlot,
+					setRenderTargets->m_numOfUAVs, ToNativeObjects<ID3D11UnorderedAccessView>(setRenderTargets->GetUAVs()), setRenderTargets->GetUAVInitialCounts());
+				break;
+			}
+			case RenderCommandType::SET_VIEWPORT:
+			{
+				RenderCommand_SetViewport const* setViewport = reinterpret_cast<RenderCommand_SetViewport const*>(command);
+				D3D11_VIEWPORT viewport		=	{};
+				viewport.TopLeftX			=	setViewport->m_topLeftX;
+				viewport.TopLeftY			=	setViewport->m_topLeftY;
+				viewport.Width				=	setViewport->m_width;
+				viewport.Height				=	setViewport->m_height;
+				viewport.MinDepth			=	setViewport->m_minDepth;
+				viewport.MaxDepth			=	setViewport->m_maxDepth;
+				m_deviceContext->RSSetViewports(1, &viewport);
+				break;
+			}
+			case RenderCommandType::CLEAR_RENDER_TARGET:
+			{
+				RenderCommand_ClearRenderTarget const* clearRenderTarget = reinterpret_cast<RenderCommand_ClearRenderTarget const*>(command);
+				m_deviceContext->ClearRenderTargetView(static_cast<ID3D11RenderTargetView*>(clearRenderTarget->m_renderTargetView), clearRenderTarget->m_color);
+				break;
+			}
+			case RenderCommandType::CLEAR_DEPTH_STENCIL:
+			{
+				RenderCommand_ClearDepthStencil const* clearDepthStencil = reinterpret_cast<RenderCommand_ClearDepthStencil const*>(command);
+				m_deviceContext->ClearDepthStencilView(static_cast<ID3D11DepthStencilView*>(clearDepthStencil->m_depthStencilView), D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, clearDepthStencil->m_depth, clearDepthStencil->m_stencil);
+				break;
+			}
+			case RenderCommandType::CLEAR_UNORDERED_ACCESS_VIEW:
+			{
+				RenderCommand_ClearUnorderedAccessView const* clearUAV = reinterpret_cast<RenderCommand_ClearUnorderedAccessView const*>(command);
+				m_deviceContext->ClearUnorderedAccessViewFloat(static_cast<ID3D11UnorderedAccessView*>(clearUAV->m_unorderedAccessView), clearUAV->m_values);
+				break;
+			}
+			case RenderCommandType::SET_SHADER:
+			{
+				RenderCommand_SetShader const* setShader = reinterpret_cast<RenderCommand_SetShader const*>(command);
+				switch (setShader->m_stage)
+				{
+					case ShaderStage::VERTEX:	m_deviceContext->VSSetShader(static_cast<ID3D11VertexShader*>(setShader->m_shader), nullptr, 0);	break;
+					case ShaderStage::PIXEL:	m_deviceContext->PSSetShader(static_cast<ID3D11PixelShader*>(setShader->m_shader), nullptr, 0);		break;
+					case ShaderStage::COMPUTE:	m_deviceContext->CSSetShader(static_cast<ID3D11ComputeShader*>(setShader->m_shader), nullptr, 0);	break;
+					default:					break;
+				}
+				break;
+			}
+			case RenderCommandType::SET_INPUT_LAYOUT:
+			{
+				m_deviceContext->IASetInputLayout(static_cast<ID3D11InputLayout*>(reinterpret_cast<RenderCommand_SetInputLayout const*>(command)->m_inputLayout));
+				break;
+			}
+			case RenderCommandType::SET_SHADER_RESOURCES:
+			{
+				RenderCommand_SetShaderResources const*	setShaderResources	=	reinterpret_cast<RenderCommand_SetShaderResources const*>(command);
+				ID3D11ShaderResourceView* const*		views				=	ToNativeObjects<ID3D11ShaderResourceView>(setShaderResources->GetViews());
+				switch (setShaderResources->m_stage)
+				{
+					case ShaderStage::VERTEX:	m_deviceContext->VSSetShaderResources(setShaderResources->m_startSlot, setShaderResources->m_numOfViews, views);	break;
+					case ShaderStage::PIXEL:	m_deviceContext->PSSetShaderResources(setShaderResources->m_startSlot, setShaderResources->m_numOfViews, views);	break;
+					case ShaderStage::COMPUTE:	m_deviceContext->CSSetShaderResources(setShaderResources->m_startSlot, setShaderResources->m_numOfViews, views);	break;
+					default:					break;
+				}
+				break;
+			}
+			case RenderCommandType::SET_UNORDERED_ACCESS_VIEWS:
+			{
+				RenderCommand_SetUnorderedAccessViews const* setUAVs = reinterpret_cast<RenderCommand_SetUnorderedAccessViews const*>(command);
+				m_deviceContext->CSSetUnorderedAccessViews(setUAVs->m_startSlot, setUAVs->m_numOfViews, ToNativeObjects<ID3D11UnorderedAccessView>(setUAVs->GetViews()), setUAVs->GetInitialCounts());
+				break;
+			}
+			case RenderCommandType::SET_CONSTANT_BUFFER:
+			{
+				RenderCommand_SetConstantBuffer const*	setConstantBuffer	=	reinterpret_cast<RenderCommand_SetConstantBuffer const*>(command);
+				ID3D11Buffer*							buffer				=	static_cast<ID3D11Buffer*>(setConstantBuffer->m_buffer);
+				if (setConstantBuffer->m_numOfConstants > 0)
+				{
+					UINT firstConstant	=	setConstantBuffer->m_firstConstant;
+					UINT numOfConstants	=	setConstantBuffer->m_numOfConstants;
+					switch (setConstantBuffer->m_stage)
+					{
+						case ShaderStage::VERTEX:	m_deviceContext1->VSSetConstantBuffers1(setConstantBuffer->m_slot, 1, &buffer, &firstConstant, &numOfConstants);	break;
+						case ShaderStage::PIXEL:	m_deviceContext1->PSSetConstantBuffers1(setConstantBuffer->m_slot, 1, &buffer, &firstConstant, &numOfConstants);	break;
+						case ShaderStage::COMPUTE:	m_deviceContext1->CSSetConstantBuffers1(setConstantBuffer->m_slot, 1, &buffer, &firstConstant, &numOfConstants);	break;
+						default:					break;
+					}
+					break;
+				}
+				switch (setConstantBuffer->m_stage)
+				{
+					case ShaderStage::VERTEX:	m_deviceContext->VSSetConstantBuffers(setConstantBuffer->m_slot, 1, &buffer);	break;
+					case ShaderStage::PIXEL:	m_deviceContext->PSSetConstantBuffers(setConstantBuffer->m_slot, 1, &buffer);	break;
+					case ShaderStage::COMPUTE:	m_deviceContext->CSSetConstantBuffers(setConstantBuffer->m_slot, 1, &buffer);	break;
+					default:					break;
+				}
+				break;
+			}
+			case RenderCommandType::SET_VERTEX_BUFFERS:
+			{
+				RenderCommand_SetVertexBuffers const* setVertexBuffers = reinterpret_cast<RenderCommand_SetVertexBuffers const*>(command);
+				m_deviceContext->IASetVertexBuffers(setVertexBuffers->m_startSlot, setVertexBuffers->m_numOfBuffers, ToNativeObjects<ID3D11Buffer>(setVertexBuffers->GetBuffers()),
+					setVertexBuffers->GetStrides(), setVertexBuffers->GetOffsets());
+				break;
+			}
+			case RenderCommandType::SET_INDEX_BUFFER:
+			{
+				RenderCommand_SetIndexBuffer const* setIndexBuffer = reinterpret_cast<RenderCommand_SetIndexBuffer const*>(command);
+				m_deviceContext->IASetIndexBuffer(static_cast<ID3D11Buffer*>(setIndexBuffer->m_buffer), DXGI_FORMAT_R32_UINT, setIndexBuffer->m_offset);
+				break;
+			}
+			case RenderCommandType::SET_PRIMITIVE_TOPOLOGY:
+			{
+				m_deviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(reinterpret_cast<RenderCommand_SetPrimitiveTopology const*>(command)->m_topology));
+				break;
+			}
+			case RenderCommandType::SET_BLEND_STATE:
+			{
+				m_deviceContext->OMSetBlendState(static_cast<ID3D11BlendState*>(reinterpret_cast<RenderCommand_SetState const*>(command)->m_state), blendFactor, sampleMask);
+				break;
+			}
+			case RenderCommandType::SET_SAMPLER_STATE:
+			{
+				RenderCommand_SetSamplerState const*	setSamplerState		=	reinterpret_cast<RenderCommand_SetSamplerState const*>(command);
+				ID3D11SamplerState*						samplerState		=	static_cast<ID3D11SamplerState*>(setSamplerState->m_sampler);
+				switch (setSamplerState->m_stage)
+				{
+					case ShaderStage::VERTEX:	m_deviceContext->VSSetSamplers(setSamplerState->m_slot, 1, &samplerState);	break;
+					case ShaderStage::PIXEL:	m_deviceContext->PSSetSamplers(setSamplerState->m_slot, 1, &samplerState);	break;
+					case ShaderStage::COMPUTE:	m_deviceContext->CSSetSamplers(setSamplerState->m_slot, 1, &samplerState);	break;
+					default:					break;
+				}
+				break;
+			}
+			case RenderCommandType::SET_RASTERIZER_STATE:
+			{
+				m_deviceContext->RSSetState(static_cast<ID3D11RasterizerState*>(reinterpret_cast<RenderCommand_SetState const*>(command)->m_state));
+				break;
+			}
+			case RenderCommandType::SET_DEPTH_STENCIL_STATE:
+			{
+				m_deviceContext->OMSetDepthStencilState(static_cast<ID3D11DepthStencilState*>(reinterpret_cast<RenderCommand_SetState const*>(command)->m_state), 0);
+				break;
+			}
+			case RenderCommandType::UPDATE_BUFFER:
+			{
+				RenderCommand_UpdateBuffer const*	updateBuffer	=	reinterpret_cast<RenderCommand_UpdateBuffer const*>(command);
+				ID3D11Buffer*						buffer			=	static_cast<ID3D11Buffer*>(updateBuffer->m_buffer);
+				D3D11_MAPPED_SUBRESOURCE			mappedSubresource;
+				HRESULT hResult = m_deviceContext->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mappedSubresource);
+				if (!SUCCEEDED(hResult))
+				{
+					ERROR_AND_DIE("Could not map the buffer");
+				}
+				memcpy(mappedSubresource.pData, updateBuffer->GetData(), updateBuffer->m_numOfBytes);
+				m_deviceContext->Unmap(buffer, 0);
+				break;
+			}
+			case RenderCommandType::COPY_RESOURCE:
+			{
+				RenderCommand_CopyResource const* copyResource = reinterpret_cast<RenderCommand_CopyResource const*>(command);
+				m_deviceContext->CopyResource(static_cast<ID3D11Resource*>(copyResource->m_destination), static_cast<ID3D11Resource*>(copyResource->m_source));
+				break;
+			}
+			case RenderCommandType::DRAW:
+			{
+				RenderCommand_Draw const* draw = reinterpret_cast<RenderCommand_Draw const*>(command);
+				m_deviceContext->Draw(draw->m_numOfVertexes, draw->m_startVertex);
+				break;
+			}
+			case RenderCommandType::DRAW_INDEXED:
+			{
+				RenderCommand_DrawIndexed const* draw = reinterpret_cast<RenderCommand_DrawIndexed const*>(command);
+				m_deviceContext->DrawIndexed(draw->m_numOfIndexes, draw->m_startIndex, draw->m_baseVertex);
+				break;
+			}
+			case RenderCommandType::DRAW_INDEXED_INSTANCED:
+			{
+				RenderCommand_DrawIndexedInstanced const* draw = reinterpret_cast<RenderCommand_DrawIndexedInstanced const*>(command);
+				m_deviceContext->DrawIndexedInstanced(draw->m_numOfIndexesPerInstance, draw->m_numOfInstances, draw->m_startIndex, draw->m_baseVertex, draw->m_startInstance);
+				break;
+			}
+			case RenderCommandType::DISPATCH:
+			{
+				RenderCommand_Dispatch const* dispatch = reinterpret_cast<RenderCommand_Dispatch const*>(command);
+				m_deviceContext->Dispatch(dispatch->m_numOfThreadGroupsX, dispatch->m_numOfThreadGroupsY, dispatch->m_numOfThreadGroupsZ);
+				break;
+			}
+			case RenderCommandType::BEGIN_EVENT:
+			{
+				if (m_debugAnnotation)
+				{
+					m_debugAnnotation->BeginEvent(reinterpret_cast<RenderCommand_Annotation const*>(command)->GetText());
+				}
+				break;
+			}
+			case RenderCommandType::END_EVENT:
+			{
+				if (m_debugAnnotation)
+				{
+					m_debugAnnotation->EndEvent();
+				}
+				break;
+			}
+			case RenderCommandType::SET_MARKER:
+			{
+				if (m_debugAnnotation)
+				{
+					m_debugAnnotation->SetMarker(reinterpret_cast<RenderCommand_Annotation const*>(command)->GetText());
+				}
+				break;
+			}
+			case RenderCommandType::BEGIN_TIMESTAMP_FRAME:
+			{
+				uint32_t frameSlot = reinterpret_cast<RenderCommand_Timestamp const*>(command)->m_frameSlot;
+				m_deviceContext->Begin(GetOrCreateQuery(m_deviceContext, m_disjointQueries[frameSlot], D3D11_QUERY_TIMESTAMP_DISJOINT));
+				break;
+			}
+			case RenderCommandType::WRITE_TIMESTAMP:
+			{
+				RenderCommand_Timestamp const* timestamp = reinterpret_cast<RenderCommand_Timestamp const*>(command);
+				m_deviceContext->End(GetOrCreateQuery(m_deviceContext, m_timestampQueries[timestamp->m_frameSlot][timestamp->m_timestampIndex], D3D11_QUERY_TIMESTAMP));
+				break;
+			}
+			case RenderCommandType::END_TIMESTAMP_FRAME:
+			{
+				uint32_t frameSlot = reinterpret_cast<RenderCommand_Timestamp const*>(command)->m_frameSlot;
+				m_deviceContext->End(GetOrCreateQuery(m_deviceContext, m_disjointQueries[frameSlot], D3D11_QUERY_TIMESTAMP_DISJOINT));
+				break;
+			}
+			case RenderCommandType::BEGIN_PIPELINE_STATISTICS:
+			{
+				RenderCommand_PipelineStatistics const* statistics = reinterpret_cast<RenderCommand_PipelineStatistics const*>(command);
+				m_deviceContext->Begin(GetOrCreateQuery(m_deviceContext, m_pipelineStatisticsQueries[statistics->m_frameSlot][statistics->m_queryIndex], D3D11_QUERY_PIPELINE_STATISTICS));
+				break;
+			}
+			case RenderCommandType::END_PIPELINE_STATISTICS:
+			{
+				RenderCommand_PipelineStatistics const* statistics = reinterpret_cast<RenderCommand_PipelineStatistics const*>(command);
+				m_deviceContext->End(GetOrCreateQuery(m_deviceContext, m_pipelineStatisticsQueries[statistics->m_frameSlot][statistics->m_queryIndex], D3D11_QUERY_PIPELINE_STATISTICS));
+				break;
+			}
+			case RenderCommandType::EXECUTE_COMMAND_BUFFER:
+			{
+				Execute(*reinterpret_cast<RenderCommand_ExecuteCommandBuffer const*>(command)->m_commandBuffer);
+				break;
+			}
+			default:
+			{
+				ERROR_AND_DIE("Unknown render command");
+			}
+		}
+	}
+}
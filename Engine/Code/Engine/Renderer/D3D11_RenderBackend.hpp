@@ -0,0 +1,63 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/RenderBackend.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+struct ID3DUserDefinedAnnotation;
+struct ID3D11DeviceContext1;
+struct ID3D11DeviceContext;
+struct ID3D11Buffer;
+struct ID3D11Query;
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int MAX_NUM_OF_FENCES_IN_FLIGHT = 8;		// Signaling past this waits for the oldest fence
+
+
+//--------------------------------------------------------------------------------------------------
+// Replays commands on the immediate context, every handle is the D3D11 object the Renderer recorded
+class D3D11_RenderBackend : public RenderBackend
+{
+public:
+	explicit D3D11_RenderBackend(ID3D11DeviceContext* deviceContext);
+	~D3D11_RenderBackend() override;
+
+	char const*		GetName() const override	{ return "D3D11"; }
+	void			SetDebugAnnotation(ID3DUserDefinedAnnotation* debugAnnotation);		// Annotations are dropped without one
+
+	void			ReserveTransientBuffer(TransientBufferType type, uint32_t sizeBytes) override;
+	RenderHandle	GetTransientBuffer(TransientBufferType type) const override;
+	bool			SupportsConstantBufferRanges() const override;		// Needs D3D11.1 with constant buffer offsetting and no overwrite maps of constant buffers
+	void			SignalFence(uint64_t fenceValue) override;			// An event query ends after the frame's commands
+	uint64_t		GetCompletedFenceValue() override;
+	bool			HasGPUTimestamps() const override	{ return true; }
+	bool			ReadGPUTimestamps(uint32_t frameSlot, uint32_t numOfTimestamps, double* out_gpuSeconds) override;		// Never waits for the GPU
+	bool			HasPipelineStatistics() const override	{ return true; }
+	bool			ReadPipelineStatistics(uint32_t frameSlot, uint32_t numOfQueries, PipelineStatistics* out_statistics) override;		// Never waits for the GPU
+
+protected:
+	void		Execute(RenderCommandBuffer const& commandBuffer) override;
+	void		WriteTransientBuffer(TransientBufferType type, unsigned char const* bytes, TransientRange const* ranges, int numOfRanges, bool discardsContents) override;
+
+private:
+	bool		RetireOldestFence(bool waitsForGPU);
+
+private:
+	ID3D11DeviceContext*		m_deviceContext											=	nullptr;
+	ID3D11DeviceContext1*		m_deviceContext1										=	nullptr;
+	ID3DUserDefinedAnnotation*	m_debugAnnotation										=	nullptr;
+	ID3D11Buffer*				m_transientBuffers[(int)TransientBufferType::COUNT]		=	{};
+	uint32_t					m_transientBufferSizes[(int)TransientBufferType::COUNT]	=	{};
+	ID3D11Query*				m_fenceQueries[MAX_NUM_OF_FENCES_IN_FLIGHT]				=	{};
+	uint64_t					m_fenceValues[MAX_NUM_OF_FENCES_IN_FLIGHT]				=	{};
+	int							m_oldestFenceIndex										=	0;
+	int							m_numOfFencesInFlight									=	0;
+	uint64_t					m_completedFenceValue									=	0;
+	ID3D11Query*				m_disjointQueries[NUM_OF_TIMESTAMP_FRAMES]				=	{};
+	ID3D11Query*				m_timestampQueries[NUM_OF_TIMESTAMP_FRAMES][MAX_NUM_OF_TIMESTAMPS_PER_FRAME]	=	{};
+	ID3D11Query*				m_pipelineStatisticsQueries[NUM_OF_TIMESTAMP_FRAMES][MAX_NUM_OF_PIPELINE_STATISTICS_PER_FRAME]	=	{};
+	bool						m_supportsConstantBufferRanges							=	false;
+};
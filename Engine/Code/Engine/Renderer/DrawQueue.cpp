@@ -0,0 +1,319 @@
+#include "Engine/Renderer/DrawQueue.hpp"
+#include "Engine/Renderer/RendererAnnotationJanitor.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------------------------
+static constexpr int		LAYER_SHIFT				=	60;
+static constexpr int		TRANSLUCENT_SHIFT		=	59;
+static constexpr uint64_t	SHADER_ID_MASK			=	(1ull << 10) - 1;
+static constexpr uint64_t	STATES_MASK				=	(1ull << 9) - 1;
+static constexpr uint64_t	TEXTURE_ID_MASK			=	(1ull << 16) - 1;
+static constexpr uint64_t	DEPTH_MASK				=	(1ull << 24) - 1;
+static constexpr uint32_t	INITIAL_ID_TABLE_SIZE	=	64;
+
+
+//--------------------------------------------------------------------------------------------------
+// Non negative floats order the same as their bit patterns, the top 24 of the 31 bits keep that order
+static uint64_t GetDepthBits(float depth)
+{
+	if (!(depth > 0.f))
+	{
+		return 0;
+	}
+	uint32_t depthBits;
+	memcpy(&depthBits, &depth, sizeof(depthBits));
+	return (uint64_t)(depthBits >> 7) & DEPTH_MASK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static uint32_t HashPointer(void const* pointer)
+{
+	uint64_t bits = (uint64_t)(uintptr_t)pointer;
+	return (uint32_t)((bits * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+DrawQueue::DrawQueue(Renderer& renderer) :
+	m_renderer(renderer)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void DrawQueue::AddDraw(QueuedDraw const& draw)
+{
+	DrawRecord record;
+	record.m_draw				=	draw;
+	record.m_blendMode			=	m_renderer.GetBlendMode();
+	record.m_samplerMode		=	m_renderer.GetSamplerMode();
+	record.m_rasterizerMode		=	m_renderer.GetRasterizerMode();
+	record.m_depthMode			=	m_renderer.GetDepthMode();
+	if (record.m_draw.m_shader == nullptr)
+	{
+		record.m_draw.m_shader	=	m_renderer.GetCurrentShader();
+	}
+	m_records.push_back(record);
+
+	SortItem sortItem;
+	sortItem.m_key		=	MakeSortKey(record);
+	sortItem.m_index	=	(uint32_t)(m_records.size() - 1);
+	m_sortItems.push_back(sortItem);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void DrawQueue::Submit()
+{
+	BlendMode		blendModeBeforeSubmit		=	m_renderer.GetBlendMode();
+	SamplerMode		samplerModeBeforeSubmit		=	m_renderer.GetSamplerMode();
+	RasterizerMode	rasterizerModeBeforeSubmit	=	m_renderer.GetRasterizerMode();
+	DepthMode		depthModeBeforeSubmit		=	m_renderer.GetDepthMode();
+
+	RadixSort();
+
+	// Only what the queue bound itself is known, so the first draw binds everything
+	Shader const*			boundShader				=	nullptr;
+	D3D11_Resource*			boundTexture			=	nullptr;
+	VertexBuffer const*		boundVertexBuffer		=	nullptr;
+	IndexBuffer const*		boundIndexBuffer		=	nullptr;
+	DrawRecord const*		previousRecord			=	nullptr;
+	for (int itemIndex = 0; itemIndex < (int)m_sortItems.size(); ++itemIndex)
+	{
+		DrawRecord const&	record	=	m_records[m_sortItems[itemIndex].m_index];
+		QueuedDraw const&	draw	=	record.m_draw;
+
+		// Binding null falls back to the default shader, for draws added before any shader was bound
+		if (previousRecord == nullptr || draw.m_shader != boundShader)
+		{
+			m_renderer.BindShader(draw.m_shader);
+			boundShader = draw.m_shader;
+		}
+		if (previousRecord == nullptr || draw.m_texture != boundTexture)
+		{
+			D3D11_Resource* texture = draw.m_texture;
+			m_renderer.BindReadableResources(&texture, 1, 0, BindingLocation::PIXEL_SHADER);
+			boundTexture = draw.m_texture;
+		}
+		if (previousRecord == nullptr || !(draw.m_modelColor == previousRecord->m_draw.m_modelColor) ||
+			memcmp(draw.m_modelMatrix.m_values, previousRecord->m_draw.m_modelMatrix.m_values, sizeof(draw.m_modelMatrix.m_values)) != 0)
+		{
+			m_renderer.SetModelConstants(draw.m_modelMatrix, draw.m_modelColor);
+		}
+		if (draw.m_vertexBuffer != boundVertexBuffer)
+		{
+			m_renderer.BindVertexBuffer(draw.m_vertexBuffer);
+			boundVertexBuffer = draw.m_vertexBuffer;
+		}
+		if (draw.m_indexBuffer && draw.m_indexBuffer != boundIndexBuffer)
+		{
+			m_renderer.BindIndexBuffer(draw.m_indexBuffer);
+			boundIndexBuffer = draw.m_indexBuffer;
+		}
+
+		// The Renderer already skips modes that did not change
+		SetBlendMode(record.m_blendMode);
+		m_renderer.SetSamplerMode(record.m_samplerMode);
+		m_renderer.SetRasterizerMode(record.m_rasterizerMode);
+		m_renderer.SetDepthMode(record.m_depthMode);
+		m_renderer.SetStatesIfChanged();
+
+		if (draw.m_debugName)
+		{
+			RendererAnnotationJanitor drawAnnotation(draw.m_debugName);
+			if (draw.m_indexBuffer)
+			{
+				m_renderer.DrawIndexed(draw.m_numOfElements);
+			}
+			else
+			{
+				m_renderer.Draw(draw.m_numOfElements);
+			}
+		}
+		else if (draw.m_indexBuffer)
+		{
+			m_renderer.DrawIndexed(draw.m_numOfElements);
+		}
+		else
+		{
+			m_renderer.Draw(draw.m_numOfElements);
+		}
+		previousRecord = &record;
+	}
+
+	SetBlendMode(blendModeBeforeSubmit);
+	m_renderer.SetSamplerMode(samplerModeBeforeSubmit);
+	m_renderer.SetRasterizerMode(rasterizerModeBeforeSubmit);
+	m_renderer.SetDepthMode(depthModeBeforeSubmit);
+	Clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void DrawQueue::Clear()
+{
+	m_records.clear();
+	m_sortItems.clear();
+	m_shaderIDs.Clear();
+	m_textureIDs.Clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int DrawQueue::GetNumOfDraws() const
+{
+	return (int)m_records.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The custom blend state is bound when it is set instead of at the draw, so it is only set again when another mode replaced it
+void DrawQueue::SetBlendMode(BlendMode blendMode)
+{
+	if (blendMode != BlendMode::INVALID)
+	{
+		m_renderer.SetBlendMode(blendMode);
+	}
+	else if (m_renderer.GetBlendMode() != BlendMode::INVALID)
+	{
+		m_renderer.SetCustomBlendMode();
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t DrawQueue::MakeSortKey(DrawRecord const& record)
+{
+	QueuedDraw const& draw = record.m_draw;
+
+	// Blend 3 bits, sampler 1, rasterizer 3, depth 2
+	uint64_t states		=	((uint64_t)record.m_blendMode << 6) | ((uint64_t)record.m_samplerMode << 5) | ((uint64_t)record.m_rasterizerMode << 2) | (uint64_t)record.m_depthMode;
+	uint64_t shaderID	=	(uint64_t)m_shaderIDs.GetOrAddID(draw.m_shader) & SHADER_ID_MASK;
+	uint64_t textureID	=	(uint64_t)m_textureIDs.GetOrAddID(draw.m_texture) & TEXTURE_ID_MASK;
+	uint64_t depth		=	GetDepthBits(draw.m_depth);
+	uint64_t key		=	((uint64_t)(draw.m_layer & 0xf) << LAYER_SHIFT);
+
+	if (!draw.m_isTranslucent)
+	{
+		return key | (shaderID << 49) | ((states & STATES_MASK) << 40) | (textureID << 24) | depth;
+	}
+
+	// Far draws have to come first, so the depth is flipped
+	return key | (1ull << TRANSLUCENT_SHIFT) | ((DEPTH_MASK - depth) << 35) | (shaderID << 25) | ((states & STATES_MASK) << 16) | textureID;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Least significant byte first, each pass is stable so draws with equal keys stay in the order they were added
+// A pass where every key has the same byte would not move anything and is skipped
+void DrawQueue::RadixSort()
+{
+	size_t numOfItems = m_sortItems.size();
+	m_sortScratch.resize(numOfItems);
+
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		size_t counts[256] = {};
+		for (size_t itemIndex = 0; itemIndex < numOfItems; ++itemIndex)
+		{
+			counts[(m_sortItems[itemIndex].m_key >> shift) & 0xff] += 1;
+		}
+		if (numOfItems == 0 || counts[(m_sortItems[0].m_key >> shift) & 0xff] == numOfItems)
+		{
+			continue;
+		}
+
+		size_t offset = 0;
+		for (int byteValue = 0; byteValue < 256; ++byteValue)
+		{
+			size_t count		=	counts[byteValue];
+			counts[byteValue]	=	offset;
+			offset				+=	count;
+		}
+		for (size_t itemIndex = 0; itemIndex < numOfItems; ++itemIndex)
+		{
+			SortItem const& item = m_sortItems[itemIndex];
+			m_sortScratch[counts[(item.m_key >> shift) & 0xff]++] = item;
+		}
+		m_sortItems.swap(m_sortScratch);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Null always gets ID 0, the empty slots are null pointers
+uint32_t DrawQueue::IDTable::GetOrAddID(void const* pointer)
+{
+	if (pointer == nullptr)
+	{
+		return 0;
+	}
+	if ((m_numOfIDs + 1) * 2 > (uint32_t)m_pointers.size())
+	{
+		Grow();
+	}
+
+	uint32_t mask = (uint32_t)m_pointers.size() - 1;
+	for (uint32_t slot = HashPointer(pointer) & mask; ; slot = (slot + 1) & mask)
+	{
+		if (m_pointers[slot] == pointer)
+		{
+			return m_ids[slot];
+		}
+		if (m_pointers[slot] == nullptr)
+		{
+			m_numOfIDs			+=	1;
+			m_pointers[slot]	=	pointer;
+			m_ids[slot]			=	m_numOfIDs;
+			return m_numOfIDs;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void DrawQueue::IDTable::Clear()
+{
+	if (m_numOfIDs == 0)
+	{
+		return;
+	}
+	std::fill(m_pointers.begin(), m_pointers.end(), nullptr);
+	m_numOfIDs = 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void DrawQueue::IDTable::Grow()
+{
+	std::vector<void const*>	oldPointers;
+	std::vector<uint32_t>		oldIDs;
+	oldPointers.swap(m_pointers);
+	oldIDs.swap(m_ids);
+
+	uint32_t newSize = oldPointers.empty() ? INITIAL_ID_TABLE_SIZE : (uint32_t)oldPointers.size() * 2;
+	m_pointers.assign(newSize, nullptr);
+	m_ids.assign(newSize, 0);
+
+	uint32_t mask = newSize - 1;
+	for (size_t oldSlot = 0; oldSlot < oldPointers.size(); ++oldSlot)
+	{
+		if (oldPointers[oldSlot] == nullptr)
+		{
+			continue;
+		}
+		uint32_t slot = HashPointer(oldPointers[oldSlot]) & mask;
+		while (m_pointers[slot] != nullptr)
+		{
+			slot = (slot + 1) & mask;
+		}
+		m_pointers[slot]	=	oldPointers[oldSlot];
+		m_ids[slot]			=	oldIDs[oldSlot];
+	}
+}
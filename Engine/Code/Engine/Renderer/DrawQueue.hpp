@@ -0,0 +1,94 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Core/Rgba8.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+class Shader;
+class IndexBuffer;
+class VertexBuffer;
+class D3D11_Resource;
+
+
+//--------------------------------------------------------------------------------------------------
+// Everything a draw binds, the blend, sampler, rasterizer and depth modes and a missing shader are taken from the Renderer when it is added
+struct QueuedDraw
+{
+	Shader*				m_shader			=	nullptr;		// Null draws with the shader bound when the draw is added
+	D3D11_Resource*		m_texture			=	nullptr;		// Pixel shader slot 0, null binds the default texture
+	VertexBuffer*		m_vertexBuffer		=	nullptr;
+	IndexBuffer*		m_indexBuffer		=	nullptr;		// Null draws m_numOfElements vertexes without indexes
+	unsigned int		m_numOfElements		=	0;
+	Mat44				m_modelMatrix;
+	Rgba8				m_modelColor		=	Rgba8::WHITE;
+	wchar_t const*		m_debugName			=	nullptr;		// Annotates the draw when set
+	float				m_depth				=	0.f;			// Distance from the camera, any measure that grows with distance works
+	unsigned char		m_layer				=	0;				// Lower layers draw first, 16 layers
+	bool				m_isTranslucent		=	false;			// Drawn after the layer's opaque draws, far to near
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Collects draws and submits them in sort key order, binding only what differs from the previous draw
+// Key, most significant bits first:
+//	opaque		layer 4 | 0 | shader 10 | states 9 | texture 16 | depth 24, near to far
+//	translucent	layer 4 | 1 | depth 24, far to near | shader 10 | states 9 | texture 16
+// Shader and texture IDs are handed out in the order they are first added, so equal frames sort the same
+class DrawQueue
+{
+public:
+	explicit DrawQueue(Renderer& renderer);
+
+	void		AddDraw(QueuedDraw const& draw);
+	void		Submit();		// Leaves the Renderer's blend, sampler, rasterizer and depth modes as they were
+	void		Clear();
+	int			GetNumOfDraws() const;
+
+private:
+	struct DrawRecord
+	{
+		QueuedDraw		m_draw;
+		BlendMode		m_blendMode			=	BlendMode::INVALID;
+		SamplerMode		m_samplerMode		=	SamplerMode::POINT_CLAMP;
+		RasterizerMode	m_rasterizerMode	=	RasterizerMode::SOLID_CULL_BACK;
+		DepthMode		m_depthMode			=	DepthMode::ENABLED;
+	};
+
+	struct SortItem
+	{
+		uint64_t	m_key		=	0;
+		uint32_t	m_index		=	0;
+	};
+
+	// Open addressed pointer to ID table, cleared every submit without giving back its memory
+	struct IDTable
+	{
+		std::vector<void const*>	m_pointers;
+		std::vector<uint32_t>		m_ids;
+		uint32_t					m_numOfIDs		=	0;
+
+		uint32_t	GetOrAddID(void const* pointer);
+		void		Clear();
+		void		Grow();
+	};
+
+	uint64_t	MakeSortKey(DrawRecord const& record);
+	void		RadixSort();
+	void		SetBlendMode(BlendMode blendMode);
+
+private:
+	Renderer&				m_renderer;
+	std::vector<DrawRecord>	m_records;
+	std::vector<SortItem>	m_sortItems;
+	std::vector<SortItem>	m_sortScratch;
+	IDTable					m_shaderIDs;
+	IDTable					m_textureIDs;
+};
@@ -3,6 +3,7 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Core/VertexQuantization.hpp"
 
 
 //--------------------------------------------------------------------------------------------------
@@ -30,9 +31,33 @@ GPUMesh::~GPUMesh()
 //--------------------------------------------------------------------------------------------------
 void GPUMesh::PopulateVertexAndIndexBuffersUsingCPUMesh(CPUMesh const* cpuMesh)
 {
-	g_theRenderer->CopyCPUToGPU(cpuMesh->m_cpuVerts.data(),		(size_t)m_gpuVertexBuffer->GetStride()	*  cpuMesh->m_cpuVerts.size(),		m_gpuVertexBuffer);
-	g_theRenderer->CopyCPUToGPU(cpuMesh->m_cpuIndexes.data(),	(size_t)m_gpuIndexBuffer->GetStride()	*  cpuMesh->m_cpuIndexes.size(),	m_gpuIndexBuffer);
-	m_indexCount = (int)cpuMesh->m_cpuIndexes.size();
+	if (m_gpuVertexBuffer->GetStride() != (unsigned int)sizeof(Vertex_PCUTBN))
+	{
+		delete m_gpuVertexBuffer;
+		m_gpuVertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN), (unsigned int)sizeof(Vertex_PCUTBN));
+	}
+	g_theRenderer->CopyCPUToGPU(cpuMesh->GetVerts(),	(size_t)m_gpuVertexBuffer->GetStride()	*  cpuMesh->GetNumOfVerts(),	m_gpuVertexBuffer);
+	g_theRenderer->CopyCPUToGPU(cpuMesh->GetIndexes(),	(size_t)m_gpuIndexBuffer->GetStride()	*  cpuMesh->GetNumOfIndexes(),	m_gpuIndexBuffer);
+	m_indexCount = (int)cpuMesh->GetNumOfIndexes();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void GPUMesh::PopulateQuantizedVertexAndIndexBuffersUsingCPUMesh(CPUMesh const* cpuMesh)
+{
+	unsigned int quantizedStride = (unsigned int)sizeof(Vertex_PCUTBN_Quantized);
+	if (m_gpuVertexBuffer->GetStride() != quantizedStride)
+	{
+		delete m_gpuVertexBuffer;
+		m_gpuVertexBuffer = g_theRenderer->CreateVertexBuffer(quantizedStride, quantizedStride);
+	}
+
+	std::vector<Vertex_PCUTBN_Quantized> quantizedVerts(cpuMesh->GetNumOfVerts());
+	m_quantizationBounds = GetQuantizationBounds(cpuMesh->GetVerts(), cpuMesh->GetNumOfVerts());
+	EncodeQuantizedVertexes(cpuMesh->GetVerts(), cpuMesh->GetNumOfVerts(), m_quantizationBounds, quantizedVerts.data());
+	g_theRenderer->CopyCPUToGPU(quantizedVerts.data(),		(size_t)quantizedStride					*  quantizedVerts.size(),		m_gpuVertexBuffer);
+	g_theRenderer->CopyCPUToGPU(cpuMesh->GetIndexes(),		(size_t)m_gpuIndexBuffer->GetStride()	*  cpuMesh->GetNumOfIndexes(),	m_gpuIndexBuffer);
+	m_indexCount = (int)cpuMesh->GetNumOfIndexes();
 }
 
 
@@ -1,6 +1,10 @@
 #pragma once
 
 
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Math/AABB3.hpp"
+
+
 //--------------------------------------------------------------------------------------------------
 class VertexBuffer;
 class IndexBuffer;
@@ -14,6 +18,8 @@ public:
 	~GPUMesh();
 
 	void PopulateVertexAndIndexBuffersUsingCPUMesh(CPUMesh const* cpuMesh);
+	// Uploads Vertex_PCUTBN_Quantized vertexes instead, draw with GetDequantizationMatrix(m_quantizationBounds) appended to the model matrix
+	void PopulateQuantizedVertexAndIndexBuffersUsingCPUMesh(CPUMesh const* cpuMesh);
 	void Render() const;
 
 private:
@@ -22,4 +28,5 @@ private:
 public:
 	VertexBuffer*	m_gpuVertexBuffer	= nullptr;
 	IndexBuffer*	m_gpuIndexBuffer	= nullptr;
+	AABB3			m_quantizationBounds;
 };
\ No newline at end of file
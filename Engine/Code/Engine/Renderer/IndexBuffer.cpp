@@ -11,6 +11,11 @@ IndexBuffer::IndexBuffer(size_t size) :
 
 IndexBuffer::~IndexBuffer()
 {
+	if (m_renderer)
+	{
+		m_renderer->ReleaseAfterFlush(m_buffer);
+		m_buffer = nullptr;
+	}
 	DX_SAFE_RELEASE(m_buffer);
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 struct ID3D11Buffer;
+class Renderer;
 
 class IndexBuffer
 {
@@ -16,4 +17,5 @@ public:
 public:
 	ID3D11Buffer* m_buffer = nullptr;
 	size_t m_size = 0;
+	Renderer* m_renderer = nullptr;
 };
\ No newline at end of file
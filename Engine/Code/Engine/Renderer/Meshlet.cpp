@@ -0,0 +1,318 @@
+#include "Engine/Renderer/Meshlet.hpp"
+#include "Engine/Renderer/CPUMesh.hpp"
+#include "Engine/Renderer/Camera.hpp"
+#include "Engine/Core/VertexUtils.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Math/Frustum.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <math.h>
+
+
+//--------------------------------------------------------------------------------------------------
+// Below this the normals spread over more than a hemisphere (minus a small margin) and the cone is useless
+constexpr float MESHLET_MIN_CONE_DOT = 0.1f;
+// Once a meshlet has its minimum number of triangles, a triangle bending further than 60 degrees away from the average starts a new meshlet
+constexpr float MESHLET_SPLIT_NORMAL_DOT = 0.5f;
+
+
+//--------------------------------------------------------------------------------------------------
+static Vec3 GetTriangleNormal(std::vector<Vertex_PCUTBN> const& verts, unsigned int const* triangleIndexes)
+{
+	Vec3 const& pos0 = verts[triangleIndexes[0]].m_position;
+	Vec3 const& pos1 = verts[triangleIndexes[1]].m_position;
+	Vec3 const& pos2 = verts[triangleIndexes[2]].m_position;
+	Vec3 normal = CrossProduct3D(pos1 - pos0, pos2 - pos0);
+	float lengthSquared = normal.GetLengthSquared();
+	if (lengthSquared <= 0.f)
+	{
+		return Vec3::ZERO;
+	}
+	return normal / sqrtf(lengthSquared);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void ComputeMeshletBounds(CPUMesh const& cpuMesh, Meshlet& meshlet)
+{
+	std::vector<Vertex_PCUTBN> const&	verts	=	cpuMesh.m_cpuVerts;
+	unsigned int const*					indexes	=	cpuMesh.m_cpuIndexes.data() + meshlet.m_firstIndex;
+	unsigned int						numOfIndexes = meshlet.m_numOfTriangles * 3;
+
+	// AABB
+	Vec3 mins = verts[indexes[0]].m_position;
+	Vec3 maxs = mins;
+	for (unsigned int index = 1; index < numOfIndexes; ++index)
+	{
+		Vec3 const& pos = verts[indexes[index]].m_position;
+		mins.x = pos.x < mins.x ? pos.x : mins.x;
+		mins.y = pos.y < mins.y ? pos.y : mins.y;
+		mins.z = pos.z < mins.z ? pos.z : mins.z;
+		maxs.x = pos.x > maxs.x ? pos.x : maxs.x;
+		maxs.y = pos.y > maxs.y ? pos.y : maxs.y;
+		maxs.z = pos.z > maxs.z ? pos.z : maxs.z;
+	}
+	meshlet.m_bounds = AABB3(mins, maxs);
+
+	// Bounding sphere around the box center, tighter than the box's own circumsphere
+	meshlet.m_sphereCenter = meshlet.m_bounds.GetCenter();
+	float maxDistSquared = 0.f;
+	for (unsigned int index = 0; index < numOfIndexes; ++index)
+	{
+		float distSquared = GetDistanceSquared3D(verts[indexes[index]].m_position, meshlet.m_sphereCenter);
+		maxDistSquared = distSquared > maxDistSquared ? distSquared : maxDistSquared;
+	}
+	meshlet.m_sphereRadius = sqrtf(maxDistSquared);
+
+	// Normal cone
+	Vec3 normalSum;
+	for (unsigned int triIndex = 0; triIndex < meshlet.m_numOfTriangles; ++triIndex)
+	{
+		normalSum += GetTriangleNormal(verts, indexes + triIndex * 3);
+	}
+	meshlet.m_coneAxis		=	Vec3::ZERO;
+	meshlet.m_coneCutoff	=	1.f;
+	if (normalSum.GetLengthSquared() <= 0.f)
+	{
+		return;
+	}
+	Vec3 coneAxis	=	normalSum.GetNormalized();
+	float minDot	=	1.f;
+	for (unsigned int triIndex = 0; triIndex < meshlet.m_numOfTriangles; ++triIndex)
+	{
+		Vec3 triNormal = GetTriangleNormal(verts, indexes + triIndex * 3);
+		if (triNormal == Vec3::ZERO)
+		{
+			continue;
+		}
+		float dot	= DotProduct3D(triNormal, coneAxis);
+		minDot		= dot < minDot ? dot : minDot;
+	}
+	if (minDot <= MESHLET_MIN_CONE_DOT)
+	{
+		return;
+	}
+	// The visibility cone is the normal cone widened by 90 degrees on each side, cos(a + 90) = -sin(a)
+	meshlet.m_coneAxis		=	coneAxis;
+	meshlet.m_coneCutoff	=	sqrtf(1.f - minDot * minDot);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static unsigned int SpreadBitsBy2(unsigned int value)
+{
+	value = (value | (value << 16)) & 0x030000FF;
+	value = (value | (value <<  8)) & 0x0300F00F;
+	value = (value | (value <<  4)) & 0x030C30C3;
+	value = (value | (value <<  2)) & 0x09249249;
+	return value;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Sorts the triangles along a 30 bit morton curve through the mesh bounds so that neighbouring triangles end up next to each other
+static void SortTrianglesSpatially(CPUMesh& cpuMesh)
+{
+	std::vector<Vertex_PCUTBN> const&	verts			=	cpuMesh.m_cpuVerts;
+	std::vector<unsigned int>&			indexes			=	cpuMesh.m_cpuIndexes;
+	unsigned int						numOfTriangles	=	(unsigned int)indexes.size() / 3;
+
+	Vec3 meshMins = verts[indexes[0]].m_position;
+	Vec3 meshMaxs = meshMins;
+	for (size_t index = 1; index < (size_t)numOfTriangles * 3; ++index)
+	{
+		Vec3 const& pos = verts[indexes[index]].m_position;
+		meshMins.x = pos.x < meshMins.x ? pos.x : meshMins.x;
+		meshMins.y = pos.y < meshMins.y ? pos.y : meshMins.y;
+		meshMins.z = pos.z < meshMins.z ? pos.z : meshMins.z;
+		meshMaxs.x = pos.x > meshMaxs.x ? pos.x : meshMaxs.x;
+		meshMaxs.y = pos.y > meshMaxs.y ? pos.y : meshMaxs.y;
+		meshMaxs.z = pos.z > meshMaxs.z ? pos.z : meshMaxs.z;
+	}
+	Vec3 meshDims = meshMaxs - meshMins;
+	Vec3 centroidScale;
+	centroidScale.x = meshDims.x > 0.f ? 1023.f / (meshDims.x * 3.f) : 0.f;
+	centroidScale.y = meshDims.y > 0.f ? 1023.f / (meshDims.y * 3.f) : 0.f;
+	centroidScale.z = meshDims.z > 0.f ? 1023.f / (meshDims.z * 3.f) : 0.f;
+
+	// Pairs of (morton code, triangle index)
+	std::vector<unsigned long long> sortKeys;
+	sortKeys.resize(numOfTriangles);
+	for (unsigned int triIndex = 0; triIndex < numOfTriangles; ++triIndex)
+	{
+		unsigned int const* triIndexes = indexes.data() + (size_t)triIndex * 3;
+		Vec3 centroidSum = verts[triIndexes[0]].m_position + verts[triIndexes[1]].m_position + verts[triIndexes[2]].m_position - meshMins * 3.f;
+		unsigned int quantizedX = (unsigned int)(centroidSum.x * centroidScale.x);
+		unsigned int quantizedY = (unsigned int)(centroidSum.y * centroidScale.y);
+		unsigned int quantizedZ = (unsigned int)(centroidSum.z * centroidScale.z);
+		unsigned int mortonCode = SpreadBitsBy2(quantizedX) | (SpreadBitsBy2(quantizedY) << 1) | (SpreadBitsBy2(quantizedZ) << 2);
+		sortKeys[triIndex] = ((unsigned long long)mortonCode << 32) | triIndex;
+	}
+	std::sort(sortKeys.begin(), sortKeys.end());
+
+	std::vector<unsigned int> sortedIndexes;
+	sortedIndexes.resize((size_t)numOfTriangles * 3);
+	for (unsigned int sortedTriIndex = 0; sortedTriIndex < numOfTriangles; ++sortedTriIndex)
+	{
+		unsigned int		sourceTriIndex	=	(unsigned int)(sortKeys[sortedTriIndex] & 0xFFFFFFFF);
+		unsigned int const*	sourceIndexes	=	indexes.data() + (size_t)sourceTriIndex * 3;
+		sortedIndexes[(size_t)sortedTriIndex * 3 + 0] = sourceIndexes[0];
+		sortedIndexes[(size_t)sortedTriIndex * 3 + 1] = sourceIndexes[1];
+		sortedIndexes[(size_t)sortedTriIndex * 3 + 2] = sourceIndexes[2];
+	}
+	indexes.swap(sortedIndexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void BuildMeshlets(CPUMesh& cpuMesh, std::vector<Meshlet>& out_meshlets, unsigned int minTrianglesPerMeshlet, unsigned int maxTrianglesPerMeshlet)
+{
+	GUARANTEE_OR_DIE(minTrianglesPerMeshlet > 0, "A meshlet needs at least one triangle before it can split");
+	// Triangles get reordered, so a mapped mesh needs its own copy
+	cpuMesh.CopyMappedDataToVectors();
+	std::vector<unsigned int> const& indexes = cpuMesh.m_cpuIndexes;
+	unsigned int numOfTriangles = (unsigned int)indexes.size() / 3;
+	if (numOfTriangles == 0)
+	{
+		return;
+	}
+	out_meshlets.reserve(out_meshlets.size() + numOfTriangles / minTrianglesPerMeshlet + 1);
+
+	SortTrianglesSpatially(cpuMesh);
+
+	Meshlet currentMeshlet;
+	Vec3	currentNormalSum;
+	for (unsigned int triIndex = 0; triIndex < numOfTriangles; ++triIndex)
+	{
+		Vec3 triNormal		=	GetTriangleNormal(cpuMesh.m_cpuVerts, indexes.data() + (size_t)triIndex * 3);
+		bool isFull			=	currentMeshlet.m_numOfTriangles >= maxTrianglesPerMeshlet;
+		bool canSplitEarly	=	currentMeshlet.m_numOfTriangles >= minTrianglesPerMeshlet && currentNormalSum.GetLengthSquared() > 0.f;
+		if (isFull || (canSplitEarly && DotProduct3D(triNormal, currentNormalSum.GetNormalized()) < MESHLET_SPLIT_NORMAL_DOT))
+		{
+			ComputeMeshletBounds(cpuMesh, currentMeshlet);
+			out_meshlets.push_back(currentMeshlet);
+			currentMeshlet					=	Meshlet();
+			currentMeshlet.m_firstIndex		=	triIndex * 3;
+			currentNormalSum				=	Vec3::ZERO;
+		}
+		currentMeshlet.m_numOfTriangles	+= 1;
+		currentNormalSum				+= triNormal;
+	}
+	ComputeMeshletBounds(cpuMesh, currentMeshlet);
+	out_meshlets.push_back(currentMeshlet);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void CullMeshlets(CPUMesh const& cpuMesh, std::vector<Meshlet> const& meshlets, Frustum const& frustum, Vec3 const& cameraPosition, std::vector<unsigned int>& out_visibleIndexes, MeshletCullStats* out_stats)
+{
+	double timeBeforeCulling = GetCurrentTimeSeconds();
+
+	// Keep the capacity from the previous frame so steady state culling never allocates
+	out_visibleIndexes.clear();
+	out_visibleIndexes.reserve(cpuMesh.GetNumOfIndexes());
+
+	MeshletCullStats stats;
+	unsigned int const* meshIndexes = cpuMesh.GetIndexes();
+	for (size_t meshletIndex = 0; meshletIndex < meshlets.size(); ++meshletIndex)
+	{
+		Meshlet const& meshlet = meshlets[meshletIndex];
+		stats.m_numOfMeshletsTested		+= 1;
+		stats.m_numOfTrianglesTested	+= meshlet.m_numOfTriangles;
+
+		if (frustum.IsSphereOutside(meshlet.m_sphereCenter, meshlet.m_sphereRadius) || frustum.IsAABB3Outside(meshlet.m_bounds))
+		{
+			stats.m_numOfMeshletsFrustumCulled += 1;
+			continue;
+		}
+
+		if (meshlet.m_coneCutoff < 1.f)
+		{
+			Vec3	dispFromCameraToCenter	=	meshlet.m_sphereCenter - cameraPosition;
+			float	distToCenter			=	dispFromCameraToCenter.GetLength();
+			if (DotProduct3D(dispFromCameraToCenter, meshlet.m_coneAxis) >= meshlet.m_coneCutoff * distToCenter + meshlet.m_sphereRadius)
+			{
+				stats.m_numOfMeshletsBackfaceCulled += 1;
+				continue;
+			}
+		}
+
+		unsigned int const* meshletIndexes = meshIndexes + meshlet.m_firstIndex;
+		out_visibleIndexes.insert(out_visibleIndexes.end(), meshletIndexes, meshletIndexes + meshlet.m_numOfTriangles * 3);
+		stats.m_numOfTrianglesVisible += meshlet.m_numOfTriangles;
+	}
+
+	stats.m_cullTimeSeconds = GetCurrentTimeSeconds() - timeBeforeCulling;
+	if (out_stats)
+	{
+		*out_stats = stats;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Command_MeshletCullBenchmark(EventArgs& args)
+{
+	int numOfSlices		=	args.GetValue("Slices", 1024);
+	int numOfStacks		=	args.GetValue("Stacks", 512);
+	int numOfIterations =	args.GetValue("Iterations", 16);
+	if (numOfSlices < 3 || numOfStacks < 2 || numOfIterations < 1)
+	{
+		return false;
+	}
+
+	CPUMesh benchmarkMesh;
+	AddVertsForSphere3D(benchmarkMesh.m_cpuVerts, benchmarkMesh.m_cpuIndexes, Vec3::ZERO, 10.f, (float)numOfSlices, (float)numOfStacks);
+
+	double timeBeforeBuilding = GetCurrentTimeSeconds();
+	std::vector<Meshlet> meshlets;
+	BuildMeshlets(benchmarkMesh, meshlets);
+	double buildTimeSeconds = GetCurrentTimeSeconds() - timeBeforeBuilding;
+
+	// Orbit a game style camera around the sphere so both the frustum and the cone tests get exercised
+	Camera camera;
+	camera.SetRenderBasis(Vec3(0.f, 0.f, 1.f), Vec3(-1.f, 0.f, 0.f), Vec3(0.f, 1.f, 0.f));
+	camera.SetPerspectiveView(2.f, 60.f, 0.1f, 100.f);
+
+	std::vector<unsigned int>	visibleIndexes;
+	double						totalCullTimeSeconds		=	0.0;
+	double						totalTrianglesTested		=	0.0;
+	double						totalTrianglesVisible		=	0.0;
+	int const					numOfViews					=	8;
+	for (int iteration = 0; iteration < numOfIterations; ++iteration)
+	{
+		for (int viewIndex = 0; viewIndex < numOfViews; ++viewIndex)
+		{
+			float	orbitYawDegrees		=	(360.f / (float)numOfViews) * (float)viewIndex;
+			Vec3	cameraPosition		=	Vec3::MakeFromPolarDegrees(0.f, orbitYawDegrees, 16.f);
+			// Alternate between looking at the sphere and looking off to its side
+			float	lookYawDegrees		=	orbitYawDegrees + 180.f + ((viewIndex & 1) ? 35.f : 0.f);
+			camera.SetTransform(cameraPosition, EulerAngles(lookYawDegrees, 0.f, 0.f));
+
+			MeshletCullStats stats;
+			CullMeshlets(benchmarkMesh, meshlets, camera.GetWorldFrustum(), cameraPosition, visibleIndexes, &stats);
+			totalCullTimeSeconds	+= stats.m_cullTimeSeconds;
+			totalTrianglesTested	+= (double)stats.m_numOfTrianglesTested;
+			totalTrianglesVisible	+= (double)stats.m_numOfTrianglesVisible;
+		}
+	}
+
+	size_t	numOfTriangles			=	benchmarkMesh.m_cpuIndexes.size() / 3;
+	double	culledTriangleRatio		=	1.0 - (totalTrianglesVisible / totalTrianglesTested);
+	double	msPerMillionTriangles	=	(totalCullTimeSeconds * 1000.0) / (totalTrianglesTested / 1000000.0);
+	std::string buildResult = Stringf("Meshlets: %d triangles -> %d meshlets (avg %.1f tris) built in %.2f ms", (int)numOfTriangles, (int)meshlets.size(), (double)numOfTriangles / (double)meshlets.size(), buildTimeSeconds * 1000.0);
+	std::string cullResult	= Stringf("Meshlets: culled %.1f%% of triangles, %.3f ms per million triangles", culledTriangleRatio * 100.0, msPerMillionTriangles);
+	DebuggerPrintf("\n%s\n%s\n", buildResult.c_str(), cullResult.c_str());
+	if (g_theDevConsole)
+	{
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, buildResult);
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, cullResult);
+	}
+	return true;
+}
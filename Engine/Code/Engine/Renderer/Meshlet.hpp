@@ -0,0 +1,57 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Math/AABB3.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+struct Frustum;
+class CPUMesh;
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr unsigned int MESHLET_MIN_TRIANGLES = 64;
+constexpr unsigned int MESHLET_MAX_TRIANGLES = 128;
+
+
+//--------------------------------------------------------------------------------------------------
+// A contiguous run of triangles inside the owning mesh's index list
+struct Meshlet
+{
+	AABB3			m_bounds;
+	Vec3			m_sphereCenter;
+	float			m_sphereRadius		=	0.f;
+	Vec3			m_coneAxis;
+	float			m_coneCutoff		=	1.f;	// Sine of the normal cone half angle, 1 means the meshlet is never backface culled
+	unsigned int	m_firstIndex		=	0;
+	unsigned int	m_numOfTriangles	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct MeshletCullStats
+{
+	unsigned int	m_numOfMeshletsTested			=	0;
+	unsigned int	m_numOfMeshletsFrustumCulled	=	0;
+	unsigned int	m_numOfMeshletsBackfaceCulled	=	0;
+	unsigned int	m_numOfTrianglesTested			=	0;
+	unsigned int	m_numOfTrianglesVisible			=	0;
+	double			m_cullTimeSeconds				=	0.0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Reorders the mesh triangles so every meshlet owns a contiguous range of the index list, minTrianglesPerMeshlet must be at least 1
+void BuildMeshlets(CPUMesh& cpuMesh, std::vector<Meshlet>& out_meshlets, unsigned int minTrianglesPerMeshlet = MESHLET_MIN_TRIANGLES, unsigned int maxTrianglesPerMeshlet = MESHLET_MAX_TRIANGLES);
+void CullMeshlets(CPUMesh const& cpuMesh, std::vector<Meshlet> const& meshlets, Frustum const& frustum, Vec3 const& cameraPosition, std::vector<unsigned int>& out_visibleIndexes, MeshletCullStats* out_stats = nullptr);
+
+
+//--------------------------------------------------------------------------------------------------
+// Console Commands
+bool Command_MeshletCullBenchmark(EventArgs& args);
@@ -0,0 +1,412 @@
+#include "Engine/Renderer/NullRenderBackend.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+// D3D11 limits, so a stream that passes here does not trip the debug layer on the real backend
+static constexpr uint32_t MAX_NUM_OF_RENDER_TARGETS				=	8;
+static constexpr uint32_t MAX_NUM_OF_SHADER_RESOURCE_SLOTS		=	128;
+static constexpr uint32_t MAX_NUM_OF_UAV_SLOTS					=	64;
+static constexpr uint32_t MAX_NUM_OF_CONSTANT_BUFFER_SLOTS		=	14;
+static constexpr uint32_t MAX_NUM_OF_SAMPLER_SLOTS				=	16;
+static constexpr uint32_t MAX_NUM_OF_VERTEX_BUFFER_SLOTS		=	32;
+static constexpr uint32_t MAX_NUM_OF_THREAD_GROUPS_PER_AXIS		=	65535;
+static constexpr uint32_t MAX_NUM_OF_CONSTANTS_IN_RANGE			=	4096;
+static constexpr uint32_t CONSTANT_RANGE_GRANULARITY			=	16;
+
+
+//--------------------------------------------------------------------------------------------------
+void NullRenderBackend::Execute(RenderCommandBuffer const& commandBuffer)
+{
+	for (RenderCommandHeader const* command = commandBuffer.GetFirstCommand(); command != nullptr; command = commandBuffer.GetNextCommand(command))
+	{
+		CountCommand(command);
+		ValidateCommand(command);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void NullRenderBackend::ReserveTransientBuffer(TransientBufferType type, uint32_t sizeBytes)
+{
+	m_transientBufferSizes[(int)type] = sizeBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderHandle NullRenderBackend::GetTransientBuffer(TransientBufferType type) const
+{
+	return const_cast<uint32_t*>(&m_transientBufferSizes[(int)type]);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void NullRenderBackend::SignalFence(uint64_t fenceValue)
+{
+	m_completedFenceValue = fenceValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t NullRenderBackend::GetCompletedFenceValue()
+{
+	return m_completedFenceValue;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool NullRenderBackend::ReadGPUTimestamps(uint32_t frameSlot, uint32_t numOfTimestamps, double* out_gpuSeconds)
+{
+	(void)frameSlot;
+	(void)numOfTimestamps;
+	(void)out_gpuSeconds;
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool NullRenderBackend::ReadPipelineStatistics(uint32_t frameSlot, uint32_t numOfQueries, PipelineStatistics* out_statistics)
+{
+	(void)frameSlot;
+	(void)numOfQueries;
+	(void)out_statistics;
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void NullRenderBackend::WriteTransientBuffer(TransientBufferType type, unsigned char const* bytes, TransientRange const* ranges, int numOfRanges, bool discardsContents)
+{
+	(void)discardsContents;
+	if (bytes == nullptr)
+	{
+		ReportError("Transient upload without data");
+	}
+	for (int rangeIndex = 0; rangeIndex < numOfRanges; ++rangeIndex)
+	{
+		if ((uint64_t)ranges[rangeIndex].m_firstByte + ranges[rangeIndex].m_numOfBytes > m_transientBufferSizes[(int)type])
+		{
+			ReportError("Transient upload past the end of the reserved buffer");
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void NullRenderBackend::ValidateCommand(RenderCommandHeader const* command)
+{
+	switch (command->m_type)
+	{
+		case RenderCommandType::SET_RENDER_TARGETS:
+		{
+			RenderCommand_SetRenderTargets const* setRenderTargets = reinterpret_cast<RenderCommand_SetRenderTargets const*>(command);
+			if (setRenderTargets->m_numOfRenderTargets > MAX_NUM_OF_RENDER_TARGETS)
+			{
+				ReportError("More than 8 render targets bound");
+			}
+			if (setRenderTargets->m_setsUAVs && setRenderTargets->m_numOfUAVs > 0)
+			{
+				if (setRenderTargets->m_uavStartSlot < setRenderTargets->m_numOfRenderTargets)
+				{
+					ReportError("Pixel shader UAVs start in a slot used by a render target");
+				}
+				if (setRenderTargets->m_uavStartSlot + setRenderTargets->m_numOfUAVs > MAX_NUM_OF_UAV_SLOTS)
+				{
+					ReportError("Pixel shader UAVs past the last UAV slot");
+				}
+			}
+
+			RenderHandle const* renderTargetViews = setRenderTargets->GetRenderTargetViews();
+			m_numOfRenderTargets = 0;
+			for (uint32_t viewIndex = 0; viewIndex < setRenderTargets->m_numOfRenderTargets; ++viewIndex)
+			{
+				m_numOfRenderTargets += renderTargetViews[viewIndex] != nullptr ? 1 : 0;
+			}
+			m_depthStencilView = setRenderTargets->m_depthStencilView;
+			if (setRenderTargets->m_setsUAVs)
+			{
+				RenderHandle const* uavs = setRenderTargets->GetUAVs();
+				m_numOfPixelShaderUAVs = 0;
+				for (uint32_t uavIndex = 0; uavIndex < setRenderTargets->m_numOfUAVs; ++uavIndex)
+				{
+					m_numOfPixelShaderUAVs += uavs[uavIndex] != nullptr ? 1 : 0;
+				}
+			}
+			break;
+		}
+		case RenderCommandType::SET_VIEWPORT:
+		{
+			RenderCommand_SetViewport const* setViewport = reinterpret_cast<RenderCommand_SetViewport const*>(command);
+			if (setViewport->m_width < 0.f || setViewport->m_height < 0.f || setViewport->m_minDepth > setViewport->m_maxDepth)
+			{
+				ReportError("Viewport with a negative size or an inverted depth range");
+			}
+			break;
+		}
+		case RenderCommandType::CLEAR_RENDER_TARGET:
+		{
+			if (reinterpret_cast<RenderCommand_ClearRenderTarget const*>(command)->m_renderTargetView == nullptr)
+			{
+				ReportError("Clear of a null render target view");
+			}
+			break;
+		}
+		case RenderCommandType::CLEAR_DEPTH_STENCIL:
+		{
+			RenderCommand_ClearDepthStencil const* clearDepthStencil = reinterpret_cast<RenderCommand_ClearDepthStencil const*>(command);
+			if (clearDepthStencil->m_depthStencilView == nullptr)
+			{
+				ReportError("Clear of a null depth stencil view");
+			}
+			if (clearDepthStencil->m_depth < 0.f || clearDepthStencil->m_depth > 1.f)
+			{
+				ReportError("Depth cleared to a value outside 0 to 1");
+			}
+			break;
+		}
+		case RenderCommandType::CLEAR_UNORDERED_ACCESS_VIEW:
+		{
+			if (reinterpret_cast<RenderCommand_ClearUnorderedAccessView const*>(command)->m_unorderedAccessView == nullptr)
+			{
+				ReportError("Clear of a null UAV");
+			}
+			break;
+		}
+		case RenderCommandType::SET_SHADER:
+		{
+			RenderCommand_SetShader const* setShader = reinterpret_cast<RenderCommand_SetShader const*>(command);
+			m_shaders[(int)setShader->m_stage] = setShader->m_shader;
+			break;
+		}
+		case RenderCommandType::SET_SHADER_RESOURCES:
+		{
+			RenderCommand_SetShaderResources const* setShaderResources = reinterpret_cast<RenderCommand_SetShaderResources const*>(command);
+			if (setShaderResources->m_startSlot + setShaderResources->m_numOfViews > MAX_NUM_OF_SHADER_RESOURCE_SLOTS)
+			{
+				ReportError("Shader resource views past the last slot");
+			}
+			break;
+		}
+		case RenderCommandType::SET_UNORDERED_ACCESS_VIEWS:
+		{
+			RenderCommand_SetUnorderedAccessViews const* setUAVs = reinterpret_cast<RenderCommand_SetUnorderedAccessViews const*>(command);
+			if (setUAVs->m_startSlot + setUAVs->m_numOfViews > MAX_NUM_OF_UAV_SLOTS)
+			{
+				ReportError("Compute shader UAVs past the last slot");
+			}
+			break;
+		}
+		case RenderCommandType::SET_CONSTANT_BUFFER:
+		{
+			RenderCommand_SetConstantBuffer const* setConstantBuffer = reinterpret_cast<RenderCommand_SetConstantBuffer const*>(command);
+			if (setConstantBuffer->m_slot >= MAX_NUM_OF_CONSTANT_BUFFER_SLOTS)
+			{
+				ReportError("Constant buffer past the last slot");
+			}
+			if (setConstantBuffer->m_numOfConstants > 0 &&
+				(setConstantBuffer->m_firstConstant % CONSTANT_RANGE_GRANULARITY != 0 || setConstantBuffer->m_numOfConstants % CONSTANT_RANGE_GRANULARITY != 0 || setConstantBuffer->m_numOfConstants > MAX_NUM_OF_CONSTANTS_IN_RANGE))
+			{
+				ReportError("Constant buffer range not a multiple of 16 constants or over 4096 constants");
+			}
+			break;
+		}
+		case RenderCommandType::SET_VERTEX_BUFFERS:
+		{
+			RenderCommand_SetVertexBuffers const* setVertexBuffers = reinterpret_cast<RenderCommand_SetVertexBuffers const*>(command);
+			if (setVertexBuffers->m_startSlot + setVertexBuffers->m_numOfBuffers > MAX_NUM_OF_VERTEX_BUFFER_SLOTS)
+			{
+				ReportError("Vertex buffers past the last slot");
+			}
+			break;
+		}
+		case RenderCommandType::SET_INDEX_BUFFER:
+		{
+			m_indexBuffer = reinterpret_cast<RenderCommand_SetIndexBuffer const*>(command)->m_buffer;
+			break;
+		}
+		case RenderCommandType::SET_PRIMITIVE_TOPOLOGY:
+		{
+			m_topology = static_cast<uint8_t>(reinterpret_cast<RenderCommand_SetPrimitiveTopology const*>(command)->m_topology);
+			break;
+		}
+		case RenderCommandType::SET_SAMPLER_STATE:
+		{
+			if (reinterpret_cast<RenderCommand_SetSamplerState const*>(command)->m_slot >= MAX_NUM_OF_SAMPLER_SLOTS)
+			{
+				ReportError("Sampler past the last slot");
+			}
+			break;
+		}
+		case RenderCommandType::UPDATE_BUFFER:
+		{
+			RenderCommand_UpdateBuffer const* updateBuffer = reinterpret_cast<RenderCommand_UpdateBuffer const*>(command);
+			if (updateBuffer->m_buffer == nullptr)
+			{
+				ReportError("Update of a null buffer");
+			}
+			break;
+		}
+		case RenderCommandType::COPY_RESOURCE:
+		{
+			RenderCommand_CopyResource const* copyResource = reinterpret_cast<RenderCommand_CopyResource const*>(command);
+			if (copyResource->m_destination == nullptr || copyResource->m_source == nullptr || copyResource->m_destination == copyResource->m_source)
+			{
+				ReportError("Copy from or to a null resource, or onto itself");
+			}
+			break;
+		}
+		case RenderCommandType::DRAW:
+		{
+			ValidateDraw();
+			break;
+		}
+		case RenderCommandType::DRAW_INDEXED:
+		case RenderCommandType::DRAW_INDEXED_INSTANCED:
+		{
+			ValidateDraw();
+			if (m_indexBuffer == nullptr)
+			{
+				ReportError("Indexed draw without an index buffer");
+			}
+			break;
+		}
+		case RenderCommandType::DISPATCH:
+		{
+			RenderCommand_Dispatch const* dispatch = reinterpret_cast<RenderCommand_Dispatch const*>(command);
+			if (m_shaders[(int)ShaderStage::COMPUTE] == nullptr)
+			{
+				ReportError("Dispatch without a compute shader");
+			}
+			if (dispatch->m_numOfThreadGroupsX == 0 || dispatch->m_numOfThreadGroupsX > MAX_NUM_OF_THREAD_GROUPS_PER_AXIS ||
+				dispatch->m_numOfThreadGroupsY == 0 || dispatch->m_numOfThreadGroupsY > MAX_NUM_OF_THREAD_GROUPS_PER_AXIS ||
+				dispatch->m_numOfThreadGroupsZ == 0 || dispatch->m_numOfThreadGroupsZ > MAX_NUM_OF_THREAD_GROUPS_PER_AXIS)
+			{
+				ReportError("Dispatch with an empty axis or more than 65535 thread groups on an axis");
+			}
+			break;
+		}
+		case RenderCommandType::BEGIN_EVENT:
+		{
+			m_eventDepth += 1;
+			break;
+		}
+		case RenderCommandType::END_EVENT:
+		{
+			if (m_eventDepth == 0)
+			{
+				ReportError("End event without a begin event");
+				break;
+			}
+			m_eventDepth -= 1;
+			break;
+		}
+		case RenderCommandType::BEGIN_TIMESTAMP_FRAME:
+		{
+			RenderCommand_Timestamp const* timestamp = reinterpret_cast<RenderCommand_Timestamp const*>(command);
+			if (m_timestampFrameSlot >= 0)
+			{
+				ReportError("Timestamp frame begun inside another one");
+			}
+			if (timestamp->m_frameSlot >= NUM_OF_TIMESTAMP_FRAMES)
+			{
+				ReportError("Timestamp frame slot out of range");
+			}
+			m_timestampFrameSlot = (int)timestamp->m_frameSlot;
+			break;
+		}
+		case RenderCommandType::WRITE_TIMESTAMP:
+		{
+			RenderCommand_Timestamp const* timestamp = reinterpret_cast<RenderCommand_Timestamp const*>(command);
+			if (m_timestampFrameSlot != (int)timestamp->m_frameSlot)
+			{
+				ReportError("Timestamp written outside its timestamp frame");
+			}
+			if (timestamp->m_timestampIndex >= MAX_NUM_OF_TIMESTAMPS_PER_FRAME)
+			{
+				ReportError("Timestamp index out of range");
+			}
+			break;
+		}
+		case RenderCommandType::END_TIMESTAMP_FRAME:
+		{
+			if (m_timestampFrameSlot != (int)reinterpret_cast<RenderCommand_Timestamp const*>(command)->m_frameSlot)
+			{
+				ReportError("Timestamp frame ended without being begun");
+			}
+			if (m_numOfOpenPipelineStatistics != 0)
+			{
+				ReportError("Timestamp frame ended with pipeline statistics still open");
+			}
+			m_timestampFrameSlot			=	-1;
+			m_numOfOpenPipelineStatistics	=	0;
+			break;
+		}
+		case RenderCommandType::BEGIN_PIPELINE_STATISTICS:
+		case RenderCommandType::END_PIPELINE_STATISTICS:
+		{
+			RenderCommand_PipelineStatistics const* statistics = reinterpret_cast<RenderCommand_PipelineStatistics const*>(command);
+			if (m_timestampFrameSlot != (int)statistics->m_frameSlot)
+			{
+				ReportError("Pipeline statistics outside their timestamp frame");
+			}
+			if (statistics->m_queryIndex >= MAX_NUM_OF_PIPELINE_STATISTICS_PER_FRAME)
+			{
+				ReportError("Pipeline statistics index out of range");
+			}
+			if (command->m_type == RenderCommandType::BEGIN_PIPELINE_STATISTICS)
+			{
+				m_numOfOpenPipelineStatistics += 1;
+			}
+			else if (m_numOfOpenPipelineStatistics == 0)
+			{
+				ReportError("Pipeline statistics ended without being begun");
+			}
+			else
+			{
+				m_numOfOpenPipelineStatistics -= 1;
+			}
+			break;
+		}
+		case RenderCommandType::EXECUTE_COMMAND_BUFFER:
+		{
+			RenderCommand_ExecuteCommandBuffer const* executeCommandBuffer = reinterpret_cast<RenderCommand_ExecuteCommandBuffer const*>(command);
+			if (executeCommandBuffer->m_commandBuffer == nullptr)
+			{
+				ReportError("Execute of a null command buffer");
+				break;
+			}
+			Execute(*executeCommandBuffer->m_commandBuffer);
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void NullRenderBackend::ValidateDraw()
+{
+	if (m_shaders[(int)ShaderStage::VERTEX] == nullptr)
+	{
+		ReportError("Draw without a vertex shader");
+	}
+	if (m_topology == 0)
+	{
+		ReportError("Draw with an undefined primitive topology");
+	}
+	if (m_numOfRenderTargets == 0 && m_depthStencilView == nullptr && m_numOfPixelShaderUAVs == 0)
+	{
+		ReportError("Draw with no render target, depth stencil or UAV bound");
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void NullRenderBackend::ReportError(char const* error)
+{
+	if (m_stats.m_numOfValidationErrors == 0)
+	{
+		m_stats.m_firstValidationError = error;
+	}
+	m_stats.m_numOfValidationErrors += 1;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/RenderBackend.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+// Executes nothing, it only counts commands and checks them against the pipeline state they would have run with
+// The handles are never dereferenced, so it runs without a device and costs only the walk over the command buffer
+class NullRenderBackend : public RenderBackend
+{
+public:
+	char const*		GetName() const override	{ return "Null"; }
+
+	void			ReserveTransientBuffer(TransientBufferType type, uint32_t sizeBytes) override;
+	RenderHandle	GetTransientBuffer(TransientBufferType type) const override;
+	bool			SupportsConstantBufferRanges() const override	{ return true; }
+	void			SignalFence(uint64_t fenceValue) override;		// Nothing runs, so every fence completes right away
+	uint64_t		GetCompletedFenceValue() override;
+	bool			HasGPUTimestamps() const override	{ return false; }
+	bool			ReadGPUTimestamps(uint32_t frameSlot, uint32_t numOfTimestamps, double* out_gpuSeconds) override;
+	bool			HasPipelineStatistics() const override	{ return false; }
+	bool			ReadPipelineStatistics(uint32_t frameSlot, uint32_t numOfQueries, PipelineStatistics* out_statistics) override;
+
+protected:
+	void		Execute(RenderCommandBuffer const& commandBuffer) override;
+	void		WriteTransientBuffer(TransientBufferType type, unsigned char const* bytes, TransientRange const* ranges, int numOfRanges, bool discardsContents) override;
+
+private:
+	void		ValidateCommand(RenderCommandHeader const* command);
+	void		ValidateDraw();
+	void		ReportError(char const* error);
+
+private:
+	RenderHandle	m_shaders[(int)ShaderStage::COUNT]							=	{};
+	RenderHandle	m_indexBuffer												=	nullptr;
+	RenderHandle	m_depthStencilView											=	nullptr;
+	uint32_t		m_numOfRenderTargets										=	1;		// Starts out like a context after BeginFrame, with the back buffer bound
+	uint32_t		m_numOfPixelShaderUAVs										=	0;
+	uint32_t		m_transientBufferSizes[(int)TransientBufferType::COUNT]		=	{};		// Their addresses stand in for the buffers
+	uint64_t		m_completedFenceValue										=	0;
+	uint8_t			m_topology													=	0;
+	int				m_eventDepth												=	0;
+	int				m_timestampFrameSlot										=	-1;		// Between BEGIN_TIMESTAMP_FRAME and END_TIMESTAMP_FRAME
+	int				m_numOfOpenPipelineStatistics								=	0;
+};
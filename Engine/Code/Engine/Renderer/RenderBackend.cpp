@@ -0,0 +1,408 @@
+#include "Engine/Renderer/RenderBackend.hpp"
+#include "Engine/Renderer/NullRenderBackend.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+static constexpr int NUM_OF_BENCHMARK_WARMUP_FRAMES = 5;
+
+
+//--------------------------------------------------------------------------------------------------
+static constexpr int NUM_OF_BENCHMARK_VERTEXES_PER_DRAW = 36;
+
+
+//--------------------------------------------------------------------------------------------------
+// Records a run of draws the way a scene partition would, a shader change every few draws and model constants for every draw
+class RecordDrawsJob : public Job
+{
+public:
+	void Execute() override;
+
+public:
+	Renderer*				m_renderer		=	nullptr;
+	VertexBuffer const*		m_vertexBuffer	=	nullptr;
+	RenderCommandBuffer*	m_commandBuffer	=	nullptr;
+	int						m_firstDraw		=	0;
+	int						m_numOfDraws	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Goes through the same Record helpers a game's parallel pass would, so the commands and handles are the real ones
+void RecordDrawsJob::Execute()
+{
+	static constexpr int NUM_OF_DRAWS_PER_SHADER = 16;
+
+	for (int drawIndex = m_firstDraw; drawIndex < m_firstDraw + m_numOfDraws; ++drawIndex)
+	{
+		if (drawIndex % NUM_OF_DRAWS_PER_SHADER == 0 || drawIndex == m_firstDraw)
+		{
+			m_renderer->RecordBindShader(*m_commandBuffer, nullptr);
+			m_renderer->RecordBindTexture(*m_commandBuffer, nullptr);
+		}
+		m_renderer->RecordModelConstants(*m_commandBuffer, Mat44::CreateTranslation3D(Vec3((float)drawIndex, 0.f, 0.f)));
+		m_renderer->RecordDrawVertexBuffer(*m_commandBuffer, m_vertexBuffer, NUM_OF_BENCHMARK_VERTEXES_PER_DRAW);
+	}
+	m_renderer->FinishParallelCommandBuffer();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t RenderCommandStats::GetNumOfCommands() const
+{
+	uint64_t numOfCommands = 0;
+	for (int typeIndex = 0; typeIndex < (int)RenderCommandType::COUNT; ++typeIndex)
+	{
+		numOfCommands += m_numOfCommands[typeIndex];
+	}
+	return numOfCommands;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t RenderCommandStats::GetNumOfDraws() const
+{
+	return m_numOfCommands[(int)RenderCommandType::DRAW] + m_numOfCommands[(int)RenderCommandType::DRAW_INDEXED] + m_numOfCommands[(int)RenderCommandType::DRAW_INDEXED_INSTANCED];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t RenderCommandStats::GetNumOfStateChanges() const
+{
+	static constexpr RenderCommandType STATE_CHANGE_TYPES[] =
+	{
+		RenderCommandType::SET_RENDER_TARGETS,
+		RenderCommandType::SET_VIEWPORT,
+		RenderCommandType::SET_SHADER,
+		RenderCommandType::SET_INPUT_LAYOUT,
+		RenderCommandType::SET_SHADER_RESOURCES,
+		RenderCommandType::SET_UNORDERED_ACCESS_VIEWS,
+		RenderCommandType::SET_CONSTANT_BUFFER,
+		RenderCommandType::SET_VERTEX_BUFFERS,
+		RenderCommandType::SET_INDEX_BUFFER,
+		RenderCommandType::SET_PRIMITIVE_TOPOLOGY,
+		RenderCommandType::SET_BLEND_STATE,
+		RenderCommandType::SET_SAMPLER_STATE,
+		RenderCommandType::SET_RASTERIZER_STATE,
+		RenderCommandType::SET_DEPTH_STENCIL_STATE,
+	};
+
+	uint64_t numOfStateChanges = 0;
+	for (RenderCommandType type : STATE_CHANGE_TYPES)
+	{
+		numOfStateChanges += m_numOfCommands[(int)type];
+	}
+	return numOfStateChanges;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t RenderCommandStats::GetNumOfBufferMaps() const
+{
+	return m_numOfCommands[(int)RenderCommandType::UPDATE_BUFFER] + m_numOfTransientUploads;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandStats::Reset()
+{
+	*this = RenderCommandStats();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderBackend::Submit(RenderCommandBuffer const& commandBuffer)
+{
+	m_timeBeforeExecute				=	GetCurrentTimeSeconds();
+	Execute(commandBuffer);
+	double secondsExecuting			=	GetCurrentTimeSeconds() - m_timeBeforeExecute;
+	m_stats.m_secondsSubmitting		+=	secondsExecuting;
+	m_secondsExecuting				+=	secondsExecuting;
+	m_stats.m_numOfSubmits			+=	1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderBackend::UploadTransientData(TransientBufferType type, unsigned char const* bytes, TransientRange const* ranges, int numOfRanges, bool discardsContents)
+{
+	if (numOfRanges == 0)
+	{
+		return;
+	}
+
+	double timeBeforeWrite = GetCurrentTimeSeconds();
+	WriteTransientBuffer(type, bytes, ranges, numOfRanges, discardsContents);
+	m_stats.m_secondsSubmitting += GetCurrentTimeSeconds() - timeBeforeWrite;
+
+	m_stats.m_numOfTransientUploads += 1;
+	for (int rangeIndex = 0; rangeIndex < numOfRanges; ++rangeIndex)
+	{
+		m_stats.m_numOfBytesUploaded += ranges[rangeIndex].m_numOfBytes;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderCommandStats const& RenderBackend::GetStats() const
+{
+	return m_stats;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderBackend::ResetStats()
+{
+	m_stats.Reset();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+TimestampSubmitTime const& RenderBackend::GetTimestampSubmitTime(uint32_t frameSlot, uint32_t timestampIndex) const
+{
+	return m_timestampSubmitTimes[frameSlot][timestampIndex];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderBackend::CountCommand(RenderCommandHeader const* command)
+{
+	m_stats.m_numOfCommands[(int)command->m_type] += 1;
+
+	switch (command->m_type)
+	{
+		case RenderCommandType::WRITE_TIMESTAMP:
+		{
+			RenderCommand_Timestamp const* timestamp = reinterpret_cast<RenderCommand_Timestamp const*>(command);
+			if (timestamp->m_frameSlot < NUM_OF_TIMESTAMP_FRAMES && timestamp->m_timestampIndex < MAX_NUM_OF_TIMESTAMPS_PER_FRAME)
+			{
+				TimestampSubmitTime& submitTime	=	m_timestampSubmitTimes[timestamp->m_frameSlot][timestamp->m_timestampIndex];
+				submitTime.m_timeSeconds		=	GetCurrentTimeSeconds();
+				submitTime.m_secondsExecuting	=	m_secondsExecuting + (submitTime.m_timeSeconds - m_timeBeforeExecute);
+			}
+			break;
+		}
+		case RenderCommandType::DRAW:
+		{
+			RenderCommand_Draw const* draw = reinterpret_cast<RenderCommand_Draw const*>(command);
+			m_stats.m_numOfVertexesDrawn	+=	draw->m_numOfVertexes;
+			m_stats.m_numOfInstancesDrawn	+=	1;
+			break;
+		}
+		case RenderCommandType::DRAW_INDEXED:
+		{
+			RenderCommand_DrawIndexed const* draw = reinterpret_cast<RenderCommand_DrawIndexed const*>(command);
+			m_stats.m_numOfIndexesDrawn		+=	draw->m_numOfIndexes;
+			m_stats.m_numOfInstancesDrawn	+=	1;
+			break;
+		}
+		case RenderCommandType::DRAW_INDEXED_INSTANCED:
+		{
+			RenderCommand_DrawIndexedInstanced const* draw = reinterpret_cast<RenderCommand_DrawIndexedInstanced const*>(command);
+			m_stats.m_numOfIndexesDrawn		+=	(uint64_t)draw->m_numOfIndexesPerInstance * draw->m_numOfInstances;
+			m_stats.m_numOfInstancesDrawn	+=	draw->m_numOfInstances;
+			break;
+		}
+		case RenderCommandType::UPDATE_BUFFER:
+		{
+			m_stats.m_numOfBytesUploaded += reinterpret_cast<RenderCommand_UpdateBuffer const*>(command)->m_numOfBytes;
+			break;
+		}
+		default:
+			break;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Warms up, resets the backend's stats and returns the seconds the measured frames took
+static double RenderBenchmarkFrames(Renderer& renderer, RenderBackend& backend, std::function<void()> const& renderFunction, int numOfFrames)
+{
+	renderer.SetBackend(&backend);
+	for (int frameIndex = 0; frameIndex < NUM_OF_BENCHMARK_WARMUP_FRAMES; ++frameIndex)
+	{
+		renderFunction();
+		renderer.SignalFrameFence();
+	}
+	backend.ResetStats();
+
+	double timeBeforeFrames = GetCurrentTimeSeconds();
+	for (int frameIndex = 0; frameIndex < numOfFrames; ++frameIndex)
+	{
+		renderFunction();
+		renderer.SignalFrameFence();
+	}
+	return GetCurrentTimeSeconds() - timeBeforeFrames;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool RunRenderBenchmark(Renderer& renderer, std::function<void()> const& renderFunction, int numOfFrames, char const* sceneName)
+{
+	if (numOfFrames < 1)
+	{
+		numOfFrames = 1;
+	}
+
+	// Anything the caller recorded so far goes to the backend it was recorded for, not into the first measured frame
+	renderer.FlushCommands();
+
+	RenderBackend*		originalBackend		=	renderer.GetBackend();
+	NullRenderBackend	nullBackend;
+	RenderBackend*		backends[2]			=	{ originalBackend, &nullBackend };
+	int					firstBackendIndex	=	renderer.IsHeadless() ? 1 : 0;		// Headless there is no D3D11 backend to compare against
+
+	PrintBenchmarkResult(Stringf("Render benchmark: %s, %d frames per backend", sceneName, numOfFrames));
+	for (int backendIndex = firstBackendIndex; backendIndex < 2; ++backendIndex)
+	{
+		RenderBackend* backend = backends[backendIndex];
+		// The scene flushes on its own at every EndCamera, the backend's submit time is taken out of the frame time to get the recording time
+		double secondsRendering = RenderBenchmarkFrames(renderer, *backend, renderFunction, numOfFrames);
+
+		RenderCommandStats const&	stats			=	backend->GetStats();
+		double						frameScale		=	1.0 / (double)numOfFrames;
+		double						msSubmitting	=	stats.m_secondsSubmitting * 1000.0 * frameScale;
+		double						msRecording		=	secondsRendering * 1000.0 * frameScale - msSubmitting;
+		PrintBenchmarkResult(Stringf("%-6s record %7.3f ms, submit %7.3f ms, %6.0f commands, %5.0f draws, %4.0f dispatches, %6.0f state changes, %8.1f KB uploaded in %5.0f maps, %4.1f submits per frame",
+			backend->GetName(), msRecording, msSubmitting, (double)stats.GetNumOfCommands() * frameScale, (double)stats.GetNumOfDraws() * frameScale,
+			(double)stats.m_numOfCommands[(int)RenderCommandType::DISPATCH] * frameScale, (double)stats.GetNumOfStateChanges() * frameScale,
+			(double)stats.m_numOfBytesUploaded / 1024.0 * frameScale, (double)stats.GetNumOfBufferMaps() * frameScale, (double)stats.m_numOfSubmits * frameScale));
+	}
+
+	RenderCommandStats const& nullStats = nullBackend.GetStats();
+	if (nullStats.m_numOfValidationErrors == 0)
+	{
+		PrintBenchmarkResult("Null backend validation: PASSED");
+	}
+	else
+	{
+		PrintBenchmarkResult(Stringf("Null backend validation: %llu errors per frame, first: %s", (unsigned long long)(nullStats.m_numOfValidationErrors / (uint64_t)numOfFrames), nullStats.m_firstValidationError), true);
+	}
+
+	renderer.SetBackend(originalBackend);
+	return nullStats.m_numOfValidationErrors == 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderCommandStats CaptureRenderStats(Renderer& renderer, std::function<void()> const& renderFunction, int numOfFrames)
+{
+	if (numOfFrames < 1)
+	{
+		numOfFrames = 1;
+	}
+
+	renderer.FlushCommands();
+	RenderBackend*		originalBackend	=	renderer.GetBackend();
+	NullRenderBackend	nullBackend;
+	RenderBenchmarkFrames(renderer, nullBackend, renderFunction, numOfFrames);
+	renderer.SetBackend(originalBackend);
+	return nullBackend.GetStats();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RunParallelRecordingBenchmark(Renderer& renderer, int numOfDrawsPerFrame, int numOfFrames)
+{
+	if (numOfDrawsPerFrame < 1)
+	{
+		numOfDrawsPerFrame = 1;
+	}
+	if (numOfFrames < 1)
+	{
+		numOfFrames = 1;
+	}
+
+	renderer.FlushCommands();
+	RenderBackend*		originalBackend	=	renderer.GetBackend();
+	NullRenderBackend	nullBackend;
+	renderer.SetBackend(&nullBackend);
+	VertexBuffer*		vertexBuffer	=	renderer.CreateVertexBuffer(NUM_OF_BENCHMARK_VERTEXES_PER_DRAW * sizeof(Vertex_PCU), sizeof(Vertex_PCU));
+
+	int maxNumOfThreads = g_theJobSystem ? g_theJobSystem->GetNumOfWorkerThreads() + 1 : 1;
+	PrintBenchmarkResult(Stringf("Parallel recording benchmark: %d draws per frame, %d frames, up to %d threads", numOfDrawsPerFrame, numOfFrames, maxNumOfThreads));
+
+	std::vector<int> threadCounts;
+	for (int numOfThreads = 1; numOfThreads < maxNumOfThreads; numOfThreads *= 2)
+	{
+		threadCounts.push_back(numOfThreads);
+	}
+	threadCounts.push_back(maxNumOfThreads);
+
+	double singleThreadCommandsPerMs = 0.0;
+	for (int numOfThreads : threadCounts)
+	{
+		std::vector<RecordDrawsJob>	recordJobs(numOfThreads);
+		std::vector<Job*>			jobs(numOfThreads);
+		int							numOfDrawsPerJob	=	(numOfDrawsPerFrame + numOfThreads - 1) / numOfThreads;
+		for (int jobIndex = 0; jobIndex < numOfThreads; ++jobIndex)
+		{
+			int firstDraw					=	jobIndex * numOfDrawsPerJob < numOfDrawsPerFrame ? jobIndex * numOfDrawsPerJob : numOfDrawsPerFrame;
+			int lastDraw					=	firstDraw + numOfDrawsPerJob < numOfDrawsPerFrame ? firstDraw + numOfDrawsPerJob : numOfDrawsPerFrame;
+			recordJobs[jobIndex].m_renderer		=	&renderer;
+			recordJobs[jobIndex].m_vertexBuffer	=	vertexBuffer;
+			recordJobs[jobIndex].m_firstDraw	=	firstDraw;
+			recordJobs[jobIndex].m_numOfDraws	=	lastDraw - firstDraw;
+			jobs[jobIndex]						=	&recordJobs[jobIndex];
+		}
+
+		double		secondsRecording		=	0.0;
+		uint64_t	numOfCommandsRecorded	=	0;
+		size_t		capacityAfterWarmup		=	0;
+		nullBackend.ResetStats();
+		for (int frameIndex = 0; frameIndex < NUM_OF_BENCHMARK_WARMUP_FRAMES + numOfFrames; ++frameIndex)
+		{
+			// Buffers are acquired on this thread in job order, which fixes the order they are submitted in no matter which job finishes first
+			double timeBeforeRecording = GetCurrentTimeSeconds();
+			for (int jobIndex = 0; jobIndex < numOfThreads; ++jobIndex)
+			{
+				recordJobs[jobIndex].m_commandBuffer = renderer.AcquireParallelCommandBuffer();
+			}
+			JobSystem::ExecuteJobsAndWait(g_theJobSystem, jobs);
+			double secondsRecordingFrame = GetCurrentTimeSeconds() - timeBeforeRecording;
+
+			size_t capacity = 0;
+			if (frameIndex >= NUM_OF_BENCHMARK_WARMUP_FRAMES)
+			{
+				secondsRecording += secondsRecordingFrame;
+				for (int jobIndex = 0; jobIndex < numOfThreads; ++jobIndex)
+				{
+					numOfCommandsRecorded	+=	recordJobs[jobIndex].m_commandBuffer->GetNumOfCommands();
+					capacity				+=	recordJobs[jobIndex].m_commandBuffer->GetCapacityBytes();
+				}
+				if (frameIndex == NUM_OF_BENCHMARK_WARMUP_FRAMES)
+				{
+					capacityAfterWarmup = capacity;
+				}
+				else if (capacity != capacityAfterWarmup)
+				{
+					capacityAfterWarmup = (size_t)-1;
+				}
+			}
+			renderer.FlushCommands();
+		}
+
+		double commandsPerMs = (double)numOfCommandsRecorded / (secondsRecording * 1000.0);
+		if (numOfThreads == 1)
+		{
+			singleThreadCommandsPerMs = commandsPerMs;
+		}
+		PrintBenchmarkResult(Stringf("%2d threads: %9.0f commands/ms, %5.2fx, record %7.3f ms per frame, %s after warmup", numOfThreads, commandsPerMs,
+			commandsPerMs / singleThreadCommandsPerMs, secondsRecording * 1000.0 / (double)numOfFrames, capacityAfterWarmup != (size_t)-1 ? "no allocations" : "ALLOCATED"),
+			capacityAfterWarmup == (size_t)-1);
+
+		RenderCommandStats const& nullStats = nullBackend.GetStats();
+		if (nullStats.m_numOfValidationErrors > 0)
+		{
+			PrintBenchmarkResult(Stringf("Null backend validation: %llu errors, first: %s", (unsigned long long)nullStats.m_numOfValidationErrors, nullStats.m_firstValidationError), true);
+		}
+	}
+
+	delete vertexBuffer;
+	renderer.SetBackend(originalBackend);
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/TransientRingBuffer.hpp"
+#include "Engine/Renderer/RenderCommands.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <functional>
+
+
+//--------------------------------------------------------------------------------------------------
+class Renderer;
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr uint32_t NUM_OF_TIMESTAMP_FRAMES						=	4;		// Frames of timestamps that can wait for the GPU at once
+constexpr uint32_t MAX_NUM_OF_TIMESTAMPS_PER_FRAME				=	256;
+constexpr uint32_t MAX_NUM_OF_PIPELINE_STATISTICS_PER_FRAME		=	MAX_NUM_OF_TIMESTAMPS_PER_FRAME / 2;		// One per scope, like the timestamp pairs
+
+
+//--------------------------------------------------------------------------------------------------
+// When the backend reached a WRITE_TIMESTAMP, which is when the timestamp was handed to the GPU
+struct TimestampSubmitTime
+{
+	double	m_timeSeconds			=	0.0;
+	double	m_secondsExecuting		=	0.0;		// The backend's own clock, only runs while it executes so the time spent recording is left out
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// What the GPU counted between a BEGIN_PIPELINE_STATISTICS and its END
+struct PipelineStatistics
+{
+	uint64_t	m_numOfVertexesAssembled			=	0;		// Read by the input assembler
+	uint64_t	m_numOfVertexShaderInvocations		=	0;
+	uint64_t	m_numOfPixelShaderInvocations		=	0;
+	uint64_t	m_numOfComputeShaderInvocations		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Counted by every backend as it executes, so the same frame can be compared between backends
+struct RenderCommandStats
+{
+	uint64_t	m_numOfCommands[(int)RenderCommandType::COUNT]	=	{};
+	uint64_t	m_numOfSubmits									=	0;
+	uint64_t	m_numOfVertexesDrawn							=	0;
+	uint64_t	m_numOfIndexesDrawn								=	0;
+	uint64_t	m_numOfInstancesDrawn							=	0;
+	uint64_t	m_numOfBytesUploaded							=	0;
+	uint64_t	m_numOfTransientUploads							=	0;		// One map per transient buffer per submit that wrote to it
+	uint64_t	m_numOfValidationErrors							=	0;
+	double		m_secondsSubmitting								=	0.0;		// CPU time spent in Execute
+	char const*	m_firstValidationError							=	nullptr;
+
+	uint64_t	GetNumOfCommands() const;
+	uint64_t	GetNumOfDraws() const;
+	uint64_t	GetNumOfStateChanges() const;		// Every bind of a shader, view, buffer, state or target
+	uint64_t	GetNumOfBufferMaps() const;
+	void		Reset();
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Executes recorded command buffers, the Renderer records everything it does and hands the buffer over on FlushCommands
+class RenderBackend
+{
+public:
+	virtual ~RenderBackend() = default;
+
+	virtual char const*	GetName() const = 0;
+
+	void						Submit(RenderCommandBuffer const& commandBuffer);
+	RenderCommandStats const&	GetStats() const;
+	void						ResetStats();
+
+	// One buffer per transient type backs the Renderer's TransientRingBuffer, the Renderer sizes it and uploads to it before every submit
+	void					UploadTransientData(TransientBufferType type, unsigned char const* bytes, TransientRange const* ranges, int numOfRanges, bool discardsContents);
+	virtual void			ReserveTransientBuffer(TransientBufferType type, uint32_t sizeBytes) = 0;		// The contents are lost when the size changes
+	virtual RenderHandle	GetTransientBuffer(TransientBufferType type) const = 0;
+	virtual bool			SupportsConstantBufferRanges() const = 0;
+
+	// Signaled after a frame's last submit, the completed value only grows
+	virtual void			SignalFence(uint64_t fenceValue) = 0;
+	virtual uint64_t		GetCompletedFenceValue() = 0;
+
+	// Every backend notes when it reached each WRITE_TIMESTAMP, GPU seconds only come from backends with timestamp queries
+	// Reading is false until the frame slot's results are in, or when the GPU clock was disjoint
+	virtual bool				HasGPUTimestamps() const = 0;
+	virtual bool				ReadGPUTimestamps(uint32_t frameSlot, uint32_t numOfTimestamps, double* out_gpuSeconds) = 0;
+	TimestampSubmitTime const&	GetTimestampSubmitTime(uint32_t frameSlot, uint32_t timestampIndex) const;
+
+	// Read the same way once the frame slot's fence completed, false until every query in it is in
+	virtual bool				HasPipelineStatistics() const = 0;
+	virtual bool				ReadPipelineStatistics(uint32_t frameSlot, uint32_t numOfQueries, PipelineStatistics* out_statistics) = 0;
+
+protected:
+	virtual void	Execute(RenderCommandBuffer const& commandBuffer) = 0;
+	virtual void	WriteTransientBuffer(TransientBufferType type, unsigned char const* bytes, TransientRange const* ranges, int numOfRanges, bool discardsContents) = 0;
+	void			CountCommand(RenderCommandHeader const* command);
+
+protected:
+	RenderCommandStats	m_stats;
+	double				m_timeBeforeExecute		=	0.0;
+	double				m_secondsExecuting		=	0.0;		// Like m_stats.m_secondsSubmitting but never reset
+	TimestampSubmitTime	m_timestampSubmitTimes[NUM_OF_TIMESTAMP_FRAMES][MAX_NUM_OF_TIMESTAMPS_PER_FRAME];
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Renders numOfFrames frames with renderFunction on the D3D11 backend and then on the null backend, printing record and submit
+// times along with what the frames contained, so backend overhead can be told apart from the cost of recording
+// A headless Renderer only has the null backend, returns whether the null backend's validation passed
+bool RunRenderBenchmark(Renderer& renderer, std::function<void()> const& renderFunction, int numOfFrames, char const* sceneName);
+
+
+//--------------------------------------------------------------------------------------------------
+// Renders numOfFrames frames with renderFunction on a null backend and returns their summed stats, the Renderer's backend is restored
+RenderCommandStats CaptureRenderStats(Renderer& renderer, std::function<void()> const& renderFunction, int numOfFrames);
+
+
+//--------------------------------------------------------------------------------------------------
+// Records numOfDrawsPerFrame draws split across parallel command buffers on 1, 2, 4... threads up to every JobSystem worker,
+// submits them on the null backend at each frame's flush and prints commands recorded per millisecond for each thread count
+void RunParallelRecordingBenchmark(Renderer& renderer, int numOfDrawsPerFrame, int numOfFrames);
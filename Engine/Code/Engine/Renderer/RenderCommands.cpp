@@ -0,0 +1,482 @@
+#include "Engine/Renderer/RenderCommands.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <string.h>
+#include <wchar.h>
+
+
+//--------------------------------------------------------------------------------------------------
+static constexpr size_t COMMAND_ALIGNMENT = 16;
+
+
+//--------------------------------------------------------------------------------------------------
+RenderCommandBuffer::RenderCommandBuffer(size_t initialCapacityBytes) :
+	m_capacityBytes(initialCapacityBytes)
+{
+	if (m_capacityBytes > 0)
+	{
+		m_bytes = new unsigned char[m_capacityBytes];
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderCommandBuffer::~RenderCommandBuffer()
+{
+	delete[] m_bytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::Reset()
+{
+	m_numOfBytesUsed	=	0;
+	m_numOfCommands		=	0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool RenderCommandBuffer::IsEmpty() const
+{
+	return m_numOfCommands == 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t RenderCommandBuffer::GetNumOfCommands() const
+{
+	return m_numOfCommands;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t RenderCommandBuffer::GetNumOfBytesUsed() const
+{
+	return m_numOfBytesUsed;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+size_t RenderCommandBuffer::GetCapacityBytes() const
+{
+	return m_capacityBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderCommandHeader const* RenderCommandBuffer::GetFirstCommand() const
+{
+	if (m_numOfBytesUsed == 0)
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<RenderCommandHeader const*>(m_bytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderCommandHeader const* RenderCommandBuffer::GetNextCommand(RenderCommandHeader const* command) const
+{
+	unsigned char const* nextCommand = reinterpret_cast<unsigned char const*>(command) + command->m_numOfBytes;
+	if (nextCommand >= m_bytes + m_numOfBytesUsed)
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<RenderCommandHeader const*>(nextCommand);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetRenderTargets(uint32_t numOfRenderTargets, RenderHandle const* renderTargetViews, RenderHandle depthStencilView)
+{
+	size_t numOfTrailingBytes = sizeof(RenderHandle) * numOfRenderTargets;
+	RenderCommand_SetRenderTargets* command = AllocateCommand<RenderCommand_SetRenderTargets>(RenderCommandType::SET_RENDER_TARGETS, numOfTrailingBytes);
+	command->m_depthStencilView		=	depthStencilView;
+	command->m_numOfRenderTargets	=	numOfRenderTargets;
+
+	RenderHandle* views = const_cast<RenderHandle*>(command->GetRenderTargetViews());
+	for (uint32_t viewIndex = 0; viewIndex < numOfRenderTargets; ++viewIndex)
+	{
+		views[viewIndex] = renderTargetViews ? renderTargetViews[viewIndex] : nullptr;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetRenderTargetsAndUAVs(uint32_t numOfRenderTargets, RenderHandle const* renderTargetViews, RenderHandle depthStencilView, uint32_t uavStartSlot, uint32_t numOfUAVs, RenderHandle const* uavs, uint32_t const* uavInitialCounts)
+{
+	size_t numOfTrailingBytes = sizeof(RenderHandle) * (numOfRenderTargets + numOfUAVs) + sizeof(uint32_t) * numOfUAVs;
+	RenderCommand_SetRenderTargets* command = AllocateCommand<RenderCommand_SetRenderTargets>(RenderCommandType::SET_RENDER_TARGETS, numOfTrailingBytes);
+	command->m_depthStencilView		=	depthStencilView;
+	command->m_numOfRenderTargets	=	numOfRenderTargets;
+	command->m_uavStartSlot			=	uavStartSlot;
+	command->m_numOfUAVs			=	numOfUAVs;
+	command->m_setsUAVs				=	true;
+
+	RenderHandle* views = const_cast<RenderHandle*>(command->GetRenderTargetViews());
+	for (uint32_t viewIndex = 0; viewIndex < numOfRenderTargets; ++viewIndex)
+	{
+		views[viewIndex] = renderTargetViews ? renderTargetViews[viewIndex] : nullptr;
+	}
+
+	RenderHandle*	commandUAVs				=	const_cast<RenderHandle*>(command->GetUAVs());
+	uint32_t*		commandInitialCounts	=	const_cast<uint32_t*>(command->GetUAVInitialCounts());
+	for (uint32_t uavIndex = 0; uavIndex < numOfUAVs; ++uavIndex)
+	{
+		commandUAVs[uavIndex]			=	uavs ? uavs[uavIndex] : nullptr;
+		commandInitialCounts[uavIndex]	=	uavInitialCounts ? uavInitialCounts[uavIndex] : 0;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetViewport(float topLeftX, float topLeftY, float width, float height, float minDepth, float maxDepth)
+{
+	RenderCommand_SetViewport* command = AllocateCommand<RenderCommand_SetViewport>(RenderCommandType::SET_VIEWPORT);
+	command->m_topLeftX		=	topLeftX;
+	command->m_topLeftY		=	topLeftY;
+	command->m_width		=	width;
+	command->m_height		=	height;
+	command->m_minDepth		=	minDepth;
+	command->m_maxDepth		=	maxDepth;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::ClearRenderTarget(RenderHandle renderTargetView, float const* color)
+{
+	RenderCommand_ClearRenderTarget* command = AllocateCommand<RenderCommand_ClearRenderTarget>(RenderCommandType::CLEAR_RENDER_TARGET);
+	command->m_renderTargetView = renderTargetView;
+	memcpy(command->m_color, color, sizeof(command->m_color));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::ClearDepthStencil(RenderHandle depthStencilView, float depth, uint8_t stencil)
+{
+	RenderCommand_ClearDepthStencil* command = AllocateCommand<RenderCommand_ClearDepthStencil>(RenderCommandType::CLEAR_DEPTH_STENCIL);
+	command->m_depthStencilView		=	depthStencilView;
+	command->m_depth				=	depth;
+	command->m_stencil				=	stencil;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::ClearUnorderedAccessView(RenderHandle unorderedAccessView, float const* values)
+{
+	RenderCommand_ClearUnorderedAccessView* command = AllocateCommand<RenderCommand_ClearUnorderedAccessView>(RenderCommandType::CLEAR_UNORDERED_ACCESS_VIEW);
+	command->m_unorderedAccessView = unorderedAccessView;
+	memcpy(command->m_values, values, sizeof(command->m_values));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetShader(ShaderStage stage, RenderHandle shader)
+{
+	RenderCommand_SetShader* command = AllocateCommand<RenderCommand_SetShader>(RenderCommandType::SET_SHADER);
+	command->m_shader	=	shader;
+	command->m_stage	=	stage;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetInputLayout(RenderHandle inputLayout)
+{
+	RenderCommand_SetInputLayout* command = AllocateCommand<RenderCommand_SetInputLayout>(RenderCommandType::SET_INPUT_LAYOUT);
+	command->m_inputLayout = inputLayout;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetShaderResources(ShaderStage stage, uint32_t startSlot, uint32_t numOfViews, RenderHandle const* views)
+{
+	RenderCommand_SetShaderResources* command = AllocateCommand<RenderCommand_SetShaderResources>(RenderCommandType::SET_SHADER_RESOURCES, sizeof(RenderHandle) * numOfViews);
+	command->m_startSlot	=	startSlot;
+	command->m_numOfViews	=	numOfViews;
+	command->m_stage		=	stage;
+
+	RenderHandle* commandViews = const_cast<RenderHandle*>(command->GetViews());
+	for (uint32_t viewIndex = 0; viewIndex < numOfViews; ++viewIndex)
+	{
+		commandViews[viewIndex] = views ? views[viewIndex] : nullptr;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetUnorderedAccessViews(uint32_t startSlot, uint32_t numOfViews, RenderHandle const* views, uint32_t const* initialCounts)
+{
+	size_t numOfTrailingBytes = sizeof(RenderHandle) * numOfViews + (initialCounts ? sizeof(uint32_t) * numOfViews : 0);
+	RenderCommand_SetUnorderedAccessViews* command = AllocateCommand<RenderCommand_SetUnorderedAccessViews>(RenderCommandType::SET_UNORDERED_ACCESS_VIEWS, numOfTrailingBytes);
+	command->m_startSlot			=	startSlot;
+	command->m_numOfViews			=	numOfViews;
+	command->m_hasInitialCounts		=	initialCounts != nullptr;
+
+	RenderHandle* commandViews = const_cast<RenderHandle*>(command->GetViews());
+	for (uint32_t viewIndex = 0; viewIndex < numOfViews; ++viewIndex)
+	{
+		commandViews[viewIndex] = views ? views[viewIndex] : nullptr;
+	}
+	if (initialCounts)
+	{
+		memcpy(const_cast<uint32_t*>(command->GetInitialCounts()), initialCounts, sizeof(uint32_t) * numOfViews);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetConstantBuffer(ShaderStage stage, uint32_t slot, RenderHandle buffer, uint32_t firstConstant, uint32_t numOfConstants)
+{
+	RenderCommand_SetConstantBuffer* command = AllocateCommand<RenderCommand_SetConstantBuffer>(RenderCommandType::SET_CONSTANT_BUFFER);
+	command->m_buffer			=	buffer;
+	command->m_slot				=	slot;
+	command->m_firstConstant	=	firstConstant;
+	command->m_numOfConstants	=	numOfConstants;
+	command->m_stage			=	stage;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetVertexBuffers(uint32_t startSlot, uint32_t numOfBuffers, RenderHandle const* buffers, uint32_t const* strides, uint32_t const* offsets)
+{
+	size_t numOfTrailingBytes = (sizeof(RenderHandle) + 2 * sizeof(uint32_t)) * numOfBuffers;
+	RenderCommand_SetVertexBuffers* command = AllocateCommand<RenderCommand_SetVertexBuffers>(RenderCommandType::SET_VERTEX_BUFFERS, numOfTrailingBytes);
+	command->m_startSlot		=	startSlot;
+	command->m_numOfBuffers		=	numOfBuffers;
+
+	memcpy(const_cast<RenderHandle*>(command->GetBuffers()), buffers, sizeof(RenderHandle) * numOfBuffers);
+	memcpy(const_cast<uint32_t*>(command->GetStrides()), strides, sizeof(uint32_t) * numOfBuffers);
+	memcpy(const_cast<uint32_t*>(command->GetOffsets()), offsets, sizeof(uint32_t) * numOfBuffers);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetIndexBuffer(RenderHandle buffer, uint32_t offset)
+{
+	RenderCommand_SetIndexBuffer* command = AllocateCommand<RenderCommand_SetIndexBuffer>(RenderCommandType::SET_INDEX_BUFFER);
+	command->m_buffer	=	buffer;
+	command->m_offset	=	offset;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetPrimitiveTopology(PrimitiveTopology topology)
+{
+	RenderCommand_SetPrimitiveTopology* command = AllocateCommand<RenderCommand_SetPrimitiveTopology>(RenderCommandType::SET_PRIMITIVE_TOPOLOGY);
+	command->m_topology = topology;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetBlendState(RenderHandle blendState)
+{
+	AllocateCommand<RenderCommand_SetState>(RenderCommandType::SET_BLEND_STATE)->m_state = blendState;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetSamplerState(ShaderStage stage, uint32_t slot, RenderHandle sampler)
+{
+	RenderCommand_SetSamplerState* command = AllocateCommand<RenderCommand_SetSamplerState>(RenderCommandType::SET_SAMPLER_STATE);
+	command->m_sampler	=	sampler;
+	command->m_slot		=	slot;
+	command->m_stage	=	stage;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetRasterizerState(RenderHandle rasterizerState)
+{
+	AllocateCommand<RenderCommand_SetState>(RenderCommandType::SET_RASTERIZER_STATE)->m_state = rasterizerState;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetDepthStencilState(RenderHandle depthStencilState)
+{
+	AllocateCommand<RenderCommand_SetState>(RenderCommandType::SET_DEPTH_STENCIL_STATE)->m_state = depthStencilState;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::UpdateBuffer(RenderHandle buffer, void const* data, size_t numOfBytes)
+{
+	GUARANTEE_OR_DIE(numOfBytes <= UINT32_MAX - 1024, "Buffer updates are limited to 4 GB");
+
+	RenderCommand_UpdateBuffer* command = AllocateCommand<RenderCommand_UpdateBuffer>(RenderCommandType::UPDATE_BUFFER, numOfBytes);
+	command->m_buffer		=	buffer;
+	command->m_numOfBytes	=	(uint32_t)numOfBytes;
+	if (numOfBytes > 0)
+	{
+		memcpy(const_cast<void*>(command->GetData()), data, numOfBytes);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::CopyResource(RenderHandle destination, RenderHandle source)
+{
+	RenderCommand_CopyResource* command = AllocateCommand<RenderCommand_CopyResource>(RenderCommandType::COPY_RESOURCE);
+	command->m_destination	=	destination;
+	command->m_source		=	source;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::Draw(uint32_t numOfVertexes, uint32_t startVertex)
+{
+	RenderCommand_Draw* command = AllocateCommand<RenderCommand_Draw>(RenderCommandType::DRAW);
+	command->m_numOfVertexes	=	numOfVertexes;
+	command->m_startVertex		=	startVertex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::DrawIndexed(uint32_t numOfIndexes, uint32_t startIndex, int32_t baseVertex)
+{
+	RenderCommand_DrawIndexed* command = AllocateCommand<RenderCommand_DrawIndexed>(RenderCommandType::DRAW_INDEXED);
+	command->m_numOfIndexes		=	numOfIndexes;
+	command->m_startIndex		=	startIndex;
+	command->m_baseVertex		=	baseVertex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::DrawIndexedInstanced(uint32_t numOfIndexesPerInstance, uint32_t numOfInstances, uint32_t startIndex, int32_t baseVertex, uint32_t startInstance)
+{
+	RenderCommand_DrawIndexedInstanced* command = AllocateCommand<RenderCommand_DrawIndexedInstanced>(RenderCommandType::DRAW_INDEXED_INSTANCED);
+	command->m_numOfIndexesPerInstance	=	numOfIndexesPerInstance;
+	command->m_numOfInstances			=	numOfInstances;
+	command->m_startIndex				=	startIndex;
+	command->m_baseVertex				=	baseVertex;
+	command->m_startInstance			=	startInstance;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::Dispatch(uint32_t numOfThreadGroupsX, uint32_t numOfThreadGroupsY, uint32_t numOfThreadGroupsZ)
+{
+	RenderCommand_Dispatch* command = AllocateCommand<RenderCommand_Dispatch>(RenderCommandType::DISPATCH);
+	command->m_numOfThreadGroupsX	=	numOfThreadGroupsX;
+	command->m_numOfThreadGroupsY	=	numOfThreadGroupsY;
+	command->m_numOfThreadGroupsZ	=	numOfThreadGroupsZ;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::BeginEvent(wchar_t const* text)
+{
+	size_t numOfTextBytes = sizeof(wchar_t) * (wcslen(text) + 1);
+	RenderCommand_Annotation* command = AllocateCommand<RenderCommand_Annotation>(RenderCommandType::BEGIN_EVENT, numOfTextBytes);
+	memcpy(const_cast<wchar_t*>(command->GetText()), text, numOfTextBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::EndEvent()
+{
+	AllocateCommand<RenderCommand_Annotation>(RenderCommandType::END_EVENT);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::SetMarker(wchar_t const* text)
+{
+	size_t numOfTextBytes = sizeof(wchar_t) * (wcslen(text) + 1);
+	RenderCommand_Annotation* command = AllocateCommand<RenderCommand_Annotation>(RenderCommandType::SET_MARKER, numOfTextBytes);
+	memcpy(const_cast<wchar_t*>(command->GetText()), text, numOfTextBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::BeginTimestampFrame(uint32_t frameSlot)
+{
+	RenderCommand_Timestamp* command = AllocateCommand<RenderCommand_Timestamp>(RenderCommandType::BEGIN_TIMESTAMP_FRAME);
+	command->m_frameSlot = frameSlot;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::WriteTimestamp(uint32_t frameSlot, uint32_t timestampIndex)
+{
+	RenderCommand_Timestamp* command	=	AllocateCommand<RenderCommand_Timestamp>(RenderCommandType::WRITE_TIMESTAMP);
+	command->m_frameSlot				=	frameSlot;
+	command->m_timestampIndex			=	timestampIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::EndTimestampFrame(uint32_t frameSlot)
+{
+	RenderCommand_Timestamp* command = AllocateCommand<RenderCommand_Timestamp>(RenderCommandType::END_TIMESTAMP_FRAME);
+	command->m_frameSlot = frameSlot;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::BeginPipelineStatistics(uint32_t frameSlot, uint32_t queryIndex)
+{
+	RenderCommand_PipelineStatistics* command	=	AllocateCommand<RenderCommand_PipelineStatistics>(RenderCommandType::BEGIN_PIPELINE_STATISTICS);
+	command->m_frameSlot						=	frameSlot;
+	command->m_queryIndex						=	queryIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::EndPipelineStatistics(uint32_t frameSlot, uint32_t queryIndex)
+{
+	RenderCommand_PipelineStatistics* command	=	AllocateCommand<RenderCommand_PipelineStatistics>(RenderCommandType::END_PIPELINE_STATISTICS);
+	command->m_frameSlot						=	frameSlot;
+	command->m_queryIndex						=	queryIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::ExecuteCommandBuffer(RenderCommandBuffer const* commandBuffer)
+{
+	GUARANTEE_OR_DIE(commandBuffer != this, "A command buffer cannot execute itself");
+	RenderCommand_ExecuteCommandBuffer* command = AllocateCommand<RenderCommand_ExecuteCommandBuffer>(RenderCommandType::EXECUTE_COMMAND_BUFFER);
+	command->m_commandBuffer = commandBuffer;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void* RenderCommandBuffer::AllocateBytes(RenderCommandType type, size_t numOfBytes)
+{
+	size_t numOfAlignedBytes = (numOfBytes + (COMMAND_ALIGNMENT - 1)) & ~(COMMAND_ALIGNMENT - 1);
+	if (m_numOfBytesUsed + numOfAlignedBytes > m_capacityBytes)
+	{
+		Grow(m_numOfBytesUsed + numOfAlignedBytes);
+	}
+
+	RenderCommandHeader* header	=	reinterpret_cast<RenderCommandHeader*>(m_bytes + m_numOfBytesUsed);
+	m_numOfBytesUsed			+=	numOfAlignedBytes;
+	m_numOfCommands				+=	1;
+
+	header->m_type				=	type;
+	header->m_numOfBytes		=	(uint32_t)numOfAlignedBytes;
+	return header;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderCommandBuffer::Grow(size_t numOfBytesNeeded)
+{
+	// Grow geometrically so a frame that records a little more than the last one does not copy the buffer every time
+	size_t newCapacity = m_capacityBytes * 2;
+	if (newCapacity < numOfBytesNeeded)
+	{
+		newCapacity = numOfBytesNeeded;
+	}
+
+	unsigned char* newBytes = new unsigned char[newCapacity];
+	if (m_numOfBytesUsed > 0)
+	{
+		memcpy(newBytes, m_bytes, m_numOfBytesUsed);
+	}
+	delete[] m_bytes;
+	m_bytes			=	newBytes;
+	m_capacityBytes	=	newCapacity;
+}
@@ -0,0 +1,426 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+
+
+//--------------------------------------------------------------------------------------------------
+enum class PrimitiveTopology : unsigned char;
+class RenderCommandBuffer;
+
+
+//--------------------------------------------------------------------------------------------------
+// Native object owned by a backend (a view, shader, buffer or state), opaque to everything but the backend that made it
+// Commands borrow handles without holding a reference, deleted buffers and shaders are released through Renderer::ReleaseAfterFlush
+// and the Renderer flushes before it releases anything else that may have been recorded
+typedef void* RenderHandle;
+
+
+//--------------------------------------------------------------------------------------------------
+enum class ShaderStage : unsigned char
+{
+	VERTEX,
+	PIXEL,
+	COMPUTE,
+	COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+enum class RenderCommandType : unsigned char
+{
+	SET_RENDER_TARGETS,
+	SET_VIEWPORT,
+	CLEAR_RENDER_TARGET,
+	CLEAR_DEPTH_STENCIL,
+	CLEAR_UNORDERED_ACCESS_VIEW,
+	SET_SHADER,
+	SET_INPUT_LAYOUT,
+	SET_SHADER_RESOURCES,
+	SET_UNORDERED_ACCESS_VIEWS,
+	SET_CONSTANT_BUFFER,
+	SET_VERTEX_BUFFERS,
+	SET_INDEX_BUFFER,
+	SET_PRIMITIVE_TOPOLOGY,
+	SET_BLEND_STATE,
+	SET_SAMPLER_STATE,
+	SET_RASTERIZER_STATE,
+	SET_DEPTH_STENCIL_STATE,
+	UPDATE_BUFFER,
+	COPY_RESOURCE,
+	DRAW,
+	DRAW_INDEXED,
+	DRAW_INDEXED_INSTANCED,
+	DISPATCH,
+	BEGIN_EVENT,
+	END_EVENT,
+	SET_MARKER,
+	BEGIN_TIMESTAMP_FRAME,
+	WRITE_TIMESTAMP,
+	END_TIMESTAMP_FRAME,
+	BEGIN_PIPELINE_STATISTICS,
+	END_PIPELINE_STATISTICS,
+	EXECUTE_COMMAND_BUFFER,
+	COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Every command starts with a header, m_numOfBytes covers the command and any arrays stored right after it and keeps the next command 16 byte aligned
+// The header's alignment makes every command's size a multiple of 8, so the arrays after a command are aligned for handles
+struct alignas(8) RenderCommandHeader
+{
+	RenderCommandType	m_type			=	RenderCommandType::COUNT;
+	uint32_t			m_numOfBytes	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Followed by m_numOfRenderTargets render target views, then m_numOfUAVs UAVs and m_numOfUAVs initial counts
+// Without m_setsUAVs it is a plain render target bind, with it the render targets and the pixel shader UAVs are set together
+struct RenderCommand_SetRenderTargets
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_depthStencilView		=	nullptr;
+	uint32_t			m_numOfRenderTargets	=	0;
+	uint32_t			m_uavStartSlot			=	0;
+	uint32_t			m_numOfUAVs				=	0;
+	bool				m_setsUAVs				=	false;
+
+	RenderHandle const*	GetRenderTargetViews() const	{ return reinterpret_cast<RenderHandle const*>(this + 1); }
+	RenderHandle const*	GetUAVs() const					{ return GetRenderTargetViews() + m_numOfRenderTargets; }
+	uint32_t const*		GetUAVInitialCounts() const		{ return reinterpret_cast<uint32_t const*>(GetUAVs() + m_numOfUAVs); }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_SetViewport
+{
+	RenderCommandHeader	m_header;
+	float				m_topLeftX		=	0.f;
+	float				m_topLeftY		=	0.f;
+	float				m_width			=	0.f;
+	float				m_height		=	0.f;
+	float				m_minDepth		=	0.f;
+	float				m_maxDepth		=	1.f;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_ClearRenderTarget
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_renderTargetView	=	nullptr;
+	float				m_color[4]			=	{ };
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_ClearDepthStencil
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_depthStencilView	=	nullptr;
+	float				m_depth				=	1.f;
+	uint8_t				m_stencil			=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_ClearUnorderedAccessView
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_unorderedAccessView	=	nullptr;
+	float				m_values[4]				=	{ };
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// A null shader unbinds the stage
+struct RenderCommand_SetShader
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_shader	=	nullptr;
+	ShaderStage			m_stage		=	ShaderStage::VERTEX;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_SetInputLayout
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_inputLayout	=	nullptr;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Followed by m_numOfViews shader resource views, null entries unbind their slot
+struct RenderCommand_SetShaderResources
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_startSlot		=	0;
+	uint32_t			m_numOfViews	=	0;
+	ShaderStage			m_stage			=	ShaderStage::PIXEL;
+
+	RenderHandle const*	GetViews() const	{ return reinterpret_cast<RenderHandle const*>(this + 1); }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Compute shader UAVs, followed by m_numOfViews UAVs and, when m_hasInitialCounts, m_numOfViews append/consume counts
+struct RenderCommand_SetUnorderedAccessViews
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_startSlot				=	0;
+	uint32_t			m_numOfViews			=	0;
+	bool				m_hasInitialCounts		=	false;
+
+	RenderHandle const*	GetViews() const			{ return reinterpret_cast<RenderHandle const*>(this + 1); }
+	uint32_t const*		GetInitialCounts() const	{ return m_hasInitialCounts ? reinterpret_cast<uint32_t const*>(GetViews() + m_numOfViews) : nullptr; }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// A range is counted in 16 byte constants, both ends multiples of 16 constants, no range binds the whole buffer
+struct RenderCommand_SetConstantBuffer
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_buffer			=	nullptr;
+	uint32_t			m_slot				=	0;
+	uint32_t			m_firstConstant		=	0;
+	uint32_t			m_numOfConstants	=	0;
+	ShaderStage			m_stage				=	ShaderStage::PIXEL;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Followed by m_numOfBuffers buffers, then m_numOfBuffers strides and m_numOfBuffers offsets
+struct RenderCommand_SetVertexBuffers
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_startSlot			=	0;
+	uint32_t			m_numOfBuffers		=	0;
+
+	RenderHandle const*	GetBuffers() const	{ return reinterpret_cast<RenderHandle const*>(this + 1); }
+	uint32_t const*		GetStrides() const	{ return reinterpret_cast<uint32_t const*>(GetBuffers() + m_numOfBuffers); }
+	uint32_t const*		GetOffsets() const	{ return GetStrides() + m_numOfBuffers; }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Indexes are always 32 bit
+struct RenderCommand_SetIndexBuffer
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_buffer	=	nullptr;
+	uint32_t			m_offset	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_SetPrimitiveTopology
+{
+	RenderCommandHeader	m_header;
+	PrimitiveTopology	m_topology;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Used for the blend, rasterizer and depth stencil states, which all bind a single state object
+struct RenderCommand_SetState
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_state		=	nullptr;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_SetSamplerState
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_sampler	=	nullptr;
+	uint32_t			m_slot		=	0;
+	ShaderStage			m_stage		=	ShaderStage::PIXEL;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Replaces the whole contents of a dynamic buffer, followed by the m_numOfBytes new bytes
+struct RenderCommand_UpdateBuffer
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_buffer		=	nullptr;
+	uint32_t			m_numOfBytes	=	0;
+
+	void const*			GetData() const		{ return this + 1; }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_CopyResource
+{
+	RenderCommandHeader	m_header;
+	RenderHandle		m_destination	=	nullptr;
+	RenderHandle		m_source		=	nullptr;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_Draw
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_numOfVertexes		=	0;
+	uint32_t			m_startVertex		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_DrawIndexed
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_numOfIndexes		=	0;
+	uint32_t			m_startIndex		=	0;
+	int32_t				m_baseVertex		=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_DrawIndexedInstanced
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_numOfIndexesPerInstance	=	0;
+	uint32_t			m_numOfInstances			=	0;
+	uint32_t			m_startIndex				=	0;
+	int32_t				m_baseVertex				=	0;
+	uint32_t			m_startInstance				=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderCommand_Dispatch
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_numOfThreadGroupsX	=	0;
+	uint32_t			m_numOfThreadGroupsY	=	0;
+	uint32_t			m_numOfThreadGroupsZ	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Begin event and marker are followed by their null terminated text, end event has nothing after the header
+struct RenderCommand_Annotation
+{
+	RenderCommandHeader	m_header;
+
+	wchar_t const*		GetText() const		{ return reinterpret_cast<wchar_t const*>(this + 1); }
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Timestamps are written into per frame slots, the frame slot's begin and end bracket every timestamp written to it
+struct RenderCommand_Timestamp
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_frameSlot			=	0;
+	uint32_t			m_timestampIndex	=	0;		// Within the frame slot, only for WRITE_TIMESTAMP
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Pipeline statistics queries share the timestamps' frame slots, a begin and an end with the same index bracket what they count
+struct RenderCommand_PipelineStatistics
+{
+	RenderCommandHeader	m_header;
+	uint32_t			m_frameSlot			=	0;
+	uint32_t			m_queryIndex		=	0;		// Within the frame slot
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Runs another buffer's commands in place, so a buffer recorded on another thread lands at the point the main thread reserved for it
+struct RenderCommand_ExecuteCommandBuffer
+{
+	RenderCommandHeader			m_header;
+	RenderCommandBuffer const*	m_commandBuffer		=	nullptr;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Linear recording of render commands, replayed in order by a RenderBackend
+// Arrays and buffer contents are copied in, so nothing the caller passes needs to outlive the call
+// Reset keeps the memory, so once a frame's worth of commands has been recorded recording stops allocating
+class RenderCommandBuffer
+{
+public:
+	explicit RenderCommandBuffer(size_t initialCapacityBytes = 64 * 1024);
+	~RenderCommandBuffer();
+	RenderCommandBuffer(RenderCommandBuffer const& copyFrom) = delete;
+	RenderCommandBuffer& operator=(RenderCommandBuffer const& copyFrom) = delete;
+
+	void		Reset();
+	bool		IsEmpty() const;
+	uint32_t	GetNumOfCommands() const;
+	size_t		GetNumOfBytesUsed() const;
+	size_t		GetCapacityBytes() const;
+
+	// Iteration, GetNextCommand returns nullptr after the last command
+	RenderCommandHeader const*	GetFirstCommand() const;
+	RenderCommandHeader const*	GetNextCommand(RenderCommandHeader const* command) const;
+
+	void	SetRenderTargets(uint32_t numOfRenderTargets, RenderHandle const* renderTargetViews, RenderHandle depthStencilView);
+	void	SetRenderTargetsAndUAVs(uint32_t numOfRenderTargets, RenderHandle const* renderTargetViews, RenderHandle depthStencilView, uint32_t uavStartSlot, uint32_t numOfUAVs, RenderHandle const* uavs, uint32_t const* uavInitialCounts);
+	void	SetViewport(float topLeftX, float topLeftY, float width, float height, float minDepth = 0.f, float maxDepth = 1.f);
+	void	ClearRenderTarget(RenderHandle renderTargetView, float const* color);
+	void	ClearDepthStencil(RenderHandle depthStencilView, float depth = 1.f, uint8_t stencil = 0);
+	void	ClearUnorderedAccessView(RenderHandle unorderedAccessView, float const* values);
+	void	SetShader(ShaderStage stage, RenderHandle shader);
+	void	SetInputLayout(RenderHandle inputLayout);
+	void	SetShaderResources(ShaderStage stage, uint32_t startSlot, uint32_t numOfViews, RenderHandle const* views);		// Null views unbinds numOfViews slots
+	void	SetUnorderedAccessViews(uint32_t startSlot, uint32_t numOfViews, RenderHandle const* views, uint32_t const* initialCounts);
+	void	SetConstantBuffer(ShaderStage stage, uint32_t slot, RenderHandle buffer, uint32_t firstConstant = 0, uint32_t numOfConstants = 0);		// Ranges need SupportsConstantBufferRanges
+	void	SetVertexBuffers(uint32_t startSlot, uint32_t numOfBuffers, RenderHandle const* buffers, uint32_t const* strides, uint32_t const* offsets);
+	void	SetIndexBuffer(RenderHandle buffer, uint32_t offset = 0);
+	void	SetPrimitiveTopology(PrimitiveTopology topology);
+	void	SetBlendState(RenderHandle blendState);
+	void	SetSamplerState(ShaderStage stage, uint32_t slot, RenderHandle sampler);
+	void	SetRasterizerState(RenderHandle rasterizerState);
+	void	SetDepthStencilState(RenderHandle depthStencilState);
+	void	UpdateBuffer(RenderHandle buffer, void const* data, size_t numOfBytes);
+	void	CopyResource(RenderHandle destination, RenderHandle source);
+	void	Draw(uint32_t numOfVertexes, uint32_t startVertex = 0);
+	void	DrawIndexed(uint32_t numOfIndexes, uint32_t startIndex = 0, int32_t baseVertex = 0);
+	void	DrawIndexedInstanced(uint32_t numOfIndexesPerInstance, uint32_t numOfInstances, uint32_t startIndex = 0, int32_t baseVertex = 0, uint32_t startInstance = 0);
+	void	Dispatch(uint32_t numOfThreadGroupsX, uint32_t numOfThreadGroupsY, uint32_t numOfThreadGroupsZ);
+	void	BeginEvent(wchar_t const* text);
+	void	EndEvent();
+	void	SetMarker(wchar_t const* text);
+	void	BeginTimestampFrame(uint32_t frameSlot);
+	void	WriteTimestamp(uint32_t frameSlot, uint32_t timestampIndex);
+	void	EndTimestampFrame(uint32_t frameSlot);
+	void	BeginPipelineStatistics(uint32_t frameSlot, uint32_t queryIndex);
+	void	EndPipelineStatistics(uint32_t frameSlot, uint32_t queryIndex);
+	void	ExecuteCommandBuffer(RenderCommandBuffer const* commandBuffer);		// Read when the buffer runs, not when this is recorded
+
+private:
+	void*	AllocateBytes(RenderCommandType type, size_t numOfBytes);
+	void	Grow(size_t numOfBytesNeeded);
+
+	template <typename T>
+	T*		AllocateCommand(RenderCommandType type, size_t numOfTrailingBytes = 0)
+	{
+		// Constructing the command resets its header, so the header AllocateBytes wrote is put back afterwards
+		void*				memory	=	AllocateBytes(type, sizeof(T) + numOfTrailingBytes);
+		RenderCommandHeader	header	=	*static_cast<RenderCommandHeader*>(memory);
+		T*					command	=	new (memory) T();
+		command->m_header			=	header;
+		return command;
+	}
+
+private:
+	unsigned char*	m_bytes				=	nullptr;
+	size_t			m_capacityBytes		=	0;
+	size_t			m_numOfBytesUsed	=	0;
+	uint32_t		m_numOfCommands		=	0;
+};
@@ -0,0 +1,432 @@
+#include "Engine/Renderer/RenderGraph.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------------------------
+static size_t AlignUp(size_t value, size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphPass& RenderGraphPass::Read(RenderGraphResourceID resource)
+{
+	m_reads.push_back(resource);
+	return *this;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphPass& RenderGraphPass::Write(RenderGraphResourceID resource)
+{
+	m_writes.push_back(resource);
+	return *this;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphPass& RenderGraphPass::ReadWrite(RenderGraphResourceID resource)
+{
+	m_reads.push_back(resource);
+	m_writes.push_back(resource);
+	return *this;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphPass& RenderGraphPass::SetHasSideEffects()
+{
+	m_hasSideEffects = true;
+	return *this;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::string const& RenderGraphPass::GetName() const
+{
+	return m_name;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool RenderGraphPass::IsCulled() const
+{
+	return m_isCulled;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraph::RenderGraph(Renderer* renderer) :
+	m_renderer(renderer)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraph::~RenderGraph()
+{
+	ReleasePhysicalResources();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderGraph::Reset()
+{
+	ReleasePhysicalResources();
+	m_passes.clear();
+	m_resources.clear();
+	m_isCompiled = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphResourceID RenderGraph::CreateTransientResource(char const* name, D3D11_ResourceConfig const& config)
+{
+	bool isBuffer = config.m_type == ResourceType::STRUCTURED_BUFFER || config.m_type == ResourceType::RAW_BUFFER;
+	GUARANTEE_OR_DIE(isBuffer || (config.m_width != (unsigned int)-1 && config.m_height != (unsigned int)-1), Stringf("Transient texture \"%s\" needs explicit dimensions", name));
+	GUARANTEE_OR_DIE(config.m_defaultInitializationData == nullptr, Stringf("Transient resource \"%s\" can not have initial data, its first pass has to write it", name));
+
+	ResourceNode resourceNode;
+	resourceNode.m_name			=	name;
+	resourceNode.m_config		=	config;
+	resourceNode.m_sizeInBytes	=	EstimateSizeInBytes(config);
+	m_resources.push_back(resourceNode);
+	m_isCompiled = false;
+	return (RenderGraphResourceID)(m_resources.size() - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphResourceID RenderGraph::ImportResource(char const* name, D3D11_Resource* resource)
+{
+	ResourceNode resourceNode;
+	resourceNode.m_name				=	name;
+	resourceNode.m_importedResource	=	resource;
+	resourceNode.m_isImported		=	true;
+	m_resources.push_back(resourceNode);
+	return (RenderGraphResourceID)(m_resources.size() - 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphPass& RenderGraph::AddPass(char const* name, RenderGraphPassFunction const& function)
+{
+	m_passes.emplace_back();
+	RenderGraphPass& pass	=	m_passes.back();
+	pass.m_name				=	name;
+	pass.m_annotationName	=	std::wstring(pass.m_name.begin(), pass.m_name.end());
+	pass.m_function			=	function;
+	m_isCompiled = false;
+	return pass;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderGraph::Compile()
+{
+	ReleasePhysicalResources();
+	for (size_t resourceIndex = 0; resourceIndex < m_resources.size(); ++resourceIndex)
+	{
+		ResourceNode& resourceNode		=	m_resources[resourceIndex];
+		resourceNode.m_firstPassIndex	=	-1;
+		resourceNode.m_lastPassIndex	=	-1;
+		resourceNode.m_heapOffset		=	0;
+		resourceNode.m_physicalIndex	=	-1;
+	}
+	m_stats									=	RenderGraphStats();
+	m_stats.m_numOfPasses					=	(int)m_passes.size();
+	CullPasses();
+	ComputeLifetimes();
+	PlaceTransientsInHeap();
+	AssignPhysicalResources();
+	m_isCompiled = true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderGraph::Execute()
+{
+	if (!m_isCompiled)
+	{
+		Compile();
+	}
+
+	for (size_t passIndex = 0; passIndex < m_passes.size(); ++passIndex)
+	{
+		RenderGraphPass const& pass = m_passes[passIndex];
+		if (pass.m_isCulled)
+		{
+			continue;
+		}
+		if (m_renderer)
+		{
+			m_renderer->BeginAnnotationEvent(pass.m_annotationName.c_str());
+			m_renderer->BeginTimingScope(pass.m_name.c_str());
+		}
+		pass.m_function(*this);
+		if (m_renderer)
+		{
+			m_renderer->EndTimingScope();
+			m_renderer->EndAnnotationEvent();
+		}
+	}
+
+	// Nothing recorded after this reads the transients, the pool can hand them to anyone else
+	ReleasePhysicalResources();
+	m_isCompiled = false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* RenderGraph::GetResource(RenderGraphResourceID resource) const
+{
+	GUARANTEE_OR_DIE(resource >= 0 && resource < (RenderGraphResourceID)m_resources.size(), "Invalid render graph resource");
+	ResourceNode const& resourceNode = m_resources[resource];
+	if (resourceNode.m_isImported)
+	{
+		return resourceNode.m_importedResource;
+	}
+	if (resourceNode.m_physicalIndex < 0 || resourceNode.m_physicalIndex >= (int)m_physicalResources.size())
+	{
+		return nullptr;
+	}
+	return m_physicalResources[resourceNode.m_physicalIndex].m_resource;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphPass const& RenderGraph::GetPass(int passIndex) const
+{
+	return m_passes[passIndex];
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int RenderGraph::GetNumOfPasses() const
+{
+	return (int)m_passes.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphStats const& RenderGraph::GetStats() const
+{
+	return m_stats;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The pool's linear size aligned to the placement alignment
+size_t RenderGraph::EstimateSizeInBytes(D3D11_ResourceConfig const& config)
+{
+	return AlignUp(ResourcePool::GetSizeInBytes(config), RENDER_GRAPH_PLACEMENT_ALIGNMENT);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Walks back from the last pass, a pass is kept when it has side effects or writes something imported or read by a kept pass
+void RenderGraph::CullPasses()
+{
+	std::vector<bool> isResourceNeeded(m_resources.size(), false);
+	for (size_t passIndex = m_passes.size(); passIndex-- > 0;)
+	{
+		RenderGraphPass& pass	=	m_passes[passIndex];
+		bool isPassNeeded		=	pass.m_hasSideEffects;
+		for (size_t writeIndex = 0; writeIndex < pass.m_writes.size() && !isPassNeeded; ++writeIndex)
+		{
+			RenderGraphResourceID resource = pass.m_writes[writeIndex];
+			isPassNeeded = m_resources[resource].m_isImported || isResourceNeeded[resource];
+		}
+
+		pass.m_isCulled = !isPassNeeded;
+		if (pass.m_isCulled)
+		{
+			m_stats.m_numOfCulledPasses += 1;
+			continue;
+		}
+		for (size_t readIndex = 0; readIndex < pass.m_reads.size(); ++readIndex)
+		{
+			isResourceNeeded[pass.m_reads[readIndex]] = true;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderGraph::ComputeLifetimes()
+{
+	for (size_t passIndex = 0; passIndex < m_passes.size(); ++passIndex)
+	{
+		RenderGraphPass const& pass = m_passes[passIndex];
+		if (pass.m_isCulled)
+		{
+			continue;
+		}
+
+		for (int accessIndex = 0; accessIndex < 2; ++accessIndex)
+		{
+			std::vector<RenderGraphResourceID> const& accesses = accessIndex == 0 ? pass.m_writes : pass.m_reads;
+			for (size_t resourceIndex = 0; resourceIndex < accesses.size(); ++resourceIndex)
+			{
+				ResourceNode& resourceNode = m_resources[accesses[resourceIndex]];
+				if (resourceNode.m_isImported)
+				{
+					continue;
+				}
+				if (resourceNode.m_firstPassIndex < 0)
+				{
+					if (accessIndex == 1)
+					{
+						DebuggerPrintf("RenderGraph: pass \"%s\" reads \"%s\" before any pass writes it\n", pass.m_name.c_str(), resourceNode.m_name.c_str());
+					}
+					resourceNode.m_firstPassIndex = (int)passIndex;
+				}
+				resourceNode.m_lastPassIndex = (int)passIndex;
+			}
+		}
+	}
+
+	for (size_t resourceIndex = 0; resourceIndex < m_resources.size(); ++resourceIndex)
+	{
+		ResourceNode const& resourceNode = m_resources[resourceIndex];
+		if (resourceNode.m_isImported)
+		{
+			continue;
+		}
+		m_stats.m_numOfTransientResources += 1;
+		if (resourceNode.m_firstPassIndex < 0)
+		{
+			m_stats.m_numOfUnusedTransientResources += 1;
+			continue;
+		}
+		m_stats.m_transientBytesWithoutAliasing += resourceNode.m_sizeInBytes;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Largest first, each one at the lowest offset that does not overlap a placed transient whose lifetime overlaps its own
+void RenderGraph::PlaceTransientsInHeap()
+{
+	std::vector<int> transientsToPlace;
+	for (size_t resourceIndex = 0; resourceIndex < m_resources.size(); ++resourceIndex)
+	{
+		if (!m_resources[resourceIndex].m_isImported && m_resources[resourceIndex].m_firstPassIndex >= 0)
+		{
+			transientsToPlace.push_back((int)resourceIndex);
+		}
+	}
+	std::stable_sort(transientsToPlace.begin(), transientsToPlace.end(), [this](int indexA, int indexB)
+	{
+		return m_resources[indexA].m_sizeInBytes > m_resources[indexB].m_sizeInBytes;
+	});
+
+	std::vector<int> overlappingTransients;
+	for (size_t placeIndex = 0; placeIndex < transientsToPlace.size(); ++placeIndex)
+	{
+		ResourceNode& transient = m_resources[transientsToPlace[placeIndex]];
+		overlappingTransients.clear();
+		for (size_t placedIndex = 0; placedIndex < placeIndex; ++placedIndex)
+		{
+			ResourceNode const& placedTransient = m_resources[transientsToPlace[placedIndex]];
+			bool areLifetimesDisjoint = placedTransient.m_lastPassIndex < transient.m_firstPassIndex || transient.m_lastPassIndex < placedTransient.m_firstPassIndex;
+			if (!areLifetimesDisjoint)
+			{
+				overlappingTransients.push_back(transientsToPlace[placedIndex]);
+			}
+		}
+		std::sort(overlappingTransients.begin(), overlappingTransients.end(), [this](int indexA, int indexB)
+		{
+			return m_resources[indexA].m_heapOffset < m_resources[indexB].m_heapOffset;
+		});
+
+		size_t heapOffset = 0;
+		for (size_t overlapIndex = 0; overlapIndex < overlappingTransients.size(); ++overlapIndex)
+		{
+			ResourceNode const& overlappingTransient = m_resources[overlappingTransients[overlapIndex]];
+			if (heapOffset + transient.m_sizeInBytes <= overlappingTransient.m_heapOffset)
+			{
+				break;
+			}
+			heapOffset = std::max(heapOffset, overlappingTransient.m_heapOffset + overlappingTransient.m_sizeInBytes);
+		}
+		transient.m_heapOffset = heapOffset;
+		m_stats.m_transientBytesWithAliasing = std::max(m_stats.m_transientBytesWithAliasing, heapOffset + transient.m_sizeInBytes);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// In order of first use, a physical resource is free again once the pass index passes the last use of what it backed
+// The physical resources come from the renderer's resource pool, so next frame's transients get the same ones back
+void RenderGraph::AssignPhysicalResources()
+{
+	if (!m_renderer)
+	{
+		return;
+	}
+
+	std::vector<int> transientsToBack;
+	for (size_t resourceIndex = 0; resourceIndex < m_resources.size(); ++resourceIndex)
+	{
+		if (!m_resources[resourceIndex].m_isImported && m_resources[resourceIndex].m_firstPassIndex >= 0)
+		{
+			transientsToBack.push_back((int)resourceIndex);
+		}
+	}
+	std::stable_sort(transientsToBack.begin(), transientsToBack.end(), [this](int indexA, int indexB)
+	{
+		return m_resources[indexA].m_firstPassIndex < m_resources[indexB].m_firstPassIndex;
+	});
+
+	int numOfPoolMissesBefore = m_renderer->GetResourcePoolStats().m_numOfMisses;
+	for (size_t backIndex = 0; backIndex < transientsToBack.size(); ++backIndex)
+	{
+		ResourceNode& transient = m_resources[transientsToBack[backIndex]];
+		for (size_t physicalIndex = 0; physicalIndex < m_physicalResources.size(); ++physicalIndex)
+		{
+			PhysicalResource const& physicalResource = m_physicalResources[physicalIndex];
+			if (physicalResource.m_lastPassIndex < transient.m_firstPassIndex && ResourcePool::AreConfigsCompatible(physicalResource.m_config, transient.m_config))
+			{
+				transient.m_physicalIndex = (int)physicalIndex;
+				break;
+			}
+		}
+
+		if (transient.m_physicalIndex < 0)
+		{
+			D3D11_ResourceConfig acquireConfig	=	transient.m_config;
+			acquireConfig.m_debugName			=	transient.m_name.c_str();
+			acquireConfig.m_debugNameSize		=	(unsigned int)transient.m_name.size() + 1;
+
+			PhysicalResource physicalResource;
+			physicalResource.m_config		=	transient.m_config;
+			physicalResource.m_resource		=	m_renderer->AcquirePooledResource(acquireConfig);
+			physicalResource.m_sizeInBytes	=	transient.m_sizeInBytes;
+			m_physicalResources.push_back(physicalResource);
+
+			transient.m_physicalIndex		=	(int)m_physicalResources.size() - 1;
+			m_stats.m_physicalBytes			+=	physicalResource.m_sizeInBytes;
+		}
+		m_physicalResources[transient.m_physicalIndex].m_lastPassIndex = transient.m_lastPassIndex;
+	}
+	m_stats.m_numOfPhysicalResources		=	(int)m_physicalResources.size();
+	m_stats.m_numOfPhysicalResourcesCreated	=	m_renderer->GetResourcePoolStats().m_numOfMisses - numOfPoolMissesBefore;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderGraph::ReleasePhysicalResources()
+{
+	for (size_t physicalIndex = 0; physicalIndex < m_physicalResources.size(); ++physicalIndex)
+	{
+		m_renderer->ReleasePooledResource(m_physicalResources[physicalIndex].m_resource);
+	}
+	m_physicalResources.clear();
+}
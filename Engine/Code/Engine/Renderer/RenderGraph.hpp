@@ -0,0 +1,138 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/ResourcePool.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+class RenderGraph;
+
+
+//--------------------------------------------------------------------------------------------------
+typedef int RenderGraphResourceID;
+constexpr RenderGraphResourceID INVALID_RENDER_GRAPH_RESOURCE = -1;
+
+
+//--------------------------------------------------------------------------------------------------
+// Records its draws and dispatches when the graph executes, GetResource hands back the D3D11 resources behind the IDs
+typedef std::function<void(RenderGraph const& graph)> RenderGraphPassFunction;
+
+
+//--------------------------------------------------------------------------------------------------
+// Every transient is placed in one heap at the smallest offset not taken by a transient alive at the same time
+// Placements and sizes are aligned like placed resources, the sizes come from EstimateSizeInBytes so they mean the same on any backend
+constexpr size_t RENDER_GRAPH_PLACEMENT_ALIGNMENT = 64 * 1024;
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderGraphStats
+{
+	int		m_numOfPasses						=	0;
+	int		m_numOfCulledPasses					=	0;
+	int		m_numOfTransientResources			=	0;
+	int		m_numOfUnusedTransientResources		=	0;		// Only touched by culled passes, never backed
+	int		m_numOfPhysicalResources			=	0;		// D3D11 resources backing this frame's transients
+	int		m_numOfPhysicalResourcesCreated		=	0;		// Resource pool misses this frame, everything else was reused from earlier frames
+	size_t	m_transientBytesWithoutAliasing		=	0;		// Every used transient in its own allocation
+	size_t	m_transientBytesWithAliasing		=	0;		// Peak of the heap where transients with disjoint lifetimes share memory
+	size_t	m_physicalBytes						=	0;		// Of the D3D11 resources backing this frame's transients
+};
+
+
+//--------------------------------------------------------------------------------------------------
+class RenderGraphPass
+{
+	friend class RenderGraph;
+public:
+	RenderGraphPass& Read(RenderGraphResourceID resource);
+	RenderGraphPass& Write(RenderGraphResourceID resource);
+	RenderGraphPass& ReadWrite(RenderGraphResourceID resource);
+	RenderGraphPass& SetHasSideEffects();		// Never culled, for passes whose results leave the graph some other way
+
+	std::string const&	GetName() const;
+	bool				IsCulled() const;
+
+private:
+	std::string							m_name;
+	std::wstring						m_annotationName;
+	RenderGraphPassFunction				m_function;
+	std::vector<RenderGraphResourceID>	m_reads;
+	std::vector<RenderGraphResourceID>	m_writes;
+	bool								m_hasSideEffects	=	false;
+	bool								m_isCulled			=	false;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Passes declare what they read and write, the graph culls the ones nothing needs, works out when each transient is
+// first and last used and backs the transients only for that span. Rebuilt every frame: Reset, AddPass..., Execute
+//
+// D3D11 has no placed resources, so transients are backed by D3D11 resources from the renderer's resource pool that are
+// handed to a later transient with the same config once the earlier one's last pass is done, and go back to the pool after
+// Execute. The stats report both that and the aliased heap peak
+class RenderGraph
+{
+public:
+	RenderGraph(Renderer* renderer);		// A null renderer compiles and reports the memory model without backing anything
+	~RenderGraph();
+
+	void					Reset();
+	RenderGraphResourceID	CreateTransientResource(char const* name, D3D11_ResourceConfig const& config);
+	RenderGraphResourceID	ImportResource(char const* name, D3D11_Resource* resource);
+	RenderGraphPass&		AddPass(char const* name, RenderGraphPassFunction const& function);
+
+	void					Compile();
+	void					Execute();		// Compiles first if needed
+
+	// Valid while the graph executes (null for transients after it), the contents of a transient are undefined until its first pass writes them
+	D3D11_Resource*			GetResource(RenderGraphResourceID resource) const;
+	RenderGraphPass const&	GetPass(int passIndex) const;
+	int						GetNumOfPasses() const;
+	RenderGraphStats const&	GetStats() const;
+
+	static size_t			EstimateSizeInBytes(D3D11_ResourceConfig const& config);
+
+private:
+	struct ResourceNode
+	{
+		std::string				m_name;
+		D3D11_ResourceConfig	m_config;
+		D3D11_Resource*			m_importedResource		=	nullptr;
+		bool					m_isImported			=	false;
+		int						m_firstPassIndex		=	-1;
+		int						m_lastPassIndex			=	-1;
+		size_t					m_sizeInBytes			=	0;
+		size_t					m_heapOffset			=	0;
+		int						m_physicalIndex			=	-1;
+	};
+
+	struct PhysicalResource
+	{
+		D3D11_ResourceConfig	m_config;
+		D3D11_Resource*			m_resource				=	nullptr;
+		size_t					m_sizeInBytes			=	0;
+		int						m_lastPassIndex			=	-1;		// Of the last transient it backs so far
+	};
+
+	void		CullPasses();
+	void		ComputeLifetimes();
+	void		PlaceTransientsInHeap();
+	void		AssignPhysicalResources();
+	void		ReleasePhysicalResources();
+
+private:
+	Renderer*						m_renderer			=	nullptr;
+	std::deque<RenderGraphPass>		m_passes;			// Handed out by reference while the frame is built
+	std::vector<ResourceNode>		m_resources;
+	std::vector<PhysicalResource>	m_physicalResources;		// Acquired from the renderer's pool at Compile, released after Execute
+	RenderGraphStats				m_stats;
+	bool							m_isCompiled		=	false;
+};
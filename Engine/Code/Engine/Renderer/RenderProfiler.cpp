@@ -0,0 +1,443 @@
+#include "Engine/Renderer/RenderProfiler.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+
+//--------------------------------------------------------------------------------------------------
+static RenderTimingRange GetTimingRange(double minSeconds, double totalSeconds, double maxSeconds, int numOfSamples)
+{
+	RenderTimingRange range;
+	if (numOfSamples > 0)
+	{
+		range.m_minMS	=	minSeconds * 1000.0;
+		range.m_avgMS	=	(totalSeconds / (double)numOfSamples) * 1000.0;
+		range.m_maxMS	=	maxSeconds * 1000.0;
+	}
+	return range;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static std::string GetEscapedJSONString(std::string const& text)
+{
+	std::string escapedText;
+	escapedText.reserve(text.size());
+	for (char character : text)
+	{
+		if (character == '"' || character == '\\')
+		{
+			escapedText.push_back('\\');
+		}
+		escapedText.push_back((unsigned char)character < 0x20 ? ' ' : character);
+	}
+	return escapedText;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void AppendChromeTraceEvent(std::string& trace, std::string const& name, int threadID, double beginSeconds, double endSeconds, uint64_t frameNumber)
+{
+	if (trace.back() != '[')
+	{
+		trace += ",\n";
+	}
+	trace += Stringf("{\"name\":\"%s\",\"cat\":\"render\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%llu}}",
+		name.c_str(), threadID, beginSeconds * 1000000.0, std::max(endSeconds - beginSeconds, 0.0) * 1000000.0, (unsigned long long)frameNumber);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Both timestamps are taken here so the scope always has its end, scopes past the frame's timestamps still get CPU times
+void RenderProfiler::BeginScope(char const* name, RenderCommandBuffer& commandBuffer)
+{
+	if (m_recordingFrameSlot < 0)
+	{
+		BeginFrame(commandBuffer);
+	}
+
+	TimestampFrame& frame	=	m_frames[m_recordingFrameSlot];
+	TimedScope scope;
+	scope.m_depth			=	(int)m_openScopeIndexes.size();
+	scope.m_nameIndex		=	GetOrAddNameIndex(name, scope.m_depth);
+	if (frame.m_numOfTimestamps + 2 <= MAX_NUM_OF_TIMESTAMPS_PER_FRAME)
+	{
+		scope.m_beginTimestampIndex		=	(int)frame.m_numOfTimestamps;
+		scope.m_endTimestampIndex		=	(int)frame.m_numOfTimestamps + 1;
+		frame.m_numOfTimestamps			+=	2;
+		commandBuffer.WriteTimestamp((uint32_t)m_recordingFrameSlot, (uint32_t)scope.m_beginTimestampIndex);
+	}
+	if (frame.m_numOfStatistics < MAX_NUM_OF_PIPELINE_STATISTICS_PER_FRAME)
+	{
+		scope.m_statisticsIndex			=	(int)frame.m_numOfStatistics;
+		frame.m_numOfStatistics			+=	1;
+		commandBuffer.BeginPipelineStatistics((uint32_t)m_recordingFrameSlot, (uint32_t)scope.m_statisticsIndex);
+	}
+	scope.m_cpuBeginSeconds	=	GetCurrentTimeSeconds();
+
+	m_openScopeIndexes.push_back((int)frame.m_scopes.size());
+	frame.m_scopes.push_back(scope);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void RenderProfiler::EndScope(RenderCommandBuffer& commandBuffer)
+{
+	GUARANTEE_OR_DIE(!m_openScopeIndexes.empty(), "Render timing scope ended without being begun");
+
+	TimedScope& scope		=	m_frames[m_recordingFrameSlot].m_scopes[m_openScopeIndexes.back()];
+	scope.m_cpuEndSeconds	=	GetCurrentTimeSeconds();
+	if (scope.m_statisticsIndex >= 0)
+	{
+		commandBuffer.EndPipelineStatistics((uint32_t)m_recordingFrameSlot, (uint32_t)scope.m_statisticsIndex);
+	}
+	if (scope.m_endTimestampIndex >= 0)
+	{
+		commandBuffer.WriteTimestamp((uint32_t)m_recordingFrameSlot, (uint32_t)scope.m_endTimestampIndex);
+	}
+	m_openScopeIndexes.pop_back();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Scopes still open end with the frame, the Renderer's frame scope is always one of them
+void RenderProfiler::EndFrame(RenderCommandBuffer& commandBuffer, uint64_t frameNumber)
+{
+	if (m_recordingFrameSlot < 0)
+	{
+		return;
+	}
+
+	while (!m_openScopeIndexes.empty())
+	{
+		EndScope(commandBuffer);
+	}
+	commandBuffer.EndTimestampFrame((uint32_t)m_recordingFrameSlot);
+
+	TimestampFrame& frame	=	m_frames[m_recordingFrameSlot];
+	frame.m_state			=	FrameState::WAITING_FOR_GPU;
+	frame.m_frameNumber		=	frameNumber;
+	m_recordingFrameSlot	=	-1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Oldest frame first, a frame whose fence completed but whose GPU clock was disjoint only gets its CPU times
+void RenderProfiler::ResolveFrames(RenderBackend& backend, uint64_t completedFrameNumber)
+{
+	for (;;)
+	{
+		int oldestFrameSlot = -1;
+		for (uint32_t frameSlot = 0; frameSlot < NUM_OF_TIMESTAMP_FRAMES; ++frameSlot)
+		{
+			TimestampFrame const& frame = m_frames[frameSlot];
+			if (frame.m_state != FrameState::WAITING_FOR_GPU || frame.m_frameNumber > completedFrameNumber)
+			{
+				continue;
+			}
+			if (oldestFrameSlot < 0 || frame.m_frameNumber < m_frames[oldestFrameSlot].m_frameNumber)
+			{
+				oldestFrameSlot = (int)frameSlot;
+			}
+		}
+		if (oldestFrameSlot < 0)
+		{
+			return;
+		}
+
+		TimestampFrame const& frame = m_frames[oldestFrameSlot];
+		bool hasGPUTimes	=	backend.HasGPUTimestamps() && frame.m_numOfTimestamps > 0 && backend.ReadGPUTimestamps((uint32_t)oldestFrameSlot, frame.m_numOfTimestamps, m_gpuSeconds);
+		bool hasStatistics	=	backend.HasPipelineStatistics() && frame.m_numOfStatistics > 0 && backend.ReadPipelineStatistics((uint32_t)oldestFrameSlot, frame.m_numOfStatistics, m_pipelineStatistics);
+		ResolveFrame(backend, (uint32_t)oldestFrameSlot, hasGPUTimes, m_gpuSeconds, hasStatistics ? m_pipelineStatistics : nullptr);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The old backend still gets the end of the frame it began, so its queries stay balanced
+void RenderProfiler::Reset(RenderCommandBuffer& commandBuffer)
+{
+	EndFrame(commandBuffer, 0);
+	for (uint32_t frameSlot = 0; frameSlot < NUM_OF_TIMESTAMP_FRAMES; ++frameSlot)
+	{
+		TimestampFrame& frame = m_frames[frameSlot];
+		if (frame.m_state == FrameState::WAITING_FOR_GPU)
+		{
+			m_numOfDroppedFrames	+=	1;
+			frame.m_state			=	FrameState::UNUSED;
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+std::vector<RenderTimingStats> RenderProfiler::GetTimingStats() const
+{
+	std::vector<RenderTimingStats> timingStats;
+	timingStats.reserve(m_scopeHistories.size());
+	for (ScopeHistory const& scopeHistory : m_scopeHistories)
+	{
+		RenderTimingStats stats;
+		stats.m_name			=	scopeHistory.m_name;
+		stats.m_depth			=	scopeHistory.m_depth;
+		stats.m_numOfSamples	=	(int)scopeHistory.m_samples.size();
+
+		double minGPU		=	0.0;
+		double totalGPU		=	0.0;
+		double maxGPU		=	0.0;
+		double minRecord	=	0.0;
+		double totalRecord	=	0.0;
+		double maxRecord	=	0.0;
+		double minSubmit	=	0.0;
+		double totalSubmit	=	0.0;
+		double maxSubmit	=	0.0;
+		PipelineStatistics totalStatistics;
+		for (size_t sampleIndex = 0; sampleIndex < scopeHistory.m_samples.size(); ++sampleIndex)
+		{
+			TimingSample const& sample = scopeHistory.m_samples[sampleIndex];
+			minRecord		=	sampleIndex == 0 ? sample.m_cpuRecordSeconds : std::min(minRecord, sample.m_cpuRecordSeconds);
+			maxRecord		=	std::max(maxRecord, sample.m_cpuRecordSeconds);
+			totalRecord		+=	sample.m_cpuRecordSeconds;
+			minSubmit		=	sampleIndex == 0 ? sample.m_cpuSubmitSeconds : std::min(minSubmit, sample.m_cpuSubmitSeconds);
+			maxSubmit		=	std::max(maxSubmit, sample.m_cpuSubmitSeconds);
+			totalSubmit		+=	sample.m_cpuSubmitSeconds;
+			if (sample.m_hasPipelineStatistics)
+			{
+				totalStatistics.m_numOfVertexesAssembled			+=	sample.m_pipelineStatistics.m_numOfVertexesAssembled;
+				totalStatistics.m_numOfVertexShaderInvocations		+=	sample.m_pipelineStatistics.m_numOfVertexShaderInvocations;
+				totalStatistics.m_numOfPixelShaderInvocations		+=	sample.m_pipelineStatistics.m_numOfPixelShaderInvocations;
+				totalStatistics.m_numOfComputeShaderInvocations		+=	sample.m_pipelineStatistics.m_numOfComputeShaderInvocations;
+				stats.m_numOfPipelineStatisticsSamples += 1;
+			}
+			if (sample.m_gpuSeconds < 0.0)
+			{
+				continue;
+			}
+			minGPU			=	stats.m_numOfGPUSamples == 0 ? sample.m_gpuSeconds : std::min(minGPU, sample.m_gpuSeconds);
+			maxGPU			=	std::max(maxGPU, sample.m_gpuSeconds);
+			totalGPU		+=	sample.m_gpuSeconds;
+			stats.m_numOfGPUSamples += 1;
+		}
+		stats.m_gpu			=	GetTimingRange(minGPU, totalGPU, maxGPU, stats.m_numOfGPUSamples);
+		stats.m_cpuRecord	=	GetTimingRange(minRecord, totalRecord, maxRecord, stats.m_numOfSamples);
+		stats.m_cpuSubmit	=	GetTimingRange(minSubmit, totalSubmit, maxSubmit, stats.m_numOfSamples);
+		if (stats.m_numOfPipelineStatisticsSamples > 0)
+		{
+			uint64_t numOfSamples = (uint64_t)stats.m_numOfPipelineStatisticsSamples;
+			stats.m_avgPipelineStatistics.m_numOfVertexesAssembled			=	totalStatistics.m_numOfVertexesAssembled / numOfSamples;
+			stats.m_avgPipelineStatistics.m_numOfVertexShaderInvocations	=	totalStatistics.m_numOfVertexShaderInvocations / numOfSamples;
+			stats.m_avgPipelineStatistics.m_numOfPixelShaderInvocations		=	totalStatistics.m_numOfPixelShaderInvocations / numOfSamples;
+			stats.m_avgPipelineStatistics.m_numOfComputeShaderInvocations	=	totalStatistics.m_numOfComputeShaderInvocations / numOfSamples;
+		}
+		timingStats.push_back(stats);
+	}
+	return timingStats;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int RenderProfiler::GetNumOfResolvedFrames() const
+{
+	return m_numOfResolvedFrames;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int RenderProfiler::GetNumOfDroppedFrames() const
+{
+	return m_numOfDroppedFrames;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Chrome's trace event format with a track each for recording, submitting and the GPU, times are from the oldest frame's start
+// The path comes from the dev console, so a folder that cannot be made or a file that cannot be written returns false instead of dying
+bool RenderProfiler::WriteChromeTrace(std::string const& filePath) const
+{
+	if (m_resolvedFrames.empty())
+	{
+		return false;
+	}
+
+	int		oldestFrameIndex	=	(int)m_resolvedFrames.size() < NUM_OF_RENDER_TIMING_SAMPLES ? 0 : m_nextResolvedFrameIndex;
+	double	startSeconds		=	-1.0;
+	for (ResolvedScope const& scope : m_resolvedFrames[oldestFrameIndex].m_scopes)
+	{
+		startSeconds = startSeconds < 0.0 ? scope.m_cpuBeginSeconds : std::min(startSeconds, scope.m_cpuBeginSeconds);
+	}
+	startSeconds = std::max(startSeconds, 0.0);
+
+	std::string trace = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	trace += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU record\"}},\n";
+	trace += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"CPU submit\"}},\n";
+	trace += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":3,\"args\":{\"name\":\"GPU\"}}";
+	for (size_t frameCount = 0; frameCount < m_resolvedFrames.size(); ++frameCount)
+	{
+		ResolvedFrame const& frame = m_resolvedFrames[(oldestFrameIndex + frameCount) % m_resolvedFrames.size()];
+		for (ResolvedScope const& scope : frame.m_scopes)
+		{
+			std::string name = GetEscapedJSONString(m_scopeHistories[scope.m_nameIndex].m_name);
+			AppendChromeTraceEvent(trace, name, 1, scope.m_cpuBeginSeconds - startSeconds, scope.m_cpuEndSeconds - startSeconds, frame.m_frameNumber);
+			if (!scope.m_hasTimestamps)
+			{
+				continue;
+			}
+			AppendChromeTraceEvent(trace, name, 2, scope.m_submitBeginSeconds - startSeconds, scope.m_submitEndSeconds - startSeconds, frame.m_frameNumber);
+			if (frame.m_hasGPUTimes)
+			{
+				AppendChromeTraceEvent(trace, name, 3, scope.m_gpuBeginSeconds - startSeconds, scope.m_gpuEndSeconds - startSeconds, frame.m_frameNumber);
+			}
+		}
+	}
+	trace += "]}\n";
+
+	std::error_code			errorCode;
+	std::filesystem::path	folderPath	=	std::filesystem::path(filePath).parent_path();
+	if (!folderPath.empty())
+	{
+		std::filesystem::create_directories(folderPath, errorCode);
+	}
+	std::ofstream traceFile(filePath, std::ios::binary | std::ios::trunc);
+	if (!traceFile.is_open())
+	{
+		return false;
+	}
+	traceFile.write(trace.data(), (std::streamsize)trace.size());
+	traceFile.close();
+	return !traceFile.fail();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// A slot still waiting for the GPU has been waiting NUM_OF_TIMESTAMP_FRAMES frames, it is dropped rather than waited on
+void RenderProfiler::BeginFrame(RenderCommandBuffer& commandBuffer)
+{
+	uint32_t		frameSlot	=	m_nextFrameSlot;
+	TimestampFrame&	frame		=	m_frames[frameSlot];
+	m_nextFrameSlot				=	(frameSlot + 1) % NUM_OF_TIMESTAMP_FRAMES;
+	if (frame.m_state == FrameState::WAITING_FOR_GPU)
+	{
+		m_numOfDroppedFrames += 1;
+	}
+
+	frame.m_state				=	FrameState::RECORDING;
+	frame.m_frameNumber			=	0;
+	frame.m_numOfTimestamps		=	0;
+	frame.m_numOfStatistics		=	0;
+	frame.m_scopes.clear();
+	m_recordingFrameSlot		=	(int)frameSlot;
+	commandBuffer.BeginTimestampFrame(frameSlot);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int RenderProfiler::GetOrAddNameIndex(char const* name, int depth)
+{
+	auto nameIter = m_nameIndexes.find(name);
+	if (nameIter != m_nameIndexes.end())
+	{
+		return nameIter->second;
+	}
+
+	ScopeHistory scopeHistory;
+	scopeHistory.m_name		=	name;
+	scopeHistory.m_depth	=	depth;
+	scopeHistory.m_samples.reserve(NUM_OF_RENDER_TIMING_SAMPLES);
+	m_scopeHistories.push_back(scopeHistory);
+
+	int nameIndex = (int)m_scopeHistories.size() - 1;
+	m_nameIndexes.emplace(scopeHistory.m_name, nameIndex);
+	return nameIndex;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The GPU clock has nothing to do with the CPU one, the trace lines it up so the frame's first timestamp runs when it was submitted
+void RenderProfiler::ResolveFrame(RenderBackend& backend, uint32_t frameSlot, bool hasGPUTimes, double const* gpuSeconds, PipelineStatistics const* pipelineStatistics)
+{
+	TimestampFrame& frame = m_frames[frameSlot];
+
+	ResolvedFrame resolvedFrame;
+	resolvedFrame.m_frameNumber		=	frame.m_frameNumber;
+	resolvedFrame.m_hasGPUTimes		=	hasGPUTimes;
+	resolvedFrame.m_scopes.reserve(frame.m_scopes.size());
+	double gpuToCPUSeconds = hasGPUTimes ? backend.GetTimestampSubmitTime(frameSlot, 0).m_timeSeconds - gpuSeconds[0] : 0.0;
+
+	std::vector<TimingSample>	frameSamples(m_scopeHistories.size());
+	std::vector<bool>			isInFrame(m_scopeHistories.size(), false);
+	for (TimedScope const& scope : frame.m_scopes)
+	{
+		ResolvedScope resolvedScope;
+		resolvedScope.m_nameIndex		=	scope.m_nameIndex;
+		resolvedScope.m_depth			=	scope.m_depth;
+		resolvedScope.m_cpuBeginSeconds	=	scope.m_cpuBeginSeconds;
+		resolvedScope.m_cpuEndSeconds	=	scope.m_cpuEndSeconds;
+		resolvedScope.m_hasTimestamps	=	scope.m_beginTimestampIndex >= 0;
+
+		TimingSample& sample			=	frameSamples[scope.m_nameIndex];
+		isInFrame[scope.m_nameIndex]	=	true;
+		sample.m_cpuRecordSeconds		+=	scope.m_cpuEndSeconds - scope.m_cpuBeginSeconds;
+		if (pipelineStatistics && scope.m_statisticsIndex >= 0)
+		{
+			PipelineStatistics const&	scopeStatistics		=	pipelineStatistics[scope.m_statisticsIndex];
+			PipelineStatistics&			sampleStatistics	=	sample.m_pipelineStatistics;
+			sample.m_hasPipelineStatistics						=	true;
+			sampleStatistics.m_numOfVertexesAssembled			+=	scopeStatistics.m_numOfVertexesAssembled;
+			sampleStatistics.m_numOfVertexShaderInvocations		+=	scopeStatistics.m_numOfVertexShaderInvocations;
+			sampleStatistics.m_numOfPixelShaderInvocations		+=	scopeStatistics.m_numOfPixelShaderInvocations;
+			sampleStatistics.m_numOfComputeShaderInvocations	+=	scopeStatistics.m_numOfComputeShaderInvocations;
+		}
+		if (resolvedScope.m_hasTimestamps)
+		{
+			TimestampSubmitTime const& submitBegin	=	backend.GetTimestampSubmitTime(frameSlot, (uint32_t)scope.m_beginTimestampIndex);
+			TimestampSubmitTime const& submitEnd	=	backend.GetTimestampSubmitTime(frameSlot, (uint32_t)scope.m_endTimestampIndex);
+			resolvedScope.m_submitBeginSeconds		=	submitBegin.m_timeSeconds;
+			resolvedScope.m_submitEndSeconds		=	submitEnd.m_timeSeconds;
+			resolvedScope.m_secondsSubmitting		=	submitEnd.m_secondsExecuting - submitBegin.m_secondsExecuting;
+			sample.m_cpuSubmitSeconds				+=	resolvedScope.m_secondsSubmitting;
+			if (hasGPUTimes)
+			{
+				resolvedScope.m_gpuBeginSeconds		=	gpuSeconds[scope.m_beginTimestampIndex] + gpuToCPUSeconds;
+				resolvedScope.m_gpuEndSeconds		=	gpuSeconds[scope.m_endTimestampIndex] + gpuToCPUSeconds;
+				sample.m_gpuSeconds					=	std::max(sample.m_gpuSeconds, 0.0) + (resolvedScope.m_gpuEndSeconds - resolvedScope.m_gpuBeginSeconds);
+			}
+		}
+		resolvedFrame.m_scopes.push_back(resolvedScope);
+	}
+
+	for (size_t nameIndex = 0; nameIndex < m_scopeHistories.size(); ++nameIndex)
+	{
+		if (!isInFrame[nameIndex])
+		{
+			continue;
+		}
+		ScopeHistory& scopeHistory = m_scopeHistories[nameIndex];
+		if ((int)scopeHistory.m_samples.size() < NUM_OF_RENDER_TIMING_SAMPLES)
+		{
+			scopeHistory.m_samples.push_back(frameSamples[nameIndex]);
+		}
+		else
+		{
+			scopeHistory.m_samples[scopeHistory.m_nextSampleIndex] = frameSamples[nameIndex];
+		}
+		scopeHistory.m_nextSampleIndex = (scopeHistory.m_nextSampleIndex + 1) % NUM_OF_RENDER_TIMING_SAMPLES;
+	}
+
+	if ((int)m_resolvedFrames.size() < NUM_OF_RENDER_TIMING_SAMPLES)
+	{
+		m_resolvedFrames.push_back(resolvedFrame);
+	}
+	else
+	{
+		m_resolvedFrames[m_nextResolvedFrameIndex] = resolvedFrame;
+	}
+	m_nextResolvedFrameIndex	=	(m_nextResolvedFrameIndex + 1) % NUM_OF_RENDER_TIMING_SAMPLES;
+	m_numOfResolvedFrames		+=	1;
+	frame.m_state				=	FrameState::UNUSED;
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/RenderBackend.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <functional>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr int NUM_OF_RENDER_TIMING_SAMPLES = 120;		// Frames in the rolling stats and in the trace
+
+
+//--------------------------------------------------------------------------------------------------
+struct RenderTimingRange
+{
+	double	m_minMS		=	0.0;
+	double	m_avgMS		=	0.0;
+	double	m_maxMS		=	0.0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Every scope with the same name adds up within a frame, the ranges are over the frames it showed up in
+struct RenderTimingStats
+{
+	std::string			m_name;
+	int					m_depth								=	0;		// Of its first use
+	int					m_numOfSamples						=	0;
+	int					m_numOfGPUSamples					=	0;		// None when the backend has no GPU timestamps
+	int					m_numOfPipelineStatisticsSamples	=	0;		// None when the backend has no pipeline statistics
+	RenderTimingRange	m_gpu;
+	RenderTimingRange	m_cpuRecord;									// Between the begin and end calls on the recording thread
+	RenderTimingRange	m_cpuSubmit;									// The backend executing the scope's commands
+	PipelineStatistics	m_avgPipelineStatistics;						// Per frame the scope showed up in
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Pairs CPU times with backend timestamps and pipeline statistics around named scopes of the Renderer's command buffer
+// A frame's timestamps are only read once its fence has completed, NUM_OF_TIMESTAMP_FRAMES frames can wait at once and a
+// frame whose slot is needed again before that is dropped, so reading them never stalls on the GPU
+class RenderProfiler
+{
+public:
+	void		BeginScope(char const* name, RenderCommandBuffer& commandBuffer);		// Starts the frame if this is its first scope
+	void		EndScope(RenderCommandBuffer& commandBuffer);
+
+	// Ending the frame is recorded before the frame's fence, resolving it after
+	void		EndFrame(RenderCommandBuffer& commandBuffer, uint64_t frameNumber);
+	void		ResolveFrames(RenderBackend& backend, uint64_t completedFrameNumber);
+	void		Reset(RenderCommandBuffer& commandBuffer);		// Before the backend changes, frames waiting for the old one are dropped
+
+	std::vector<RenderTimingStats>	GetTimingStats() const;		// In the order the scopes were first seen
+	int								GetNumOfResolvedFrames() const;
+	int								GetNumOfDroppedFrames() const;
+	bool							WriteChromeTrace(std::string const& filePath) const;		// The last NUM_OF_RENDER_TIMING_SAMPLES frames, for chrome://tracing or Perfetto, false if none resolved or the file could not be written
+
+private:
+	struct TimedScope
+	{
+		int			m_nameIndex				=	0;
+		int			m_depth					=	0;
+		int			m_beginTimestampIndex	=	-1;		// Both are taken at the begin, -1 once the frame ran out of timestamps
+		int			m_endTimestampIndex		=	-1;
+		int			m_statisticsIndex		=	-1;		// -1 once the frame ran out of pipeline statistics queries
+		double		m_cpuBeginSeconds		=	0.0;
+		double		m_cpuEndSeconds			=	0.0;
+	};
+
+	enum class FrameState
+	{
+		UNUSED,
+		RECORDING,
+		WAITING_FOR_GPU,
+	};
+
+	struct TimestampFrame
+	{
+		FrameState				m_state				=	FrameState::UNUSED;
+		uint64_t				m_frameNumber		=	0;
+		uint32_t				m_numOfTimestamps	=	0;
+		uint32_t				m_numOfStatistics	=	0;
+		std::vector<TimedScope>	m_scopes;
+	};
+
+	struct ResolvedScope
+	{
+		int			m_nameIndex				=	0;
+		int			m_depth					=	0;
+		double		m_cpuBeginSeconds		=	0.0;
+		double		m_cpuEndSeconds			=	0.0;
+		double		m_submitBeginSeconds	=	0.0;
+		double		m_submitEndSeconds		=	0.0;
+		double		m_secondsSubmitting		=	0.0;
+		double		m_gpuBeginSeconds		=	0.0;		// On the CPU clock, lined up with the submit of the frame's first timestamp
+		double		m_gpuEndSeconds			=	0.0;
+		bool		m_hasTimestamps			=	false;
+	};
+
+	struct ResolvedFrame
+	{
+		uint64_t					m_frameNumber	=	0;
+		bool						m_hasGPUTimes	=	false;
+		std::vector<ResolvedScope>	m_scopes;
+	};
+
+	// One per frame the scope showed up in, a GPU time below zero is missing
+	struct TimingSample
+	{
+		double				m_gpuSeconds				=	-1.0;
+		double				m_cpuRecordSeconds			=	0.0;
+		double				m_cpuSubmitSeconds			=	0.0;
+		bool				m_hasPipelineStatistics		=	false;
+		PipelineStatistics	m_pipelineStatistics;
+	};
+
+	struct ScopeHistory
+	{
+		std::string					m_name;
+		int							m_depth				=	0;
+		std::vector<TimingSample>	m_samples;						// Ring of up to NUM_OF_RENDER_TIMING_SAMPLES
+		int							m_nextSampleIndex	=	0;
+	};
+
+	void		BeginFrame(RenderCommandBuffer& commandBuffer);
+	int			GetOrAddNameIndex(char const* name, int depth);
+	void		ResolveFrame(RenderBackend& backend, uint32_t frameSlot, bool hasGPUTimes, double const* gpuSeconds, PipelineStatistics const* pipelineStatistics);		// Null statistics when they are not in
+
+private:
+	TimestampFrame							m_frames[NUM_OF_TIMESTAMP_FRAMES];
+	int										m_recordingFrameSlot		=	-1;
+	uint32_t								m_nextFrameSlot				=	0;
+	std::vector<int>						m_openScopeIndexes;			// Into the recording frame's scopes
+	std::map<std::string, int, std::less<>>	m_nameIndexes;				// Looked up by the char const* without making a string
+	std::vector<ScopeHistory>				m_scopeHistories;
+	std::vector<ResolvedFrame>				m_resolvedFrames;			// Ring of up to NUM_OF_RENDER_TIMING_SAMPLES
+	int										m_nextResolvedFrameIndex	=	0;
+	int										m_numOfResolvedFrames		=	0;
+	int										m_numOfDroppedFrames		=	0;
+	double									m_gpuSeconds[MAX_NUM_OF_TIMESTAMPS_PER_FRAME]	=	{};		// Scratch for reading a frame's timestamps
+	PipelineStatistics						m_pipelineStatistics[MAX_NUM_OF_PIPELINE_STATISTICS_PER_FRAME];	// And its pipeline statistics
+};
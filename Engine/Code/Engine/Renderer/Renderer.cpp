@@ -1,9 +1,13 @@
+#include "Engine/Renderer/D3D11_RenderBackend.hpp"
+#include "Engine/Renderer/NullRenderBackend.hpp"
 #include "Engine/Renderer/StructuredBuffer.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Renderer/ConstantBuffer.hpp"
 #include "Engine/Renderer/DefaultShader.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Renderer/D3D11_Buffer.hpp"
+#include "Engine/Renderer/RenderProfiler.hpp"
+#include "Engine/Renderer/ResourcePool.hpp"
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Renderer.hpp"
@@ -25,6 +29,7 @@
 #include <d3d11_1.h>
 #include <dxgi.h>
 #include <d3dcompiler.h>
+#include <string.h>
 
 
 //--------------------------------------------------------------------------------------------------
@@ -82,6 +87,28 @@ struct ModelConstants
 static int const s_modelConstantsSlot = 3;
 
 
+//--------------------------------------------------------------------------------------------------
+static constexpr uint32_t	TRANSIENT_VERTEX_ALIGNMENT		=	16;
+static constexpr uint32_t	TRANSIENT_CONSTANTS_RANGE_SIZE	=	256;		// Ranges start and span multiples of 16 constants
+static_assert(sizeof(ModelConstants) <= TRANSIENT_CONSTANTS_RANGE_SIZE, "Model constants do not fit in one constant buffer range");
+
+
+//--------------------------------------------------------------------------------------------------
+// Arrays of native objects are recorded as arrays of handles, every native object pointer is the same size as a handle
+template <typename T>
+static RenderHandle const* ToRenderHandles(T* const* nativeObjects)
+{
+	return reinterpret_cast<RenderHandle const*>(nativeObjects);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void SetViewport(RenderCommandBuffer& commandBuffer, D3D11_VIEWPORT const& viewport)
+{
+	commandBuffer.SetViewport(viewport.TopLeftX, viewport.TopLeftY, viewport.Width, viewport.Height, viewport.MinDepth, viewport.MaxDepth);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 Renderer::Renderer(RendererConfig const& config) :
 	m_config(config)
@@ -143,27 +170,75 @@ void Renderer::Startup()
 																			D3D_FEATURE_LEVEL_9_1, 
 																		};
 	HRESULT hResult;
-	hResult = D3D11CreateDeviceAndSwapChain(	NULL,											// Let it be null unless you want to specify the video adapter
-												D3D_DRIVER_TYPE_HARDWARE,						// Enables the use of D3D on the Hardware(GPU)
-												NULL,											// Only useful when D3D_DRIVER_TYPE |^ is D3D_DRIVER_TYPE_SOFTWARE
-												deviceFlags,
-												featureLevelsSupported,							// Feature level related (d3d version AND feature list)
-												numOfFeatureLevels, 							// Feature level related (d3d version AND feature list)
-												D3D11_SDK_VERSION,								// Lets the client know which version of DirectX was the game built on
-												&swapChainDesc,									// Pointer to the Swap_chain_description struct
-												&m_swapChain,
-												&m_d3d11Device,
-												NULL,											// Feature Level related
-												&m_d3d11DeviceContext
-											);
+	if (m_config.m_isHeadless)
+	{
+		// WARP runs on the CPU, resources and shaders are still created for real so loading behaves as it does on a GPU
+		hResult = D3D11CreateDevice(	NULL,
+										D3D_DRIVER_TYPE_WARP,
+										NULL,
+										deviceFlags,
+										featureLevelsSupported,
+										numOfFeatureLevels,
+										D3D11_SDK_VERSION,
+										&m_d3d11Device,
+										NULL,
+										&m_d3d11DeviceContext
+									);
+	}
+	else
+	{
+		hResult = D3D11CreateDeviceAndSwapChain(	NULL,											// Let it be null unless you want to specify the video adapter
+													D3D_DRIVER_TYPE_HARDWARE,						// Enables the use of D3D on the Hardware(GPU)
+													NULL,											// Only useful when D3D_DRIVER_TYPE |^ is D3D_DRIVER_TYPE_SOFTWARE
+													deviceFlags,
+													featureLevelsSupported,							// Feature level related (d3d version AND feature list)
+													numOfFeatureLevels, 							// Feature level related (d3d version AND feature list)
+													D3D11_SDK_VERSION,								// Lets the client know which version of DirectX was the game built on
+													&swapChainDesc,									// Pointer to the Swap_chain_description struct
+													&m_swapChain,
+													&m_d3d11Device,
+													NULL,											// Feature Level related
+													&m_d3d11DeviceContext
+												);
+	}
 	if (!SUCCEEDED(hResult))
 	{
 		ERROR_AND_DIE("Could not create D3D11 device and swap chain");
 	}
 
+	// Recording does not know which backend it feeds, headless the commands are only validated and counted, never submitted
+	if (m_config.m_isHeadless)
+	{
+		m_headlessBackend	=	new NullRenderBackend();
+		m_backend			=	m_headlessBackend;
+	}
+	else
+	{
+		m_d3d11Backend		=	new D3D11_RenderBackend(m_d3d11DeviceContext);
+		m_backend			=	m_d3d11Backend;
+	}
+	ReserveTransientBuffers();
+
 	ID3D11Texture2D* backBuffer;
-	// HRESULT is a data type that represents the completion status of a function
-	hResult = m_swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer); // Fills in the Back-buffer/ Gets the location of where in memory the back-buffer is
+	if (m_config.m_isHeadless)
+	{
+		// Stands in for the swap chain's buffer, so the default render target and depth buffer still match the window
+		D3D11_TEXTURE2D_DESC backBufferDesc	=	{};
+		backBufferDesc.Width				=	windowDim.x;
+		backBufferDesc.Height				=	windowDim.y;
+		backBufferDesc.MipLevels			=	1;
+		backBufferDesc.ArraySize			=	1;
+		backBufferDesc.Format				=	DXGI_FORMAT_R8G8B8A8_UNORM;
+		backBufferDesc.SampleDesc.Count		=	1;
+		backBufferDesc.Usage				=	D3D11_USAGE_DEFAULT;
+		backBufferDesc.BindFlags			=	D3D11_BIND_RENDER_TARGET;
+		hResult = m_d3d11Device->CreateTexture2D(&backBufferDesc, NULL, &backBuffer);
+	}
+	else
+	{
+		// HRESULT is a data type that represents the completion status of a function
+		hResult = m_swapChain->GetBuffer(0, __uuidof(ID3D11Texture2D), (void**)&backBuffer); // Fills in the Back-buffer/ Gets the location of where in memory the back-buffer is
+	}
 	if (!SUCCEEDED(hResult))
 	{
 		ERROR_AND_DIE("Could not get swap chain buffer");
@@ -175,6 +250,16 @@ void Renderer::Startup()
 		ERROR_AND_DIE("Could create render target view for swap chain buffer");
 	}
 
+	m_shaderCache		=	new ShaderCache(m_config.m_shaderCacheFolder);
+
+	ResourcePoolConfig resourcePoolConfig;
+	resourcePoolConfig.m_maxIdleBytes		=	m_config.m_maxIdlePooledBytes;
+	resourcePoolConfig.m_maxNumOfIdleFrames	=	m_config.m_maxIdlePooledFrames;
+	m_resourcePool = new ResourcePool(resourcePoolConfig,
+		[this](D3D11_ResourceConfig const& config) { return CreateUntrackedResource(config); },
+		[](D3D11_Resource* resource) { delete resource; });
+	m_renderProfiler	=	new RenderProfiler();
+
 	Shader* shader		=	CreateShader("Default", g_theShaderSource);
 	m_defaultShader		=	shader;
 	BindShader(shader);
@@ -184,9 +269,6 @@ void Renderer::Startup()
 	m_defaultTexture				=	CreateTextureFromImage(defaultImage);
 	BindTexture(m_defaultTexture);
 
-	m_immediateVBO		=	CreateVertexBuffer(sizeof(Vertex_PCU), sizeof(Vertex_PCU));
-	m_immediatePNCUVBO	=	CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
-	m_immediateIBO		=	CreateIndexBuffer(sizeof(unsigned int));
 	m_cameraCBO			=	CreateConstantBuffer(sizeof(CameraConstants));
 	m_modelCBO			=	CreateConstantBuffer(sizeof(ModelConstants));
 	m_lightingCBO		=	CreateConstantBuffer(sizeof(LightingConstants));
@@ -205,13 +287,14 @@ void Renderer::Startup()
 	SetModelConstants();
 
 	CreateUserDefinedDebugAnnotation();
+	FlushCommands();
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::BeginFrame()
 {
-	m_d3d11DeviceContext->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+	m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&m_renderTargetView), m_depthStencilView);
 	D3D11_VIEWPORT viewport =	{};
 	viewport.MaxDepth		=	1;
 	IntVec2 windowDim		=	m_config.m_window->GetClientDimensions();
@@ -219,13 +302,20 @@ void Renderer::BeginFrame()
 	float	clientHeight	=	(float)windowDim.y;
 	viewport.Width			=	clientWidth;
 	viewport.Height			=	clientHeight;
-	m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+	SetViewport(m_commandBuffer, viewport);
+	FlushCommands();
+	BeginTimingScope("Frame");
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::EndFrame()
 {
+	SignalFrameFence();
+	if (m_swapChain == nullptr)
+	{
+		return;
+	}
 	HRESULT hResult = m_swapChain->Present(0, 0);
 	if (hResult == DXGI_ERROR_DEVICE_REMOVED || hResult == DXGI_ERROR_DEVICE_RESET)
 	{
@@ -237,6 +327,30 @@ void Renderer::EndFrame()
 //--------------------------------------------------------------------------------------------------
 void Renderer::Shutdown()
 {
+	FlushCommands();
+	ShaderCacheStats shaderCacheStats = m_shaderCache->GetStats();
+	DebuggerPrintf("Shader cache: %d hits in %.1f ms, %d misses (%d stale) compiled in %.1f ms, %d files not written\n", shaderCacheStats.m_numOfHits, shaderCacheStats.m_secondsLoading * 1000.0,
+		shaderCacheStats.m_numOfMisses, shaderCacheStats.m_numOfRejectedFiles, shaderCacheStats.m_secondsCompiling * 1000.0, shaderCacheStats.m_numOfFailedWrites);
+	delete m_shaderCache;
+	m_shaderCache = nullptr;
+	ResourcePoolStats const& resourcePoolStats = m_resourcePool->GetStats();
+	DebuggerPrintf("Resource pool: %d hits, %d misses, %d destroyed, peak %.1f MB\n", resourcePoolStats.m_numOfHits, resourcePoolStats.m_numOfMisses,
+		resourcePoolStats.m_numOfDestroyedResources, double(resourcePoolStats.m_peakBytes) / (1024.0 * 1024.0));
+	delete m_resourcePool;
+	m_resourcePool = nullptr;
+	delete m_renderProfiler;
+	m_renderProfiler = nullptr;
+	m_backend = nullptr;
+	delete m_d3d11Backend;
+	m_d3d11Backend = nullptr;
+	delete m_headlessBackend;
+	m_headlessBackend = nullptr;
+	for (int bufferIndex = 0; bufferIndex < (int)m_parallelCommandBuffers.size(); ++bufferIndex)
+	{
+		delete m_parallelCommandBuffers[bufferIndex];
+	}
+	m_parallelCommandBuffers.clear();
+
 	for (int samplerIndex = 0; samplerIndex < int(SamplerMode::COUNT); ++samplerIndex)
 	{
 		DX_SAFE_RELEASE(m_samplerStates[samplerIndex]);
@@ -283,13 +397,12 @@ void Renderer::Shutdown()
 		delete m_loadedResources[resourceIndex];
 		m_loadedResources[resourceIndex] = nullptr;
 	}
+	for (int retiredIndex = 0; retiredIndex < m_retiredResources.size(); ++retiredIndex)
+	{
+		delete m_retiredResources[retiredIndex].m_resource;
+	}
+	m_retiredResources.clear();
 
-	delete m_immediateVBO;
-	m_immediateVBO = nullptr;
-	delete m_immediatePNCUVBO;
-	m_immediatePNCUVBO = nullptr;
-	delete m_immediateIBO;
-	m_immediateIBO = nullptr;
 	delete m_cameraCBO;
 	m_cameraCBO = nullptr;
 	delete m_modelCBO;
@@ -314,8 +427,8 @@ void Renderer::ClearScreen(Rgba8 const& clearColor)
 {
 	float clearColorAsFloats[4] = {};
 	clearColor.GetAsFloats(clearColorAsFloats);
-	m_d3d11DeviceContext->ClearRenderTargetView(m_renderTargetView, clearColorAsFloats);
-	m_d3d11DeviceContext->ClearDepthStencilView(m_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1, 0);
+	m_commandBuffer.ClearRenderTarget(m_renderTargetView, clearColorAsFloats);
+	m_commandBuffer.ClearDepthStencil(m_depthStencilView, 1.f, 0);
 }
 
 
@@ -357,7 +470,7 @@ void Renderer::BeginCamera(Camera const& camera)
 		viewport.Width		=	cameraDimensions.x;
 		viewport.Height		=	cameraDimensions.y;
 		viewport.MaxDepth = 1;
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+		SetViewport(m_commandBuffer, viewport);
 	}
 }
 
@@ -366,14 +479,231 @@ void Renderer::BeginCamera(Camera const& camera)
 void Renderer::EndCamera(Camera const& camera)
 {
 	(void)camera;
+	FlushCommands();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::FlushCommands()
+{
+	if (m_commandBuffer.IsEmpty())
+	{
+		return;
+	}
+	GUARANTEE_OR_DIE(m_numOfOpenParallelCommandBuffers == 0, "Flushing while a parallel command buffer is still recording, finish it and wait for its job first");
+	UploadTransientData();
+	m_backend->Submit(m_commandBuffer);
+	m_commandBuffer.Reset();
+	m_numOfParallelCommandBuffersInUse = 0;
+
+	// The context holds its own reference to whatever is still bound, so the submitted commands no longer need these
+	for (int objectIndex = 0; objectIndex < (int)m_objectsToReleaseAfterFlush.size(); ++objectIndex)
+	{
+		m_objectsToReleaseAfterFlush[objectIndex]->Release();
+	}
+	m_objectsToReleaseAfterFlush.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::ReleaseAfterFlush(IUnknown* d3d11Object)
+{
+	if (d3d11Object == nullptr)
+	{
+		return;
+	}
+	// Acquiring a parallel buffer records its execute command here, so an empty buffer means nothing can refer to the object
+	if (m_commandBuffer.IsEmpty())
+	{
+		d3d11Object->Release();
+		return;
+	}
+	m_objectsToReleaseAfterFlush.push_back(d3d11Object);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The fence tells the rings when the GPU is done with the frame, so its bytes can be handed out again
+void Renderer::SignalFrameFence()
+{
+	m_renderProfiler->EndFrame(m_commandBuffer, m_numOfFramesSignaled + 1);
+	FlushCommands();
+	m_numOfFramesSignaled += 1;
+	m_backend->SignalFence(m_numOfFramesSignaled);
+
+	uint64_t completedFenceValue = m_backend->GetCompletedFenceValue();
+	for (int typeIndex = 0; typeIndex < (int)TransientBufferType::COUNT; ++typeIndex)
+	{
+		m_transientBuffers[typeIndex].EndFrame(m_numOfFramesSignaled);
+		m_transientBuffers[typeIndex].RetireFrames(completedFenceValue);
+	}
+	m_resourcePool->EndFrame(m_numOfFramesSignaled, completedFenceValue);
+	for (size_t retiredIndex = 0; retiredIndex < m_retiredResources.size();)
+	{
+		if (m_retiredResources[retiredIndex].m_lastUsedFrame <= completedFenceValue)
+		{
+			delete m_retiredResources[retiredIndex].m_resource;
+			m_retiredResources[retiredIndex] = m_retiredResources.back();
+			m_retiredResources.pop_back();
+		}
+		else
+		{
+			++retiredIndex;
+		}
+	}
+	m_renderProfiler->ResolveFrames(*m_backend, completedFenceValue);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::SetBackend(RenderBackend* backend)
+{
+	m_renderProfiler->Reset(m_commandBuffer);
+	FlushCommands();
+	if (backend == nullptr)
+	{
+		backend = m_headlessBackend ? (RenderBackend*)m_headlessBackend : (RenderBackend*)m_d3d11Backend;
+	}
+	m_backend = backend;
+
+	// The new backend has not seen any of the states, and its buffers do not hold the frames in flight
+	for (int typeIndex = 0; typeIndex < (int)TransientBufferType::COUNT; ++typeIndex)
+	{
+		m_transientBuffers[typeIndex].Reset();
+	}
+	ReserveTransientBuffers();
+	InvalidateStateCache();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderBackend* Renderer::GetBackend() const
+{
+	return m_backend;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Renderer::IsHeadless() const
+{
+	return m_config.m_isHeadless;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderCommandBuffer* Renderer::AcquireParallelCommandBuffer()
+{
+	if (m_numOfParallelCommandBuffersInUse == (int)m_parallelCommandBuffers.size())
+	{
+		m_parallelCommandBuffers.push_back(new RenderCommandBuffer());
+	}
+	RenderCommandBuffer* commandBuffer = m_parallelCommandBuffers[m_numOfParallelCommandBuffersInUse];
+	m_numOfParallelCommandBuffersInUse += 1;
+	m_numOfOpenParallelCommandBuffers += 1;
+	commandBuffer->Reset();
+
+	// The buffer inherits whatever the main thread has set so far, and may leave any state bound when it is done
+	SetStatesIfChanged();
+	m_commandBuffer.ExecuteCommandBuffer(commandBuffer);
+	InvalidateStateCache();
+	return commandBuffer;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::FinishParallelCommandBuffer()
+{
+	int numOfOpenBuffers = m_numOfOpenParallelCommandBuffers.fetch_sub(1);
+	GUARANTEE_OR_DIE(numOfOpenBuffers > 0, "Finished more parallel command buffers than were acquired");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::RecordBindShader(RenderCommandBuffer& commandBuffer, Shader const* shader) const
+{
+	if (shader == nullptr)
+	{
+		shader = m_defaultShader;
+	}
+	if (!shader->IsReady())
+	{
+		shader = GetFallbackShader(shader);
+	}
+	commandBuffer.SetInputLayout(shader->m_inputLayout);
+	commandBuffer.SetShader(ShaderStage::VERTEX, shader->m_vertexShader);
+	commandBuffer.SetShader(ShaderStage::PIXEL, shader->m_pixelShader);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::RecordBindTexture(RenderCommandBuffer& commandBuffer, Texture const* texture, unsigned int slot) const
+{
+	if (texture == nullptr)
+	{
+		texture = m_defaultTexture;
+	}
+	commandBuffer.SetShaderResources(ShaderStage::PIXEL, slot, 1, ToRenderHandles(&texture->m_shaderResourceView));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::RecordModelConstants(RenderCommandBuffer& commandBuffer, Mat44 const& modelMatrix, Rgba8 const& modelColor) const
+{
+	ModelConstants modelConstants;
+	modelConstants.modelMatrix = modelMatrix;
+	modelColor.GetAsFloats(modelConstants.modelColor);
+	commandBuffer.UpdateBuffer(m_modelCBO->m_buffer, &modelConstants, sizeof(modelConstants));
+	commandBuffer.SetConstantBuffer(ShaderStage::VERTEX, s_modelConstantsSlot, m_modelCBO->m_buffer);
+	commandBuffer.SetConstantBuffer(ShaderStage::PIXEL, s_modelConstantsSlot, m_modelCBO->m_buffer);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::RecordDrawVertexBuffer(RenderCommandBuffer& commandBuffer, VertexBuffer const* vbo, int vertexCount, PrimitiveTopology primitiveTopology, int vertexOffset) const
+{
+	unsigned int vertexStride	=	vbo->GetStride();
+	unsigned int offset			=	0;
+	commandBuffer.SetVertexBuffers(0, 1, ToRenderHandles(&vbo->m_buffer), &vertexStride, &offset);
+	commandBuffer.SetPrimitiveTopology(primitiveTopology);
+	commandBuffer.Draw(vertexCount, vertexOffset);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::RecordDrawVertexAndIndexBuffer(RenderCommandBuffer& commandBuffer, VertexBuffer const* vbo, IndexBuffer const* ibo, int indexCount, int indexOffset, int vertexOffset) const
+{
+	unsigned int vertexStride	=	vbo->GetStride();
+	unsigned int offset			=	0;
+	commandBuffer.SetVertexBuffers(0, 1, ToRenderHandles(&vbo->m_buffer), &vertexStride, &offset);
+	commandBuffer.SetPrimitiveTopology(PrimitiveTopology::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandBuffer.SetIndexBuffer(ibo->m_buffer);
+	commandBuffer.DrawIndexed(indexCount, indexOffset, vertexOffset);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Vertexes are written to the transient geometry ring and drawn from their offset in it
+static void DrawTransientVertexes(Renderer& renderer, RenderCommandBuffer& commandBuffer, RenderHandle transientBuffer, TransientAllocation const& allocation, uint32_t vertexStride, int numVertexes, PrimitiveTopology primitiveTopology)
+{
+	renderer.SetStatesIfChanged();
+	commandBuffer.SetVertexBuffers(0, 1, &transientBuffer, &vertexStride, &allocation.m_offset);
+	commandBuffer.SetPrimitiveTopology(primitiveTopology);
+	commandBuffer.Draw(numVertexes, 0);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes)
 {
-	CopyCPUToGPU(vertexes, (size_t)m_immediateVBO->GetStride() * numVertexes, m_immediateVBO);
-	DrawVertexBuffer(m_immediateVBO, numVertexes);
+	if (numVertexes <= 0)
+	{
+		return;
+	}
+	uint32_t			numOfBytes	=	(uint32_t)(sizeof(Vertex_PCU) * numVertexes);
+	TransientAllocation	allocation;
+	AllocateTransient(TransientBufferType::GEOMETRY, numOfBytes, TRANSIENT_VERTEX_ALIGNMENT, allocation);
+	memcpy(allocation.m_data, vertexes, numOfBytes);
+	DrawTransientVertexes(*this, m_commandBuffer, m_backend->GetTransientBuffer(TransientBufferType::GEOMETRY), allocation, sizeof(Vertex_PCU), numVertexes, PrimitiveTopology::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 }
 
 
@@ -381,34 +711,110 @@ void Renderer::DrawVertexArray(int numVertexes, Vertex_PCU const* vertexes)
 void Renderer::DrawVertexArray(std::vector<Vertex_PCU> const& vertexes, PrimitiveTopology const& primitiveTopology)
 {
 	int numVertexes = (int)vertexes.size();
-	CopyCPUToGPU(vertexes.data(), (size_t)m_immediateVBO->GetStride() * numVertexes, m_immediateVBO);
-	DrawVertexBuffer(m_immediateVBO, numVertexes, primitiveTopology);
+	if (numVertexes <= 0)
+	{
+		return;
+	}
+	uint32_t			numOfBytes	=	(uint32_t)(sizeof(Vertex_PCU) * numVertexes);
+	TransientAllocation	allocation;
+	AllocateTransient(TransientBufferType::GEOMETRY, numOfBytes, TRANSIENT_VERTEX_ALIGNMENT, allocation);
+	memcpy(allocation.m_data, vertexes.data(), numOfBytes);
+	DrawTransientVertexes(*this, m_commandBuffer, m_backend->GetTransientBuffer(TransientBufferType::GEOMETRY), allocation, sizeof(Vertex_PCU), numVertexes, primitiveTopology);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::DrawIndexedArray(int numVertexes, Vertex_PCU const* vertexes, int numIndexes, unsigned int const* indexes)
+// Vertexes and indexes go in one allocation, so growing the ring for the indexes can not drop the vertexes
+static void DrawTransientIndexedVertexes(Renderer& renderer, RenderCommandBuffer& commandBuffer, RenderHandle transientBuffer, TransientAllocation const& allocation, uint32_t vertexStride, uint32_t numOfVertexBytes, int numIndexes)
 {
-	SetStatesIfChanged();
-	CopyCPUToGPU(vertexes, (size_t)m_immediateVBO->GetStride() * numVertexes, m_immediateVBO);
-	BindVertexBuffer(m_immediateVBO);
-	CopyCPUToGPU(indexes, (size_t)m_immediateIBO->GetStride() * numIndexes, m_immediateIBO);
-	BindIndexBuffer(m_immediateIBO);
+	renderer.SetStatesIfChanged();
+	commandBuffer.SetVertexBuffers(0, 1, &transientBuffer, &vertexStride, &allocation.m_offset);
+	commandBuffer.SetPrimitiveTopology(PrimitiveTopology::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandBuffer.SetIndexBuffer(transientBuffer, allocation.m_offset + numOfVertexBytes);
+	commandBuffer.DrawIndexed(numIndexes, 0, 0);
+}
 
-	DrawIndexed(numIndexes);
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::DrawIndexedArray(int numVertexes, Vertex_PCU const* vertexes, int numIndexes, unsigned int const* indexes)
+{
+	if (numVertexes <= 0 || numIndexes <= 0)
+	{
+		return;
+	}
+	uint32_t			numOfVertexBytes	=	(uint32_t)(sizeof(Vertex_PCU) * numVertexes);
+	uint32_t			numOfIndexBytes		=	(uint32_t)(sizeof(unsigned int) * numIndexes);
+	TransientAllocation	allocation;
+	AllocateTransient(TransientBufferType::GEOMETRY, numOfVertexBytes + numOfIndexBytes, TRANSIENT_VERTEX_ALIGNMENT, allocation);
+	memcpy(allocation.m_data, vertexes, numOfVertexBytes);
+	memcpy(allocation.m_data + numOfVertexBytes, indexes, numOfIndexBytes);
+	DrawTransientIndexedVertexes(*this, m_commandBuffer, m_backend->GetTransientBuffer(TransientBufferType::GEOMETRY), allocation, sizeof(Vertex_PCU), numOfVertexBytes, numIndexes);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::DrawIndexedArray(int numVertexes, Vertex_PCUTBN const* vertexes, int numIndexes, unsigned int const* indexes)
 {
-	SetStatesIfChanged();
-	CopyCPUToGPU(vertexes, (size_t)m_immediatePNCUVBO->GetStride() * numVertexes, m_immediatePNCUVBO);
-	BindVertexBuffer(m_immediatePNCUVBO);
-	CopyCPUToGPU(indexes, (size_t)m_immediateIBO->GetStride() * numIndexes, m_immediateIBO);
-	BindIndexBuffer(m_immediateIBO);
+	if (numVertexes <= 0 || numIndexes <= 0)
+	{
+		return;
+	}
+	uint32_t			numOfVertexBytes	=	(uint32_t)(sizeof(Vertex_PCUTBN) * numVertexes);
+	uint32_t			numOfIndexBytes		=	(uint32_t)(sizeof(unsigned int) * numIndexes);
+	TransientAllocation	allocation;
+	AllocateTransient(TransientBufferType::GEOMETRY, numOfVertexBytes + numOfIndexBytes, TRANSIENT_VERTEX_ALIGNMENT, allocation);
+	memcpy(allocation.m_data, vertexes, numOfVertexBytes);
+	memcpy(allocation.m_data + numOfVertexBytes, indexes, numOfIndexBytes);
+	DrawTransientIndexedVertexes(*this, m_commandBuffer, m_backend->GetTransientBuffer(TransientBufferType::GEOMETRY), allocation, sizeof(Vertex_PCUTBN), numOfVertexBytes, numIndexes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Retires what the GPU finished before growing, growing flushes so nothing recorded refers to the old buffer
+void Renderer::AllocateTransient(TransientBufferType type, uint32_t numOfBytes, uint32_t alignment, TransientAllocation& out_allocation)
+{
+	TransientRingBuffer& ringBuffer = m_transientBuffers[(int)type];
+	if (ringBuffer.Allocate(numOfBytes, alignment, out_allocation))
+	{
+		return;
+	}
+	ringBuffer.RetireFrames(m_backend->GetCompletedFenceValue());
+	if (ringBuffer.Allocate(numOfBytes, alignment, out_allocation))
+	{
+		return;
+	}
+
+	FlushCommands();
+	ringBuffer.Grow(numOfBytes + alignment);
+	m_backend->ReserveTransientBuffer(type, ringBuffer.GetSizeBytes());
+	bool isAllocated = ringBuffer.Allocate(numOfBytes, alignment, out_allocation);
+	GUARANTEE_OR_DIE(isAllocated, "Could not allocate from the grown transient buffer");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::UploadTransientData()
+{
+	for (int typeIndex = 0; typeIndex < (int)TransientBufferType::COUNT; ++typeIndex)
+	{
+		TransientRingBuffer&	ringBuffer			=	m_transientBuffers[typeIndex];
+		TransientRange			ranges[2];
+		bool					discardsContents	=	false;
+		int						numOfRanges			=	ringBuffer.TakePendingRanges(ranges, discardsContents);
+		m_backend->UploadTransientData((TransientBufferType)typeIndex, ringBuffer.GetBytes(), ranges, numOfRanges, discardsContents);
+	}
+}
 
-	DrawIndexed(numIndexes);
+
+//--------------------------------------------------------------------------------------------------
+// Constants are only sub-allocated on backends that can bind part of a constant buffer
+void Renderer::ReserveTransientBuffers()
+{
+	m_backend->ReserveTransientBuffer(TransientBufferType::GEOMETRY, m_transientBuffers[(int)TransientBufferType::GEOMETRY].GetSizeBytes());
+	if (m_backend->SupportsConstantBufferRanges())
+	{
+		m_backend->ReserveTransientBuffer(TransientBufferType::CONSTANTS, m_transientBuffers[(int)TransientBufferType::CONSTANTS].GetSizeBytes());
+	}
 }
 
 
@@ -438,15 +844,15 @@ void Renderer::BindTexture(Texture const* texture, BindingLocation bindingLocati
 
 	if (bindingLocation == BindingLocation::PIXEL_SHADER)
 	{
-		m_d3d11DeviceContext->PSSetShaderResources(0, 1, &texture->m_shaderResourceView);
+		m_commandBuffer.SetShaderResources(ShaderStage::PIXEL, 0, 1, ToRenderHandles(&texture->m_shaderResourceView));
 	}
 	if (bindingLocation == BindingLocation::VERTEX_SHADER)
 	{
-		m_d3d11DeviceContext->VSSetShaderResources(0, 1, &texture->m_shaderResourceView);
+		m_commandBuffer.SetShaderResources(ShaderStage::VERTEX, 0, 1, ToRenderHandles(&texture->m_shaderResourceView));
 	}
 	if (bindingLocation == BindingLocation::COMPUTE_SHADER)
 	{
-		m_d3d11DeviceContext->CSSetShaderResources(0, 1, &texture->m_shaderResourceView);
+		m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, 0, 1, ToRenderHandles(&texture->m_shaderResourceView));
 	}
 }
 
@@ -454,8 +860,8 @@ void Renderer::BindTexture(Texture const* texture, BindingLocation bindingLocati
 //--------------------------------------------------------------------------------------------------
 Texture* Renderer::CreateTextureFromFile(char const* imageFilePath)
 {
-	Image* newImage = new Image(imageFilePath);
-	Texture* newTexture = CreateTextureFromImage(*newImage);
+	Image newImage(imageFilePath);
+	Texture* newTexture = CreateTextureFromImage(newImage);
 	if (newTexture != nullptr)
 	{
 		m_loadedTextures.push_back(newTexture);
@@ -537,6 +943,24 @@ Texture* Renderer::CreateOrGetTextureFromFile(char const* imageFilePath)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+Texture* Renderer::CreateOrGetTextureFromImage(Image const& image)
+{
+	Texture* existingTexture = GetTextureForFileName(image.GetImageFilePath().c_str());
+	if (existingTexture)
+	{
+		return existingTexture;
+	}
+
+	Texture* newTexture = CreateTextureFromImage(image);
+	if (newTexture != nullptr)
+	{
+		m_loadedTextures.push_back(newTexture);
+	}
+	return newTexture;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 BitmapFont* Renderer::CreateOrGetBitmapFont(char const* bitmapFontFilePathWithNoExtension)
 {
@@ -553,17 +977,30 @@ BitmapFont* Renderer::CreateOrGetBitmapFont(char const* bitmapFontFilePathWithNo
 
 //--------------------------------------------------------------------------------------------------
 Shader* Renderer::CreateOrGetShader(char const* shaderFilePath, InputLayout const& inputLayout, bool isUsedForInstancedRendering /*= false*/)
+{
+	Shader* existingShader = GetShaderForName(shaderFilePath);
+	if (existingShader)
+	{
+		return existingShader;
+	}
+
+	Shader* newShader = CreateShader(shaderFilePath, inputLayout, isUsedForInstancedRendering);
+	return newShader;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Shader* Renderer::GetShaderForName(char const* shaderName)
 {
 	for (int shaderIndex = 0; shaderIndex < m_loadedShaders.size(); ++shaderIndex)
 	{
-		if (m_loadedShaders[shaderIndex]->m_config.m_name == shaderFilePath)
+		if (m_loadedShaders[shaderIndex]->m_config.m_name == shaderName)
 		{
 			return m_loadedShaders[shaderIndex];
 		}
 	}
 
-	Shader* newShader = CreateShader(shaderFilePath, inputLayout, isUsedForInstancedRendering);
-	return newShader;
+	return nullptr;
 }
 
 
@@ -603,63 +1040,92 @@ void Renderer::BindShader(Shader* shader, BindingLocation bindingLocation)
 	if (shader == nullptr)
 	{
 		shader = m_defaultShader;
-		m_d3d11DeviceContext->VSSetShader(nullptr, NULL, NULL);
-		m_d3d11DeviceContext->PSSetShader(nullptr, NULL, NULL);
-		m_d3d11DeviceContext->CSSetShader(nullptr, NULL, NULL);
+		m_commandBuffer.SetShader(ShaderStage::VERTEX, nullptr);
+		m_commandBuffer.SetShader(ShaderStage::PIXEL, nullptr);
+		m_commandBuffer.SetShader(ShaderStage::COMPUTE, nullptr);
+	}
+	if (bindingLocation == BindingLocation::COMPUTE_SHADER)
+	{
+		m_isBoundComputeShaderReady = shader->IsReady();
+	}
+	else if (!shader->IsReady())
+	{
+		shader = GetFallbackShader(shader);
 	}
 
-	m_d3d11DeviceContext->IASetInputLayout(shader->m_inputLayout);
+	m_commandBuffer.SetInputLayout(shader->m_inputLayout);
 	if (bindingLocation == BindingLocation::VERTEX_SHADER || bindingLocation == BindingLocation::PIXEL_SHADER)
 	{
-		m_d3d11DeviceContext->VSSetShader(shader->m_vertexShader, NULL, NULL);
-		m_d3d11DeviceContext->PSSetShader(shader->m_pixelShader, NULL, NULL);
+		m_commandBuffer.SetShader(ShaderStage::VERTEX, shader->m_vertexShader);
+		m_commandBuffer.SetShader(ShaderStage::PIXEL, shader->m_pixelShader);
 	}
 
 	if (bindingLocation == BindingLocation::COMPUTE_SHADER)
 	{
-		m_d3d11DeviceContext->CSSetShader(shader->m_computeShader, NULL, NULL);
+		m_commandBuffer.SetShader(ShaderStage::COMPUTE, shader->m_computeShader);
 	}
 
 	m_currentShader = shader;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+Shader* Renderer::GetFallbackShader(Shader const* shader) const
+{
+	Shader* fallbackShader = shader->m_fallbackShader;
+	return (fallbackShader && fallbackShader->IsReady()) ? fallbackShader : m_defaultShader;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Shader* Renderer::GetCurrentShader() const
+{
+	return m_currentShader;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void Renderer::UnbindShaders()
 {
 	ID3D11ShaderResourceView* nullViews[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
-	m_d3d11DeviceContext->PSSetShaderResources(0, 8, nullViews);
+	m_commandBuffer.SetShaderResources(ShaderStage::PIXEL, 0, 8, ToRenderHandles(nullViews));
 }
 
 
 //--------------------------------------------------------------------------------------------------
 Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource, InputLayout const& inputLayout /*= inputLayout::VERTEX_PCU*/, bool isUsedForInstancedRendering /*= false*/)
 {
-	HRESULT hResult;
 	ShaderConfig shaderConfig;
 	shaderConfig.m_name = shaderName;
 	
 	Shader* shader = new Shader(shaderConfig);
+	shader->m_renderer = this;
 
 	std::vector<unsigned char> vertexShaderByteCode;
-	bool isVertexShaderCompiled = CompileShaderToByteCode(vertexShaderByteCode, shaderName, shaderSource, shaderConfig.m_vertexEntryPoint.c_str(), "vs_5_0");
-	if (isVertexShaderCompiled)
+	std::vector<unsigned char> pixelShaderByteCode;
+	CompileShaderToByteCode(vertexShaderByteCode, shaderName, shaderSource, shaderConfig.m_vertexEntryPoint.c_str(), "vs_5_0");
+	CompileShaderToByteCode(pixelShaderByteCode, shaderName, shaderSource, shaderConfig.m_pixelEntryPoint.c_str(), "ps_5_0");
+	CreateShaderStages(*shader, vertexShaderByteCode, pixelShaderByteCode, inputLayout, isUsedForInstancedRendering);
+
+	m_loadedShaders.push_back(shader);
+
+	return shader;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::CreateShaderStages(Shader& shader, std::vector<unsigned char> const& vertexShaderByteCode, std::vector<unsigned char> const& pixelShaderByteCode, InputLayout const& inputLayout, bool isUsedForInstancedRendering)
+{
+	HRESULT hResult;
+	hResult = m_d3d11Device->CreateVertexShader(vertexShaderByteCode.data(), vertexShaderByteCode.size(), NULL, &shader.m_vertexShader);
+	if (!SUCCEEDED(hResult))
 	{
-		hResult = m_d3d11Device->CreateVertexShader(vertexShaderByteCode.data(), vertexShaderByteCode.size(), NULL, &shader->m_vertexShader);
-		if (!SUCCEEDED(hResult))
-		{
-			ERROR_AND_DIE("Could not create a Vertex Shader")
-		}
+		ERROR_AND_DIE("Could not create a Vertex Shader")
 	}
-	std::vector<unsigned char> pixelShaderByteCode;
-	bool isPixelShaderCompiled = CompileShaderToByteCode(pixelShaderByteCode, shaderName, shaderSource, shaderConfig.m_pixelEntryPoint.c_str(), "ps_5_0");
-	if (isPixelShaderCompiled)
+	hResult = m_d3d11Device->CreatePixelShader(pixelShaderByteCode.data(), pixelShaderByteCode.size(), NULL, &shader.m_pixelShader);
+	if (!SUCCEEDED(hResult))
 	{
-		hResult = m_d3d11Device->CreatePixelShader(pixelShaderByteCode.data(), pixelShaderByteCode.size(), NULL, &shader->m_pixelShader);
-		if (!SUCCEEDED(hResult))
-		{
-			ERROR_AND_DIE("Could not create a Pixel Shader")
-		}
+		ERROR_AND_DIE("Could not create a Pixel Shader")
 	}
 
 	if (!isUsedForInstancedRendering)
@@ -676,7 +1142,7 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 				{"BINORMAL",	0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
 				{"NORMAL",		0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
 			}; // organizing the data in a way so that the GPU can understand how our Vertices are laid out in memory
-			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 6, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader->m_inputLayout);
+			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 6, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader.m_inputLayout);
 		}
 		else if (inputLayout == InputLayout::VERTEX_PCU)
 		{
@@ -687,7 +1153,20 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 				{"COLOR",		0, DXGI_FORMAT_R8G8B8A8_UNORM,	0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
 				{"TEXCOORD",	0, DXGI_FORMAT_R32G32_FLOAT,	0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
 			}; // organizing the data in a way so that the GPU can understand how our Vertices are laid out in memory
-			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 3, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader->m_inputLayout);
+			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 3, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader.m_inputLayout);
+		}
+		else if (inputLayout == InputLayout::VERTEX_PCUTBN_QUANTIZED)
+		{
+			// See Vertex_PCUTBN_Quantized, the shader dequantizes the position with the model matrix and decodes the octahedral tangent and normal itself
+			D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
+			{
+				{"POSITION",	0, DXGI_FORMAT_R16G16B16A16_UNORM,	0, 0,							 D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"COLOR",		0, DXGI_FORMAT_R8G8B8A8_UNORM,		0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"TEXCOORD",	0, DXGI_FORMAT_R16G16_FLOAT,		0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"TANGENT",		0, DXGI_FORMAT_R16G16_SNORM,		0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+				{"NORMAL",		0, DXGI_FORMAT_R16G16_SNORM,		0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+			};
+			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 5, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader.m_inputLayout);
 		}
 		else
 		{
@@ -702,7 +1181,7 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 			{
 				{"INSTANCE_POSITION",	0, DXGI_FORMAT_R32G32B32_FLOAT,		0,	0,								D3D11_INPUT_PER_INSTANCE_DATA,	1},
 			}; 
-			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 1, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader->m_inputLayout);
+			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 1, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader.m_inputLayout);
 		}
 		else if (inputLayout == InputLayout::VERTEX_PCU)
 		{
@@ -714,7 +1193,7 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 				{"TEXCOORD",			0, DXGI_FORMAT_R32G32_FLOAT,		0,	D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_VERTEX_DATA,	0},
 				{"INSTANCE_POSITION",	0, DXGI_FORMAT_R32G32B32_FLOAT,		1,	0,								D3D11_INPUT_PER_INSTANCE_DATA,	1}
 			};
-			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 4, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader->m_inputLayout);
+			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 4, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader.m_inputLayout);
 		}
 		else if (inputLayout == InputLayout::VERTEX_PCUTBN)
 		{
@@ -728,7 +1207,31 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 				{"NORMAL",				0, DXGI_FORMAT_R32G32B32_FLOAT,		0,	D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_VERTEX_DATA,	0},
 				{"INSTANCE_POSITION",	0, DXGI_FORMAT_R32G32B32_FLOAT,		1,	0,								D3D11_INPUT_PER_INSTANCE_DATA,	1}
 			}; 
-			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 7, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader->m_inputLayout);
+			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 7, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader.m_inputLayout);
+		}
+		else if (inputLayout == InputLayout::SPRITE_QUAD)
+		{
+			// See SpriteQuad, bounds and UVs are mins then maxs
+			D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
+			{
+				{"QUAD_BOUNDS",			0, DXGI_FORMAT_R32G32B32A32_FLOAT,	0,	0,								D3D11_INPUT_PER_INSTANCE_DATA,	1},
+				{"QUAD_UVS",			0, DXGI_FORMAT_R32G32B32A32_FLOAT,	0,	D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_INSTANCE_DATA,	1},
+				{"COLOR",				0, DXGI_FORMAT_R8G8B8A8_UNORM,		0,	D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_INSTANCE_DATA,	1},
+			};
+			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 3, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader.m_inputLayout);
+		}
+		else if (inputLayout == InputLayout::VERTEX_PCUTBN_QUANTIZED)
+		{
+			D3D11_INPUT_ELEMENT_DESC inputElementDesc[] =
+			{
+				{"POSITION",			0, DXGI_FORMAT_R16G16B16A16_UNORM,	0,	0,								D3D11_INPUT_PER_VERTEX_DATA,	0},
+				{"COLOR",				0, DXGI_FORMAT_R8G8B8A8_UNORM,		0,	D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_VERTEX_DATA,	0},
+				{"TEXCOORD",			0, DXGI_FORMAT_R16G16_FLOAT,		0,	D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_VERTEX_DATA,	0},
+				{"TANGENT",				0, DXGI_FORMAT_R16G16_SNORM,		0,	D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_VERTEX_DATA,	0},
+				{"NORMAL",				0, DXGI_FORMAT_R16G16_SNORM,		0,	D3D11_APPEND_ALIGNED_ELEMENT,	D3D11_INPUT_PER_VERTEX_DATA,	0},
+				{"INSTANCE_POSITION",	0, DXGI_FORMAT_R32G32B32_FLOAT,		1,	0,								D3D11_INPUT_PER_INSTANCE_DATA,	1}
+			};
+			hResult = m_d3d11Device->CreateInputLayout(inputElementDesc, 6, vertexShaderByteCode.data(), vertexShaderByteCode.size(), &shader.m_inputLayout);
 		}
 		else
 		{
@@ -740,10 +1243,6 @@ Shader* Renderer::CreateShader(char const* shaderName, char const* shaderSource,
 	{
 		ERROR_AND_DIE("Could not create an input layout for how our vertices are laid out in memory")
 	}
-
-	m_loadedShaders.push_back(shader);
-
-	return shader;
 }
 
 
@@ -778,17 +1277,11 @@ Shader* Renderer::CreateComputeShader(char const* shaderName)
 	shaderConfig.m_name = shaderName;
 
 	Shader* shader = new Shader(shaderConfig);
+	shader->m_renderer = this;
 
 	std::vector<unsigned char> computeShaderByteCode;
-	bool isComputeShaderCompiled = CompileShaderToByteCode(computeShaderByteCode, shaderName, shaderSource.c_str(), shaderConfig.m_computeShaderEntryPoint.c_str(), "cs_5_0");
-	if (isComputeShaderCompiled)
-	{
-		HRESULT hResult = m_d3d11Device->CreateComputeShader(computeShaderByteCode.data(), computeShaderByteCode.size(), NULL, &shader->m_computeShader);
-		if (!SUCCEEDED(hResult))
-		{
-			ERROR_AND_DIE("Could not create a Compute Shader")
-		}
-	}
+	CompileShaderToByteCode(computeShaderByteCode, shaderName, shaderSource.c_str(), shaderConfig.m_computeShaderEntryPoint.c_str(), "cs_5_0");
+	CreateComputeShaderStage(*shader, computeShaderByteCode);
 
 	m_loadedShaders.push_back(shader);
 
@@ -797,13 +1290,35 @@ Shader* Renderer::CreateComputeShader(char const* shaderName)
 
 
 //--------------------------------------------------------------------------------------------------
-bool Renderer::CompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target)
+void Renderer::CreateComputeShaderStage(Shader& shader, std::vector<unsigned char> const& computeShaderByteCode)
 {
-	unsigned int flags1 = D3DCOMPILE_OPTIMIZATION_LEVEL3;
-#if defined(ENGINE_DEBUG_RENDERER)
-	flags1 = D3DCOMPILE_SKIP_OPTIMIZATION | D3DCOMPILE_DEBUG | D3DCOMPILE_WARNINGS_ARE_ERRORS;
-#endif
+	HRESULT hResult = m_d3d11Device->CreateComputeShader(computeShaderByteCode.data(), computeShaderByteCode.size(), NULL, &shader.m_computeShader);
+	if (!SUCCEEDED(hResult))
+	{
+		ERROR_AND_DIE("Could not create a Compute Shader")
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Registered right away so CreateOrGetShader finds it and Shutdown frees it, the ShaderCompileQueue creates its stages later
+Shader* Renderer::CreatePendingShader(char const* shaderName, Shader* fallbackShader)
+{
+	ShaderConfig shaderConfig;
+	shaderConfig.m_name = shaderName;
+
+	Shader* shader				=	new Shader(shaderConfig);
+	shader->m_renderer			=	this;
+	shader->m_status			=	ShaderStatus::COMPILING;
+	shader->m_fallbackShader	=	fallbackShader;
+	m_loadedShaders.push_back(shader);
+	return shader;
+}
 
+
+//--------------------------------------------------------------------------------------------------
+static bool CompileHLSLToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target, unsigned int flags1)
+{
 	ID3DBlob* pointerToAccessCompiledCode = nullptr; 
 	ID3DBlob* pointerToAccessErrorMesg = nullptr;
 
@@ -822,8 +1337,13 @@ bool Renderer::CompileShaderToByteCode(std::vector<unsigned char>& outByteCode,
 
 	if (!SUCCEEDED(hResult))
 	{
-		DebuggerPrintf((char const*)pointerToAccessErrorMesg->GetBufferPointer());
-		ERROR_AND_DIE("Could not compile the HLSL shader source");
+		if (pointerToAccessErrorMesg)
+		{
+			DebuggerPrintf((char const*)pointerToAccessErrorMesg->GetBufferPointer());
+		}
+		DX_SAFE_RELEASE(pointerToAccessCompiledCode);
+		DX_SAFE_RELEASE(pointerToAccessErrorMesg);
+		return false;
 	}
 	outByteCode.resize(pointerToAccessCompiledCode->GetBufferSize());
 	memcpy(outByteCode.data(), pointerToAccessCompiledCode->GetBufferPointer(), pointerToAccessCompiledCode->GetBufferSize());
@@ -835,6 +1355,48 @@ bool Renderer::CompileShaderToByteCode(std::vector<unsigned char>& outByteCode,
 }
 
 
+//--------------------------------------------------------------------------------------------------
+bool Renderer::CompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target)
+{
+	if (!TryCompileShaderToByteCode(outByteCode, name, source, entryPoint, target))
+	{
+		ERROR_AND_DIE("Could not compile the HLSL shader source");
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Renderer::TryCompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target)
+{
+	unsigned int flags1 = D3DCOMPILE_OPTIMIZATION_LEVEL3;
+#if defined(ENGINE_DEBUG_RENDERER)
+	flags1 = D3DCOMPILE_SKIP_OPTIMIZATION | D3DCOMPILE_DEBUG | D3DCOMPILE_WARNINGS_ARE_ERRORS;
+#endif
+
+	// No include handler or defines are passed to D3DCompile, so the source is everything that goes in and nothing is included
+	ShaderCompileDesc compileDesc;
+	compileDesc.m_name				=	name;
+	compileDesc.m_source			=	source;
+	compileDesc.m_entryPoint		=	entryPoint;
+	compileDesc.m_target			=	target;
+	compileDesc.m_compileFlags		=	flags1;
+	compileDesc.m_compilerVersion	=	D3D_COMPILER_VERSION;
+	return m_shaderCache->GetOrCompile(compileDesc, [&](std::vector<unsigned char>& out_byteCode, std::vector<std::string>& out_includedFiles)
+	{
+		(void)out_includedFiles;
+		return CompileHLSLToByteCode(out_byteCode, name, source, entryPoint, target, flags1);
+	}, outByteCode);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ShaderCacheStats Renderer::GetShaderCacheStats() const
+{
+	return m_shaderCache->GetStats();
+}
+
+
 //--------------------------------------------------------------------------------------------------
 VertexBuffer* Renderer::CreateVertexBuffer(size_t const size)
 {
@@ -848,6 +1410,7 @@ VertexBuffer* Renderer::CreateVertexBuffer(size_t const size)
 
 	HRESULT hResult;
 	VertexBuffer* vertexBuffer = new VertexBuffer(size);
+	vertexBuffer->m_renderer = this;
 	hResult = m_d3d11Device->CreateBuffer(&vertexBufferDesc, NULL, &vertexBuffer->m_buffer); // The second parameter specifies the default initialization value, having it be NULL signifies only space is allocated and the values will be garbage
 	// hResult = m_d3d11Device->CreateBuffer(&vertexBufferDesc, NULL, &m_immediateVBO->m_buffer); // The second parameter specifies the default initialization value, having it be NULL signifies only space is allocated and the values will be garbage
 	if (!SUCCEEDED(hResult))
@@ -872,6 +1435,7 @@ VertexBuffer* Renderer::CreateVertexBuffer(size_t const size, unsigned int strid
 
 	HRESULT hResult;
 	VertexBuffer* vertexBuffer = new VertexBuffer(size, stride);
+	vertexBuffer->m_renderer = this;
 	hResult = m_d3d11Device->CreateBuffer(&vertexBufferDesc, NULL, &vertexBuffer->m_buffer); // The second parameter specifies the default initialization value, having it be NULL signifies only space is allocated and the values will be garbage
 	// hResult = m_d3d11Device->CreateBuffer(&vertexBufferDesc, NULL, &m_immediateVBO->m_buffer); // The second parameter specifies the default initialization value, having it be NULL signifies only space is allocated and the values will be garbage
 	if (!SUCCEEDED(hResult))
@@ -930,6 +1494,7 @@ VertexBuffer* Renderer::CreateVertexBuffer(size_t const size, unsigned int strid
 	initializationData.pSysMem = defaultInitializationData;
 
 	VertexBuffer* vertexBuffer = new VertexBuffer(vertexBufferSizeInBytes, stride);
+	vertexBuffer->m_renderer = this;
 	HRESULT hResult = m_d3d11Device->CreateBuffer(&vertexBufferDesc, &initializationData, &vertexBuffer->m_buffer);
 	GUARANTEE_OR_DIE(SUCCEEDED(hResult), "Could not create a vertex buffer");
 
@@ -1010,6 +1575,7 @@ IndexBuffer* Renderer::CreateIndexBuffer(size_t const size)
 
 	HRESULT hResult;
 	IndexBuffer* indexBuffer = new IndexBuffer(size);
+	indexBuffer->m_renderer = this;
 	hResult = m_d3d11Device->CreateBuffer(&indexBufferDesc, NULL, &indexBuffer->m_buffer); // The second parameter specifies the default initialization value, having it be NULL signifies only space is allocated and the values will be garbage
 	if (!SUCCEEDED(hResult))
 	{
@@ -1064,6 +1630,7 @@ IndexBuffer* Renderer::CreateIndexBuffer(size_t const size, ResourceUsage buffer
 	initializationData.pSysMem = defaultInitializationData;
 
 	IndexBuffer* indexBuffer = new IndexBuffer(indexBufferSizeInBytes);
+	indexBuffer->m_renderer = this;
 	HRESULT hResult = m_d3d11Device->CreateBuffer(&indexBufferDesc, &initializationData, &indexBuffer->m_buffer);
 	GUARANTEE_OR_DIE(SUCCEEDED(hResult), "Could not create an index buffer");
 
@@ -1358,19 +1925,15 @@ void Renderer::CopyCPUToGPU(void const* data, size_t size, VertexBuffer*& vbo)
 {
 	if (vbo->m_size < size)
 	{
-		int newStride = vbo->GetStride();
-		DX_SAFE_RELEASE(vbo->m_buffer);
-		vbo = CreateVertexBuffer(size, newStride);
-	}
-	// We now have Vertices(system memory) and a vertex buffer(video memory) to place them in, now all we are required to do is copy the vertices in-to the buffer
-	D3D11_MAPPED_SUBRESOURCE mappedSubresource;																	// Will be filled with all the imp info about the buffer including a pointer to the buffer's location
-	HRESULT hResult = m_d3d11DeviceContext->Map(vbo->m_buffer, NULL, D3D11_MAP_WRITE_DISCARD, NULL, &mappedSubresource);	// Maps the buffer(GPU is blocked from using this buffer), giving us access to it, map_write_discard clears the prev contents of the buffers, and opens the new buffer for writting
-	if (!SUCCEEDED(hResult))
-	{
-		ERROR_AND_DIE("Could not map the buffer");
+		// Recorded commands may still use the old buffer, deleting it only releases it after they are submitted
+		// Doubling keeps a buffer that is refilled with slowly growing data from being recreated every time
+		int		newStride	=	vbo->GetStride();
+		size_t	newSize		=	size > vbo->m_size * 2 ? size : vbo->m_size * 2;
+		delete vbo;
+		vbo = CreateVertexBuffer(newSize, newStride);
 	}
-	memcpy(mappedSubresource.pData, data, size);												// copies the contents from system memory to video memory
-	m_d3d11DeviceContext->Unmap(vbo->m_buffer, NULL);														// GPU regains access to the buffer, CPU losses access
+	// The vertices are copied into the command buffer and written to the buffer with a map write discard when the commands run
+	m_commandBuffer.UpdateBuffer(vbo->m_buffer, data, size);
 }
 
 
@@ -1379,24 +1942,20 @@ void Renderer::CopyCPUToGPU(void const* data, size_t size, IndexBuffer*& ibo)
 {
 	if (ibo->m_size < size)
 	{
-		DX_SAFE_RELEASE(ibo->m_buffer);
-		ibo = CreateIndexBuffer(size);
+		size_t newSize = size > ibo->m_size * 2 ? size : ibo->m_size * 2;
+		delete ibo;
+		ibo = CreateIndexBuffer(newSize);
 	}
-	// We now have Vertices(system memory) and a vertex buffer(video memory) to place them in, now all we are required to do is copy the vertices in-to the buffer
-	D3D11_MAPPED_SUBRESOURCE mappedSubresource;																	// Will be filled with all the imp info about the buffer including a pointer to the buffer's location
-	HRESULT hResult = m_d3d11DeviceContext->Map(ibo->m_buffer, NULL, D3D11_MAP_WRITE_DISCARD, NULL, &mappedSubresource);	// Maps the buffer(GPU is blocked from using this buffer), giving us access to it, map_write_discard clears the prev contents of the buffers, and opens the new buffer for writting
-	if (!SUCCEEDED(hResult))
-	{
-		ERROR_AND_DIE("Could not map the index buffer");
-	}
-	memcpy(mappedSubresource.pData, data, size);												// copies the contents from system memory to video memory
-	m_d3d11DeviceContext->Unmap(ibo->m_buffer, NULL);														// GPU regains access to the buffer, CPU losses access
+	m_commandBuffer.UpdateBuffer(ibo->m_buffer, data, size);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::CopyGPUToCPU(D3D11_Resource const* resourceToCopy, void*& out_data)
 {
+	// Reads back on the context directly, so everything recorded before it has to have run
+	FlushCommands();
+
 	D3D11_MAPPED_SUBRESOURCE mappedSubresource;
 	HRESULT hResult;
 	switch (resourceToCopy->m_resourceType)
@@ -1485,8 +2044,8 @@ void Renderer::BindVertexBuffer(VertexBuffer* vbo, PrimitiveTopology primitiveTo
 	unsigned int offset = 0;
 	// Set vertex buffers requires an offset from where to start in the buffer, the number of vertex buffers to be bound, pointer to the array of vertex buffers
 	// the strides of all the vertex buffers to be bound and the offset of all the vertex buffers
-	m_d3d11DeviceContext->IASetVertexBuffers(0, 1, &vbo->m_buffer, &vertexStride, &offset);
-	m_d3d11DeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(primitiveTopology));
+	m_commandBuffer.SetVertexBuffers(0, 1, ToRenderHandles(&vbo->m_buffer), &vertexStride, &offset);
+	m_commandBuffer.SetPrimitiveTopology(primitiveTopology);
 }
 
 
@@ -1510,14 +2069,14 @@ void Renderer::BindVertexBuffer(VertexBuffer* vbo, PrimitiveTopology primitiveTo
 // Binds the index buffer to the pipeline for the Input Assembler
 void Renderer::BindIndexBuffer(IndexBuffer* ibo)
 {
-	m_d3d11DeviceContext->IASetIndexBuffer(ibo->m_buffer, DXGI_FORMAT_R32_UINT, 0);
+	m_commandBuffer.SetIndexBuffer(ibo->m_buffer);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::BindIndexBuffer(D3D11_Buffer* ibo)
 {
-	m_d3d11DeviceContext->IASetIndexBuffer(ibo->m_buffer, DXGI_FORMAT_R32_UINT, 0);
+	m_commandBuffer.SetIndexBuffer(ibo->m_buffer);
 }
 
 
@@ -1529,8 +2088,8 @@ void Renderer::BindInstanceBuffer(D3D11_Buffer* instanceBuffer, D3D11_Buffer* ve
 		unsigned int vertexStride		=	instanceBuffer->GetElementSize();
 		unsigned int offset				=	0;
 
-		m_d3d11DeviceContext->IASetVertexBuffers(0, 1, &instanceBuffer->m_buffer, &vertexStride, &offset);
-		m_d3d11DeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(primitiveTopology));
+		m_commandBuffer.SetVertexBuffers(0, 1, ToRenderHandles(&instanceBuffer->m_buffer), &vertexStride, &offset);
+		m_commandBuffer.SetPrimitiveTopology(primitiveTopology);
 		return;
 	}
 
@@ -1539,8 +2098,8 @@ void Renderer::BindInstanceBuffer(D3D11_Buffer* instanceBuffer, D3D11_Buffer* ve
 	unsigned int vertexStrides[]	=	{ vertexBuffer->GetElementSize(), instanceBuffer->GetElementSize() };
 	unsigned int offsets[]			=	{ 0, 0 };
 
-	m_d3d11DeviceContext->IASetVertexBuffers(0, 2, vertexBuffers, vertexStrides, offsets);
-	m_d3d11DeviceContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY(primitiveTopology));
+	m_commandBuffer.SetVertexBuffers(0, 2, ToRenderHandles(vertexBuffers), vertexStrides, offsets);
+	m_commandBuffer.SetPrimitiveTopology(primitiveTopology);
 }
 
 
@@ -1556,6 +2115,7 @@ ConstantBuffer* Renderer::CreateConstantBuffer(size_t const size)
 
 	HRESULT hResult;
 	ConstantBuffer* constantBuffer = new ConstantBuffer(size);
+	constantBuffer->m_renderer = this;
 	hResult = m_d3d11Device->CreateBuffer(&constantBufferDesc, NULL, &constantBuffer->m_buffer);
 	if (!SUCCEEDED(hResult))
 	{
@@ -1593,6 +2153,7 @@ ConstantBuffer* Renderer::CreateConstantBuffer(unsigned int const& size, bool is
 	initializationData.pSysMem = defaultInitializationData;
 
 	ConstantBuffer* constantBuffer = new ConstantBuffer(size_t(size));
+	constantBuffer->m_renderer = this;
 	HRESULT hResult = m_d3d11Device->CreateBuffer(&constantBufferDesc, &initializationData, &constantBuffer->m_buffer);
 	GUARANTEE_OR_DIE(SUCCEEDED(hResult), "Something went wrong while creating a constant buffer");
 
@@ -1603,14 +2164,7 @@ ConstantBuffer* Renderer::CreateConstantBuffer(unsigned int const& size, bool is
 //--------------------------------------------------------------------------------------------------
 void Renderer::CopyCPUToGPU(void const* data, size_t size, ConstantBuffer*& cbo)
 {
-	D3D11_MAPPED_SUBRESOURCE mappedSubresource;
-	HRESULT hResult = m_d3d11DeviceContext->Map(cbo->m_buffer, NULL, D3D11_MAP_WRITE_DISCARD, NULL, &mappedSubresource);
-	if (!SUCCEEDED(hResult))
-	{
-		ERROR_AND_DIE("Could not map the constantBuffer");
-	}
-	memcpy(mappedSubresource.pData, data, size);
-	m_d3d11DeviceContext->Unmap(cbo->m_buffer, NULL);
+	m_commandBuffer.UpdateBuffer(cbo->m_buffer, data, size);
 }
 
 
@@ -1619,12 +2173,12 @@ void Renderer::BindConstantBuffer(int slot, ConstantBuffer* cbo, BindingLocation
 {
 	if (bindingLocation == BindingLocation::VERTEX_SHADER || bindingLocation == BindingLocation::PIXEL_SHADER)
 	{
-		m_d3d11DeviceContext->VSSetConstantBuffers(slot, 1, &cbo->m_buffer);
-		m_d3d11DeviceContext->PSSetConstantBuffers(slot, 1, &cbo->m_buffer);
+		m_commandBuffer.SetConstantBuffer(ShaderStage::VERTEX, slot, cbo->m_buffer);
+		m_commandBuffer.SetConstantBuffer(ShaderStage::PIXEL, slot, cbo->m_buffer);
 	}
 	if (bindingLocation == BindingLocation::COMPUTE_SHADER)
 	{
-		m_d3d11DeviceContext->CSSetConstantBuffers(slot, 1, &cbo->m_buffer);
+		m_commandBuffer.SetConstantBuffer(ShaderStage::COMPUTE, slot, cbo->m_buffer);
 	}
 }
 
@@ -1634,7 +2188,7 @@ void Renderer::DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, PrimitiveTop
 {
 	SetStatesIfChanged();
 	BindVertexBuffer(vbo, primitiveTopology);
-	m_d3d11DeviceContext->Draw(vertexCount, vertexOffset);
+	m_commandBuffer.Draw(vertexCount, vertexOffset);
 }
 
 
@@ -1645,7 +2199,7 @@ void Renderer::DrawVertexAndIndexBuffer(VertexBuffer* vbo, IndexBuffer* ibo, int
 	BindVertexBuffer(vbo);
 	BindIndexBuffer(ibo);
 
-	m_d3d11DeviceContext->DrawIndexed(indexCount, indexOffset, vertexOffset);
+	m_commandBuffer.DrawIndexed(indexCount, indexOffset, vertexOffset);
 }
 
 
@@ -1655,14 +2209,42 @@ void Renderer::DrawIndexedBuffer(IndexBuffer* ibo, VertexBuffer* vbo, unsigned i
 	SetStatesIfChanged();
 	BindVertexBuffer(vbo);
 	BindIndexBuffer(ibo);
-	m_d3d11DeviceContext->DrawIndexed(indexCount, indexOffset, vertexOffset);
+	m_commandBuffer.DrawIndexed(indexCount, indexOffset, vertexOffset);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::Draw(int vertexCount, int vertexOffset)
+{
+	m_commandBuffer.Draw(vertexCount, vertexOffset);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::DrawInstancedArray(int numOfInstances, void const* instances, unsigned int instanceStride, IndexBuffer* ibo, int numOfIndexesPerInstance)
+{
+	if (numOfInstances <= 0)
+	{
+		return;
+	}
+	uint32_t			numOfBytes	=	instanceStride * (uint32_t)numOfInstances;
+	TransientAllocation	allocation;
+	AllocateTransient(TransientBufferType::GEOMETRY, numOfBytes, TRANSIENT_VERTEX_ALIGNMENT, allocation);
+	memcpy(allocation.m_data, instances, numOfBytes);
+
+	SetStatesIfChanged();
+	RenderHandle transientBuffer = m_backend->GetTransientBuffer(TransientBufferType::GEOMETRY);
+	m_commandBuffer.SetVertexBuffers(0, 1, &transientBuffer, &instanceStride, &allocation.m_offset);
+	m_commandBuffer.SetPrimitiveTopology(PrimitiveTopology::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	m_commandBuffer.SetIndexBuffer(ibo->m_buffer);
+	m_commandBuffer.DrawIndexedInstanced(numOfIndexesPerInstance, numOfInstances);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::DrawIndexed(int indexCount, int indexOffset, int vertexOffset)
 {
-	m_d3d11DeviceContext->DrawIndexed(indexCount, indexOffset, vertexOffset);
+	m_commandBuffer.DrawIndexed(indexCount, indexOffset, vertexOffset);
 }
 
 
@@ -1672,14 +2254,19 @@ void Renderer::DrawIndexedInstanced(D3D11_Buffer* indexBuffer, D3D11_Buffer* ins
 	SetStatesIfChanged();
 	BindInstanceBuffer(instanceBuffer, vertexBuffer);
 	BindIndexBuffer(indexBuffer);
-	m_d3d11DeviceContext->DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
+	m_commandBuffer.DrawIndexedInstanced(indexCountPerInstance, instanceCount, startIndexLocation, baseVertexLocation, startInstanceLocation);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::ComputeShaderDispatch(unsigned int threadGroupX, unsigned int threadGroupY, unsigned int threadGroupZ)
 {
-	m_d3d11DeviceContext->Dispatch(threadGroupX, threadGroupY, threadGroupZ);
+	// A compute shader still compiling has nothing to fall back to, its pass is skipped until it is ready
+	if (!m_isBoundComputeShaderReady)
+	{
+		return;
+	}
+	m_commandBuffer.Dispatch(threadGroupX, threadGroupY, threadGroupZ);
 }
 
 
@@ -1691,6 +2278,10 @@ void Renderer::CreateUserDefinedDebugAnnotation()
 	{
 		return;
 	}
+	if (m_d3d11Backend)
+	{
+		m_d3d11Backend->SetDebugAnnotation(m_debugAnnotation);
+	}
 }
 
 
@@ -1959,10 +2550,8 @@ void Renderer::CreateBlendModes(BlendMode const* blendModes, unsigned short numO
 //--------------------------------------------------------------------------------------------------
 void Renderer::SetCustomBlendMode()
 {
-	float blendFactor[4]		=	{ 0 };
-	unsigned int sampleMask		=	0xffffffff;
 	m_desiredBlendMode			=	BlendMode::INVALID;
-	m_d3d11DeviceContext->OMSetBlendState(m_customBlendState, blendFactor, sampleMask);
+	m_commandBuffer.SetBlendState(m_customBlendState);
 	m_blendState = m_customBlendState;
 }
 
@@ -1988,46 +2577,98 @@ void Renderer::SetDepthMode(DepthMode depthMode)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+BlendMode Renderer::GetBlendMode() const
+{
+	return m_desiredBlendMode;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+SamplerMode Renderer::GetSamplerMode() const
+{
+	return m_desiredSamplerMode;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RasterizerMode Renderer::GetRasterizerMode() const
+{
+	return m_desiredRasterizedMode;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+DepthMode Renderer::GetDepthMode() const
+{
+	return m_desiredDepthMode;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void Renderer::SetStatesIfChanged()
 {
-	if (m_blendStates[int(m_desiredBlendMode)] != m_blendState)
+	// INVALID means the custom blend state, which SetCustomBlendMode has already bound
+	if (m_desiredBlendMode != BlendMode::INVALID && m_blendStates[int(m_desiredBlendMode)] != m_blendState)
 	{
-		m_blendState				=	m_desiredBlendMode != BlendMode::INVALID ? m_blendStates[int(m_desiredBlendMode)] : m_blendState;
-		float blendFactor[4]		=	{ 0 };
-		unsigned int sampleMask		=	0xffffffff;
-		m_d3d11DeviceContext->OMSetBlendState(m_blendState, blendFactor, sampleMask);
+		m_blendState				=	m_blendStates[int(m_desiredBlendMode)];
+		m_commandBuffer.SetBlendState(m_blendState);
 	}
 
 	if (m_samplerStates[int(m_desiredSamplerMode)] != m_d3d11SamplerState)
 	{
 		m_d3d11SamplerState = m_samplerStates[int(m_desiredSamplerMode)];
-		m_d3d11DeviceContext->PSSetSamplers(0, 1, &m_d3d11SamplerState);
-		m_d3d11DeviceContext->VSSetSamplers(0, 1, &m_d3d11SamplerState);
+		m_commandBuffer.SetSamplerState(ShaderStage::PIXEL, 0, m_d3d11SamplerState);
+		m_commandBuffer.SetSamplerState(ShaderStage::VERTEX, 0, m_d3d11SamplerState);
 	}
 
 	if (m_rasterizerStates[int(m_desiredRasterizedMode)] != m_d3d11RasterizeState)
 	{
 		m_d3d11RasterizeState = m_rasterizerStates[int(m_desiredRasterizedMode)];
-		m_d3d11DeviceContext->RSSetState(m_d3d11RasterizeState);
+		m_commandBuffer.SetRasterizerState(m_d3d11RasterizeState);
 	}
 
 	if (m_depthStencilStates[int(m_desiredDepthMode)] != m_depthStencilState)
 	{
 		m_depthStencilState = m_depthStencilStates[int(m_desiredDepthMode)];
-		m_d3d11DeviceContext->OMSetDepthStencilState(m_depthStencilState, 0);
+		m_commandBuffer.SetDepthStencilState(m_depthStencilState);
 	}
 }
 
 
+//--------------------------------------------------------------------------------------------------
+void Renderer::InvalidateStateCache()
+{
+	m_blendState			=	nullptr;
+	m_d3d11SamplerState		=	nullptr;
+	m_d3d11RasterizeState	=	nullptr;
+	m_depthStencilState		=	nullptr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void Renderer::SetModelConstants(Mat44 const& modelMatrix, Rgba8 const& modelColor)
 {
 	ModelConstants modelConstants;
 	modelConstants.modelMatrix = modelMatrix;
 	modelColor.GetAsFloats(modelConstants.modelColor);
-	CopyCPUToGPU(&modelConstants, sizeof(modelConstants), m_modelCBO);
-	BindConstantBuffer(s_modelConstantsSlot, m_modelCBO);
+	if (!m_backend->SupportsConstantBufferRanges())
+	{
+		CopyCPUToGPU(&modelConstants, sizeof(modelConstants), m_modelCBO);
+		BindConstantBuffer(s_modelConstantsSlot, m_modelCBO);
+		return;
+	}
+
+	// Each draw's constants get their own range instead of another write to the same buffer
+	TransientAllocation allocation;
+	AllocateTransient(TransientBufferType::CONSTANTS, TRANSIENT_CONSTANTS_RANGE_SIZE, TRANSIENT_CONSTANTS_RANGE_SIZE, allocation);
+	memcpy(allocation.m_data, &modelConstants, sizeof(modelConstants));
+
+	RenderHandle	transientBuffer		=	m_backend->GetTransientBuffer(TransientBufferType::CONSTANTS);
+	uint32_t		firstConstant		=	allocation.m_offset / 16;
+	uint32_t		numOfConstants		=	TRANSIENT_CONSTANTS_RANGE_SIZE / 16;
+	m_commandBuffer.SetConstantBuffer(ShaderStage::VERTEX, s_modelConstantsSlot, transientBuffer, firstConstant, numOfConstants);
+	m_commandBuffer.SetConstantBuffer(ShaderStage::PIXEL, s_modelConstantsSlot, transientBuffer, firstConstant, numOfConstants);
 }
 
 
@@ -2066,27 +2707,42 @@ void Renderer::SetLightAt(Light const& lightToSet, int indexToSet)
 //--------------------------------------------------------------------------------------------------
 void Renderer::SetCustomAnnotationMarker(wchar_t const* annotationText)
 {
-	m_debugAnnotation->SetMarker(annotationText);
+	m_commandBuffer.SetMarker(annotationText);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::BeginAnnotationEvent(wchar_t const* annotationText)
 {
-	int numOfAnnotationEventsStartedButNotEnded = m_debugAnnotation->BeginEvent(annotationText);
-
-	// redundant
-	if (numOfAnnotationEventsStartedButNotEnded == -1)
-	{
-		return;
-	}
+	m_commandBuffer.BeginEvent(annotationText);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::EndAnnotationEvent()
 {
-	m_debugAnnotation->EndEvent();
+	m_commandBuffer.EndEvent();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::BeginTimingScope(char const* name)
+{
+	m_renderProfiler->BeginScope(name, m_commandBuffer);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::EndTimingScope()
+{
+	m_renderProfiler->EndScope(m_commandBuffer);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RenderProfiler const& Renderer::GetRenderProfiler() const
+{
+	return *m_renderProfiler;
 }
 
 
@@ -2454,6 +3110,15 @@ void Renderer::CreateTextureFromConfig(TextureConfig const& config, Texture*& te
 //--------------------------------------------------------------------------------------------------
 void Renderer::CreateResourceFromConfig(D3D11_ResourceConfig& config, D3D11_Resource*& out_resource)
 {
+	out_resource = CreateUntrackedResource(config);
+	m_loadedResources.push_back(out_resource);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* Renderer::CreateUntrackedResource(D3D11_ResourceConfig const& config)
+{
+	D3D11_Resource* out_resource = nullptr;
 	HRESULT hResult;
 	switch (config.m_type)
 	{
@@ -2835,15 +3500,22 @@ void Renderer::CreateResourceFromConfig(D3D11_ResourceConfig& config, D3D11_Reso
 	{
 		SetDebugResourceName(out_resource, config.m_debugNameSize, config.m_debugName);
 	}
-	m_loadedResources.push_back(out_resource);
+	return out_resource;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 D3D11_Resource* Renderer::CreateTextureResourceFromFile(char const* imageFilePath, char const* debugResourceName /*= nullptr*/, unsigned int debugResourceNameSize /*= 0*/)
 {
-	Image* newImage = new Image(imageFilePath);
-	IntVec2 textureDim = newImage->GetDimensions();
+	Image newImage(imageFilePath);
+	return CreateTextureResourceFromImage(newImage, debugResourceName, debugResourceNameSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* Renderer::CreateTextureResourceFromImage(Image const& image, char const* debugResourceName /*= nullptr*/, unsigned int debugResourceNameSize /*= 0*/)
+{
+	IntVec2 textureDim = image.GetDimensions();
 
 	D3D11_ResourceConfig textureResourceConfig			=	{ };
 	textureResourceConfig.m_type						=	ResourceType::TEXTURE2D;
@@ -2852,11 +3524,12 @@ D3D11_Resource* Renderer::CreateTextureResourceFromFile(char const* imageFilePat
 	textureResourceConfig.m_height						=	textureDim.y;
 	textureResourceConfig.m_bindFlags					=	ResourceBindFlag::SHADER_RESOURCE;
 	textureResourceConfig.m_usageFlag					=	ResourceUsage::GPU_READ;
-	textureResourceConfig.m_defaultInitializationData	=	(void*)newImage->GetRawData();
+	textureResourceConfig.m_defaultInitializationData	=	(void*)image.GetRawData();
 	textureResourceConfig.m_sizeOfTexelInBytes			=	4;
 	textureResourceConfig.m_debugName					=	debugResourceName;
 	textureResourceConfig.m_debugNameSize				=	debugResourceNameSize;
 
+	// The initial data is copied into the resource, the image can go away right after
 	D3D11_Resource* newTextureResource = nullptr;
 	CreateResourceFromConfig(textureResourceConfig, newTextureResource);
 	return newTextureResource;
@@ -2868,7 +3541,7 @@ D3D11_Resource* Renderer::CreateTextureResourceFromFile(char const* imageFilePat
 // Quick Hack, Ensure the directory name follows the naming convention:
 // The name should end with an underscore followed by an extension, e.g., "skybox_png".
 // Example valid names: "skybox_png", "textures_jpg"
-D3D11_Resource* Renderer::CreateTextureCubeResourceFromFile(char const* cubeMapDir, char const* debugResourceName /*= nullptr*/, unsigned int debugResourceNameSize /*= 0*/)
+void Renderer::GetTextureCubeFaceFilePaths(char const* cubeMapDir, std::string* out_faceFilePaths)
 {
 	// Fetch extension
 	char const* ext = strchr(cubeMapDir, '_');
@@ -2877,22 +3550,41 @@ D3D11_Resource* Renderer::CreateTextureCubeResourceFromFile(char const* cubeMapD
 	std::string extension = std::string(ext, 0, 3);
 
 	std::string cubeMapTextureNamesWithoutExt[6] = { "XPos", "XNeg", "YPos", "YNeg", "ZPos", "ZNeg" };
-	D3D11_SUBRESOURCE_DATA cubeMapInitData[6];
-	IntVec2 textureDim;
 	for (uint8_t textureIndex = 0; textureIndex < 6; ++textureIndex)
 	{
 		// Concatenate directory, texture name and extension
-		std::string currentTextureFilePath		=	cubeMapDir + cubeMapTextureNamesWithoutExt[textureIndex] + "." + extension;
-		
-		// Load texture and populate subresource data
-		Image* currentTexture							=	new Image(currentTextureFilePath.c_str());	// Memory leak
-		cubeMapInitData[textureIndex].pSysMem			=	currentTexture->GetRawData();
-		cubeMapInitData[textureIndex].SysMemPitch		=	currentTexture->GetDimensions().x * 4;		// Pitch, width * bytesPerTexel
+		out_faceFilePaths[textureIndex] = cubeMapDir + cubeMapTextureNamesWithoutExt[textureIndex] + "." + extension;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* Renderer::CreateTextureCubeResourceFromFile(char const* cubeMapDir, char const* debugResourceName /*= nullptr*/, unsigned int debugResourceNameSize /*= 0*/)
+{
+	std::string faceFilePaths[6];
+	GetTextureCubeFaceFilePaths(cubeMapDir, faceFilePaths);
+
+	Image faceImages[6];
+	for (uint8_t textureIndex = 0; textureIndex < 6; ++textureIndex)
+	{
+		faceImages[textureIndex] = Image(faceFilePaths[textureIndex].c_str());
+	}
+	return CreateTextureCubeResourceFromImages(faceImages, debugResourceName, debugResourceNameSize);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* Renderer::CreateTextureCubeResourceFromImages(Image const* faceImages, char const* debugResourceName /*= nullptr*/, unsigned int debugResourceNameSize /*= 0*/)
+{
+	D3D11_SUBRESOURCE_DATA cubeMapInitData[6];
+	IntVec2 textureDim = faceImages[0].GetDimensions();
+	for (uint8_t textureIndex = 0; textureIndex < 6; ++textureIndex)
+	{
+		Image const& currentTexture						=	faceImages[textureIndex];
+		GUARANTEE_OR_DIE(currentTexture.GetDimensions() == textureDim, Stringf("Cube map face \"%s\" does not match the size of the other faces", currentTexture.GetImageFilePath().c_str()));
+		cubeMapInitData[textureIndex].pSysMem			=	currentTexture.GetRawData();
+		cubeMapInitData[textureIndex].SysMemPitch		=	currentTexture.GetDimensions().x * 4;		// Pitch, width * bytesPerTexel
 		cubeMapInitData[textureIndex].SysMemSlicePitch	=	0;											// Ignore
-		if (textureDim == IntVec2())
-		{
-			textureDim = currentTexture->GetDimensions();
-		}
 	}
 
 	// Populate texture cube resource config
@@ -2947,26 +3639,95 @@ D3D11_Resource* Renderer::CreateTextureCubeResourceFromFile(char const* cubeMapD
 //--------------------------------------------------------------------------------------------------
 void Renderer::CreateDepthResource(D3D11_Resource*& depthResource, char const* debugResourceName /*= "None"*/, unsigned int debugResourceNameSize /*= 0*/, bool canBeReadOnly /*= false*/, IntVec2 const& textureDims /*= IntVec2(-1, -1)*/)
 {
-	D3D11_ResourceConfig depthResourceConfig	=	{ };
+	D3D11_ResourceConfig depthResourceConfig	=	GetDepthResourceConfig(canBeReadOnly, textureDims);
 	depthResourceConfig.m_debugName				=	debugResourceName;
 	depthResourceConfig.m_debugNameSize			=	debugResourceNameSize;
+	CreateResourceFromConfig(depthResourceConfig, depthResource);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::CreateRenderTargetResource(D3D11_Resource*& renderTargetResource, bool isWritable, char const* debugResourceName /*= nullptr*/, unsigned int debugResourceNameSize /*= 0*/, IntVec2 const& textureDims /*= IntVec2(-1, -1)*/)
+{
+	D3D11_ResourceConfig renderTargetResourceConfig		=	GetRenderTargetResourceConfig(isWritable, textureDims);
+	renderTargetResourceConfig.m_debugName				=	debugResourceName;
+	renderTargetResourceConfig.m_debugNameSize			=	debugResourceNameSize;
+	CreateResourceFromConfig(renderTargetResourceConfig, renderTargetResource);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::DestroyResource(D3D11_Resource*& resource)
+{
+	for (size_t resourceIndex = 0; resourceIndex < m_loadedResources.size(); ++resourceIndex)
+	{
+		if (m_loadedResources[resourceIndex] == resource)
+		{
+			m_loadedResources.erase(m_loadedResources.begin() + resourceIndex);
+			m_retiredResources.push_back({ resource, m_numOfFramesSignaled + 1 });
+			resource = nullptr;
+			return;
+		}
+	}
+	ERROR_AND_DIE("Destroying a resource the renderer did not create, pooled resources go back with ReleasePooledResource");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_Resource* Renderer::AcquirePooledResource(D3D11_ResourceConfig const& config)
+{
+	D3D11_ResourceConfig resolvedConfig = config;
+	bool isTexture = config.m_type != ResourceType::STRUCTURED_BUFFER && config.m_type != ResourceType::RAW_BUFFER;
+	if (isTexture && (config.m_width == (unsigned int)-1 || config.m_height == (unsigned int)-1))
+	{
+		IntVec2 windowDim		=	m_config.m_window->GetClientDimensions();
+		resolvedConfig.m_width	=	windowDim.x;
+		resolvedConfig.m_height	=	windowDim.y;
+	}
+	return m_resourcePool->Acquire(resolvedConfig);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::ReleasePooledResource(D3D11_Resource*& resource)
+{
+	m_resourcePool->Release(resource);
+	resource = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Renderer::ReleaseIdlePooledResources()
+{
+	m_resourcePool->ReleaseIdleResources();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ResourcePoolStats const& Renderer::GetResourcePoolStats() const
+{
+	return m_resourcePool->GetStats();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+D3D11_ResourceConfig Renderer::GetDepthResourceConfig(bool canBeReadOnly /*= false*/, IntVec2 const& textureDims /*= IntVec2(-1, -1)*/)
+{
+	D3D11_ResourceConfig depthResourceConfig	=	{ };
 	depthResourceConfig.m_width					=	textureDims.x;
 	depthResourceConfig.m_height				=	textureDims.y;
 	depthResourceConfig.m_bindFlags				=	ResourceBindFlag((unsigned char)ResourceBindFlag::DEPTH_STENCIL | (unsigned char)ResourceBindFlag::SHADER_RESOURCE);
 	depthResourceConfig.m_usageFlag				=	ResourceUsage::GPU_READ_GPU_WRITE;
 	depthResourceConfig.m_format				=	ResourceViewFormat::DXGI_FORMAT_R32_TYPELESS;
 	depthResourceConfig.m_canDepthBeReadOnly	=	canBeReadOnly;
-
-	CreateResourceFromConfig(depthResourceConfig, depthResource);
+	return depthResourceConfig;
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::CreateRenderTargetResource(D3D11_Resource*& renderTargetResource, bool isWritable, char const* debugResourceName /*= nullptr*/, unsigned int debugResourceNameSize /*= 0*/, IntVec2 const& textureDims /*= IntVec2(-1, -1)*/)
+D3D11_ResourceConfig Renderer::GetRenderTargetResourceConfig(bool isWritable, IntVec2 const& textureDims /*= IntVec2(-1, -1)*/)
 {
 	D3D11_ResourceConfig renderTargetResourceConfig		=	{ };
-	renderTargetResourceConfig.m_debugName				=	debugResourceName;
-	renderTargetResourceConfig.m_debugNameSize			=	debugResourceNameSize;
 	renderTargetResourceConfig.m_width					=	textureDims.x;
 	renderTargetResourceConfig.m_height					=	textureDims.y;
 	renderTargetResourceConfig.m_bindFlags				=	ResourceBindFlag((unsigned char)ResourceBindFlag::RENDER_TARGET | (unsigned char)ResourceBindFlag::SHADER_RESOURCE);
@@ -2977,8 +3738,7 @@ void Renderer::CreateRenderTargetResource(D3D11_Resource*& renderTargetResource,
 	{
 		renderTargetResourceConfig.m_bindFlags = ResourceBindFlag((unsigned char)(renderTargetResourceConfig.m_bindFlags) | (unsigned char)ResourceBindFlag::UNORDERED_ACCESS);
 	}
-
-	CreateResourceFromConfig(renderTargetResourceConfig, renderTargetResource);
+	return renderTargetResourceConfig;
 }
 
 
@@ -2987,10 +3747,10 @@ void Renderer::BindRenderTargetOnly(Texture* renderTarget)
 {
 	if (!renderTarget)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargets(1, &m_renderTargetView, nullptr);
+		m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&m_renderTargetView), nullptr);
 		return;
 	}
-	m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTarget->m_renderTargetView, nullptr);
+	m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTarget->m_renderTargetView), nullptr);
 }
 
 
@@ -3016,38 +3776,38 @@ void Renderer::BindRenderAndDepthTargetViewsToThePipeline(Texture* renderTexture
 		uavs[0]							=	buffer->m_unorderedAccessView;
 		appendConsumeBufferOffsets[0]	=	(unsigned int)-1;
 
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, 1, 1, uavs.data(), appendConsumeBufferOffsets.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, 1, 1, ToRenderHandles(uavs.data()), appendConsumeBufferOffsets.data());
 	}
 	else if (!renderTexture && !depthTexture)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+		m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&m_renderTargetView), m_depthStencilView);
 		viewport.Width		=	clientWidth;
 		viewport.Height		=	clientHeight;
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+		SetViewport(m_commandBuffer, viewport);
 	}
 	else if (!renderTexture && depthTexture)
 	{
 		IntVec2 const& depthTextureDims		=	depthTexture->GetDimensions();
 		viewport.Width						=	float(depthTextureDims.x);
 		viewport.Height						=	float(depthTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
-		m_d3d11DeviceContext->OMSetRenderTargets(0, nullptr, depthTexture->m_depthStencilView);
+		SetViewport(m_commandBuffer, viewport);
+		m_commandBuffer.SetRenderTargets(0, nullptr, depthTexture->m_depthStencilView);
 	}
 	else if (renderTexture && !depthTexture)
 	{
 		IntVec2 const& renderTextureDims	=	renderTexture->GetDimensions();
 		viewport.Width						=	float(renderTextureDims.x);
 		viewport.Height						=	float(renderTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
-		m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTexture->m_renderTargetView, nullptr);
+		SetViewport(m_commandBuffer, viewport);
+		m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTexture->m_renderTargetView), nullptr);
 	}
 	else if (renderTexture && depthTexture)
 	{
 		IntVec2 const& renderTargetTextureDims	=	renderTexture->GetDimensions();
 		viewport.Width							=	float(renderTargetTextureDims.x);
 		viewport.Height							=	float(renderTargetTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
-		m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTexture->m_renderTargetView, depthTexture->m_depthStencilView);
+		SetViewport(m_commandBuffer, viewport);
+		m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTexture->m_renderTargetView), depthTexture->m_depthStencilView);
 	}
 }
 
@@ -3064,15 +3824,15 @@ void Renderer::BindRenderAndDepthTargetViewsToThePipeline(unsigned int numOfRend
 
 	if (depthTarget)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargets(numOfRenderTargetViews, renderTargetViews.data(), depthTarget->m_depthStencilView);
+		m_commandBuffer.SetRenderTargets(numOfRenderTargetViews, ToRenderHandles(renderTargetViews.data()), depthTarget->m_depthStencilView);
 		if (isDepthReadOnly)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(numOfRenderTargetViews, renderTargetViews.data(), depthTarget->m_readOnlyDepthStencilView);
+			m_commandBuffer.SetRenderTargets(numOfRenderTargetViews, ToRenderHandles(renderTargetViews.data()), depthTarget->m_readOnlyDepthStencilView);
 		}
 		return;
 	}
 
-	m_d3d11DeviceContext->OMSetRenderTargets(numOfRenderTargetViews, renderTargetViews.data(), nullptr);
+	m_commandBuffer.SetRenderTargets(numOfRenderTargetViews, ToRenderHandles(renderTargetViews.data()), nullptr);
 }
 
 
@@ -3090,24 +3850,24 @@ void Renderer::BindRenderAndDepthTargetViews(Texture* renderTarget /*= nullptr*/
 
 	if (!renderTarget && !depthStencil)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+		m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&m_renderTargetView), m_depthStencilView);
 		viewport.Width		=	clientWidth;
 		viewport.Height		=	clientHeight;
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+		SetViewport(m_commandBuffer, viewport);
 	}
 	else if (!renderTarget && depthStencil)
 	{
 		IntVec2 const& depthTextureDims		=	depthStencil->GetDimensions();
 		viewport.Width						=	float(depthTextureDims.x);
 		viewport.Height						=	float(depthTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+		SetViewport(m_commandBuffer, viewport);
 		if (!isDepthReadOnly)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(0, nullptr, depthStencil->m_depthStencilView);
+			m_commandBuffer.SetRenderTargets(0, nullptr, depthStencil->m_depthStencilView);
 		}
 		else
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(0, nullptr, depthStencil->m_readOnlyDepthStencilView);
+			m_commandBuffer.SetRenderTargets(0, nullptr, depthStencil->m_readOnlyDepthStencilView);
 		}
 	}
 	else if (renderTarget && !depthStencil)
@@ -3115,22 +3875,22 @@ void Renderer::BindRenderAndDepthTargetViews(Texture* renderTarget /*= nullptr*/
 		IntVec2 const& renderTextureDims	=	renderTarget->GetDimensions();
 		viewport.Width						=	float(renderTextureDims.x);
 		viewport.Height						=	float(renderTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
-		m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTarget->m_renderTargetView, nullptr);
+		SetViewport(m_commandBuffer, viewport);
+		m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTarget->m_renderTargetView), nullptr);
 	}
 	else if (renderTarget && depthStencil)
 	{
 		IntVec2 const& renderTargetTextureDims	=	renderTarget->GetDimensions();
 		viewport.Width							=	float(renderTargetTextureDims.x);
 		viewport.Height							=	float(renderTargetTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+		SetViewport(m_commandBuffer, viewport);
 		if (!isDepthReadOnly)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTarget->m_renderTargetView, depthStencil->m_depthStencilView);
+			m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTarget->m_renderTargetView), depthStencil->m_depthStencilView);
 		}
 		else
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTarget->m_renderTargetView, depthStencil->m_readOnlyDepthStencilView);
+			m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTarget->m_renderTargetView), depthStencil->m_readOnlyDepthStencilView);
 		}
 	}
 }
@@ -3150,15 +3910,15 @@ void Renderer::BindRenderAndDepthResources(D3D11_Resource* renderTarget /*= null
 	{
 		viewport.Width		=	clientWidth;
 		viewport.Height		=	clientHeight;
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+		SetViewport(m_commandBuffer, viewport);
 
 		if (!bindDefault)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(0, 0, 0);
+			m_commandBuffer.SetRenderTargets(0, nullptr, nullptr);
 		}
 		else
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(1, &m_renderTargetView, m_depthStencilView);
+			m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&m_renderTargetView), m_depthStencilView);
 		}
 	}
 	else if (!renderTarget && depthResource)
@@ -3167,14 +3927,14 @@ void Renderer::BindRenderAndDepthResources(D3D11_Resource* renderTarget /*= null
 		IntVec2 const& depthTextureDims		=	IntVec2(textureDims.x, textureDims.y);
 		viewport.Width						=	float(depthTextureDims.x);
 		viewport.Height						=	float(depthTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+		SetViewport(m_commandBuffer, viewport);
 		if (!isDepthReadOnly)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(0, nullptr, depthResource->m_depthStencilView);
+			m_commandBuffer.SetRenderTargets(0, nullptr, depthResource->m_depthStencilView);
 		}
 		else
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(0, nullptr, depthResource->m_readOnlyDepthStencilView);
+			m_commandBuffer.SetRenderTargets(0, nullptr, depthResource->m_readOnlyDepthStencilView);
 		}
 	}
 	else if (renderTarget && !depthResource)
@@ -3183,8 +3943,8 @@ void Renderer::BindRenderAndDepthResources(D3D11_Resource* renderTarget /*= null
 		IntVec2 const& renderTextureDims	=	IntVec2(textureDims.x, textureDims.y);
 		viewport.Width						=	float(renderTextureDims.x);
 		viewport.Height						=	float(renderTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
-		m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTarget->m_renderTargetView, nullptr);
+		SetViewport(m_commandBuffer, viewport);
+		m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTarget->m_renderTargetView), nullptr);
 	}
 	else if (renderTarget && depthResource)
 	{
@@ -3192,14 +3952,14 @@ void Renderer::BindRenderAndDepthResources(D3D11_Resource* renderTarget /*= null
 		IntVec2 const& renderTextureDims	=	IntVec2(textureDims.x, textureDims.y);
 		viewport.Width						=	float(renderTextureDims.x);
 		viewport.Height						=	float(renderTextureDims.y);
-		m_d3d11DeviceContext->RSSetViewports(1, &viewport);
+		SetViewport(m_commandBuffer, viewport);
 		if (!isDepthReadOnly)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTarget->m_renderTargetView, depthResource->m_depthStencilView);
+			m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTarget->m_renderTargetView), depthResource->m_depthStencilView);
 		}
 		else
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(1, &renderTarget->m_renderTargetView, depthResource->m_readOnlyDepthStencilView);
+			m_commandBuffer.SetRenderTargets(1, ToRenderHandles(&renderTarget->m_renderTargetView), depthResource->m_readOnlyDepthStencilView);
 		}
 	}
 }
@@ -3219,21 +3979,21 @@ void Renderer::BindRenderAndDepthResources(unsigned int numOfRenderTargetViews,
 	{
 		if (isDepthReadOnly)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargets(numOfRenderTargetViews, renderTargetViews.data(), depthTarget->m_readOnlyDepthStencilView);
+			m_commandBuffer.SetRenderTargets(numOfRenderTargetViews, ToRenderHandles(renderTargetViews.data()), depthTarget->m_readOnlyDepthStencilView);
 			return;
 		}
-		m_d3d11DeviceContext->OMSetRenderTargets(numOfRenderTargetViews, renderTargetViews.data(), depthTarget->m_depthStencilView);
+		m_commandBuffer.SetRenderTargets(numOfRenderTargetViews, ToRenderHandles(renderTargetViews.data()), depthTarget->m_depthStencilView);
 		return;
 	}
 
-	m_d3d11DeviceContext->OMSetRenderTargets(numOfRenderTargetViews, renderTargetViews.data(), nullptr);
+	m_commandBuffer.SetRenderTargets(numOfRenderTargetViews, ToRenderHandles(renderTargetViews.data()), nullptr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Renderer::UnbindRenderAndDepthTargets()
 {
-	m_d3d11DeviceContext->OMSetRenderTargets(0, 0, 0);
+	m_commandBuffer.SetRenderTargets(0, nullptr, nullptr);
 }
 
 
@@ -3265,7 +4025,7 @@ void Renderer::BindWritableBuffersToThePipeline(D3D11_Buffer* const* writableBuf
 
 		if (writableBuffers == nullptr)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(1, currentArrayOfRenderTargets, *currentArrayOfDepthStencilViews, uavStartSlot, numOfUAVs, emptyUAVs.data(), appendConsumeBufferOffsets.data());
+			m_commandBuffer.SetRenderTargetsAndUAVs(1, ToRenderHandles(currentArrayOfRenderTargets), *currentArrayOfDepthStencilViews, uavStartSlot, numOfUAVs, ToRenderHandles(emptyUAVs.data()), appendConsumeBufferOffsets.data());
 			return;
 		}
 
@@ -3277,13 +4037,13 @@ void Renderer::BindWritableBuffersToThePipeline(D3D11_Buffer* const* writableBuf
 		}
 
 
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(1, currentArrayOfRenderTargets, *currentArrayOfDepthStencilViews, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffsets.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(1, ToRenderHandles(currentArrayOfRenderTargets), *currentArrayOfDepthStencilViews, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffsets.data());
 		return;
 	}
 
 	if (writableBuffers == nullptr)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, numOfUAVs, emptyUAVs.data(), appendConsumeBufferOffsets.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(emptyUAVs.data()), appendConsumeBufferOffsets.data());
 		return;
 	}
 
@@ -3295,8 +4055,8 @@ void Renderer::BindWritableBuffersToThePipeline(D3D11_Buffer* const* writableBuf
 	}
 
 
-	m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffsets.data());
-	m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffsets.data());
+	m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffsets.data());
+	m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffsets.data());
 }
 
 
@@ -3306,12 +4066,12 @@ void Renderer::BindWritableBufferToThePipeline(D3D11_Buffer* writableBuffer, uns
 	unsigned int appendConsumeBufferOffset[1] = { 0 };
 	if (writableBuffer)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, 1, &writableBuffer->m_unorderedAccessView, appendConsumeBufferOffset);
+		m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, 1, ToRenderHandles(&writableBuffer->m_unorderedAccessView), appendConsumeBufferOffset);
 		return;
 	}
 	std::vector<ID3D11UnorderedAccessView*> emptyUAVs;
 	emptyUAVs.resize(1, NULL);
-	m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, 1, emptyUAVs.data(), appendConsumeBufferOffset);
+	m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, 1, ToRenderHandles(emptyUAVs.data()), appendConsumeBufferOffset);
 }
 
 
@@ -3323,11 +4083,11 @@ void Renderer::BindReadOnlyBufferToThePipeleine(D3D11_Buffer* readableBuffer, un
 	startOffset = 0;
 	if (readableBuffer)
 	{
-		m_d3d11DeviceContext->CSSetShaderResources(startSlot, 1, &readableBuffer->m_shaderResourceView);
+		m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, 1, ToRenderHandles(&readableBuffer->m_shaderResourceView));
 		return;
 	}
 	ID3D11ShaderResourceView* emptySRV[1] = { NULL };
-	m_d3d11DeviceContext->CSSetShaderResources(startSlot, 1, emptySRV);
+	m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, 1, ToRenderHandles(emptySRV));
 }
 
 
@@ -3339,11 +4099,11 @@ void Renderer::BindWritableBufferToTheComputeShader(D3D11_Buffer* writableBuffer
 	startOffset		=	0;
 	if (writableBuffer)
 	{
-		m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, 1, &writableBuffer->m_unorderedAccessView, nullptr);
+		m_commandBuffer.SetUnorderedAccessViews(startSlot, 1, ToRenderHandles(&writableBuffer->m_unorderedAccessView), nullptr);
 		return;
 	}
 	ID3D11UnorderedAccessView* emptyUAV[1] = { NULL };
-	m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, 1, emptyUAV, NULL);
+	m_commandBuffer.SetUnorderedAccessViews(startSlot, 1, ToRenderHandles(emptyUAV), nullptr);
 }
 
 
@@ -3354,11 +4114,11 @@ void Renderer::BindWritableTextureToTheComputeShader(Texture* writableTexture, u
 	startOffset		=	0;
 	if (writableTexture)
 	{
-		m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, 1, &writableTexture->m_unorderedAccessView, nullptr);
+		m_commandBuffer.SetUnorderedAccessViews(startSlot, 1, ToRenderHandles(&writableTexture->m_unorderedAccessView), nullptr);
 		return;
 	}
 	ID3D11UnorderedAccessView* emptyUAV[1] = { NULL };
-	m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, 1, emptyUAV, NULL);
+	m_commandBuffer.SetUnorderedAccessViews(startSlot, 1, ToRenderHandles(emptyUAV), nullptr);
 }
 
 
@@ -3377,7 +4137,7 @@ void Renderer::BindWritableBuffersToTheComputeShader(D3D11_Buffer* const* writab
 		uavs[uavIndex]							=	writableBuffers[uavIndex]->m_unorderedAccessView;
 		appendConsumeBufferOffsets[uavIndex]	=	(unsigned int)0;
 	}
-	m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffsets.data());
+	m_commandBuffer.SetUnorderedAccessViews(startSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffsets.data());
 }
 
 
@@ -3397,7 +4157,7 @@ void Renderer::BindWritableTexturesToTheComputeShader(Texture* const* writableTe
 		uavs[uavIndex]							=	writableTextures[uavIndex]->m_unorderedAccessView;
 		appendConsumeBufferOffsets[uavIndex]	=	(unsigned int)0;
 	}
-	m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, numOfUAVs, uavs.data(), appendConsumeOffsets);
+	m_commandBuffer.SetUnorderedAccessViews(startSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeOffsets);
 }
 
 
@@ -3416,7 +4176,7 @@ void Renderer::BindWritableResourcesToComputeShader(D3D11_Resource* const* writa
 		uavs.emplace_back(writableResources[uavIndex]->m_unorderedAccessView);
 		appendConsumeBufferOffsets.emplace_back((unsigned int)0);
 	}
-	m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, numOfUAVs, uavs.data(), appendConsumeOffsets);
+	m_commandBuffer.SetUnorderedAccessViews(startSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeOffsets);
 }
 
 
@@ -3429,7 +4189,7 @@ void Renderer::BindReadableBuffersToTheComputeShader(D3D11_Buffer* const* readOn
 	{
 		srvs[srvIndex] = readOnlyBuffers[srvIndex]->m_shaderResourceView;
 	}
-	m_d3d11DeviceContext->CSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+	m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 }
 
 
@@ -3455,17 +4215,17 @@ void Renderer::BindReadableResources(D3D11_Resource* const* readableResourcesToB
 	{
 		case BindingLocation::VERTEX_SHADER:
 		{
-			m_d3d11DeviceContext->VSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+			m_commandBuffer.SetShaderResources(ShaderStage::VERTEX, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 			break;
 		}
 		case BindingLocation::PIXEL_SHADER:
 		{
-			m_d3d11DeviceContext->PSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+			m_commandBuffer.SetShaderResources(ShaderStage::PIXEL, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 			break;
 		}
 		case BindingLocation::COMPUTE_SHADER:
 		{
-			m_d3d11DeviceContext->CSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+			m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 			break;
 		}
 		default:
@@ -3486,7 +4246,7 @@ void Renderer::BindReadableTexturesToTheComputeShader(Texture* const* readableTe
 	{
 		srvs[srvIndex] = readableTextures[srvIndex]->m_shaderResourceView;
 	}
-	m_d3d11DeviceContext->CSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+	m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 }
 
 
@@ -3504,17 +4264,17 @@ void Renderer::BindReadableTexture(Texture* const* readableTextures, unsigned in
 	{
 	case BindingLocation::VERTEX_SHADER:
 	{
-		m_d3d11DeviceContext->VSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::VERTEX, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	case BindingLocation::PIXEL_SHADER:
 	{
-		m_d3d11DeviceContext->PSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::PIXEL, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	case BindingLocation::COMPUTE_SHADER:
 	{
-		m_d3d11DeviceContext->CSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	default:
@@ -3538,14 +4298,14 @@ void Renderer::BindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned in
 
 	if (!numOfRenderTargets)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 		return;
 	}
 
 	ID3D11DepthStencilView* depthStencilView = !depthTexture ? m_depthStencilView : depthTexture->m_depthStencilView;
 	if (renderTargets == nullptr)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(1, &m_renderTargetView, depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(1, ToRenderHandles(&m_renderTargetView), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 		return;
 	}
 
@@ -3565,12 +4325,12 @@ void Renderer::BindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned in
 	if (!isDepthReadOnly)
 	{
 		depthStencilView = !depthTexture ? m_depthStencilView : depthTexture->m_depthStencilView;
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(numOfRenderTargets, renderTargetViews.data(), depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(numOfRenderTargets, ToRenderHandles(renderTargetViews.data()), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 	}
 	else
 	{
 		depthStencilView = !depthTexture ? m_depthStencilView : depthTexture->m_readOnlyDepthStencilView; 
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(numOfRenderTargets, renderTargetViews.data(), depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(numOfRenderTargets, ToRenderHandles(renderTargetViews.data()), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 	}
 }
 
@@ -3590,14 +4350,14 @@ void Renderer::BindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned in
 
 	if (!numOfRenderTargets)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 		return;
 	}
 
 	ID3D11DepthStencilView* depthStencilView = !depthTexture ? m_depthStencilView : depthTexture->m_depthStencilView;
 	if (renderTargets == nullptr)
 	{
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(1, &m_renderTargetView, depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(1, ToRenderHandles(&m_renderTargetView), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 		return;
 	}
 
@@ -3617,12 +4377,12 @@ void Renderer::BindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned in
 	if (!isDepthReadOnly)
 	{
 		depthStencilView = !depthTexture ? m_depthStencilView : depthTexture->m_depthStencilView;
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(numOfRenderTargets, renderTargetViews.data(), depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(numOfRenderTargets, ToRenderHandles(renderTargetViews.data()), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 	}
 	else
 	{
 		depthStencilView = !depthTexture ? m_depthStencilView : depthTexture->m_readOnlyDepthStencilView;
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(numOfRenderTargets, renderTargetViews.data(), depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(numOfRenderTargets, ToRenderHandles(renderTargetViews.data()), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 	}
 }
 
@@ -3644,14 +4404,14 @@ void Renderer::BindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned in
 	{
 		if (!depthTargetResource)
 		{
-			m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+			m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 			return;
 		}
 
 		ID3D11DepthStencilView* depthStencilView = !isDepthReadOnly ? depthTargetResource->m_depthStencilView : depthTargetResource->m_readOnlyDepthStencilView;
 		// Mid Thesis refactor
 		// m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(1, &m_renderTargetView, depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 		return;
 	}
 
@@ -3660,11 +4420,11 @@ void Renderer::BindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned in
 		if (isDepthBufferBound)
 		{
 			ID3D11DepthStencilView* depthStencilView = !depthTargetResource ? m_depthStencilView : depthTargetResource->m_depthStencilView;
-			m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(1, &m_renderTargetView, depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+			m_commandBuffer.SetRenderTargetsAndUAVs(1, ToRenderHandles(&m_renderTargetView), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 			return;
 		}
 
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(1, &m_renderTargetView, 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(1, ToRenderHandles(&m_renderTargetView), nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 		return;
 	}
 
@@ -3686,10 +4446,10 @@ void Renderer::BindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned in
 		if (isDepthBufferBound)
 		{
 			ID3D11DepthStencilView* depthStencilView = !depthTargetResource ? m_depthStencilView : depthTargetResource->m_depthStencilView;
-			m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(numOfRenderTargets, renderTargetViews.data(), depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+			m_commandBuffer.SetRenderTargetsAndUAVs(numOfRenderTargets, ToRenderHandles(renderTargetViews.data()), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 			return;
 		}
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(numOfRenderTargets, renderTargetViews.data(), 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(numOfRenderTargets, ToRenderHandles(renderTargetViews.data()), nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 
 	}
 	else
@@ -3697,10 +4457,10 @@ void Renderer::BindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned in
 		if (isDepthBufferBound)
 		{
 			ID3D11DepthStencilView* depthStencilView = !depthTargetResource ? m_depthStencilView : depthTargetResource->m_readOnlyDepthStencilView;
-			m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(numOfRenderTargets, renderTargetViews.data(), depthStencilView, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+			m_commandBuffer.SetRenderTargetsAndUAVs(numOfRenderTargets, ToRenderHandles(renderTargetViews.data()), depthStencilView, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 			return;
 		}
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(numOfRenderTargets, renderTargetViews.data(), 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeBufferOffset.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(numOfRenderTargets, ToRenderHandles(renderTargetViews.data()), nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeBufferOffset.data());
 	}
 }
 
@@ -3712,7 +4472,7 @@ void Renderer::UnbindUAVsRenderAndDepthTargets(unsigned int numOfUAVs, unsigned
 	UNUSED(uavStartSlot);
 	UNUSED(numOfRenderTargets);
 	// ERROR_AND_DIE("Do not use, yet to be impelemented");
-	m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, 0, 0, 0, 0);
+	m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, 0, 0, nullptr, nullptr);
 }
 
 
@@ -3730,7 +4490,7 @@ void Renderer::UnbindWritableBuffers(unsigned int numOfUAVs, unsigned int startS
 		appendConsumeOffsets[uavIndex]	=	(unsigned int)0;
 	}
 
-	m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, numOfUAVs, uavs.data(), appendConsumeOffsets.data());
+	m_commandBuffer.SetUnorderedAccessViews(startSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeOffsets.data());
 }
 
 
@@ -3752,12 +4512,12 @@ void Renderer::UnbindWritableResources(unsigned int numOfUAVs /*= 1*/, unsigned
 	case BindingLocation::VERTEX_SHADER:
 	case BindingLocation::PIXEL_SHADER:
 	{
-		m_d3d11DeviceContext->OMSetRenderTargetsAndUnorderedAccessViews(0, 0, 0, uavStartSlot, numOfUAVs, uavs.data(), appendConsumeOffsets.data());
+		m_commandBuffer.SetRenderTargetsAndUAVs(0, nullptr, nullptr, uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeOffsets.data());
 		break;
 	}
 	case BindingLocation::COMPUTE_SHADER:
 	{
-		m_d3d11DeviceContext->CSSetUnorderedAccessViews(uavStartSlot, numOfUAVs, uavs.data(), appendConsumeOffsets.data());
+		m_commandBuffer.SetUnorderedAccessViews(uavStartSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeOffsets.data());
 		break;
 	}
 	default:
@@ -3781,17 +4541,17 @@ void Renderer::UnbindReadableBuffers(unsigned int numOfSRVs, unsigned int startS
 	{
 	case BindingLocation::VERTEX_SHADER:
 	{
-		m_d3d11DeviceContext->VSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::VERTEX, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	case BindingLocation::PIXEL_SHADER:
 	{
-		m_d3d11DeviceContext->PSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::PIXEL, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	case BindingLocation::COMPUTE_SHADER:
 	{
-		m_d3d11DeviceContext->CSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	default:
@@ -3814,17 +4574,17 @@ void Renderer::UnbindReadableResources(unsigned int numOfSRVs /*= 1*/, unsigned
 	{
 		case BindingLocation::VERTEX_SHADER:
 		{
-			m_d3d11DeviceContext->VSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+			m_commandBuffer.SetShaderResources(ShaderStage::VERTEX, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 			break;
 		}
 		case BindingLocation::PIXEL_SHADER:
 		{
-			m_d3d11DeviceContext->PSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+			m_commandBuffer.SetShaderResources(ShaderStage::PIXEL, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 			break;
 		}
 		case BindingLocation::COMPUTE_SHADER:
 		{
-			m_d3d11DeviceContext->CSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+			m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 			break;
 		}
 		default:
@@ -3849,7 +4609,7 @@ void Renderer::UnbindWritableTextures(unsigned int numOfUAVs, unsigned int start
 		appendConsumeOffsets[uavIndex]	=	(unsigned int)0;
 	}
 
-	m_d3d11DeviceContext->CSSetUnorderedAccessViews(startSlot, numOfUAVs, uavs.data(), appendConsumeOffsets.data());
+	m_commandBuffer.SetUnorderedAccessViews(startSlot, numOfUAVs, ToRenderHandles(uavs.data()), appendConsumeOffsets.data());
 }
 
 
@@ -3867,17 +4627,17 @@ void Renderer::UnbindReadableTextures(unsigned int numOfSRVs, unsigned int start
 	{
 	case BindingLocation::VERTEX_SHADER:
 	{
-		m_d3d11DeviceContext->VSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::VERTEX, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	case BindingLocation::PIXEL_SHADER:
 	{
-		m_d3d11DeviceContext->PSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::PIXEL, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	case BindingLocation::COMPUTE_SHADER:
 	{
-		m_d3d11DeviceContext->CSSetShaderResources(startSlot, numOfSRVs, srvs.data());
+		m_commandBuffer.SetShaderResources(ShaderStage::COMPUTE, startSlot, numOfSRVs, ToRenderHandles(srvs.data()));
 		break;
 	}
 	default:
@@ -3893,75 +4653,77 @@ void Renderer::ClearRenderTargetAndDepthStencil(Texture* const& renderTarget, Te
 	clearColor.GetAsFloats(clearColorAsFloats);
 	if (renderTarget)
 	{
-		m_d3d11DeviceContext->ClearRenderTargetView(renderTarget->m_renderTargetView, clearColorAsFloats);
+		m_commandBuffer.ClearRenderTarget(renderTarget->m_renderTargetView, clearColorAsFloats);
 	}
 	else
 	{
-		m_d3d11DeviceContext->ClearRenderTargetView(m_renderTargetView, clearColorAsFloats);
+		m_commandBuffer.ClearRenderTarget(m_renderTargetView, clearColorAsFloats);
 	}
 	
 	if (depthStencil)
 	{
 		float depthClearValue = m_desiredDepthMode != DepthMode::GREATER ? 1.f : 0.f;
-		m_d3d11DeviceContext->ClearDepthStencilView(depthStencil->m_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, depthClearValue, 0);
+		m_commandBuffer.ClearDepthStencil(depthStencil->m_depthStencilView, depthClearValue, 0);
 	}
 	else
 	{
-		m_d3d11DeviceContext->ClearDepthStencilView(m_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1, 0);
+		m_commandBuffer.ClearDepthStencil(m_depthStencilView, 1.f, 0);
 	}
 }
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::ClearDepthTextureAndView(Texture* textureToClear) const
+void Renderer::ClearDepthTextureAndView(Texture* textureToClear)
 {
-	m_d3d11DeviceContext->ClearDepthStencilView(textureToClear->m_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, 1, 0);
+	m_commandBuffer.ClearDepthStencil(textureToClear->m_depthStencilView, 1.f, 0);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::ClearDepthResource(D3D11_Resource* depthResourceToClear, float depthValueToClearTo /*= 1.f*/) const
+void Renderer::ClearDepthResource(D3D11_Resource* depthResourceToClear, float depthValueToClearTo /*= 1.f*/)
 {
-	m_d3d11DeviceContext->ClearDepthStencilView(depthResourceToClear->m_depthStencilView, D3D11_CLEAR_DEPTH | D3D11_CLEAR_STENCIL, depthValueToClearTo, 0);
+	m_commandBuffer.ClearDepthStencil(depthResourceToClear->m_depthStencilView, depthValueToClearTo, 0);
 }
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::ClearRenderTargetTextureAndView(Texture* textureToClear, Rgba8 const& clearColor) const
+void Renderer::ClearRenderTargetTextureAndView(Texture* textureToClear, Rgba8 const& clearColor)
 {
 	float clearColorAsFloats[4] = {};
 	clearColor.GetAsFloats(clearColorAsFloats);
-	m_d3d11DeviceContext->ClearRenderTargetView(textureToClear->m_renderTargetView, clearColorAsFloats);
+	m_commandBuffer.ClearRenderTarget(textureToClear->m_renderTargetView, clearColorAsFloats);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::ClearRenderTargetResource(D3D11_Resource* rtToClear, Rgba8 const& clearColor) const
+void Renderer::ClearRenderTargetResource(D3D11_Resource* rtToClear, Rgba8 const& clearColor)
 {
 	float clearColorAsFloats[4] = {};
 	clearColor.GetAsFloats(clearColorAsFloats);
-	m_d3d11DeviceContext->ClearRenderTargetView(rtToClear->m_renderTargetView, clearColorAsFloats);
+	m_commandBuffer.ClearRenderTarget(rtToClear->m_renderTargetView, clearColorAsFloats);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::ClearTextureView(Texture* textureToClear, Rgba8 const& clearColor) const
+void Renderer::ClearTextureView(Texture* textureToClear, Rgba8 const& clearColor)
 {
 	float clearColorAsFloats[4] = {};
 	clearColor.GetAsFloats(clearColorAsFloats);
-	m_d3d11DeviceContext->ClearUnorderedAccessViewFloat(textureToClear->m_unorderedAccessView, clearColorAsFloats);
+	m_commandBuffer.ClearUnorderedAccessView(textureToClear->m_unorderedAccessView, clearColorAsFloats);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::ReleaseTexture(Texture*& textureToRelease) const
+void Renderer::ReleaseTexture(Texture*& textureToRelease)
 {
+	FlushCommands();
 	delete textureToRelease;
 	textureToRelease = nullptr;
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Renderer::ReleaseBuffer(D3D11_Buffer*& bufferToRelease) const
+void Renderer::ReleaseBuffer(D3D11_Buffer*& bufferToRelease)
 {
+	FlushCommands();
 	delete bufferToRelease;
 	bufferToRelease = nullptr;
 }
@@ -4149,22 +4911,22 @@ void Renderer::CopyResource(D3D11_Resource* resourceToCopy, D3D11_Resource* copy
 	{
 		case ResourceType::TEXTURE1D:
 		{
-			m_d3d11DeviceContext->CopyResource(copyDestinationResource->m_texture1d, resourceToCopy->m_texture1d);
+			m_commandBuffer.CopyResource(copyDestinationResource->m_texture1d, resourceToCopy->m_texture1d);
 			break;
 		}
 		case ResourceType::TEXTURE2D:
 		{
-			m_d3d11DeviceContext->CopyResource(copyDestinationResource->m_texture2d, resourceToCopy->m_texture2d);
+			m_commandBuffer.CopyResource(copyDestinationResource->m_texture2d, resourceToCopy->m_texture2d);
 			break;
 		}
 		case ResourceType::TEXTURE3D:
 		{
-			m_d3d11DeviceContext->CopyResource(copyDestinationResource->m_texture3d, resourceToCopy->m_texture3d);
+			m_commandBuffer.CopyResource(copyDestinationResource->m_texture3d, resourceToCopy->m_texture3d);
 			break;
 		}
 		case ResourceType::STRUCTURED_BUFFER:
 		{
-			m_d3d11DeviceContext->CopyResource(copyDestinationResource->m_buffer, resourceToCopy->m_buffer);
+			m_commandBuffer.CopyResource(copyDestinationResource->m_buffer, resourceToCopy->m_buffer);
 			break;
 		}
 		case ResourceType::RAW_BUFFER:
@@ -4181,7 +4943,7 @@ void Renderer::CopyResource(D3D11_Resource* resourceToCopy, D3D11_Resource* copy
 //--------------------------------------------------------------------------------------------------
 void Renderer::CopyTextureResource(Texture const* dest, Texture const* src)
 {
-	m_d3d11DeviceContext->CopyResource(dest->m_texture, src->m_texture);
+	m_commandBuffer.CopyResource(dest->m_texture, src->m_texture);
 }
 
 
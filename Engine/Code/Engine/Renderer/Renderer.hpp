@@ -4,6 +4,9 @@
 //--------------------------------------------------------------------------------------------------
 #include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Renderer/TransientRingBuffer.hpp"
+#include "Engine/Renderer/RenderCommands.hpp"
+#include "Engine/Renderer/ShaderCache.hpp"
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Core/Rgba8.hpp"
@@ -16,6 +19,7 @@
 
 //--------------------------------------------------------------------------------------------------
 #include <vector>
+#include <atomic>
 
 
 //--------------------------------------------------------------------------------------------------
@@ -40,6 +44,7 @@ struct ID3D11BlendState;
 struct ID3D11Texture2D;
 struct IDXGISwapChain;
 struct ID3D11Device;
+struct IUnknown;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -53,7 +58,13 @@ class  D3D11_Buffer;
 class  ConstantBuffer;
 class  D3D11_Resource;
 class  StructuredBuffer;
+class  RenderBackend;
+class  D3D11_RenderBackend;
+class  NullRenderBackend;
+class  ResourcePool;
+class  RenderProfiler;
 struct D3D11_ResourceConfig;
+struct ResourcePoolStats;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -297,6 +308,8 @@ enum class InputLayout : unsigned char
 	VERTEX_NONE,
 	VERTEX_PCU,
 	VERTEX_PCUTBN,
+	VERTEX_PCUTBN_QUANTIZED,
+	SPRITE_QUAD,				// Instanced only, see SpriteQuad
 };
 
 
@@ -316,7 +329,11 @@ enum class ResourceType : unsigned char
 //--------------------------------------------------------------------------------------------------
 struct RendererConfig
 {
-	Window* m_window = nullptr;
+	Window*		m_window				=	nullptr;
+	std::string	m_shaderCacheFolder		=	SHADER_CACHE_FOLDER;	// Empty compiles every shader on every launch
+	size_t		m_maxIdlePooledBytes	=	512u * 1024u * 1024u;	// Idle pooled resources past this are destroyed, least recently used first
+	uint64_t	m_maxIdlePooledFrames	=	300;					// Pooled resources idle this many frames are destroyed under budget too
+	bool		m_isHeadless			=	false;					// WARP device without a swap chain, commands only go to a null backend and nothing is presented
 };
 
 
@@ -388,6 +405,31 @@ public:
 	void EndFrame();
 	void Shutdown();
 
+	// Pipeline work is recorded and runs on the backend at EndCamera, EndFrame or an explicit flush
+	void			FlushCommands();
+	void			SignalFrameFence();						// Flushes and ends the frame's transient data, EndFrame does this before presenting
+	void			SetBackend(RenderBackend* backend);		// Null goes back to the default backend, D3D11 or the headless null backend
+	RenderBackend*	GetBackend() const;
+	bool			IsHeadless() const;
+
+	// Recorded commands borrow D3D11 objects without a reference, the buffers and shaders hand theirs over here when deleted
+	// Released right away when nothing is recorded, otherwise once the pending commands have been submitted, main thread only
+	void			ReleaseAfterFlush(IUnknown* d3d11Object);
+
+	// For recording on job threads, the buffer runs at the point in the main thread's commands where it was acquired
+	// The recording thread finishes the buffer when it is done, flushing while any acquired buffer is unfinished dies
+	// The buffers are kept across frames so they stop allocating once warm
+	RenderCommandBuffer*	AcquireParallelCommandBuffer();
+	void					FinishParallelCommandBuffer();		// Once per acquired buffer, from the thread that recorded it
+
+	// Record into a parallel command buffer from any thread, they only read the resources and leave the Renderer's state alone
+	// Blend, sampler, rasterizer and depth states are the ones set on the main thread when the buffer was acquired
+	void RecordBindShader(RenderCommandBuffer& commandBuffer, Shader const* shader) const;
+	void RecordBindTexture(RenderCommandBuffer& commandBuffer, Texture const* texture, unsigned int slot = 0) const;
+	void RecordModelConstants(RenderCommandBuffer& commandBuffer, Mat44 const& modelMatrix = Mat44(), Rgba8 const& modelColor = Rgba8::WHITE) const;
+	void RecordDrawVertexBuffer(RenderCommandBuffer& commandBuffer, VertexBuffer const* vbo, int vertexCount, PrimitiveTopology primitiveTopology = PrimitiveTopology::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, int vertexOffset = 0) const;
+	void RecordDrawVertexAndIndexBuffer(RenderCommandBuffer& commandBuffer, VertexBuffer const* vbo, IndexBuffer const* ibo, int indexCount, int indexOffset = 0, int vertexOffset = 0) const;
+
 	void ClearScreen(Rgba8 const& clearColor);
 	void BeginCamera(Camera const& camera);
 	void EndCamera(Camera const& camera);
@@ -401,18 +443,27 @@ public:
 	Texture*	CreateTextureFromData(char const* name, IntVec2 dimensions, int bytesPerTexel, unsigned char* texelData);
 	void		BindTexture(Texture const* texture, BindingLocation bindingLocation = BindingLocation::PIXEL_SHADER);
 	Texture*	CreateOrGetTextureFromFile(char const* imageFilePath);
+	Texture*	CreateOrGetTextureFromImage(Image const& image);	// Keyed on the image's file path like CreateOrGetTextureFromFile, for images decoded off the main thread
 	BitmapFont*	CreateOrGetBitmapFont(char const* bitmapFontFilePathWithNoExtension);
 	Shader*		CreateOrGetShader(char const* shaderFilePath, InputLayout const& inputLayout = InputLayout::VERTEX_PCU, bool isUsedForInstancedRendering = false);
 
 	Texture*	GetTextureForFileName	(char const* imageFilePath);
 	BitmapFont* GetBitmapFontForFileName(char const* bitmapFontFilePathWithNoExtension);
+	Shader*		GetShaderForName		(char const* shaderName);
 
 	void	BindShader(Shader* shader, BindingLocation bindingLocation = BindingLocation::PIXEL_SHADER);
+	Shader*	GetCurrentShader() const;
+	Shader*	GetFallbackShader(Shader const* shader) const;		// What binding a shader that is not READY binds instead
 	void	UnbindShaders();
 	Shader* CreateShader(char const* shaderName, char const* shaderSource, InputLayout const& inputLayout = InputLayout::VERTEX_PCU, bool isUsedForInstancedRendering = false);
 	Shader* CreateShader(char const* shaderName, InputLayout const& inputLayout = InputLayout::VERTEX_PCU, bool isUsedForInstancedRendering = false);
 	Shader* CreateComputeShader(char const* shaderName);
-	bool	CompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target);
+	bool	CompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target);	// Through the shader cache, dies on compile errors
+	bool	TryCompileShaderToByteCode(std::vector<unsigned char>& outByteCode, char const* name, char const* source, char const* entryPoint, char const* target);	// False on compile errors, safe on job threads
+	void	CreateShaderStages(Shader& shader, std::vector<unsigned char> const& vertexShaderByteCode, std::vector<unsigned char> const& pixelShaderByteCode, InputLayout const& inputLayout, bool isUsedForInstancedRendering);
+	void	CreateComputeShaderStage(Shader& shader, std::vector<unsigned char> const& computeShaderByteCode);
+	Shader*	CreatePendingShader(char const* shaderName, Shader* fallbackShader = nullptr);
+	ShaderCacheStats GetShaderCacheStats() const;
 
 	VertexBuffer*	CreateVertexBuffer(size_t const size);
 	VertexBuffer*	CreateVertexBuffer(size_t const size, unsigned int stride);
@@ -444,6 +495,8 @@ public:
 	void DrawVertexBuffer(VertexBuffer* vbo, int vertexCount, PrimitiveTopology const& primitiveTopology = PrimitiveTopology::D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST, int vertexOffset = 0);
 	void DrawVertexAndIndexBuffer(VertexBuffer* vbo, IndexBuffer* ibo, int indexCount, int indexOffset = 0, int vertexOffset = 0);
 	void DrawIndexedBuffer(IndexBuffer* ibo, VertexBuffer* vbo, unsigned int indexCount, unsigned int indexOffset = 0, int vertexOffset = 0);
+	void Draw(int vertexCount, int vertexOffset = 0);		// Draws with the bound vertex buffer, like DrawIndexed
+	void DrawInstancedArray(int numOfInstances, void const* instances, unsigned int instanceStride, IndexBuffer* ibo, int numOfIndexesPerInstance);	// Instances are the only vertex stream, the shader builds vertexes from SV_VertexID
 	void DrawIndexed(int indexCount, int indexOffset = 0, int vertexOffset = 0);
 	void DrawIndexedInstanced(D3D11_Buffer* indexBuffer, D3D11_Buffer* instanceBuffer, D3D11_Buffer* vertexBuffer, unsigned int indexCountPerInstance, 
 							  unsigned int instanceCount, unsigned int startIndexLocation = 0, unsigned int baseVertexLocation = 0, unsigned int startInstanceLocation = 0);
@@ -461,7 +514,12 @@ public:
 	void SetSamplerMode(SamplerMode samplerMode);
 	void SetRasterizerMode(RasterizerMode rasterizerMode);
 	void SetDepthMode(DepthMode depthMode);
+	BlendMode		GetBlendMode() const;			// The modes the next draw binds, INVALID means the custom blend state
+	SamplerMode		GetSamplerMode() const;
+	RasterizerMode	GetRasterizerMode() const;
+	DepthMode		GetDepthMode() const;
 	void SetStatesIfChanged();
+	void InvalidateStateCache();		// The next draw binds every state again
 	void SetModelConstants(Mat44 const& modelMatrix = Mat44(), Rgba8 const& modelColor = Rgba8::WHITE);
 	void SetLightingConstants(Vec3 const& sunDirection, float sunIntensity, float ambientIntensity, Vec3 worldEyePosition = Vec3::ZERO, int normalMode = 0, int specularMode = 0, float specularIntensity = 0.f, float specularPower = 0.f);
 	void SetLightAt(Light const& lightToSet, int indexToSet);
@@ -470,6 +528,12 @@ public:
 	void BeginAnnotationEvent(wchar_t const* annotationText);
 	void EndAnnotationEvent();
 
+	// Times the main command buffer's commands between them, on the CPU while recording and submitting and on the GPU when the backend can
+	// BeginFrame opens a "Frame" scope and SignalFrameFence closes whatever is still open
+	void					BeginTimingScope(char const* name);
+	void					EndTimingScope();
+	RenderProfiler const&	GetRenderProfiler() const;
+
 	void			CreateDefaultDepthTextureAndView();
 	void			CreateNewDepthTextureAndView(Texture*& depthTexture, unsigned int debugResourceNameSize = 0, char const* debugResourceName = "None", IntVec2 const& textureDims = IntVec2(-1, -1));
 	void			CreateWritableRenderTarget(Texture*& renderTarget, unsigned int debugResourceNameSize = 0, char const* debugResourceName = "None", IntVec2 const& textureDims = IntVec2(-1, -1));
@@ -480,9 +544,22 @@ public:
 	void			CreateTextureFromConfig(TextureConfig const& config, Texture*& texture);
 	void			CreateResourceFromConfig(D3D11_ResourceConfig& config, D3D11_Resource*& resource);
 	D3D11_Resource* CreateTextureResourceFromFile(char const* imageFilePath, char const* debugResourceName = nullptr, unsigned int debugResourceNameSize = 0);
+	D3D11_Resource* CreateTextureResourceFromImage(Image const& image, char const* debugResourceName = nullptr, unsigned int debugResourceNameSize = 0);
 	D3D11_Resource* CreateTextureCubeResourceFromFile(char const* cubeMapDir, char const* debugResourceName = nullptr, unsigned int debugResourceNameSize = 0);
+	D3D11_Resource* CreateTextureCubeResourceFromImages(Image const* faceImages, char const* debugResourceName = nullptr, unsigned int debugResourceNameSize = 0);	// faceImages holds 6 images of the same size
+	static void		GetTextureCubeFaceFilePaths(char const* cubeMapDir, std::string* out_faceFilePaths);	// out_faceFilePaths holds 6 strings: XPos XNeg YPos YNeg ZPos ZNeg
 	void			CreateDepthResource(D3D11_Resource*& depthResource, char const* debugResourceName = "None", unsigned int debugResourceNameSize = 0, bool canBeReadOnly = false, IntVec2 const& textureDims = IntVec2(-1, -1));
 	void			CreateRenderTargetResource(D3D11_Resource*& renderTargetResource, bool isWritable, char const* debugResourceName = nullptr, unsigned int debugResourceNameSize = 0, IntVec2 const& textureDims = IntVec2(-1, -1));
+	static D3D11_ResourceConfig GetDepthResourceConfig(bool canBeReadOnly = false, IntVec2 const& textureDims = IntVec2(-1, -1));	// What CreateDepthResource creates
+	static D3D11_ResourceConfig GetRenderTargetResourceConfig(bool isWritable, IntVec2 const& textureDims = IntVec2(-1, -1));	// What CreateRenderTargetResource creates
+	void			DestroyResource(D3D11_Resource*& resource);		// One of the Create*Resource* ones, nulls the pointer, deleted once the frames in flight are done with it
+
+	// Recycled by descriptor across frames, window sized configs (-1 dimensions) are resolved to the client size first
+	// A released resource may go to the next acquire right away, it is only destroyed once the frames in flight are done with it
+	D3D11_Resource*				AcquirePooledResource(D3D11_ResourceConfig const& config);
+	void						ReleasePooledResource(D3D11_Resource*& resource);		// Nulls the pointer
+	void						ReleaseIdlePooledResources();							// Instead of waiting for the idle budget to run out
+	ResourcePoolStats const&	GetResourcePoolStats() const;
 
 
 	void BindRenderTargetOnly(Texture* renderTarget);
@@ -517,14 +594,14 @@ public:
 	void UnbindReadableTextures(unsigned int numOfSRVs = 1, unsigned int startSlot = 0, BindingLocation unbindingLocation = BindingLocation::PIXEL_SHADER);
 
 	void ClearRenderTargetAndDepthStencil(Texture* const& renderTarget = nullptr, Texture* const& depthStencil = nullptr, Rgba8 const& clearColor = Rgba8::BLACK);
-	void ClearDepthTextureAndView(Texture* textureToClear)	const;
-	void ClearDepthResource(D3D11_Resource* depthResourceToClear, float depthValueToClearTo = 1.f) const;
-	void ClearRenderTargetTextureAndView(Texture* textureToClear, Rgba8 const& clearColor) const;
-	void ClearRenderTargetResource(D3D11_Resource* rtToClear, Rgba8 const& clearColor) const;
-	void ClearTextureView(Texture* textureToClear, Rgba8 const& clearColor) const;
-	void ReleaseTexture(Texture*& textureToRelease)			const;
+	void ClearDepthTextureAndView(Texture* textureToClear);
+	void ClearDepthResource(D3D11_Resource* depthResourceToClear, float depthValueToClearTo = 1.f);
+	void ClearRenderTargetTextureAndView(Texture* textureToClear, Rgba8 const& clearColor);
+	void ClearRenderTargetResource(D3D11_Resource* rtToClear, Rgba8 const& clearColor);
+	void ClearTextureView(Texture* textureToClear, Rgba8 const& clearColor);
+	void ReleaseTexture(Texture*& textureToRelease);
 
-	void ReleaseBuffer(D3D11_Buffer*& bufferToRelease) const;
+	void ReleaseBuffer(D3D11_Buffer*& bufferToRelease);
 
 	void SetDebugResourceName(D3D11_Buffer*&	bufferToName,	unsigned int debugNameSize, char const* debugName);
 	void SetDebugResourceName(VertexBuffer*&	bufferToName,	unsigned int debugNameSize, char const* debugName);
@@ -537,10 +614,16 @@ public:
 	Texture*	GetDefaultTexture() const;
 
 private:
+	D3D11_Resource*	CreateUntrackedResource(D3D11_ResourceConfig const& config);		// Not in m_loadedResources, for the resource pool
 	Texture*	CreateTextureFromFile	(char const* imageFilePath);
 	Texture*	CreateTextureFromImage	(Image const& image);
 	BitmapFont*	CreateBitmapFont		(char const* imageFilePathWithNoExtension);
 
+	// Immediate draw data and model constants are sub-allocated from per frame rings, uploaded once per flush
+	void		AllocateTransient(TransientBufferType type, uint32_t numOfBytes, uint32_t alignment, TransientAllocation& out_allocation);
+	void		UploadTransientData();
+	void		ReserveTransientBuffers();
+
 protected:
 	void* m_dxgiDebugModule = nullptr;
 	void* m_dxgiDebug		= nullptr;
@@ -570,16 +653,28 @@ protected:
 
 	
 	std::vector<Shader*>	m_loadedShaders;
-	Shader const*			m_currentShader = nullptr;
+	Shader*					m_currentShader = nullptr;
 	Shader*					m_defaultShader = nullptr;
+	bool					m_isBoundComputeShaderReady = true;
 	
-	VertexBuffer*	m_immediateVBO		= nullptr;
-	VertexBuffer*	m_immediatePNCUVBO	= nullptr;
-	IndexBuffer*	m_immediateIBO		= nullptr;
 	ConstantBuffer* m_cameraCBO			= nullptr;
-	ConstantBuffer* m_modelCBO			= nullptr;
+	ConstantBuffer* m_modelCBO			= nullptr;		// Model constants without constant buffer ranges and from parallel command buffers
 	ConstantBuffer* m_lightingCBO		= nullptr;
 
+	RenderCommandBuffer					m_commandBuffer;
+	std::vector<RenderCommandBuffer*>	m_parallelCommandBuffers;
+	int									m_numOfParallelCommandBuffersInUse	= 0;
+	std::atomic<int>					m_numOfOpenParallelCommandBuffers	= 0;		// Acquired and not yet finished
+	std::vector<IUnknown*>				m_objectsToReleaseAfterFlush;
+	D3D11_RenderBackend*				m_d3d11Backend						= nullptr;
+	NullRenderBackend*					m_headlessBackend					= nullptr;	// Instead of m_d3d11Backend when the config is headless
+	RenderBackend*						m_backend							= nullptr;
+	TransientRingBuffer					m_transientBuffers[(int)TransientBufferType::COUNT]	= { TransientRingBuffer(1u << 20), TransientRingBuffer(1u << 18) };	// Both grow when the frames in flight need more
+	uint64_t							m_numOfFramesSignaled				= 0;
+	ShaderCache*						m_shaderCache						= nullptr;
+	ResourcePool*						m_resourcePool						= nullptr;
+	RenderProfiler*						m_renderProfiler					= nullptr;
+
 	RendererConfig m_config;
 
 	Texture*						m_defaultTexture = nullptr;
@@ -587,6 +682,14 @@ protected:
 	std::vector<BitmapFont*>		m_loadedFonts;
 	std::vector<D3D11_Resource*>	m_loadedResources;
 
+	// Destroyed resources wait here until the fence passes the last frame that could use them
+	struct RetiredResource
+	{
+		D3D11_Resource*	m_resource		=	nullptr;
+		uint64_t		m_lastUsedFrame	=	0;
+	};
+	std::vector<RetiredResource>	m_retiredResources;
+
 private:
 	// Should this be a pointer
 	Light m_lights[MAX_LIGHTS];
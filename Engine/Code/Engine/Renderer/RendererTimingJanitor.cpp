@@ -0,0 +1,23 @@
+#include "Engine/Renderer/RendererTimingJanitor.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+extern Renderer* g_theRenderer;
+
+
+//--------------------------------------------------------------------------------------------------
+RendererTimingJanitor::RendererTimingJanitor(char const* scopeName)
+{
+	GUARANTEE_OR_DIE(g_theRenderer != nullptr, "Please create a renderer before calling the renderer timing janitor");
+	g_theRenderer->BeginTimingScope(scopeName);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+RendererTimingJanitor::~RendererTimingJanitor()
+{
+	GUARANTEE_OR_DIE(g_theRenderer != nullptr, "Please create a renderer before calling the renderer timing janitor");
+	g_theRenderer->EndTimingScope();
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+
+
+//--------------------------------------------------------------------------------------------------
+class RendererTimingJanitor
+{
+public:
+	RendererTimingJanitor(char const* scopeName);
+	~RendererTimingJanitor();
+};
\ No newline at end of file
@@ -0,0 +1,296 @@
+#include "Engine/Renderer/ResourcePool.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <algorithm>
+
+
+//--------------------------------------------------------------------------------------------------
+ResourcePool::ResourcePool(ResourcePoolConfig const& config, ResourcePoolCreateFunction const& createFunction, ResourcePoolDestroyFunction const& destroyFunction) :
+	m_config(config), m_createFunction(createFunction), m_destroyFunction(destroyFunction)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ResourcePool::~ResourcePool()
+{
+	for (size_t pooledIndex = 0; pooledIndex < m_pooledResources.size(); ++pooledIndex)
+	{
+		m_destroyFunction(m_pooledResources[pooledIndex].m_resource);
+	}
+	m_pooledResources.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Of the idle resources with the same descriptor, the most recently used one
+D3D11_Resource* ResourcePool::Acquire(D3D11_ResourceConfig const& config)
+{
+	int bestPooledIndex = -1;
+	for (size_t pooledIndex = 0; pooledIndex < m_pooledResources.size(); ++pooledIndex)
+	{
+		PooledResource const& pooledResource = m_pooledResources[pooledIndex];
+		if (pooledResource.m_isInUse || !AreConfigsCompatible(pooledResource.m_config, config))
+		{
+			continue;
+		}
+		if (bestPooledIndex < 0 || pooledResource.m_lastUsedFrame > m_pooledResources[bestPooledIndex].m_lastUsedFrame)
+		{
+			bestPooledIndex = (int)pooledIndex;
+		}
+	}
+
+	if (bestPooledIndex >= 0)
+	{
+		PooledResource& pooledResource	=	m_pooledResources[bestPooledIndex];
+		pooledResource.m_isInUse		=	true;
+		pooledResource.m_lastUsedFrame	=	m_frameNumber + 1;
+		m_stats.m_numOfHits					+=	1;
+		m_stats.m_numOfResourcesInUse		+=	1;
+		m_stats.m_numOfIdleResources		-=	1;
+		m_stats.m_bytesInUse				+=	pooledResource.m_sizeInBytes;
+		m_stats.m_idleBytes					-=	pooledResource.m_sizeInBytes;
+		return pooledResource.m_resource;
+	}
+
+	// The pool keeps the descriptor only, not the name of whoever asked for it first
+	PooledResource pooledResource;
+	pooledResource.m_config						=	config;
+	pooledResource.m_config.m_debugName			=	"None";
+	pooledResource.m_config.m_debugNameSize		=	0;
+	pooledResource.m_resource					=	m_createFunction(config);
+	pooledResource.m_sizeInBytes				=	GetSizeInBytes(config);
+	pooledResource.m_lastUsedFrame				=	m_frameNumber + 1;
+	pooledResource.m_isInUse					=	true;
+	m_pooledResources.push_back(pooledResource);
+
+	m_stats.m_numOfMisses			+=	1;
+	m_stats.m_numOfResourcesInUse	+=	1;
+	m_stats.m_bytesInUse			+=	pooledResource.m_sizeInBytes;
+	m_stats.m_peakBytes				=	std::max(m_stats.m_peakBytes, m_stats.m_bytesInUse + m_stats.m_idleBytes);
+	return pooledResource.m_resource;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The frame recording now is the last one to use it, so it is not destroyed before that frame's fence completes
+void ResourcePool::Release(D3D11_Resource* resource)
+{
+	for (size_t pooledIndex = 0; pooledIndex < m_pooledResources.size(); ++pooledIndex)
+	{
+		PooledResource& pooledResource = m_pooledResources[pooledIndex];
+		if (pooledResource.m_resource != resource)
+		{
+			continue;
+		}
+		GUARANTEE_OR_DIE(pooledResource.m_isInUse, "Releasing a pooled resource that was already released");
+		pooledResource.m_isInUse		=	false;
+		pooledResource.m_lastUsedFrame	=	m_frameNumber + 1;
+		m_stats.m_numOfResourcesInUse	-=	1;
+		m_stats.m_numOfIdleResources	+=	1;
+		m_stats.m_bytesInUse			-=	pooledResource.m_sizeInBytes;
+		m_stats.m_idleBytes				+=	pooledResource.m_sizeInBytes;
+		return;
+	}
+	ERROR_AND_DIE("Releasing a resource that does not belong to the resource pool");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool ResourcePool::IsPooled(D3D11_Resource const* resource) const
+{
+	for (size_t pooledIndex = 0; pooledIndex < m_pooledResources.size(); ++pooledIndex)
+	{
+		if (m_pooledResources[pooledIndex].m_resource == resource)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ResourcePool::EndFrame(uint64_t frameNumber, uint64_t completedFrameNumber)
+{
+	m_frameNumber			=	frameNumber;
+	m_completedFrameNumber	=	completedFrameNumber;
+	ReleaseStaleResources();
+	ReleaseIdleResources(m_config.m_maxIdleBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ResourcePool::ReleaseIdleResources()
+{
+	ReleaseIdleResources(0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ResourcePoolStats const& ResourcePool::GetStats() const
+{
+	return m_stats;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Least recently used first, an idle resource the frames in flight may still read is skipped
+void ResourcePool::ReleaseIdleResources(size_t maxIdleBytes)
+{
+	while (m_stats.m_idleBytes > maxIdleBytes || (maxIdleBytes == 0 && m_stats.m_numOfIdleResources > 0))
+	{
+		int oldestPooledIndex = -1;
+		for (size_t pooledIndex = 0; pooledIndex < m_pooledResources.size(); ++pooledIndex)
+		{
+			PooledResource const& pooledResource = m_pooledResources[pooledIndex];
+			if (CanBeDestroyed(pooledResource) && (oldestPooledIndex < 0 || pooledResource.m_lastUsedFrame < m_pooledResources[oldestPooledIndex].m_lastUsedFrame))
+			{
+				oldestPooledIndex = (int)pooledIndex;
+			}
+		}
+		if (oldestPooledIndex < 0)
+		{
+			return;
+		}
+		DestroyPooledResource(oldestPooledIndex);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Whatever the budget, the ones that sat idle for m_maxNumOfIdleFrames
+void ResourcePool::ReleaseStaleResources()
+{
+	if (m_config.m_maxNumOfIdleFrames == 0)
+	{
+		return;
+	}
+	for (size_t pooledIndex = 0; pooledIndex < m_pooledResources.size();)
+	{
+		PooledResource const& pooledResource = m_pooledResources[pooledIndex];
+		if (CanBeDestroyed(pooledResource) && pooledResource.m_lastUsedFrame + m_config.m_maxNumOfIdleFrames <= m_frameNumber)
+		{
+			DestroyPooledResource(pooledIndex);
+			continue;
+		}
+		++pooledIndex;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Idle, and the frames in flight that may still read it are done
+bool ResourcePool::CanBeDestroyed(PooledResource const& pooledResource) const
+{
+	return !pooledResource.m_isInUse && pooledResource.m_lastUsedFrame <= m_completedFrameNumber &&
+		pooledResource.m_lastUsedFrame + m_config.m_numOfFramesBeforeRelease <= m_frameNumber;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ResourcePool::DestroyPooledResource(size_t pooledIndex)
+{
+	PooledResource const& pooledResource = m_pooledResources[pooledIndex];
+	m_destroyFunction(pooledResource.m_resource);
+	m_stats.m_numOfDestroyedResources	+=	1;
+	m_stats.m_numOfIdleResources		-=	1;
+	m_stats.m_idleBytes					-=	pooledResource.m_sizeInBytes;
+	m_pooledResources.erase(m_pooledResources.begin() + pooledIndex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Block compressed formats ignore the rounding up to whole blocks
+size_t ResourcePool::GetSizeInBytes(D3D11_ResourceConfig const& config)
+{
+	if (config.m_type == ResourceType::STRUCTURED_BUFFER || config.m_type == ResourceType::RAW_BUFFER)
+	{
+		return size_t(config.m_numOfElements) * size_t(config.m_elementStride);
+	}
+	if (config.m_width == (unsigned int)-1 || config.m_height == (unsigned int)-1)
+	{
+		return 0;
+	}
+
+	size_t width	=	config.m_width;
+	size_t height	=	config.m_type == ResourceType::TEXTURE1D ? 1 : config.m_height;
+	size_t depth	=	(config.m_type == ResourceType::TEXTURE3D && config.m_depth != (unsigned int)-1) ? config.m_depth : 1;
+
+	size_t bitsPerTexel = GetBitsPerTexel(config.m_format);
+	if (bitsPerTexel == 0)
+	{
+		bitsPerTexel = size_t(config.m_sizeOfTexelInBytes) * 8;
+	}
+
+	// Zero mip levels asks D3D11 for the whole chain
+	size_t numOfTexels = 0;
+	for (unsigned int mipLevel = 0; config.m_mipLevels == 0 || mipLevel < config.m_mipLevels; ++mipLevel)
+	{
+		size_t mipWidth		=	std::max<size_t>(width >> mipLevel, 1);
+		size_t mipHeight	=	std::max<size_t>(height >> mipLevel, 1);
+		size_t mipDepth		=	std::max<size_t>(depth >> mipLevel, 1);
+		numOfTexels += mipWidth * mipHeight * mipDepth;
+		if (mipWidth == 1 && mipHeight == 1 && mipDepth == 1)
+		{
+			break;
+		}
+	}
+
+	size_t numOfSlices	=	std::max<unsigned int>(config.m_numOfSlices, 1);
+	size_t numOfSamples	=	std::max<unsigned int>(config.m_multiSampleCount, 1);
+	return (numOfTexels * bitsPerTexel + 7) / 8 * numOfSlices * numOfSamples;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Zero for DXGI_FORMAT_UNKNOWN and the video formats
+unsigned int ResourcePool::GetBitsPerTexel(ResourceViewFormat format)
+{
+	unsigned int formatIndex = (unsigned int)format;
+	if (formatIndex == 0)																		return 0;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_R32G32B32A32_SINT)	return 128;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_R32G32B32_SINT)		return 96;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_X32_TYPELESS_G8X24_UINT)	return 64;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_X24_TYPELESS_G8_UINT)	return 32;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_R16_SINT)			return 16;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_A8_UNORM)			return 8;
+	if (formatIndex == (unsigned int)ResourceViewFormat::DXGI_FORMAT_R1_UNORM)			return 1;
+	if (formatIndex == (unsigned int)ResourceViewFormat::DXGI_FORMAT_R9G9B9E5_SHAREDEXP)	return 32;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_G8R8_G8B8_UNORM)		return 16;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_BC1_UNORM_SRGB)		return 4;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_BC3_UNORM_SRGB)		return 8;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_BC4_SNORM)			return 4;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_BC5_SNORM)			return 8;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_B5G5R5A1_UNORM)		return 16;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_B8G8R8X8_UNORM_SRGB)	return 32;
+	if (formatIndex <= (unsigned int)ResourceViewFormat::DXGI_FORMAT_BC7_UNORM_SRGB)		return 8;
+	if (formatIndex == (unsigned int)ResourceViewFormat::DXGI_FORMAT_B4G4R4A4_UNORM)		return 16;
+	return 0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Everything D3D11 bakes into the resource
+bool ResourcePool::AreConfigsCompatible(D3D11_ResourceConfig const& configA, D3D11_ResourceConfig const& configB)
+{
+	return	configA.m_format				==	configB.m_format				&&
+			configA.m_bindFlags				==	configB.m_bindFlags				&&
+			configA.m_uavResourceFlag		==	configB.m_uavResourceFlag		&&
+			configA.m_usageFlag				==	configB.m_usageFlag				&&
+			configA.m_type					==	configB.m_type					&&
+			configA.m_isStandard			==	configB.m_isStandard			&&
+			configA.m_canDepthBeReadOnly	==	configB.m_canDepthBeReadOnly	&&
+			configA.m_width					==	configB.m_width					&&
+			configA.m_height				==	configB.m_height				&&
+			configA.m_depth					==	configB.m_depth					&&
+			configA.m_numOfElements			==	configB.m_numOfElements			&&
+			configA.m_elementStride			==	configB.m_elementStride			&&
+			configA.m_mipLevels				==	configB.m_mipLevels				&&
+			configA.m_numOfSlices			==	configB.m_numOfSlices			&&
+			configA.m_multiSampleCount		==	configB.m_multiSampleCount		&&
+			configA.m_multiSampleQuality	==	configB.m_multiSampleQuality	&&
+			configA.m_sizeOfTexelInBytes	==	configB.m_sizeOfTexelInBytes;
+}
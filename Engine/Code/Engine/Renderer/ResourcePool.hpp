@@ -0,0 +1,95 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/Renderer.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <functional>
+#include <stdint.h>
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+struct ResourcePoolConfig
+{
+	size_t		m_maxIdleBytes					=	512u * 1024u * 1024u;	// Idle resources past this are released, least recently used first
+	uint64_t	m_numOfFramesBeforeRelease		=	3;						// A released resource stays idle at least this long before it can be destroyed
+	uint64_t	m_maxNumOfIdleFrames			=	300;					// Idle this long it is destroyed even under budget, 0 keeps it until the budget runs out
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct ResourcePoolStats
+{
+	int			m_numOfHits					=	0;
+	int			m_numOfMisses				=	0;		// Every miss created a resource
+	int			m_numOfDestroyedResources	=	0;
+	int			m_numOfResourcesInUse		=	0;
+	int			m_numOfIdleResources		=	0;
+	size_t		m_bytesInUse				=	0;
+	size_t		m_idleBytes					=	0;
+	size_t		m_peakBytes					=	0;		// In use and idle together
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Creates a resource for a config whose dimensions are resolved, and destroys one the pool gives up on
+typedef std::function<D3D11_Resource*(D3D11_ResourceConfig const& config)>	ResourcePoolCreateFunction;
+typedef std::function<void(D3D11_Resource* resource)>						ResourcePoolDestroyFunction;
+
+
+//--------------------------------------------------------------------------------------------------
+// Recycles render targets, depth targets and buffers by descriptor (format, dimensions, bind flags, usage, ...)
+// Released resources stay idle in the pool and the next acquire with the same descriptor gets one back instead of
+// creating it again. Idle ones are only destroyed numOfFramesBeforeRelease frames after their release, once the fence of
+// the frame that last used them has completed, and then once they have sat idle for maxNumOfIdleFrames or while the idle
+// bytes are over budget, so descriptors nothing asks for anymore (an old window size, a mode switched off) do not stay forever
+// Knows nothing about D3D11 itself, the renderer hands it the functions that create and destroy the resources
+class ResourcePool
+{
+public:
+	ResourcePool(ResourcePoolConfig const& config, ResourcePoolCreateFunction const& createFunction, ResourcePoolDestroyFunction const& destroyFunction);
+	~ResourcePool();		// Destroys everything, in use or not
+
+	// The config's dimensions have to be resolved, the debug name only names the resource if it has to be created
+	D3D11_Resource*				Acquire(D3D11_ResourceConfig const& config);
+	void						Release(D3D11_Resource* resource);
+	bool						IsPooled(D3D11_Resource const* resource) const;
+
+	// Frame numbers are the renderer's frame fence values
+	void						EndFrame(uint64_t frameNumber, uint64_t completedFrameNumber);
+	void						ReleaseIdleResources();		// Every idle resource past the frame delay, budget or not
+
+	ResourcePoolStats const&	GetStats() const;
+
+	// Linear size of every mip of every slice, window sized configs (-1 dimensions) have no size here
+	static size_t				GetSizeInBytes(D3D11_ResourceConfig const& config);
+	static unsigned int			GetBitsPerTexel(ResourceViewFormat format);
+	static bool					AreConfigsCompatible(D3D11_ResourceConfig const& configA, D3D11_ResourceConfig const& configB);		// Ignores the debug name and initial data
+
+private:
+	struct PooledResource
+	{
+		D3D11_ResourceConfig	m_config;
+		D3D11_Resource*			m_resource			=	nullptr;
+		size_t					m_sizeInBytes		=	0;
+		uint64_t				m_lastUsedFrame		=	0;
+		bool					m_isInUse			=	false;
+	};
+
+	void		ReleaseIdleResources(size_t maxIdleBytes);
+	void		ReleaseStaleResources();
+	bool		CanBeDestroyed(PooledResource const& pooledResource) const;
+	void		DestroyPooledResource(size_t pooledIndex);
+
+private:
+	ResourcePoolConfig				m_config;
+	ResourcePoolCreateFunction		m_createFunction;
+	ResourcePoolDestroyFunction		m_destroyFunction;
+	std::vector<PooledResource>		m_pooledResources;
+	uint64_t						m_frameNumber				=	0;
+	uint64_t						m_completedFrameNumber		=	0;
+	ResourcePoolStats				m_stats;
+};
@@ -16,6 +16,17 @@ Shader::Shader(ShaderConfig const& config) :
 //--------------------------------------------------------------------------------------------------
 Shader::~Shader()
 {
+	if (m_renderer)
+	{
+		m_renderer->ReleaseAfterFlush(m_vertexShader);
+		m_renderer->ReleaseAfterFlush(m_pixelShader);
+		m_renderer->ReleaseAfterFlush(m_computeShader);
+		m_renderer->ReleaseAfterFlush(m_inputLayout);
+		m_vertexShader	=	nullptr;
+		m_pixelShader	=	nullptr;
+		m_computeShader	=	nullptr;
+		m_inputLayout	=	nullptr;
+	}
 	DX_SAFE_RELEASE(m_vertexShader);
 	DX_SAFE_RELEASE(m_pixelShader);
 	DX_SAFE_RELEASE(m_computeShader);
@@ -28,3 +39,17 @@ std::string const& Shader::GetName() const
 {
 	return m_config.m_name;
 }
+
+
+//--------------------------------------------------------------------------------------------------
+ShaderStatus Shader::GetStatus() const
+{
+	return m_status;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Shader::IsReady() const
+{
+	return m_status == ShaderStatus::READY;
+}
@@ -10,6 +10,7 @@ struct ID3D11ComputeShader;
 struct ID3D11VertexShader;
 struct ID3D11PixelShader;
 struct ID3D11InputLayout;
+class  Renderer;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -22,6 +23,15 @@ struct ShaderConfig
 };
 
 
+//--------------------------------------------------------------------------------------------------
+enum class ShaderStatus : unsigned char
+{
+	COMPILING,		// Requested from the ShaderCompileQueue, binding it binds the fallback shader instead
+	READY,
+	FAILED,			// Keeps binding the fallback shader
+};
+
+
 //--------------------------------------------------------------------------------------------------
 class Shader
 {
@@ -32,7 +42,9 @@ public:
 	Shader(Shader const& copy) = delete;
 	~Shader();
 
-	std::string const& GetName() const;
+	std::string const&	GetName() const;
+	ShaderStatus		GetStatus() const;
+	bool				IsReady() const;
 
 public:
 	ShaderConfig			m_config;
@@ -40,4 +52,7 @@ public:
 	ID3D11PixelShader*		m_pixelShader		=	nullptr;
 	ID3D11ComputeShader*	m_computeShader		=	nullptr;
 	ID3D11InputLayout*		m_inputLayout		=	nullptr;
+	ShaderStatus			m_status			=	ShaderStatus::READY;
+	Shader*					m_fallbackShader	=	nullptr;		// Bound while not READY, the default shader if null, compute shaders skip their dispatches instead
+	Renderer*				m_renderer			=	nullptr;		// Set by the Renderer that made the stages, which releases them once no recorded command refers to them
 };
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "Engine/Renderer/ShaderCache.hpp"
+#include "Engine/Core/MemoryMappedFile.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/HashUtils.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <string.h>
+
+
+//--------------------------------------------------------------------------------------------------
+static constexpr uint64_t SHADER_CACHE_KEY_CHECK_SEED = 0x9E3779B97F4A7C15ull;
+static std::atomic<uint32_t> s_nextTempFileIndex = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+// Length prefixed so "ab" + "c" and "a" + "bc" hash differently
+static void HashKeyString(XXHash64& hasher, char const* text, size_t length)
+{
+	uint64_t length64 = (uint64_t)length;
+	hasher.Update(&length64, sizeof(length64));
+	hasher.Update(text, length);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+static void AppendBytes(std::vector<unsigned char>& bytes, void const* data, size_t numOfBytes)
+{
+	unsigned char const* dataBytes = reinterpret_cast<unsigned char const*>(data);
+	bytes.insert(bytes.end(), dataBytes, dataBytes + numOfBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ShaderCache::ShaderCache(std::string const& folder) :
+	m_folder(folder)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool ShaderCache::GetOrCompile(ShaderCompileDesc const& desc, ShaderCompileFunction const& compileFunction, std::vector<unsigned char>& out_byteCode)
+{
+	// An empty folder turns the cache off, every shader compiles
+	std::vector<std::string> includedFiles;
+	if (m_folder.empty())
+	{
+		return compileFunction(out_byteCode, includedFiles);
+	}
+
+	double		timeBeforeLoad	=	GetCurrentTimeSeconds();
+	uint64_t	key				=	ComputeKey(desc);
+	uint64_t	keyCheck		=	ComputeKey(desc, SHADER_CACHE_KEY_CHECK_SEED);
+	std::string	fileName		=	GetCacheFileName(desc, key);
+	bool		wasRejected		=	false;
+	bool		isHit			=	LoadEntry(fileName, key, keyCheck, out_byteCode, wasRejected);
+	double		loadSeconds		=	GetCurrentTimeSeconds() - timeBeforeLoad;
+	if (isHit)
+	{
+		std::lock_guard<std::mutex> statsLock(m_statsMutex);
+		m_stats.m_secondsLoading	+=	loadSeconds;
+		m_stats.m_numOfHits			+=	1;
+		return true;
+	}
+
+	double timeBeforeCompile = GetCurrentTimeSeconds();
+	if (!compileFunction(out_byteCode, includedFiles))
+	{
+		return false;
+	}
+	double	compileSeconds	=	GetCurrentTimeSeconds() - timeBeforeCompile;
+	bool	wasWritten		=	WriteEntry(fileName, key, keyCheck, out_byteCode, includedFiles);
+
+	std::lock_guard<std::mutex> statsLock(m_statsMutex);
+	m_stats.m_secondsLoading		+=	loadSeconds;
+	m_stats.m_numOfMisses			+=	1;
+	m_stats.m_numOfRejectedFiles	+=	wasRejected ? 1 : 0;
+	m_stats.m_secondsCompiling		+=	compileSeconds;
+	m_stats.m_numOfFailedWrites		+=	wasWritten ? 0 : 1;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ShaderCacheStats ShaderCache::GetStats() const
+{
+	std::lock_guard<std::mutex> statsLock(m_statsMutex);
+	return m_stats;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint64_t ShaderCache::ComputeKey(ShaderCompileDesc const& desc, uint64_t seed)
+{
+	XXHash64 hasher(seed);
+	HashKeyString(hasher, desc.m_source, strlen(desc.m_source));
+	HashKeyString(hasher, desc.m_entryPoint, strlen(desc.m_entryPoint));
+	HashKeyString(hasher, desc.m_target, strlen(desc.m_target));
+	hasher.Update(&desc.m_compileFlags, sizeof(desc.m_compileFlags));
+	hasher.Update(&desc.m_compilerVersion, sizeof(desc.m_compilerVersion));
+
+	uint64_t numOfDefines = (uint64_t)desc.m_defines.size();
+	hasher.Update(&numOfDefines, sizeof(numOfDefines));
+	for (size_t defineIndex = 0; defineIndex < desc.m_defines.size(); ++defineIndex)
+	{
+		ShaderDefine const& define = desc.m_defines[defineIndex];
+		HashKeyString(hasher, define.m_name.c_str(), define.m_name.size());
+		HashKeyString(hasher, define.m_value.c_str(), define.m_value.size());
+	}
+	return hasher.GetHash();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// "Data/Shaders/Default", VertexMain, vs_5_0 -> "Cache/Shaders/Data_Shaders_Default.VertexMain.vs_5_0.<key>.shc"
+// The name only keeps the folder readable, the key alone decides what the file holds
+std::string ShaderCache::GetCacheFileName(ShaderCompileDesc const& desc, uint64_t key) const
+{
+	std::string flattenedName = desc.m_name;
+	for (size_t charIndex = 0; charIndex < flattenedName.size(); ++charIndex)
+	{
+		char& character = flattenedName[charIndex];
+		if (character == '/' || character == '\\' || character == ':')
+		{
+			character = '_';
+		}
+	}
+	return m_folder + flattenedName + "." + desc.m_entryPoint + "." + desc.m_target + Stringf(".%016llx.shc", (unsigned long long)key);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool ShaderCache::LoadEntry(std::string const& fileName, uint64_t key, uint64_t keyCheck, std::vector<unsigned char>& out_byteCode, bool& out_wasRejected) const
+{
+	out_wasRejected = false;
+	MemoryMappedFile file;
+	if (!file.Open(fileName))
+	{
+		return false;
+	}
+
+	// Anything wrong past this point means the file is there but can not be used
+	out_wasRejected = true;
+	if (file.GetSize() < sizeof(ShaderCacheHeader))
+	{
+		return false;
+	}
+	ShaderCacheHeader header;
+	memcpy(&header, file.GetData(), sizeof(ShaderCacheHeader));
+	if (header.m_fourCC != SHADER_CACHE_FOURCC || header.m_version != SHADER_CACHE_VERSION || header.m_key != key || header.m_keyCheck != keyCheck)
+	{
+		return false;
+	}
+
+	unsigned char const*	contents		=	file.GetData() + sizeof(ShaderCacheHeader);
+	size_t					contentsSize	=	file.GetSize() - sizeof(ShaderCacheHeader);
+	if (contentsSize < header.m_byteCodeSize || ComputeCRC32C(contents, contentsSize) != header.m_contentsCRC)
+	{
+		return false;
+	}
+
+	size_t readOffset = 0;
+	size_t includesSize = contentsSize - header.m_byteCodeSize;
+	for (uint32_t includeIndex = 0; includeIndex < header.m_numOfIncludes; ++includeIndex)
+	{
+		uint64_t includeHash	=	0;
+		uint32_t pathLength		=	0;
+		if (readOffset + sizeof(includeHash) + sizeof(pathLength) > includesSize)
+		{
+			return false;
+		}
+		memcpy(&includeHash, contents + readOffset, sizeof(includeHash));
+		memcpy(&pathLength, contents + readOffset + sizeof(includeHash), sizeof(pathLength));
+		readOffset += sizeof(includeHash) + sizeof(pathLength);
+		if (readOffset + pathLength > includesSize)
+		{
+			return false;
+		}
+
+		std::string	includePath(reinterpret_cast<char const*>(contents + readOffset), pathLength);
+		uint64_t	currentHash	=	0;
+		readOffset += pathLength;
+		if (!ComputeFileXXHash64(includePath, currentHash) || currentHash != includeHash)
+		{
+			return false;
+		}
+	}
+	if (readOffset != includesSize)
+	{
+		return false;
+	}
+
+	out_byteCode.assign(contents + includesSize, contents + contentsSize);
+	out_wasRejected = false;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Writes to a temporary file first and renames it, a failed or interrupted write never leaves a half written entry behind
+// Two threads compiling the same key write different temporary files and the last rename wins with identical bytes
+bool ShaderCache::WriteEntry(std::string const& fileName, uint64_t key, uint64_t keyCheck, std::vector<unsigned char> const& byteCode, std::vector<std::string> const& includedFiles) const
+{
+	ShaderCacheHeader header;
+	header.m_key			=	key;
+	header.m_keyCheck		=	keyCheck;
+	header.m_numOfIncludes	=	(uint32_t)includedFiles.size();
+	header.m_byteCodeSize	=	(uint32_t)byteCode.size();
+
+	std::vector<unsigned char> fileBytes(sizeof(ShaderCacheHeader));
+	for (size_t includeIndex = 0; includeIndex < includedFiles.size(); ++includeIndex)
+	{
+		std::string const&	includePath		=	includedFiles[includeIndex];
+		uint64_t			includeHash		=	0;
+		uint32_t			pathLength		=	(uint32_t)includePath.size();
+		if (!ComputeFileXXHash64(includePath, includeHash))
+		{
+			return false;
+		}
+		AppendBytes(fileBytes, &includeHash, sizeof(includeHash));
+		AppendBytes(fileBytes, &pathLength, sizeof(pathLength));
+		AppendBytes(fileBytes, includePath.data(), includePath.size());
+	}
+	AppendBytes(fileBytes, byteCode.data(), byteCode.size());
+	header.m_contentsCRC = ComputeCRC32C(fileBytes.data() + sizeof(ShaderCacheHeader), fileBytes.size() - sizeof(ShaderCacheHeader));
+	memcpy(fileBytes.data(), &header, sizeof(ShaderCacheHeader));
+
+	std::error_code errorCode;
+	std::filesystem::create_directories(m_folder, errorCode);
+
+	std::string		tempFileName	=	fileName + Stringf(".%u.tmp", s_nextTempFileIndex.fetch_add(1));
+	std::ofstream	file(tempFileName, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+	file.write(reinterpret_cast<char const*>(fileBytes.data()), (std::streamsize)fileBytes.size());
+	file.close();
+	bool wasWritten = !file.fail();
+	if (wasWritten)
+	{
+		std::filesystem::rename(tempFileName, fileName, errorCode);
+		wasWritten = !errorCode;
+	}
+	if (!wasWritten)
+	{
+		std::filesystem::remove(tempFileName, errorCode);
+	}
+	return wasWritten;
+}
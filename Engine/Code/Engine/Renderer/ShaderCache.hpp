@@ -0,0 +1,97 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+
+//--------------------------------------------------------------------------------------------------
+constexpr uint32_t		SHADER_CACHE_FOURCC		=	0x48434853;				// "SHCH" read as little endian
+constexpr uint32_t		SHADER_CACHE_VERSION	=	1;
+constexpr char const*	SHADER_CACHE_FOLDER		=	"Cache/Shaders/";
+
+
+//--------------------------------------------------------------------------------------------------
+struct ShaderDefine
+{
+	std::string		m_name;
+	std::string		m_value;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Everything that changes the bytecode the compiler produces, all of it goes into the cache key
+struct ShaderCompileDesc
+{
+	char const*					m_name				=	"";
+	char const*					m_source			=	"";
+	char const*					m_entryPoint		=	"";
+	char const*					m_target			=	"";
+	uint32_t					m_compileFlags		=	0;
+	uint32_t					m_compilerVersion	=	0;
+	std::vector<ShaderDefine>	m_defines;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Starts every cache file, m_numOfIncludes include records then m_byteCodeSize bytes of bytecode follow
+// An include record is its content hash, the length of its path and the path, the hash is checked against the file on load
+struct ShaderCacheHeader
+{
+	uint32_t	m_fourCC				=	SHADER_CACHE_FOURCC;
+	uint32_t	m_version				=	SHADER_CACHE_VERSION;
+	uint64_t	m_key					=	0;
+	uint64_t	m_keyCheck				=	0;		// The key hashed with another seed, two different keys matching both is not a concern
+	uint32_t	m_numOfIncludes			=	0;
+	uint32_t	m_byteCodeSize			=	0;
+	uint32_t	m_contentsCRC			=	0;		// CRC32C of everything after the header
+	uint32_t	m_padding				=	0;
+};
+static_assert(sizeof(ShaderCacheHeader) == 40, "ShaderCacheHeader is written to disk as is, bump SHADER_CACHE_VERSION when changing it");
+
+
+//--------------------------------------------------------------------------------------------------
+struct ShaderCacheStats
+{
+	int			m_numOfHits				=	0;
+	int			m_numOfMisses			=	0;
+	int			m_numOfRejectedFiles	=	0;		// Misses whose file was there but malformed, corrupt or had an include change
+	int			m_numOfFailedWrites		=	0;		// Misses that compiled but could not write their file
+	double		m_secondsLoading		=	0.0;
+	double		m_secondsCompiling		=	0.0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Compiles the shader on a miss, out_includedFiles lists every file the source pulled in so changing one invalidates the entry
+typedef std::function<bool(std::vector<unsigned char>& out_byteCode, std::vector<std::string>& out_includedFiles)> ShaderCompileFunction;
+
+
+//--------------------------------------------------------------------------------------------------
+// Bytecode on disk, one file per key, knows nothing about the compiler so it works with any compile function
+// GetOrCompile may run on several job threads at once, the stats are guarded and each writer uses its own temporary file
+class ShaderCache
+{
+public:
+	explicit ShaderCache(std::string const& folder = SHADER_CACHE_FOLDER);
+
+	// Loads the bytecode if a valid entry exists, otherwise compiles and writes it, false only if compiling failed
+	bool					GetOrCompile(ShaderCompileDesc const& desc, ShaderCompileFunction const& compileFunction, std::vector<unsigned char>& out_byteCode);
+	ShaderCacheStats		GetStats() const;
+
+	static uint64_t			ComputeKey(ShaderCompileDesc const& desc, uint64_t seed = 0);
+	std::string				GetCacheFileName(ShaderCompileDesc const& desc, uint64_t key) const;
+
+private:
+	bool	LoadEntry(std::string const& fileName, uint64_t key, uint64_t keyCheck, std::vector<unsigned char>& out_byteCode, bool& out_wasRejected) const;
+	bool	WriteEntry(std::string const& fileName, uint64_t key, uint64_t keyCheck, std::vector<unsigned char> const& byteCode, std::vector<std::string> const& includedFiles) const;
+
+private:
+	std::string			m_folder;
+	mutable std::mutex	m_statsMutex;
+	ShaderCacheStats	m_stats;
+};
@@ -0,0 +1,128 @@
+#include "Engine/Renderer/ShaderCacheCheck.hpp"
+#include "Engine/Renderer/ShaderCache.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Core/DevConsole.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <filesystem>
+#include <fstream>
+
+
+//--------------------------------------------------------------------------------------------------
+static constexpr size_t STUB_BYTE_CODE_SIZE = 64;
+
+
+//--------------------------------------------------------------------------------------------------
+static bool WriteCheckFile(std::string const& fileName, std::string const& contents)
+{
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+	file.write(contents.data(), (std::streamsize)contents.size());
+	file.close();
+	return !file.fail();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The last byte is bytecode, so only the contents CRC can catch it
+static bool FlipLastByte(std::string const& fileName)
+{
+	std::fstream file(fileName, std::ios::binary | std::ios::in | std::ios::out);
+	if (!file.is_open())
+	{
+		return false;
+	}
+	char lastByte = 0;
+	file.seekg(-1, std::ios::end);
+	file.read(&lastByte, 1);
+	lastByte = (char)~lastByte;
+	file.seekp(-1, std::ios::end);
+	file.write(&lastByte, 1);
+	file.close();
+	return !file.fail();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Command_ShaderCacheCheck(EventArgs& args)
+{
+	// An empty folder turns the cache off, so there would be nothing to check
+	std::string folder = args.GetValue("Folder", "Cache/ShaderCacheCheck/");
+	if (folder.empty())
+	{
+		return false;
+	}
+	if (folder.back() != '/' && folder.back() != '\\')
+	{
+		folder += '/';
+	}
+	std::error_code errorCode;
+	std::filesystem::remove_all(folder, errorCode);
+	std::filesystem::create_directories(folder, errorCode);
+
+	std::string includeFileName = folder + "ShaderCacheCheck.hlsli";
+	if (!WriteCheckFile(includeFileName, "float4 g_tint;\n"))
+	{
+		PrintBenchmarkResult(Stringf("Shader cache check: could not write %s", includeFileName.c_str()), true);
+		return false;
+	}
+
+	ShaderCompileDesc desc;
+	desc.m_name			=	"ShaderCacheCheck";
+	desc.m_source		=	"#include \"ShaderCacheCheck.hlsli\"\nfloat4 PixelMain() : SV_Target0 { return g_tint; }\n";
+	desc.m_entryPoint	=	"PixelMain";
+	desc.m_target		=	"ps_5_0";
+
+	// Every compile fills the bytecode with its own count, so a load is told apart from a recompile by the bytes alone
+	int						numOfCompiles	=	0;
+	ShaderCompileFunction	stubCompiler	=	[&](std::vector<unsigned char>& out_byteCode, std::vector<std::string>& out_includedFiles)
+	{
+		numOfCompiles += 1;
+		out_byteCode.assign(STUB_BYTE_CODE_SIZE, (unsigned char)numOfCompiles);
+		out_includedFiles.push_back(includeFileName);
+		return true;
+	};
+
+	ShaderCache	shaderCache(folder);
+	bool		areAllPassed	=	true;
+	auto		checkStep		=	[&](char const* stepName, bool shouldCompile, bool shouldReject)
+	{
+		ShaderCacheStats			statsBefore		=	shaderCache.GetStats();
+		int							compilesBefore	=	numOfCompiles;
+		std::vector<unsigned char>	byteCode;
+		bool						hasByteCode		=	shaderCache.GetOrCompile(desc, stubCompiler, byteCode);
+		ShaderCacheStats			statsAfter		=	shaderCache.GetStats();
+		bool						didCompile		=	numOfCompiles != compilesBefore;
+		bool						wasRejected		=	statsAfter.m_numOfRejectedFiles != statsBefore.m_numOfRejectedFiles;
+		bool						wasWritten		=	statsAfter.m_numOfFailedWrites == statsBefore.m_numOfFailedWrites;
+		bool						isLatest		=	byteCode == std::vector<unsigned char>(STUB_BYTE_CODE_SIZE, (unsigned char)numOfCompiles);
+		bool						isPassed		=	hasByteCode && didCompile == shouldCompile && wasRejected == shouldReject && wasWritten && isLatest;
+		areAllPassed = areAllPassed && isPassed;
+		PrintBenchmarkResult(Stringf("%-24s %-9s %s", stepName, didCompile ? (wasRejected ? "rejected" : "compiled") : "loaded", isPassed ? "passed" : "FAILED"), !isPassed);
+	};
+
+	PrintBenchmarkResult(Stringf("Shader cache check in %s", folder.c_str()));
+	checkStep("Empty folder", true, false);
+	checkStep("Unchanged", false, false);
+
+	std::string cacheFileName = shaderCache.GetCacheFileName(desc, ShaderCache::ComputeKey(desc));
+	std::filesystem::resize_file(cacheFileName, sizeof(ShaderCacheHeader) + 4, errorCode);
+	checkStep("Truncated entry", true, true);
+
+	FlipLastByte(cacheFileName);
+	checkStep("Corrupt bytecode", true, true);
+
+	WriteCheckFile(includeFileName, "float4 g_tint;\nfloat g_exposure;\n");
+	checkStep("Include changed", true, true);
+	checkStep("Unchanged again", false, false);
+
+	desc.m_defines.push_back({ "USE_EXPOSURE", "1" });
+	checkStep("Define added", true, false);
+
+	std::filesystem::remove_all(folder, errorCode);
+	return areAllPassed;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Core/EventSystem.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+// Runs ShaderCache::GetOrCompile with a stub compiler in a scratch folder, through a miss, a hit, a truncated entry, a corrupt
+// entry, a changed include and a new define, and checks each one loaded or compiled when it should
+bool Command_ShaderCacheCheck(EventArgs& args);
@@ -0,0 +1,281 @@
+#include "Engine/Renderer/ShaderCompileQueue.hpp"
+#include "Engine/Renderer/Shader.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/FileUtils.hpp"
+#include "Engine/Core/JobSystem.hpp"
+#include "Engine/Core/Time.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+ShaderCompileQueue* g_theShaderCompileQueue = nullptr;
+
+
+//--------------------------------------------------------------------------------------------------
+// Compiles one stage on a job worker, or on the main thread when RetrieveCompiledStages has to wait for it and no worker took it yet
+// The request's source is not touched by the main thread while the job is out, the bytecode only once the job is retrieved
+class ShaderCompileJob : public Job
+{
+public:
+	ShaderCompileJob(Renderer* renderer, ShaderCompileRequest* request, char const* entryPoint, char const* target, std::vector<unsigned char>& out_byteCode) :
+		m_renderer(renderer), m_request(request), m_entryPoint(entryPoint), m_target(target), m_byteCode(out_byteCode) {};
+	virtual void Execute() override;
+
+public:
+	Renderer*					m_renderer		=	nullptr;
+	ShaderCompileRequest*		m_request		=	nullptr;
+	char const*					m_entryPoint	=	"";
+	char const*					m_target		=	"";
+	std::vector<unsigned char>&	m_byteCode;
+	bool						m_isCompiled	=	false;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCompileJob::Execute()
+{
+	std::string const& shaderName = m_request->m_shader->GetName();
+	m_isCompiled = m_renderer->TryCompileShaderToByteCode(m_byteCode, shaderName.c_str(), m_request->m_source.c_str(), m_entryPoint, m_target);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ShaderCompileQueue::ShaderCompileQueue(ShaderCompileQueueConfig const& config) :
+	m_config(config)
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ShaderCompileQueue::~ShaderCompileQueue()
+{
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCompileQueue::Startup()
+{
+	GUARANTEE_OR_DIE(m_config.m_renderer && m_config.m_jobSystem, "The shader compile queue needs a renderer and a job system");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCompileQueue::Update()
+{
+	bool hasNoWorkers = m_config.m_jobSystem->GetNumOfWorkerThreads() == 0;
+	RetrieveCompiledStages(hasNoWorkers);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The shaders themselves belong to the renderer, anything still compiling is left COMPILING for it to free
+void ShaderCompileQueue::Shutdown()
+{
+	// The jobs read the requests' source and write their bytecode, so they have to be done before a request is freed
+	std::vector<Job*> compileJobs(m_compileJobs.begin(), m_compileJobs.end());
+	m_config.m_jobSystem->WaitUntilJobsCompleted(compileJobs);
+	for (size_t jobIndex = 0; jobIndex < m_compileJobs.size(); ++jobIndex)
+	{
+		delete m_compileJobs[jobIndex];
+	}
+	m_compileJobs.clear();
+
+	for (size_t requestIndex = 0; requestIndex < m_requests.size(); ++requestIndex)
+	{
+		delete m_requests[requestIndex];
+	}
+	m_requests.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Shader* ShaderCompileQueue::RequestShader(char const* shaderName, InputLayout const& inputLayout, bool isUsedForInstancedRendering)
+{
+	Shader* existingShader = m_config.m_renderer->GetShaderForName(shaderName);
+	if (existingShader)
+	{
+		return existingShader;
+	}
+
+	Shader*					shader	=	m_config.m_renderer->CreatePendingShader(shaderName, m_config.m_fallbackShader);
+	ShaderCompileRequest*	request	=	CreateRequest(shader, false);
+	if (request)
+	{
+		ShaderConfig const& shaderConfig		=	request->m_shader->m_config;
+		request->m_inputLayout					=	inputLayout;
+		request->m_isUsedForInstancedRendering	=	isUsedForInstancedRendering;
+		QueueStage(request, shaderConfig.m_vertexEntryPoint.c_str(), "vs_5_0", request->m_vertexShaderByteCode);
+		QueueStage(request, shaderConfig.m_pixelEntryPoint.c_str(), "ps_5_0", request->m_pixelShaderByteCode);
+	}
+	return shader;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+Shader* ShaderCompileQueue::RequestComputeShader(char const* shaderName)
+{
+	Shader* existingShader = m_config.m_renderer->GetShaderForName(shaderName);
+	if (existingShader)
+	{
+		return existingShader;
+	}
+
+	Shader*					shader	=	m_config.m_renderer->CreatePendingShader(shaderName, m_config.m_fallbackShader);
+	ShaderCompileRequest*	request	=	CreateRequest(shader, true);
+	if (request)
+	{
+		ShaderConfig const& shaderConfig = request->m_shader->m_config;
+		QueueStage(request, shaderConfig.m_computeShaderEntryPoint.c_str(), "cs_5_0", request->m_computeShaderByteCode);
+	}
+	return shader;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCompileQueue::WaitUntilAllCompiled()
+{
+	while (GetNumOfShadersInFlight() > 0)
+	{
+		RetrieveCompiledStages(true);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int ShaderCompileQueue::GetNumOfShadersInFlight() const
+{
+	return (int)m_requests.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+ShaderCompileQueueConfig const& ShaderCompileQueue::GetConfig() const
+{
+	return m_config;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The file is read here so a missing one fails right away, null if it did and the shader is marked FAILED
+ShaderCompileRequest* ShaderCompileQueue::CreateRequest(Shader* shader, bool isComputeShader)
+{
+	std::string shaderFilePath = shader->GetName() + ".hlsl";
+	std::string shaderSource;
+	// FileReadToString dies on a missing file, a missing shader should only fail its own request
+	if (!DoesFileExist(shaderFilePath) || FileReadToString(shaderSource, shaderFilePath) == 0)
+	{
+		DebuggerPrintf("\nShaderCompileQueue: failed to read the shader file \"%s\"\n", shaderFilePath.c_str());
+		shader->m_status = ShaderStatus::FAILED;
+		return nullptr;
+	}
+
+	if (m_requests.empty())
+	{
+		m_timeOfFirstRequest	=	GetCurrentTimeSeconds();
+		m_numOfShadersRequested	=	0;
+	}
+	ShaderCompileRequest* request	=	new ShaderCompileRequest();
+	request->m_shader				=	shader;
+	request->m_source				=	std::move(shaderSource);
+	request->m_isComputeShader		=	isComputeShader;
+	m_requests.push_back(request);
+	m_numOfShadersRequested += 1;
+	return request;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void ShaderCompileQueue::QueueStage(ShaderCompileRequest* request, char const* entryPoint, char const* target, std::vector<unsigned char>& out_byteCode)
+{
+	request->m_numOfStagesCompiling += 1;
+	ShaderCompileJob* compileJob = new ShaderCompileJob(m_config.m_renderer, request, entryPoint, target, out_byteCode);
+	m_compileJobs.push_back(compileJob);
+	m_config.m_jobSystem->QueueNewJob(compileJob);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// With waitForOne and nothing finished yet, waits on the oldest stage (which runs it on this thread if no worker has claimed it)
+void ShaderCompileQueue::RetrieveCompiledStages(bool waitForOne)
+{
+	if (waitForOne && !m_compileJobs.empty())
+	{
+		bool isAnyStageCompleted = false;
+		for (size_t jobIndex = 0; jobIndex < m_compileJobs.size() && !isAnyStageCompleted; ++jobIndex)
+		{
+			isAnyStageCompleted = m_compileJobs[jobIndex]->m_status == JOB_STATUS_COMPLETED;
+		}
+		if (!isAnyStageCompleted)
+		{
+			std::vector<Job*> oldestCompileJob = { m_compileJobs.front() };
+			m_config.m_jobSystem->WaitUntilJobsCompleted(oldestCompileJob);
+		}
+	}
+
+	for (size_t jobIndex = 0; jobIndex < m_compileJobs.size();)
+	{
+		ShaderCompileJob* compileJob = m_compileJobs[jobIndex];
+		if (compileJob->m_status == JOB_STATUS_COMPLETED)
+		{
+			// Takes it off the job system's completed list, the job is already done so this does not wait
+			std::vector<Job*> completedCompileJob = { compileJob };
+			m_config.m_jobSystem->WaitUntilJobsCompleted(completedCompileJob);
+		}
+		if (compileJob->m_status != JOB_STATUS_RETRIEVED_AND_RETIRED)
+		{
+			++jobIndex;
+			continue;
+		}
+
+		ShaderCompileRequest* request		=	compileJob->m_request;
+		request->m_hasAnyStageFailed		|=	!compileJob->m_isCompiled;
+		request->m_numOfStagesCompiling		-=	1;
+		m_compileJobs.erase(m_compileJobs.begin() + jobIndex);
+		delete compileJob;
+
+		if (request->m_numOfStagesCompiling == 0)
+		{
+			FinishRequest(request);
+		}
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// D3D device calls stay on the main thread, only the compiling went wide
+void ShaderCompileQueue::FinishRequest(ShaderCompileRequest* request)
+{
+	Shader* shader = request->m_shader;
+	if (request->m_hasAnyStageFailed)
+	{
+		DebuggerPrintf("\nShaderCompileQueue: failed to compile \"%s\", it keeps binding its fallback\n", shader->GetName().c_str());
+		shader->m_status = ShaderStatus::FAILED;
+	}
+	else
+	{
+		if (request->m_isComputeShader)
+		{
+			m_config.m_renderer->CreateComputeShaderStage(*shader, request->m_computeShaderByteCode);
+		}
+		else
+		{
+			m_config.m_renderer->CreateShaderStages(*shader, request->m_vertexShaderByteCode, request->m_pixelShaderByteCode, request->m_inputLayout, request->m_isUsedForInstancedRendering);
+		}
+		shader->m_status = ShaderStatus::READY;
+	}
+
+	for (size_t requestIndex = 0; requestIndex < m_requests.size(); ++requestIndex)
+	{
+		if (m_requests[requestIndex] == request)
+		{
+			m_requests.erase(m_requests.begin() + requestIndex);
+			break;
+		}
+	}
+	delete request;
+
+	if (m_requests.empty())
+	{
+		double secondsToCompile = GetCurrentTimeSeconds() - m_timeOfFirstRequest;
+		DebuggerPrintf("ShaderCompileQueue: %d shaders finished in %.1f ms\n", m_numOfShadersRequested, secondsToCompile * 1000.0);
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/Renderer.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <vector>
+#include <string>
+
+
+//--------------------------------------------------------------------------------------------------
+class JobSystem;
+class Shader;
+class ShaderCompileJob;
+class ShaderCompileQueue;
+
+
+//--------------------------------------------------------------------------------------------------
+extern ShaderCompileQueue* g_theShaderCompileQueue;
+
+
+//--------------------------------------------------------------------------------------------------
+// One requested shader, its stages compile as separate jobs and the D3D objects are created once the last one is retrieved
+struct ShaderCompileRequest
+{
+	Shader*			m_shader						=	nullptr;
+	std::string		m_source;
+	InputLayout		m_inputLayout					=	InputLayout::VERTEX_PCU;
+	bool			m_isUsedForInstancedRendering	=	false;
+	bool			m_isComputeShader				=	false;
+	int				m_numOfStagesCompiling			=	0;
+	bool			m_hasAnyStageFailed				=	false;
+	std::vector<unsigned char>	m_vertexShaderByteCode;
+	std::vector<unsigned char>	m_pixelShaderByteCode;
+	std::vector<unsigned char>	m_computeShaderByteCode;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct ShaderCompileQueueConfig
+{
+	Renderer*	m_renderer			=	nullptr;
+	JobSystem*	m_jobSystem			=	nullptr;
+	Shader*		m_fallbackShader	=	nullptr;		// Bound in place of shaders still compiling, the renderer's default shader if null
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Compiles every stage of every requested shader on the job system, through the renderer's shader cache
+// The requests hand back the Shader right away, it stays COMPILING (and binds the fallback) until Update creates its D3D objects
+// Requests for a shader the renderer already has return that shader, with no job workers Update compiles one stage per frame
+class ShaderCompileQueue
+{
+public:
+	ShaderCompileQueue(ShaderCompileQueueConfig const& config);
+	~ShaderCompileQueue();
+
+	void		Startup();
+	void		Update();
+	void		Shutdown();
+
+	Shader*		RequestShader(char const* shaderName, InputLayout const& inputLayout = InputLayout::VERTEX_PCU, bool isUsedForInstancedRendering = false);
+	Shader*		RequestComputeShader(char const* shaderName);
+
+	// Blocks until every request so far is READY or FAILED
+	void		WaitUntilAllCompiled();
+
+	int			GetNumOfShadersInFlight() const;
+	ShaderCompileQueueConfig const& GetConfig() const;
+
+private:
+	ShaderCompileRequest*	CreateRequest(Shader* shader, bool isComputeShader);
+	void					QueueStage(ShaderCompileRequest* request, char const* entryPoint, char const* target, std::vector<unsigned char>& out_byteCode);
+	void					RetrieveCompiledStages(bool waitForOne);
+	void					FinishRequest(ShaderCompileRequest* request);
+
+private:
+	ShaderCompileQueueConfig				m_config;
+	std::vector<ShaderCompileRequest*>		m_requests;
+	std::vector<ShaderCompileJob*>			m_compileJobs;
+	double									m_timeOfFirstRequest		=	0.0;	// Of the requests in flight, for the time it took all of them to be ready
+	int										m_numOfShadersRequested		=	0;
+};
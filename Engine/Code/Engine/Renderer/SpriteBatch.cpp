@@ -0,0 +1,317 @@
+#include "Engine/Renderer/SpriteBatch.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+static_assert(sizeof(SpriteQuad) == 36, "The sprite quad input layout expects 36 byte quads");
+
+
+//--------------------------------------------------------------------------------------------------
+static constexpr int	NUM_OF_VERTEXES_PER_QUAD	=	6;
+static char const*		SPRITE_QUAD_SHADER_NAME		=	"SpriteQuad";
+static unsigned int		QUAD_INDEXES[]				=	{ 0, 1, 2, 0, 2, 3 };
+
+
+//--------------------------------------------------------------------------------------------------
+// The indexes 0 1 2 0 2 3 reach the vertex shader as vertex IDs and pick the corners BL BR TR TL,
+// the same triangles AddVertsForAABB2D makes
+static char const* SPRITE_QUAD_SHADER_SOURCE = R"(
+//--------------------------------------------------------------------------------------------------
+struct vs_input_t
+{
+	float4	bounds		:	QUAD_BOUNDS;
+	float4	uvs			:	QUAD_UVS;
+	float4	color		:	COLOR;
+	uint	vertexID	:	SV_VertexID;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct v2p_t
+{
+	float4 position		:	SV_Position;
+	float4 color		:	COLOR;
+	float2 uv			:	TEXCOORD;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+cbuffer CameraConstants : register(b2)
+{
+	float4x4 viewToClipTransformator;
+	float4x4 worldToViewTransformator;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+cbuffer ModelConstants : register(b3)
+{
+	float4x4 localToWorldTransformator;
+	float4   modelColor;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+Texture2D diffuseTexture	: register(t0);
+
+SamplerState diffuseSampler : register(s0);
+
+
+//--------------------------------------------------------------------------------------------------
+v2p_t VertexMain(vs_input_t input)
+{
+	float2	corner			=	float2(input.vertexID == 1 || input.vertexID == 2, input.vertexID >= 2);
+	float4	localPosition	=	float4(lerp(input.bounds.xy, input.bounds.zw, corner), 0, 1);
+	float4	worldPosition	=	mul(localToWorldTransformator, localPosition);
+	float4	viewPosition	=	mul(worldToViewTransformator, worldPosition);
+
+	v2p_t v2p;
+	v2p.position			=	mul(viewToClipTransformator, viewPosition);
+	v2p.color				=	input.color * modelColor;
+	v2p.uv					=	lerp(input.uvs.xy, input.uvs.zw, corner);
+	return v2p;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+float4 PixelMain(v2p_t input) : SV_Target0
+{
+	float4 color	=	diffuseTexture.Sample(diffuseSampler, input.uv);
+	color			*=	input.color;
+	if (color.a < 0.001) discard;
+	return color;
+}
+)";
+
+
+//--------------------------------------------------------------------------------------------------
+SpriteBatch::SpriteBatch(Renderer& renderer, bool expandsQuadsOnGPU) :
+	m_renderer(renderer),
+	m_expandsQuadsOnGPU(expandsQuadsOnGPU)
+{
+	if (m_expandsQuadsOnGPU)
+	{
+		// Every GPU expanding batch shares the one shader the Renderer keeps
+		m_quadShader = m_renderer.GetShaderForName(SPRITE_QUAD_SHADER_NAME);
+		if (m_quadShader == nullptr)
+		{
+			m_quadShader = m_renderer.CreateShader(SPRITE_QUAD_SHADER_NAME, SPRITE_QUAD_SHADER_SOURCE, InputLayout::SPRITE_QUAD, true);
+		}
+		m_quadIndexBuffer = m_renderer.CreateIndexBuffer(NUM_OF_VERTEXES_PER_QUAD, ResourceUsage::GPU_READ, QUAD_INDEXES);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+SpriteBatch::~SpriteBatch()
+{
+	delete m_quadIndexBuffer;
+	m_quadIndexBuffer = nullptr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void SpriteBatch::Begin(SpriteSortMode sortMode)
+{
+	GUARANTEE_OR_DIE(!m_isBatching, "SpriteBatch::Begin called twice without End");
+	m_isBatching	=	true;
+	m_sortMode		=	sortMode;
+	m_keys.clear();
+	m_quads.clear();
+	m_quadKeyIndexes.clear();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void SpriteBatch::AddQuad(Texture const* texture, BlendMode blendMode, AABB2 const& bounds, AABB2 const& uvs, Rgba8 const& color)
+{
+	SpriteQuad quad;
+	quad.m_bounds	=	bounds;
+	quad.m_uvs		=	uvs;
+	quad.m_color	=	color;
+	AddQuads(texture, blendMode, &quad, 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void SpriteBatch::AddQuads(Texture const* texture, BlendMode blendMode, SpriteQuad const* quads, int numOfQuads)
+{
+	GUARANTEE_OR_DIE(m_isBatching, "SpriteBatch quads have to be added between Begin and End");
+	if (numOfQuads <= 0)
+	{
+		return;
+	}
+	uint32_t keyIndex = GetOrAddKeyIndex(texture, blendMode);
+	m_quads.insert(m_quads.end(), quads, quads + numOfQuads);
+	m_quadKeyIndexes.insert(m_quadKeyIndexes.end(), (size_t)numOfQuads, keyIndex);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void SpriteBatch::End()
+{
+	GUARANTEE_OR_DIE(m_isBatching, "SpriteBatch::End called without Begin");
+	m_isBatching = false;
+	if (m_quads.empty())
+	{
+		return;
+	}
+
+	std::vector<SpriteQuad> const*	quads			=	&m_quads;
+	std::vector<uint32_t> const*	quadKeyIndexes	=	&m_quadKeyIndexes;
+	if (m_sortMode == SpriteSortMode::TEXTURE && m_keys.size() > 1)
+	{
+		SortQuadsByKey();
+		quads			=	&m_sortedQuads;
+		quadKeyIndexes	=	&m_sortedQuadKeyIndexes;
+	}
+
+	BlendMode	blendModeBeforeEnd	=	m_renderer.GetBlendMode();
+	Shader*		shaderBeforeEnd		=	m_renderer.GetCurrentShader();
+	if (m_expandsQuadsOnGPU)
+	{
+		m_renderer.BindShader(m_quadShader);
+	}
+
+	int numOfQuads		=	(int)quads->size();
+	int firstQuadOfRun	=	0;
+	for (int quadIndex = 1; quadIndex <= numOfQuads; ++quadIndex)
+	{
+		if (quadIndex < numOfQuads && (*quadKeyIndexes)[quadIndex] == (*quadKeyIndexes)[firstQuadOfRun])
+		{
+			continue;
+		}
+		DrawRun((*quadKeyIndexes)[firstQuadOfRun], quads->data() + firstQuadOfRun, quadIndex - firstQuadOfRun);
+		firstQuadOfRun = quadIndex;
+	}
+
+	if (m_expandsQuadsOnGPU)
+	{
+		m_renderer.BindShader(shaderBeforeEnd);
+	}
+	if (blendModeBeforeEnd != BlendMode::INVALID)
+	{
+		m_renderer.SetBlendMode(blendModeBeforeEnd);
+	}
+	else
+	{
+		m_renderer.SetCustomBlendMode();
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool SpriteBatch::IsExpandingQuadsOnGPU() const
+{
+	return m_expandsQuadsOnGPU;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+SpriteBatchStats const& SpriteBatch::GetStats() const
+{
+	return m_stats;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void SpriteBatch::ResetStats()
+{
+	m_stats = SpriteBatchStats();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Text adds long runs with one key, so the last key is checked before the rest
+uint32_t SpriteBatch::GetOrAddKeyIndex(Texture const* texture, BlendMode blendMode)
+{
+	if (!m_keys.empty() && m_keys.back().m_texture == texture && m_keys.back().m_blendMode == blendMode)
+	{
+		return (uint32_t)m_keys.size() - 1;
+	}
+
+	// Deferred batches only merge neighbours, so an earlier key is never reused
+	if (m_sortMode == SpriteSortMode::TEXTURE)
+	{
+		for (uint32_t keyIndex = 0; keyIndex < (uint32_t)m_keys.size(); ++keyIndex)
+		{
+			if (m_keys[keyIndex].m_texture == texture && m_keys[keyIndex].m_blendMode == blendMode)
+			{
+				return keyIndex;
+			}
+		}
+	}
+
+	BatchKey key;
+	key.m_texture	=	texture;
+	key.m_blendMode	=	blendMode;
+	m_keys.push_back(key);
+	return (uint32_t)m_keys.size() - 1;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Counting sort on the key index, stable so each group keeps its quads in the order they were added
+void SpriteBatch::SortQuadsByKey()
+{
+	std::vector<uint32_t> firstQuadOfKey(m_keys.size() + 1, 0);
+	for (size_t quadIndex = 0; quadIndex < m_quadKeyIndexes.size(); ++quadIndex)
+	{
+		firstQuadOfKey[m_quadKeyIndexes[quadIndex] + 1] += 1;
+	}
+	for (size_t keyIndex = 1; keyIndex < firstQuadOfKey.size(); ++keyIndex)
+	{
+		firstQuadOfKey[keyIndex] += firstQuadOfKey[keyIndex - 1];
+	}
+
+	m_sortedQuads.resize(m_quads.size());
+	m_sortedQuadKeyIndexes.resize(m_quads.size());
+	for (size_t quadIndex = 0; quadIndex < m_quads.size(); ++quadIndex)
+	{
+		uint32_t keyIndex						=	m_quadKeyIndexes[quadIndex];
+		uint32_t sortedIndex					=	firstQuadOfKey[keyIndex]++;
+		m_sortedQuads[sortedIndex]				=	m_quads[quadIndex];
+		m_sortedQuadKeyIndexes[sortedIndex]		=	keyIndex;
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void SpriteBatch::DrawRun(uint32_t keyIndex, SpriteQuad const* quads, int numOfQuads)
+{
+	BatchKey const& key = m_keys[keyIndex];
+	m_renderer.SetBlendMode(key.m_blendMode);
+	m_renderer.BindTexture(key.m_texture);
+
+	m_stats.m_numOfQuads	+=	(uint64_t)numOfQuads;
+	m_stats.m_numOfDraws	+=	1;
+	if (m_expandsQuadsOnGPU)
+	{
+		m_renderer.DrawInstancedArray(numOfQuads, quads, sizeof(SpriteQuad), m_quadIndexBuffer, NUM_OF_VERTEXES_PER_QUAD);
+		m_stats.m_numOfBytesUploaded += (uint64_t)numOfQuads * sizeof(SpriteQuad);
+		return;
+	}
+
+	m_vertexes.resize((size_t)numOfQuads * NUM_OF_VERTEXES_PER_QUAD);
+	Vertex_PCU* vertexes = m_vertexes.data();
+	for (int quadIndex = 0; quadIndex < numOfQuads; ++quadIndex)
+	{
+		SpriteQuad const&	quad	=	quads[quadIndex];
+		Vec2 const&			mins	=	quad.m_bounds.m_mins;
+		Vec2 const&			maxs	=	quad.m_bounds.m_maxs;
+		Vec2 const&			uvMins	=	quad.m_uvs.m_mins;
+		Vec2 const&			uvMaxs	=	quad.m_uvs.m_maxs;
+
+		Vertex_PCU bottomLeft	=	Vertex_PCU(Vec3(mins.x, mins.y, 0.f), quad.m_color, Vec2(uvMins.x, uvMins.y));
+		Vertex_PCU topRight		=	Vertex_PCU(Vec3(maxs.x, maxs.y, 0.f), quad.m_color, Vec2(uvMaxs.x, uvMaxs.y));
+		*vertexes++ = bottomLeft;
+		*vertexes++ = Vertex_PCU(Vec3(maxs.x, mins.y, 0.f), quad.m_color, Vec2(uvMaxs.x, uvMins.y));
+		*vertexes++ = topRight;
+		*vertexes++ = bottomLeft;
+		*vertexes++ = topRight;
+		*vertexes++ = Vertex_PCU(Vec3(mins.x, maxs.y, 0.f), quad.m_color, Vec2(uvMins.x, uvMaxs.y));
+	}
+	m_renderer.DrawVertexArray((int)m_vertexes.size(), m_vertexes.data());
+	m_stats.m_numOfBytesUploaded += (uint64_t)m_vertexes.size() * sizeof(Vertex_PCU);
+}
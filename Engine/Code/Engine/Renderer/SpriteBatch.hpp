@@ -0,0 +1,91 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Core/Rgba8.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+class Shader;
+class Texture;
+class IndexBuffer;
+
+
+//--------------------------------------------------------------------------------------------------
+// An axis aligned quad in the XY plane, 36 bytes instead of the 144 of its 6 Vertex_PCUs
+struct SpriteQuad
+{
+	AABB2	m_bounds;
+	AABB2	m_uvs		=	AABB2::ZERO_TO_ONE;
+	Rgba8	m_color		=	Rgba8::WHITE;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+enum class SpriteSortMode : unsigned char
+{
+	DEFERRED,		// Submission order, only neighbouring quads with the same texture and blend mode share a draw
+	TEXTURE,		// Grouped by texture and blend mode in the order each was first added, for quads that do not overlap other groups
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct SpriteBatchStats
+{
+	uint64_t	m_numOfQuads			=	0;
+	uint64_t	m_numOfDraws			=	0;
+	uint64_t	m_numOfBytesUploaded	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Collects 2D quads between Begin and End and draws each run with the same texture and blend mode in one draw
+// Quads are expanded to Vertex_PCUs on the CPU, or with expandsQuadsOnGPU drawn as instances the vertex shader expands
+// End draws with the camera, model constants, sampler, rasterizer and depth modes already set, and restores the blend mode
+class SpriteBatch
+{
+public:
+	explicit SpriteBatch(Renderer& renderer, bool expandsQuadsOnGPU = false);
+	~SpriteBatch();
+
+	void		Begin(SpriteSortMode sortMode = SpriteSortMode::DEFERRED);
+	void		AddQuad(Texture const* texture, BlendMode blendMode, AABB2 const& bounds, AABB2 const& uvs = AABB2::ZERO_TO_ONE, Rgba8 const& color = Rgba8::WHITE);
+	void		AddQuads(Texture const* texture, BlendMode blendMode, SpriteQuad const* quads, int numOfQuads);
+	void		End();
+
+	bool					IsExpandingQuadsOnGPU() const;
+	SpriteBatchStats const&	GetStats() const;
+	void					ResetStats();
+
+private:
+	struct BatchKey
+	{
+		Texture const*	m_texture		=	nullptr;
+		BlendMode		m_blendMode		=	BlendMode::ALPHA;
+	};
+
+	uint32_t	GetOrAddKeyIndex(Texture const* texture, BlendMode blendMode);
+	void		SortQuadsByKey();
+	void		DrawRun(uint32_t keyIndex, SpriteQuad const* quads, int numOfQuads);
+
+private:
+	Renderer&					m_renderer;
+	Shader*						m_quadShader			=	nullptr;		// Owned by the Renderer
+	IndexBuffer*				m_quadIndexBuffer		=	nullptr;
+	bool						m_expandsQuadsOnGPU		=	false;
+	bool						m_isBatching			=	false;
+	SpriteSortMode				m_sortMode				=	SpriteSortMode::DEFERRED;
+	std::vector<BatchKey>		m_keys;
+	std::vector<SpriteQuad>		m_quads;
+	std::vector<uint32_t>		m_quadKeyIndexes;
+	std::vector<SpriteQuad>		m_sortedQuads;
+	std::vector<uint32_t>		m_sortedQuadKeyIndexes;
+	std::vector<Vertex_PCU>		m_vertexes;
+	SpriteBatchStats			m_stats;
+};
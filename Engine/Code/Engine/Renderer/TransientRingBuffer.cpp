@@ -0,0 +1,176 @@
+#include "Engine/Renderer/TransientRingBuffer.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+
+//--------------------------------------------------------------------------------------------------
+TransientRingBuffer::TransientRingBuffer(uint32_t initialSizeBytes)
+{
+	GUARANTEE_OR_DIE(initialSizeBytes > 0, "Transient ring buffer needs a size");
+	m_bytes.resize(initialSizeBytes);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool TransientRingBuffer::Allocate(uint32_t numOfBytes, uint32_t alignment, TransientAllocation& out_allocation)
+{
+	// With every frame retired the whole ring is free, starting over at 0 keeps it in one piece
+	if (m_numOfBytesInUse == 0)
+	{
+		m_head			=	0;
+		m_tail			=	0;
+		m_uploadedHead	=	0;
+		m_hasWrapped	=	false;
+	}
+
+	uint32_t	size			=	(uint32_t)m_bytes.size();
+	uint32_t	alignedHead		=	(m_head + alignment - 1) & ~(alignment - 1);
+	uint32_t	offset			=	0;
+	uint32_t	numOfBytesUsed	=	0;
+
+	// The free bytes run from the head to the tail, around the end of the ring when the head is past the tail
+	bool isHeadPastTail = m_head > m_tail || (m_head == m_tail && m_numOfBytesInUse == 0);
+	if (isHeadPastTail && (uint64_t)alignedHead + numOfBytes <= size)
+	{
+		offset			=	alignedHead;
+		numOfBytesUsed	=	alignedHead - m_head + numOfBytes;
+	}
+	else if (isHeadPastTail && numOfBytes <= m_tail)
+	{
+		// The pending bytes can not wrap twice, that would mean running over the tail
+		GUARANTEE_OR_DIE(!m_hasWrapped, "Transient ring buffer wrapped twice between uploads");
+		m_hasWrapped	=	true;
+		m_wrapOffset	=	m_head;
+		offset			=	0;
+		numOfBytesUsed	=	size - m_head + numOfBytes;
+	}
+	else if (!isHeadPastTail && (uint64_t)alignedHead + numOfBytes <= m_tail)
+	{
+		offset			=	alignedHead;
+		numOfBytesUsed	=	alignedHead - m_head + numOfBytes;
+	}
+	else
+	{
+		return false;
+	}
+
+	m_head					=	offset + numOfBytes;
+	m_numOfBytesInUse		+=	numOfBytesUsed;
+	m_numOfBytesThisFrame	+=	numOfBytesUsed;
+	out_allocation.m_data	=	m_bytes.data() + offset;
+	out_allocation.m_offset	=	offset;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TransientRingBuffer::EndFrame(uint64_t fenceValue)
+{
+	if (m_numOfBytesThisFrame == 0)
+	{
+		return;
+	}
+
+	Frame frame;
+	frame.m_fenceValue		=	fenceValue;
+	frame.m_endOffset		=	m_head;
+	frame.m_numOfBytes		=	m_numOfBytesThisFrame;
+	m_framesInFlight.push_back(frame);
+	m_numOfBytesThisFrame	=	0;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TransientRingBuffer::RetireFrames(uint64_t completedFenceValue)
+{
+	int numOfFramesRetired = 0;
+	while (numOfFramesRetired < (int)m_framesInFlight.size() && m_framesInFlight[numOfFramesRetired].m_fenceValue <= completedFenceValue)
+	{
+		Frame const& frame	=	m_framesInFlight[numOfFramesRetired];
+		m_tail				=	frame.m_endOffset;
+		m_numOfBytesInUse	-=	frame.m_numOfBytes;
+		numOfFramesRetired	+=	1;
+	}
+	m_framesInFlight.erase(m_framesInFlight.begin(), m_framesInFlight.begin() + numOfFramesRetired);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TransientRingBuffer::Grow(uint32_t numOfBytesNeeded)
+{
+	uint64_t newSize = (uint64_t)m_bytes.size() * 2;
+	while (newSize < numOfBytesNeeded)
+	{
+		newSize *= 2;
+	}
+	GUARANTEE_OR_DIE(newSize <= UINT32_MAX, "Transient ring buffer grew past 4 GB");
+	m_bytes.resize((size_t)newSize);
+	Reset();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void TransientRingBuffer::Reset()
+{
+	m_framesInFlight.clear();
+	m_head					=	0;
+	m_tail					=	0;
+	m_numOfBytesInUse		=	0;
+	m_numOfBytesThisFrame	=	0;
+	m_uploadedHead			=	0;
+	m_wrapOffset			=	0;
+	m_hasWrapped			=	false;
+	m_needsDiscard			=	true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+int TransientRingBuffer::TakePendingRanges(TransientRange out_ranges[2], bool& out_discards)
+{
+	int numOfRanges = 0;
+	if (m_hasWrapped)
+	{
+		if (m_wrapOffset > m_uploadedHead)
+		{
+			out_ranges[numOfRanges].m_firstByte		=	m_uploadedHead;
+			out_ranges[numOfRanges].m_numOfBytes	=	m_wrapOffset - m_uploadedHead;
+			numOfRanges								+=	1;
+		}
+		m_uploadedHead	=	0;
+		m_hasWrapped	=	false;
+	}
+	if (m_head > m_uploadedHead)
+	{
+		out_ranges[numOfRanges].m_firstByte		=	m_uploadedHead;
+		out_ranges[numOfRanges].m_numOfBytes	=	m_head - m_uploadedHead;
+		numOfRanges								+=	1;
+	}
+	m_uploadedHead = m_head;
+
+	out_discards = m_needsDiscard && numOfRanges > 0;
+	if (numOfRanges > 0)
+	{
+		m_needsDiscard = false;
+	}
+	return numOfRanges;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t TransientRingBuffer::GetSizeBytes() const
+{
+	return (uint32_t)m_bytes.size();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+uint32_t TransientRingBuffer::GetNumOfBytesInUse() const
+{
+	return m_numOfBytesInUse;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+unsigned char const* TransientRingBuffer::GetBytes() const
+{
+	return m_bytes.data();
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+
+//--------------------------------------------------------------------------------------------------
+#include <stdint.h>
+#include <vector>
+
+
+//--------------------------------------------------------------------------------------------------
+// Vertexes and indexes share a ring, constant buffers can not be bound as anything else so they get their own
+enum class TransientBufferType : unsigned char
+{
+	GEOMETRY,
+	CONSTANTS,
+	COUNT,
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct TransientRange
+{
+	uint32_t	m_firstByte		=	0;
+	uint32_t	m_numOfBytes	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Where an allocation lives, write m_numOfBytes bytes to m_data and bind the backend's buffer at m_offset
+struct TransientAllocation
+{
+	unsigned char*	m_data		=	nullptr;
+	uint32_t		m_offset	=	0;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+// Sub-allocates per frame data from a ring, the CPU copy is uploaded to the backend's buffer at the same offsets
+// Every frame's bytes are tagged with the fence signaled at its end and only handed out again once that fence completes,
+// so uploads never write over data a frame in flight may still read and the backend can map without discarding
+// When the frames in flight fill the ring, Allocate fails and the owner flushes and grows the ring
+class TransientRingBuffer
+{
+public:
+	explicit TransientRingBuffer(uint32_t initialSizeBytes);
+
+	bool		Allocate(uint32_t numOfBytes, uint32_t alignment, TransientAllocation& out_allocation);		// Alignment is a power of two
+	void		EndFrame(uint64_t fenceValue);
+	void		RetireFrames(uint64_t completedFenceValue);
+	void		Grow(uint32_t numOfBytesNeeded);	// Doubles until numOfBytesNeeded fits, only once nothing recorded refers to the ring
+	void		Reset();							// Forgets every frame, for a backend that never saw them
+
+	// Ranges written since the last call, at most two when the ring wrapped in between
+	// Discards is set for the first upload after a Grow or Reset, so a buffer the GPU may still be reading is renamed instead
+	int			TakePendingRanges(TransientRange out_ranges[2], bool& out_discards);
+
+	uint32_t				GetSizeBytes() const;
+	uint32_t				GetNumOfBytesInUse() const;
+	unsigned char const*	GetBytes() const;
+
+private:
+	struct Frame
+	{
+		uint64_t	m_fenceValue		=	0;
+		uint32_t	m_endOffset			=	0;
+		uint32_t	m_numOfBytes		=	0;		// Including what was skipped at a wrap
+	};
+
+private:
+	std::vector<unsigned char>	m_bytes;
+	std::vector<Frame>			m_framesInFlight;				// Oldest first
+	uint32_t					m_head						=	0;
+	uint32_t					m_tail						=	0;
+	uint32_t					m_numOfBytesInUse			=	0;
+	uint32_t					m_numOfBytesThisFrame		=	0;
+	uint32_t					m_uploadedHead				=	0;
+	uint32_t					m_wrapOffset				=	0;		// Where the pending bytes before the wrap end
+	bool						m_hasWrapped				=	false;
+	bool						m_needsDiscard				=	true;
+};
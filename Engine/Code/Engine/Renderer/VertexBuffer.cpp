@@ -16,6 +16,11 @@ VertexBuffer::VertexBuffer(size_t size, unsigned int stride) :
 
 VertexBuffer::~VertexBuffer()
 {
+	if (m_renderer)
+	{
+		m_renderer->ReleaseAfterFlush(m_buffer);
+		m_buffer = nullptr;
+	}
 	DX_SAFE_RELEASE(m_buffer);
 }
 
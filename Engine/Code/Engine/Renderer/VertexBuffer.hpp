@@ -1,6 +1,7 @@
 #pragma once
 
 struct ID3D11Buffer;
+class Renderer;
 
 class VertexBuffer
 {
@@ -18,4 +19,5 @@ public:
 	ID3D11Buffer* m_buffer = nullptr;
 	size_t m_size = 0;
 	unsigned int m_stride = 0;
+	Renderer* m_renderer = nullptr;
 };
\ No newline at end of file
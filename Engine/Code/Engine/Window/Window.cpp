@@ -387,12 +387,15 @@ void Window::CreateOSWindow()
 		GetModuleHandle(NULL), // NOTE(sid): handle to the instance of the module to be associated. 
 		NULL);
 
-	// NOTE(sid): Activates window and displays it in its current size and position
-	ShowWindow(hwnd, SW_SHOW);
-	// NOTE(sid): Brings the thread that created the window to the foreground and activates the window. Keyboard input is directed towards this window, and this thread gets relatively higher priority
-	SetForegroundWindow(hwnd);
-	// NOTE(sid): Keyboard focus is set to the current window
-	SetFocus(hwnd);
+	if (!m_config.m_isHidden)
+	{
+		// NOTE(sid): Activates window and displays it in its current size and position
+		ShowWindow(hwnd, SW_SHOW);
+		// NOTE(sid): Brings the thread that created the window to the foreground and activates the window. Keyboard input is directed towards this window, and this thread gets relatively higher priority
+		SetForegroundWindow(hwnd);
+		// NOTE(sid): Keyboard focus is set to the current window
+		SetFocus(hwnd);
+	}
 
 	m_windowHandle = (void*)hwnd;
 
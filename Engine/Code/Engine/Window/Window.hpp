@@ -22,6 +22,7 @@ struct WindowConfig
 	bool			m_isFullScreen		=	false;
 	IntVec2			m_windowDims		=	IntVec2(-1, -1);
 	IntVec2			m_windowStartPos	=	IntVec2(-1, -1);
+	bool			m_isHidden			=	false;		// Created but never shown, for headless runs that only need the client size
 };
 
 
@@ -5,15 +5,24 @@
 
 //--------------------------------------------------------------------------------------------------
 #include "Engine/Renderer/RendererAnnotationJanitor.hpp"
+#include "Engine/Renderer/RendererTimingJanitor.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/DevConsole.hpp"
 #include "Engine/Renderer/ConstantBuffer.hpp"
+#include "Engine/Renderer/RenderBackend.hpp"
+#include "Engine/Renderer/RenderProfiler.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
+#include "Engine/Renderer/DrawQueue.hpp"
+#include "Engine/Renderer/SpriteBatch.hpp"
+#include "Engine/Renderer/ShaderCompileQueue.hpp"
+#include "Engine/Renderer/Shader.hpp"
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Core/VertexUtils.hpp"
 #include "Engine/Core/OBJLoader.hpp"
+#include "Engine/Core/AssetLoader.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Window/Window.hpp"
 #include "Engine/Math/AABB3.hpp"
@@ -35,6 +44,7 @@ Game* g_theGame = nullptr;
 //--------------------------------------------------------------------------------------------------
 static unsigned int s_threadGroupX;
 static unsigned int s_threadGroupY;
+static constexpr int	NUM_OF_BENCHMARK_GLYPHS_PER_LINE	=	128;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -45,6 +55,11 @@ Game::Game(float clientAspect)
 	m_clock = new Clock(*g_theApp->m_clock);
 
 	g_theEventSystem->SubscribeEventCallbackFunction("PeelCount", Command_SetDepthPeelCount);
+	g_theEventSystem->SubscribeEventCallbackFunction("drawqueuebenchmark", Command_DrawQueueBenchmark);
+	g_theEventSystem->SubscribeEventCallbackFunction("spritebatchbenchmark", Command_SpriteBatchBenchmark);
+	g_theEventSystem->SubscribeEventCallbackFunction("rendergraphmemory", Command_RenderGraphMemory);
+	g_theEventSystem->SubscribeEventCallbackFunction("rendertimings", Command_RenderTimings);
+	g_theEventSystem->SubscribeEventCallbackFunction("rendertimingstrace", Command_RenderTimingsTrace);
 }
 
 
@@ -137,6 +152,8 @@ void Game::Startup()
 {
 	m_screenCamera.SetOrthoView(Vec2(0.f, 0.f), Vec2(1600.f, 800.f));
 	m_player = new Player(this, Vec3(-2.f, 0.f, 0.f), m_clientAspect);
+	m_drawQueue = new DrawQueue(*g_theRenderer);
+	m_renderGraph = new RenderGraph(g_theRenderer);
 
 	// Meshes needed to be initialized before initializing textures
 	InitializeMeshes();
@@ -156,6 +173,10 @@ void Game::Startup()
 //--------------------------------------------------------------------------------------------------
 void Game::Shutdown()
 {
+	delete m_drawQueue;
+	m_drawQueue = nullptr;
+	delete m_renderGraph;
+	m_renderGraph = nullptr;
 }
 
 
@@ -669,6 +690,7 @@ void Game::RenderDebugInfo() const
 void Game::RenderGameModeInfo(eSplitScreenQuadrant quadrant /*= eSPLIT_SCREEN_QUADRANT_1*/) const
 {
 	RendererAnnotationJanitor gameModeInfoRender(L"Game Mode Info");
+	RendererTimingJanitor gameModeInfoTiming("Game Mode Info");
 
 	g_theRenderer->EndCamera(m_player->m_camera);
 	g_theRenderer->BeginCamera(m_screenCamera);
@@ -725,6 +747,7 @@ void Game::RenderGameModeInfo(eSplitScreenQuadrant quadrant /*= eSPLIT_SCREEN_QU
 void Game::GameModeRender() const
 {
 	RendererAnnotationJanitor gameModeRender(L"Game Mode Render");
+	RendererTimingJanitor gameModeTiming("Game Mode Render");
 	switch (m_gameMode)
 	{
 		case eGAME_MODE_DEPTH_TEST:
@@ -893,45 +916,19 @@ void Game::UAVWritesSubModeRender() const
 //--------------------------------------------------------------------------------------------------
 void Game::OITSubModeRender() const
 {
-	if (!m_isTwoSplitScreen && !m_isFourSplitScreen)
-	{
-		OITSubModeQuadrantRender(m_quadrant1SubgroupMode, eSPLIT_SCREEN_QUADRANT_1);
-		return;
-	}
-
-	if (m_isTwoSplitScreen)
+	// Every quadrant adds its passes, the graph then culls them, backs the transients and runs what is left in order
+	m_renderGraph->Reset();
+	OITSubModeQuadrantRender(m_quadrant1SubgroupMode, eSPLIT_SCREEN_QUADRANT_1);
+	if (m_isTwoSplitScreen || m_isFourSplitScreen)
 	{
-		{
-			RendererAnnotationJanitor quadrant1(L"Quadrant-1 Render");
-			OITSubModeQuadrantRender(m_quadrant1SubgroupMode, eSPLIT_SCREEN_QUADRANT_1);
-		}
-		{
-			RendererAnnotationJanitor quadrant2(L"Quadrant-2 Render");
-			OITSubModeQuadrantRender(m_quadrant2SubgroupMode, eSPLIT_SCREEN_QUADRANT_2);
-		}
-		return;
+		OITSubModeQuadrantRender(m_quadrant2SubgroupMode, eSPLIT_SCREEN_QUADRANT_2);
 	}
-
 	if (m_isFourSplitScreen)
 	{
-		{
-			RendererAnnotationJanitor quadrant1(L"Quadrant-1 Render");
-			OITSubModeQuadrantRender(m_quadrant1SubgroupMode, eSPLIT_SCREEN_QUADRANT_1);
-		}
-		{
-			RendererAnnotationJanitor quadrant2(L"Quadrant-2 Render");
-			OITSubModeQuadrantRender(m_quadrant2SubgroupMode, eSPLIT_SCREEN_QUADRANT_2);
-		}
-		{
-			RendererAnnotationJanitor quadrant1(L"Quadrant-3 Render");
-			OITSubModeQuadrantRender(m_quadrant3SubgroupMode, eSPLIT_SCREEN_QUADRANT_3);
-		}
-		{
-			RendererAnnotationJanitor quadrant2(L"Quadrant-4 Render");
-			OITSubModeQuadrantRender(m_quadrant4SubgroupMode, eSPLIT_SCREEN_QUADRANT_4);
-		}
-		return;
+		OITSubModeQuadrantRender(m_quadrant3SubgroupMode, eSPLIT_SCREEN_QUADRANT_3);
+		OITSubModeQuadrantRender(m_quadrant4SubgroupMode, eSPLIT_SCREEN_QUADRANT_4);
 	}
+	m_renderGraph->Execute();
 }
 
 
@@ -1028,9 +1025,9 @@ void Game::UAVWritesSubModeQuadrantRender(unsigned char subgroupMode, eSplitScre
 
 
 //--------------------------------------------------------------------------------------------------
+// Only adds the quadrant's passes to the render graph, OITSubModeRender executes them
 void Game::OITSubModeQuadrantRender(unsigned char subgroupMode, eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
 {
-	RendererAnnotationJanitor subgroupModeRender(L"OIT Mode");
 	switch ((eOITMode)subgroupMode)
 	{
 		case eOIT_MODE_WORST_CASE:
@@ -1447,90 +1444,101 @@ void Game::WithROVUAVWritesSubModeRender(eSplitScreenQuadrant quadrantToRender /
 //--------------------------------------------------------------------------------------------------
 void Game::WorstCaseOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
 {
-	RendererAnnotationJanitor overAlphaBlendJanitor(L"Worst Case OIT");
-	D3D11_Resource* rtResource		=	GetRenderTargetFromQuadrantInfo(quadrantToRender);
-	D3D11_Resource* depthResource	=	GetDepthResourceFromQuadrantInfo(quadrantToRender);
-	g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
-	g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
-	g_theRenderer->ClearDepthResource(depthResource);
+	RenderGraphResourceID renderTarget	=	m_renderGraph->ImportResource("Quadrant Render Target", GetRenderTargetFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID depthTarget	=	m_renderGraph->ImportResource("Quadrant Depth Target", GetDepthResourceFromQuadrantInfo(quadrantToRender));
 
+	std::string passName = GetOITPassName(quadrantToRender, "Worst Case OIT");
+	m_renderGraph->AddPass(passName.c_str(), [this, quadrantToRender, renderTarget, depthTarget](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor opaqueRenderPass(L"Opaque Render Pass");
-		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
-		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-		g_theRenderer->SetModelConstants();
-		g_theRenderer->BindShader(nullptr);
-		DrawScene(eRENDER_PASS_OPAQUE);
-	}
+		D3D11_Resource* rtResource		=	graph.GetResource(renderTarget);
+		D3D11_Resource* depthResource	=	graph.GetResource(depthTarget);
+		g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
+		g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
+		g_theRenderer->ClearDepthResource(depthResource);
 
-	{
-		RendererAnnotationJanitor translucentRenderPass(L"Translucent Render Pass");
-		g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource, true);
-		g_theRenderer->SetBlendMode(BlendMode::ALPHA);
-		DrawScene(eRENDER_PASS_TRANSLUCENT);
-	}
+		{
+			RendererAnnotationJanitor opaqueRenderPass(L"Opaque Render Pass");
+			g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+			g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+			g_theRenderer->SetModelConstants();
+			g_theRenderer->BindShader(nullptr);
+			DrawScene(eRENDER_PASS_OPAQUE);
+		}
 
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-	RenderGameModeInfo(quadrantToRender);
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+		{
+			RendererAnnotationJanitor translucentRenderPass(L"Translucent Render Pass");
+			g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource, true);
+			g_theRenderer->SetBlendMode(BlendMode::ALPHA);
+			DrawScene(eRENDER_PASS_TRANSLUCENT);
+		}
+
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		RenderGameModeInfo(quadrantToRender);
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+	}).Write(renderTarget).Write(depthTarget);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Game::CPUSortedOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
 {
-	RendererAnnotationJanitor overAlphaBlendJanitor(L"CPU Sorted OIT");
-	D3D11_Resource* rtResource		=	GetRenderTargetFromQuadrantInfo(quadrantToRender);
-	D3D11_Resource* depthResource	=	GetDepthResourceFromQuadrantInfo(quadrantToRender);
-	g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
-	g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
-	g_theRenderer->ClearDepthResource(depthResource);
+	RenderGraphResourceID renderTarget	=	m_renderGraph->ImportResource("Quadrant Render Target", GetRenderTargetFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID depthTarget	=	m_renderGraph->ImportResource("Quadrant Depth Target", GetDepthResourceFromQuadrantInfo(quadrantToRender));
 
+	std::string passName = GetOITPassName(quadrantToRender, "CPU Sorted OIT");
+	m_renderGraph->AddPass(passName.c_str(), [this, quadrantToRender, renderTarget, depthTarget](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor opaqueRenderPass(L"Opaque Render Pass");
-		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
-		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-		g_theRenderer->SetModelConstants();
-		g_theRenderer->BindShader(nullptr);
-		DrawScene(eRENDER_PASS_OPAQUE);
-	}
+		D3D11_Resource* rtResource		=	graph.GetResource(renderTarget);
+		D3D11_Resource* depthResource	=	graph.GetResource(depthTarget);
+		g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
+		g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
+		g_theRenderer->ClearDepthResource(depthResource);
 
-	{
-		RendererAnnotationJanitor translucentRenderPass(L"Translucent Render Pass");
-		g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource, true);
-		g_theRenderer->SetBlendMode(BlendMode::ALPHA);
-		DrawSortedTranslucentScene();
-	}
+		{
+			RendererAnnotationJanitor opaqueRenderPass(L"Opaque Render Pass");
+			g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+			g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+			g_theRenderer->SetModelConstants();
+			g_theRenderer->BindShader(nullptr);
+			DrawScene(eRENDER_PASS_OPAQUE);
+		}
 
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-	RenderGameModeInfo(quadrantToRender);
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+		{
+			RendererAnnotationJanitor translucentRenderPass(L"Translucent Render Pass");
+			g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource, true);
+			g_theRenderer->SetBlendMode(BlendMode::ALPHA);
+			DrawSortedTranslucentScene();
+		}
+
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		RenderGameModeInfo(quadrantToRender);
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+	}).Write(renderTarget).Write(depthTarget);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Game::DepthPeelingOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
 {
-	RendererAnnotationJanitor depthPeelingJanitor(L"Depth Peeling OIT");
-	D3D11_Resource* rtResource		=	GetRenderTargetFromQuadrantInfo(quadrantToRender);
-	D3D11_Resource* depthResource	=	GetDepthResourceFromQuadrantInfo(quadrantToRender);
-	g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
-	g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
-	g_theRenderer->ClearRenderTargetResource(m_intermediateTarget, Rgba8::BLACK);
-	g_theRenderer->ClearRenderTargetResource(m_depthPeelingIntermediateRenderTarget, Rgba8::BLACK);
-	g_theRenderer->ClearDepthResource(depthResource);
-
-	{
-		RendererAnnotationJanitor opaqueRenderPass(L"Opaque Render Pass");
-		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
-		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-		g_theRenderer->SetModelConstants();
-		g_theRenderer->BindShader(nullptr);
-		DrawScene(eRENDER_PASS_OPAQUE);
-	}
-
-	{
-		RendererAnnotationJanitor depthPeelingPasses(L"Translucent Render Pass");
+	RenderGraphResourceID renderTarget				=	m_renderGraph->ImportResource("Quadrant Render Target", GetRenderTargetFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID depthTarget				=	m_renderGraph->ImportResource("Quadrant Depth Target", GetDepthResourceFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID intermediateTarget		=	CreateOITTransient(eOIT_TRANSIENT_INTERMEDIATE_TARGET);
+	RenderGraphResourceID intermediateRenderTarget	=	CreateOITTransient(eOIT_TRANSIENT_INTERMEDIATE_RENDER_TARGET);
+	RenderGraphResourceID peelingRenderTarget		=	CreateOITTransient(eOIT_TRANSIENT_DEPTH_PEELING_RENDER_TARGET);
+	RenderGraphResourceID peelingDepthTarget		=	CreateOITTransient(eOIT_TRANSIENT_DEPTH_PEELING_DEPTH_TARGET);
+
+	AddOpaquePass(quadrantToRender, renderTarget, depthTarget);
+
+	std::string passName = GetOITPassName(quadrantToRender, "Depth Peeling OIT: Translucent Render Pass");
+	m_renderGraph->AddPass(passName.c_str(), [this, depthTarget, intermediateTarget, intermediateRenderTarget, peelingRenderTarget, peelingDepthTarget](RenderGraph const& graph)
+	{
+		D3D11_Resource* depthResource				=	graph.GetResource(depthTarget);
+		D3D11_Resource* intermediateTargetResource	=	graph.GetResource(intermediateTarget);
+		D3D11_Resource* intermediateRTResource		=	graph.GetResource(intermediateRenderTarget);
+		D3D11_Resource* peelingRTResource			=	graph.GetResource(peelingRenderTarget);
+		D3D11_Resource* peelingDepthResource		=	graph.GetResource(peelingDepthTarget);
+		g_theRenderer->ClearRenderTargetResource(intermediateTargetResource, Rgba8::BLACK);
+		g_theRenderer->ClearRenderTargetResource(peelingRTResource, Rgba8::BLACK);
 		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
 		for (unsigned int passNo = 0; passNo < m_numOfDepthPeelingPasses; ++passNo)
 		{
@@ -1541,62 +1549,62 @@ void Game::DepthPeelingOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*
 			MultiByteToWideChar(GetACP(), 0, pass.c_str(), -1, (LPWSTR)wstringPass.c_str(), (int)(pass.size() + 1));
 			RendererAnnotationJanitor passNoAnnotator(wstringPass.c_str());
 #endif
-			g_theRenderer->ClearRenderTargetResource(m_intermediateRenderTarget, Rgba8::BLACK);
-			g_theRenderer->ClearDepthResource(m_depthPeelingIntermediateDepthTarget);
-			g_theRenderer->BindRenderAndDepthResources(m_intermediateRenderTarget, m_depthPeelingIntermediateDepthTarget);
-			D3D11_Resource* depthResources[2] = { m_intermediateTarget, depthResource };
+			g_theRenderer->ClearRenderTargetResource(intermediateRTResource, Rgba8::BLACK);
+			g_theRenderer->ClearDepthResource(peelingDepthResource);
+			g_theRenderer->BindRenderAndDepthResources(intermediateRTResource, peelingDepthResource);
+			D3D11_Resource* depthResources[2] = { intermediateTargetResource, depthResource };
 			g_theRenderer->BindReadableResources(depthResources, 2, 1, BindingLocation::PIXEL_SHADER);
 			g_theRenderer->BindShader(m_depthPeelingShader);
 			DrawScene(eRENDER_PASS_TRANSLUCENT);
 			g_theRenderer->UnbindReadableResources(2, 1, BindingLocation::PIXEL_SHADER);
 
-			CompositeDepthPeelingDepth(m_depthPeelingIntermediateDepthTarget);
-			CompositeDepthPeelingColor(m_depthPeelingIntermediateRenderTarget);
+			CompositeDepthPeelingDepth(peelingDepthResource, intermediateTargetResource);
+			CompositeDepthPeelingColor(intermediateRTResource, peelingRTResource);
 		}
-	}
+	}).Read(depthTarget).Write(intermediateTarget).Write(intermediateRenderTarget).Write(peelingRenderTarget).Write(peelingDepthTarget);
 
 	// Composite the accumulated color with the background/Opaque texture
+	passName = GetOITPassName(quadrantToRender, "Depth Peeling OIT: Final Composite Pass");
+	m_renderGraph->AddPass(passName.c_str(), [this, quadrantToRender, renderTarget, peelingRenderTarget](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor finalComposite(L"Final Composite Pass");
-		g_theRenderer->BindReadableResources(&m_depthPeelingIntermediateRenderTarget, 1, 0, BindingLocation::COMPUTE_SHADER);
+		D3D11_Resource* rtResource			=	graph.GetResource(renderTarget);
+		D3D11_Resource* peelingRTResource	=	graph.GetResource(peelingRenderTarget);
+		g_theRenderer->BindReadableResources(&peelingRTResource, 1, 0, BindingLocation::COMPUTE_SHADER);
 		g_theRenderer->BindWritableResourcesToComputeShader(&rtResource, 1, 0);
 		g_theRenderer->BindShader(m_depthPeelingFinalBackgroundPassShader, BindingLocation::COMPUTE_SHADER);
 		g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
 		g_theRenderer->UnbindReadableResources(1, 0, BindingLocation::COMPUTE_SHADER);
 		g_theRenderer->UnbindWritableResources(1, 0, BindingLocation::COMPUTE_SHADER);
-	}
 
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-	g_theRenderer->SetDepthMode(DepthMode::DISABLED);
-	g_theRenderer->BindRenderAndDepthResources(rtResource);
-	RenderGameModeInfo(quadrantToRender);
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		g_theRenderer->SetDepthMode(DepthMode::DISABLED);
+		g_theRenderer->BindRenderAndDepthResources(rtResource);
+		RenderGameModeInfo(quadrantToRender);
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+	}).Read(peelingRenderTarget).ReadWrite(renderTarget);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Game::VirtualPixelMapsOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
 {
-	RendererAnnotationJanitor vpmJanitor(L"Virtual Pixel Maps OIT");
-	D3D11_Resource* rtResource		=	GetRenderTargetFromQuadrantInfo(quadrantToRender);
-	D3D11_Resource* depthResource	=	GetDepthResourceFromQuadrantInfo(quadrantToRender);
-	g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
-	g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
-	g_theRenderer->ClearRenderTargetResource(m_intermediateTarget, Rgba8::WHITE);
-	g_theRenderer->ClearDepthResource(depthResource);
+	RenderGraphResourceID renderTarget				=	m_renderGraph->ImportResource("Quadrant Render Target", GetRenderTargetFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID depthTarget				=	m_renderGraph->ImportResource("Quadrant Depth Target", GetDepthResourceFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID intermediateTarget		=	CreateOITTransient(eOIT_TRANSIENT_INTERMEDIATE_TARGET);
+	RenderGraphResourceID intermediateRenderTarget	=	CreateOITTransient(eOIT_TRANSIENT_INTERMEDIATE_RENDER_TARGET);
 
-	{
-		RendererAnnotationJanitor depthPeelingPasses(L"Opaque Render Pass");
-		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
-		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-		g_theRenderer->SetModelConstants();
-		g_theRenderer->BindShader(nullptr);
-		DrawScene(eRENDER_PASS_OPAQUE);
-		CompositeVPMDepth(depthResource);
-	}
+	AddOpaquePass(quadrantToRender, renderTarget, depthTarget);
 
+	std::string passName = GetOITPassName(quadrantToRender, "Virtual Pixel Maps OIT: Translucent Render Pass");
+	m_renderGraph->AddPass(passName.c_str(), [this, quadrantToRender, renderTarget, depthTarget, intermediateTarget, intermediateRenderTarget](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor translucentPass(L"Translucent Render Pass");
+		D3D11_Resource* rtResource					=	graph.GetResource(renderTarget);
+		D3D11_Resource* depthResource				=	graph.GetResource(depthTarget);
+		D3D11_Resource* intermediateTargetResource	=	graph.GetResource(intermediateTarget);
+		D3D11_Resource* intermediateRTResource		=	graph.GetResource(intermediateRenderTarget);
+		g_theRenderer->ClearRenderTargetResource(intermediateTargetResource, Rgba8::WHITE);
+		CompositeVPMDepth(depthResource, intermediateTargetResource);
+
 		g_theRenderer->SetDepthMode(DepthMode::GREATER);
 		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
 		for (unsigned int passNo = 0; passNo < m_numOfDepthPeelingPasses; ++passNo)
@@ -1609,260 +1617,279 @@ void Game::VirtualPixelMapsOITSubModeRender(eSplitScreenQuadrant quadrantToRende
 			RendererAnnotationJanitor passNoAnnotator(wstringPass.c_str());
 #endif
 			g_theRenderer->ClearDepthResource(depthResource, 0.f);
-			g_theRenderer->ClearRenderTargetResource(m_intermediateRenderTarget, Rgba8::BLACK);
-			g_theRenderer->BindRenderAndDepthResources(m_intermediateRenderTarget, depthResource);
-			g_theRenderer->BindReadableResources(&m_intermediateTarget, 1, 1, BindingLocation::PIXEL_SHADER);
+			g_theRenderer->ClearRenderTargetResource(intermediateRTResource, Rgba8::BLACK);
+			g_theRenderer->BindRenderAndDepthResources(intermediateRTResource, depthResource);
+			g_theRenderer->BindReadableResources(&intermediateTargetResource, 1, 1, BindingLocation::PIXEL_SHADER);
 			g_theRenderer->BindShader(m_vpmPeelingShader);
 			DrawScene(eRENDER_PASS_TRANSLUCENT);
 			g_theRenderer->UnbindReadableResources(1, 1, BindingLocation::PIXEL_SHADER);
 
-			CompositeVPMDepth(depthResource);
-			CompositeVPMColor(rtResource);
+			CompositeVPMDepth(depthResource, intermediateTargetResource);
+			CompositeVPMColor(intermediateRTResource, rtResource);
 		}
-	}
 
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-	g_theRenderer->SetDepthMode(DepthMode::DISABLED);
-	g_theRenderer->BindRenderAndDepthResources(rtResource);
-	RenderGameModeInfo(quadrantToRender);
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		g_theRenderer->SetDepthMode(DepthMode::DISABLED);
+		g_theRenderer->BindRenderAndDepthResources(rtResource);
+		RenderGameModeInfo(quadrantToRender);
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+	}).ReadWrite(depthTarget).ReadWrite(renderTarget).Write(intermediateTarget).Write(intermediateRenderTarget);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 void Game::WeightedBlendedOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
 {
-	RendererAnnotationJanitor overAlphaBlendJanitor(L"Weighted Blended OIT");
-	D3D11_Resource* rtResource		=	GetRenderTargetFromQuadrantInfo(quadrantToRender);
-	D3D11_Resource* depthResource	=	GetDepthResourceFromQuadrantInfo(quadrantToRender);
-	g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
-	g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
-	g_theRenderer->ClearDepthResource(depthResource);
+	RenderGraphResourceID renderTarget			=	m_renderGraph->ImportResource("Quadrant Render Target", GetRenderTargetFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID depthTarget			=	m_renderGraph->ImportResource("Quadrant Depth Target", GetDepthResourceFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID accumulationTarget	=	CreateOITTransient(eOIT_TRANSIENT_ACCUMULATION_TARGET);
+	RenderGraphResourceID revealageTarget		=	CreateOITTransient(eOIT_TRANSIENT_REVEALAGE_TARGET);
+
+	AddOpaquePass(quadrantToRender, renderTarget, depthTarget);
 
+	std::string passName = GetOITPassName(quadrantToRender, "Weighted Blended OIT: Populate Accumulation and Revealage Targets");
+	m_renderGraph->AddPass(passName.c_str(), [this, depthTarget, accumulationTarget, revealageTarget](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor opaqueRenderPass(L"Opaque Render Pass");
-		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
-		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		D3D11_Resource* weightedBlendedRTs[2] = { graph.GetResource(accumulationTarget), graph.GetResource(revealageTarget) };
+		g_theRenderer->ClearRenderTargetResource(weightedBlendedRTs[0], Rgba8::BLACK);
+		g_theRenderer->ClearRenderTargetResource(weightedBlendedRTs[1], Rgba8::WHITE);
+		g_theRenderer->BindRenderAndDepthResources(2, weightedBlendedRTs, graph.GetResource(depthTarget), true);
+		g_theRenderer->BindShader(m_populateAccumRevealRTsShader);
+		g_theRenderer->SetCustomBlendMode();
+		DrawScene(eRENDER_PASS_TRANSLUCENT);
+		g_theRenderer->SetBlendMode(BlendMode::ALPHA);
+	}).Read(depthTarget).Write(accumulationTarget).Write(revealageTarget);
+
+	passName = GetOITPassName(quadrantToRender, "Weighted Blended OIT: Composite Pass");
+	m_renderGraph->AddPass(passName.c_str(), [this, quadrantToRender, renderTarget, accumulationTarget, revealageTarget](RenderGraph const& graph)
+	{
+		D3D11_Resource* rtResource			=	graph.GetResource(renderTarget);
+		D3D11_Resource* readableTexs[2]		=	{ graph.GetResource(accumulationTarget), graph.GetResource(revealageTarget) };
+		g_theRenderer->BeginCamera(m_screenCamera);
+		g_theRenderer->BindRenderAndDepthResources(rtResource);
+		g_theRenderer->SetDepthMode(DepthMode::DISABLED);
+		g_theRenderer->BindShader(m_weightedBlendedCompositeShader);
+		g_theRenderer->BindReadableResources(readableTexs, 2, 1, BindingLocation::PIXEL_SHADER);
 		g_theRenderer->SetModelConstants();
-		g_theRenderer->BindShader(nullptr);
-		DrawScene(eRENDER_PASS_OPAQUE);
-	}
+		g_theRenderer->DrawIndexedBuffer(m_fullScreenQuadIB, m_fullScreenQuadVB, 6);
+		g_theRenderer->UnbindReadableResources(2, 1);
+		g_theRenderer->EndCamera(m_screenCamera);
+
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		RenderGameModeInfo(quadrantToRender);
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+	}).Read(accumulationTarget).Read(revealageTarget).ReadWrite(renderTarget);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Game::PerPixelLinkedListOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
+{
+	eNodes					numOfNodesToUse	=	GetNodesFromQuadrant(quadrantToRender);
+	RenderGraphResourceID	renderTarget	=	m_renderGraph->ImportResource("Quadrant Render Target", GetRenderTargetFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID	depthTarget		=	m_renderGraph->ImportResource("Quadrant Depth Target", GetDepthResourceFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID	headNodes		=	CreateOITTransient(eOITTransient(eOIT_TRANSIENT_HEAD_NODES_2 + numOfNodesToUse));
+	RenderGraphResourceID	fragments		=	CreateOITTransient(eOITTransient(eOIT_TRANSIENT_FRAGMENTS_2 + numOfNodesToUse));
 
+	AddOpaquePass(quadrantToRender, renderTarget, depthTarget);
+
+	// The clear pass resets every head node, whatever the buffers held before this frame is never read
+	std::string passName = GetOITPassName(quadrantToRender, "Per Pixel Linked List OIT: Clear Buffers");
+	m_renderGraph->AddPass(passName.c_str(), [this, numOfNodesToUse, headNodes, fragments](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor translucentRenderPass(L"Translucent Render Pass");
+		D3D11_Resource* linkedListRelatedResources[2] = { graph.GetResource(headNodes), graph.GetResource(fragments) };
+		g_theRenderer->UnbindRenderAndDepthTargets();
+		g_theRenderer->BindWritableResourcesToComputeShader(linkedListRelatedResources, 2, 1);
+		if (numOfNodesToUse == eNODES_2)
 		{
-			RendererAnnotationJanitor populateAccumulationAndRevealage(L"Populate Accumulation and Revealage Targets");
-			g_theRenderer->ClearRenderTargetResource(m_accumulationTargetWeightedBlended, Rgba8::BLACK);
-			g_theRenderer->ClearRenderTargetResource(m_revealageTargetWeightedBlended, Rgba8::WHITE);
-			D3D11_Resource* weightedBlendedRTs[2] = { m_accumulationTargetWeightedBlended, m_revealageTargetWeightedBlended };
-			g_theRenderer->BindRenderAndDepthResources(2, weightedBlendedRTs, depthResource, true);
-			g_theRenderer->BindShader(m_populateAccumRevealRTsShader);
-			g_theRenderer->SetCustomBlendMode();
-			DrawScene(eRENDER_PASS_TRANSLUCENT);
-			g_theRenderer->SetBlendMode(BlendMode::ALPHA);
+			g_theRenderer->BindShader(m_perPixelLinkedListClearBufferShader_2, BindingLocation::COMPUTE_SHADER);
+		}
+		else if (numOfNodesToUse == eNODES_4)
+		{
+			g_theRenderer->BindShader(m_perPixelLinkedListClearBufferShader_4, BindingLocation::COMPUTE_SHADER);
 		}
+		else
+		{
+			g_theRenderer->BindShader(m_perPixelLinkedListClearBufferShader_32, BindingLocation::COMPUTE_SHADER);
+		}
+		g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
+		g_theRenderer->UnbindWritableResources(2, 1, BindingLocation::COMPUTE_SHADER);
+	}).Write(headNodes).Write(fragments);
 
+	passName = GetOITPassName(quadrantToRender, "Per Pixel Linked List OIT: Populate Fragment Linked List");
+	m_renderGraph->AddPass(passName.c_str(), [this, depthTarget, headNodes, fragments](RenderGraph const& graph)
+	{
+		D3D11_Resource* linkedListRelatedResources[2] = { graph.GetResource(headNodes), graph.GetResource(fragments) };
+		g_theRenderer->BindUAVsRenderAndDepthTargets(2, 1, linkedListRelatedResources, 0, nullptr, graph.GetResource(depthTarget), true);
+		g_theRenderer->BindShader(m_populatePerPixelLinkedListShader);
+		g_theRenderer->BindConstantBuffer(g_gameConstantsSlot, m_gameConstantBuffer);
+		DrawScene(eRENDER_PASS_TRANSLUCENT);
+		g_theRenderer->UnbindWritableResources(2, 1);
+	}).Read(depthTarget).ReadWrite(headNodes).ReadWrite(fragments);
+
+	passName = GetOITPassName(quadrantToRender, "Per Pixel Linked List OIT: Populating the RT");
+	m_renderGraph->AddPass(passName.c_str(), [this, quadrantToRender, numOfNodesToUse, renderTarget, headNodes, fragments](RenderGraph const& graph)
+	{
+		D3D11_Resource* rtResource						=	graph.GetResource(renderTarget);
+		D3D11_Resource* linkedListRelatedResources[2]	=	{ graph.GetResource(headNodes), graph.GetResource(fragments) };
+		g_theRenderer->BindWritableResourcesToComputeShader(&rtResource, 1, 1);
+		g_theRenderer->BindReadableResources(linkedListRelatedResources, 2, 1, BindingLocation::COMPUTE_SHADER);
+		if (numOfNodesToUse == eNODES_2)
 		{
-			RendererAnnotationJanitor compositePass(L"Composite Pass");
-			g_theRenderer->BeginCamera(m_screenCamera);
-			D3D11_Resource* readableTexs[2] = { m_accumulationTargetWeightedBlended, m_revealageTargetWeightedBlended };
-			g_theRenderer->BindRenderAndDepthResources(rtResource);
-			g_theRenderer->SetDepthMode(DepthMode::DISABLED);
-			g_theRenderer->BindShader(m_weightedBlendedCompositeShader);
-			g_theRenderer->BindReadableResources(readableTexs, 2, 1, BindingLocation::PIXEL_SHADER);
-			g_theRenderer->SetModelConstants();
-			g_theRenderer->DrawIndexedBuffer(m_fullScreenQuadIB, m_fullScreenQuadVB, 6);
-			g_theRenderer->UnbindReadableResources(2, 1);
-			g_theRenderer->EndCamera(m_screenCamera);
+			g_theRenderer->BindShader(m_perPixelLinkedListCompositePassShader_2, BindingLocation::COMPUTE_SHADER);
 		}
-	}
+		else if (numOfNodesToUse == eNODES_4)
+		{
+			g_theRenderer->BindShader(m_perPixelLinkedListCompositePassShader_4, BindingLocation::COMPUTE_SHADER);
+		}
+		else
+		{
+			g_theRenderer->BindShader(m_perPixelLinkedListCompositePassShader_32, BindingLocation::COMPUTE_SHADER);
+		}
+		g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
+		g_theRenderer->UnbindWritableResources(1, 1, BindingLocation::COMPUTE_SHADER);
+		g_theRenderer->UnbindReadableResources(2, 1, BindingLocation::COMPUTE_SHADER);
 
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-	RenderGameModeInfo(quadrantToRender);
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+		g_theRenderer->BindRenderAndDepthResources(rtResource);
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		RenderGameModeInfo(quadrantToRender);
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+	}).Read(headNodes).Read(fragments).ReadWrite(renderTarget);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Game::PerPixelLinkedListOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
+void Game::MultiLayerAlphaBlendingOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
 {
-	RendererAnnotationJanitor overAlphaBlendJanitor(L"Per Pixel Linked List OIT");
-	D3D11_Resource* rtResource		=	GetRenderTargetFromQuadrantInfo(quadrantToRender);
-	D3D11_Resource* depthResource	=	GetDepthResourceFromQuadrantInfo(quadrantToRender);
-	eNodes			numOfNodesToUse =	GetNodesFromQuadrant(quadrantToRender);
-	g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
-	g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
-	g_theRenderer->ClearDepthResource(depthResource);
+	eNodes					nodesToUse					=	GetNodesFromQuadrant(quadrantToRender);
+	RenderGraphResourceID	renderTarget				=	m_renderGraph->ImportResource("Quadrant Render Target", GetRenderTargetFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID	depthTarget					=	m_renderGraph->ImportResource("Quadrant Depth Target", GetDepthResourceFromQuadrantInfo(quadrantToRender));
+	RenderGraphResourceID	untouchedFragmentMask		=	m_renderGraph->ImportResource("Unoptimized MLAB Untouched Fragment Mask", m_unoptimizedMLABUntouchedFragmentMask);
+	RenderGraphResourceID	intermediateRenderTarget	=	CreateOITTransient(eOIT_TRANSIENT_INTERMEDIATE_RENDER_TARGET);
+	RenderGraphResourceID	blendingArray				=	CreateOITTransient(eOITTransient(eOIT_TRANSIENT_MLAB_BLENDING_ARRAY_2 + nodesToUse));
 
+	// Nothing in MLAB reads the intermediate render target back, the graph culls this pass
+	std::string passName = GetOITPassName(quadrantToRender, "Multi Layered Alpha Blending: Clear Intermediate Render Target");
+	m_renderGraph->AddPass(passName.c_str(), [intermediateRenderTarget](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor opaqueRenderPass(L"Opaque Render Pass");
-		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
-		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-		g_theRenderer->SetModelConstants();
-		g_theRenderer->BindShader(nullptr);
-		DrawScene(eRENDER_PASS_OPAQUE);
-	}
+		g_theRenderer->ClearRenderTargetResource(graph.GetResource(intermediateRenderTarget), Rgba8::BLACK);
+	}).Write(intermediateRenderTarget);
 
+	AddOpaquePass(quadrantToRender, renderTarget, depthTarget);
+
+	// The untouched fragment mask gates every read of the blending array, what it held before this frame is never read
+	passName = GetOITPassName(quadrantToRender, "Multi Layered Alpha Blending: Populate Blending Array");
+	m_renderGraph->AddPass(passName.c_str(), [this, nodesToUse, depthTarget, untouchedFragmentMask, blendingArray](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor translucentRenderPass(L"Translucent Render Pass");
-		D3D11_Resource* linkedListRelatedResources[2] = { m_headNodeByteAddressBuffer_2, m_fragmentsPerPixelStructuredBuffer_2 };
-		if (numOfNodesToUse == eNODES_4)
+		D3D11_Resource* uavResources[2] = { graph.GetResource(untouchedFragmentMask), graph.GetResource(blendingArray) };
+		if (nodesToUse == eNODES_4)
 		{
-			linkedListRelatedResources[0] = m_headNodeByteAddressBuffer_4;
-			linkedListRelatedResources[1] = m_fragmentsPerPixelStructuredBuffer_4;
+			g_theRenderer->BindShader(m_unoptimizedMLABPopulateBlendingArrayShader_4);
 		}
-		if (numOfNodesToUse == eNODES_32)
+		else if (nodesToUse == eNODES_32)
 		{
-			linkedListRelatedResources[0] = m_headNodeByteAddressBuffer_32;
-			linkedListRelatedResources[1] = m_fragmentsPerPixelStructuredBuffer_32;
+			g_theRenderer->BindShader(m_unoptimizedMLABPopulateBlendingArrayShader_32);
 		}
-
+		else
 		{
-			RendererAnnotationJanitor clearBuffers(L"Clear Buffers");
-			g_theRenderer->UnbindRenderAndDepthTargets();
-			g_theRenderer->BindWritableResourcesToComputeShader(linkedListRelatedResources, 2, 1);
-			if (numOfNodesToUse == eNODES_2)
-			{
-				g_theRenderer->BindShader(m_perPixelLinkedListClearBufferShader_2, BindingLocation::COMPUTE_SHADER);
-			}
-			else if (numOfNodesToUse == eNODES_4)
-			{
-				g_theRenderer->BindShader(m_perPixelLinkedListClearBufferShader_4, BindingLocation::COMPUTE_SHADER);
-			}
-			else
-			{
-				g_theRenderer->BindShader(m_perPixelLinkedListClearBufferShader_32, BindingLocation::COMPUTE_SHADER);
-			}
-			g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
-			g_theRenderer->UnbindWritableResources(2, 1, BindingLocation::COMPUTE_SHADER);
+			g_theRenderer->BindShader(m_unoptimizedMLABPopulateBlendingArrayShader_2);
 		}
+		g_theRenderer->BindUAVsRenderAndDepthTargets(2, 1, uavResources, 0, nullptr, graph.GetResource(depthTarget), true);
+		g_theRenderer->BindConstantBuffer(g_screenConstantsSlot, m_screenConstantBuffer);
+		DrawScene(eRENDER_PASS_TRANSLUCENT);
+		g_theRenderer->UnbindUAVsRenderAndDepthTargets(2, 1, 0);
+	}).Read(depthTarget).ReadWrite(untouchedFragmentMask).Write(blendingArray);
 
+	passName = GetOITPassName(quadrantToRender, "Multi Layered Alpha Blending: Populate Custom RT");
+	m_renderGraph->AddPass(passName.c_str(), [this, quadrantToRender, nodesToUse, renderTarget, untouchedFragmentMask, blendingArray](RenderGraph const& graph)
+	{
+		D3D11_Resource* rtResource			=	graph.GetResource(renderTarget);
+		D3D11_Resource* blendingArrayBuffer	=	graph.GetResource(blendingArray);
+		g_theRenderer->BindReadableResources(&blendingArrayBuffer, 1, 0, BindingLocation::COMPUTE_SHADER);
+		if (nodesToUse == eNODES_2)
 		{
-			RendererAnnotationJanitor populateLinkedList(L"Populate Fragment Linked List");
-			g_theRenderer->BindUAVsRenderAndDepthTargets(2, 1, linkedListRelatedResources, 0, nullptr, depthResource, true);
-			g_theRenderer->BindShader(m_populatePerPixelLinkedListShader);
-			g_theRenderer->BindConstantBuffer(g_gameConstantsSlot, m_gameConstantBuffer);
-			DrawScene(eRENDER_PASS_TRANSLUCENT);
-			g_theRenderer->UnbindWritableResources(2, 1);
+			g_theRenderer->BindShader(m_unoptimizedMLABPopulateRenderTargetShader_2, BindingLocation::COMPUTE_SHADER);
 		}
-
+		else if (nodesToUse == eNODES_4)
 		{
-			RendererAnnotationJanitor composite(L"Populating the RT");
-			g_theRenderer->BindWritableResourcesToComputeShader(&rtResource, 1, 1);
-			g_theRenderer->BindReadableResources(linkedListRelatedResources, 2, 1, BindingLocation::COMPUTE_SHADER);
-			if (numOfNodesToUse == eNODES_2)
-			{
-				g_theRenderer->BindShader(m_perPixelLinkedListCompositePassShader_2, BindingLocation::COMPUTE_SHADER);
-			}
-			else if (numOfNodesToUse == eNODES_4)
-			{
-				g_theRenderer->BindShader(m_perPixelLinkedListCompositePassShader_4, BindingLocation::COMPUTE_SHADER);
-			}
-			else
-			{
-				g_theRenderer->BindShader(m_perPixelLinkedListCompositePassShader_32, BindingLocation::COMPUTE_SHADER);
-			}
-			g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
-			g_theRenderer->UnbindWritableResources(1, 1, BindingLocation::COMPUTE_SHADER);
-			g_theRenderer->UnbindReadableResources(2, 1, BindingLocation::COMPUTE_SHADER);
+			g_theRenderer->BindShader(m_unoptimizedMLABPopulateRenderTargetShader_4, BindingLocation::COMPUTE_SHADER);
 		}
-	}
+		else
+		{
+			g_theRenderer->BindShader(m_unoptimizedMLABPopulateRenderTargetShader_32, BindingLocation::COMPUTE_SHADER);
+		}
+		D3D11_Resource* const writableResources[2] = { rtResource, graph.GetResource(untouchedFragmentMask) };
+		g_theRenderer->BindWritableResourcesToComputeShader(writableResources, 2, 0);
+		g_theRenderer->BindConstantBuffer(g_screenConstantsSlot, m_screenConstantBuffer, BindingLocation::COMPUTE_SHADER);
+		g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
+		g_theRenderer->UnbindReadableResources(1, 0, BindingLocation::COMPUTE_SHADER);
+		g_theRenderer->UnbindWritableResources(2, 0, BindingLocation::COMPUTE_SHADER);
 
-	g_theRenderer->BindRenderAndDepthResources(rtResource);
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-	RenderGameModeInfo(quadrantToRender);
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
+		g_theRenderer->SetDepthMode(DepthMode::DISABLED);
+		g_theRenderer->BindRenderAndDepthResources(rtResource);
+		RenderGameModeInfo(quadrantToRender);
+		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+	}).Read(blendingArray).ReadWrite(untouchedFragmentMask).ReadWrite(renderTarget);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Game::MultiLayerAlphaBlendingOITSubModeRender(eSplitScreenQuadrant quadrantToRender /*= eSPLIT_SCREEN_QUADRANT_1*/) const
+// Clears the quadrant's targets and draws the opaque objects, the first pass of every OIT mode that composites
+void Game::AddOpaquePass(eSplitScreenQuadrant quadrant, RenderGraphResourceID renderTarget, RenderGraphResourceID depthTarget) const
 {
-	RendererAnnotationJanitor overAlphaBlendJanitor(L"Multi Layered Alpha Blending");
-	D3D11_Resource* rtResource		=	GetRenderTargetFromQuadrantInfo(quadrantToRender);
-	D3D11_Resource* depthResource	=	GetDepthResourceFromQuadrantInfo(quadrantToRender);
-	eNodes			nodesToUse		=	GetNodesFromQuadrant(quadrantToRender);
-
-	g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
-	g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
-	g_theRenderer->ClearDepthResource(depthResource);
-	g_theRenderer->ClearRenderTargetResource(m_intermediateRenderTarget, Rgba8::BLACK);
-
+	std::string passName = GetOITPassName(quadrant, "Opaque Render Pass");
+	m_renderGraph->AddPass(passName.c_str(), [this, renderTarget, depthTarget](RenderGraph const& graph)
 	{
-		RendererAnnotationJanitor opaqueRenderPass(L"Opaque Render Pass");
+		D3D11_Resource* rtResource		=	graph.GetResource(renderTarget);
+		D3D11_Resource* depthResource	=	graph.GetResource(depthTarget);
+		g_theRenderer->BindRenderAndDepthResources(rtResource, depthResource);
+		g_theRenderer->ClearRenderTargetResource(rtResource, Rgba8::BLACK);
+		g_theRenderer->ClearDepthResource(depthResource);
 		g_theRenderer->SetDepthMode(DepthMode::ENABLED);
 		g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
 		g_theRenderer->SetModelConstants();
 		g_theRenderer->BindShader(nullptr);
 		DrawScene(eRENDER_PASS_OPAQUE);
-	}
+	}).Write(renderTarget).Write(depthTarget);
+}
 
-	{
-		RendererAnnotationJanitor translucentRenderPass(L"Translucent Render Pass");
-		{
-			RendererAnnotationJanitor populateBlendingArray(L"Populate Blending Array");
-			D3D11_Resource* uavResources[2] = { m_unoptimizedMLABUntouchedFragmentMask, m_unoptimizedMLABStructuredBuffer_2 };
-			if (nodesToUse == eNODES_4)
-			{
-				uavResources[1] = m_unoptimizedMLABStructuredBuffer_4;
-				g_theRenderer->BindShader(m_unoptimizedMLABPopulateBlendingArrayShader_4);
-			}
-			else if (nodesToUse == eNODES_32)
-			{
-				uavResources[1] = m_unoptimizedMLABStructuredBuffer_32;
-				g_theRenderer->BindShader(m_unoptimizedMLABPopulateBlendingArrayShader_32);
-			}
-			else
-			{
-				g_theRenderer->BindShader(m_unoptimizedMLABPopulateBlendingArrayShader_2);
-			}
-			g_theRenderer->BindUAVsRenderAndDepthTargets(2, 1, uavResources, 0, nullptr, depthResource, true);
-			g_theRenderer->BindConstantBuffer(g_screenConstantsSlot, m_screenConstantBuffer);
-			DrawScene(eRENDER_PASS_TRANSLUCENT);
-			g_theRenderer->UnbindUAVsRenderAndDepthTargets(2, 1, 0);
-		}
 
-		{
-			RendererAnnotationJanitor populateCustomRT(L"Populate Custom RT");
-			if (nodesToUse == eNODES_2)
-			{
-				g_theRenderer->BindReadableResources(&m_unoptimizedMLABStructuredBuffer_2, 1, 0, BindingLocation::COMPUTE_SHADER);
-				g_theRenderer->BindShader(m_unoptimizedMLABPopulateRenderTargetShader_2, BindingLocation::COMPUTE_SHADER);
-			}
-			else if (nodesToUse == eNODES_4)
-			{
-				g_theRenderer->BindReadableResources(&m_unoptimizedMLABStructuredBuffer_4, 1, 0, BindingLocation::COMPUTE_SHADER);
-				g_theRenderer->BindShader(m_unoptimizedMLABPopulateRenderTargetShader_4, BindingLocation::COMPUTE_SHADER);
-			}
-			else
-			{
-				g_theRenderer->BindReadableResources(&m_unoptimizedMLABStructuredBuffer_32, 1, 0, BindingLocation::COMPUTE_SHADER);
-				g_theRenderer->BindShader(m_unoptimizedMLABPopulateRenderTargetShader_32, BindingLocation::COMPUTE_SHADER);
-			}
-			D3D11_Resource* const writableResources[2] = { rtResource, m_unoptimizedMLABUntouchedFragmentMask };
-			g_theRenderer->BindWritableResourcesToComputeShader(writableResources, 2, 0);
-			g_theRenderer->BindConstantBuffer(g_screenConstantsSlot, m_screenConstantBuffer, BindingLocation::COMPUTE_SHADER);
-			g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
-			g_theRenderer->UnbindReadableResources(1, 0, BindingLocation::COMPUTE_SHADER);
-			g_theRenderer->UnbindWritableResources(2, 0, BindingLocation::COMPUTE_SHADER);
-		}
-	}
+//--------------------------------------------------------------------------------------------------
+// "Quadrant-2 Weighted Blended OIT: Composite Pass", the graph annotates every pass with its name
+std::string Game::GetOITPassName(eSplitScreenQuadrant quadrant, char const* passName) const
+{
+	return Stringf("Quadrant-%d %s", (int)quadrant + 1, passName);
+}
 
-	g_theRenderer->SetBlendMode(BlendMode::OPAQUE);
-	g_theRenderer->SetDepthMode(DepthMode::DISABLED);
-	g_theRenderer->BindRenderAndDepthResources(rtResource);
-	RenderGameModeInfo(quadrantToRender);
-	g_theRenderer->SetDepthMode(DepthMode::ENABLED);
+
+//--------------------------------------------------------------------------------------------------
+RenderGraphResourceID Game::CreateOITTransient(eOITTransient transient) const
+{
+	D3D11_ResourceConfig const& transientConfig = m_oitTransientConfigs[transient];
+	return m_renderGraph->CreateTransientResource(transientConfig.m_debugName, transientConfig);
 }
 
 
 //--------------------------------------------------------------------------------------------------
-void Game::CompositeDepthPeelingDepth(D3D11_Resource* depthResource) const
+size_t Game::GetUpFrontOITTransientBytes() const
+{
+	size_t upFrontBytes = 0;
+	for (int transientIndex = 0; transientIndex < eOIT_TRANSIENT_COUNT; ++transientIndex)
+	{
+		upFrontBytes += RenderGraph::EstimateSizeInBytes(m_oitTransientConfigs[transientIndex]);
+	}
+	return upFrontBytes;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+void Game::CompositeDepthPeelingDepth(D3D11_Resource* depthResource, D3D11_Resource* depthTarget) const
 {
 	RendererAnnotationJanitor depthComposite(L"Depth Composite");
 	g_theRenderer->UnbindRenderAndDepthTargets();
 	g_theRenderer->BindReadableResources(&depthResource, 1, 0, BindingLocation::COMPUTE_SHADER);
-	g_theRenderer->BindWritableResourcesToComputeShader(&m_intermediateTarget, 1, 0);
+	g_theRenderer->BindWritableResourcesToComputeShader(&depthTarget, 1, 0);
 	g_theRenderer->BindShader(m_depthPeelingDepthCompositeShader, BindingLocation::COMPUTE_SHADER);
 	g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
 	g_theRenderer->UnbindReadableResources(1, 0, BindingLocation::COMPUTE_SHADER);
@@ -1871,11 +1898,11 @@ void Game::CompositeDepthPeelingDepth(D3D11_Resource* depthResource) const
 
 
 //--------------------------------------------------------------------------------------------------
-void Game::CompositeDepthPeelingColor(D3D11_Resource* colorTarget) const
+void Game::CompositeDepthPeelingColor(D3D11_Resource* colorResource, D3D11_Resource* colorTarget) const
 {
 	RendererAnnotationJanitor depthComposite(L"Color Composite");
 	g_theRenderer->UnbindRenderAndDepthTargets();
-	g_theRenderer->BindReadableResources(&m_intermediateRenderTarget, 1, 0, BindingLocation::COMPUTE_SHADER);
+	g_theRenderer->BindReadableResources(&colorResource, 1, 0, BindingLocation::COMPUTE_SHADER);
 	g_theRenderer->BindWritableResourcesToComputeShader(&colorTarget, 1, 0);
 	g_theRenderer->BindShader(m_depthPeelingColorCompositeShader, BindingLocation::COMPUTE_SHADER);
 	g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
@@ -1885,12 +1912,12 @@ void Game::CompositeDepthPeelingColor(D3D11_Resource* colorTarget) const
 
 
 //--------------------------------------------------------------------------------------------------
-void Game::CompositeVPMDepth(D3D11_Resource*& depthResource) const
+void Game::CompositeVPMDepth(D3D11_Resource* depthResource, D3D11_Resource* depthTarget) const
 {
 	RendererAnnotationJanitor depthComposite(L"Depth Composite");
 	g_theRenderer->UnbindRenderAndDepthTargets();
 	g_theRenderer->BindReadableResources(&depthResource, 1, 0, BindingLocation::COMPUTE_SHADER);
-	g_theRenderer->BindWritableResourcesToComputeShader(&m_intermediateTarget, 1, 0);
+	g_theRenderer->BindWritableResourcesToComputeShader(&depthTarget, 1, 0);
 	g_theRenderer->BindShader(m_vpmDepthCompositeShader, BindingLocation::COMPUTE_SHADER);
 	g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
 	g_theRenderer->UnbindReadableResources(1, 0, BindingLocation::COMPUTE_SHADER);
@@ -1899,11 +1926,11 @@ void Game::CompositeVPMDepth(D3D11_Resource*& depthResource) const
 
 
 //--------------------------------------------------------------------------------------------------
-void Game::CompositeVPMColor(D3D11_Resource*& colorTarget) const
+void Game::CompositeVPMColor(D3D11_Resource* colorResource, D3D11_Resource* colorTarget) const
 {
 	RendererAnnotationJanitor depthComposite(L"Color Composite");
 	g_theRenderer->UnbindRenderAndDepthTargets();
-	g_theRenderer->BindReadableResources(&m_intermediateRenderTarget, 1, 0, BindingLocation::COMPUTE_SHADER);
+	g_theRenderer->BindReadableResources(&colorResource, 1, 0, BindingLocation::COMPUTE_SHADER);
 	g_theRenderer->BindWritableResourcesToComputeShader(&colorTarget, 1, 0);
 	g_theRenderer->BindShader(m_vpmColorCompositeShader, BindingLocation::COMPUTE_SHADER);
 	g_theRenderer->ComputeShaderDispatch(s_threadGroupX, s_threadGroupY, 1);
@@ -1924,6 +1951,13 @@ void Game::DrawScene(eRenderPass renderPass) const
 		g_theRenderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_NONE);
 	}
 
+	if ((m_isRetainedModeRendering || renderPass == eRENDER_PASS_OPAQUE) && m_isDrawQueueEnabled)
+	{
+		// Translucent objects and anything drawn without a depth test blend in the order the scene lists them
+		SubmitSceneObjects(sceneObjectsToRender, isTranslucentPass || g_theRenderer->GetDepthMode() == DepthMode::DISABLED);
+		return;
+	}
+
 	if (m_isRetainedModeRendering || renderPass == eRENDER_PASS_OPAQUE)
 	{
 		static Mat44 identityTransform;
@@ -1932,8 +1966,9 @@ void Game::DrawScene(eRenderPass renderPass) const
 			SceneObject const& currentMesh = sceneObjectsToRender[meshIndex];
 			RendererAnnotationJanitor meshRender(currentMesh.m_debugName);
 
+			D3D11_Resource* textureResource = currentMesh.m_textureAsset ? currentMesh.m_textureAsset->GetTextureResource() : currentMesh.m_textureResource;
 			g_theRenderer->SetModelConstants(identityTransform, Rgba8(255, 255, 255, currentMesh.m_color.a));
-			g_theRenderer->BindReadableResources(&currentMesh.m_textureResource, currentMesh.m_numOfTexturesBound, 0, BindingLocation::PIXEL_SHADER);
+			g_theRenderer->BindReadableResources(&textureResource, currentMesh.m_numOfTexturesBound, 0, BindingLocation::PIXEL_SHADER);
 			if (!m_isTextured)
 			{
 				g_theRenderer->BindTexture(nullptr, BindingLocation::PIXEL_SHADER);
@@ -1951,7 +1986,26 @@ void Game::DrawScene(eRenderPass renderPass) const
 				}
 			}
 
-			g_theRenderer->DrawIndexedBuffer(currentMesh.m_indexBuffer, currentMesh.m_vertexBuffer, currentMesh.m_numOfIndexes);
+			VertexBuffer*	vertexBuffer	=	currentMesh.m_meshAsset ? currentMesh.m_meshAsset->GetVertexBuffer()	: currentMesh.m_vertexBuffer;
+			IndexBuffer*	indexBuffer		=	currentMesh.m_meshAsset ? currentMesh.m_meshAsset->GetIndexBuffer()		: currentMesh.m_indexBuffer;
+			unsigned int	numOfIndexes	=	currentMesh.m_meshAsset ? currentMesh.m_meshAsset->GetNumOfIndexes()	: currentMesh.m_numOfIndexes;
+			bool			isQuantized		=	currentMesh.m_meshAsset && currentMesh.m_meshAsset->GetType() == AssetType::MESH_PCUTBN_QUANTIZED;
+			if (vertexBuffer && isQuantized)
+			{
+				// The fallback shader reads Vertex_PCU, so the mesh waits for its own shader to compile
+				if (m_defaultQuantizedShader->IsReady())
+				{
+					Shader* passShader = g_theRenderer->GetCurrentShader();
+					g_theRenderer->BindShader(m_defaultQuantizedShader);
+					g_theRenderer->SetModelConstants(currentMesh.m_meshAsset->GetDequantizationMatrix(), m_isTextured ? Rgba8(255, 255, 255, currentMesh.m_color.a) : currentMesh.m_color);
+					g_theRenderer->DrawIndexedBuffer(indexBuffer, vertexBuffer, numOfIndexes);
+					g_theRenderer->BindShader(passShader);
+				}
+			}
+			else if (vertexBuffer)
+			{
+				g_theRenderer->DrawIndexedBuffer(indexBuffer, vertexBuffer, numOfIndexes);
+			}
 		}
 		return;
 	}
@@ -1970,6 +2024,12 @@ void Game::DrawSortedTranslucentScene() const
 	std::vector<SceneObject> const& sceneObjectsToRender	=	scene->m_sortedTranslucentObjects;
 
 	g_theRenderer->SetRasterizerMode(RasterizerMode::SOLID_CULL_NONE);
+	if (m_isRetainedModeRendering && m_isDrawQueueEnabled)
+	{
+		SubmitSceneObjects(sceneObjectsToRender, true);
+		return;
+	}
+
 	if (m_isRetainedModeRendering)
 	{
 		static Mat44 identityTransform;
@@ -1978,8 +2038,9 @@ void Game::DrawSortedTranslucentScene() const
 			SceneObject const& currentMesh = sceneObjectsToRender[meshIndex];
 			RendererAnnotationJanitor meshRender(currentMesh.m_debugName);
 
+			D3D11_Resource* textureResource = currentMesh.m_textureAsset ? currentMesh.m_textureAsset->GetTextureResource() : currentMesh.m_textureResource;
 			g_theRenderer->SetModelConstants(identityTransform, Rgba8(255, 255, 255, currentMesh.m_color.a));
-			g_theRenderer->BindReadableResources(&currentMesh.m_textureResource, currentMesh.m_numOfTexturesBound, 0, BindingLocation::PIXEL_SHADER);
+			g_theRenderer->BindReadableResources(&textureResource, currentMesh.m_numOfTexturesBound, 0, BindingLocation::PIXEL_SHADER);
 			if (!m_isTextured)
 			{
 				g_theRenderer->BindTexture(nullptr, BindingLocation::PIXEL_SHADER);
@@ -1997,7 +2058,13 @@ void Game::DrawSortedTranslucentScene() const
 				}
 			}
 
-			g_theRenderer->DrawIndexedBuffer(currentMesh.m_indexBuffer, currentMesh.m_vertexBuffer, currentMesh.m_numOfIndexes);
+			VertexBuffer*	vertexBuffer	=	currentMesh.m_meshAsset ? currentMesh.m_meshAsset->GetVertexBuffer()	: currentMesh.m_vertexBuffer;
+			IndexBuffer*	indexBuffer		=	currentMesh.m_meshAsset ? currentMesh.m_meshAsset->GetIndexBuffer()		: currentMesh.m_indexBuffer;
+			unsigned int	numOfIndexes	=	currentMesh.m_meshAsset ? currentMesh.m_meshAsset->GetNumOfIndexes()	: currentMesh.m_numOfIndexes;
+			if (vertexBuffer)
+			{
+				g_theRenderer->DrawIndexedBuffer(indexBuffer, vertexBuffer, numOfIndexes);
+			}
 		}
 		return;
 	}
@@ -2009,6 +2076,70 @@ void Game::DrawSortedTranslucentScene() const
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// Binds the same resources DrawScene does per object, the queue drops the binds that repeat the previous draw's
+void Game::SubmitSceneObjects(std::vector<SceneObject> const& sceneObjects, bool keepsSceneOrder) const
+{
+	Vec3			playerCamPos	=	m_player->m_camera.GetCameraPosition();
+	unsigned int	numOfObjects	=	(unsigned int)sceneObjects.size();
+	Shader*			passShader		=	g_theRenderer->GetCurrentShader();
+	bool			isAnyQuantized	=	false;
+	for (unsigned int meshIndex = 0; meshIndex < numOfObjects; ++meshIndex)
+	{
+		SceneObject const&	currentMesh	=	sceneObjects[meshIndex];
+		Asset const*		meshAsset	=	currentMesh.m_meshAsset;
+		if (meshAsset && !meshAsset->IsReady())
+		{
+			continue;
+		}
+		QueuedDraw			draw;
+		draw.m_vertexBuffer		=	meshAsset ? meshAsset->GetVertexBuffer()	: currentMesh.m_vertexBuffer;
+		draw.m_indexBuffer		=	meshAsset ? meshAsset->GetIndexBuffer()		: currentMesh.m_indexBuffer;
+		draw.m_numOfElements	=	meshAsset ? meshAsset->GetNumOfIndexes()	: currentMesh.m_numOfIndexes;
+		draw.m_debugName		=	currentMesh.m_debugName;
+		draw.m_modelColor		=	m_isTextured ? Rgba8(255, 255, 255, currentMesh.m_color.a) : currentMesh.m_color;
+		if (m_isTextured)
+		{
+			draw.m_texture = currentMesh.m_textureAsset ? currentMesh.m_textureAsset->GetTextureResource() : currentMesh.m_textureResource;
+		}
+		if (m_sceneIndex == eTRANSLUCENT_SCENE_FOG && currentMesh.m_type == eMESH_TYPE_BILLBOARDED_QUAD && currentMesh.m_color.a != 255)
+		{
+			draw.m_modelMatrix = currentMesh.m_transform;
+		}
+		if (meshAsset && meshAsset->GetType() == AssetType::MESH_PCUTBN_QUANTIZED)
+		{
+			// The fallback shader reads Vertex_PCU, so the mesh waits for its own shader to compile
+			if (!m_defaultQuantizedShader->IsReady())
+			{
+				continue;
+			}
+			draw.m_shader		=	m_defaultQuantizedShader;
+			draw.m_modelMatrix	=	meshAsset->GetDequantizationMatrix();
+			isAnyQuantized		=	true;
+		}
+
+		// Ordered draws go through the far to near translucent path, counting down keeps them in list order
+		if (keepsSceneOrder)
+		{
+			draw.m_isTranslucent	=	true;
+			draw.m_depth			=	(float)(numOfObjects - meshIndex);
+		}
+		else
+		{
+			draw.m_depth = (currentMesh.m_center - playerCamPos).GetLengthSquared();
+		}
+		m_drawQueue->AddDraw(draw);
+	}
+	m_drawQueue->Submit();
+
+	// The queue leaves whichever shader it bound last, the pass expects its own back
+	if (isAnyQuantized)
+	{
+		g_theRenderer->BindShader(passShader);
+	}
+}
+
+
 //--------------------------------------------------------------------------------------------------
 char* Game::GetGameModeAsText() const
 {
@@ -2989,6 +3120,253 @@ bool Game::Command_SetDepthPeelCount(EventArgs& args)
 }
 
 
+//--------------------------------------------------------------------------------------------------
+// Renders every scene with the draw queue off and then on, and prints what sorting saved in state changes per frame
+bool Game::Command_DrawQueueBenchmark(EventArgs& args)
+{
+	int					numOfFrames				=	args.GetValue("NumOfFrames", 50);
+	eTranslucentScene	sceneIndexBefore		=	g_theGame->m_sceneIndex;
+	bool				wasDrawQueueEnabled		=	g_theGame->m_isDrawQueueEnabled;
+	double				frameScale				=	1.0 / (double)(numOfFrames < 1 ? 1 : numOfFrames);
+
+	g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Draw queue benchmark: %s, %d frames per scene", g_theGame->GetGameModeAsText(), numOfFrames));
+	for (int sceneIndex = 0; sceneIndex < eTRANSLUCENT_SCENE_COUNT; ++sceneIndex)
+	{
+		if (g_theGame->m_scenes[sceneIndex] == nullptr)
+		{
+			continue;
+		}
+		g_theGame->m_sceneIndex = (eTranslucentScene)sceneIndex;
+
+		g_theGame->m_isDrawQueueEnabled		=	false;
+		RenderCommandStats unsortedStats	=	CaptureRenderStats(*g_theRenderer, []() { g_theGame->Render(); }, numOfFrames);
+		g_theGame->m_isDrawQueueEnabled		=	true;
+		RenderCommandStats sortedStats		=	CaptureRenderStats(*g_theRenderer, []() { g_theGame->Render(); }, numOfFrames);
+
+		double	stateChangesBefore	=	(double)unsortedStats.GetNumOfStateChanges() * frameScale;
+		double	stateChangesAfter	=	(double)sortedStats.GetNumOfStateChanges() * frameScale;
+		double	reduction			=	stateChangesBefore > 0.0 ? (1.0 - stateChangesAfter / stateChangesBefore) * 100.0 : 0.0;
+		std::string result = Stringf("%-20s state changes %7.0f -> %7.0f (%5.1f%% fewer), %6.0f draws, commands %7.0f -> %7.0f per frame",
+			g_theGame->GetTranslucentSceneAsText(), stateChangesBefore, stateChangesAfter, reduction, (double)sortedStats.GetNumOfDraws() * frameScale,
+			(double)unsortedStats.GetNumOfCommands() * frameScale, (double)sortedStats.GetNumOfCommands() * frameScale);
+		DebuggerPrintf("%s\n", result.c_str());
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, result);
+		if (sortedStats.m_numOfValidationErrors > 0)
+		{
+			g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("Null backend validation failed with the draw queue: %s", sortedStats.m_firstValidationError));
+		}
+	}
+
+	g_theGame->m_sceneIndex				=	sceneIndexBefore;
+	g_theGame->m_isDrawQueueEnabled		=	wasDrawQueueEnabled;
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Draws NumOfGlyphs glyphs of screen text with one draw per line, then through a SpriteBatch expanding on the CPU and on the GPU,
+// and prints draws and bytes uploaded per frame for each
+bool Game::Command_SpriteBatchBenchmark(EventArgs& args)
+{
+	int		numOfFrames		=	args.GetValue("NumOfFrames", 50);
+	int		numOfGlyphs		=	args.GetValue("NumOfGlyphs", 50000);
+	double	frameScale		=	1.0 / (double)(numOfFrames < 1 ? 1 : numOfFrames);
+	int		numOfLines		=	(numOfGlyphs + NUM_OF_BENCHMARK_GLYPHS_PER_LINE - 1) / NUM_OF_BENCHMARK_GLYPHS_PER_LINE;
+	float	cellHeight		=	800.f / (float)NUM_OF_BENCHMARK_GLYPHS_PER_LINE;
+	int		linesOnScreen	=	(int)(800.f / cellHeight);
+
+	// Lines wrap back to the bottom of the screen once it is full, the glyphs overlap but every one is still drawn
+	std::vector<std::string>	lines;
+	std::vector<Vec2>			lineMins;
+	lines.reserve(numOfLines);
+	lineMins.reserve(numOfLines);
+	for (int lineIndex = 0; lineIndex < numOfLines; ++lineIndex)
+	{
+		int			numOfGlyphsLeft		=	numOfGlyphs - lineIndex * NUM_OF_BENCHMARK_GLYPHS_PER_LINE;
+		int			numOfGlyphsInLine	=	numOfGlyphsLeft < NUM_OF_BENCHMARK_GLYPHS_PER_LINE ? numOfGlyphsLeft : NUM_OF_BENCHMARK_GLYPHS_PER_LINE;
+		std::string	line((size_t)numOfGlyphsInLine, ' ');
+		for (int glyphIndex = 0; glyphIndex < numOfGlyphsInLine; ++glyphIndex)
+		{
+			line[glyphIndex] = (char)('!' + (lineIndex + glyphIndex) % 94);
+		}
+		lines.push_back(line);
+		lineMins.push_back(Vec2(0.f, cellHeight * (float)(lineIndex % linesOnScreen)));
+	}
+
+	Camera const&	screenCamera	=	g_theGame->m_screenCamera;
+	Texture const*	fontTexture		=	&g_theFont->GetTexture();
+	std::vector<Vertex_PCU>	lineVerts;
+	std::vector<SpriteQuad>	lineQuads;
+
+	g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Sprite batch benchmark: %d glyphs in %d lines, %d frames per mode", numOfGlyphs, numOfLines, numOfFrames));
+
+	// One draw per line is what every text caller did before the batch
+	RenderCommandStats perLineStats = CaptureRenderStats(*g_theRenderer, [&]()
+	{
+		g_theRenderer->BeginCamera(screenCamera);
+		g_theRenderer->SetBlendMode(BlendMode::ALPHA);
+		g_theRenderer->BindTexture(fontTexture);
+		for (int lineIndex = 0; lineIndex < numOfLines; ++lineIndex)
+		{
+			lineVerts.clear();
+			g_theFont->AddVertsForText2D(lineVerts, lineMins[lineIndex], cellHeight, lines[lineIndex], Rgba8::WHITE, 1.f);
+			g_theRenderer->DrawVertexArray((int)lineVerts.size(), lineVerts.data());
+		}
+		g_theRenderer->EndCamera(screenCamera);
+	}, numOfFrames);
+
+	std::string result = Stringf("%-14s %8.0f draws, %10.1f KB uploaded per frame",
+		"Per line", (double)perLineStats.GetNumOfDraws() * frameScale, (double)perLineStats.m_numOfBytesUploaded * frameScale / 1024.0);
+	DebuggerPrintf("%s\n", result.c_str());
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, result);
+
+	for (int modeIndex = 0; modeIndex < 2; ++modeIndex)
+	{
+		bool		expandsQuadsOnGPU	=	modeIndex == 1;
+		SpriteBatch	spriteBatch(*g_theRenderer, expandsQuadsOnGPU);
+		RenderCommandStats batchStats = CaptureRenderStats(*g_theRenderer, [&]()
+		{
+			g_theRenderer->BeginCamera(screenCamera);
+			spriteBatch.Begin();
+			for (int lineIndex = 0; lineIndex < numOfLines; ++lineIndex)
+			{
+				lineQuads.clear();
+				g_theFont->AddQuadsForText2D(lineQuads, lineMins[lineIndex], cellHeight, lines[lineIndex], Rgba8::WHITE, 1.f);
+				spriteBatch.AddQuads(fontTexture, BlendMode::ALPHA, lineQuads.data(), (int)lineQuads.size());
+			}
+			spriteBatch.End();
+			g_theRenderer->EndCamera(screenCamera);
+		}, numOfFrames);
+
+		result = Stringf("%-14s %8.0f draws, %10.1f KB uploaded per frame",
+			expandsQuadsOnGPU ? "Batch GPU quad" : "Batch CPU quad", (double)batchStats.GetNumOfDraws() * frameScale, (double)batchStats.m_numOfBytesUploaded * frameScale / 1024.0);
+		DebuggerPrintf("%s\n", result.c_str());
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, result);
+		if (batchStats.m_numOfValidationErrors > 0)
+		{
+			g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("Null backend validation failed with the sprite batch: %s", batchStats.m_firstValidationError));
+		}
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Peak memory of the OIT intermediates: all of them created up front, the last OIT frame's transients each in their own
+// allocation and aliased in one heap (EstimateSizeInBytes, the same on any backend), and what the D3D11 pool really holds
+bool Game::Command_RenderGraphMemory(EventArgs& args)
+{
+	UNUSED(args);
+	RenderGraphStats const&		stats			=	g_theGame->m_renderGraph->GetStats();
+	ResourcePoolStats const&	poolStats		=	g_theRenderer->GetResourcePoolStats();
+	double						bytesToMB		=	1.0 / (1024.0 * 1024.0);
+	size_t						upFrontBytes	=	g_theGame->GetUpFrontOITTransientBytes();
+
+	std::string lines[] =
+	{
+		Stringf("Render graph, last OIT frame: %d passes, %d culled, %d transients (%d unused)", stats.m_numOfPasses, stats.m_numOfCulledPasses, stats.m_numOfTransientResources, stats.m_numOfUnusedTransientResources),
+		Stringf("%-34s %8.1f MB", "Up front, every OIT intermediate", (double)upFrontBytes * bytesToMB),
+		Stringf("%-34s %8.1f MB", "Transients without aliasing", (double)stats.m_transientBytesWithoutAliasing * bytesToMB),
+		Stringf("%-34s %8.1f MB", "Transients aliased, heap peak", (double)stats.m_transientBytesWithAliasing * bytesToMB),
+		Stringf("%-34s %8.1f MB, %d resources (%d created)", "D3D11 resources this frame", (double)stats.m_physicalBytes * bytesToMB, stats.m_numOfPhysicalResources, stats.m_numOfPhysicalResourcesCreated),
+		Stringf("%-34s %8.1f MB in use, %.1f MB idle, %d hits, %d misses, %d destroyed", "Resource pool", (double)poolStats.m_bytesInUse * bytesToMB, (double)poolStats.m_idleBytes * bytesToMB,
+			poolStats.m_numOfHits, poolStats.m_numOfMisses, poolStats.m_numOfDestroyedResources),
+	};
+	for (int lineIndex = 0; lineIndex < (int)(sizeof(lines) / sizeof(lines[0])); ++lineIndex)
+	{
+		DebuggerPrintf("%s\n", lines[lineIndex].c_str());
+		g_theDevConsole->AddLine(lineIndex == 0 ? DevConsole::INFO_MAJOR : DevConsole::INFO_MINOR, lines[lineIndex]);
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// Rolling min/avg/max over the last frames of every render graph pass, so each OIT technique's passes can be compared
+// GPU times need a backend with timestamps, the null backend still has what recording and submitting cost
+// With pipeline statistics each line also has the average vertexes assembled and shader invocations per frame
+bool Game::Command_RenderTimings(EventArgs& args)
+{
+	UNUSED(args);
+	RenderProfiler const&			profiler		=	g_theRenderer->GetRenderProfiler();
+	std::vector<RenderTimingStats>	timingStats		=	profiler.GetTimingStats();
+
+	std::string header = Stringf("Render timings over the last %d frames (%d resolved, %d dropped waiting for the GPU), min/avg/max ms, avg pipeline statistics per frame",
+		NUM_OF_RENDER_TIMING_SAMPLES, profiler.GetNumOfResolvedFrames(), profiler.GetNumOfDroppedFrames());
+	DebuggerPrintf("%s\n", header.c_str());
+	g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, header);
+	for (RenderTimingStats const& stats : timingStats)
+	{
+		std::string gpuText = stats.m_numOfGPUSamples > 0 ? Stringf("%6.3f/%6.3f/%6.3f", stats.m_gpu.m_minMS, stats.m_gpu.m_avgMS, stats.m_gpu.m_maxMS) : std::string("   no GPU timestamps");
+		std::string line	= Stringf("%*s%-*s GPU %s  record %6.3f/%6.3f/%6.3f  submit %6.3f/%6.3f/%6.3f", stats.m_depth * 2, "", 56 - stats.m_depth * 2, stats.m_name.c_str(), gpuText.c_str(),
+			stats.m_cpuRecord.m_minMS, stats.m_cpuRecord.m_avgMS, stats.m_cpuRecord.m_maxMS, stats.m_cpuSubmit.m_minMS, stats.m_cpuSubmit.m_avgMS, stats.m_cpuSubmit.m_maxMS);
+		if (stats.m_numOfPipelineStatisticsSamples > 0)
+		{
+			PipelineStatistics const& statistics = stats.m_avgPipelineStatistics;
+			line += Stringf("  IA verts %llu  VS %llu  PS %llu  CS %llu", (unsigned long long)statistics.m_numOfVertexesAssembled, (unsigned long long)statistics.m_numOfVertexShaderInvocations,
+				(unsigned long long)statistics.m_numOfPixelShaderInvocations, (unsigned long long)statistics.m_numOfComputeShaderInvocations);
+		}
+		DebuggerPrintf("%s\n", line.c_str());
+		g_theDevConsole->AddLine(DevConsole::INFO_MINOR, line);
+	}
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+bool Game::Command_RenderTimingsTrace(EventArgs& args)
+{
+	std::string				filePath	=	args.GetValue("File", "Traces/RenderTimings.json");
+	RenderProfiler const&	profiler	=	g_theRenderer->GetRenderProfiler();
+	if (profiler.GetNumOfResolvedFrames() == 0)
+	{
+		g_theDevConsole->AddLine(DevConsole::ERROR, "No render timings resolved yet");
+		return true;
+	}
+	if (!profiler.WriteChromeTrace(filePath))
+	{
+		g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("Could not write the render timings trace to %s", filePath.c_str()));
+		return false;
+	}
+	g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Render timings trace written to %s", filePath.c_str()));
+	return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// The immediate mode path draws the whole scene from these in one call, every vert takes the mesh's color
+void Game::AppendMeshToSceneArrays(Scene& scene, std::vector<Vertex_PCU> const& verts, std::vector<unsigned int> const& indexes, Rgba8 const& meshColor)
+{
+	unsigned int firstVertIndex = (unsigned int)scene.m_sceneVertices.size();
+	for (unsigned int vertIndex = 0; vertIndex < (unsigned int)verts.size(); ++vertIndex)
+	{
+		Vertex_PCU currentVertex = verts[vertIndex];
+		currentVertex.m_color = meshColor;
+		scene.m_sceneVertices.emplace_back(currentVertex);
+	}
+	for (unsigned int index = 0; index < (unsigned int)indexes.size(); ++index)
+	{
+		scene.m_sceneIndexes.emplace_back(firstVertIndex + indexes[index]);
+	}
+}
+
+
+//--------------------------------------------------------------------------------------------------
+// For the quantized opaque meshes, whose loaded callbacks only see their Vertex_PCUTBN source verts
+void Game::AppendMeshToSceneArrays(Scene& scene, std::vector<Vertex_PCUTBN> const& verts, std::vector<unsigned int> const& indexes, Rgba8 const& meshColor)
+{
+	unsigned int firstVertIndex = (unsigned int)scene.m_sceneVertices.size();
+	for (unsigned int vertIndex = 0; vertIndex < (unsigned int)verts.size(); ++vertIndex)
+	{
+		scene.m_sceneVertices.emplace_back(verts[vertIndex].m_position, meshColor, verts[vertIndex].m_uvTexCoords);
+	}
+	for (unsigned int index = 0; index < (unsigned int)indexes.size(); ++index)
+	{
+		scene.m_sceneIndexes.emplace_back(firstVertIndex + indexes[index]);
+	}
+}
+
+
 //--------------------------------------------------------------------------------------------------
 void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 {
@@ -3023,6 +3401,8 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 		Vec3 meshkUp;
 		meshOrientation.GetAsVectors_XFwd_YLeft_ZUp(meshiForward, meshjLeft, meshkUp);
 		Vec3 meshHalfDims = meshDimension * 0.5f;
+		std::string	objFilePath;
+		Mat44		objTransformFixupMat;
 		switch (meshType)
 		{
 			case eMESH_TYPE_BILLBOARDED_QUAD:
@@ -3080,7 +3460,8 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 				Mat44 transformFixupMat;
 				transformFixupMat.SetIJKT3D(meshiForward, meshkUp, -meshjLeft, meshCenter);
 				transformFixupMat.AppendScaleUniform3D(meshHalfDims.x);
-				OBJLoader::LoadOBJFileByName("Data/Models/Teapot.obj", tempVerts, tempIndexes, transformFixupMat);
+				objFilePath			=	"Data/Models/Teapot.obj";
+				objTransformFixupMat	=	transformFixupMat;
 				currentMesh.m_debugName = L"Teapot Render";
 				break;
 			}
@@ -3089,7 +3470,8 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 				Mat44 transformFixupMat;
 				transformFixupMat.SetIJKT3D(-meshiForward, meshkUp, meshjLeft, meshCenter);
 				transformFixupMat.AppendScaleUniform3D(meshHalfDims.x);
-				OBJLoader::LoadOBJFileByName("Data/Models/StanfordBunny.obj", tempVerts, tempIndexes, transformFixupMat);
+				objFilePath			=	"Data/Models/StanfordBunny.obj";
+				objTransformFixupMat	=	transformFixupMat;
 				currentMesh.m_debugName = L"Bunny Render";
 				break;
 			}
@@ -3098,7 +3480,8 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 				Mat44 transformFixupMat;
 				transformFixupMat.SetIJKT3D(meshjLeft, meshkUp, meshiForward, meshCenter);
 				transformFixupMat.AppendScaleUniform3D(meshHalfDims.x);
-				OBJLoader::LoadOBJFileByName("Data/Models/FridgeDoor.obj", tempVerts, tempIndexes, transformFixupMat);
+				objFilePath			=	"Data/Models/FridgeDoor.obj";
+				objTransformFixupMat	=	transformFixupMat;
 				currentMesh.m_debugName = L"Fridge Door Render";
 				break;
 			}
@@ -3107,7 +3490,8 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 				Mat44 transformFixupMat;
 				transformFixupMat.SetIJKT3D(meshjLeft, meshkUp, meshiForward, meshCenter);
 				transformFixupMat.AppendScaleUniform3D(meshHalfDims.x);
-				OBJLoader::LoadOBJFileByName("Data/Models/FridgeBody.obj", tempVerts, tempIndexes, transformFixupMat);
+				objFilePath			=	"Data/Models/FridgeBody.obj";
+				objTransformFixupMat	=	transformFixupMat;
 				currentMesh.m_debugName = L"Fridge Body Render";
 				break;
 			}
@@ -3116,7 +3500,8 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 				Mat44 transformFixupMat;
 				transformFixupMat.SetIJKT3D(meshjLeft, meshkUp, meshiForward, meshCenter);
 				transformFixupMat.AppendScaleUniform3D(meshHalfDims.x);
-				OBJLoader::LoadOBJFileByName("Data/Models/CarBody.obj", tempVerts, tempIndexes, transformFixupMat);
+				objFilePath			=	"Data/Models/CarBody.obj";
+				objTransformFixupMat	=	transformFixupMat;
 				currentMesh.m_debugName = L"Car Body Render";
 				break;
 			}
@@ -3125,7 +3510,8 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 				Mat44 transformFixupMat;
 				transformFixupMat.SetIJKT3D(meshjLeft, meshkUp, meshiForward, meshCenter);
 				transformFixupMat.AppendScaleUniform3D(meshHalfDims.x);
-				OBJLoader::LoadOBJFileByName("Data/Models/CarGlass1.obj", tempVerts, tempIndexes, transformFixupMat);
+				objFilePath			=	"Data/Models/CarGlass1.obj";
+				objTransformFixupMat	=	transformFixupMat;
 				currentMesh.m_debugName = L"Car Glass 1 Render";
 				break;
 			}
@@ -3134,7 +3520,8 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 				Mat44 transformFixupMat;
 				transformFixupMat.SetIJKT3D(meshjLeft, meshkUp, meshiForward, meshCenter);
 				transformFixupMat.AppendScaleUniform3D(meshHalfDims.x);
-				OBJLoader::LoadOBJFileByName("Data/Models/CarGlass2.obj", tempVerts, tempIndexes, transformFixupMat);
+				objFilePath			=	"Data/Models/CarGlass2.obj";
+				objTransformFixupMat	=	transformFixupMat;
 				currentMesh.m_debugName = L"Car Glass 2 Render";
 				break;
 			}
@@ -3152,7 +3539,7 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 			{
 				std::string textureResourceDebugName		=	ParseXmlAttribute(*textureResourceElement, "debugTextureName", "INVALID");
 				GUARANTEE_OR_DIE(textureResourceDebugName	!= "INVALID", "Please provide a debug name for texture resource");
-				currentMesh.m_textureResource			=	g_theRenderer->CreateTextureResourceFromFile(textureResourceFilePath.c_str(), textureResourceDebugName.c_str(), (unsigned int)textureResourceDebugName.size());
+				currentMesh.m_textureAsset				=	g_theAssetLoader->RequestTextureResource(textureResourceFilePath, textureResourceDebugName);
 			}
 		}
 		
@@ -3162,28 +3549,38 @@ void Game::InitializeSceneFromElement(XmlElement const& sceneDef)
 		// 	currentSceneObjects = new Scene;
 		// }
 
-		unsigned int currentSceneIndexeSize = (unsigned int)currentScene->m_sceneVertices.size();
-		for (unsigned int currentIndex = 0; currentIndex < tempVerts.size(); ++currentIndex)
+		// OBJ meshes stream in through the asset loader, until then they draw nothing and the immediate mode scene arrays go without them
+		// Opaque ones only ever draw with the default shader, so they are uploaded quantized and drawn with its quantized counterpart
+		if (!objFilePath.empty() && isOpaque)
 		{
-			Vertex_PCU currentVertex = tempVerts[currentIndex];
-			currentVertex.m_color = currentMesh.m_color;
-			currentScene->m_sceneVertices.emplace_back(currentVertex);
+			Scene*	scene		=	currentScene;
+			Rgba8	meshColor	=	currentMesh.m_color;
+			currentMesh.m_meshAsset	=	g_theAssetLoader->RequestMeshPCUTBNQuantized(objFilePath, objTransformFixupMat, sceneName + "_" + meshTypeAsString, [scene, meshColor](Asset const& meshAsset)
+			{
+				AppendMeshToSceneArrays(*scene, meshAsset.GetDecodedPCUTBNVerts(), meshAsset.GetDecodedIndexes(), meshColor);
+			});
 		}
-		// currentSceneObjects->m_sceneVertices.insert(currentSceneObjects->m_sceneVertices.end(), tempVerts.begin(), tempVerts.end());
-		currentMesh.m_vertexBuffer	=	g_theRenderer->CreateVertexBuffer(tempVerts.size(), sizeof(Vertex_PCU), ResourceUsage::GPU_READ, tempVerts.data());
-		std::string debugMeshVBName =	sceneName + "_" + meshTypeAsString + "_VertexBuffer";
-		g_theRenderer->SetDebugResourceName(currentMesh.m_vertexBuffer, (unsigned int)debugMeshVBName.size(), debugMeshVBName.c_str());
-		
-		
-		currentMesh.m_numOfIndexes			=	(unsigned int)tempIndexes.size();
-		for (unsigned int index = 0; index < currentMesh.m_numOfIndexes; ++index)
+		else if (!objFilePath.empty())
+		{
+			Scene*	scene		=	currentScene;
+			Rgba8	meshColor	=	currentMesh.m_color;
+			currentMesh.m_meshAsset	=	g_theAssetLoader->RequestMesh(objFilePath, objTransformFixupMat, sceneName + "_" + meshTypeAsString, [scene, meshColor](Asset const& meshAsset)
+			{
+				AppendMeshToSceneArrays(*scene, meshAsset.GetDecodedVerts(), meshAsset.GetDecodedIndexes(), meshColor);
+			});
+		}
+		else
 		{
-			unsigned int currentIndex = currentSceneIndexeSize + tempIndexes[index];
-			currentScene->m_sceneIndexes.emplace_back(currentIndex);
+			AppendMeshToSceneArrays(*currentScene, tempVerts, tempIndexes, currentMesh.m_color);
+			currentMesh.m_vertexBuffer	=	g_theRenderer->CreateVertexBuffer(tempVerts.size(), sizeof(Vertex_PCU), ResourceUsage::GPU_READ, tempVerts.data());
+			std::string debugMeshVBName =	sceneName + "_" + meshTypeAsString + "_VertexBuffer";
+			g_theRenderer->SetDebugResourceName(currentMesh.m_vertexBuffer, (unsigned int)debugMeshVBName.size(), debugMeshVBName.c_str());
+
+			currentMesh.m_numOfIndexes	=	(unsigned int)tempIndexes.size();
+			currentMesh.m_indexBuffer	=	g_theRenderer->CreateIndexBuffer(currentMesh.m_numOfIndexes, ResourceUsage::GPU_READ, tempIndexes.data());
+			std::string debugMeshIBName =	sceneName + "_" + meshTypeAsString + "_IndexBuffer";
+			g_theRenderer->SetDebugResourceName(currentMesh.m_indexBuffer, (unsigned int)debugMeshIBName.size(), debugMeshIBName.c_str());
 		}
-		currentMesh.m_indexBuffer	=	g_theRenderer->CreateIndexBuffer(currentMesh.m_numOfIndexes, ResourceUsage::GPU_READ, tempIndexes.data());
-		std::string debugMeshIBName =	sceneName + "_" + meshTypeAsString + "_IndexBuffer";
-		g_theRenderer->SetDebugResourceName(currentMesh.m_indexBuffer, (unsigned int)debugMeshIBName.size(), debugMeshIBName.c_str());
 		
 		std::vector<SceneObject>& currentSceneObjects = !isOpaque ? currentScene->m_translucentObjects : currentScene->m_opaqueObjects;
 		currentSceneObjects.emplace_back(currentMesh);
@@ -3434,168 +3831,25 @@ void Game::InitializeResources()
 	g_theRenderer->CreateRenderTargetResource(m_quadrant2RenderTarget,					true,  "Quadrant 2 Render Target",					sizeof("Quadrant 2 Render Target"));
 	g_theRenderer->CreateRenderTargetResource(m_quadrant3RenderTarget,					true,  "Quadrant 3 Render Target",					sizeof("Quadrant 3 Render Target"));
 	g_theRenderer->CreateRenderTargetResource(m_quadrant4RenderTarget,					true,  "Quadrant 4 Render Target",					sizeof("Quadrant 4 Render Target"));
-	g_theRenderer->CreateRenderTargetResource(m_intermediateRenderTarget,				true, "Intermediate Render Target",				sizeof("Intermediate Render Target"));
-	g_theRenderer->CreateRenderTargetResource(m_intermediateTarget,						true,  "Intermediate Target",						sizeof("Intermediate Target"));
 	g_theRenderer->CreateRenderTargetResource(m_opaqueBackgroundQuadrant1RenderTarget,	false, "Opaque BG Quadrant 1 RT",		sizeof("Opaque BG Quadrant 1 RT"));
-	g_theRenderer->CreateRenderTargetResource(m_depthPeelingIntermediateRenderTarget,	true,  "Depth Peeling Intermediate Render Target",	sizeof("Depth Peeling Intermediate Render Target"));
 
 	g_theRenderer->CreateDepthResource(m_quadrant1DepthTarget,					"Quadrant 1 Depth Target",					sizeof("Quadrant 1 Depth Target"),					true);
 	g_theRenderer->CreateDepthResource(m_quadrant2DepthTarget,					"Quadrant 2 Depth Target",					sizeof("Quadrant 2 Depth Target"),					true);
 	g_theRenderer->CreateDepthResource(m_quadrant3DepthTarget,					"Quadrant 3 Depth Target",					sizeof("Quadrant 3 Depth Target"),					true);
 	g_theRenderer->CreateDepthResource(m_quadrant4DepthTarget,					"Quadrant 4 Depth Target",					sizeof("Quadrant 4 Depth Target"),					true);
-	g_theRenderer->CreateDepthResource(m_depthPeelingIntermediateDepthTarget,	"Depth Peeling Intermediate Depth Target",	sizeof("Depth Peeling Intermediate Depth Target"),	true);
 
 	IntVec2 windowDim	=	g_theWindow->GetClientDimensions();
-	{
-		// Buffer resources 
-		// Structured Buffer
-		int numOfNodes		=	32;										// Make sure to change the number of nodes in the hlsl (compute shader, both clear and other one)as well
-		int numOfElements	=	windowDim.x * windowDim.y * numOfNodes;
-		std::vector<Fragment> defaultFragData;
-		defaultFragData.resize((size_t)numOfElements);
-		
-		D3D11_ResourceConfig structuredBufferConfig			=	{ };
-		structuredBufferConfig.m_numOfElements				=	numOfElements;
-		structuredBufferConfig.m_elementStride				=	sizeof(Fragment);
-		structuredBufferConfig.m_usageFlag					=	ResourceUsage::GPU_READ_GPU_WRITE;
-		structuredBufferConfig.m_defaultInitializationData	=	defaultFragData.data();
-		structuredBufferConfig.m_format						=	ResourceViewFormat::DXGI_FORMAT_UNKNOWN;
-		structuredBufferConfig.m_isStandard					=	false;
-		structuredBufferConfig.m_type						=	ResourceType::STRUCTURED_BUFFER;
-		structuredBufferConfig.m_debugName					=	"FragmentsPerPixelStructuredBuffer_32";
-		structuredBufferConfig.m_debugNameSize				=	sizeof("FragmentsPerPixelStructuredBuffer_32");
-		g_theRenderer->CreateResourceFromConfig(structuredBufferConfig, m_fragmentsPerPixelStructuredBuffer_32);
-
-		// Byte-Address Buffer
-		numOfElements = windowDim.x * windowDim.y;
-		std::vector<unsigned int> defaultRootLinkedListData;
-		defaultRootLinkedListData.resize(numOfElements, 0xFFFFFFFFU);
-		// g_theRenderer->CreateRawBuffer(m_byteAddressBufferOfHeadLinkedList, windowDim.x * windowDim.y, ResourceUsage::GPU_READ_GPU_WRITE, defaultRootLinkedListData.data());
-		// g_theRenderer->SetDebugResourceName(m_byteAddressBufferOfHeadLinkedList, sizeof("HeadOfFragmentsPerPixelLinkedList"), "HeadOfFragmentsPerPixelLinkedList");
-
-		
-		D3D11_ResourceConfig rawBufferConfig			=	{ };
-		rawBufferConfig.m_numOfElements					=	numOfElements;
-		rawBufferConfig.m_elementStride					=	4;
-		rawBufferConfig.m_usageFlag						=	ResourceUsage::GPU_READ_GPU_WRITE;
-		rawBufferConfig.m_defaultInitializationData		=	defaultRootLinkedListData.data();
-		rawBufferConfig.m_type							=	ResourceType::RAW_BUFFER;
-		rawBufferConfig.m_debugName						=	"headNodeByteAddressBuffer_32";
-		rawBufferConfig.m_debugNameSize					=	sizeof("headNodeByteAddressBuffer_32");
-		g_theRenderer->CreateResourceFromConfig(rawBufferConfig, m_headNodeByteAddressBuffer_32);
-
-		// Constant Buffer
-		m_gameConstantBuffer				=	g_theRenderer->CreateConstantBuffer(sizeof(GameConstants));
-		GameConstants screenConstants		=	{ };
-		screenConstants.m_screenWidth		=	(float)windowDim.x;
-		screenConstants.m_uintMax			=	(unsigned int)-1;
-		screenConstants.m_cameraFar			=   m_player->m_camera.GetCameraFarClipDist();
-		g_theRenderer->CopyCPUToGPU(&screenConstants, sizeof(GameConstants), m_gameConstantBuffer);
-		g_theRenderer->BindConstantBuffer(g_gameConstantsSlot, m_gameConstantBuffer, BindingLocation::COMPUTE_SHADER);
-	}
-
-	{
-		// Buffer resources 
-		// Structured Buffer
-		int numOfNodes		=	4;										// Make sure to change the number of nodes in the hlsl (compute shader, both clear and other one)as well
-		int numOfElements	=	windowDim.x * windowDim.y * numOfNodes;
-		std::vector<Fragment> defaultFragData;
-		defaultFragData.resize((size_t)numOfElements);
-		
-		D3D11_ResourceConfig structuredBufferConfig			=	{ };
-		structuredBufferConfig.m_numOfElements				=	numOfElements;
-		structuredBufferConfig.m_elementStride				=	sizeof(Fragment);
-		structuredBufferConfig.m_usageFlag					=	ResourceUsage::GPU_READ_GPU_WRITE;
-		structuredBufferConfig.m_defaultInitializationData	=	defaultFragData.data();
-		structuredBufferConfig.m_format						=	ResourceViewFormat::DXGI_FORMAT_UNKNOWN;
-		structuredBufferConfig.m_isStandard					=	false;
-		structuredBufferConfig.m_type						=	ResourceType::STRUCTURED_BUFFER;
-		structuredBufferConfig.m_debugName					=	"FragmentsPerPixelStructuredBuffer_4";
-		structuredBufferConfig.m_debugNameSize				=	sizeof("FragmentsPerPixelStructuredBuffer_4");
-		g_theRenderer->CreateResourceFromConfig(structuredBufferConfig, m_fragmentsPerPixelStructuredBuffer_4);
-
-		// Byte-Address Buffer
-		numOfElements = windowDim.x * windowDim.y;
-		std::vector<unsigned int> defaultRootLinkedListData;
-		defaultRootLinkedListData.resize(numOfElements, 0xFFFFFFFFU);
-		// g_theRenderer->CreateRawBuffer(m_byteAddressBufferOfHeadLinkedList, windowDim.x * windowDim.y, ResourceUsage::GPU_READ_GPU_WRITE, defaultRootLinkedListData.data());
-		// g_theRenderer->SetDebugResourceName(m_byteAddressBufferOfHeadLinkedList, sizeof("HeadOfFragmentsPerPixelLinkedList"), "HeadOfFragmentsPerPixelLinkedList");
-
-		
-		D3D11_ResourceConfig rawBufferConfig			=	{ };
-		rawBufferConfig.m_numOfElements					=	numOfElements;
-		rawBufferConfig.m_elementStride					=	4;
-		rawBufferConfig.m_usageFlag						=	ResourceUsage::GPU_READ_GPU_WRITE;
-		rawBufferConfig.m_defaultInitializationData		=	defaultRootLinkedListData.data();
-		rawBufferConfig.m_type							=	ResourceType::RAW_BUFFER;
-		rawBufferConfig.m_debugName						=	"headNodeByteAddressBuffer_4";
-		rawBufferConfig.m_debugNameSize					=	sizeof("headNodeByteAddressBuffer_4");
-		g_theRenderer->CreateResourceFromConfig(rawBufferConfig, m_headNodeByteAddressBuffer_4);
-	}
-
-
-	{
-		// Buffer resources 
-		// Structured Buffer
-		int numOfNodes		=	2;										// Make sure to change the number of nodes in the hlsl (compute shader, both clear and other one)as well
-		int numOfElements	=	windowDim.x * windowDim.y * numOfNodes;
-		std::vector<Fragment> defaultFragData;
-		defaultFragData.resize((size_t)numOfElements);
-		
-		D3D11_ResourceConfig structuredBufferConfig			=	{ };
-		structuredBufferConfig.m_numOfElements				=	numOfElements;
-		structuredBufferConfig.m_elementStride				=	sizeof(Fragment);
-		structuredBufferConfig.m_usageFlag					=	ResourceUsage::GPU_READ_GPU_WRITE;
-		structuredBufferConfig.m_defaultInitializationData	=	defaultFragData.data();
-		structuredBufferConfig.m_format						=	ResourceViewFormat::DXGI_FORMAT_UNKNOWN;
-		structuredBufferConfig.m_isStandard					=	false;
-		structuredBufferConfig.m_type						=	ResourceType::STRUCTURED_BUFFER;
-		structuredBufferConfig.m_debugName					=	"FragmentsPerPixelStructuredBuffer_2";
-		structuredBufferConfig.m_debugNameSize				=	sizeof("FragmentsPerPixelStructuredBuffer_2");
-		g_theRenderer->CreateResourceFromConfig(structuredBufferConfig, m_fragmentsPerPixelStructuredBuffer_2);
-
-		// Byte-Address Buffer
-		numOfElements = windowDim.x * windowDim.y;
-		std::vector<unsigned int> defaultRootLinkedListData;
-		defaultRootLinkedListData.resize(numOfElements, 0xFFFFFFFFU);
-		// g_theRenderer->CreateRawBuffer(m_byteAddressBufferOfHeadLinkedList, windowDim.x * windowDim.y, ResourceUsage::GPU_READ_GPU_WRITE, defaultRootLinkedListData.data());
-		// g_theRenderer->SetDebugResourceName(m_byteAddressBufferOfHeadLinkedList, sizeof("HeadOfFragmentsPerPixelLinkedList"), "HeadOfFragmentsPerPixelLinkedList");
-
-		
-		D3D11_ResourceConfig rawBufferConfig			=	{ };
-		rawBufferConfig.m_numOfElements					=	numOfElements;
-		rawBufferConfig.m_elementStride					=	4;
-		rawBufferConfig.m_usageFlag						=	ResourceUsage::GPU_READ_GPU_WRITE;
-		rawBufferConfig.m_defaultInitializationData		=	defaultRootLinkedListData.data();
-		rawBufferConfig.m_type							=	ResourceType::RAW_BUFFER;
-		rawBufferConfig.m_debugName						=	"headNodeByteAddressBuffer_2";
-		rawBufferConfig.m_debugNameSize					=	sizeof("headNodeByteAddressBuffer_2");
-		g_theRenderer->CreateResourceFromConfig(rawBufferConfig, m_headNodeByteAddressBuffer_2);
-	}
-
-
-	// Weighted Blended OIT textures
-	D3D11_ResourceConfig accumulationRenderTargetConfig		=	{ };
-	accumulationRenderTargetConfig.m_type					=	ResourceType::TEXTURE2D;
-	accumulationRenderTargetConfig.m_usageFlag				=	ResourceUsage::GPU_READ_GPU_WRITE;
-	accumulationRenderTargetConfig.m_format					=	ResourceViewFormat::DXGI_FORMAT_R16G16B16A16_FLOAT;
-	accumulationRenderTargetConfig.m_bindFlags				=	ResourceBindFlag((unsigned int)ResourceBindFlag::RENDER_TARGET | (unsigned int)ResourceBindFlag::SHADER_RESOURCE);
-	accumulationRenderTargetConfig.m_debugName				=	"AccumulationRenderTarget";
-	accumulationRenderTargetConfig.m_debugNameSize			=	sizeof("AccumulationRenderTarget");
-	accumulationRenderTargetConfig.m_width					=	windowDim.x;
-	accumulationRenderTargetConfig.m_height					=	windowDim.y;
-	g_theRenderer->CreateResourceFromConfig(accumulationRenderTargetConfig, m_accumulationTargetWeightedBlended);
-
-	D3D11_ResourceConfig revealageRenderTargetConfig		=	{ };
-	revealageRenderTargetConfig.m_type				=	ResourceType::TEXTURE2D;
-	revealageRenderTargetConfig.m_usageFlag			=	ResourceUsage::GPU_READ_GPU_WRITE;
-	revealageRenderTargetConfig.m_format			=	ResourceViewFormat::DXGI_FORMAT_R16_FLOAT;
-	revealageRenderTargetConfig.m_bindFlags			=	ResourceBindFlag((unsigned int)ResourceBindFlag::RENDER_TARGET | (unsigned int)ResourceBindFlag::SHADER_RESOURCE);
-	revealageRenderTargetConfig.m_debugName			=	"RevealageRenderTarget";
-	revealageRenderTargetConfig.m_debugNameSize		=	sizeof("RevealageRenderTarget");
-	revealageRenderTargetConfig.m_width				=	windowDim.x;
-	revealageRenderTargetConfig.m_height			=	windowDim.y;
-	g_theRenderer->CreateResourceFromConfig(revealageRenderTargetConfig, m_revealageTargetWeightedBlended);
+	size_t numOfPixels	=	size_t(windowDim.x) * size_t(windowDim.y);
+	InitializeOITTransientConfigs(windowDim);
+
+	// Constant Buffer
+	m_gameConstantBuffer				=	g_theRenderer->CreateConstantBuffer(sizeof(GameConstants));
+	GameConstants screenConstants		=	{ };
+	screenConstants.m_screenWidth		=	(float)windowDim.x;
+	screenConstants.m_uintMax			=	(unsigned int)-1;
+	screenConstants.m_cameraFar			=   m_player->m_camera.GetCameraFarClipDist();
+	g_theRenderer->CopyCPUToGPU(&screenConstants, sizeof(GameConstants), m_gameConstantBuffer);
+	g_theRenderer->BindConstantBuffer(g_gameConstantsSlot, m_gameConstantBuffer, BindingLocation::COMPUTE_SHADER);
 
 	// MLAB Resources
 	m_screenConstantBuffer					=	g_theRenderer->CreateConstantBuffer(sizeof(ScreenConstants));
@@ -3605,8 +3859,7 @@ void Game::InitializeResources()
 	g_theRenderer->BindConstantBuffer(g_screenConstantsSlot, m_screenConstantBuffer, BindingLocation::COMPUTE_SHADER);
 
 	// Unoptimized MLAB Resources
-	// // Untouched Fragment Mask
-	size_t numOfPixels = size_t(windowDim.x) * size_t(windowDim.y);
+	// // Untouched Fragment Mask, persistent since the populate shaders rely on the previous frame leaving it reset
 	std::vector<unsigned char> unoptimizedMLABClearedMaskDefaultData;
 	unoptimizedMLABClearedMaskDefaultData.resize(numOfPixels, (unsigned char)1);
 
@@ -3622,54 +3875,88 @@ void Game::InitializeResources()
 	unoptimizedMLABUntouchedFragmentMaskConfig.m_defaultInitializationData	=   unoptimizedMLABClearedMaskDefaultData.data();
 	unoptimizedMLABUntouchedFragmentMaskConfig.m_sizeOfTexelInBytes			=	1;
 	g_theRenderer->CreateResourceFromConfig(unoptimizedMLABUntouchedFragmentMaskConfig, m_unoptimizedMLABUntouchedFragmentMask);
+}
 
-	// // Blending Array Structured Buffer
+
+//--------------------------------------------------------------------------------------------------
+// The intermediates are not created here, every frame the render graph backs the ones the frame's modes use and only for as
+// long as their passes need them. None of them has initial data, each mode clears them or (PPLL, MLAB) never reads stale contents
+void Game::InitializeOITTransientConfigs(IntVec2 const& windowDim)
+{
+	static char const* const transientNames[eOIT_TRANSIENT_COUNT] =
 	{
-		UnoptimizedFragmentArray_2* blendingArray = new UnoptimizedFragmentArray_2[numOfPixels]();
+		"Intermediate Target",
+		"Intermediate Render Target",
+		"Depth Peeling Intermediate Render Target",
+		"Depth Peeling Intermediate Depth Target",
+		"AccumulationRenderTarget",
+		"RevealageRenderTarget",
+		"headNodeByteAddressBuffer_2",
+		"headNodeByteAddressBuffer_4",
+		"headNodeByteAddressBuffer_32",
+		"FragmentsPerPixelStructuredBuffer_2",
+		"FragmentsPerPixelStructuredBuffer_4",
+		"FragmentsPerPixelStructuredBuffer_32",
+		"Unoptimized MLAB Blending Array",
+		"Unoptimized MLAB Blending Array_4",
+		"Unoptimized MLAB Blending Array_32",
+	};
 
-		D3D11_ResourceConfig unoptimizedMLABstructuredBufferConfig = { };
-		unoptimizedMLABstructuredBufferConfig.m_defaultInitializationData = blendingArray;
-		unoptimizedMLABstructuredBufferConfig.m_numOfElements = (unsigned int)numOfPixels;
-		unoptimizedMLABstructuredBufferConfig.m_elementStride = sizeof(UnoptimizedFragmentArray_2);
-		unoptimizedMLABstructuredBufferConfig.m_isStandard = false;
-		unoptimizedMLABstructuredBufferConfig.m_usageFlag = ResourceUsage::GPU_READ_GPU_WRITE;
-		unoptimizedMLABstructuredBufferConfig.m_format = ResourceViewFormat::DXGI_FORMAT_UNKNOWN;
-		unoptimizedMLABstructuredBufferConfig.m_type = ResourceType::STRUCTURED_BUFFER;
-		unoptimizedMLABstructuredBufferConfig.m_debugNameSize = sizeof("Unoptimized MLAB Blending Array");
-		unoptimizedMLABstructuredBufferConfig.m_debugName = "Unoptimized MLAB Blending Array";
-		g_theRenderer->CreateResourceFromConfig(unoptimizedMLABstructuredBufferConfig, m_unoptimizedMLABStructuredBuffer_2);
-	}
+	m_oitTransientConfigs[eOIT_TRANSIENT_INTERMEDIATE_TARGET]			=	Renderer::GetRenderTargetResourceConfig(true, windowDim);
+	m_oitTransientConfigs[eOIT_TRANSIENT_INTERMEDIATE_RENDER_TARGET]	=	Renderer::GetRenderTargetResourceConfig(true, windowDim);
+	m_oitTransientConfigs[eOIT_TRANSIENT_DEPTH_PEELING_RENDER_TARGET]	=	Renderer::GetRenderTargetResourceConfig(true, windowDim);
+	m_oitTransientConfigs[eOIT_TRANSIENT_DEPTH_PEELING_DEPTH_TARGET]	=	Renderer::GetDepthResourceConfig(true, windowDim);
 
-	{
-		UnoptimizedFragmentArray_4* blendingArray	= new UnoptimizedFragmentArray_4[numOfPixels]();
+	// Weighted Blended OIT textures
+	D3D11_ResourceConfig& accumulationRenderTargetConfig	=	m_oitTransientConfigs[eOIT_TRANSIENT_ACCUMULATION_TARGET];
+	accumulationRenderTargetConfig.m_type					=	ResourceType::TEXTURE2D;
+	accumulationRenderTargetConfig.m_usageFlag				=	ResourceUsage::GPU_READ_GPU_WRITE;
+	accumulationRenderTargetConfig.m_format					=	ResourceViewFormat::DXGI_FORMAT_R16G16B16A16_FLOAT;
+	accumulationRenderTargetConfig.m_bindFlags				=	ResourceBindFlag((unsigned int)ResourceBindFlag::RENDER_TARGET | (unsigned int)ResourceBindFlag::SHADER_RESOURCE);
+	accumulationRenderTargetConfig.m_width					=	windowDim.x;
+	accumulationRenderTargetConfig.m_height					=	windowDim.y;
 
-		D3D11_ResourceConfig unoptimizedMLABstructuredBufferConfig			=	{ };
-		unoptimizedMLABstructuredBufferConfig.m_defaultInitializationData	=	blendingArray;
-		unoptimizedMLABstructuredBufferConfig.m_numOfElements				=	(unsigned int)numOfPixels;
-		unoptimizedMLABstructuredBufferConfig.m_elementStride				=	sizeof(UnoptimizedFragmentArray_4);
-		unoptimizedMLABstructuredBufferConfig.m_isStandard					=	false;
-		unoptimizedMLABstructuredBufferConfig.m_usageFlag					=	ResourceUsage::GPU_READ_GPU_WRITE;
-		unoptimizedMLABstructuredBufferConfig.m_format						=	ResourceViewFormat::DXGI_FORMAT_UNKNOWN;
-		unoptimizedMLABstructuredBufferConfig.m_type						=	ResourceType::STRUCTURED_BUFFER;
-		unoptimizedMLABstructuredBufferConfig.m_debugNameSize				=	sizeof("Unoptimized MLAB Blending Array_4");
-		unoptimizedMLABstructuredBufferConfig.m_debugName					=	"Unoptimized MLAB Blending Array_4";
-		g_theRenderer->CreateResourceFromConfig(unoptimizedMLABstructuredBufferConfig, m_unoptimizedMLABStructuredBuffer_4);
+	D3D11_ResourceConfig& revealageRenderTargetConfig		=	m_oitTransientConfigs[eOIT_TRANSIENT_REVEALAGE_TARGET];
+	revealageRenderTargetConfig.m_type						=	ResourceType::TEXTURE2D;
+	revealageRenderTargetConfig.m_usageFlag					=	ResourceUsage::GPU_READ_GPU_WRITE;
+	revealageRenderTargetConfig.m_format					=	ResourceViewFormat::DXGI_FORMAT_R16_FLOAT;
+	revealageRenderTargetConfig.m_bindFlags					=	ResourceBindFlag((unsigned int)ResourceBindFlag::RENDER_TARGET | (unsigned int)ResourceBindFlag::SHADER_RESOURCE);
+	revealageRenderTargetConfig.m_width						=	windowDim.x;
+	revealageRenderTargetConfig.m_height					=	windowDim.y;
+
+	// Per Pixel Linked List buffers and Unoptimized MLAB blending arrays, make sure the number of nodes matches the hlsl
+	unsigned int numOfPixels								=	(unsigned int)windowDim.x * (unsigned int)windowDim.y;
+	unsigned int const numOfNodes[eNODES_COUNT]				=	{ 2, 4, 32 };
+	unsigned int const blendingArrayStrides[eNODES_COUNT]	=	{ sizeof(UnoptimizedFragmentArray_2), sizeof(UnoptimizedFragmentArray_4), sizeof(UnoptimizedFragmentArray_32) };
+	for (int nodesIndex = 0; nodesIndex < eNODES_COUNT; ++nodesIndex)
+	{
+		D3D11_ResourceConfig& rawBufferConfig			=	m_oitTransientConfigs[eOIT_TRANSIENT_HEAD_NODES_2 + nodesIndex];
+		rawBufferConfig.m_numOfElements					=	numOfPixels;
+		rawBufferConfig.m_elementStride					=	4;
+		rawBufferConfig.m_usageFlag						=	ResourceUsage::GPU_READ_GPU_WRITE;
+		rawBufferConfig.m_type							=	ResourceType::RAW_BUFFER;
+
+		D3D11_ResourceConfig& structuredBufferConfig	=	m_oitTransientConfigs[eOIT_TRANSIENT_FRAGMENTS_2 + nodesIndex];
+		structuredBufferConfig.m_numOfElements			=	numOfPixels * numOfNodes[nodesIndex];
+		structuredBufferConfig.m_elementStride			=	sizeof(Fragment);
+		structuredBufferConfig.m_usageFlag				=	ResourceUsage::GPU_READ_GPU_WRITE;
+		structuredBufferConfig.m_format					=	ResourceViewFormat::DXGI_FORMAT_UNKNOWN;
+		structuredBufferConfig.m_isStandard				=	false;
+		structuredBufferConfig.m_type					=	ResourceType::STRUCTURED_BUFFER;
+
+		D3D11_ResourceConfig& blendingArrayConfig		=	m_oitTransientConfigs[eOIT_TRANSIENT_MLAB_BLENDING_ARRAY_2 + nodesIndex];
+		blendingArrayConfig.m_numOfElements				=	numOfPixels;
+		blendingArrayConfig.m_elementStride				=	blendingArrayStrides[nodesIndex];
+		blendingArrayConfig.m_isStandard				=	false;
+		blendingArrayConfig.m_usageFlag					=	ResourceUsage::GPU_READ_GPU_WRITE;
+		blendingArrayConfig.m_format					=	ResourceViewFormat::DXGI_FORMAT_UNKNOWN;
+		blendingArrayConfig.m_type						=	ResourceType::STRUCTURED_BUFFER;
 	}
 
+	for (int transientIndex = 0; transientIndex < eOIT_TRANSIENT_COUNT; ++transientIndex)
 	{
-		UnoptimizedFragmentArray_32* blendingArray = new UnoptimizedFragmentArray_32[numOfPixels]();
-
-		D3D11_ResourceConfig unoptimizedMLABstructuredBufferConfig = { };
-		unoptimizedMLABstructuredBufferConfig.m_defaultInitializationData = blendingArray;
-		unoptimizedMLABstructuredBufferConfig.m_numOfElements = (unsigned int)numOfPixels;
-		unoptimizedMLABstructuredBufferConfig.m_elementStride = sizeof(UnoptimizedFragmentArray_32);
-		unoptimizedMLABstructuredBufferConfig.m_isStandard = false;
-		unoptimizedMLABstructuredBufferConfig.m_usageFlag = ResourceUsage::GPU_READ_GPU_WRITE;
-		unoptimizedMLABstructuredBufferConfig.m_format = ResourceViewFormat::DXGI_FORMAT_UNKNOWN;
-		unoptimizedMLABstructuredBufferConfig.m_type = ResourceType::STRUCTURED_BUFFER;
-		unoptimizedMLABstructuredBufferConfig.m_debugNameSize = sizeof("Unoptimized MLAB Blending Array_32");
-		unoptimizedMLABstructuredBufferConfig.m_debugName = "Unoptimized MLAB Blending Array_32";
-		g_theRenderer->CreateResourceFromConfig(unoptimizedMLABstructuredBufferConfig, m_unoptimizedMLABStructuredBuffer_32);
+		m_oitTransientConfigs[transientIndex].m_debugName		=	transientNames[transientIndex];
+		m_oitTransientConfigs[transientIndex].m_debugNameSize	=	(unsigned int)strlen(transientNames[transientIndex]) + 1;
 	}
 }
 
@@ -3677,33 +3964,35 @@ void Game::InitializeResources()
 //--------------------------------------------------------------------------------------------------
 void Game::InitializeShaders()
 {
-	m_defaultShader									=	g_theRenderer->CreateOrGetShader("Data/Shaders/Default");
-	m_vpmPeelingShader								=	g_theRenderer->CreateOrGetShader("Data/Shaders/VPMPeelingShader");
-	m_vpmDepthCompositeShader						=	g_theRenderer->CreateComputeShader("Data/Shaders/VPMDepthCompositeShader");
-	m_vpmColorCompositeShader						=	g_theRenderer->CreateComputeShader("Data/Shaders/VPMColorCompositeShader");
-	m_depthPeelingShader							=	g_theRenderer->CreateOrGetShader("Data/Shaders/DepthPeelingShader");
-	m_depthPeelingDepthCompositeShader				=	g_theRenderer->CreateComputeShader("Data/Shaders/DepthPeelingDepthCompositeShader");
-	m_depthPeelingColorCompositeShader				=	g_theRenderer->CreateComputeShader("Data/Shaders/DepthPeelingColorCompositeShader");
-	m_depthPeelingFinalBackgroundPassShader			=	g_theRenderer->CreateComputeShader("Data/Shaders/DepthPeelingFinalBackgroundPassShader");
-	m_underCompositeShader							=	g_theRenderer->CreateComputeShader("Data/Shaders/UnderCompositeShader");
-	m_uavWriteWithROVShader							=	g_theRenderer->CreateOrGetShader("Data/Shaders/UAVWriteWithROVShader");
-	m_uavWriteWithoutROVShader						=	g_theRenderer->CreateOrGetShader("Data/Shaders/UAVWriteWithoutROVShader");
-	m_defaultPremultipliedAlphaShader				=	g_theRenderer->CreateOrGetShader("Data/Shaders/DefaultPremultipliedAlphaShader");
-	m_perPixelLinkedListClearBufferShader_32		=	g_theRenderer->CreateComputeShader("Data/Shaders/ClearBuffers");
-	m_perPixelLinkedListCompositePassShader_32		=	g_theRenderer->CreateComputeShader("Data/Shaders/PopulateRenderTarget");
-	m_perPixelLinkedListClearBufferShader_4			=	g_theRenderer->CreateComputeShader("Data/Shaders/ClearBuffers_4");
-	m_perPixelLinkedListCompositePassShader_4		=	g_theRenderer->CreateComputeShader("Data/Shaders/PopulateRenderTarget_4");
-	m_perPixelLinkedListClearBufferShader_2			=	g_theRenderer->CreateComputeShader("Data/Shaders/ClearBuffers_2");
-	m_perPixelLinkedListCompositePassShader_2		=	g_theRenderer->CreateComputeShader("Data/Shaders/PopulateRenderTarget_2");
-	m_populatePerPixelLinkedListShader				=	g_theRenderer->CreateOrGetShader("Data/Shaders/PopulateFragmentLinkedList");
-	m_populateAccumRevealRTsShader					=	g_theRenderer->CreateOrGetShader("Data/Shaders/PopulateAccumRevealRTs");				
-	m_weightedBlendedCompositeShader				=	g_theRenderer->CreateOrGetShader("Data/Shaders/CompositePass");
-	m_unoptimizedMLABPopulateBlendingArrayShader_2	=	g_theRenderer->CreateOrGetShader("Data/Shaders/UnoptimizedMLABPopulateBlendingArrayShader");
-	m_unoptimizedMLABPopulateRenderTargetShader_2	=	g_theRenderer->CreateComputeShader("Data/Shaders/UnoptimizedMLABPopulateRTShader");
-	m_unoptimizedMLABPopulateBlendingArrayShader_4	=	g_theRenderer->CreateOrGetShader("Data/Shaders/UnoptimizedMLABPopulateBlendingArrayShader_4");
-	m_unoptimizedMLABPopulateRenderTargetShader_4	=	g_theRenderer->CreateComputeShader("Data/Shaders/UnoptimizedMLABPopulateRTShader_4");
-	m_unoptimizedMLABPopulateBlendingArrayShader_32	=	g_theRenderer->CreateOrGetShader("Data/Shaders/UnoptimizedMLABPopulateBlendingArrayShader_32");
-	m_unoptimizedMLABPopulateRenderTargetShader_32	=	g_theRenderer->CreateComputeShader("Data/Shaders/UnoptimizedMLABPopulateRTShader_32");
+	// Every stage compiles on the job system, the game renders with the default shader and skips compute passes until they are ready
+	m_defaultShader									=	g_theShaderCompileQueue->RequestShader("Data/Shaders/Default");
+	m_defaultQuantizedShader						=	g_theShaderCompileQueue->RequestShader("Data/Shaders/DefaultQuantized", InputLayout::VERTEX_PCUTBN_QUANTIZED);
+	m_vpmPeelingShader								=	g_theShaderCompileQueue->RequestShader("Data/Shaders/VPMPeelingShader");
+	m_vpmDepthCompositeShader						=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/VPMDepthCompositeShader");
+	m_vpmColorCompositeShader						=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/VPMColorCompositeShader");
+	m_depthPeelingShader							=	g_theShaderCompileQueue->RequestShader("Data/Shaders/DepthPeelingShader");
+	m_depthPeelingDepthCompositeShader				=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/DepthPeelingDepthCompositeShader");
+	m_depthPeelingColorCompositeShader				=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/DepthPeelingColorCompositeShader");
+	m_depthPeelingFinalBackgroundPassShader			=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/DepthPeelingFinalBackgroundPassShader");
+	m_underCompositeShader							=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/UnderCompositeShader");
+	m_uavWriteWithROVShader							=	g_theShaderCompileQueue->RequestShader("Data/Shaders/UAVWriteWithROVShader");
+	m_uavWriteWithoutROVShader						=	g_theShaderCompileQueue->RequestShader("Data/Shaders/UAVWriteWithoutROVShader");
+	m_defaultPremultipliedAlphaShader				=	g_theShaderCompileQueue->RequestShader("Data/Shaders/DefaultPremultipliedAlphaShader");
+	m_perPixelLinkedListClearBufferShader_32		=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/ClearBuffers");
+	m_perPixelLinkedListCompositePassShader_32		=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/PopulateRenderTarget");
+	m_perPixelLinkedListClearBufferShader_4			=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/ClearBuffers_4");
+	m_perPixelLinkedListCompositePassShader_4		=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/PopulateRenderTarget_4");
+	m_perPixelLinkedListClearBufferShader_2			=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/ClearBuffers_2");
+	m_perPixelLinkedListCompositePassShader_2		=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/PopulateRenderTarget_2");
+	m_populatePerPixelLinkedListShader				=	g_theShaderCompileQueue->RequestShader("Data/Shaders/PopulateFragmentLinkedList");
+	m_populateAccumRevealRTsShader					=	g_theShaderCompileQueue->RequestShader("Data/Shaders/PopulateAccumRevealRTs");				
+	m_weightedBlendedCompositeShader				=	g_theShaderCompileQueue->RequestShader("Data/Shaders/CompositePass");
+	m_unoptimizedMLABPopulateBlendingArrayShader_2	=	g_theShaderCompileQueue->RequestShader("Data/Shaders/UnoptimizedMLABPopulateBlendingArrayShader");
+	m_unoptimizedMLABPopulateRenderTargetShader_2	=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/UnoptimizedMLABPopulateRTShader");
+	m_unoptimizedMLABPopulateBlendingArrayShader_4	=	g_theShaderCompileQueue->RequestShader("Data/Shaders/UnoptimizedMLABPopulateBlendingArrayShader_4");
+	m_unoptimizedMLABPopulateRenderTargetShader_4	=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/UnoptimizedMLABPopulateRTShader_4");
+	m_unoptimizedMLABPopulateBlendingArrayShader_32	=	g_theShaderCompileQueue->RequestShader("Data/Shaders/UnoptimizedMLABPopulateBlendingArrayShader_32");
+	m_unoptimizedMLABPopulateRenderTargetShader_32	=	g_theShaderCompileQueue->RequestComputeShader("Data/Shaders/UnoptimizedMLABPopulateRTShader_32");
 }
 
 
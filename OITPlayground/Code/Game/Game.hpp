@@ -11,7 +11,9 @@
 //--------------------------------------------------------------------------------------------------
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Renderer/Camera.hpp"
+#include "Engine/Renderer/RenderGraph.hpp"
 #include "Engine/Core/Vertex_PCU.hpp"
+#include "Engine/Core/Vertex_PCUTBN.hpp"
 #include "Engine/Core/XmlUtils.hpp"
 #include "Engine/Core/Rgba8.hpp"
 
@@ -27,6 +29,9 @@ class IndexBuffer;
 class VertexBuffer;
 class ConstantBuffer;
 class D3D11_Resource;
+class DrawQueue;
+class RenderGraph;
+class Asset;
 
 
 //--------------------------------------------------------------------------------------------------
@@ -146,6 +151,30 @@ enum eRenderPass : unsigned char
 };
 
 
+//--------------------------------------------------------------------------------------------------
+// Intermediates of the OIT modes, created in the render graph each frame by the mode that uses them
+// The per node ones are in eNodes order so eOITTransient(..._2 + nodes) picks the right one
+enum eOITTransient : unsigned char
+{
+	eOIT_TRANSIENT_INTERMEDIATE_TARGET = 0,
+	eOIT_TRANSIENT_INTERMEDIATE_RENDER_TARGET,
+	eOIT_TRANSIENT_DEPTH_PEELING_RENDER_TARGET,
+	eOIT_TRANSIENT_DEPTH_PEELING_DEPTH_TARGET,
+	eOIT_TRANSIENT_ACCUMULATION_TARGET,
+	eOIT_TRANSIENT_REVEALAGE_TARGET,
+	eOIT_TRANSIENT_HEAD_NODES_2,
+	eOIT_TRANSIENT_HEAD_NODES_4,
+	eOIT_TRANSIENT_HEAD_NODES_32,
+	eOIT_TRANSIENT_FRAGMENTS_2,
+	eOIT_TRANSIENT_FRAGMENTS_4,
+	eOIT_TRANSIENT_FRAGMENTS_32,
+	eOIT_TRANSIENT_MLAB_BLENDING_ARRAY_2,
+	eOIT_TRANSIENT_MLAB_BLENDING_ARRAY_4,
+	eOIT_TRANSIENT_MLAB_BLENDING_ARRAY_32,
+	eOIT_TRANSIENT_COUNT,
+};
+
+
 //--------------------------------------------------------------------------------------------------
 enum eNodes : unsigned char
 {
@@ -162,6 +191,8 @@ struct SceneObject
 	IndexBuffer*				m_indexBuffer				=	nullptr;
 	VertexBuffer*				m_vertexBuffer				=	nullptr;
 	D3D11_Resource*				m_textureResource			=	nullptr;
+	Asset const*				m_textureAsset				=	nullptr;	// Streamed in by g_theAssetLoader, binds its placeholder until then
+	Asset const*				m_meshAsset					=	nullptr;	// OBJ meshes are streamed in by g_theAssetLoader, nothing is drawn until it is READY
 	wchar_t const*				m_debugName					=	nullptr;
 	unsigned int				m_numOfTexturesBound		=	1;
 	unsigned int				m_numOfIndexes				=	0;
@@ -255,16 +286,23 @@ public:
 	void MultiLayerAlphaBlendingOITSubModeRender(eSplitScreenQuadrant quadrantToRender = eSPLIT_SCREEN_QUADRANT_1)	const;
 	
 	// Depth Peeling helper methods
-	void CompositeDepthPeelingDepth(D3D11_Resource* depthResource)	const;
-	void CompositeDepthPeelingColor(D3D11_Resource* colorTarget)	const;
+	void CompositeDepthPeelingDepth(D3D11_Resource* depthResource, D3D11_Resource* depthTarget)	const;
+	void CompositeDepthPeelingColor(D3D11_Resource* colorResource, D3D11_Resource* colorTarget)	const;
 
 	// Virtual Pixel Maps helper methods
-	void CompositeVPMDepth(D3D11_Resource*& depthResource)	const;
-	void CompositeVPMColor(D3D11_Resource*& colorTarget)	const;
+	void CompositeVPMDepth(D3D11_Resource* depthResource, D3D11_Resource* depthTarget)	const;
+	void CompositeVPMColor(D3D11_Resource* colorResource, D3D11_Resource* colorTarget)	const;
+
+	// Render graph helper methods
+	void					AddOpaquePass(eSplitScreenQuadrant quadrant, RenderGraphResourceID renderTarget, RenderGraphResourceID depthTarget)	const;
+	std::string				GetOITPassName(eSplitScreenQuadrant quadrant, char const* passName)													const;
+	RenderGraphResourceID	CreateOITTransient(eOITTransient transient)																			const;
+	size_t					GetUpFrontOITTransientBytes()																						const;	// What creating every OIT intermediate at startup takes
 
 	// Scene render helper methods
 	void DrawScene(eRenderPass renderPass)						const;
 	void DrawSortedTranslucentScene()							const;
+	void SubmitSceneObjects(std::vector<SceneObject> const& sceneObjects, bool keepsSceneOrder) const;
 	// void OpaqueRenderPass(eTranslucentScene sceneToDraw)		const;
 	// void TranslucentRenderPass(eTranslucentScene sceneToDraw)	const;
 
@@ -304,9 +342,16 @@ public:
 
 	// Commands
 	static bool Command_SetDepthPeelCount(EventArgs& args);
+	static bool Command_DrawQueueBenchmark(EventArgs& args);
+	static bool Command_SpriteBatchBenchmark(EventArgs& args);
+	static bool Command_RenderGraphMemory(EventArgs& args);
+	static bool Command_RenderTimings(EventArgs& args);
+	static bool Command_RenderTimingsTrace(EventArgs& args);
 
 
 	// Initialization methods
+	static void AppendMeshToSceneArrays(Scene& scene, std::vector<Vertex_PCU> const& verts, std::vector<unsigned int> const& indexes, Rgba8 const& meshColor);
+	static void AppendMeshToSceneArrays(Scene& scene, std::vector<Vertex_PCUTBN> const& verts, std::vector<unsigned int> const& indexes, Rgba8 const& meshColor);
 	void InitializeSceneFromElement(XmlElement const& sceneDef);
 	void InitializeDepthTestModeSceneObjects();
 	void InitializeVertexAndIndexBuffers();
@@ -314,6 +359,7 @@ public:
 	void InitializeCustomBlendModes();
 	void InitializeGridBuffer();
 	void InitializeResources();
+	void InitializeOITTransientConfigs(IntVec2 const& windowDim);
 	void InitializeShaders();
 	void InitializeMeshes();
 
@@ -326,23 +372,9 @@ private:
 	D3D11_Resource*				m_quadrant2DepthTarget									=	nullptr;
 	D3D11_Resource*				m_quadrant3DepthTarget									=	nullptr;
 	D3D11_Resource*				m_quadrant4DepthTarget									=	nullptr;
-	D3D11_Resource*				m_intermediateTarget									=	nullptr;
-	D3D11_Resource*				m_intermediateRenderTarget								=	nullptr;
 	D3D11_Resource*				m_opaqueBackgroundQuadrant1RenderTarget					=	nullptr;
-	D3D11_Resource*				m_depthPeelingIntermediateDepthTarget					=	nullptr;
-	D3D11_Resource*				m_depthPeelingIntermediateRenderTarget					=	nullptr;
-	D3D11_Resource*				m_fragmentsPerPixelStructuredBuffer_32					=	nullptr;
-	D3D11_Resource*				m_headNodeByteAddressBuffer_32							=	nullptr;
-	D3D11_Resource*				m_fragmentsPerPixelStructuredBuffer_4					=	nullptr;
-	D3D11_Resource*				m_headNodeByteAddressBuffer_4							=	nullptr;
-	D3D11_Resource*				m_fragmentsPerPixelStructuredBuffer_2					=	nullptr;
-	D3D11_Resource*				m_headNodeByteAddressBuffer_2							=	nullptr;
-	D3D11_Resource*				m_accumulationTargetWeightedBlended						=	nullptr;
-	D3D11_Resource*				m_revealageTargetWeightedBlended						=	nullptr;
 	D3D11_Resource*				m_unoptimizedMLABUntouchedFragmentMask					=	nullptr;
-	D3D11_Resource*				m_unoptimizedMLABStructuredBuffer_2						=	nullptr;
-	D3D11_Resource*				m_unoptimizedMLABStructuredBuffer_4						=	nullptr;
-	D3D11_Resource*				m_unoptimizedMLABStructuredBuffer_32					=	nullptr;
+	D3D11_ResourceConfig		m_oitTransientConfigs[eOIT_TRANSIENT_COUNT]				=	{ };
 
 	VertexBuffer*				m_fullScreenQuadVB										=	nullptr;
 	IndexBuffer*				m_fullScreenQuadIB										=	nullptr;
@@ -365,6 +397,7 @@ private:
 
 	VertexBuffer*				m_gridVertexBuffer										=	nullptr;
 	Shader*						m_defaultShader											=	nullptr;
+	Shader*						m_defaultQuantizedShader								=	nullptr;	// Opaque OBJ meshes are Vertex_PCUTBN_Quantized
 	Shader*						m_vpmPeelingShader										=	nullptr;
 	Shader*						m_vpmDepthCompositeShader								=	nullptr;
 	Shader*						m_vpmColorCompositeShader								=	nullptr;
@@ -394,6 +427,9 @@ private:
 	Shader*						m_unoptimizedMLABPopulateBlendingArrayShader_32			=	nullptr;
 	Shader*						m_unoptimizedMLABPopulateRenderTargetShader_32			=	nullptr;
 
+	DrawQueue*					m_drawQueue												=	nullptr;
+	RenderGraph*				m_renderGraph											=	nullptr;		// OIT mode frames, rebuilt every frame
+
 	Camera						m_screenCamera											=	{ };
 	Vec3						m_prevPlayerCamPos;
 	EulerAngles					m_prevPlayerCamOrientation;
@@ -407,6 +443,7 @@ private:
 	bool						m_isTextured											=	true;
 	bool						m_isDepthTestEnabled									=	false;
 	bool						m_isRetainedModeRendering								=	true;
+	bool						m_isDrawQueueEnabled									=	true;
 	eTranslucentScene			m_sceneIndex											=	eTRANSLUCENT_SCENE_TWO_QUADS;
 	eTranslucentMode			m_translucentModeQuadrant1								=	eTRANSLUCENT_MODE_WORST_CASE;
 	eTranslucentMode			m_translucentModeQuadrant2								=	eTRANSLUCENT_MODE_WORST_CASE;
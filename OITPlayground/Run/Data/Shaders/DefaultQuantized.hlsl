@@ -0,0 +1,89 @@
+//--------------------------------------------------------------------------------------------------
+// Default.hlsl for Vertex_PCUTBN_Quantized meshes, created with InputLayout::VERTEX_PCUTBN_QUANTIZED
+// The model matrix has GetDequantizationMatrix(bounds) appended, so the UNORM16 position goes through it as is
+struct vs_input_t
+{
+	float4 quantizedPosition	:	POSITION;		// xyz in [0, 1] across the mesh bounds, w is the binormal handedness (0 = -1, 1 = +1)
+	float4 color				:	COLOR;
+	float2 uv					:	TEXCOORD;
+	float2 octahedralTangent	:	TANGENT;
+	float2 octahedralNormal		:	NORMAL;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+struct v2p_t
+{
+	float4 position		:	SV_Position;
+	float4 color		:	COLOR;
+	float2 uv			:	TEXCOORD;
+	float3 tangent		:	TANGENT;
+	float3 binormal		:	BINORMAL;
+	float3 normal		:	NORMAL;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+cbuffer CameraConstants : register(b2)
+{
+	float4x4 viewToClipTransformator;
+	float4x4 worldToViewTransformator;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+cbuffer ModelConstants : register(b3)
+{
+	float4x4 localToWorldTransformator;
+	float4   modelColor;
+};
+
+
+//--------------------------------------------------------------------------------------------------
+Texture2D diffuseTexture	: register(t0);
+
+SamplerState diffuseSampler : register(s0);
+
+
+//--------------------------------------------------------------------------------------------------
+// Inverse of EncodeOctahedral in VertexQuantization.cpp, unfolds the lower hemisphere back over the diagonals
+float3 DecodeOctahedral(float2 octahedral)
+{
+	float3 direction	=	float3(octahedral, 1.f - abs(octahedral.x) - abs(octahedral.y));
+	float  fold			=	saturate(-direction.z);
+	direction.xy		-=	fold * (step(0.f, direction.xy) * 2.f - 1.f);
+	return normalize(direction);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+v2p_t VertexMain(vs_input_t input)
+{
+	v2p_t v2p;
+	float4 localPosition	=	float4(input.quantizedPosition.xyz, 1);
+	float4 worldPosition	=	mul(localToWorldTransformator, localPosition);
+	float4 viewPosition		=	mul(worldToViewTransformator, worldPosition);
+	float4 clipPosition		=	mul(viewToClipTransformator, viewPosition);
+	v2p.position			=	clipPosition;
+	v2p.color				=	input.color * modelColor;
+	v2p.uv					=	input.uv;
+
+	// The scene's meshes have their fix-up baked into the verts, so the model matrix is only the dequantization and the directions skip it
+	float3 localNormal		=	DecodeOctahedral(input.octahedralNormal);
+	float3 localTangent		=	DecodeOctahedral(input.octahedralTangent);
+	float  handedness		=	input.quantizedPosition.w * 2.f - 1.f;
+	v2p.normal				=	localNormal;
+	v2p.tangent				=	localTangent;
+	v2p.binormal			=	cross(localNormal, localTangent) * handedness;
+	return v2p;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+[earlydepthstencil]
+float4 PixelMain(v2p_t input) : SV_Target0
+{
+	float4 color	=	diffuseTexture.Sample(diffuseSampler, input.uv);
+	color			*=	input.color;
+	return color;
+}